@@ -0,0 +1,334 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the BLAS content and geometry hashing functions.
+//=============================================================================
+
+#include "blas_hash.h"
+
+#include <string.h>  // for memcpy()
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
+#include "job_system.h"
+#include "public/rra_blas.h"
+#include "surface_area_heuristic.h"
+
+namespace rra
+{
+    static const uint64_t kPrime1 = 0x9e3779b185ebca87ULL;  ///< Hash multiplier.
+    static const uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;  ///< Hash multiplier.
+    static const uint64_t kPrime3 = 0x165667b19e3779f9ULL;  ///< Hash multiplier.
+
+    /// @brief Rotate a 64-bit value left.
+    ///
+    /// @param [in] value The value to rotate.
+    /// @param [in] bits  The number of bits to rotate by.
+    ///
+    /// @return The rotated value.
+    static inline uint64_t RotateLeft(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    /// @brief Mix a 64-bit input word into a hash lane.
+    ///
+    /// @param [in] lane  The current lane value.
+    /// @param [in] input The input word.
+    ///
+    /// @return The new lane value.
+    static inline uint64_t MixLane(uint64_t lane, uint64_t input)
+    {
+        lane += input * kPrime2;
+        lane = RotateLeft(lane, 31);
+        return lane * kPrime1;
+    }
+
+    /// @brief Mix the bits of a 64-bit value (the splitmix64 finalizer).
+    ///
+    /// @param [in] value The value to mix.
+    ///
+    /// @return The mixed value.
+    static inline uint64_t MixHash(uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return value;
+    }
+
+    uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+    {
+        const uint8_t* bytes  = static_cast<const uint8_t*>(data);
+        size_t         offset = 0;
+        uint64_t       hash   = seed + kPrime3;
+
+        if (size >= 32)
+        {
+            uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+            uint64_t words[4];
+
+            for (; offset + 32 <= size; offset += 32)
+            {
+                memcpy(words, bytes + offset, sizeof(words));
+                lanes[0] = MixLane(lanes[0], words[0]);
+                lanes[1] = MixLane(lanes[1], words[1]);
+                lanes[2] = MixLane(lanes[2], words[2]);
+                lanes[3] = MixLane(lanes[3], words[3]);
+            }
+
+            hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+        }
+
+        for (; offset + 8 <= size; offset += 8)
+        {
+            uint64_t word = 0;
+            memcpy(&word, bytes + offset, sizeof(word));
+            hash = RotateLeft(hash ^ MixLane(0, word), 27) * kPrime1 + kPrime3;
+        }
+
+        for (; offset < size; offset++)
+        {
+            hash ^= bytes[offset] * kPrime3;
+            hash = RotateLeft(hash, 11) * kPrime1;
+        }
+
+        return MixHash(hash + size);
+    }
+
+    /// @brief Hash a triangle so that the result does not depend on which vertex comes first.
+    ///
+    /// The vertices are rotated to start at the vertex with the smallest hash, keeping the winding order.
+    ///
+    /// @param [in] triangle The triangle to hash.
+    ///
+    /// @return The hash.
+    static uint64_t HashTriangle(const TriangleVertices& triangle)
+    {
+        const uint64_t vertex_hashes[3] = {HashBytes(&triangle.a, sizeof(VertexPosition)),
+                                           HashBytes(&triangle.b, sizeof(VertexPosition)),
+                                           HashBytes(&triangle.c, sizeof(VertexPosition))};
+
+        size_t first = 0;
+        if (vertex_hashes[1] < vertex_hashes[first])
+        {
+            first = 1;
+        }
+        if (vertex_hashes[2] < vertex_hashes[first])
+        {
+            first = 2;
+        }
+
+        uint64_t hash = 0;
+        for (size_t i = 0; i < 3; i++)
+        {
+            hash = MixHash(hash ^ vertex_hashes[(first + i) % 3]);
+        }
+        return hash;
+    }
+
+    RraErrorCode CalculateBlasGeometryHash(RraContext* context, uint64_t blas_index, uint64_t* out_hash, uint64_t* out_triangle_count)
+    {
+        std::vector<dxr::amd::NodePointer> triangle_nodes;
+        RRA_BUBBLE_ON_ERROR(GetBlasTriangleNodes(context, blas_index, triangle_nodes));
+
+        uint64_t         hash           = 0;
+        uint64_t         triangle_count = 0;
+        TriangleVertices triangles[2]   = {};
+
+        for (const auto& node_ptr : triangle_nodes)
+        {
+            uint32_t node_triangle_count = 0;
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetNodeTriangleCount(context, blas_index, node_ptr.GetRawPointer(), &node_triangle_count));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetNodeTriangles(context, blas_index, node_ptr.GetRawPointer(), triangles));
+
+            node_triangle_count = std::min(node_triangle_count, 2u);
+            for (uint32_t i = 0; i < node_triangle_count; i++)
+            {
+                hash += HashTriangle(triangles[i]);
+            }
+            triangle_count += node_triangle_count;
+        }
+
+        *out_hash           = MixHash(hash ^ triangle_count);
+        *out_triangle_count = triangle_count;
+        return kRraOk;
+    }
+
+    /// @brief Get the triangles of a BLAS in an order that doesn't depend on the BVH layout.
+    ///
+    /// Each triangle is rotated to start at its smallest vertex, keeping the winding order, and the
+    /// triangles are then sorted. Two BLASes with the same geometry get the same list.
+    ///
+    /// @param [in]  context       The context holding the loaded trace.
+    /// @param [in]  blas_index    The index of the BLAS.
+    /// @param [out] out_triangles The triangles.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    static RraErrorCode GetCanonicalTriangles(RraContext* context, uint64_t blas_index, std::vector<TriangleVertices>& out_triangles)
+    {
+        std::vector<dxr::amd::NodePointer> triangle_nodes;
+        RRA_BUBBLE_ON_ERROR(GetBlasTriangleNodes(context, blas_index, triangle_nodes));
+
+        const auto triangle_less = [](const TriangleVertices& lhs, const TriangleVertices& rhs) {
+            return memcmp(&lhs, &rhs, sizeof(TriangleVertices)) < 0;
+        };
+
+        out_triangles.clear();
+        out_triangles.reserve(triangle_nodes.size());
+        TriangleVertices triangles[2] = {};
+        for (const auto& node_ptr : triangle_nodes)
+        {
+            uint32_t node_triangle_count = 0;
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetNodeTriangleCount(context, blas_index, node_ptr.GetRawPointer(), &node_triangle_count));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetNodeTriangles(context, blas_index, node_ptr.GetRawPointer(), triangles));
+
+            node_triangle_count = std::min(node_triangle_count, 2u);
+            for (uint32_t i = 0; i < node_triangle_count; i++)
+            {
+                // Compare whole rotations rather than single vertices, so a triangle repeating a vertex still has one order.
+                TriangleVertices canonical = triangles[i];
+                for (const TriangleVertices& rotation : {TriangleVertices{triangles[i].b, triangles[i].c, triangles[i].a},
+                                                         TriangleVertices{triangles[i].c, triangles[i].a, triangles[i].b}})
+                {
+                    if (triangle_less(rotation, canonical))
+                    {
+                        canonical = rotation;
+                    }
+                }
+                out_triangles.push_back(canonical);
+            }
+        }
+
+        std::sort(out_triangles.begin(), out_triangles.end(), triangle_less);
+        return kRraOk;
+    }
+
+    /// @brief Calculate the content and geometry hashes for a single BLAS.
+    ///
+    /// @param [in] context The context holding the loaded trace.
+    /// @param [in] blas    The bottom level acceleration structure.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    static RraErrorCode CalculateHashes(RraContext* context, rta::EncodedRtIp11BottomLevelBvh* blas)
+    {
+        if (blas->IsEmpty())
+        {
+            return kRraOk;
+        }
+
+        const auto& interior_nodes = blas->GetInteriorNodesData();
+        const auto& leaf_nodes     = blas->GetLeafNodesData();
+        const auto& geometry_infos = blas->GetGeometryInfos();
+
+        uint64_t content_hash = HashBytes(interior_nodes.data(), interior_nodes.size());
+        content_hash          = HashBytes(leaf_nodes.data(), leaf_nodes.size(), content_hash);
+        content_hash          = HashBytes(geometry_infos.data(), geometry_infos.size() * sizeof(dxr::amd::GeometryInfo), content_hash);
+
+        uint64_t geometry_hash  = 0;
+        uint64_t triangle_count = 0;
+        RRA_BUBBLE_ON_ERROR(CalculateBlasGeometryHash(context, blas->GetID(), &geometry_hash, &triangle_count));
+
+        blas->SetContentHash(content_hash);
+        blas->SetGeometryHash(triangle_count > 0 ? geometry_hash : 0);
+        return kRraOk;
+    }
+
+    RraErrorCode CalculateBlasHashes(RraContext* context)
+    {
+        const auto&                                    bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
+        std::vector<rta::EncodedRtIp11BottomLevelBvh*> blases(bottom_level_bvhs.size(), nullptr);
+        for (size_t blas_index = 0; blas_index < bottom_level_bvhs.size(); blas_index++)
+        {
+            blases[blas_index] = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
+            if (blases[blas_index] == nullptr)
+            {
+                return kRraErrorInvalidPointer;
+            }
+        }
+
+        // BLASes vary a lot in size, so each one is a block of its own rather than part of a fixed range.
+        CancellationToken failed;
+        JobSystem::Get().ParallelFor(
+            blases.size(),
+            1,
+            0,
+            [context, &blases, &failed](size_t begin, size_t end, uint32_t) {
+                for (size_t index = begin; index < end; index++)
+                {
+                    if (CalculateHashes(context, blases[index]) != kRraOk)
+                    {
+                        failed.Cancel();
+                    }
+                }
+            },
+            &failed);
+
+        if (failed.IsCancelled())
+        {
+            return kRraErrorInvalidPointer;
+        }
+
+        // Mark each BLAS as a duplicate of the first BLAS with the same geometry. Different meshes can share a geometry
+        // hash, so the triangles are compared before a BLAS is merged into a group. Each hash keeps the first BLAS of
+        // every group found with it, along with its triangles once they have been needed for a comparison.
+        std::unordered_map<uint64_t, std::vector<uint64_t>>         groups_with_hash;
+        std::unordered_map<uint64_t, std::vector<TriangleVertices>> group_triangles;
+        std::vector<TriangleVertices>                               triangles;
+        for (size_t blas_index = 0; blas_index < blases.size(); blas_index++)
+        {
+            rta::EncodedRtIp11BottomLevelBvh* blas = blases[blas_index];
+            if (blas->GetGeometryHash() == 0)
+            {
+                blas->SetDuplicateOf(blas_index);
+                continue;
+            }
+
+            std::vector<uint64_t>& groups         = groups_with_hash[blas->GetGeometryHash()];
+            uint64_t               duplicate_of   = blas_index;
+            bool                   have_triangles = false;
+            for (uint64_t group_index : groups)
+            {
+                if (!have_triangles)
+                {
+                    RRA_BUBBLE_ON_ERROR(GetCanonicalTriangles(context, blas_index, triangles));
+                    have_triangles = true;
+                }
+
+                auto group_it = group_triangles.find(group_index);
+                if (group_it == group_triangles.end())
+                {
+                    group_it = group_triangles.emplace(group_index, std::vector<TriangleVertices>()).first;
+                    RRA_BUBBLE_ON_ERROR(GetCanonicalTriangles(context, group_index, group_it->second));
+                }
+
+                const std::vector<TriangleVertices>& group = group_it->second;
+                if (group.size() == triangles.size() && memcmp(group.data(), triangles.data(), triangles.size() * sizeof(TriangleVertices)) == 0)
+                {
+                    duplicate_of = group_index;
+                    break;
+                }
+            }
+
+            // Nothing matched, so this BLAS starts a new group.
+            if (duplicate_of == blas_index)
+            {
+                groups.push_back(blas_index);
+                if (have_triangles)
+                {
+                    group_triangles[blas_index] = std::move(triangles);
+                    triangles.clear();
+                }
+            }
+            blas->SetDuplicateOf(duplicate_of);
+        }
+
+        return kRraOk;
+    }
+}  // namespace rra
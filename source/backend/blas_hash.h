@@ -0,0 +1,129 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the BLAS content and geometry hashing functions.
+//=============================================================================
+
+#ifndef RRA_BACKEND_BLAS_HASH_H_
+#define RRA_BACKEND_BLAS_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>  // for memcmp()
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "public/rra_error.h"
+#include "rra_context.h"
+
+// BLAS hashing functions. Used only by the backend; no public interface.
+
+namespace rra
+{
+    /// @brief Hash a block of memory.
+    ///
+    /// This is plain scalar code. Blocks of 32 bytes are folded into four separate running hashes, one
+    /// 8-byte word each, so the four multiplies of a block don't wait on each other.
+    ///
+    /// @param [in] data The data to hash.
+    /// @param [in] size The size of the data, in bytes.
+    /// @param [in] seed The starting hash value.
+    ///
+    /// @return The hash.
+    uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+    /// @brief Get a float that compares equal bit for bit to every float equal to it.
+    ///
+    /// Adding zero turns -0 into +0, and leaves every other value as it is.
+    ///
+    /// @param [in] value The value.
+    ///
+    /// @return The value, with -0 replaced by +0.
+    inline float CanonicalizeZero(float value)
+    {
+        return value + 0.0f;
+    }
+
+    /// @brief Give each distinct key an index.
+    ///
+    /// Keys are sorted by hash, and keys with the same hash are compared bit for bit. Each key is compared
+    /// against the keys before it with the same hash, so a hash shared by many different keys would be slow.
+    ///
+    /// @param [in] keys The keys. Use CanonicalizeZero() on float keys first so that -0 and +0 match.
+    ///
+    /// @return The index of each key. Identical keys have the same index, and the indices start at zero with no gaps.
+    template <typename Key>
+    std::vector<uint32_t> GetKeyIndices(const std::vector<Key>& keys)
+    {
+        std::vector<std::pair<uint64_t, uint32_t>> hashes(keys.size());
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            hashes[i] = {HashBytes(&keys[i], sizeof(Key)), static_cast<uint32_t>(i)};
+        }
+        std::sort(hashes.begin(), hashes.end());
+
+        std::vector<uint32_t> indices(keys.size());
+        uint32_t              next_index = 0;
+        for (size_t begin = 0; begin < hashes.size();)
+        {
+            size_t end = begin + 1;
+            while (end < hashes.size() && hashes[end].first == hashes[begin].first)
+            {
+                end++;
+            }
+
+            for (size_t j = begin; j < end; j++)
+            {
+                const uint32_t a = hashes[j].second;
+                indices[a]       = next_index;
+                for (size_t k = begin; k < j; k++)
+                {
+                    const uint32_t b = hashes[k].second;
+                    if (memcmp(&keys[a], &keys[b], sizeof(Key)) == 0)
+                    {
+                        indices[a] = indices[b];
+                        break;
+                    }
+                }
+                if (indices[a] == next_index)
+                {
+                    next_index++;
+                }
+            }
+            begin = end;
+        }
+
+        return indices;
+    }
+
+    /// @brief Calculate the geometry hash for a BLAS.
+    ///
+    /// The per-triangle hashes are summed so the result does not depend on the order of the leaf nodes,
+    /// meaning two builds of the same mesh hash the same even if the BVH layout differs.
+    ///
+    /// @param [in]  context            The context holding the loaded trace.
+    /// @param [in]  blas_index         The index of the BLAS.
+    /// @param [out] out_hash           The geometry hash.
+    /// @param [out] out_triangle_count The number of triangles hashed.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode CalculateBlasGeometryHash(RraContext* context, uint64_t blas_index, uint64_t* out_hash, uint64_t* out_triangle_count);
+
+    /// @brief Calculate the content and geometry hashes for all BLASes, and find duplicates.
+    ///
+    /// The content hash covers the raw interior node, leaf node and geometry info data, so it
+    /// only matches BLASes that are bit-identical. BLASes with the same geometry hash and the same
+    /// triangles are treated as duplicates, and each is marked as a duplicate of the lowest indexed
+    /// BLAS in its group.
+    ///
+    /// @param [in] context The context holding the loaded trace.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode CalculateBlasHashes(RraContext* context);
+}  // namespace rra
+
+#endif  // RRA_BACKEND_BLAS_HASH_H_
@@ -179,8 +179,10 @@ namespace rta
     bool EncodedRtIp11BottomLevelBvh::PostLoad()
     {
         size_t num_leaf_nodes = leaf_nodes_.size() / sizeof(dxr::amd::TriangleNode);
-        ScanTreeDepth();
+        ScanTree();
         triangle_surface_area_heuristic_.resize(num_leaf_nodes, 0);
+        triangle_leaf_tightness_.resize(num_leaf_nodes, 0);
+        triangle_issue_flags_.resize(num_leaf_nodes, kTriangleIssueNone);
         return true;
     }
 
@@ -201,6 +203,48 @@ namespace rta
         triangle_surface_area_heuristic_[leaf_index] = surface_area_heuristic;
     }
 
+    float EncodedRtIp11BottomLevelBvh::GetLeafNodeTightness(const dxr::amd::NodePointer node_ptr) const
+    {
+        const uint32_t index = (node_ptr.GetByteOffset() - GetHeader().GetBufferOffsets().leaf_nodes) / sizeof(dxr::amd::TriangleNode);
+        assert(index < triangle_leaf_tightness_.size());
+        return triangle_leaf_tightness_[index];
+    }
+
+    void EncodedRtIp11BottomLevelBvh::SetLeafNodeTightness(uint64_t leaf_index, float tightness)
+    {
+        assert(leaf_index < triangle_leaf_tightness_.size());
+        triangle_leaf_tightness_[leaf_index] = tightness;
+    }
+
+    std::uint8_t EncodedRtIp11BottomLevelBvh::GetLeafNodeIssueFlags(const dxr::amd::NodePointer node_ptr) const
+    {
+        const uint32_t index = (node_ptr.GetByteOffset() - GetHeader().GetBufferOffsets().leaf_nodes) / sizeof(dxr::amd::TriangleNode);
+        assert(index < triangle_issue_flags_.size());
+        return triangle_issue_flags_[index];
+    }
+
+    void EncodedRtIp11BottomLevelBvh::SetLeafNodeIssueFlags(uint64_t leaf_index, std::uint8_t issue_flags)
+    {
+        assert(leaf_index < triangle_issue_flags_.size());
+        triangle_issue_flags_[leaf_index] = issue_flags;
+    }
+
+    const TriangleIssueCounts& EncodedRtIp11BottomLevelBvh::GetTriangleIssueCounts() const
+    {
+        return triangle_issue_counts_;
+    }
+
+    const std::vector<TriangleIssueCounts>& EncodedRtIp11BottomLevelBvh::GetGeometryTriangleIssueCounts() const
+    {
+        return geometry_triangle_issue_counts_;
+    }
+
+    void EncodedRtIp11BottomLevelBvh::SetTriangleIssueCounts(const TriangleIssueCounts& counts, std::vector<TriangleIssueCounts>&& geometry_counts)
+    {
+        triangle_issue_counts_          = counts;
+        geometry_triangle_issue_counts_ = std::move(geometry_counts);
+    }
+
     float EncodedRtIp11BottomLevelBvh::GetSurfaceAreaHeuristic() const
     {
         return surface_area_heuristic_;
@@ -211,4 +255,34 @@ namespace rta
         surface_area_heuristic_ = surface_area_heuristic;
     }
 
+    uint64_t EncodedRtIp11BottomLevelBvh::GetContentHash() const
+    {
+        return content_hash_;
+    }
+
+    void EncodedRtIp11BottomLevelBvh::SetContentHash(uint64_t content_hash)
+    {
+        content_hash_ = content_hash;
+    }
+
+    uint64_t EncodedRtIp11BottomLevelBvh::GetGeometryHash() const
+    {
+        return geometry_hash_;
+    }
+
+    void EncodedRtIp11BottomLevelBvh::SetGeometryHash(uint64_t geometry_hash)
+    {
+        geometry_hash_ = geometry_hash;
+    }
+
+    uint64_t EncodedRtIp11BottomLevelBvh::GetDuplicateOf() const
+    {
+        return duplicate_of_;
+    }
+
+    void EncodedRtIp11BottomLevelBvh::SetDuplicateOf(uint64_t blas_index)
+    {
+        duplicate_of_ = blas_index;
+    }
+
 }  // namespace rta
@@ -16,6 +16,29 @@
 
 namespace rta
 {
+    /// @brief Flags for the problems the triangle scan can find with a triangle.
+    enum TriangleIssueFlags : std::uint8_t
+    {
+        kTriangleIssueNone          = 0,       ///< No problems found.
+        kTriangleIssueZeroArea      = 1 << 0,  ///< The triangle has no area.
+        kTriangleIssueSliver        = 1 << 1,  ///< The triangle is extremely long and thin.
+        kTriangleIssueNonFinite     = 1 << 2,  ///< A vertex has a NaN or infinite coordinate, and the triangle is not inactive.
+        kTriangleIssueDuplicate     = 1 << 3,  ///< Another triangle in the BLAS has the same vertex positions.
+        kTriangleIssueOutsideParent = 1 << 4,  ///< The triangle reaches well outside the bounding box stored in its parent.
+    };
+
+    /// @brief The number of triangles with each kind of problem.
+    struct TriangleIssueCounts
+    {
+        std::uint64_t triangle_count         = 0;  ///< The number of triangles scanned.
+        std::uint64_t zero_area_count        = 0;  ///< The number of zero area triangles.
+        std::uint64_t sliver_count           = 0;  ///< The number of sliver triangles.
+        std::uint64_t non_finite_count       = 0;  ///< The number of triangles with NaN or infinite vertices.
+        std::uint64_t duplicate_count        = 0;  ///< The number of triangles sharing their vertex positions with another triangle.
+        std::uint64_t outside_parent_count   = 0;  ///< The number of triangles reaching outside their parent's bounding box.
+        std::uint64_t problem_triangle_count = 0;  ///< The number of triangles with at least one problem.
+    };
+
     class EncodedRtIp11BottomLevelBvh final : public IEncodedRtIp11Bvh
     {
     public:
@@ -89,6 +112,48 @@ namespace rta
         /// @param [in] surface_area_heuristic The surface area heuristic value to be set.
         void SetLeafNodeSurfaceAreaHeuristic(uint64_t leaf_index, float surface_area_heuristic);
 
+        /// @brief Get the tightness of the bounding box around a given leaf node.
+        ///
+        /// @param [in] node_ptr The leaf node whose tightness is to be found.
+        ///
+        /// @return The leaf tightness.
+        float GetLeafNodeTightness(const dxr::amd::NodePointer node_ptr) const;
+
+        /// @brief Set the tightness of the bounding box around a given leaf node.
+        ///
+        /// @param [in] leaf_index The leaf index whose tightness is to be set.
+        /// @param [in] tightness  The leaf tightness value to be set.
+        void SetLeafNodeTightness(uint64_t leaf_index, float tightness);
+
+        /// @brief Get the problems found with the triangles in a given leaf node.
+        ///
+        /// @param [in] node_ptr The leaf node whose problems are to be found.
+        ///
+        /// @return The TriangleIssueFlags of all the triangles in the node.
+        std::uint8_t GetLeafNodeIssueFlags(const dxr::amd::NodePointer node_ptr) const;
+
+        /// @brief Set the problems found with the triangles in a given leaf node.
+        ///
+        /// @param [in] leaf_index  The leaf index whose problems are to be set.
+        /// @param [in] issue_flags The TriangleIssueFlags of all the triangles in the node.
+        void SetLeafNodeIssueFlags(uint64_t leaf_index, std::uint8_t issue_flags);
+
+        /// @brief Get the triangle problem counts for this BLAS.
+        ///
+        /// @return The problem counts.
+        const TriangleIssueCounts& GetTriangleIssueCounts() const;
+
+        /// @brief Get the triangle problem counts for each geometry in this BLAS.
+        ///
+        /// @return The problem counts, indexed by geometry index.
+        const std::vector<TriangleIssueCounts>& GetGeometryTriangleIssueCounts() const;
+
+        /// @brief Set the triangle problem counts for this BLAS.
+        ///
+        /// @param [in] counts          The problem counts for the whole BLAS.
+        /// @param [in] geometry_counts The problem counts for each geometry.
+        void SetTriangleIssueCounts(const TriangleIssueCounts& counts, std::vector<TriangleIssueCounts>&& geometry_counts);
+
         /// @brief Get the top-level surface area heuristic for this BLAS.
         ///
         /// @return The surface area heuristic.
@@ -99,6 +164,36 @@ namespace rta
         /// @param [in] surface_area_heuristic The surface area heuristic value to be set.
         void SetSurfaceAreaHeuristic(float surface_area_heuristic);
 
+        /// @brief Get the hash of the raw node and geometry info data for this BLAS.
+        ///
+        /// @return The content hash.
+        uint64_t GetContentHash() const;
+
+        /// @brief Set the hash of the raw node and geometry info data for this BLAS.
+        ///
+        /// @param [in] content_hash The content hash.
+        void SetContentHash(uint64_t content_hash);
+
+        /// @brief Get the hash of the triangle geometry for this BLAS.
+        ///
+        /// @return The geometry hash, or 0 if the BLAS has no triangles.
+        uint64_t GetGeometryHash() const;
+
+        /// @brief Set the hash of the triangle geometry for this BLAS.
+        ///
+        /// @param [in] geometry_hash The geometry hash.
+        void SetGeometryHash(uint64_t geometry_hash);
+
+        /// @brief Get the index of the first BLAS with the same geometry as this one.
+        ///
+        /// @return The BLAS index. This is the index of this BLAS if it is not a duplicate.
+        uint64_t GetDuplicateOf() const;
+
+        /// @brief Set the index of the first BLAS with the same geometry as this one.
+        ///
+        /// @param [in] blas_index The BLAS index.
+        void SetDuplicateOf(uint64_t blas_index);
+
     private:
         /// @brief Obtain the byte size of the encoded buffer.
         ///
@@ -117,7 +212,14 @@ namespace rta
         std::vector<dxr::amd::NodePointer>  primitive_node_ptrs_             = {};    ///< Pointer to the leaf nodes.
         std::vector<std::uint8_t>           sideband_data_                   = {};    ///< Sideband data for compression.
         std::vector<float>                  triangle_surface_area_heuristic_ = {};    ///< Surface area heuristic values for the triangles.
+        std::vector<float>                  triangle_leaf_tightness_         = {};    ///< Bounding box tightness values for the triangles.
+        std::vector<std::uint8_t>           triangle_issue_flags_            = {};    ///< The problems found with the triangles in each leaf node.
+        TriangleIssueCounts                 triangle_issue_counts_           = {};    ///< The triangle problem counts for the whole BLAS.
+        std::vector<TriangleIssueCounts>    geometry_triangle_issue_counts_  = {};    ///< The triangle problem counts for each geometry.
         float                               surface_area_heuristic_          = 0.0f;  ///< The precalculated Surface area heuristic for this BLAS.
+        uint64_t                            content_hash_                    = 0;     ///< Hash of the raw node and geometry info data.
+        uint64_t                            geometry_hash_                   = 0;     ///< Hash of the triangle geometry.
+        uint64_t                            duplicate_of_                    = 0;     ///< Index of the first BLAS with the same geometry.
     };
 
 }  // namespace rta
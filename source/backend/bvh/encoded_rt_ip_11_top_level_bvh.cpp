@@ -8,10 +8,10 @@
 
 #include "bvh/encoded_rt_ip_11_top_level_bvh.h"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cassert>
-#include <deque>
 #include <unordered_set>
 
 #include "public/rra_assert.h"
@@ -106,8 +106,8 @@ namespace rta
 
     bool EncodedRtIp11TopLevelBvh::PostLoad()
     {
+        ScanTree();
         bool result = BuildInstanceList();
-        ScanTreeDepth();
         instance_surface_area_heuristic_.resize(instance_nodes_.size(), 0);
         return result;
     }
@@ -158,93 +158,53 @@ namespace rta
             return true;
         }
 
-        std::deque<std::pair<dxr::amd::NodePointer, std::uint32_t>> traversal_stack;
+        // The instance nodes were found by ScanTree(), so only the leaf list needs to be walked here.
+        const auto& scanned_counts           = GetScannedNodeCounts();
+        uint64_t    num_traversal_node_count = static_cast<uint64_t>(scanned_counts.box32) + scanned_counts.box16;
 
-        const auto& interior_nodes = GetInteriorNodesData();
-
-        // Top level node doesn't exist in the data so needs to be created. Assumed to be a Box32.
-        dxr::amd::NodePointer root_ptr                 = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
-        uint64_t              num_traversal_node_count = 0;
-
-        // Assume there's a single root node.
-        auto box_nodes_per_interior_node = 1;
-
-        traversal_stack.push_back(std::make_pair(root_ptr, 0));
+        // The BLAS index and node pointer of each instance, in traversal order.
+        std::vector<uint64_t>              instance_blas_indices;
+        std::vector<dxr::amd::NodePointer> instance_node_ptrs;
+        instance_blas_indices.reserve(scanned_counts.instance);
+        instance_node_ptrs.reserve(scanned_counts.instance);
 
         const auto& header_offsets = header_->GetBufferOffsets();
-        while (!traversal_stack.empty())
+        const auto& instance_nodes = GetInstanceNodes();
+        for (const auto& node_ptr : GetLeafNodes())
         {
-            auto front    = traversal_stack.front();
-            auto node_ptr = front.first;
-            auto level    = front.second;
+            if (!node_ptr.IsInstanceNode())
+            {
+                continue;
+            }
 
-            traversal_stack.pop_front();
+            auto byte_offset = node_ptr.GetByteOffset() - header_offsets.leaf_nodes;
 
-            if (node_ptr.IsInstanceNode())
-            {
-                auto byte_offset = node_ptr.GetByteOffset() - header_offsets.leaf_nodes;
+            uint32_t instance_node_size = sizeof(dxr::amd::InstanceNode);
+            uint32_t instance_index     = byte_offset / instance_node_size;
 
-                uint32_t instance_node_size = sizeof(dxr::amd::InstanceNode);
-                uint32_t instance_index     = byte_offset / instance_node_size;
+            if (instance_index < instance_nodes.size())
+            {
+                const dxr::amd::InstanceNode* instance_node = &instance_nodes[instance_index];
+                const auto&                   desc          = instance_node->GetDesc();
+                num_traversal_node_count++;
 
-                const auto& instance_nodes = GetInstanceNodes();
-                if (instance_index < instance_nodes.size())
+                // Inactive instances are not given a relative BLAS reference, so their BLAS address is still a raw
+                // GPU address. They don't reference a BLAS, so they are left out of the per-BLAS lists.
+                if (instance_node->IsInactive())
                 {
-                    const dxr::amd::InstanceNode* instance_node = &instance_nodes[instance_index];
-                    const auto&                   desc          = instance_node->GetDesc();
-
-                    uint64_t              blas_index = desc.GetBottomLevelBvhGpuVa(dxr::InstanceDescType::kRaw) >> 3;
-                    uint32_t              address    = (instance_index * sizeof(dxr::amd::InstanceNode)) + header_offsets.leaf_nodes;
-                    dxr::amd::NodePointer new_node   = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeInstance, address);
-
-                    if (instance_list_.find(blas_index) == instance_list_.end())
-                    {
-                        std::vector<dxr::amd::NodePointer> node_list = {new_node};
-                        instance_list_.insert(std::make_pair(blas_index, node_list));
-                    }
-                    else
-                    {
-                        instance_list_[blas_index].push_back(new_node);
-                    }
-                    num_traversal_node_count++;
-                }
-                else
-                {
-                    RRA_ASSERT_MESSAGE(false, "Instance pointer out of range");
+                    continue;
                 }
-            }
 
-            for (auto count = 0; count < box_nodes_per_interior_node; count++)
+                uint64_t              blas_index = desc.GetBottomLevelBvhGpuVa(dxr::InstanceDescType::kRaw) >> 3;
+                uint32_t              address    = (instance_index * sizeof(dxr::amd::InstanceNode)) + header_offsets.leaf_nodes;
+                dxr::amd::NodePointer new_node   = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeInstance, address);
+
+                instance_blas_indices.push_back(blas_index);
+                instance_node_ptrs.push_back(new_node);
+            }
+            else
             {
-                if (node_ptr.IsBoxNode())
-                {
-                    num_traversal_node_count++;
-                    auto byte_offset = node_ptr.GetByteOffset() - header_offsets.interior_nodes;
-
-                    if (node_ptr.IsFp32BoxNode())
-                    {
-                        const auto node = reinterpret_cast<const dxr::amd::Float32BoxNode*>(&interior_nodes[byte_offset]);
-                        for (const auto& ptr : node->GetChildren())
-                        {
-                            if (!ptr.IsInvalid())
-                            {
-                                traversal_stack.push_back(std::make_pair(ptr, level + 1));
-                            }
-                        }
-                    }
-
-                    else if (node_ptr.IsFp16BoxNode())
-                    {
-                        const auto node = reinterpret_cast<const dxr::amd::Float16BoxNode*>(&interior_nodes[byte_offset]);
-                        for (const auto& ptr : node->GetChildren())
-                        {
-                            if (!ptr.IsInvalid())
-                            {
-                                traversal_stack.push_back(std::make_pair(ptr, level + 1));
-                            }
-                        }
-                    }
-                }
+                RRA_ASSERT_MESSAGE(false, "Instance pointer out of range");
             }
         }
 
@@ -252,6 +212,57 @@ namespace rta
         {
             return false;
         }
+
+        if (instance_node_ptrs.empty())
+        {
+            return true;
+        }
+
+        // Group the instances by BLAS with a counting sort. The BLAS indices are relative references
+        // into the BLAS list, so they are dense and can index the count array directly.
+        const uint64_t        max_blas_index = *std::max_element(instance_blas_indices.begin(), instance_blas_indices.end());
+        std::vector<uint32_t> counts(max_blas_index + 1, 0);
+        for (uint64_t blas_index : instance_blas_indices)
+        {
+            counts[blas_index]++;
+        }
+
+        referenced_blas_indices_.clear();
+        instance_list_offsets_.clear();
+        uint32_t offset = 0;
+        for (uint64_t blas_index = 0; blas_index <= max_blas_index; blas_index++)
+        {
+            if (counts[blas_index] > 0)
+            {
+                referenced_blas_indices_.push_back(blas_index);
+                instance_list_offsets_.push_back(offset);
+
+                // Reuse the count as the next write position for this BLAS.
+                uint32_t count     = counts[blas_index];
+                counts[blas_index] = offset;
+                offset += count;
+            }
+        }
+        instance_list_offsets_.push_back(offset);
+
+        // Scatter in traversal order, so each BLAS keeps its instances in the order they were found.
+        instance_list_.resize(instance_node_ptrs.size());
+        for (size_t i = 0; i < instance_node_ptrs.size(); i++)
+        {
+            instance_list_[counts[instance_blas_indices[i]]++] = instance_node_ptrs[i];
+        }
+
+        return true;
+    }
+
+    bool EncodedRtIp11TopLevelBvh::FindReferencedBlas(uint64_t blas_index, size_t* out_position) const
+    {
+        auto iter = std::lower_bound(referenced_blas_indices_.begin(), referenced_blas_indices_.end(), blas_index);
+        if (iter == referenced_blas_indices_.end() || *iter != blas_index)
+        {
+            return false;
+        }
+        *out_position = iter - referenced_blas_indices_.begin();
         return true;
     }
 
@@ -270,13 +281,13 @@ namespace rta
 
     uint64_t EncodedRtIp11TopLevelBvh::GetBlasCount(bool empty_placeholder) const
     {
-        auto size = instance_list_.size();
+        auto size = referenced_blas_indices_.size();
         if (empty_placeholder && size)
         {
             // If there are instances referencing the missing blas index, ignore it as a valid BLAS.
+            // The indices are sorted, so the missing index (0) can only be first.
             uint64_t missing_blas_index = 0;
-            auto iter = instance_list_.find(missing_blas_index);
-            if (iter != instance_list_.end())
+            if (referenced_blas_indices_.front() == missing_blas_index)
             {
                 return size - 1;
             }
@@ -284,14 +295,14 @@ namespace rta
         return size;
     }
 
-    uint64_t EncodedRtIp11TopLevelBvh::GetReferencedBlasMemorySize() const
+    uint64_t EncodedRtIp11TopLevelBvh::GetReferencedBlasMemorySize(RraContext* context) const
     {
         uint64_t total_memory = 0;
 
-        for (const auto& it : instance_list_)
+        for (uint64_t blas_index : referenced_blas_indices_)
         {
             uint32_t     blas_memory = 0;
-            RraErrorCode status      = RraBlasGetSizeInBytes(it.first, &blas_memory);
+            RraErrorCode status      = RraContextBlasGetSizeInBytes(context, blas_index, &blas_memory);
             RRA_ASSERT(status == kRraOk);
             if (status == kRraOk)
             {
@@ -301,29 +312,30 @@ namespace rta
         return total_memory;
     }
 
-    uint64_t EncodedRtIp11TopLevelBvh::GetTotalTriangleCount() const
+    uint64_t EncodedRtIp11TopLevelBvh::GetTotalTriangleCount(RraContext* context) const
     {
         uint64_t triangle_count = 0;
-        for (const auto& it : instance_list_)
+        for (size_t i = 0; i < referenced_blas_indices_.size(); i++)
         {
             uint32_t     blas_triangles = 0;
-            RraErrorCode status         = RraBlasGetUniqueTriangleCount(it.first, &blas_triangles);
+            RraErrorCode status         = RraContextBlasGetUniqueTriangleCount(context, referenced_blas_indices_[i], &blas_triangles);
             RRA_ASSERT(status == kRraOk);
             if (status == kRraOk)
             {
-                triangle_count += static_cast<uint64_t>(blas_triangles) * it.second.size();
+                uint64_t instance_count = instance_list_offsets_[i + 1] - instance_list_offsets_[i];
+                triangle_count += static_cast<uint64_t>(blas_triangles) * instance_count;
             }
         }
         return triangle_count;
     }
 
-    uint64_t EncodedRtIp11TopLevelBvh::GetUniqueTriangleCount() const
+    uint64_t EncodedRtIp11TopLevelBvh::GetUniqueTriangleCount(RraContext* context) const
     {
         uint64_t triangle_count = 0;
-        for (const auto& it : instance_list_)
+        for (uint64_t blas_index : referenced_blas_indices_)
         {
             uint32_t     blas_triangles = 0;
-            RraErrorCode status         = RraBlasGetUniqueTriangleCount(it.first, &blas_triangles);
+            RraErrorCode status         = RraContextBlasGetUniqueTriangleCount(context, blas_index, &blas_triangles);
             RRA_ASSERT(status == kRraOk);
             if (status == kRraOk)
             {
@@ -335,29 +347,52 @@ namespace rta
 
     uint64_t EncodedRtIp11TopLevelBvh::GetInstanceCount(uint64_t index) const
     {
-        auto iter = instance_list_.find(index);
-        if (iter != instance_list_.end())
+        size_t position = 0;
+        if (FindReferencedBlas(index, &position))
         {
-            return iter->second.size();
+            return instance_list_offsets_[position + 1] - instance_list_offsets_[position];
         }
         return 0;
     }
 
     dxr::amd::NodePointer EncodedRtIp11TopLevelBvh::GetInstanceNode(uint64_t blas_index, uint64_t instance_index) const
     {
-        size_t num_instances = 0;
-        auto   iter          = instance_list_.find(blas_index);
-        if (iter != instance_list_.end())
+        uint64_t                     num_instances = 0;
+        const dxr::amd::NodePointer* instances     = GetInstanceList(blas_index, &num_instances);
+        if (instances != nullptr && instance_index < num_instances)
         {
-            num_instances = iter->second.size();
-            if (instance_index < num_instances)
-            {
-                return iter->second[instance_index];
-            }
+            return instances[instance_index];
         }
         return dxr::amd::kInvalidNode;
     }
 
+    const dxr::amd::NodePointer* EncodedRtIp11TopLevelBvh::GetInstanceList(uint64_t blas_index, uint64_t* out_instance_count) const
+    {
+        size_t position = 0;
+        if (FindReferencedBlas(blas_index, &position))
+        {
+            *out_instance_count = instance_list_offsets_[position + 1] - instance_list_offsets_[position];
+            return &instance_list_[instance_list_offsets_[position]];
+        }
+        *out_instance_count = 0;
+        return nullptr;
+    }
+
+    const std::vector<uint64_t>& EncodedRtIp11TopLevelBvh::GetReferencedBlasIndices() const
+    {
+        return referenced_blas_indices_;
+    }
+
+    const std::vector<uint32_t>& EncodedRtIp11TopLevelBvh::GetInstanceListOffsets() const
+    {
+        return instance_list_offsets_;
+    }
+
+    const std::vector<dxr::amd::NodePointer>& EncodedRtIp11TopLevelBvh::GetInstanceListNodes() const
+    {
+        return instance_list_;
+    }
+
     float EncodedRtIp11TopLevelBvh::GetLeafNodeSurfaceAreaHeuristic(const dxr::amd::NodePointer node_ptr) const
     {
         const uint32_t byte_offset = node_ptr.GetByteOffset();
@@ -13,6 +13,7 @@
 
 #include "bvh/iencoded_rt_ip_11_bvh.h"
 #include "bvh/node_types/instance_node.h"
+#include "public/rra_context.h"
 
 namespace rta
 {
@@ -88,8 +89,10 @@ namespace rta
 
         /// @brief Get the memory size for all the BLASes referenced by this TLAS.
         ///
+        /// @param [in] context The context holding the loaded trace, used to look up the BLASes.
+        ///
         /// @return The total memory for all referenced BLASes, in bytes.
-        uint64_t GetReferencedBlasMemorySize() const;
+        uint64_t GetReferencedBlasMemorySize(RraContext* context) const;
 
         /// @brief Get the total triangle count for this TLAS.
         ///
@@ -99,15 +102,19 @@ namespace rta
         /// For each instance node, add the total number of triangles in the BLAS
         /// the instance node references.
         ///
+        /// @param [in] context The context holding the loaded trace, used to look up the BLASes.
+        ///
         /// @return The total number of triangles.
-        uint64_t GetTotalTriangleCount() const;
+        uint64_t GetTotalTriangleCount(RraContext* context) const;
 
         /// @brief Get the unique triangle count for this TLAS.
         ///
         /// This is the sum of triangles in each BLAS referenced by the TLAS.
         ///
+        /// @param [in] context The context holding the loaded trace, used to look up the BLASes.
+        ///
         /// @return The number unique of triangles.
-        uint64_t GetUniqueTriangleCount() const;
+        uint64_t GetUniqueTriangleCount(RraContext* context) const;
 
         /// @brief Get the instance node for a given blas index and instance index.
         ///
@@ -117,6 +124,32 @@ namespace rta
         /// @return The instance node.
         dxr::amd::NodePointer GetInstanceNode(uint64_t blas_index, uint64_t instance_index) const;
 
+        /// @brief Get the list of instance nodes referencing a given BLAS.
+        ///
+        /// @param [in]  blas_index         The index of the BLAS.
+        /// @param [out] out_instance_count The number of instance nodes in the list.
+        ///
+        /// @return A pointer to the first instance node in the list, or nullptr if the BLAS isn't referenced by this TLAS.
+        const dxr::amd::NodePointer* GetInstanceList(uint64_t blas_index, uint64_t* out_instance_count) const;
+
+        /// @brief Get the indices of all the BLASes referenced by this TLAS.
+        ///
+        /// @return The BLAS indices, sorted in ascending order.
+        const std::vector<uint64_t>& GetReferencedBlasIndices() const;
+
+        /// @brief Get the offsets of the instance lists for each referenced BLAS.
+        ///
+        /// The instances of the BLAS at GetReferencedBlasIndices()[i] are the instance nodes from offset
+        /// i up to offset i + 1. There is one more offset than there are referenced BLASes.
+        ///
+        /// @return The instance list offsets.
+        const std::vector<uint32_t>& GetInstanceListOffsets() const;
+
+        /// @brief Get the instance nodes for all referenced BLASes.
+        ///
+        /// @return The instance nodes, grouped by BLAS in the order of GetReferencedBlasIndices().
+        const std::vector<dxr::amd::NodePointer>& GetInstanceListNodes() const;
+
         /// @brief Get the surface area heuristic for a given leaf node.
         ///
         /// @param [in] node_ptr The leaf node whose SAH is to be found.
@@ -140,18 +173,30 @@ namespace rta
 
         /// @brief Build the list for the number of instances of each BLAS.
         ///
+        /// Uses the leaf nodes found by ScanTree(), so must be called after it.
+        ///
         /// @return true if the build succeeded, false if error.
         bool BuildInstanceList();
 
+        /// @brief Find the position of a BLAS in the referenced BLAS list.
+        ///
+        /// @param [in]  blas_index   The index of the BLAS.
+        /// @param [out] out_position The position of the BLAS in referenced_blas_indices_.
+        ///
+        /// @return true if the BLAS is referenced by this TLAS, false if not.
+        bool FindReferencedBlas(uint64_t blas_index, size_t* out_position) const;
+
         /// @brief Derived class implementation of GetInactiveInstanceCount().
         ///
         /// @return The number of inactive instances.
         virtual uint64_t GetInactiveInstanceCountImpl() const override;
 
-        std::vector<dxr::amd::InstanceNode>                              instance_nodes_      = {};  ///< The list of instance nodes.
-        std::vector<dxr::amd::NodePointer>                               primitive_node_ptrs_ = {};  ///< The list of primitive node pointers.
-        std::unordered_map<uint64_t, std::vector<dxr::amd::NodePointer>> instance_list_       = {};  ///< A map of BLAS index to list of instances of that BLAS.
-        std::vector<float> instance_surface_area_heuristic_                                   = {};  ///< Surface area heuristic values for the instances.
+        std::vector<dxr::amd::InstanceNode> instance_nodes_                  = {};  ///< The list of instance nodes.
+        std::vector<dxr::amd::NodePointer>  primitive_node_ptrs_             = {};  ///< The list of primitive node pointers.
+        std::vector<uint64_t>               referenced_blas_indices_         = {};  ///< The BLASes referenced by the instances, sorted by index.
+        std::vector<uint32_t>               instance_list_offsets_           = {};  ///< Start of each referenced BLAS's instances in instance_list_, plus the end.
+        std::vector<dxr::amd::NodePointer>  instance_list_                   = {};  ///< The instance nodes, grouped by BLAS.
+        std::vector<float>                  instance_surface_area_heuristic_ = {};  ///< Surface area heuristic values for the instances.
     };
 }  // namespace rta
 
@@ -31,5 +31,21 @@ namespace dxr
         {
             return primitive_node_ptrs_offset_;
         }
+
+        void GeometryInfo::SetGeometryFlagsAndPrimitiveCount(const GeometryFlags flags, const std::uint32_t count)
+        {
+            geometry_flags  = static_cast<std::uint32_t>(flags);
+            primitive_count = count;
+        }
+
+        void GeometryInfo::SetGeometryBufferOffset(const std::uint32_t geometry_buffer_offset)
+        {
+            geometry_buffer_offset_ = geometry_buffer_offset;
+        }
+
+        void GeometryInfo::SetPrimitiveNodePtrsOffset(const std::uint32_t primitive_node_ptrs_offset)
+        {
+            primitive_node_ptrs_offset_ = primitive_node_ptrs_offset;
+        }
     }  // namespace amd
 }  // namespace dxr
@@ -38,6 +38,22 @@ namespace dxr
             /// @return The primitive node pointer offset.
             std::uint32_t GetPrimitiveNodePtrsOffset() const;
 
+            /// @brief Set the geometry flags and primitive count.
+            ///
+            /// @param flags The geometry flags.
+            /// @param count The primitive count.
+            void SetGeometryFlagsAndPrimitiveCount(const GeometryFlags flags, const std::uint32_t count);
+
+            /// @brief Set the offset to the geometry's leaf nodes.
+            ///
+            /// @param geometry_buffer_offset The byte offset.
+            void SetGeometryBufferOffset(const std::uint32_t geometry_buffer_offset);
+
+            /// @brief Set the offset to the primitive node pointers.
+            ///
+            /// @param primitive_node_ptrs_offset The byte offset from the first primitive node pointer.
+            void SetPrimitiveNodePtrsOffset(const std::uint32_t primitive_node_ptrs_offset);
+
         private:
             union  ///< Encodes the geometry flags (opaque, non_opaque, ...) and number of primitives.
             {
@@ -10,7 +10,6 @@
 #include <iostream>
 #include <vector>
 #include <cassert>
-#include <deque>
 #include <unordered_set>
 #include <float.h>
 
@@ -328,6 +327,8 @@ namespace rta
         const size_t num_box_nodes = header_->GetInteriorNodeCount();
 
         box_surface_area_heuristic_.resize(num_box_nodes, 0);
+        box_overlap_area_.resize(num_box_nodes, 0);
+        box_overlap_volume_.resize(num_box_nodes, 0);
     }
 
     void IEncodedRtIp11Bvh::SetRelativeReferences(const std::unordered_map<GpuVirtualAddress, std::uint64_t>& reference_map,
@@ -392,81 +393,118 @@ namespace rta
         const auto  compression_mode  = ToDxrTriangleCompressionMode(GetHeader().GetPostBuildInfo().GetTriangleCompressionMode());
         const auto  parent_link_index = node_ptr->CalculateParentLinkIndex(parent_data.GetSizeInBytes(), compression_mode);
 
-        assert(parent_link_index < parent_data.GetLinkCount());
+        // A node pointer that doesn't belong to this BVH can map past the end of the parent links.
+        if (parent_link_index >= parent_data.GetLinkCount())
+        {
+            return dxr::amd::NodePointer();
+        }
 
         dxr::amd::NodePointer parent_node = parent_links[parent_link_index];
 
         return parent_node;
     }
 
-    void IEncodedRtIp11Bvh::ScanTreeDepth()
+    void IEncodedRtIp11Bvh::ScanTree()
     {
+        max_tree_depth_      = 0;
+        avg_tree_depth_      = 0;
+        scanned_node_counts_ = {};
+        level_node_counts_.clear();
+        leaf_nodes_.clear();
+
         size_t num_box_nodes = header_->GetInteriorNodeCount();
         if (num_box_nodes == 0)
         {
             return;
         }
 
-        std::deque<std::pair<dxr::amd::NodePointer, std::uint32_t>> traversal_stack;
+        // The level lists are reused for every BVH scanned on this thread, so they only grow to the widest level seen.
+        static thread_local std::vector<dxr::amd::NodePointer> current_level;
+        static thread_local std::vector<dxr::amd::NodePointer> next_level;
+        current_level.clear();
+        next_level.clear();
 
         const auto& interior_nodes = GetInteriorNodesData();
+        const auto& header_offsets = header_->GetBufferOffsets();
 
         // Top level node doesn't exist in the data so needs to be created. Assumed to be a Box32.
-        dxr::amd::NodePointer root_ptr = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
+        current_level.push_back(dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize));
+        leaf_nodes_.reserve(header_->GetLeafNodeCount());
 
-        // Assume there's a single root node.
-        auto box_nodes_per_interior_node = 1;
-
-        traversal_stack.push_back(std::make_pair(root_ptr, 0));
-
-        const auto& header_offsets = header_->GetBufferOffsets();
-        uint64_t    depth_sum      = 0;
-        uint32_t    leaf_count     = 0;
-        while (!traversal_stack.empty())
+        uint64_t depth_sum = 0;
+        for (uint32_t level = 0; !current_level.empty(); level++)
         {
-            auto index_to_level = traversal_stack.front();
-            auto node_ptr       = index_to_level.first;
-            auto level          = index_to_level.second;
+            BvhNodeTypeCounts level_counts = {};
 
-            max_tree_depth_ = std::max(max_tree_depth_, level + 1);
-
-            traversal_stack.pop_front();
-
-            for (auto count = 0; count < box_nodes_per_interior_node; count++)
+            for (const auto& node_ptr : current_level)
             {
-                auto byte_offset = node_ptr.GetByteOffset() - header_offsets.interior_nodes;
-                if (node_ptr.IsFp32BoxNode())
+                if (node_ptr.IsBoxNode())
                 {
-                    const auto node = reinterpret_cast<const dxr::amd::Float32BoxNode*>(&interior_nodes[byte_offset]);
-                    for (const auto& ptr : node->GetChildren())
+                    auto byte_offset = node_ptr.GetByteOffset() - header_offsets.interior_nodes;
+                    if (byte_offset >= interior_nodes.size())
+                    {
+                        RRA_ASSERT_MESSAGE(false, "Box node pointer out of range");
+                        continue;
+                    }
+
+                    if (node_ptr.IsFp32BoxNode())
                     {
-                        if (!ptr.IsInvalid())
+                        level_counts.box32++;
+                        const auto node = reinterpret_cast<const dxr::amd::Float32BoxNode*>(&interior_nodes[byte_offset]);
+                        for (const auto& ptr : node->GetChildren())
                         {
-                            traversal_stack.push_back(std::make_pair(ptr, level + 1));
+                            if (!ptr.IsInvalid())
+                            {
+                                next_level.push_back(ptr);
+                            }
                         }
                     }
-                }
-                else if (node_ptr.IsFp16BoxNode())
-                {
-                    const auto node = reinterpret_cast<const dxr::amd::Float16BoxNode*>(&interior_nodes[byte_offset]);
-                    for (const auto& ptr : node->GetChildren())
+                    else if (node_ptr.IsFp16BoxNode())
                     {
-                        if (!ptr.IsInvalid())
+                        level_counts.box16++;
+                        const auto node = reinterpret_cast<const dxr::amd::Float16BoxNode*>(&interior_nodes[byte_offset]);
+                        for (const auto& ptr : node->GetChildren())
                         {
-                            traversal_stack.push_back(std::make_pair(ptr, level + 1));
+                            if (!ptr.IsInvalid())
+                            {
+                                next_level.push_back(ptr);
+                            }
                         }
                     }
+                    continue;
                 }
-                else if (node_ptr.IsTriangleNode())
+
+                leaf_nodes_.push_back(node_ptr);
+                if (node_ptr.IsTriangleNode())
                 {
-                    leaf_count++;
+                    level_counts.triangle++;
                     depth_sum += static_cast<uint64_t>(level) + 1;
                 }
+                else if (node_ptr.IsProceduralNode())
+                {
+                    level_counts.procedural++;
+                }
+                else if (node_ptr.IsInstanceNode())
+                {
+                    level_counts.instance++;
+                }
             }
+
+            scanned_node_counts_.box32 += level_counts.box32;
+            scanned_node_counts_.box16 += level_counts.box16;
+            scanned_node_counts_.triangle += level_counts.triangle;
+            scanned_node_counts_.procedural += level_counts.procedural;
+            scanned_node_counts_.instance += level_counts.instance;
+            level_node_counts_.push_back(level_counts);
+
+            std::swap(current_level, next_level);
+            next_level.clear();
         }
-        if (leaf_count > 0)
+
+        max_tree_depth_ = static_cast<uint32_t>(level_node_counts_.size());
+        if (scanned_node_counts_.triangle > 0)
         {
-            depth_sum /= leaf_count;
+            depth_sum /= scanned_node_counts_.triangle;
         }
         avg_tree_depth_ = static_cast<uint32_t>(depth_sum);
     }
@@ -487,6 +525,38 @@ namespace rta
         box_surface_area_heuristic_[index] = surface_area_heuristic;
     }
 
+    float IEncodedRtIp11Bvh::GetInteriorNodeOverlapArea(const dxr::amd::NodePointer node_ptr) const
+    {
+        const uint32_t index = (node_ptr.GetByteOffset() - GetHeader().GetBufferOffsets().interior_nodes) / sizeof(dxr::amd::Float32BoxNode);
+        RRA_ASSERT(index < box_overlap_area_.size());
+        return box_overlap_area_[index];
+    }
+
+    float IEncodedRtIp11Bvh::GetInteriorNodeOverlapVolume(const dxr::amd::NodePointer node_ptr) const
+    {
+        const uint32_t index = (node_ptr.GetByteOffset() - GetHeader().GetBufferOffsets().interior_nodes) / sizeof(dxr::amd::Float32BoxNode);
+        RRA_ASSERT(index < box_overlap_volume_.size());
+        return box_overlap_volume_[index];
+    }
+
+    void IEncodedRtIp11Bvh::SetInteriorNodeOverlap(const dxr::amd::NodePointer node_ptr, float overlap_area, float overlap_volume)
+    {
+        const uint32_t index = (node_ptr.GetByteOffset() - GetHeader().GetBufferOffsets().interior_nodes) / sizeof(dxr::amd::Float32BoxNode);
+        RRA_ASSERT(index < box_overlap_area_.size());
+        box_overlap_area_[index]   = overlap_area;
+        box_overlap_volume_[index] = overlap_volume;
+    }
+
+    const BvhOverlapStats& IEncodedRtIp11Bvh::GetOverlapStats() const
+    {
+        return overlap_stats_;
+    }
+
+    void IEncodedRtIp11Bvh::SetOverlapStats(const BvhOverlapStats& overlap_stats)
+    {
+        overlap_stats_ = overlap_stats;
+    }
+
     uint32_t IEncodedRtIp11Bvh::GetMaxTreeDepth() const
     {
         return max_tree_depth_;
@@ -497,4 +567,19 @@ namespace rta
         return avg_tree_depth_;
     }
 
+    const BvhNodeTypeCounts& IEncodedRtIp11Bvh::GetScannedNodeCounts() const
+    {
+        return scanned_node_counts_;
+    }
+
+    const std::vector<BvhNodeTypeCounts>& IEncodedRtIp11Bvh::GetLevelNodeCounts() const
+    {
+        return level_node_counts_;
+    }
+
+    const std::vector<dxr::amd::NodePointer>& IEncodedRtIp11Bvh::GetLeafNodes() const
+    {
+        return leaf_nodes_;
+    }
+
 }  // namespace rta
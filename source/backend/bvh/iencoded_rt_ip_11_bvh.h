@@ -96,6 +96,31 @@ namespace rta
         kDefault    = kAll
     };
 
+    /// @brief The number of nodes of each type reached by the post-load scan.
+    struct BvhNodeTypeCounts
+    {
+        std::uint32_t box32      = 0;  ///< The number of FP32 box nodes.
+        std::uint32_t box16      = 0;  ///< The number of FP16 box nodes.
+        std::uint32_t triangle   = 0;  ///< The number of triangle nodes.
+        std::uint32_t procedural = 0;  ///< The number of procedural nodes.
+        std::uint32_t instance   = 0;  ///< The number of instance nodes.
+    };
+
+    static const std::uint32_t kOverlapHistogramBinCount = 10;  ///< The number of bins in the node overlap histograms.
+
+    /// @brief A summary of the sibling overlap and leaf tightness of the nodes in a BVH.
+    ///
+    /// The histogram bins cover [0, 1] in equal steps. The last bin also counts values above 1.
+    struct BvhOverlapStats
+    {
+        float                                                mean_overlap_area        = 0.0f;  ///< The mean sibling overlap area of the box nodes.
+        float                                                mean_overlap_volume      = 0.0f;  ///< The mean sibling overlap volume of the box nodes.
+        float                                                mean_leaf_tightness      = 0.0f;  ///< The mean leaf tightness of the triangle nodes.
+        std::array<std::uint32_t, kOverlapHistogramBinCount> overlap_area_histogram   = {};    ///< The box nodes binned by sibling overlap area.
+        std::array<std::uint32_t, kOverlapHistogramBinCount> overlap_volume_histogram = {};    ///< The box nodes binned by sibling overlap volume.
+        std::array<std::uint32_t, kOverlapHistogramBinCount> leaf_tightness_histogram = {};    ///< The triangle nodes binned by leaf tightness.
+    };
+
     /// @brief Base class for a ray-tracing IP 1.1-based BVH. This corresponds to Navi2x ray tracing.
     class IEncodedRtIp11Bvh : public IBvh
     {
@@ -216,8 +241,8 @@ namespace rta
         ///
         /// @param [in] node_ptr The node whose parent is to be found.
         ///
-        /// @return The parent node. If the node passed in is the root node, the
-        /// parent node will be an invalid node.
+        /// @return The parent node. If the node passed in is the root node, or its parent link is
+        /// outside the parent data, the parent node will be an invalid node.
         dxr::amd::NodePointer GetParentNode(const dxr::amd::NodePointer* node_ptr) const;
 
         /// @brief Get the surface area heuristic for a given leaf node.
@@ -236,6 +261,29 @@ namespace rta
         /// @return The surface area heuristic.
         float GetInteriorNodeSurfaceAreaHeuristic(const dxr::amd::NodePointer node_ptr) const;
 
+        /// @brief Get the sibling overlap area for a given interior node.
+        ///
+        /// This is the surface area of the pairwise intersections of the node's children, relative to the node's surface area.
+        ///
+        /// @param [in] node_ptr The interior node whose overlap is to be found.
+        ///
+        /// @return The sibling overlap area.
+        float GetInteriorNodeOverlapArea(const dxr::amd::NodePointer node_ptr) const;
+
+        /// @brief Get the sibling overlap volume for a given interior node.
+        ///
+        /// This is the volume of the pairwise intersections of the node's children, relative to the node's volume.
+        ///
+        /// @param [in] node_ptr The interior node whose overlap is to be found.
+        ///
+        /// @return The sibling overlap volume.
+        float GetInteriorNodeOverlapVolume(const dxr::amd::NodePointer node_ptr) const;
+
+        /// @brief Get the summary of the node overlap metrics for this BVH.
+        ///
+        /// @return The overlap summary.
+        const BvhOverlapStats& GetOverlapStats() const;
+
         /// @brief Get the maximum tree depth of this BVH.
         ///
         /// @return The maximum tree depth.
@@ -246,12 +294,39 @@ namespace rta
         /// @return The average tree depth.
         uint32_t GetAvgTreeDepth() const;
 
+        /// @brief Get the number of nodes of each type reached when scanning the tree.
+        ///
+        /// @return The node counts.
+        const BvhNodeTypeCounts& GetScannedNodeCounts() const;
+
+        /// @brief Get the number of nodes of each type on each level of the tree.
+        ///
+        /// @return The node counts, indexed by level. Level 0 is the root.
+        const std::vector<BvhNodeTypeCounts>& GetLevelNodeCounts() const;
+
+        /// @brief Get the leaf nodes reachable from the root, in breadth-first order.
+        ///
+        /// @return The leaf node pointers.
+        const std::vector<dxr::amd::NodePointer>& GetLeafNodes() const;
+
         /// @brief Set the surface area heuristic for a given interior node.
         ///
         /// @param [in] node_ptr               The interior node whose SAH is to be set.
         /// @param [in] surface_area_heuristic The surface area heuristic value to be set.
         void SetInteriorNodeSurfaceAreaHeuristic(const dxr::amd::NodePointer node_ptr, float surface_area_heuristic);
 
+        /// @brief Set the sibling overlap for a given interior node.
+        ///
+        /// @param [in] node_ptr       The interior node whose overlap is to be set.
+        /// @param [in] overlap_area   The sibling overlap area.
+        /// @param [in] overlap_volume The sibling overlap volume.
+        void SetInteriorNodeOverlap(const dxr::amd::NodePointer node_ptr, float overlap_area, float overlap_volume);
+
+        /// @brief Set the summary of the node overlap metrics for this BVH.
+        ///
+        /// @param [in] overlap_stats The overlap summary.
+        void SetOverlapStats(const BvhOverlapStats& overlap_stats);
+
         /// @brief Get the box32 node associated with the node pointer.
         ///
         /// Assumes that the node pointer passed in is a box32 node.
@@ -300,8 +375,11 @@ namespace rta
         const bool IsHalfBoxNode(const dxr::amd::NodePointer node_pointer) const;
 
     protected:
-        /// @brief Scan the tree to get the maximum and average tree depths.
-        void ScanTreeDepth();
+        /// @brief Scan the tree once after loading.
+        ///
+        /// Gets the maximum and average tree depths, the node counts per level and
+        /// the list of leaf nodes, all in a single breadth-first pass.
+        void ScanTree();
 
         /// @brief Load the common BVH data from the file.
         ///
@@ -328,11 +406,19 @@ namespace rta
         std::vector<std::uint8_t>                           interior_nodes_             = {};       ///< Interior nodes in bvh, bboxes are either FP32 or FP16.
         bool                                                is_compacted_               = false;    ///< States whether this BVH was compacted or not.
         std::vector<float>                                  box_surface_area_heuristic_ = {};  ///< Surface area heuristic values for the interior box nodes.
+        std::vector<float>                                  box_overlap_area_           = {};  ///< Sibling overlap areas for the interior box nodes.
+        std::vector<float>                                  box_overlap_volume_         = {};  ///< Sibling overlap volumes for the interior box nodes.
+        BvhOverlapStats                                     overlap_stats_              = {};  ///< The summary of the node overlap metrics.
         uint32_t                                            max_tree_depth_             = 0;   ///< The maximum depth of the BVH tree.
         uint32_t                                            avg_tree_depth_             = 0;   ///< The average depth of a triangle node in the BVH tree.
+        BvhNodeTypeCounts                                   scanned_node_counts_        = {};  ///< The node counts for the whole tree.
+        std::vector<BvhNodeTypeCounts>                      level_node_counts_          = {};  ///< The node counts for each level of the tree.
+        std::vector<dxr::amd::NodePointer>                  leaf_nodes_                 = {};  ///< The leaf nodes, in breadth-first order.
         uint64_t                                            gpu_virtual_address_        = 0;   ///< The GPU virtual address.
 
     private:
+        friend struct ScanTreeBenchmarkAccess;  ///< Lets the backend benchmarks time ScanTree() on a loaded trace.
+
         /// @brief Is this acceleration structure compacted.
         ///
         /// @return true if compacted, false if not.
@@ -12,6 +12,7 @@
 
 #include "bvh/dxr_definitions.h"
 #include "bvh/irt_ip_11_acceleration_structure_post_build_info.h"
+#include "bvh/node_types/instance_node.h"
 #include "bvh/rt_binary_file_defs.h"
 
 #include "public/rra_macro.h"
@@ -47,6 +48,27 @@ namespace rta
         std::uint32_t build_time_hash_ = 0;  ///< The hash generated at build time.
     };
 
+    /// @brief The raw layout of the acceleration structure header, as written by the driver.
+    struct DxrAccelerationStructureHeader
+    {
+        std::uint32_t                      build_info;                       ///< The build info flags.
+        std::uint32_t                      meta_data_size_in_bytes;          ///< The size of the metadata, in bytes.
+        std::uint32_t                      file_size_in_bytes;               ///< The size of the acceleration structure, in bytes.
+        std::uint32_t                      primitive_count;                  ///< Num Primitives, 0 for Blas
+        std::uint32_t                      active_primitive_count;           ///< The number of active primitives.
+        std::uint32_t                      task_id_counter;                  ///< The task ID count.
+        std::uint32_t                      desc_count;                       ///< The number of descriptors.
+        dxr::GeometryType                  geometry_type;                    ///< Type of primitive contained in blas, invalid for tlas.
+        AccelerationStructureBufferOffsets offsets;                          ///< Offsets to the node and primitive data relative to start of this header.
+        std::uint32_t                      interior_fp32_node_count;         ///< Number of interior nodes in float32.
+        std::uint32_t                      interior_fp16_node_count;         ///< Number of interior nodes in float16 (for compression).
+        std::uint32_t                      leaf_node_count;                  ///< Number of leaf nodes (instances for tlas, geometry for blas).
+        RayTracingBinaryVersion            driver_gpu_rt_interface_version;  ///< GpuRT version.
+        VulkanUniversalIdentifier          universal_identifier;             ///< Vulkan-specific universal identifier.
+        std::uint32_t                      interior_half_fp32_node_count;    ///< Number of half float32 box interior nodes.
+        std::array<std::uint32_t, 13>      padding;                          ///< Padding for 128-byte alignment.
+    };
+
     // This interface provides all the information stored in a RT IP 1.1 acceleration
     // header. Allows the user to query and set different BVH attributes.
     // Contains helper functions to compute buffer sizes.
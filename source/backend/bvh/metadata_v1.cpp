@@ -44,5 +44,10 @@ namespace dxr
             return byte_size_;
         }
 
+        void MetaDataV1::SetByteSize(const std::uint32_t byte_size)
+        {
+            byte_size_ = byte_size;
+        }
+
     }  // namespace amd
 }  // namespace dxr
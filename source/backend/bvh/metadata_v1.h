@@ -41,6 +41,13 @@ namespace dxr
             /// @return The size, in bytes.
             std::uint32_t GetByteSize() const;
 
+            /// @brief Set the size of the metadata.
+            ///
+            /// This is also the offset from the start of the metadata to the acceleration structure header.
+            ///
+            /// @param byte_size The size, in bytes.
+            void SetByteSize(const std::uint32_t byte_size);
+
         private:
             // GPU Address of the AS split in low and high bits
             std::uint32_t id_low_    = 0;
@@ -34,6 +34,20 @@ namespace dxr
             return fp32_bounding_boxes;
         }
 
+        void Float16BoxNode::SetChildren(const std::array<NodePointer, 4>& children)
+        {
+            children_ = children;
+        }
+
+        void Float16BoxNode::SetBoundingBoxes(const std::array<AxisAlignedBoundingBox, 4>& bounding_boxes)
+        {
+            for (size_t i = 0; i < bounding_boxes.size(); i++)
+            {
+                rta::ConvertFloatToHalf(&bounding_boxes[i].min.x, &bounding_boxes_[i].min.x, 3, false);
+                rta::ConvertFloatToHalf(&bounding_boxes[i].max.x, &bounding_boxes_[i].max.x, 3, true);
+            }
+        }
+
         std::uint32_t Float16BoxNode::GetValidChildCount() const
         {
             return GetValidChildCountFromArray(children_);
@@ -28,6 +28,16 @@ namespace dxr
             return bounding_boxes_;
         }
 
+        void Float32BoxNode::SetChildren(const std::array<NodePointer, 4>& children)
+        {
+            children_ = children;
+        }
+
+        void Float32BoxNode::SetBoundingBoxes(const std::array<AxisAlignedBoundingBox, 4>& bounding_boxes)
+        {
+            bounding_boxes_ = bounding_boxes;
+        }
+
         std::uint32_t Float32BoxNode::GetValidChildCount() const
         {
             return GetValidChildCountFromArray(children_);
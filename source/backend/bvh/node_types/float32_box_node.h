@@ -34,6 +34,16 @@ namespace dxr
             /// @return The bounding volumes.
             const std::array<AxisAlignedBoundingBox, 4>& GetBoundingBoxes() const;
 
+            /// @brief Set the child nodes.
+            ///
+            /// @param children The child nodes.
+            void SetChildren(const std::array<NodePointer, 4>& children);
+
+            /// @brief Set the bounding volumes.
+            ///
+            /// @param bounding_boxes The bounding volumes.
+            void SetBoundingBoxes(const std::array<AxisAlignedBoundingBox, 4>& bounding_boxes);
+
             /// @brief Get the number of valid child nodes. They can be scattered across all 4 positions.
             ///
             /// @return The number of valid child nodes.
@@ -185,6 +185,26 @@ namespace dxr
             return original_instance_transform_;
         }
 
+        void InstanceExtraData::SetInstanceIndex(const std::uint32_t index)
+        {
+            index_ = index;
+        }
+
+        void InstanceExtraData::SetBottomLevelBvhNodePointer(const NodePointer node_pointer)
+        {
+            bottom_level_bvh_node_pointer_ = node_pointer;
+        }
+
+        void InstanceExtraData::SetBottomLevelBvhMetaDataSize(const std::uint32_t meta_data_size)
+        {
+            bottom_level_bvh_meta_data_size_ = meta_data_size;
+        }
+
+        void InstanceExtraData::SetOriginalInstanceTransform(const Matrix3x4& transform)
+        {
+            original_instance_transform_ = transform;
+        }
+
         InstanceDesc& InstanceNode::GetDesc()
         {
             return desc_;
@@ -200,6 +220,11 @@ namespace dxr
             return extra_data_;
         }
 
+        InstanceExtraData& InstanceNode::GetExtraData()
+        {
+            return extra_data_;
+        }
+
         bool InstanceNode::IsInactive() const
         {
             return desc_.GetBottomLevelBvhGpuVa(dxr::InstanceDescType::kDecoded) == 0 || extra_data_.GetBottomLevelBvhMetaDataSize() == 0 || desc_.GetMask() == 0;
@@ -184,6 +184,26 @@ namespace dxr
             /// @return The instance transform.
             const Matrix3x4& GetOriginalInstanceTransform() const;
 
+            /// @brief Set the instance index.
+            ///
+            /// @param index The instance index.
+            void SetInstanceIndex(const std::uint32_t index);
+
+            /// @brief Set the root node of the bottom level BVH.
+            ///
+            /// @param node_pointer The root node pointer.
+            void SetBottomLevelBvhNodePointer(const NodePointer node_pointer);
+
+            /// @brief Set the size of the bottom level BVH meta data.
+            ///
+            /// @param meta_data_size The metadata size, in bytes.
+            void SetBottomLevelBvhMetaDataSize(const std::uint32_t meta_data_size);
+
+            /// @brief Set the instance transform.
+            ///
+            /// @param transform The original (non-inverted) instance transform.
+            void SetOriginalInstanceTransform(const Matrix3x4& transform);
+
         private:
             std::uint32_t index_                         = 0;                                ///< Index of this instance.
             NodePointer   bottom_level_bvh_node_pointer_ = {NodeType::kAmdNodeTriangle0, 0};  ///< The bottom level node pointer.
@@ -219,6 +239,11 @@ namespace dxr
             /// @return The extra data.
             const InstanceExtraData& GetExtraData() const;
 
+            /// @brief Obtain the extra data.
+            ///
+            /// @return The extra data.
+            InstanceExtraData& GetExtraData();
+
             /// @brief Checks if the pointer to the blas and the blas meta data size is zero,
             /// as defined in the DXR 1.0 spec.
             ///
@@ -103,6 +103,12 @@ namespace dxr
             return vertices_;
         }
 
+        void TriangleNode::SetVertex(const std::uint32_t index, const Float3& vertex)
+        {
+            assert(index < 4);
+            vertices_[index] = vertex;
+        }
+
         std::array<std::uint32_t, 3> TriangleNode::GetTriangleIndices(const NodeType node_type, const TriangleCompressionMode compression_mode) const
         {
             RRA_UNUSED(compression_mode);
@@ -158,6 +164,15 @@ namespace dxr
             std::memcpy(&vertices_[4].x, &index_and_flags, sizeof(float));
         }
 
+        void TriangleNode::SetTriangleId(const dxr::amd::NodeType node_type, const dxr::GeometryFlags geometry_flags, const std::uint32_t rotation)
+        {
+            const std::uint32_t id_bit_stride  = 8;
+            const std::uint32_t triangle_shift = static_cast<uint32_t>(node_type) * id_bit_stride;
+            const std::uint32_t other_bits     = triangle_id_ & ~(0xFFu << triangle_shift);
+
+            triangle_id_ = CalculateTriangleId(node_type, geometry_flags, other_bits, rotation);
+        }
+
         std::uint32_t TriangleNode::GetPrimitiveIndex(const dxr::amd::NodeType node_type) const
         {
             assert(node_type <= NodeType::kAmdNodeTriangle1);
@@ -68,6 +68,14 @@ namespace dxr
             /// @return The triangle vertices.
             const std::array<Float3, 5>& GetVertices() const;
 
+            /// @brief Set a triangle vertex.
+            ///
+            /// Vertex 4 holds the geometry and primitive indices, so only vertices 0 to 3 should be set.
+            ///
+            /// @param index The vertex index.
+            /// @param vertex The vertex position.
+            void SetVertex(const std::uint32_t index, const Float3& vertex);
+
             /// @brief Get the triangle ID.
             ///
             /// @return The triangle ID.
@@ -102,6 +110,13 @@ namespace dxr
             /// @param geometry_flags The geometry flags.
             void SetGeometryIndexAndFlags(const std::uint32_t geometry_index, const dxr::GeometryFlags geometry_flags);
 
+            /// @brief Set the part of the triangle ID for a single triangle, keeping the other triangles.
+            ///
+            /// @param node_type The node type of the triangle.
+            /// @param geometry_flags The geometry flags.
+            /// @param rotation The triangle rotation.
+            void SetTriangleId(const dxr::amd::NodeType node_type, const dxr::GeometryFlags geometry_flags, const std::uint32_t rotation = 0);
+
             /// @brief Is the triangle inactive.
             ///
             /// Checks if the x-components of all triangle vertices are NaN according to the DXR 1.0 spec.
@@ -37,6 +37,29 @@ namespace rta
         }
     }
 
+    void ConvertFloatToHalf(const float* input, std::uint16_t* output, std::int32_t count, bool round_up)
+    {
+        std::array<std::uint8_t, 8 * sizeof(float)> buffer;
+
+        while (count > 0)
+        {
+            std::memcpy(buffer.data(), input, std::min(count, 8) * sizeof(float));
+
+            __m256  float_vector = _mm256_loadu_ps(reinterpret_cast<float*>(buffer.data()));
+            __m128i half_vector  = round_up ? _mm256_cvtps_ph(float_vector, _MM_FROUND_TO_POS_INF) : _mm256_cvtps_ph(float_vector, _MM_FROUND_TO_NEG_INF);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer.data()), half_vector);
+
+            std::memcpy(output, buffer.data(), std::min(count, 8) * sizeof(std::uint16_t));
+
+            // Advance pointers
+            input += 8;
+            output += 8;
+
+            // Decrement left elements
+            count -= 8;
+        }
+    }
+
     std::uint32_t ComputeBoxNodePerInteriorNodeCount(const std::uint32_t interior_node_branching_factor)
     {
         return static_cast<std::uint32_t>(std::ceil(interior_node_branching_factor / 4.f));
@@ -19,6 +19,17 @@ namespace rta
     /// @param [in]  count  The size of the array to convert.
     void ConvertHalfToFloat(const std::uint16_t* input, float* output, std::int32_t count);
 
+    /// @brief Converts count floats stored in input array to half-precision floats (uint16) in output array.
+    ///
+    /// Values are rounded towards positive or negative infinity rather than to the nearest half, so a bounding
+    /// box converted with its minimum rounded down and its maximum rounded up still contains the original box.
+    ///
+    /// @param [in]  input    The array of float32s to convert.
+    /// @param [out] output   The array to hold the converted float16s.
+    /// @param [in]  count    The size of the array to convert.
+    /// @param [in]  round_up If true, round towards positive infinity, otherwise towards negative infinity.
+    void ConvertFloatToHalf(const float* input, std::uint16_t* output, std::int32_t count, bool round_up);
+
     /// @brief Calculate how many box nodes per interior node count.
     ///
     /// @param [in] interior_node_branching_factor The branching factor.
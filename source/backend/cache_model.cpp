@@ -0,0 +1,129 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the cache model used to simulate traversal memory accesses.
+//=============================================================================
+
+#include "cache_model.h"
+
+#include <algorithm>
+
+namespace rra
+{
+    namespace ray_cost
+    {
+        static const uint64_t kInvalidTag = UINT64_MAX;  ///< Marks an empty way.
+
+        /// @brief Check if a value is a power of 2.
+        ///
+        /// @param [in] value The value.
+        ///
+        /// @return true if the value is a power of 2, false if not.
+        static bool IsPowerOfTwo(uint32_t value)
+        {
+            return value != 0 && (value & (value - 1)) == 0;
+        }
+
+        /// @brief Get the log2 of a power of 2.
+        ///
+        /// @param [in] value The value.
+        ///
+        /// @return The log2.
+        static uint32_t Log2(uint32_t value)
+        {
+            uint32_t shift = 0;
+            while ((1u << shift) < value)
+            {
+                shift++;
+            }
+            return shift;
+        }
+
+        CacheModel::CacheModel(const RraRayCostCacheConfig& config)
+            : line_shift_(Log2(config.line_size))
+            , page_shift_(Log2(config.page_size / config.line_size))
+            , associativity_(config.associativity)
+            , set_count_(config.capacity / (config.line_size * config.associativity))
+            , tags_(static_cast<size_t>(set_count_) * associativity_, kInvalidTag)
+            , last_used_(static_cast<size_t>(set_count_) * associativity_, 0)
+        {
+        }
+
+        RraErrorCode CacheModel::ValidateConfig(const RraRayCostCacheConfig& config)
+        {
+            RRA_RETURN_ON_ERROR(IsPowerOfTwo(config.line_size), kRraErrorInvalidSize);
+            RRA_RETURN_ON_ERROR(IsPowerOfTwo(config.page_size) && config.page_size >= config.line_size, kRraErrorInvalidSize);
+            RRA_RETURN_ON_ERROR(config.associativity > 0 && config.ray_group_size > 0, kRraErrorInvalidSize);
+
+            const uint64_t set_size = static_cast<uint64_t>(config.line_size) * config.associativity;
+            RRA_RETURN_ON_ERROR(config.capacity >= set_size && config.capacity % set_size == 0, kRraErrorInvalidSize);
+            return kRraOk;
+        }
+
+        void CacheModel::Flush()
+        {
+            std::fill(tags_.begin(), tags_.end(), kInvalidTag);
+            std::fill(last_used_.begin(), last_used_.end(), 0);
+            clock_ = 0;
+        }
+
+        void CacheModel::Read(uint64_t address, uint32_t size)
+        {
+            const uint64_t first_line = address >> line_shift_;
+            const uint64_t last_line  = (address + std::max(size, 1u) - 1) >> line_shift_;
+            for (uint64_t line = first_line; line <= last_line; line++)
+            {
+                ReadLine(line);
+            }
+        }
+
+        void CacheModel::ReadLine(uint64_t line)
+        {
+            ray_result_.line_reads++;
+            ray_lines_.push_back(line);
+            clock_++;
+
+            const size_t first_way = static_cast<size_t>(line % set_count_) * associativity_;
+            size_t       victim    = first_way;
+            for (size_t way = first_way; way < first_way + associativity_; way++)
+            {
+                if (tags_[way] == line)
+                {
+                    ray_result_.hits++;
+                    last_used_[way] = clock_;
+                    return;
+                }
+
+                // Empty ways have a last use of 0, so they are filled before anything is evicted.
+                if (last_used_[way] < last_used_[victim])
+                {
+                    victim = way;
+                }
+            }
+
+            tags_[victim]      = line;
+            last_used_[victim] = clock_;
+        }
+
+        void CacheModel::EndRay(RayCacheResult& out_result)
+        {
+            std::sort(ray_lines_.begin(), ray_lines_.end());
+            ray_lines_.erase(std::unique(ray_lines_.begin(), ray_lines_.end()), ray_lines_.end());
+            ray_result_.unique_lines = static_cast<uint32_t>(ray_lines_.size());
+
+            // The lines are sorted, so the lines in each page are next to each other.
+            for (size_t i = 0; i < ray_lines_.size(); i++)
+            {
+                if (i == 0 || (ray_lines_[i] >> page_shift_) != (ray_lines_[i - 1] >> page_shift_))
+                {
+                    ray_result_.unique_pages++;
+                }
+            }
+
+            out_result  = ray_result_;
+            ray_result_ = {};
+            ray_lines_.clear();
+        }
+    }  // namespace ray_cost
+}  // namespace rra
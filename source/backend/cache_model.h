@@ -0,0 +1,85 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the cache model used to simulate traversal memory accesses.
+//=============================================================================
+
+#ifndef RRA_BACKEND_CACHE_MODEL_H_
+#define RRA_BACKEND_CACHE_MODEL_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "public/rra_error.h"
+#include "public/rra_ray_cost.h"
+
+// Cache model. Used only by the backend; the public interface is in rra_ray_cost.h.
+
+namespace rra
+{
+    namespace ray_cost
+    {
+        /// @brief The cache counts for a single ray.
+        struct RayCacheResult
+        {
+            uint32_t line_reads   = 0;  ///< The number of cache line reads.
+            uint32_t hits         = 0;  ///< The number of cache line reads that hit.
+            uint32_t unique_lines = 0;  ///< The number of distinct lines read.
+            uint32_t unique_pages = 0;  ///< The number of distinct DRAM pages read.
+        };
+
+        /// @brief A set-associative cache with least recently used replacement.
+        ///
+        /// Only the tags are stored, since only the hits and misses are of interest. Each worker thread owns its own
+        /// cache, so no locking is needed.
+        class CacheModel
+        {
+        public:
+            /// @brief Constructor.
+            ///
+            /// @param [in] config The cache settings. Must have passed ValidateConfig().
+            explicit CacheModel(const RraRayCostCacheConfig& config);
+
+            /// @brief Check the cache settings.
+            ///
+            /// @param [in] config The cache settings.
+            ///
+            /// @return kRraOk if the settings are valid, kRraErrorInvalidSize if not.
+            static RraErrorCode ValidateConfig(const RraRayCostCacheConfig& config);
+
+            /// @brief Empty the cache.
+            void Flush();
+
+            /// @brief Read a range of bytes through the cache.
+            ///
+            /// @param [in] address The address of the first byte.
+            /// @param [in] size    The number of bytes.
+            void Read(uint64_t address, uint32_t size);
+
+            /// @brief Finish the current ray, and start counting for the next one. The cache contents are kept.
+            ///
+            /// @param [out] out_result The counts for the finished ray.
+            void EndRay(RayCacheResult& out_result);
+
+        private:
+            /// @brief Read a single line through the cache.
+            ///
+            /// @param [in] line The line address.
+            void ReadLine(uint64_t line);
+
+            uint32_t              line_shift_    = 0;   ///< The log2 of the line size.
+            uint32_t              page_shift_    = 0;   ///< The log2 of the number of lines in a page.
+            uint32_t              associativity_ = 0;   ///< The number of lines in each set.
+            uint32_t              set_count_     = 0;   ///< The number of sets.
+            uint64_t              clock_         = 0;   ///< Incremented on each read, to order the lines by last use.
+            std::vector<uint64_t> tags_;                ///< The line address held in each way, grouped by set.
+            std::vector<uint64_t> last_used_;           ///< The clock value when each way was last read.
+            std::vector<uint64_t> ray_lines_;           ///< The lines read by the current ray.
+            RayCacheResult        ray_result_    = {};  ///< The counts for the current ray.
+        };
+    }  // namespace ray_cost
+}  // namespace rra
+
+#endif  // RRA_BACKEND_CACHE_MODEL_H_
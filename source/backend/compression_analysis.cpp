@@ -0,0 +1,377 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the compression analyzer.
+//=============================================================================
+
+#include "compression_analysis.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+#include "blas_hash.h"
+#include "bvh/dxr_type_conversion.h"
+#include "bvh/utils.h"
+#include "job_system.h"
+
+namespace rra
+{
+    static const uint32_t kNoNeighbor = UINT32_MAX;  ///< Marks a triangle edge not shared with another triangle.
+
+    /// @brief A triangle edge, as a pair of vertex indices.
+    struct Edge
+    {
+        uint32_t geometry_index;  ///< The geometry the triangle belongs to. Triangles in different geometries are never paired.
+        uint32_t vertex_a;        ///< The lower vertex index.
+        uint32_t vertex_b;        ///< The higher vertex index.
+        uint32_t triangle;        ///< The triangle the edge belongs to.
+
+        bool operator<(const Edge& other) const
+        {
+            return std::tie(geometry_index, vertex_a, vertex_b, triangle) < std::tie(other.geometry_index, other.vertex_a, other.vertex_b, other.triangle);
+        }
+    };
+
+    /// @brief The triangles of a BLAS, as collected while walking the tree.
+    struct BlasTriangles
+    {
+        std::vector<std::array<float, 3>> vertices;          ///< Three vertices per triangle.
+        std::vector<uint32_t>             geometry_indices;  ///< The geometry index of each triangle.
+    };
+
+    /// @brief The box node counts of a BLAS, as collected while walking the tree.
+    struct BoxNodeCounts
+    {
+        uint64_t fp32_count          = 0;  ///< The number of fp32 box nodes.
+        uint64_t fp16_count          = 0;  ///< The number of fp16 box nodes.
+        uint64_t representable_count = 0;  ///< The number of non-root box nodes that are fp16 or could be within the tolerance.
+        uint64_t leaf_parent_count   = 0;  ///< The number of non-root box nodes whose children are all leaf nodes.
+    };
+
+    bool IsFp16Representable(const std::array<dxr::amd::AxisAlignedBoundingBox, 4>& boxes,
+                             const std::array<dxr::amd::NodePointer, 4>&            children,
+                             float                                                   tolerance)
+    {
+        float mins[12];
+        float maxs[12];
+
+        dxr::amd::AxisAlignedBoundingBox parent = {{INFINITY, INFINITY, INFINITY}, {-INFINITY, -INFINITY, -INFINITY}};
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            // Invalid children may hold garbage, so give them an empty box that converts exactly.
+            const bool valid = !children[i].IsInvalid();
+            mins[3 * i + 0]  = valid ? boxes[i].min.x : 0.0f;
+            mins[3 * i + 1]  = valid ? boxes[i].min.y : 0.0f;
+            mins[3 * i + 2]  = valid ? boxes[i].min.z : 0.0f;
+            maxs[3 * i + 0]  = valid ? boxes[i].max.x : 0.0f;
+            maxs[3 * i + 1]  = valid ? boxes[i].max.y : 0.0f;
+            maxs[3 * i + 2]  = valid ? boxes[i].max.z : 0.0f;
+
+            if (valid)
+            {
+                parent.min = {std::min(parent.min.x, boxes[i].min.x), std::min(parent.min.y, boxes[i].min.y), std::min(parent.min.z, boxes[i].min.z)};
+                parent.max = {std::max(parent.max.x, boxes[i].max.x), std::max(parent.max.y, boxes[i].max.y), std::max(parent.max.z, boxes[i].max.z)};
+            }
+        }
+
+        uint16_t half_mins[12];
+        uint16_t half_maxs[12];
+        float    rounded_mins[12];
+        float    rounded_maxs[12];
+        rta::ConvertFloatToHalf(mins, half_mins, 12, false);
+        rta::ConvertFloatToHalf(maxs, half_maxs, 12, true);
+        rta::ConvertHalfToFloat(half_mins, rounded_mins, 12);
+        rta::ConvertHalfToFloat(half_maxs, rounded_maxs, 12);
+
+        const float extent    = std::max({parent.max.x - parent.min.x, parent.max.y - parent.min.y, parent.max.z - parent.min.z, 0.0f});
+        const float max_error = tolerance * extent;
+
+        // NaN and infinite errors fail the comparison, so they are never representable.
+        bool representable = true;
+        for (uint32_t i = 0; i < 12; i++)
+        {
+            representable &= (mins[i] - rounded_mins[i]) <= max_error;
+            representable &= (rounded_maxs[i] - maxs[i]) <= max_error;
+        }
+        return representable;
+    }
+
+    /// @brief Walk the tree of a BLAS, counting the box nodes and collecting the triangles.
+    ///
+    /// @param [in]  blas                 The BLAS.
+    /// @param [in]  fp16_tolerance       How far the bounds of a box node may move when converted to fp16.
+    /// @param [out] out_box_counts       The box node counts.
+    /// @param [out] out_triangles        The active triangles.
+    /// @param [out] out_leaf_count       The number of distinct leaf nodes.
+    /// @param [out] out_procedural_count The number of distinct procedural nodes.
+    static void WalkBlas(const rta::EncodedRtIp11BottomLevelBvh* blas,
+                         float                                   fp16_tolerance,
+                         BoxNodeCounts&                          out_box_counts,
+                         BlasTriangles&                          out_triangles,
+                         uint64_t&                               out_leaf_count,
+                         uint64_t&                               out_procedural_count)
+    {
+        const uint32_t leaf_nodes_offset = blas->GetHeader().GetBufferOffsets().leaf_nodes;
+        const auto     compression_mode  = rta::ToDxrTriangleCompressionMode(blas->GetHeader().GetPostBuildInfo().GetTriangleCompressionMode());
+
+        // With two triangle compression, both triangles of a node may have their own pointer, so only count each node once.
+        // 0 is an unvisited node, 1 a node holding one triangle, and 2 a node holding two.
+        std::vector<uint8_t>               node_triangle_counts(blas->GetLeafNodesData().size() / sizeof(dxr::amd::TriangleNode), 0);
+        std::vector<dxr::amd::NodePointer> triangle_nodes;
+
+        const dxr::amd::NodePointer        root_ptr(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
+        std::vector<dxr::amd::NodePointer> stack = {root_ptr};
+        while (!stack.empty())
+        {
+            const dxr::amd::NodePointer node_ptr = stack.back();
+            stack.pop_back();
+
+            const bool                                      is_root = node_ptr.GetByteOffset() == root_ptr.GetByteOffset();
+            std::array<dxr::amd::AxisAlignedBoundingBox, 4> boxes;
+            const std::array<dxr::amd::NodePointer, 4>*     children = nullptr;
+            if (node_ptr.IsFp32BoxNode())
+            {
+                const dxr::amd::Float32BoxNode* box_node = blas->GetFloat32Box(node_ptr);
+                boxes                                    = box_node->GetBoundingBoxes();
+                children                                 = &box_node->GetChildren();
+                out_box_counts.fp32_count++;
+                if (!is_root && IsFp16Representable(boxes, *children, fp16_tolerance))
+                {
+                    out_box_counts.representable_count++;
+                }
+            }
+            else
+            {
+                const dxr::amd::Float16BoxNode* box_node = blas->GetFloat16Box(node_ptr);
+                boxes                                    = box_node->GetBoundingBoxes();
+                children                                 = &box_node->GetChildren();
+                out_box_counts.fp16_count++;
+                out_box_counts.representable_count++;
+            }
+
+            bool only_leaf_children = true;
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                const dxr::amd::NodePointer child = (*children)[i];
+                if (child.IsInvalid())
+                {
+                    continue;
+                }
+
+                if (child.IsBoxNode())
+                {
+                    stack.push_back(child);
+                    only_leaf_children = false;
+                    continue;
+                }
+
+                const size_t leaf_index = (child.GetByteOffset() - leaf_nodes_offset) / sizeof(dxr::amd::TriangleNode);
+                if (leaf_index >= node_triangle_counts.size())
+                {
+                    continue;
+                }
+
+                const uint8_t triangle_count = (child.IsTriangleNode() && child.GetType() == dxr::amd::NodeType::kAmdNodeTriangle1) ? 2 : 1;
+                if (node_triangle_counts[leaf_index] == 0)
+                {
+                    out_leaf_count++;
+                    if (child.IsTriangleNode())
+                    {
+                        triangle_nodes.push_back(child);
+                    }
+                    else
+                    {
+                        out_procedural_count++;
+                    }
+                }
+                node_triangle_counts[leaf_index] = std::max(node_triangle_counts[leaf_index], triangle_count);
+            }
+
+            if (!is_root && only_leaf_children)
+            {
+                out_box_counts.leaf_parent_count++;
+            }
+        }
+
+        for (const dxr::amd::NodePointer node_ptr : triangle_nodes)
+        {
+            const dxr::amd::TriangleNode* triangle_node  = blas->GetTriangleNode(node_ptr);
+            const size_t                  leaf_index     = (node_ptr.GetByteOffset() - leaf_nodes_offset) / sizeof(dxr::amd::TriangleNode);
+            const uint32_t                geometry_index = triangle_node->GetGeometryIndex();
+
+            for (uint32_t j = 0; j < node_triangle_counts[leaf_index]; j++)
+            {
+                const auto                    node_type   = (j == 0) ? dxr::amd::NodeType::kAmdNodeTriangle0 : dxr::amd::NodeType::kAmdNodeTriangle1;
+                const dxr::amd::Triangle      triangle    = triangle_node->GetTriangle(node_type, compression_mode);
+                const dxr::amd::Float3* const vertices[3] = {&triangle.v0, &triangle.v1, &triangle.v2};
+
+                if (triangle.v0.x != triangle.v0.x)
+                {
+                    // Skip inactive triangles, which have NaN vertices.
+                    continue;
+                }
+
+                for (const dxr::amd::Float3* vertex : vertices)
+                {
+                    out_triangles.vertices.push_back({CanonicalizeZero(vertex->x), CanonicalizeZero(vertex->y), CanonicalizeZero(vertex->z)});
+                }
+                out_triangles.geometry_indices.push_back(geometry_index);
+            }
+        }
+    }
+
+    /// @brief Count the disjoint pairs of triangles that share an edge.
+    ///
+    /// Triangles are linked to the other triangles sharing each of their edges, then matched greedily in the order
+    /// they were found in the tree, which keeps pairs spatially close like a builder would.
+    ///
+    /// @param [in] triangles The triangles.
+    ///
+    /// @return The number of pairs.
+    static uint64_t CountSharedEdgePairs(const BlasTriangles& triangles)
+    {
+        const size_t                triangle_count = triangles.geometry_indices.size();
+        const std::vector<uint32_t> vertex_indices = GetKeyIndices(triangles.vertices);
+
+        std::vector<Edge> edges;
+        edges.reserve(triangle_count * 3);
+        for (size_t i = 0; i < triangle_count; i++)
+        {
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                const uint32_t a = vertex_indices[3 * i + j];
+                const uint32_t b = vertex_indices[3 * i + (j + 1) % 3];
+                if (a != b)
+                {
+                    edges.push_back({triangles.geometry_indices[i], std::min(a, b), std::max(a, b), static_cast<uint32_t>(i)});
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        // A triangle gets at most one neighbor per edge. Edges shared by more than two triangles are split into pairs.
+        std::vector<std::array<uint32_t, 3>> neighbors(triangle_count, {kNoNeighbor, kNoNeighbor, kNoNeighbor});
+        std::vector<uint8_t>                 neighbor_counts(triangle_count, 0);
+        for (size_t begin = 0; begin < edges.size();)
+        {
+            size_t end = begin + 1;
+            while (end < edges.size() && edges[end].geometry_index == edges[begin].geometry_index && edges[end].vertex_a == edges[begin].vertex_a &&
+                   edges[end].vertex_b == edges[begin].vertex_b)
+            {
+                end++;
+            }
+
+            for (size_t j = begin; j + 1 < end; j += 2)
+            {
+                const uint32_t a                   = edges[j].triangle;
+                const uint32_t b                   = edges[j + 1].triangle;
+                neighbors[a][neighbor_counts[a]++] = b;
+                neighbors[b][neighbor_counts[b]++] = a;
+            }
+            begin = end;
+        }
+
+        std::vector<bool> paired(triangle_count, false);
+        uint64_t          pair_count = 0;
+        for (size_t i = 0; i < triangle_count; i++)
+        {
+            if (paired[i])
+            {
+                continue;
+            }
+
+            for (uint32_t j = 0; j < neighbor_counts[i]; j++)
+            {
+                const uint32_t neighbor = neighbors[i][j];
+                if (neighbor != i && !paired[neighbor])
+                {
+                    paired[i]        = true;
+                    paired[neighbor] = true;
+                    pair_count++;
+                    break;
+                }
+            }
+        }
+
+        return pair_count;
+    }
+
+    void AnalyzeBlasCompression(const rta::EncodedRtIp11BottomLevelBvh* blas, float fp16_tolerance, RraBlasCompressionStats& out_stats)
+    {
+        out_stats = {};
+
+        const auto& header                  = blas->GetHeader();
+        const auto  triangle_mode           = header.GetPostBuildInfo().GetTriangleCompressionMode();
+        out_stats.triangle_compression_mode = static_cast<RraTriangleCompressionMode>(triangle_mode);
+        out_stats.box_fp16_mode             = static_cast<RraBoxFp16Mode>(header.GetPostBuildInfo().GetBottomLevelFp16Mode());
+
+        if (blas->IsEmpty())
+        {
+            return;
+        }
+
+        out_stats.leaf_node_buffer_size = header.CalculateCompressionModeLeafNodeBufferSize(triangle_mode);
+
+        BoxNodeCounts box_counts;
+        BlasTriangles triangles;
+        uint64_t      leaf_count       = 0;
+        uint64_t      procedural_count = 0;
+        WalkBlas(blas, fp16_tolerance, box_counts, triangles, leaf_count, procedural_count);
+
+        // Procedural nodes take one leaf node whatever the triangle compression mode.
+        const uint64_t triangle_count = triangles.geometry_indices.size();
+        const uint64_t pair_count     = CountSharedEdgePairs(triangles);
+
+        out_stats.triangle_count                        = triangle_count;
+        out_stats.leaf_node_count                       = leaf_count;
+        out_stats.shared_edge_pair_count                = pair_count;
+        out_stats.pair_compression_ratio                = (triangle_count > 0) ? static_cast<float>(triangle_count - pair_count) / triangle_count : 1.0f;
+        out_stats.uncompressed_leaf_node_buffer_size    = (triangle_count + procedural_count) * dxr::amd::kLeafNodeSize;
+        out_stats.pair_compressed_leaf_node_buffer_size = (triangle_count - pair_count + procedural_count) * dxr::amd::kLeafNodeSize;
+
+        const uint64_t box_count      = box_counts.fp32_count + box_counts.fp16_count;
+        const uint64_t non_root_count = (box_count > 0) ? box_count - 1 : 0;
+
+        out_stats.fp32_box_node_count               = box_counts.fp32_count;
+        out_stats.fp16_box_node_count               = box_counts.fp16_count;
+        out_stats.fp16_representable_box_node_count = box_counts.representable_count;
+        out_stats.fp16_representable_fraction       = (non_root_count > 0) ? static_cast<float>(box_counts.representable_count) / non_root_count : 0.0f;
+        out_stats.interior_node_buffer_size         = box_counts.fp32_count * dxr::amd::kFp32BoxNodeSize + box_counts.fp16_count * dxr::amd::kFp16BoxNodeSize;
+
+        // The root node is always fp32.
+        const uint64_t fp16_counts[kRraBoxFp16ModeCount] = {0, box_counts.leaf_parent_count, box_counts.representable_count, non_root_count};
+        for (uint32_t mode = 0; mode < kRraBoxFp16ModeCount; mode++)
+        {
+            out_stats.projected_interior_node_buffer_size[mode] =
+                (box_count - fp16_counts[mode]) * dxr::amd::kFp32BoxNodeSize + fp16_counts[mode] * dxr::amd::kFp16BoxNodeSize;
+        }
+    }
+
+    RraErrorCode AnalyzeCompression(const RraDataSet& data_set, uint32_t thread_count, float fp16_tolerance, std::vector<RraBlasCompressionStats>& out_stats)
+    {
+        std::vector<const rta::EncodedRtIp11BottomLevelBvh*> blases;
+        for (const auto& blas : data_set.bvh_bundle->GetBottomLevelBvhs())
+        {
+            const rta::EncodedRtIp11BottomLevelBvh* bvh = dynamic_cast<const rta::EncodedRtIp11BottomLevelBvh*>(&(*blas));
+            if (bvh == nullptr)
+            {
+                return kRraErrorInvalidPointer;
+            }
+            blases.push_back(bvh);
+        }
+
+        out_stats.assign(blases.size(), RraBlasCompressionStats{});
+        JobSystem::Get().ParallelFor(blases.size(), 1, thread_count, [&blases, &out_stats, fp16_tolerance](size_t begin, size_t end, uint32_t) {
+            for (size_t index = begin; index < end; index++)
+            {
+                AnalyzeBlasCompression(blases[index], fp16_tolerance, out_stats[index]);
+            }
+        });
+
+        return kRraOk;
+    }
+}  // namespace rra
@@ -0,0 +1,54 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the compression analyzer.
+//=============================================================================
+
+#ifndef RRA_BACKEND_COMPRESSION_ANALYSIS_H_
+#define RRA_BACKEND_COMPRESSION_ANALYSIS_H_
+
+#include <array>
+#include <vector>
+
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
+#include "public/rra_compression_analysis.h"
+#include "rra_data_set.h"
+
+// Compression analyzer functions. Used only by the backend; the public interface is in rra_compression_analysis.h.
+
+namespace rra
+{
+    /// @brief Check if an fp32 box node could be stored as an fp16 box node.
+    ///
+    /// The children's bounds are rounded outwards to half precision all at once, so the rounded boxes always contain
+    /// the original boxes. Bounds outside the fp16 range round to infinity and fail the check.
+    ///
+    /// @param [in] boxes     The child bounding boxes.
+    /// @param [in] children  The child node pointers. Invalid children are ignored.
+    /// @param [in] tolerance How far a bound may move, as a fraction of the node's largest extent.
+    ///
+    /// @return true if every bound moves by no more than the tolerance.
+    bool IsFp16Representable(const std::array<dxr::amd::AxisAlignedBoundingBox, 4>& boxes,
+                             const std::array<dxr::amd::NodePointer, 4>&            children,
+                             float                                                   tolerance);
+
+    /// @brief Analyze the triangle compression and fp16 box node opportunities for a single BLAS.
+    ///
+    /// @param [in]  blas           The BLAS.
+    /// @param [in]  fp16_tolerance How far the bounds of a box node may move when converted to fp16, as a fraction of the node's largest extent.
+    /// @param [out] out_stats      The analysis.
+    void AnalyzeBlasCompression(const rta::EncodedRtIp11BottomLevelBvh* blas, float fp16_tolerance, RraBlasCompressionStats& out_stats);
+
+    /// @brief Analyze the triangle compression and fp16 box node opportunities for all the BLASes in parallel.
+    ///
+    /// @param [in]  data_set       The data set containing the loaded trace data.
+    /// @param [in]  thread_count   The number of threads to use, or 0 for one per core.
+    /// @param [in]  fp16_tolerance How far the bounds of a box node may move when converted to fp16, as a fraction of the node's largest extent.
+    /// @param [out] out_stats      The analysis for each BLAS, indexed by BLAS index.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode AnalyzeCompression(const RraDataSet& data_set, uint32_t thread_count, float fp16_tolerance, std::vector<RraBlasCompressionStats>& out_stats);
+}  // namespace rra
+
+#endif  // RRA_BACKEND_COMPRESSION_ANALYSIS_H_
@@ -0,0 +1,574 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the instance overlap finder.
+//=============================================================================
+
+#include "instance_overlap.h"
+
+#include <float.h>
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "job_system.h"
+
+namespace rra
+{
+    namespace instance_overlap
+    {
+        static const uint64_t kMaxCellsPerBox     = 64;    ///< Boxes touching more cells than this are tested against all the others instead.
+        static const uint32_t kMaxGridCellsPerBox = 2;     ///< The grid has at most this many cells per box.
+        static const uint32_t kMedianSampleCount  = 4096;  ///< The number of boxes sampled to find the median extent.
+        static const size_t   kBoxBlockSize       = 4096;  ///< The number of boxes in each block of work.
+        static const size_t   kCellBlockSize      = 1024;  ///< The number of grid cells in each block of work.
+
+        /// @brief A uniform grid over the scene bounds.
+        struct Grid
+        {
+            float    origin[3];          ///< The minimum corner of the grid.
+            float    cell_size;          ///< The size of a cell along each axis.
+            float    inverse_cell_size;  ///< The reciprocal of the cell size.
+            uint32_t dimensions[3];      ///< The number of cells along each axis.
+            uint64_t cell_count;         ///< The total number of cells.
+        };
+
+        /// @brief An inclusive range of grid cells.
+        struct CellRange
+        {
+            uint32_t min[3];  ///< The minimum cell coordinates.
+            uint32_t max[3];  ///< The maximum cell coordinates.
+
+            /// @brief Get the number of cells in the range.
+            ///
+            /// @return The cell count.
+            uint64_t GetCellCount() const
+            {
+                return static_cast<uint64_t>(max[0] - min[0] + 1) * (max[1] - min[1] + 1) * (max[2] - min[2] + 1);
+            }
+        };
+
+        /// @brief Is a bounding box empty.
+        ///
+        /// @param [in] box The bounding box.
+        ///
+        /// @return true if the box is empty or contains NaNs, false if not.
+        static bool IsEmpty(const BoundingVolumeExtents& box)
+        {
+            return !(box.min_x <= box.max_x && box.min_y <= box.max_y && box.min_z <= box.max_z);
+        }
+
+        /// @brief Do two intervals along an axis overlap.
+        ///
+        /// Intervals that only touch don't count, so a grid of tiles doesn't overlap itself. An interval with zero
+        /// length counts if it lies within the other interval, so flat decals on a surface are still found.
+        ///
+        /// @param [in] a_min The start of the first interval.
+        /// @param [in] a_max The end of the first interval.
+        /// @param [in] b_min The start of the second interval.
+        /// @param [in] b_max The end of the second interval.
+        ///
+        /// @return true if the intervals overlap, false if not.
+        static bool IntervalsOverlap(float a_min, float a_max, float b_min, float b_max)
+        {
+            const float low  = std::max(a_min, b_min);
+            const float high = std::min(a_max, b_max);
+            return (high > low) | ((high == low) & ((a_min == a_max) | (b_min == b_max)));
+        }
+
+        /// @brief Do two bounding boxes overlap.
+        ///
+        /// @param [in] a The first bounding box.
+        /// @param [in] b The second bounding box.
+        ///
+        /// @return true if the boxes overlap, false if not.
+        static bool BoxesOverlap(const BoundingVolumeExtents& a, const BoundingVolumeExtents& b)
+        {
+            return IntervalsOverlap(a.min_x, a.max_x, b.min_x, b.max_x) && IntervalsOverlap(a.min_y, a.max_y, b.min_y, b.max_y) &&
+                   IntervalsOverlap(a.min_z, a.max_z, b.min_z, b.max_z);
+        }
+
+        /// @brief Get the grid cell coordinate of a position along one axis.
+        ///
+        /// @param [in] grid     The grid.
+        /// @param [in] axis     The axis.
+        /// @param [in] position The position along the axis.
+        ///
+        /// @return The cell coordinate, clamped to the grid.
+        static uint32_t GetCellCoordinate(const Grid& grid, uint32_t axis, float position)
+        {
+            const float cell = (position - grid.origin[axis]) * grid.inverse_cell_size;
+            if (!(cell > 0.0f))
+            {
+                return 0;
+            }
+            return static_cast<uint32_t>(std::min(cell, static_cast<float>(grid.dimensions[axis] - 1)));
+        }
+
+        /// @brief Get the range of grid cells touched by a bounding box.
+        ///
+        /// @param [in] grid The grid.
+        /// @param [in] box  The bounding box.
+        ///
+        /// @return The cell range.
+        static CellRange GetCellRange(const Grid& grid, const BoundingVolumeExtents& box)
+        {
+            CellRange range;
+            range.min[0] = GetCellCoordinate(grid, 0, box.min_x);
+            range.min[1] = GetCellCoordinate(grid, 1, box.min_y);
+            range.min[2] = GetCellCoordinate(grid, 2, box.min_z);
+            range.max[0] = GetCellCoordinate(grid, 0, box.max_x);
+            range.max[1] = GetCellCoordinate(grid, 1, box.max_y);
+            range.max[2] = GetCellCoordinate(grid, 2, box.max_z);
+            return range;
+        }
+
+        /// @brief Get the index of a grid cell.
+        ///
+        /// @param [in] grid The grid.
+        /// @param [in] x    The X cell coordinate.
+        /// @param [in] y    The Y cell coordinate.
+        /// @param [in] z    The Z cell coordinate.
+        ///
+        /// @return The cell index.
+        static uint64_t GetCellIndex(const Grid& grid, uint32_t x, uint32_t y, uint32_t z)
+        {
+            return x + static_cast<uint64_t>(grid.dimensions[0]) * (y + static_cast<uint64_t>(grid.dimensions[1]) * z);
+        }
+
+        /// @brief Call a function for every cell in a range.
+        ///
+        /// @param [in] grid  The grid.
+        /// @param [in] range The cell range.
+        /// @param [in] func  The function to call with each cell index.
+        template <typename Func>
+        static void ForEachCell(const Grid& grid, const CellRange& range, Func func)
+        {
+            for (uint32_t z = range.min[2]; z <= range.max[2]; z++)
+            {
+                for (uint32_t y = range.min[1]; y <= range.max[1]; y++)
+                {
+                    const uint64_t row = GetCellIndex(grid, 0, y, z);
+                    for (uint32_t x = range.min[0]; x <= range.max[0]; x++)
+                    {
+                        func(row + x);
+                    }
+                }
+            }
+        }
+
+        /// @brief The boxes of a single grid cell, copied into one array per extent so the pair tests read
+        /// contiguous floats rather than gathering them from the boxes through the index list.
+        struct CellScratch
+        {
+            std::vector<float>    min_x;      ///< The minimum X extents.
+            std::vector<float>    min_y;      ///< The minimum Y extents.
+            std::vector<float>    min_z;      ///< The minimum Z extents.
+            std::vector<float>    max_x;      ///< The maximum X extents.
+            std::vector<float>    max_y;      ///< The maximum Y extents.
+            std::vector<float>    max_z;      ///< The maximum Z extents.
+            std::vector<uint8_t>  home_axes;  ///< A bit per axis, set if the box starts in this cell along that axis.
+            std::vector<uint32_t> counts;     ///< The number of overlaps found for each box in this cell.
+
+            /// @brief Copy the boxes of a cell into the scratch arrays.
+            ///
+            /// @param [in] grid    The grid.
+            /// @param [in] cell    The cell coordinates.
+            /// @param [in] boxes   All the bounding boxes.
+            /// @param [in] indices The indices of the boxes in the cell.
+            /// @param [in] count   The number of boxes in the cell.
+            void Load(const Grid& grid, const uint32_t cell[3], const std::vector<BoundingVolumeExtents>& boxes, const uint32_t* indices, size_t count)
+            {
+                min_x.resize(count);
+                min_y.resize(count);
+                min_z.resize(count);
+                max_x.resize(count);
+                max_y.resize(count);
+                max_z.resize(count);
+                home_axes.resize(count);
+                counts.assign(count, 0);
+                for (size_t i = 0; i < count; i++)
+                {
+                    const BoundingVolumeExtents& box = boxes[indices[i]];
+                    min_x[i]                         = box.min_x;
+                    min_y[i]                         = box.min_y;
+                    min_z[i]                         = box.min_z;
+                    max_x[i]                         = box.max_x;
+                    max_y[i]                         = box.max_y;
+                    max_z[i]                         = box.max_z;
+                    home_axes[i]                     = static_cast<uint8_t>((GetCellCoordinate(grid, 0, box.min_x) == cell[0] ? 1 : 0) |
+                                                        (GetCellCoordinate(grid, 1, box.min_y) == cell[1] ? 2 : 0) |
+                                                        (GetCellCoordinate(grid, 2, box.min_z) == cell[2] ? 4 : 0));
+                }
+            }
+        };
+
+        /// @brief Build a grid over a set of bounding boxes.
+        ///
+        /// The cell size starts at the median of the largest extent of each box, so a typical box touches up to
+        /// eight cells, and grows until there are no more than kMaxGridCellsPerBox cells per box.
+        ///
+        /// @param [in] boxes        The bounding boxes.
+        /// @param [in] empty        A flag per box set if the box is empty.
+        /// @param [in] scene_bounds The union of the non-empty boxes.
+        /// @param [in] box_count    The number of non-empty boxes.
+        ///
+        /// @return The grid.
+        static Grid BuildGrid(const std::vector<BoundingVolumeExtents>& boxes,
+                              const std::vector<uint8_t>&               empty,
+                              const BoundingVolumeExtents&              scene_bounds,
+                              uint64_t                                  box_count)
+        {
+            const float scene_extent[3] = {
+                scene_bounds.max_x - scene_bounds.min_x, scene_bounds.max_y - scene_bounds.min_y, scene_bounds.max_z - scene_bounds.min_z};
+            const float max_scene_extent = std::max(scene_extent[0], std::max(scene_extent[1], scene_extent[2]));
+
+            // Sample the boxes evenly to find the median extent.
+            std::vector<float> extents;
+            const size_t       stride = std::max<size_t>(boxes.size() / kMedianSampleCount, 1);
+            extents.reserve(kMedianSampleCount + 1);
+            for (size_t i = 0; i < boxes.size(); i += stride)
+            {
+                if (!empty[i])
+                {
+                    const BoundingVolumeExtents& box = boxes[i];
+                    extents.push_back(std::max(box.max_x - box.min_x, std::max(box.max_y - box.min_y, box.max_z - box.min_z)));
+                }
+            }
+
+            float cell_size = 0.0f;
+            if (!extents.empty())
+            {
+                std::nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+                cell_size = extents[extents.size() / 2];
+            }
+            if (!(cell_size > 0.0f))
+            {
+                cell_size = max_scene_extent / std::cbrt(static_cast<float>(std::max<uint64_t>(box_count, 1)));
+            }
+            if (!(cell_size > 0.0f) || !std::isfinite(cell_size))
+            {
+                cell_size = 1.0f;
+            }
+
+            Grid grid      = {};
+            grid.origin[0] = scene_bounds.min_x;
+            grid.origin[1] = scene_bounds.min_y;
+            grid.origin[2] = scene_bounds.min_z;
+
+            const double max_cell_count = static_cast<double>(std::max<uint64_t>(box_count, 1)) * kMaxGridCellsPerBox;
+            for (;;)
+            {
+                double cell_count = 1.0;
+                for (uint32_t axis = 0; axis < 3; axis++)
+                {
+                    cell_count *= std::max(ceil(static_cast<double>(scene_extent[axis]) / cell_size), 1.0);
+                }
+                if (cell_count <= max_cell_count)
+                {
+                    break;
+                }
+                cell_size *= static_cast<float>(std::max(std::cbrt(cell_count / max_cell_count), 1.01));
+            }
+
+            grid.cell_size         = cell_size;
+            grid.inverse_cell_size = 1.0f / cell_size;
+            grid.cell_count        = 1;
+            for (uint32_t axis = 0; axis < 3; axis++)
+            {
+                grid.dimensions[axis] = static_cast<uint32_t>(std::max(ceil(static_cast<double>(scene_extent[axis]) / cell_size), 1.0));
+                grid.cell_count *= grid.dimensions[axis];
+            }
+            return grid;
+        }
+
+        RraErrorCode FindOverlaps(const std::vector<BoundingVolumeExtents>& boxes, uint32_t thread_count, uint32_t max_cluster_count, Result& out_result)
+        {
+            if (boxes.size() > UINT32_MAX)
+            {
+                return kRraErrorInvalidSize;
+            }
+
+            if (thread_count == 0)
+            {
+                thread_count = JobSystem::Get().GetThreadCount();
+            }
+
+            const size_t box_count = boxes.size();
+            out_result.overlap_counts.assign(box_count, 0);
+            out_result.overlap_depths.assign(box_count, 0);
+            out_result.overlapping_pair_count = 0;
+            out_result.grid_dimensions        = {0, 0, 0};
+            out_result.clusters.clear();
+
+            // Find the empty boxes and the scene bounds.
+            std::vector<uint8_t>               empty(box_count, 0);
+            std::vector<BoundingVolumeExtents> thread_bounds(thread_count, {FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX});
+            std::vector<uint64_t>              thread_box_counts(thread_count, 0);
+            JobSystem::Get().ParallelFor(box_count, kBoxBlockSize, thread_count, [&](size_t begin, size_t end, uint32_t thread_index) {
+                BoundingVolumeExtents& bounds = thread_bounds[thread_index];
+                for (size_t i = begin; i < end; i++)
+                {
+                    const BoundingVolumeExtents& box = boxes[i];
+                    if (IsEmpty(box))
+                    {
+                        empty[i] = 1;
+                        continue;
+                    }
+                    bounds.min_x = std::min(bounds.min_x, box.min_x);
+                    bounds.min_y = std::min(bounds.min_y, box.min_y);
+                    bounds.min_z = std::min(bounds.min_z, box.min_z);
+                    bounds.max_x = std::max(bounds.max_x, box.max_x);
+                    bounds.max_y = std::max(bounds.max_y, box.max_y);
+                    bounds.max_z = std::max(bounds.max_z, box.max_z);
+                    thread_box_counts[thread_index]++;
+                }
+            });
+
+            BoundingVolumeExtents scene_bounds    = thread_bounds[0];
+            uint64_t              non_empty_count = 0;
+            for (uint32_t thread_index = 0; thread_index < thread_count; thread_index++)
+            {
+                const BoundingVolumeExtents& bounds = thread_bounds[thread_index];
+                scene_bounds.min_x                  = std::min(scene_bounds.min_x, bounds.min_x);
+                scene_bounds.min_y                  = std::min(scene_bounds.min_y, bounds.min_y);
+                scene_bounds.min_z                  = std::min(scene_bounds.min_z, bounds.min_z);
+                scene_bounds.max_x                  = std::max(scene_bounds.max_x, bounds.max_x);
+                scene_bounds.max_y                  = std::max(scene_bounds.max_y, bounds.max_y);
+                scene_bounds.max_z                  = std::max(scene_bounds.max_z, bounds.max_z);
+                non_empty_count += thread_box_counts[thread_index];
+            }
+
+            if (non_empty_count == 0)
+            {
+                return kRraOk;
+            }
+
+            const Grid grid            = BuildGrid(boxes, empty, scene_bounds, non_empty_count);
+            out_result.grid_dimensions = {grid.dimensions[0], grid.dimensions[1], grid.dimensions[2]};
+
+            // Sort the boxes by the cell holding their minimum corner, so the passes below walk the grid roughly in
+            // order rather than jumping around it. The boxes that touch too many cells are set aside at the end.
+            std::vector<std::vector<uint64_t>> thread_sort_keys(thread_count);
+            std::vector<std::vector<uint32_t>> thread_large_boxes(thread_count);
+            JobSystem::Get().ParallelFor(box_count, kBoxBlockSize, thread_count, [&](size_t begin, size_t end, uint32_t thread_index) {
+                for (size_t i = begin; i < end; i++)
+                {
+                    if (empty[i])
+                    {
+                        continue;
+                    }
+
+                    const CellRange range = GetCellRange(grid, boxes[i]);
+                    if (range.GetCellCount() > kMaxCellsPerBox)
+                    {
+                        thread_large_boxes[thread_index].push_back(static_cast<uint32_t>(i));
+                        continue;
+                    }
+
+                    const uint64_t home_cell = GetCellIndex(grid, range.min[0], range.min[1], range.min[2]);
+                    thread_sort_keys[thread_index].push_back((home_cell << 32) | i);
+                }
+            });
+
+            std::vector<uint64_t> sort_keys;
+            std::vector<uint32_t> large_boxes;
+            sort_keys.reserve(non_empty_count);
+            for (uint32_t thread_index = 0; thread_index < thread_count; thread_index++)
+            {
+                sort_keys.insert(sort_keys.end(), thread_sort_keys[thread_index].begin(), thread_sort_keys[thread_index].end());
+                large_boxes.insert(large_boxes.end(), thread_large_boxes[thread_index].begin(), thread_large_boxes[thread_index].end());
+                thread_sort_keys[thread_index] = {};
+            }
+            std::sort(sort_keys.begin(), sort_keys.end());
+            std::sort(large_boxes.begin(), large_boxes.end());
+
+            // From here on the boxes are addressed by their sorted index. The small boxes come first.
+            const uint32_t                     small_count  = static_cast<uint32_t>(sort_keys.size());
+            const uint32_t                     sorted_count = small_count + static_cast<uint32_t>(large_boxes.size());
+            std::vector<uint32_t>              order(sorted_count);
+            std::vector<BoundingVolumeExtents> sorted_boxes(sorted_count);
+            JobSystem::Get().ParallelFor(sorted_count, kBoxBlockSize, thread_count, [&](size_t begin, size_t end, uint32_t) {
+                for (size_t i = begin; i < end; i++)
+                {
+                    order[i]        = (i < small_count) ? static_cast<uint32_t>(sort_keys[i]) : large_boxes[i - small_count];
+                    sorted_boxes[i] = boxes[order[i]];
+                }
+            });
+
+            // Count the boxes in each cell, lay the cell lists out end to end, then scatter the boxes into them.
+            std::vector<std::atomic<uint32_t>> cell_counts(grid.cell_count);
+            JobSystem::Get().ParallelFor(small_count, kBoxBlockSize, thread_count, [&](size_t begin, size_t end, uint32_t) {
+                for (size_t i = begin; i < end; i++)
+                {
+                    ForEachCell(grid, GetCellRange(grid, sorted_boxes[i]), [&cell_counts](uint64_t cell) {
+                        cell_counts[cell].fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            });
+
+            std::vector<uint64_t> cell_offsets(grid.cell_count + 1);
+            cell_offsets[0] = 0;
+            for (uint64_t cell = 0; cell < grid.cell_count; cell++)
+            {
+                cell_offsets[cell + 1] = cell_offsets[cell] + cell_counts[cell].load(std::memory_order_relaxed);
+            }
+
+            std::vector<uint32_t> cell_boxes(cell_offsets[grid.cell_count]);
+            JobSystem::Get().ParallelFor(small_count, kBoxBlockSize, thread_count, [&](size_t begin, size_t end, uint32_t) {
+                for (size_t i = begin; i < end; i++)
+                {
+                    ForEachCell(grid, GetCellRange(grid, sorted_boxes[i]), [&](uint64_t cell) {
+                        const uint32_t slot                   = cell_counts[cell].fetch_sub(1, std::memory_order_relaxed) - 1;
+                        cell_boxes[cell_offsets[cell] + slot] = static_cast<uint32_t>(i);
+                    });
+                }
+            });
+
+            // The cell occupancy includes the large boxes, so the overlap depth isn't underestimated under them.
+            std::vector<uint32_t> cell_occupancy(grid.cell_count);
+            for (uint64_t cell = 0; cell < grid.cell_count; cell++)
+            {
+                cell_occupancy[cell] = static_cast<uint32_t>(cell_offsets[cell + 1] - cell_offsets[cell]);
+            }
+            for (uint32_t i = small_count; i < sorted_count; i++)
+            {
+                ForEachCell(grid, GetCellRange(grid, sorted_boxes[i]), [&cell_occupancy](uint64_t cell) { cell_occupancy[cell]++; });
+            }
+
+            std::vector<std::atomic<uint32_t>> overlap_counts(sorted_count);
+            std::vector<uint64_t>              thread_pair_counts(thread_count, 0);
+            std::vector<CellScratch>           thread_scratch(thread_count);
+
+            // Test the boxes sharing each cell. A pair is only counted in the cell holding the minimum corner of
+            // its intersection, which both boxes touch, so pairs sharing several cells are counted once. Both boxes
+            // touch that cell, so it is this cell if, along every axis, one of the two boxes starts in this cell.
+            JobSystem::Get().ParallelFor(grid.cell_count, kCellBlockSize, thread_count, [&](size_t begin, size_t end, uint32_t thread_index) {
+                CellScratch& scratch    = thread_scratch[thread_index];
+                uint64_t     pair_count = 0;
+                for (size_t cell = begin; cell < end; cell++)
+                {
+                    const uint32_t* indices = &cell_boxes[cell_offsets[cell]];
+                    const size_t    count   = static_cast<size_t>(cell_offsets[cell + 1] - cell_offsets[cell]);
+                    if (count < 2)
+                    {
+                        continue;
+                    }
+
+                    const uint32_t coordinates[3] = {static_cast<uint32_t>(cell % grid.dimensions[0]),
+                                                     static_cast<uint32_t>((cell / grid.dimensions[0]) % grid.dimensions[1]),
+                                                     static_cast<uint32_t>(cell / (static_cast<uint64_t>(grid.dimensions[0]) * grid.dimensions[1]))};
+
+                    scratch.Load(grid, coordinates, sorted_boxes, indices, count);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        const float   min_x     = scratch.min_x[i];
+                        const float   min_y     = scratch.min_y[i];
+                        const float   min_z     = scratch.min_z[i];
+                        const float   max_x     = scratch.max_x[i];
+                        const float   max_y     = scratch.max_y[i];
+                        const float   max_z     = scratch.max_z[i];
+                        const uint8_t home_axes = scratch.home_axes[i];
+                        uint32_t      hit_count = 0;
+                        for (size_t j = i + 1; j < count; j++)
+                        {
+                            const uint32_t hit = IntervalsOverlap(min_x, max_x, scratch.min_x[j], scratch.max_x[j]) &
+                                                 IntervalsOverlap(min_y, max_y, scratch.min_y[j], scratch.max_y[j]) &
+                                                 IntervalsOverlap(min_z, max_z, scratch.min_z[j], scratch.max_z[j]) &
+                                                 ((home_axes | scratch.home_axes[j]) == 7);
+                            scratch.counts[j] += hit;
+                            hit_count += hit;
+                        }
+                        scratch.counts[i] += hit_count;
+                        pair_count += hit_count;
+                    }
+
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        if (scratch.counts[i] > 0)
+                        {
+                            overlap_counts[indices[i]].fetch_add(scratch.counts[i], std::memory_order_relaxed);
+                        }
+                    }
+                }
+                thread_pair_counts[thread_index] += pair_count;
+            });
+
+            // Test the large boxes against everything. A pair of large boxes is counted by the first of the two only.
+            JobSystem::Get().ParallelFor(sorted_count - small_count, 1, thread_count, [&](size_t begin, size_t end, uint32_t thread_index) {
+                for (size_t large_index = begin; large_index < end; large_index++)
+                {
+                    const uint32_t               a     = small_count + static_cast<uint32_t>(large_index);
+                    const BoundingVolumeExtents& box_a = sorted_boxes[a];
+                    uint32_t                     count = 0;
+                    for (uint32_t b = 0; b < sorted_count; b++)
+                    {
+                        if (b == a || (b >= small_count && b < a) || !BoxesOverlap(box_a, sorted_boxes[b]))
+                        {
+                            continue;
+                        }
+
+                        overlap_counts[b].fetch_add(1, std::memory_order_relaxed);
+                        count++;
+                    }
+                    overlap_counts[a].fetch_add(count, std::memory_order_relaxed);
+                    thread_pair_counts[thread_index] += count;
+                }
+            });
+
+            // The overlap depth of a box is the highest occupancy of the cells it touches.
+            JobSystem::Get().ParallelFor(sorted_count, kBoxBlockSize, thread_count, [&](size_t begin, size_t end, uint32_t) {
+                for (size_t i = begin; i < end; i++)
+                {
+                    uint32_t depth = 0;
+                    ForEachCell(grid, GetCellRange(grid, sorted_boxes[i]), [&](uint64_t cell) { depth = std::max(depth, cell_occupancy[cell]); });
+                    out_result.overlap_counts[order[i]] = overlap_counts[i].load(std::memory_order_relaxed);
+                    out_result.overlap_depths[order[i]] = depth;
+                }
+            });
+
+            for (uint64_t pair_count : thread_pair_counts)
+            {
+                out_result.overlapping_pair_count += pair_count;
+            }
+
+            // The clusters are the most crowded cells.
+            std::vector<uint64_t> crowded_cells;
+            for (uint64_t cell = 0; cell < grid.cell_count; cell++)
+            {
+                if (cell_occupancy[cell] > 1)
+                {
+                    crowded_cells.push_back(cell);
+                }
+            }
+
+            const size_t cluster_count = std::min<size_t>(max_cluster_count, crowded_cells.size());
+            std::partial_sort(crowded_cells.begin(), crowded_cells.begin() + cluster_count, crowded_cells.end(), [&cell_occupancy](uint64_t a, uint64_t b) {
+                return (cell_occupancy[a] != cell_occupancy[b]) ? cell_occupancy[a] > cell_occupancy[b] : a < b;
+            });
+
+            out_result.clusters.reserve(cluster_count);
+            for (size_t i = 0; i < cluster_count; i++)
+            {
+                const uint64_t cell = crowded_cells[i];
+                const float    x    = grid.origin[0] + (cell % grid.dimensions[0]) * grid.cell_size;
+                const float    y    = grid.origin[1] + ((cell / grid.dimensions[0]) % grid.dimensions[1]) * grid.cell_size;
+                const float    z    = grid.origin[2] + (cell / (static_cast<uint64_t>(grid.dimensions[0]) * grid.dimensions[1])) * grid.cell_size;
+
+                Cluster cluster;
+                cluster.bounds.min_x   = x;
+                cluster.bounds.min_y   = y;
+                cluster.bounds.min_z   = z;
+                cluster.bounds.max_x   = std::min(x + grid.cell_size, scene_bounds.max_x);
+                cluster.bounds.max_y   = std::min(y + grid.cell_size, scene_bounds.max_y);
+                cluster.bounds.max_z   = std::min(z + grid.cell_size, scene_bounds.max_z);
+                cluster.instance_count = cell_occupancy[cell];
+                out_result.clusters.push_back(cluster);
+            }
+
+            return kRraOk;
+        }
+    }  // namespace instance_overlap
+}  // namespace rra
@@ -0,0 +1,58 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the instance overlap finder.
+//=============================================================================
+
+#ifndef RRA_BACKEND_INSTANCE_OVERLAP_H_
+#define RRA_BACKEND_INSTANCE_OVERLAP_H_
+
+#include <array>
+#include <vector>
+
+#include "public/rra_bvh.h"
+#include "public/rra_error.h"
+
+// Instance overlap functions. Used only by the backend; the public interface is in rra_instance_overlap.h.
+
+namespace rra
+{
+    namespace instance_overlap
+    {
+        /// @brief A grid cell touched by several instance bounding boxes.
+        struct Cluster
+        {
+            BoundingVolumeExtents bounds;          ///< The bounds of the cell, clipped to the scene bounds.
+            uint32_t              instance_count;  ///< The number of instance bounding boxes touching the cell.
+        };
+
+        /// @brief The overlaps found between a set of bounding boxes.
+        struct Result
+        {
+            std::vector<uint32_t>   overlap_counts;          ///< The number of other boxes each box overlaps.
+            std::vector<uint32_t>   overlap_depths;          ///< The highest number of boxes sharing a grid cell with each box, including itself.
+            uint64_t                overlapping_pair_count;  ///< The number of overlapping pairs of boxes.
+            std::array<uint32_t, 3> grid_dimensions;         ///< The number of grid cells along each axis.
+            std::vector<Cluster>    clusters;                ///< The densest grid cells, densest first.
+        };
+
+        /// @brief Find the overlapping pairs in a set of world space bounding boxes.
+        ///
+        /// The boxes are binned into a uniform grid sized from the median box extent, and only boxes sharing a grid
+        /// cell are tested against each other. Each pair is counted in a single cell, so no pair is counted twice.
+        /// The few boxes that span too many cells are tested against all the other boxes instead.
+        ///
+        /// Boxes with a minimum above their maximum on any axis are treated as empty and never overlap anything.
+        ///
+        /// @param [in]  boxes             The bounding boxes.
+        /// @param [in]  thread_count      The number of threads to use, or 0 for one per core.
+        /// @param [in]  max_cluster_count The maximum number of clusters to return.
+        /// @param [out] out_result        The overlaps found.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        RraErrorCode FindOverlaps(const std::vector<BoundingVolumeExtents>& boxes, uint32_t thread_count, uint32_t max_cluster_count, Result& out_result);
+    }  // namespace instance_overlap
+}  // namespace rra
+
+#endif  // RRA_BACKEND_INSTANCE_OVERLAP_H_
@@ -0,0 +1,392 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the work-stealing job system shared by the backend passes.
+//=============================================================================
+
+#include "job_system.h"
+
+#include <algorithm>
+
+#include "public/rra_assert.h"
+
+/// The index of the calling thread's own queue. Threads outside the pool use the shared queue at index 0.
+static thread_local uint32_t current_queue_index_ = 0;
+
+namespace rra
+{
+    /// @brief Get the default number of threads.
+    ///
+    /// @return One thread per core.
+    static uint32_t GetDefaultThreadCount()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void CancellationToken::Cancel()
+    {
+        cancelled_.store(true);
+    }
+
+    bool CancellationToken::IsCancelled() const
+    {
+        return cancelled_.load();
+    }
+
+    JobGroup::JobGroup(const CancellationToken* cancellation_token)
+        : cancellation_token_(cancellation_token)
+    {
+    }
+
+    JobGroup::~JobGroup()
+    {
+        if (pending_count_ > 0)
+        {
+            JobSystem::Get().Wait(*this);
+        }
+    }
+
+    bool JobGroup::IsCancelled() const
+    {
+        return cancellation_token_ != nullptr && cancellation_token_->IsCancelled();
+    }
+
+    bool JobGroup::IsFinished() const
+    {
+        return pending_count_ == 0;
+    }
+
+    uint32_t TaskGraph::AddTask(std::function<void()> task, const std::vector<uint32_t>& dependencies)
+    {
+        const uint32_t task_index = static_cast<uint32_t>(tasks_.size());
+
+        std::unique_ptr<Task> new_task(new Task);
+        new_task->function         = std::move(task);
+        new_task->dependency_count = static_cast<uint32_t>(dependencies.size());
+        for (uint32_t dependency : dependencies)
+        {
+            RRA_ASSERT(dependency < task_index);
+            tasks_[dependency]->dependents.push_back(task_index);
+        }
+
+        tasks_.push_back(std::move(new_task));
+        return task_index;
+    }
+
+    void TaskGraph::Run(const CancellationToken* cancellation_token)
+    {
+        JobGroup group(cancellation_token);
+        for (auto& task : tasks_)
+        {
+            task->remaining_dependencies = task->dependency_count;
+        }
+
+        for (uint32_t task_index = 0; task_index < tasks_.size(); task_index++)
+        {
+            if (tasks_[task_index]->dependency_count == 0)
+            {
+                SubmitTask(task_index, group);
+            }
+        }
+
+        JobSystem::Get().Wait(group);
+    }
+
+    void TaskGraph::SubmitTask(uint32_t task_index, JobGroup& group)
+    {
+        // A cancelled task is never run, so the tasks that depend on it are never submitted either.
+        JobSystem::Get().Submit(
+            [this, task_index, &group]() {
+                Task& task = *tasks_[task_index];
+                task.function();
+
+                // The dependents are submitted before this job finishes, so the group can't finish early.
+                for (uint32_t dependent : task.dependents)
+                {
+                    if (tasks_[dependent]->remaining_dependencies.fetch_sub(1) == 1)
+                    {
+                        SubmitTask(dependent, group);
+                    }
+                }
+            },
+            group);
+    }
+
+    JobSystem& JobSystem::Get()
+    {
+        static JobSystem job_system;
+        return job_system;
+    }
+
+    JobSystem::JobSystem()
+    {
+        StartWorkers(GetDefaultThreadCount() - 1);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        StopWorkers();
+    }
+
+    void JobSystem::SetThreadCount(uint32_t thread_count)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = GetDefaultThreadCount();
+        }
+
+        if (thread_count != GetThreadCount())
+        {
+            StopWorkers();
+            StartWorkers(thread_count - 1);
+        }
+    }
+
+    uint32_t JobSystem::GetThreadCount() const
+    {
+        return static_cast<uint32_t>(workers_.size()) + 1;
+    }
+
+    void JobSystem::Submit(std::function<void()> job, JobGroup& group)
+    {
+        group.pending_count_++;
+        jobs_submitted_++;
+
+        // The count goes up before the job can be taken, so taking it can't bring the count below zero. It is changed
+        // under the lock, so a thread about to sleep can't miss it.
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            queued_count_++;
+        }
+
+        const uint32_t queue_index = (current_queue_index_ < queues_.size()) ? current_queue_index_ : 0;
+        JobQueue&      queue       = *queues_[queue_index];
+        uint64_t       depth       = 0;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back({std::move(job), &group});
+            depth = queue.jobs.size();
+        }
+
+        uint64_t max_depth = max_queue_depth_.load();
+        while (depth > max_depth && !max_queue_depth_.compare_exchange_weak(max_depth, depth))
+        {
+        }
+
+        wake_condition_.notify_one();
+    }
+
+    void JobSystem::Wait(JobGroup& group)
+    {
+        while (group.pending_count_ > 0)
+        {
+            QueuedJob job;
+            if (TakeJob(job))
+            {
+                RunJob(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_condition_.wait(lock, [this, &group]() { return group.pending_count_ == 0 || queued_count_ > 0; });
+        }
+    }
+
+    void JobSystem::RunConcurrently(uint32_t call_count, const std::function<void(uint32_t)>& function, const CancellationToken* cancellation_token)
+    {
+        if (call_count == 0)
+        {
+            return;
+        }
+
+        JobGroup group(cancellation_token);
+        for (uint32_t call_index = 1; call_index < call_count; call_index++)
+        {
+            Submit([&function, call_index]() { function(call_index); }, group);
+        }
+
+        if (!group.IsCancelled())
+        {
+            function(0);
+        }
+        Wait(group);
+    }
+
+    void JobSystem::ParallelFor(size_t                                                item_count,
+                                size_t                                                block_size,
+                                uint32_t                                              max_concurrency,
+                                const std::function<void(size_t, size_t, uint32_t)>& function,
+                                const CancellationToken*                              cancellation_token)
+    {
+        if (item_count == 0)
+        {
+            return;
+        }
+
+        block_size               = std::max<size_t>(block_size, 1);
+        const size_t block_count = (item_count + block_size - 1) / block_size;
+        uint32_t     call_count  = (max_concurrency > 0) ? std::min(max_concurrency, GetThreadCount()) : GetThreadCount();
+        call_count               = static_cast<uint32_t>(std::min<size_t>(call_count, block_count));
+
+        // Each call takes the next block until there are none left, so a slow block doesn't hold up the others.
+        std::atomic<size_t> next_block(0);
+        RunConcurrently(
+            call_count,
+            [&](uint32_t call_index) {
+                for (size_t block = next_block++; block < block_count; block = next_block++)
+                {
+                    if (cancellation_token != nullptr && cancellation_token->IsCancelled())
+                    {
+                        return;
+                    }
+
+                    const size_t begin = block * block_size;
+                    function(begin, std::min(begin + block_size, item_count), call_index);
+                }
+            },
+            cancellation_token);
+    }
+
+    void JobSystem::GetStats(RraJobSystemStats& out_stats) const
+    {
+        out_stats                  = {};
+        out_stats.thread_count     = GetThreadCount();
+        out_stats.jobs_submitted   = jobs_submitted_;
+        out_stats.jobs_executed    = jobs_executed_;
+        out_stats.jobs_cancelled   = jobs_cancelled_;
+        out_stats.steal_count      = steal_count_;
+        out_stats.max_queue_depth  = max_queue_depth_;
+        out_stats.queued_job_count = queued_count_;
+    }
+
+    void JobSystem::ResetStats()
+    {
+        jobs_submitted_  = 0;
+        jobs_executed_   = 0;
+        jobs_cancelled_  = 0;
+        steal_count_     = 0;
+        max_queue_depth_ = 0;
+    }
+
+    void JobSystem::StartWorkers(uint32_t worker_count)
+    {
+        stopping_ = false;
+
+        queues_.clear();
+        for (uint32_t i = 0; i <= worker_count; i++)
+        {
+            queues_.emplace_back(new JobQueue);
+        }
+
+        for (uint32_t queue_index = 1; queue_index <= worker_count; queue_index++)
+        {
+            workers_.emplace_back(&JobSystem::WorkerMain, this, queue_index);
+        }
+    }
+
+    void JobSystem::StopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_condition_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+        workers_.clear();
+    }
+
+    void JobSystem::WorkerMain(uint32_t queue_index)
+    {
+        current_queue_index_ = queue_index;
+        for (;;)
+        {
+            QueuedJob job;
+            if (TakeJob(job))
+            {
+                RunJob(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_condition_.wait(lock, [this]() { return stopping_ || queued_count_ > 0; });
+            if (stopping_ && queued_count_ == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    bool JobSystem::TakeJob(QueuedJob& out_job)
+    {
+        const uint32_t own_index = (current_queue_index_ < queues_.size()) ? current_queue_index_ : 0;
+
+        // The newest job in the thread's own queue is the most likely to still be in the cache.
+        {
+            JobQueue&                   queue = *queues_[own_index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                out_job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+                queued_count_--;
+                return true;
+            }
+        }
+
+        // Steal the oldest job from another queue, which is likely to be the largest piece of work.
+        for (size_t i = 1; i < queues_.size(); i++)
+        {
+            const size_t                steal_index = (own_index + i) % queues_.size();
+            JobQueue&                   queue       = *queues_[steal_index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty())
+            {
+                out_job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+                queued_count_--;
+                if (steal_index != 0)
+                {
+                    steal_count_++;
+                }
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::RunJob(QueuedJob& job)
+    {
+        if (job.group->IsCancelled())
+        {
+            jobs_cancelled_++;
+        }
+        else
+        {
+            job.function();
+            jobs_executed_++;
+        }
+
+        // Release anything the job holds before the group can be destroyed.
+        JobGroup* group = job.group;
+        job.function    = nullptr;
+        if (group->pending_count_.fetch_sub(1) == 1)
+        {
+            NotifyWaiters();
+        }
+    }
+
+    void JobSystem::NotifyWaiters()
+    {
+        // Taking the lock orders this after a waiter's check of its group, so the wake up can't be missed.
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+        }
+        wake_condition_.notify_all();
+    }
+}  // namespace rra
@@ -0,0 +1,249 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the work-stealing job system shared by the backend passes.
+//=============================================================================
+
+#ifndef RRA_BACKEND_JOB_SYSTEM_H_
+#define RRA_BACKEND_JOB_SYSTEM_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "public/rra_job_system.h"
+
+// Job system. Used only by the backend; the public interface is in rra_job_system.h.
+
+namespace rra
+{
+    /// @brief Lets the code that started some work ask for it to stop early.
+    ///
+    /// Cancelling does not interrupt a job that is already running. Jobs that have not started yet are skipped, and
+    /// long running jobs can poll IsCancelled() to stop early.
+    class CancellationToken
+    {
+    public:
+        /// @brief Ask the work to stop.
+        void Cancel();
+
+        /// @brief Has the work been asked to stop.
+        ///
+        /// @return true if Cancel() has been called, false if not.
+        bool IsCancelled() const;
+
+    private:
+        std::atomic<bool> cancelled_{false};  ///< Set once Cancel() is called.
+    };
+
+    /// @brief A set of jobs that can be waited on together.
+    class JobGroup
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in] cancellation_token Checked before each job in the group starts. May be nullptr.
+        explicit JobGroup(const CancellationToken* cancellation_token = nullptr);
+
+        /// @brief Destructor. Waits for any jobs still running.
+        ~JobGroup();
+
+        /// @brief Has the group been cancelled.
+        ///
+        /// @return true if the group's cancellation token has been cancelled, false if not.
+        bool IsCancelled() const;
+
+        /// @brief Has every job in the group finished.
+        ///
+        /// @return true if no jobs are queued or running, false if not.
+        bool IsFinished() const;
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<size_t>      pending_count_{0};   ///< The number of jobs submitted to the group that have not finished.
+        const CancellationToken* cancellation_token_;  ///< The cancellation token, or nullptr.
+    };
+
+    /// @brief A set of tasks with dependencies between them, run on the job system.
+    ///
+    /// A task only starts once every task it depends on has finished. A task can only depend on tasks added before it,
+    /// so the graph can never contain a cycle.
+    class TaskGraph
+    {
+    public:
+        /// @brief Add a task to the graph.
+        ///
+        /// @param [in] task         The work to do.
+        /// @param [in] dependencies The tasks that must finish first. Each must have been returned by an earlier call.
+        ///
+        /// @return The task's index, used to depend on it.
+        uint32_t AddTask(std::function<void()> task, const std::vector<uint32_t>& dependencies = {});
+
+        /// @brief Run every task in the graph, and wait for them to finish.
+        ///
+        /// The graph can be run again once this returns.
+        ///
+        /// @param [in] cancellation_token Tasks that have not started when this is cancelled are skipped. May be nullptr.
+        void Run(const CancellationToken* cancellation_token = nullptr);
+
+    private:
+        /// @brief A single task in the graph.
+        struct Task
+        {
+            std::function<void()> function;                 ///< The work to do.
+            std::vector<uint32_t> dependents;               ///< The tasks waiting for this one.
+            uint32_t              dependency_count = 0;     ///< The number of tasks this one waits for.
+            std::atomic<uint32_t> remaining_dependencies;   ///< The number of tasks this one is still waiting for while running.
+        };
+
+        /// @brief Submit a task whose dependencies have all finished.
+        ///
+        /// @param [in] task_index The index of the task.
+        /// @param [in] group      The group to submit the task to.
+        void SubmitTask(uint32_t task_index, JobGroup& group);
+
+        std::vector<std::unique_ptr<Task>> tasks_;  ///< The tasks, in the order they were added.
+    };
+
+    /// @brief A pool of worker threads, each with its own queue of jobs.
+    ///
+    /// A worker takes jobs from the back of its own queue, and when that is empty, steals from the front of another
+    /// queue. Jobs submitted from outside the pool go on a shared queue that every worker steals from. A thread waiting
+    /// for a group runs queued jobs while it waits, so jobs can start and wait for more jobs without tying up a worker.
+    class JobSystem
+    {
+    public:
+        /// @brief Get the job system shared by the whole backend.
+        ///
+        /// @return The job system.
+        static JobSystem& Get();
+
+        /// @brief Destructor. Stops the worker threads.
+        ~JobSystem();
+
+        /// @brief Set the number of threads that run jobs.
+        ///
+        /// No jobs may be running when this is called.
+        ///
+        /// @param [in] thread_count The number of threads, including a thread waiting for jobs. 0 uses one per core.
+        void SetThreadCount(uint32_t thread_count);
+
+        /// @brief Get the number of threads that run jobs.
+        ///
+        /// @return The number of worker threads, plus one for a thread waiting for jobs.
+        uint32_t GetThreadCount() const;
+
+        /// @brief Add a job to a group.
+        ///
+        /// @param [in]     job   The job.
+        /// @param [in,out] group The group. Must not be destroyed until the job has finished.
+        void Submit(std::function<void()> job, JobGroup& group);
+
+        /// @brief Wait for every job in a group to finish, running queued jobs in the meantime.
+        ///
+        /// @param [in,out] group The group.
+        void Wait(JobGroup& group);
+
+        /// @brief Run a function several times at once, and wait for them all to finish.
+        ///
+        /// This is for work that pulls its own items from a shared counter and keeps a running total per call. The
+        /// calling thread runs the first call itself.
+        ///
+        /// @param [in] call_count         The number of calls.
+        /// @param [in] function           The function. Called with the index of the call, from 0 to call_count - 1.
+        /// @param [in] cancellation_token Calls that have not started when this is cancelled are skipped. May be nullptr.
+        void RunConcurrently(uint32_t call_count, const std::function<void(uint32_t)>& function, const CancellationToken* cancellation_token = nullptr);
+
+        /// @brief Run a function over blocks of items in parallel, and wait for them all to finish.
+        ///
+        /// @param [in] item_count         The number of items.
+        /// @param [in] block_size         The number of items in each block.
+        /// @param [in] max_concurrency    The most blocks to run at once, or 0 to use every thread.
+        /// @param [in] function           The function to run on each block. Called with the first item, one past the
+        ///                                last item, and an index below max_concurrency that no other block running at
+        ///                                the same time has, for keeping running totals.
+        /// @param [in] cancellation_token Blocks that have not started when this is cancelled are skipped. May be nullptr.
+        void ParallelFor(size_t                                                item_count,
+                         size_t                                                block_size,
+                         uint32_t                                              max_concurrency,
+                         const std::function<void(size_t, size_t, uint32_t)>& function,
+                         const CancellationToken*                              cancellation_token = nullptr);
+
+        /// @brief Get the job system counters.
+        ///
+        /// @param [out] out_stats The counters.
+        void GetStats(RraJobSystemStats& out_stats) const;
+
+        /// @brief Reset the job system counters to zero.
+        void ResetStats();
+
+    private:
+        /// @brief A job waiting to run.
+        struct QueuedJob
+        {
+            std::function<void()> function;  ///< The work to do.
+            JobGroup*             group;     ///< The group the job belongs to.
+        };
+
+        /// @brief A queue of jobs. Index 0 is shared by threads outside the pool; the others each belong to a worker.
+        struct JobQueue
+        {
+            std::mutex            mutex;  ///< Protects the jobs.
+            std::deque<QueuedJob> jobs;   ///< The jobs. The owner pushes and pops at the back, and thieves take from the front.
+        };
+
+        /// @brief Constructor. Starts one thread per core.
+        JobSystem();
+
+        /// @brief Start the worker threads.
+        ///
+        /// @param [in] worker_count The number of worker threads.
+        void StartWorkers(uint32_t worker_count);
+
+        /// @brief Stop the worker threads, once their queues are empty.
+        void StopWorkers();
+
+        /// @brief The main loop of a worker thread.
+        ///
+        /// @param [in] queue_index The index of the worker's own queue.
+        void WorkerMain(uint32_t queue_index);
+
+        /// @brief Take a job from the calling thread's own queue, or steal one from another queue.
+        ///
+        /// @param [out] out_job The job.
+        ///
+        /// @return true if a job was found, false if every queue is empty.
+        bool TakeJob(QueuedJob& out_job);
+
+        /// @brief Run a job, and mark it finished in its group.
+        ///
+        /// @param [in] job The job.
+        void RunJob(QueuedJob& job);
+
+        /// @brief Wake the threads waiting for a group to finish.
+        void NotifyWaiters();
+
+        std::vector<std::unique_ptr<JobQueue>> queues_;                 ///< The shared queue, then one queue per worker.
+        std::vector<std::thread>               workers_;                ///< The worker threads.
+        std::mutex                             wake_mutex_;             ///< Protects stopping_, and orders the wake ups.
+        std::condition_variable                wake_condition_;         ///< Signalled when a job is queued, a group finishes, or the workers stop.
+        std::atomic<size_t>                    queued_count_{0};        ///< The number of jobs in all the queues.
+        bool                                   stopping_ = false;       ///< Set to stop the worker threads.
+        std::atomic<uint64_t>                  jobs_submitted_{0};      ///< The number of jobs submitted.
+        std::atomic<uint64_t>                  jobs_executed_{0};       ///< The number of jobs run.
+        std::atomic<uint64_t>                  jobs_cancelled_{0};      ///< The number of jobs skipped because they were cancelled.
+        std::atomic<uint64_t>                  steal_count_{0};         ///< The number of jobs taken from a queue other than the thread's own.
+        std::atomic<uint64_t>                  max_queue_depth_{0};     ///< The most jobs seen in a single queue.
+    };
+}  // namespace rra
+
+#endif  // RRA_BACKEND_JOB_SYSTEM_H_
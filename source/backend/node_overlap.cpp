@@ -0,0 +1,250 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the node overlap calculator.
+//=============================================================================
+
+#include "node_overlap.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
+#include "bvh/encoded_rt_ip_11_top_level_bvh.h"
+#include "job_system.h"
+#include "public/rra_bvh.h"
+#include "rra_blas_impl.h"
+#include "surface_area_heuristic.h"
+
+namespace rra
+{
+    /// @brief The sibling overlap of a box node.
+    struct SiblingOverlap
+    {
+        float area   = 0.0f;  ///< The overlap surface area, relative to the node's surface area.
+        float volume = 0.0f;  ///< The overlap volume, relative to the node's volume.
+    };
+
+    /// @brief The running totals for a BVH's overlap summary.
+    struct OverlapTotals
+    {
+        double               overlap_area   = 0.0;  ///< The sum of the box node overlap areas.
+        double               overlap_volume = 0.0;  ///< The sum of the box node overlap volumes.
+        double               leaf_tightness = 0.0;  ///< The sum of the triangle node tightness values.
+        uint32_t             box_count      = 0;    ///< The number of box nodes.
+        uint32_t             leaf_count     = 0;    ///< The number of triangle nodes.
+        rta::BvhOverlapStats stats          = {};   ///< The histograms and means.
+    };
+
+    /// @brief Add a value to a histogram.
+    ///
+    /// @param [in] histogram The histogram.
+    /// @param [in] value     The value. Values outside [0, 1] go in the first or last bin.
+    static void AddToHistogram(std::array<uint32_t, rta::kOverlapHistogramBinCount>& histogram, float value)
+    {
+        float    bin   = value * rta::kOverlapHistogramBinCount;
+        uint32_t index = (bin > 0.0f) ? std::min(static_cast<uint32_t>(std::min(bin, 1e6f)), rta::kOverlapHistogramBinCount - 1) : 0;
+        histogram[index]++;
+    }
+
+    /// @brief Calculate the sibling overlap of a box node.
+    ///
+    /// The child bounds are copied into one array per extent, and each child is intersected with all four children.
+    /// A mask rather than a branch drops the pairs that are counted twice, invalid or disjoint.
+    ///
+    /// @param [in] boxes    The child bounding boxes.
+    /// @param [in] children The child node pointers. Invalid children are ignored.
+    ///
+    /// @return The sibling overlap.
+    static SiblingOverlap CalculateSiblingOverlap(const std::array<dxr::amd::AxisAlignedBoundingBox, 4>& boxes,
+                                                  const std::array<dxr::amd::NodePointer, 4>&            children)
+    {
+        float min_x[4], min_y[4], min_z[4];
+        float max_x[4], max_y[4], max_z[4];
+        bool  valid[4];
+
+        dxr::amd::AxisAlignedBoundingBox parent = {{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            valid[i] = !children[i].IsInvalid();
+            min_x[i] = boxes[i].min.x;
+            min_y[i] = boxes[i].min.y;
+            min_z[i] = boxes[i].min.z;
+            max_x[i] = boxes[i].max.x;
+            max_y[i] = boxes[i].max.y;
+            max_z[i] = boxes[i].max.z;
+
+            if (valid[i])
+            {
+                parent.min = {std::min(parent.min.x, min_x[i]), std::min(parent.min.y, min_y[i]), std::min(parent.min.z, min_z[i])};
+                parent.max = {std::max(parent.max.x, max_x[i]), std::max(parent.max.y, max_y[i]), std::max(parent.max.z, max_z[i])};
+            }
+        }
+
+        float pair_area[4]   = {};
+        float pair_volume[4] = {};
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            for (uint32_t j = 0; j < 4; j++)
+            {
+                const float dx = std::min(max_x[i], max_x[j]) - std::max(min_x[i], min_x[j]);
+                const float dy = std::min(max_y[i], max_y[j]) - std::max(min_y[i], min_y[j]);
+                const float dz = std::min(max_z[i], max_z[j]) - std::max(min_z[i], min_z[j]);
+
+                // Only count each pair once, and only if the boxes intersect.
+                const float mask = (j > i && valid[i] && valid[j] && dx >= 0.0f && dy >= 0.0f && dz >= 0.0f) ? 1.0f : 0.0f;
+                pair_area[j] += mask * (dx * dy + dy * dz + dz * dx);
+                pair_volume[j] += mask * (dx * dy * dz);
+            }
+        }
+
+        const float dx         = parent.max.x - parent.min.x;
+        const float dy         = parent.max.y - parent.min.y;
+        const float dz         = parent.max.z - parent.min.z;
+        const float half_area  = dx * dy + dy * dz + dz * dx;
+        const float volume     = dx * dy * dz;
+        const float area_sum   = pair_area[0] + pair_area[1] + pair_area[2] + pair_area[3];
+        const float volume_sum = pair_volume[0] + pair_volume[1] + pair_volume[2] + pair_volume[3];
+
+        SiblingOverlap overlap;
+        overlap.area   = (half_area > 0.0f) ? area_sum / half_area : 0.0f;
+        overlap.volume = (volume > 0.0f) ? volume_sum / volume : 0.0f;
+        return overlap;
+    }
+
+    /// @brief Calculate the tightness of the bounding box stored for a triangle node.
+    ///
+    /// @param [in] blas     The BLAS containing the node.
+    /// @param [in] node_ptr The triangle node.
+    /// @param [in] box      The bounding box stored for the node in its parent.
+    ///
+    /// @return The leaf tightness.
+    static float CalculateLeafTightness(const rta::EncodedRtIp11BottomLevelBvh* blas, const dxr::amd::NodePointer node_ptr, const dxr::amd::AxisAlignedBoundingBox& box)
+    {
+        const uint32_t tri_count     = (node_ptr.GetType() == dxr::amd::NodeType::kAmdNodeTriangle1) ? 2 : 1;
+        const float    triangle_area = RraBlasGetTriangleSurfaceArea(*blas->GetTriangleNode(node_ptr), tri_count);
+
+        BoundingVolumeExtents extents  = {box.min.x, box.min.y, box.min.z, box.max.x, box.max.y, box.max.z};
+        float                 box_area = 0.0f;
+        RraBvhGetBoundingVolumeSurfaceArea(&extents, &box_area);
+
+        return GetTriangleSurfaceAreaHeuristic(triangle_area, tri_count, box_area);
+    }
+
+    /// @brief Calculate the node overlap metrics for a single BVH.
+    ///
+    /// @param [in] bvh  The acceleration structure.
+    /// @param [in] blas The same acceleration structure if it is a BLAS, or nullptr for a TLAS.
+    static void CalculateBvhNodeOverlap(rta::IEncodedRtIp11Bvh* bvh, rta::EncodedRtIp11BottomLevelBvh* blas)
+    {
+        if (bvh->IsEmpty())
+        {
+            return;
+        }
+
+        const uint32_t leaf_nodes_offset = bvh->GetHeader().GetBufferOffsets().leaf_nodes;
+        OverlapTotals  totals;
+
+        std::vector<dxr::amd::NodePointer> stack = {dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize)};
+        while (!stack.empty())
+        {
+            const dxr::amd::NodePointer node_ptr = stack.back();
+            stack.pop_back();
+
+            std::array<dxr::amd::AxisAlignedBoundingBox, 4> boxes;
+            const std::array<dxr::amd::NodePointer, 4>*     children = nullptr;
+            if (node_ptr.IsFp32BoxNode())
+            {
+                const dxr::amd::Float32BoxNode* box_node = bvh->GetFloat32Box(node_ptr);
+                boxes                                    = box_node->GetBoundingBoxes();
+                children                                 = &box_node->GetChildren();
+            }
+            else
+            {
+                const dxr::amd::Float16BoxNode* box_node = bvh->GetFloat16Box(node_ptr);
+                boxes                                    = box_node->GetBoundingBoxes();
+                children                                 = &box_node->GetChildren();
+            }
+
+            const SiblingOverlap overlap = CalculateSiblingOverlap(boxes, *children);
+            bvh->SetInteriorNodeOverlap(node_ptr, overlap.area, overlap.volume);
+            totals.overlap_area += overlap.area;
+            totals.overlap_volume += overlap.volume;
+            totals.box_count++;
+            AddToHistogram(totals.stats.overlap_area_histogram, overlap.area);
+            AddToHistogram(totals.stats.overlap_volume_histogram, overlap.volume);
+
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                const dxr::amd::NodePointer child = (*children)[i];
+                if (child.IsInvalid())
+                {
+                    continue;
+                }
+
+                if (child.IsBoxNode())
+                {
+                    stack.push_back(child);
+                }
+                else if (blas != nullptr && child.IsTriangleNode())
+                {
+                    const float tightness = CalculateLeafTightness(blas, child, boxes[i]);
+                    blas->SetLeafNodeTightness((child.GetByteOffset() - leaf_nodes_offset) / sizeof(dxr::amd::TriangleNode), tightness);
+                    totals.leaf_tightness += tightness;
+                    totals.leaf_count++;
+                    AddToHistogram(totals.stats.leaf_tightness_histogram, tightness);
+                }
+            }
+        }
+
+        if (totals.box_count > 0)
+        {
+            totals.stats.mean_overlap_area   = static_cast<float>(totals.overlap_area / totals.box_count);
+            totals.stats.mean_overlap_volume = static_cast<float>(totals.overlap_volume / totals.box_count);
+        }
+        if (totals.leaf_count > 0)
+        {
+            totals.stats.mean_leaf_tightness = static_cast<float>(totals.leaf_tightness / totals.leaf_count);
+        }
+        bvh->SetOverlapStats(totals.stats);
+    }
+
+    RraErrorCode CalculateNodeOverlap(RraDataSet& data_set)
+    {
+        std::vector<rta::IEncodedRtIp11Bvh*>           bvhs;
+        std::vector<rta::EncodedRtIp11BottomLevelBvh*> blases;
+
+        for (const auto& tlas : data_set.bvh_bundle->GetTopLevelBvhs())
+        {
+            rta::IEncodedRtIp11Bvh* bvh = dynamic_cast<rta::EncodedRtIp11TopLevelBvh*>(&(*tlas));
+            if (bvh == nullptr)
+            {
+                return kRraErrorInvalidPointer;
+            }
+            bvhs.push_back(bvh);
+            blases.push_back(nullptr);
+        }
+
+        for (const auto& blas : data_set.bvh_bundle->GetBottomLevelBvhs())
+        {
+            rta::EncodedRtIp11BottomLevelBvh* bvh = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*blas));
+            if (bvh == nullptr)
+            {
+                return kRraErrorInvalidPointer;
+            }
+            bvhs.push_back(bvh);
+            blases.push_back(bvh);
+        }
+
+        JobSystem::Get().ParallelFor(bvhs.size(), 1, 0, [&bvhs, &blases](size_t begin, size_t end, uint32_t) {
+            for (size_t index = begin; index < end; index++)
+            {
+                CalculateBvhNodeOverlap(bvhs[index], blases[index]);
+            }
+        });
+
+        return kRraOk;
+    }
+}  // namespace rra
@@ -0,0 +1,33 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the node overlap calculator.
+//=============================================================================
+
+#ifndef RRA_BACKEND_NODE_OVERLAP_H_
+#define RRA_BACKEND_NODE_OVERLAP_H_
+
+#include "rra_data_set.h"
+
+// Node overlap calculator functions. Used only by the backend; no public interface.
+
+namespace rra
+{
+    /// @brief Calculate the sibling overlap of the box nodes and the leaf tightness of the triangle nodes in all the TLASes and BLASes.
+    ///
+    /// The sibling overlap of a box node is the sum of the pairwise intersections of its child bounding boxes,
+    /// relative to the node's own bounding box. It is calculated for both surface area and volume. Rays passing
+    /// through an overlapping region have to visit both children, so lower is better.
+    ///
+    /// The leaf tightness of a triangle node is the surface area heuristic of the triangles against the bounding
+    /// box stored for the node in its parent, rather than against the triangles' own bounding box, so it also
+    /// picks up boxes that were made looser by compression.
+    ///
+    /// @param [in] data_set The data set containing the loaded trace data.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode CalculateNodeOverlap(RraDataSet& data_set);
+}  // namespace rra
+
+#endif  // RRA_BACKEND_NODE_OVERLAP_H_
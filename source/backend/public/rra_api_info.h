@@ -10,6 +10,8 @@
 
 #include <stdbool.h>
 
+#include "public/rra_context.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif  // #ifdef __cplusplus
@@ -19,11 +21,21 @@ extern "C" {
 /// @return The text string of the node name.
 const char* RraApiInfoGetApiName();
 
+/// @brief Same as RraApiInfoGetApiName(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraApiInfoGetApiName().
+const char* RraContextApiInfoGetApiName(RraContext* context);
+
 /// @brief Get whether or not the captured application uses Vulkan.
 /// 
 /// @return True if the captured application uses Vulkan, false otherwise.
 bool RraApiInfoIsVulkan();
 
+/// @brief Same as RraApiInfoIsVulkan(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraApiInfoIsVulkan().
+bool RraContextApiInfoIsVulkan(RraContext* context);
+
 #ifdef __cplusplus
 }
 #endif  // #ifdef __cplusplus
@@ -11,6 +11,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "public/rra_context.h"
 #include "public/rra_error.h"
 
 #ifdef __cplusplus
@@ -22,6 +23,11 @@ extern "C" {
 /// @return Pointer to a string containing the device string, or nullptr if invalid.
 const char* RraAsicInfoGetDeviceName();
 
+/// @brief Same as RraAsicInfoGetDeviceName(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetDeviceName().
+const char* RraContextAsicInfoGetDeviceName(RraContext* context);
+
 /// @brief Get the device ID.
 ///
 /// @param [out] A variable to receive the device ID.
@@ -29,6 +35,11 @@ const char* RraAsicInfoGetDeviceName();
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetDeviceID(int32_t* device_id);
 
+/// @brief Same as RraAsicInfoGetDeviceID(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetDeviceID().
+RraErrorCode RraContextAsicInfoGetDeviceID(RraContext* context, int32_t* device_id);
+
 /// @brief Get the device revision ID.
 ///
 /// @param [out] A variable to receive the device revision ID.
@@ -36,6 +47,11 @@ RraErrorCode RraAsicInfoGetDeviceID(int32_t* device_id);
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetDeviceRevisionID(int32_t* device_revision_id);
 
+/// @brief Same as RraAsicInfoGetDeviceRevisionID(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetDeviceRevisionID().
+RraErrorCode RraContextAsicInfoGetDeviceRevisionID(RraContext* context, int32_t* device_revision_id);
+
 /// @brief Get the shader core clock frequency, in MHz.
 ///
 /// @param [out] A variable to receive the shader clock frequency.
@@ -43,6 +59,11 @@ RraErrorCode RraAsicInfoGetDeviceRevisionID(int32_t* device_revision_id);
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetShaderCoreClockFrequency(uint64_t* out_clk_frequency);
 
+/// @brief Same as RraAsicInfoGetShaderCoreClockFrequency(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetShaderCoreClockFrequency().
+RraErrorCode RraContextAsicInfoGetShaderCoreClockFrequency(RraContext* context, uint64_t* out_clk_frequency);
+
 /// @brief Get the maximum shader core clock frequency, in MHz.
 ///
 /// @param [out] A variable to receive the shader clock frequency.
@@ -50,6 +71,11 @@ RraErrorCode RraAsicInfoGetShaderCoreClockFrequency(uint64_t* out_clk_frequency)
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetMaxShaderCoreClockFrequency(uint64_t* out_clk_frequency);
 
+/// @brief Same as RraAsicInfoGetMaxShaderCoreClockFrequency(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetMaxShaderCoreClockFrequency().
+RraErrorCode RraContextAsicInfoGetMaxShaderCoreClockFrequency(RraContext* context, uint64_t* out_clk_frequency);
+
 /// @brief Get the Video RAM size, in bytes.
 ///
 /// @param [out] A variable to receive the video RAM size.
@@ -57,6 +83,11 @@ RraErrorCode RraAsicInfoGetMaxShaderCoreClockFrequency(uint64_t* out_clk_frequen
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetVRAMSize(int64_t* out_vram_size);
 
+/// @brief Same as RraAsicInfoGetVRAMSize(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetVRAMSize().
+RraErrorCode RraContextAsicInfoGetVRAMSize(RraContext* context, int64_t* out_vram_size);
+
 /// @brief Get the memory clock frequency, in MHz.
 ///
 /// @param [out] A variable to receive the memory clock frequency.
@@ -64,6 +95,11 @@ RraErrorCode RraAsicInfoGetVRAMSize(int64_t* out_vram_size);
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetMemoryClockFrequency(uint64_t* out_clk_frequency);
 
+/// @brief Same as RraAsicInfoGetMemoryClockFrequency(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetMemoryClockFrequency().
+RraErrorCode RraContextAsicInfoGetMemoryClockFrequency(RraContext* context, uint64_t* out_clk_frequency);
+
 /// @brief Get the maximum memory clock frequency, in MHz.
 ///
 /// @param [out] A variable to receive the memory clock frequency.
@@ -71,6 +107,11 @@ RraErrorCode RraAsicInfoGetMemoryClockFrequency(uint64_t* out_clk_frequency);
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetMaxMemoryClockFrequency(uint64_t* out_clk_frequency);
 
+/// @brief Same as RraAsicInfoGetMaxMemoryClockFrequency(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetMaxMemoryClockFrequency().
+RraErrorCode RraContextAsicInfoGetMaxMemoryClockFrequency(RraContext* context, uint64_t* out_clk_frequency);
+
 /// @brief Get the video memory bandwidth, in bytes per second.
 ///
 /// @param [out] A variable to receive the memory bandwidth.
@@ -78,11 +119,21 @@ RraErrorCode RraAsicInfoGetMaxMemoryClockFrequency(uint64_t* out_clk_frequency);
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetVideoMemoryBandwidth(uint64_t* out_memory_bandwidth);
 
+/// @brief Same as RraAsicInfoGetVideoMemoryBandwidth(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetVideoMemoryBandwidth().
+RraErrorCode RraContextAsicInfoGetVideoMemoryBandwidth(RraContext* context, uint64_t* out_memory_bandwidth);
+
 /// @brief Get the video memory type as a string.
 ///
 /// @return Pointer to the video memory type string, or nullptr if invalid.
 const char* RraAsicInfoGetVideoMemoryType();
 
+/// @brief Same as RraAsicInfoGetVideoMemoryType(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetVideoMemoryType().
+const char* RraContextAsicInfoGetVideoMemoryType(RraContext* context);
+
 /// @brief Get the video memory bus width, in bits.
 ///
 /// @param [out] A variable to receive the memory bus width.
@@ -90,6 +141,11 @@ const char* RraAsicInfoGetVideoMemoryType();
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetVideoMemoryBusWidth(int32_t* out_bus_width);
 
+/// @brief Same as RraAsicInfoGetVideoMemoryBusWidth(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetVideoMemoryBusWidth().
+RraErrorCode RraContextAsicInfoGetVideoMemoryBusWidth(RraContext* context, int32_t* out_bus_width);
+
 /// @brief Get the ray tracing binary version.
 ///
 /// @param [out] out_version_major A variable to receive the ray tracing major version.
@@ -98,6 +154,11 @@ RraErrorCode RraAsicInfoGetVideoMemoryBusWidth(int32_t* out_bus_width);
 /// @return kRraOk if successful or error code if not.
 RraErrorCode RraAsicInfoGetRaytracingVersion(uint16_t* out_version_major, uint16_t* out_version_minor);
 
+/// @brief Same as RraAsicInfoGetRaytracingVersion(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraAsicInfoGetRaytracingVersion().
+RraErrorCode RraContextAsicInfoGetRaytracingVersion(RraContext* context, uint16_t* out_version_major, uint16_t* out_version_minor);
+
 #ifdef __cplusplus
 }
 #endif  // #ifdef __cplusplus
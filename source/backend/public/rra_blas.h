@@ -11,6 +11,7 @@
 #define RRA_BACKEND_PUBLIC_RRA_BLAS_H_
 
 #include "rra_bvh.h"
+#include "rra_context.h"
 #include "rra_error.h"
 
 #include "vulkan/include/vulkan/vulkan_core.h"
@@ -19,6 +20,31 @@
 extern "C" {
 #endif  // #ifdef __cplusplus
 
+/// @brief Flags for the problems found with a triangle by the triangle scan.
+typedef enum RraTriangleIssueFlagBits
+{
+    kRraTriangleIssueNone          = 0,       ///< No problems found.
+    kRraTriangleIssueZeroArea      = 1 << 0,  ///< The triangle has no area.
+    kRraTriangleIssueSliver        = 1 << 1,  ///< The triangle is extremely long and thin.
+    kRraTriangleIssueNonFinite     = 1 << 2,  ///< A vertex has a NaN or infinite coordinate, and the triangle is not inactive.
+    kRraTriangleIssueDuplicate     = 1 << 3,  ///< Another triangle in the BLAS has the same vertex positions.
+    kRraTriangleIssueOutsideParent = 1 << 4,  ///< The triangle reaches well outside the bounding box stored in its parent node.
+} RraTriangleIssueFlagBits;
+
+/// @brief The number of triangles with each kind of problem.
+///
+/// A triangle can have more than one problem, so the individual counts can add up to more than problem_triangle_count.
+typedef struct RraTriangleIssueCounts
+{
+    uint64_t triangle_count;          ///< The number of triangles scanned, including inactive triangles.
+    uint64_t zero_area_count;         ///< The number of zero area triangles.
+    uint64_t sliver_count;            ///< The number of sliver triangles.
+    uint64_t non_finite_count;        ///< The number of triangles with NaN or infinite vertices.
+    uint64_t duplicate_count;         ///< The number of triangles sharing their vertex positions with another triangle.
+    uint64_t outside_parent_count;    ///< The number of triangles reaching outside their parent's bounding box.
+    uint64_t problem_triangle_count;  ///< The number of triangles with at least one problem.
+} RraTriangleIssueCounts;
+
 /// @brief Get the base address for the blas_index given.
 ///
 /// @param [in]  blas_index  The index of the BLAS to use.
@@ -27,6 +53,11 @@ extern "C" {
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetBaseAddress(uint64_t blas_index, uint64_t* out_address);
 
+/// @brief Same as RraBlasGetBaseAddress(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetBaseAddress().
+RraErrorCode RraContextBlasGetBaseAddress(RraContext* context, uint64_t blas_index, uint64_t* out_address);
+
 /// @brief Is the BLAS empty.
 ///
 /// @param [in]  blas_index  The index of the BLAS to use.
@@ -34,6 +65,11 @@ RraErrorCode RraBlasGetBaseAddress(uint64_t blas_index, uint64_t* out_address);
 /// @return true if empty, false if not.
 bool RraBlasIsEmpty(uint64_t blas_index);
 
+/// @brief Same as RraBlasIsEmpty(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasIsEmpty().
+bool RraContextBlasIsEmpty(RraContext* context, uint64_t blas_index);
+
 /// @brief Get the total number of nodes for the blas_index given.
 ///
 /// The total number of nodes is the sum of the internal nodes and leaf nodes.
@@ -44,6 +80,11 @@ bool RraBlasIsEmpty(uint64_t blas_index);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetTotalNodeCount(uint64_t blas_index, uint64_t* out_node_count);
 
+/// @brief Same as RraBlasGetTotalNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetTotalNodeCount().
+RraErrorCode RraContextBlasGetTotalNodeCount(RraContext* context, uint64_t blas_index, uint64_t* out_node_count);
+
 /// @brief Get the child node count for a given node.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -53,6 +94,11 @@ RraErrorCode RraBlasGetTotalNodeCount(uint64_t blas_index, uint64_t* out_node_co
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetChildNodeCount(uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_count);
 
+/// @brief Same as RraBlasGetChildNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetChildNodeCount().
+RraErrorCode RraContextBlasGetChildNodeCount(RraContext* context, uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_count);
+
 /// @brief Get the child nodes for a given node.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -62,6 +108,11 @@ RraErrorCode RraBlasGetChildNodeCount(uint64_t blas_index, uint32_t parent_node,
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetChildNodes(uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_nodes);
 
+/// @brief Same as RraBlasGetChildNodes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetChildNodes().
+RraErrorCode RraContextBlasGetChildNodes(RraContext* context, uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_nodes);
+
 /// @brief Get the total number of box nodes for the blas_index given.
 ///
 /// The total number of box nodes is the number of internal nodes.
@@ -72,6 +123,11 @@ RraErrorCode RraBlasGetChildNodes(uint64_t blas_index, uint32_t parent_node, uin
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetBoxNodeCount(uint64_t blas_index, uint64_t* out_node_count);
 
+/// @brief Same as RraBlasGetBoxNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetBoxNodeCount().
+RraErrorCode RraContextBlasGetBoxNodeCount(RraContext* context, uint64_t blas_index, uint64_t* out_node_count);
+
 /// @brief Get the number of box-16 nodes for the blas_index given.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -80,6 +136,11 @@ RraErrorCode RraBlasGetBoxNodeCount(uint64_t blas_index, uint64_t* out_node_coun
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetBox16NodeCount(uint64_t blas_index, uint32_t* out_node_count);
 
+/// @brief Same as RraBlasGetBox16NodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetBox16NodeCount().
+RraErrorCode RraContextBlasGetBox16NodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count);
+
 /// @brief Get the number of box-32 nodes for the blas_index given.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -88,6 +149,11 @@ RraErrorCode RraBlasGetBox16NodeCount(uint64_t blas_index, uint32_t* out_node_co
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetBox32NodeCount(uint64_t blas_index, uint32_t* out_node_count);
 
+/// @brief Same as RraBlasGetBox32NodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetBox32NodeCount().
+RraErrorCode RraContextBlasGetBox32NodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count);
+
 /// @brief Get the number of half box-32 nodes for the blas_index given.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -96,6 +162,11 @@ RraErrorCode RraBlasGetBox32NodeCount(uint64_t blas_index, uint32_t* out_node_co
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetHalfBox32NodeCount(uint64_t blas_index, uint32_t* out_node_count);
 
+/// @brief Same as RraBlasGetHalfBox32NodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetHalfBox32NodeCount().
+RraErrorCode RraContextBlasGetHalfBox32NodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count);
+
 /// @brief Get the maximum tree depth for the blas_index given.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -104,6 +175,11 @@ RraErrorCode RraBlasGetHalfBox32NodeCount(uint64_t blas_index, uint32_t* out_nod
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetMaxTreeDepth(uint64_t blas_index, uint32_t* out_tree_depth);
 
+/// @brief Same as RraBlasGetMaxTreeDepth(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetMaxTreeDepth().
+RraErrorCode RraContextBlasGetMaxTreeDepth(RraContext* context, uint64_t blas_index, uint32_t* out_tree_depth);
+
 /// @brief Get the average tree depth of a triangle node for the blas_index given.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -112,6 +188,11 @@ RraErrorCode RraBlasGetMaxTreeDepth(uint64_t blas_index, uint32_t* out_tree_dept
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetAvgTreeDepth(uint64_t blas_index, uint32_t* out_tree_depth);
 
+/// @brief Same as RraBlasGetAvgTreeDepth(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetAvgTreeDepth().
+RraErrorCode RraContextBlasGetAvgTreeDepth(RraContext* context, uint64_t blas_index, uint32_t* out_tree_depth);
+
 /// @brief Get the child node pointer for a given node.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -122,6 +203,11 @@ RraErrorCode RraBlasGetAvgTreeDepth(uint64_t blas_index, uint32_t* out_tree_dept
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetChildNodePtr(uint64_t blas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr);
 
+/// @brief Same as RraBlasGetChildNodePtr(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetChildNodePtr().
+RraErrorCode RraContextBlasGetChildNodePtr(RraContext* context, uint64_t blas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr);
+
 /// @brief Get the base address for a given node.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -131,6 +217,11 @@ RraErrorCode RraBlasGetChildNodePtr(uint64_t blas_index, uint32_t parent_node, u
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetNodeBaseAddress(uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address);
 
+/// @brief Same as RraBlasGetNodeBaseAddress(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetNodeBaseAddress().
+RraErrorCode RraContextBlasGetNodeBaseAddress(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address);
+
 /// @brief Get the base address for a given node's parent.
 ///
 /// @param [in]  blas_index     The index of the BLAS to use.
@@ -140,6 +231,26 @@ RraErrorCode RraBlasGetNodeBaseAddress(uint64_t blas_index, uint32_t node_ptr, u
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetNodeParentBaseAddress(uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address);
 
+/// @brief Same as RraBlasGetNodeParentBaseAddress(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetNodeParentBaseAddress().
+RraErrorCode RraContextBlasGetNodeParentBaseAddress(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address);
+
+/// @brief Get the parent node pointer for a given node.
+///
+/// @param [in]  blas_index          The index of the BLAS to use.
+/// @param [in]  node_ptr            The node whose parent is to be found.
+/// @param [out] out_parent_node_ptr A pointer to receive the parent node pointer.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred. kRraErrorInvalidPointer
+///         is returned for the root node, since it has no parent.
+RraErrorCode RraBlasGetNodeParent(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr);
+
+/// @brief Same as RraBlasGetNodeParent(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetNodeParent().
+RraErrorCode RraContextBlasGetNodeParent(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr);
+
 /// @brief Get the surface area of a given node.
 ///
 /// @param [in]  blas_index          The index of the BLAS to use.
@@ -149,6 +260,11 @@ RraErrorCode RraBlasGetNodeParentBaseAddress(uint64_t blas_index, uint32_t node_
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetSurfaceArea(uint64_t blas_index, uint32_t node_ptr, float* out_surface_area);
 
+/// @brief Same as RraBlasGetSurfaceArea(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetSurfaceArea().
+RraErrorCode RraContextBlasGetSurfaceArea(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_surface_area);
+
 /// @brief Get the surface area heuristic of a given node.
 ///
 /// @param [in]  blas_index                 The index of the BLAS to use.
@@ -158,6 +274,11 @@ RraErrorCode RraBlasGetSurfaceArea(uint64_t blas_index, uint32_t node_ptr, float
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, float* out_surface_area_heuristic);
 
+/// @brief Same as RraBlasGetSurfaceAreaHeuristic(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetSurfaceAreaHeuristic().
+RraErrorCode RraContextBlasGetSurfaceAreaHeuristic(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_surface_area_heuristic);
+
 /// @brief Get the minimum surface area heuristic of a given node's triangle leaf nodes.
 ///
 /// @param [in]  blas_index                     The index of the BLAS to use.
@@ -168,6 +289,15 @@ RraErrorCode RraBlasGetSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_p
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetMinimumSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, bool tri_only, float* out_min_surface_area_heuristic);
 
+/// @brief Same as RraBlasGetMinimumSurfaceAreaHeuristic(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetMinimumSurfaceAreaHeuristic().
+RraErrorCode RraContextBlasGetMinimumSurfaceAreaHeuristic(RraContext* context,
+                                                          uint64_t    blas_index,
+                                                          uint32_t    node_ptr,
+                                                          bool        tri_only,
+                                                          float*      out_min_surface_area_heuristic);
+
 /// @brief Get the average surface area heuristic of a given node's triangle leaf nodes.
 ///
 /// @param [in]  blas_index                     The index of the BLAS to use.
@@ -178,6 +308,15 @@ RraErrorCode RraBlasGetMinimumSurfaceAreaHeuristic(uint64_t blas_index, uint32_t
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetAverageSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, bool tri_only, float* out_avg_surface_area_heuristic);
 
+/// @brief Same as RraBlasGetAverageSurfaceAreaHeuristic(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetAverageSurfaceAreaHeuristic().
+RraErrorCode RraContextBlasGetAverageSurfaceAreaHeuristic(RraContext* context,
+                                                          uint64_t    blas_index,
+                                                          uint32_t    node_ptr,
+                                                          bool        tri_only,
+                                                          float*      out_avg_surface_area_heuristic);
+
 /// @brief Get the surface area heuristic of a given triangle node.
 ///
 /// @param [in]  blas_index                     The index of the BLAS to use.
@@ -187,6 +326,59 @@ RraErrorCode RraBlasGetAverageSurfaceAreaHeuristic(uint64_t blas_index, uint32_t
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetTriangleSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, float* out_tri_surface_area_heuristic);
 
+/// @brief Same as RraBlasGetTriangleSurfaceAreaHeuristic(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetTriangleSurfaceAreaHeuristic().
+RraErrorCode RraContextBlasGetTriangleSurfaceAreaHeuristic(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_tri_surface_area_heuristic);
+
+/// @brief Get the sibling overlap of a given box node.
+///
+/// This is the sum of the pairwise intersections of the node's child bounding boxes, relative to the node's own
+/// bounding box. Rays through an overlapping region must visit more than one child, so lower is better.
+///
+/// @param [in]  blas_index         The index of the BLAS to use.
+/// @param [in]  node_ptr           The box node pointer whose overlap is to be found.
+/// @param [out] out_overlap_area   A pointer to receive the overlap surface area, relative to the node's surface area.
+/// @param [out] out_overlap_volume A pointer to receive the overlap volume, relative to the node's volume.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetSiblingOverlap(uint64_t blas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume);
+
+/// @brief Same as RraBlasGetSiblingOverlap(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetSiblingOverlap().
+RraErrorCode RraContextBlasGetSiblingOverlap(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume);
+
+/// @brief Get the leaf tightness of a given triangle node.
+///
+/// This is the surface area heuristic of the node's triangles against the bounding box stored for the node in its
+/// parent, so it includes any loosening from box compression. Higher is better.
+///
+/// @param [in]  blas_index         The index of the BLAS to use.
+/// @param [in]  node_ptr           The triangle node pointer whose tightness is to be found.
+/// @param [out] out_leaf_tightness A pointer to receive the leaf tightness.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetLeafTightness(uint64_t blas_index, uint32_t node_ptr, float* out_leaf_tightness);
+
+/// @brief Same as RraBlasGetLeafTightness(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetLeafTightness().
+RraErrorCode RraContextBlasGetLeafTightness(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_leaf_tightness);
+
+/// @brief Get the node overlap summary of a BLAS.
+///
+/// @param [in]  blas_index The index of the BLAS to use.
+/// @param [out] out_stats  A pointer to receive the overlap summary.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetOverlapStats(uint64_t blas_index, RraBvhOverlapStats* out_stats);
+
+/// @brief Same as RraBlasGetOverlapStats(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetOverlapStats().
+RraErrorCode RraContextBlasGetOverlapStats(RraContext* context, uint64_t blas_index, RraBvhOverlapStats* out_stats);
+
 /// @brief Get the bounding volume extents of a given node.
 ///
 /// @param [in]  blas_index          The index of the BLAS to use.
@@ -196,6 +388,11 @@ RraErrorCode RraBlasGetTriangleSurfaceAreaHeuristic(uint64_t blas_index, uint32_
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetBoundingVolumeExtents(uint64_t blas_index, uint32_t node_ptr, struct BoundingVolumeExtents* out_extents);
 
+/// @brief Same as RraBlasGetBoundingVolumeExtents(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetBoundingVolumeExtents().
+RraErrorCode RraContextBlasGetBoundingVolumeExtents(RraContext* context, uint64_t blas_index, uint32_t node_ptr, struct BoundingVolumeExtents* out_extents);
+
 /// @brief Retrieve the number of unique triangles in a BLAS mesh.
 ///
 /// @param [in] blas_index           The index of the BLAS to use.
@@ -204,6 +401,11 @@ RraErrorCode RraBlasGetBoundingVolumeExtents(uint64_t blas_index, uint32_t node_
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetUniqueTriangleCount(uint64_t blas_index, uint32_t* out_triangle_count);
 
+/// @brief Same as RraBlasGetUniqueTriangleCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetUniqueTriangleCount().
+RraErrorCode RraContextBlasGetUniqueTriangleCount(RraContext* context, uint64_t blas_index, uint32_t* out_triangle_count);
+
 /// @brief Retrieve the number of triangle nodes in a BLAS mesh.
 ///
 /// @param [in] blas_index           The index of the BLAS to use.
@@ -212,6 +414,11 @@ RraErrorCode RraBlasGetUniqueTriangleCount(uint64_t blas_index, uint32_t* out_tr
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetTriangleNodeCount(uint64_t blas_index, uint32_t* out_triangle_count);
 
+/// @brief Same as RraBlasGetTriangleNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetTriangleNodeCount().
+RraErrorCode RraContextBlasGetTriangleNodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_triangle_count);
+
 /// @brief Retrieve the total number of procedural nodes in a BLAS mesh.
 ///
 /// @param [in] blas_index                  The index of the BLAS to use.
@@ -220,6 +427,11 @@ RraErrorCode RraBlasGetTriangleNodeCount(uint64_t blas_index, uint32_t* out_tria
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetProceduralNodeCount(uint64_t blas_index, uint32_t* out_procedural_node_count);
 
+/// @brief Same as RraBlasGetProceduralNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetProceduralNodeCount().
+RraErrorCode RraContextBlasGetProceduralNodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_procedural_node_count);
+
 /// @brief Retrieve the geometry index for the triangle node.
 ///
 /// @param [in]  blas_index         The index of the BLAS to use.
@@ -229,6 +441,11 @@ RraErrorCode RraBlasGetProceduralNodeCount(uint64_t blas_index, uint32_t* out_pr
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetGeometryIndex(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_geometry_index);
 
+/// @brief Same as RraBlasGetGeometryIndex(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetGeometryIndex().
+RraErrorCode RraContextBlasGetGeometryIndex(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_geometry_index);
+
 /// @brief Retrieve the geometry flags for a triangle node.
 ///
 /// @param [in]  blas_index         The index of the BLAS to use.
@@ -238,6 +455,11 @@ RraErrorCode RraBlasGetGeometryIndex(uint64_t blas_index, uint32_t node_ptr, uin
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetGeometryFlags(uint64_t blas_index, uint32_t geometry_index, uint32_t* out_geometry_flags);
 
+/// @brief Same as RraBlasGetGeometryFlags(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetGeometryFlags().
+RraErrorCode RraContextBlasGetGeometryFlags(RraContext* context, uint64_t blas_index, uint32_t geometry_index, uint32_t* out_geometry_flags);
+
 /// @brief Retrieve whether the node is inactive.
 ///
 /// @param [in]  blas_index         The index of the BLAS to use.
@@ -247,6 +469,11 @@ RraErrorCode RraBlasGetGeometryFlags(uint64_t blas_index, uint32_t geometry_inde
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetIsInactive(uint64_t blas_index, uint32_t node_ptr, bool* out_is_inactive);
 
+/// @brief Same as RraBlasGetIsInactive(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetIsInactive().
+RraErrorCode RraContextBlasGetIsInactive(RraContext* context, uint64_t blas_index, uint32_t node_ptr, bool* out_is_inactive);
+
 /// @brief Retrieve the number of triangles on a given node.
 ///
 /// @param [in] blas_index The index of the BLAS to use.
@@ -256,6 +483,11 @@ RraErrorCode RraBlasGetIsInactive(uint64_t blas_index, uint32_t node_ptr, bool*
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetNodeTriangleCount(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_triangle_count);
 
+/// @brief Same as RraBlasGetNodeTriangleCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetNodeTriangleCount().
+RraErrorCode RraContextBlasGetNodeTriangleCount(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_triangle_count);
+
 /// @brief Retrieve the triangles stored in the given node id.
 ///
 /// @param [in] blas_index The index of the BLAS to use.
@@ -265,6 +497,11 @@ RraErrorCode RraBlasGetNodeTriangleCount(uint64_t blas_index, uint32_t node_ptr,
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetNodeTriangles(uint64_t blas_index, uint32_t node_ptr, struct TriangleVertices* out_triangles);
 
+/// @brief Same as RraBlasGetNodeTriangles(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetNodeTriangles().
+RraErrorCode RraContextBlasGetNodeTriangles(RraContext* context, uint64_t blas_index, uint32_t node_ptr, struct TriangleVertices* out_triangles);
+
 /// @brief Retrieve the vertices stored in the given node id.
 ///
 /// @param [in] blas_index The index of the BLAS to use.
@@ -274,6 +511,11 @@ RraErrorCode RraBlasGetNodeTriangles(uint64_t blas_index, uint32_t node_ptr, str
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetNodeVertices(uint64_t blas_index, uint32_t node_ptr, struct VertexPosition* out_vertices);
 
+/// @brief Same as RraBlasGetNodeVertices(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetNodeVertices().
+RraErrorCode RraContextBlasGetNodeVertices(RraContext* context, uint64_t blas_index, uint32_t node_ptr, struct VertexPosition* out_vertices);
+
 /// @brief Retrieve the primitive index of a triangle node.
 ///
 /// @param [in] blas_index The index of the BLAS to use.
@@ -283,6 +525,11 @@ RraErrorCode RraBlasGetNodeVertices(uint64_t blas_index, uint32_t node_ptr, stru
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetPrimitiveIndex(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_primitive_index);
 
+/// @brief Same as RraBlasGetPrimitiveIndex(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetPrimitiveIndex().
+RraErrorCode RraContextBlasGetPrimitiveIndex(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_primitive_index);
+
 /// @brief Retrieve the build flags used to build this BLAS.
 ///
 /// @param [in] blas_index The index of the BLAS to use.
@@ -291,6 +538,11 @@ RraErrorCode RraBlasGetPrimitiveIndex(uint64_t blas_index, uint32_t node_ptr, ui
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetBuildFlags(uint64_t blas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags);
 
+/// @brief Same as RraBlasGetBuildFlags(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetBuildFlags().
+RraErrorCode RraContextBlasGetBuildFlags(RraContext* context, uint64_t blas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags);
+
 /// @brief Get the size of the BLAS, in bytes.
 ///
 /// @param [in] blas_index         The index of the BLAS to use.
@@ -299,6 +551,141 @@ RraErrorCode RraBlasGetBuildFlags(uint64_t blas_index, VkBuildAccelerationStruct
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBlasGetSizeInBytes(uint64_t blas_index, uint32_t* out_size_in_bytes);
 
+/// @brief Same as RraBlasGetSizeInBytes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetSizeInBytes().
+RraErrorCode RraContextBlasGetSizeInBytes(RraContext* context, uint64_t blas_index, uint32_t* out_size_in_bytes);
+
+/// @brief Get the hash of the raw node data of the BLAS.
+///
+/// BLASes with the same content hash are bit-identical.
+///
+/// @param [in]  blas_index       The index of the BLAS to use.
+/// @param [out] out_content_hash The content hash.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetContentHash(uint64_t blas_index, uint64_t* out_content_hash);
+
+/// @brief Same as RraBlasGetContentHash(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetContentHash().
+RraErrorCode RraContextBlasGetContentHash(RraContext* context, uint64_t blas_index, uint64_t* out_content_hash);
+
+/// @brief Get the hash of the triangle geometry of the BLAS.
+///
+/// The hash does not depend on the BVH layout, so BLASes built separately from the same
+/// triangles have the same geometry hash.
+///
+/// @param [in]  blas_index        The index of the BLAS to use.
+/// @param [out] out_geometry_hash The geometry hash, or 0 if the BLAS has no triangles.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetGeometryHash(uint64_t blas_index, uint64_t* out_geometry_hash);
+
+/// @brief Same as RraBlasGetGeometryHash(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetGeometryHash().
+RraErrorCode RraContextBlasGetGeometryHash(RraContext* context, uint64_t blas_index, uint64_t* out_geometry_hash);
+
+/// @brief Get the index of the first BLAS with the same geometry as this one.
+///
+/// @param [in]  blas_index     The index of the BLAS to use.
+/// @param [out] out_blas_index The index of the first BLAS with the same geometry. This is
+/// blas_index if the BLAS is not a duplicate.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetDuplicateOf(uint64_t blas_index, uint64_t* out_blas_index);
+
+/// @brief Same as RraBlasGetDuplicateOf(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetDuplicateOf().
+RraErrorCode RraContextBlasGetDuplicateOf(RraContext* context, uint64_t blas_index, uint64_t* out_blas_index);
+
+/// @brief Get the number of geometries in the BLAS.
+///
+/// @param [in]  blas_index         The index of the BLAS to use.
+/// @param [out] out_geometry_count The number of geometries.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetGeometryCount(uint64_t blas_index, uint32_t* out_geometry_count);
+
+/// @brief Same as RraBlasGetGeometryCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetGeometryCount().
+RraErrorCode RraContextBlasGetGeometryCount(RraContext* context, uint64_t blas_index, uint32_t* out_geometry_count);
+
+/// @brief Get the problems found with the triangles in a given triangle node.
+///
+/// The triangles of every BLAS are scanned once after the trace is loaded.
+///
+/// @param [in]  blas_index      The index of the BLAS to use.
+/// @param [in]  node_ptr        The triangle node pointer.
+/// @param [out] out_issue_flags The RraTriangleIssueFlagBits of all the triangles in the node.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetTriangleIssueFlags(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_issue_flags);
+
+/// @brief Same as RraBlasGetTriangleIssueFlags(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetTriangleIssueFlags().
+RraErrorCode RraContextBlasGetTriangleIssueFlags(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_issue_flags);
+
+/// @brief Get the number of triangles with each kind of problem in the BLAS.
+///
+/// @param [in]  blas_index The index of the BLAS to use.
+/// @param [out] out_counts A pointer to receive the counts.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetTriangleIssueCounts(uint64_t blas_index, RraTriangleIssueCounts* out_counts);
+
+/// @brief Same as RraBlasGetTriangleIssueCounts(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetTriangleIssueCounts().
+RraErrorCode RraContextBlasGetTriangleIssueCounts(RraContext* context, uint64_t blas_index, RraTriangleIssueCounts* out_counts);
+
+/// @brief Get the number of triangles with each kind of problem in a single geometry of the BLAS.
+///
+/// @param [in]  blas_index     The index of the BLAS to use.
+/// @param [in]  geometry_index The index of the geometry, less than the count from RraBlasGetGeometryCount().
+/// @param [out] out_counts     A pointer to receive the counts.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetGeometryTriangleIssueCounts(uint64_t blas_index, uint32_t geometry_index, RraTriangleIssueCounts* out_counts);
+
+/// @brief Same as RraBlasGetGeometryTriangleIssueCounts(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetGeometryTriangleIssueCounts().
+RraErrorCode RraContextBlasGetGeometryTriangleIssueCounts(RraContext*             context,
+                                                          uint64_t                blas_index,
+                                                          uint32_t                geometry_index,
+                                                          RraTriangleIssueCounts* out_counts);
+
+/// @brief Get the number of triangle nodes in the BLAS with at least one problem.
+///
+/// @param [in]  blas_index     The index of the BLAS to use.
+/// @param [out] out_node_count The number of triangle nodes.
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetProblemTriangleNodeCount(uint64_t blas_index, uint32_t* out_node_count);
+
+/// @brief Same as RraBlasGetProblemTriangleNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetProblemTriangleNodeCount().
+RraErrorCode RraContextBlasGetProblemTriangleNodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count);
+
+/// @brief Get the triangle nodes in the BLAS with at least one problem.
+///
+/// @param [in]  blas_index    The index of the BLAS to use.
+/// @param [out] out_node_ptrs An array to receive the node pointers, sized by RraBlasGetProblemTriangleNodeCount().
+///
+/// @returns kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBlasGetProblemTriangleNodes(uint64_t blas_index, uint32_t* out_node_ptrs);
+
+/// @brief Same as RraBlasGetProblemTriangleNodes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBlasGetProblemTriangleNodes().
+RraErrorCode RraContextBlasGetProblemTriangleNodes(RraContext* context, uint64_t blas_index, uint32_t* out_node_ptrs);
+
 #ifdef __cplusplus
 }
 #endif  // #ifdef __cplusplus
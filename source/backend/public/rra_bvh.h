@@ -12,6 +12,7 @@
 
 #include <stdbool.h>
 
+#include "rra_context.h"
 #include "rra_error.h"
 
 #ifdef __cplusplus
@@ -53,6 +54,25 @@ struct TriangleVertices
     VertexPosition c;  ///< The third vertex in the triangle.
 };
 
+/// @brief The number of bins in the node overlap histograms.
+enum
+{
+    kRraBvhOverlapHistogramBinCount = 10
+};
+
+/// @brief A summary of the sibling overlap and leaf tightness of the nodes in an acceleration structure.
+///
+/// The histogram bins cover [0, 1] in equal steps. The last bin also counts values above 1.
+typedef struct RraBvhOverlapStats
+{
+    float    mean_overlap_area;                                          ///< The mean sibling overlap area of the box nodes.
+    float    mean_overlap_volume;                                        ///< The mean sibling overlap volume of the box nodes.
+    float    mean_leaf_tightness;                                        ///< The mean leaf tightness of the triangle nodes. Zero for a TLAS.
+    uint32_t overlap_area_histogram[kRraBvhOverlapHistogramBinCount];    ///< The box nodes binned by sibling overlap area.
+    uint32_t overlap_volume_histogram[kRraBvhOverlapHistogramBinCount];  ///< The box nodes binned by sibling overlap volume.
+    uint32_t leaf_tightness_histogram[kRraBvhOverlapHistogramBinCount];  ///< The triangle nodes binned by leaf tightness. Zero for a TLAS.
+} RraBvhOverlapStats;
+
 /// @brief Get the root node pointer for an acceleration structure.
 ///
 /// @param [out] out_node_ptr        A pointer to receive the node pointer.
@@ -137,6 +157,11 @@ bool RraBvhIsProceduralNode(uint32_t node_ptr);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetTlasCount(uint64_t* out_count);
 
+/// @brief Same as RraBvhGetTlasCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetTlasCount().
+RraErrorCode RraContextBvhGetTlasCount(RraContext* context, uint64_t* out_count);
+
 /// @brief Get the total number of BLAS's in the loaded trace.
 ///
 /// This doesn't include the empty BLAS placeholder for missing
@@ -147,6 +172,11 @@ RraErrorCode RraBvhGetTlasCount(uint64_t* out_count);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetBlasCount(uint64_t* out_count);
 
+/// @brief Same as RraBvhGetBlasCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetBlasCount().
+RraErrorCode RraContextBvhGetBlasCount(RraContext* context, uint64_t* out_count);
+
 /// @brief Get the total number of BLAS's in the backend.
 ///
 /// This is the array size used to hold the BLASes.
@@ -156,6 +186,11 @@ RraErrorCode RraBvhGetBlasCount(uint64_t* out_count);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetTotalBlasCount(uint64_t* out_count);
 
+/// @brief Same as RraBvhGetTotalBlasCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetTotalBlasCount().
+RraErrorCode RraContextBvhGetTotalBlasCount(RraContext* context, uint64_t* out_count);
+
 /// @brief Get the number of missing BLAS's in the loaded trace.
 ///
 /// @param [out] out_count A pointer to receive the number of missing BLAS's.
@@ -163,6 +198,11 @@ RraErrorCode RraBvhGetTotalBlasCount(uint64_t* out_count);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetMissingBlasCount(uint64_t* out_count);
 
+/// @brief Same as RraBvhGetMissingBlasCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetMissingBlasCount().
+RraErrorCode RraContextBvhGetMissingBlasCount(RraContext* context, uint64_t* out_count);
+
 /// @brief Get the number of inactive instances in the loaded trace.
 ///
 /// @param [out] out_count A pointer to receive the number of inactive instances.
@@ -170,6 +210,11 @@ RraErrorCode RraBvhGetMissingBlasCount(uint64_t* out_count);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetInactiveInstancesCount(uint64_t* out_count);
 
+/// @brief Same as RraBvhGetInactiveInstancesCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetInactiveInstancesCount().
+RraErrorCode RraContextBvhGetInactiveInstancesCount(RraContext* context, uint64_t* out_count);
+
 /// @brief Get the number of empty BLAS's in the loaded trace.
 ///
 /// @param [out] out_count A pointer to receive the number of empty BLAS's.
@@ -177,6 +222,37 @@ RraErrorCode RraBvhGetInactiveInstancesCount(uint64_t* out_count);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetEmptyBlasCount(uint64_t* out_count);
 
+/// @brief Same as RraBvhGetEmptyBlasCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetEmptyBlasCount().
+RraErrorCode RraContextBvhGetEmptyBlasCount(RraContext* context, uint64_t* out_count);
+
+/// @brief Get the number of BLAS's in the loaded trace that duplicate the geometry of another BLAS.
+///
+/// The first BLAS with a given geometry is not counted, only the copies.
+///
+/// @param [out] out_count A pointer to receive the number of duplicate BLAS's.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBvhGetDuplicateBlasCount(uint64_t* out_count);
+
+/// @brief Same as RraBvhGetDuplicateBlasCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetDuplicateBlasCount().
+RraErrorCode RraContextBvhGetDuplicateBlasCount(RraContext* context, uint64_t* out_count);
+
+/// @brief Get the memory that could be saved by removing the duplicate BLAS's, in bytes.
+///
+/// @param [out] out_size_in_bytes The total size of the duplicate BLAS's.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraBvhGetDuplicateBlasSizeInBytes(uint64_t* out_size_in_bytes);
+
+/// @brief Same as RraBvhGetDuplicateBlasSizeInBytes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetDuplicateBlasSizeInBytes().
+RraErrorCode RraContextBvhGetDuplicateBlasSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes);
+
 /// @brief Get the size of all TLASes in the trace, in bytes.
 ///
 /// @param [out] out_size_in_bytes The size of the TLASes in the trace.
@@ -184,6 +260,11 @@ RraErrorCode RraBvhGetEmptyBlasCount(uint64_t* out_count);
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetTotalTlasSizeInBytes(uint64_t* out_size_in_bytes);
 
+/// @brief Same as RraBvhGetTotalTlasSizeInBytes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetTotalTlasSizeInBytes().
+RraErrorCode RraContextBvhGetTotalTlasSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes);
+
 /// @brief Get the size of all BLASes in the trace, in bytes.
 ///
 /// @param [out] out_size_in_bytes The size of the BLASes in the trace.
@@ -191,6 +272,11 @@ RraErrorCode RraBvhGetTotalTlasSizeInBytes(uint64_t* out_size_in_bytes);
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetTotalBlasSizeInBytes(uint64_t* out_size_in_bytes);
 
+/// @brief Same as RraBvhGetTotalBlasSizeInBytes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetTotalBlasSizeInBytes().
+RraErrorCode RraContextBvhGetTotalBlasSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes);
+
 /// @brief Get the size of all TLASes and BLASes in the trace, in bytes.
 ///
 /// @param [out] out_size_in_bytes The size of the TLASes and BLASes in the trace.
@@ -198,6 +284,11 @@ RraErrorCode RraBvhGetTotalBlasSizeInBytes(uint64_t* out_size_in_bytes);
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraBvhGetTotalTraceSizeInBytes(uint64_t* out_size_in_bytes);
 
+/// @brief Same as RraBvhGetTotalTraceSizeInBytes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraBvhGetTotalTraceSizeInBytes().
+RraErrorCode RraContextBvhGetTotalTraceSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes);
+
 #ifdef __cplusplus
 }
 #endif  // #ifdef __cplusplus
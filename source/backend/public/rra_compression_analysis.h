@@ -0,0 +1,116 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the compression analysis interface.
+///
+/// Estimates how much memory a BLAS would take if it had been built with a
+/// different triangle compression or fp16 box node mode. The triangles are
+/// checked for shared edges to see how many could be paired into a single
+/// leaf node, and the fp32 box nodes are checked to see how many could be
+/// stored as fp16 box nodes without loosening the bounding boxes too much.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_COMPRESSION_ANALYSIS_H_
+#define RRA_BACKEND_PUBLIC_RRA_COMPRESSION_ANALYSIS_H_
+
+#include <stdint.h>
+
+#include "rra_context.h"
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief The triangle compression modes. Matches the mode stored in the BLAS header.
+typedef enum
+{
+    kRraTriangleCompressionModeNone          = 0,  ///< One triangle per leaf node.
+    kRraTriangleCompressionModeTwoTriangles  = 1,  ///< Two triangles per leaf node, each with its own node pointer.
+    kRraTriangleCompressionModePairTriangles = 2,  ///< Two triangles sharing an edge per leaf node, with a single node pointer.
+    kRraTriangleCompressionModeAutomatic     = 3,  ///< Chosen by the driver.
+    kRraTriangleCompressionModeFourTriangles = 4,  ///< Four triangles per leaf node.
+} RraTriangleCompressionMode;
+
+/// @brief The fp16 box node modes. Matches the mode stored in the BLAS header.
+typedef enum
+{
+    kRraBoxFp16ModeNone          = 0,  ///< All box nodes are fp32.
+    kRraBoxFp16ModeLeafNodesOnly = 1,  ///< Box nodes whose children are all leaf nodes are fp16.
+    kRraBoxFp16ModeMixedWithFp32 = 2,  ///< Box nodes are fp16 if converting them loosens the bounding boxes by less than a tolerance.
+    kRraBoxFp16ModeAll           = 3,  ///< All box nodes except the root are fp16.
+
+    kRraBoxFp16ModeCount  ///< The number of fp16 box node modes.
+} RraBoxFp16Mode;
+
+/// @brief The compression analysis of a BLAS.
+///
+/// The projected sizes only count the nodes reachable from the root, so they may be smaller than the buffer sizes
+/// stored in the header, which are allocated for the worst case.
+typedef struct RraBlasCompressionStats
+{
+    RraTriangleCompressionMode triangle_compression_mode;                                  ///< The triangle compression mode the BLAS was built with.
+    RraBoxFp16Mode             box_fp16_mode;                                              ///< The fp16 box node mode the BLAS was built with.
+    uint64_t                   triangle_count;                                             ///< The number of active triangles.
+    uint64_t                   leaf_node_count;                                            ///< The number of leaf nodes, including procedural nodes.
+    uint64_t                   shared_edge_pair_count;                                     ///< The number of triangle pairs sharing an edge that could each go in one leaf node.
+    float                      pair_compression_ratio;                                     ///< The leaf node count with pair compression over the count without. 0.5 is the best case.
+    uint64_t                   leaf_node_buffer_size;                                      ///< The leaf node buffer size for the current mode, from the header.
+    uint64_t                   uncompressed_leaf_node_buffer_size;                         ///< The projected leaf node buffer size without triangle compression.
+    uint64_t                   pair_compressed_leaf_node_buffer_size;                      ///< The projected leaf node buffer size with pair compression.
+    uint64_t                   fp32_box_node_count;                                        ///< The number of fp32 box nodes.
+    uint64_t                   fp16_box_node_count;                                        ///< The number of fp16 box nodes.
+    uint64_t                   fp16_representable_box_node_count;                          ///< The number of non-root box nodes that are fp16 or could be within the tolerance.
+    float                      fp16_representable_fraction;                                ///< The fraction of the non-root box nodes that are fp16 or could be within the tolerance.
+    uint64_t                   interior_node_buffer_size;                                  ///< The size of the box nodes as captured.
+    uint64_t                   projected_interior_node_buffer_size[kRraBoxFp16ModeCount];  ///< The projected size of the box nodes, indexed by RraBoxFp16Mode.
+} RraBlasCompressionStats;
+
+/// @brief Analyze the compression opportunities for a BLAS.
+///
+/// The shared edges are found by hashing the vertex positions, and only triangles in the same geometry are paired.
+/// Each triangle is paired at most once, so the pair count is an estimate of what a builder pairing triangles
+/// across the whole mesh could achieve.
+///
+/// A box node could be fp16 if, after rounding each child bounding box outwards to half precision, no bound moves
+/// by more than the tolerance times the largest extent of the node.
+///
+/// @param [in]  blas_index     The index of the BLAS to analyze.
+/// @param [in]  fp16_tolerance How far the bounds of a box node may move when converted to fp16, as a fraction of the node's largest extent.
+/// @param [out] out_stats      A pointer to receive the analysis.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraCompressionAnalyzeBlas(uint64_t blas_index, float fp16_tolerance, RraBlasCompressionStats* out_stats);
+
+/// @brief Same as RraCompressionAnalyzeBlas(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraCompressionAnalyzeBlas().
+RraErrorCode RraContextCompressionAnalyzeBlas(RraContext* context, uint64_t blas_index, float fp16_tolerance, RraBlasCompressionStats* out_stats);
+
+/// @brief Analyze the compression opportunities for all the BLASes in parallel.
+///
+/// @param [in]  thread_count    The number of threads to use, or 0 for one per core.
+/// @param [in]  fp16_tolerance  How far the bounds of a box node may move when converted to fp16, as a fraction of the node's largest extent.
+/// @param [out] out_blas_stats  An array to receive the analysis for each BLAS. It must hold RraBvhGetTotalBlasCount() entries. May be NULL.
+/// @param [out] out_total_stats A pointer to receive the counts and sizes summed over all the BLASes. The modes are left as kNone. May be NULL.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraCompressionAnalyzeAllBlases(uint32_t                 thread_count,
+                                            float                    fp16_tolerance,
+                                            RraBlasCompressionStats* out_blas_stats,
+                                            RraBlasCompressionStats* out_total_stats);
+
+/// @brief Same as RraCompressionAnalyzeAllBlases(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraCompressionAnalyzeAllBlases().
+RraErrorCode RraContextCompressionAnalyzeAllBlases(RraContext*              context,
+                                                   uint32_t                 thread_count,
+                                                   float                    fp16_tolerance,
+                                                   RraBlasCompressionStats* out_blas_stats,
+                                                   RraBlasCompressionStats* out_total_stats);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+#endif  // RRA_BACKEND_PUBLIC_RRA_COMPRESSION_ANALYSIS_H_
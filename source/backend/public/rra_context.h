@@ -0,0 +1,87 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the backend context interface.
+///
+/// A context holds one loaded trace. Several contexts can exist at once, so the
+/// backend can hold more than one trace at a time.
+///
+/// Each function that queries a trace has a version taking the context to query,
+/// named RraContext followed by the rest of the function's name, so RraBlasIsEmpty()
+/// has RraContextBlasIsEmpty(). The context passed to them must not be NULL. The
+/// versions without a context query the default context, which is the one the
+/// RraTraceLoader* functions load into.
+///
+/// Functions that only query a loaded trace do not modify the context, so they
+/// can be called from several threads at once, on the same or on different
+/// contexts. A context must not be loaded, unloaded or destroyed while another
+/// thread is querying it.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_CONTEXT_H_
+#define RRA_BACKEND_PUBLIC_RRA_CONTEXT_H_
+
+#include <time.h>
+
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief An opaque handle to a backend context.
+typedef struct RraContext RraContext;
+
+/// @brief Create a new, empty context.
+///
+/// @param [out] out_context A pointer to receive the new context.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraContextCreate(RraContext** out_context);
+
+/// @brief Destroy a context created with RraContextCreate(), unloading its trace.
+///
+/// @param [in] context The context to destroy.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraContextDestroy(RraContext* context);
+
+/// @brief Get the default context.
+///
+/// @return The default context. This is never NULL.
+RraContext* RraContextGetDefault();
+
+/// @brief Load a trace file into a context, replacing any trace already loaded.
+///
+/// @param [in] context         The context to load into.
+/// @param [in] trace_file_name The name of the trace file to load.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraContextLoadTrace(RraContext* context, const char* trace_file_name);
+
+/// @brief Unload the trace in a context.
+///
+/// @param [in] context The context to unload.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraContextUnloadTrace(RraContext* context);
+
+/// @brief Does a context have a trace loaded.
+///
+/// @param [in] context The context to check.
+///
+/// @return true if a trace is loaded, false if not.
+bool RraContextIsTraceLoaded(const RraContext* context);
+
+/// @brief Get the time the trace loaded into a context was created.
+///
+/// @param [in] context The context to query.
+///
+/// @return The time the trace was created, or 0 if no trace is loaded.
+time_t RraContextGetTraceCreateTime(const RraContext* context);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+#endif  // RRA_BACKEND_PUBLIC_RRA_CONTEXT_H_
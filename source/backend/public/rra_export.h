@@ -0,0 +1,78 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the statistics export interface.
+///
+/// Exports the per-TLAS, BLAS, instance and triangle statistics of the loaded
+/// trace as a set of column files for use by external tools.
+///
+/// Each table is written as one file per column, named
+/// <c><i>table.column.rracol</i></c>. A column file starts with a
+/// RraExportColumnHeader, followed by row_count * components values of the
+/// column type, stored little-endian with no padding. The values start at a
+/// 32 byte offset so the file can be memory-mapped and used directly as an array.
+///
+/// A <c><i>manifest.json</i></c> file lists the tables, their row counts and
+/// the name, type and file of every column. Rows left out of a table are
+/// counted there too: skipped_row_count for rows that couldn't be read, and
+/// inactive_instance_count for the instances that have no row.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_EXPORT_H_
+#define RRA_BACKEND_PUBLIC_RRA_EXPORT_H_
+
+#include <stdint.h>
+
+#include "rra_context.h"
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief The magic number at the start of every column file ("RRACOL01" read as little-endian).
+static const uint64_t kRraExportColumnMagic = 0x31304c4f43415252ULL;
+
+/// @brief The version of the column file format.
+static const uint32_t kRraExportColumnVersion = 1;
+
+/// @brief The value types that can be stored in a column.
+typedef enum RraExportColumnType
+{
+    kRraExportColumnTypeUint32  = 0,  ///< Unsigned 32-bit integer.
+    kRraExportColumnTypeUint64  = 1,  ///< Unsigned 64-bit integer.
+    kRraExportColumnTypeFloat32 = 2,  ///< 32-bit IEEE float.
+} RraExportColumnType;
+
+/// @brief The header at the start of every column file.
+typedef struct RraExportColumnHeader
+{
+    uint64_t magic;       ///< Always kRraExportColumnMagic.
+    uint32_t version;     ///< The format version, kRraExportColumnVersion.
+    uint32_t type;        ///< The value type, one of RraExportColumnType.
+    uint32_t components;  ///< The number of values per row (12 for a 3x4 transform, otherwise 1).
+    uint32_t reserved;    ///< Reserved, always 0.
+    uint64_t row_count;   ///< The number of rows in the column.
+} RraExportColumnHeader;
+
+/// @brief Export the statistics for the loaded trace as column files.
+///
+/// Writes the tlas, blas, instance and triangle tables into an existing directory.
+/// The data is streamed to disk in fixed size blocks per column, so memory use only
+/// grows with the number of instances in the largest TLAS, which are read in one go.
+///
+/// @param [in] directory_path The directory to write the files to. The directory must exist.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraExportStatistics(const char* directory_path);
+
+/// @brief Same as RraExportStatistics(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraExportStatistics().
+RraErrorCode RraContextExportStatistics(RraContext* context, const char* directory_path);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+#endif  // RRA_BACKEND_PUBLIC_RRA_EXPORT_H_
@@ -0,0 +1,85 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the instance overlap interface.
+///
+/// Finds the instances of a TLAS whose world space bounding boxes overlap.
+/// A ray passing through an overlapping region has to traverse every BLAS
+/// there, so heavily overlapping instances are a common cause of slow TLAS
+/// traversal.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_INSTANCE_OVERLAP_H_
+#define RRA_BACKEND_PUBLIC_RRA_INSTANCE_OVERLAP_H_
+
+#include <stdint.h>
+
+#include "rra_bvh.h"
+#include "rra_context.h"
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+enum
+{
+    kRraInstanceOverlapMaxClusterCount = 16  ///< The maximum number of clusters returned in RraInstanceOverlapStats.
+};
+
+/// @brief A region of the scene where many instance bounding boxes overlap.
+typedef struct RraInstanceOverlapCluster
+{
+    struct BoundingVolumeExtents bounds;          ///< The world space bounds of the region.
+    uint32_t                     instance_count;  ///< The number of instance bounding boxes touching the region.
+} RraInstanceOverlapCluster;
+
+/// @brief The instance overlap summary for a TLAS.
+typedef struct RraInstanceOverlapStats
+{
+    uint64_t                  instance_count;                                ///< The number of instances tested.
+    uint64_t                  overlapping_instance_count;                    ///< The number of instances overlapping at least one other instance.
+    uint64_t                  overlapping_pair_count;                        ///< The number of overlapping pairs of instances.
+    float                     mean_overlap_count;                            ///< The mean number of other instances each instance overlaps.
+    uint32_t                  max_overlap_count;                             ///< The highest number of other instances a single instance overlaps.
+    uint32_t                  max_overlap_depth;                             ///< The highest number of instances sharing a single grid cell.
+    uint32_t                  grid_dimensions[3];                            ///< The number of grid cells used along each axis.
+    uint32_t                  cluster_count;                                 ///< The number of valid entries in clusters.
+    RraInstanceOverlapCluster clusters[kRraInstanceOverlapMaxClusterCount];  ///< The densest regions of the scene, densest first.
+    double                    time_ms;                                       ///< The time taken to find the overlaps, in milliseconds.
+} RraInstanceOverlapStats;
+
+/// @brief Find the overlapping instances in a TLAS.
+///
+/// Each instance is bounded by the root bounding box of its BLAS, transformed to world space. Instances with an
+/// instance mask of 0 can never be hit, so they are ignored. The per-instance arrays are in instance table order, as
+/// returned by RraTlasGetInstanceTable(), and must hold RraTlasGetInstanceTableRowCount() entries.
+///
+/// @param [in]  tlas_index         The index of the TLAS.
+/// @param [in]  thread_count       The number of threads to use, or 0 for one per core.
+/// @param [out] out_overlap_counts The number of other instances each instance overlaps. May be NULL.
+/// @param [out] out_overlap_depths The highest number of instances sharing a grid cell with each instance, including itself. May be NULL.
+/// @param [out] out_stats          A pointer to receive the summary.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraInstanceOverlapCalculate(uint64_t                 tlas_index,
+                                         uint32_t                 thread_count,
+                                         uint32_t*                out_overlap_counts,
+                                         uint32_t*                out_overlap_depths,
+                                         RraInstanceOverlapStats* out_stats);
+
+/// @brief Same as RraInstanceOverlapCalculate(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraInstanceOverlapCalculate().
+RraErrorCode RraContextInstanceOverlapCalculate(RraContext*              context,
+                                                uint64_t                 tlas_index,
+                                                uint32_t                 thread_count,
+                                                uint32_t*                out_overlap_counts,
+                                                uint32_t*                out_overlap_depths,
+                                                RraInstanceOverlapStats* out_stats);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+#endif  // RRA_BACKEND_PUBLIC_RRA_INSTANCE_OVERLAP_H_
@@ -0,0 +1,114 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the job system interface.
+///
+/// The backend runs its parallel work, such as the analysis passes, the
+/// instance tables and the ray cost estimates, as jobs on a single shared pool
+/// of threads. Threads that wait for jobs run queued jobs while they wait, and
+/// idle threads steal jobs from busy ones. The functions that take a thread
+/// count use it as a limit on how many jobs of theirs run at once.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_JOB_SYSTEM_H_
+#define RRA_BACKEND_PUBLIC_RRA_JOB_SYSTEM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief The job system counters.
+typedef struct RraJobSystemStats
+{
+    uint32_t thread_count;      ///< The number of threads that run jobs, including a thread waiting for jobs.
+    uint64_t jobs_submitted;    ///< The number of jobs submitted since the counters were reset.
+    uint64_t jobs_executed;     ///< The number of jobs run since the counters were reset.
+    uint64_t jobs_cancelled;    ///< The number of jobs skipped because their work was cancelled.
+    uint64_t steal_count;       ///< The number of jobs a thread took from another thread's queue.
+    uint64_t max_queue_depth;   ///< The most jobs seen waiting in a single queue.
+    uint64_t queued_job_count;  ///< The number of jobs waiting to run now.
+} RraJobSystemStats;
+
+/// @brief Set the number of threads the job system uses.
+///
+/// No backend work may be running when this is called.
+///
+/// @param [in] thread_count The number of threads, or 0 for one per core.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraJobSystemSetThreadCount(uint32_t thread_count);
+
+/// @brief Get the number of threads the job system uses.
+///
+/// @return The number of threads that run jobs, including a thread waiting for jobs.
+uint32_t RraJobSystemGetThreadCount();
+
+/// @brief Get the job system counters.
+///
+/// @param [out] out_stats A pointer to receive the counters.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraJobSystemGetStats(RraJobSystemStats* out_stats);
+
+/// @brief Reset the job system counters to zero.
+void RraJobSystemResetStats();
+
+/// @brief A set of jobs that can be waited on together.
+typedef struct RraJobGroup RraJobGroup;
+
+/// @brief A job.
+///
+/// @param [in] user_data The pointer passed to RraJobGroupSubmit().
+typedef void (*RraJobFunction)(void* user_data);
+
+/// @brief Create a job group.
+///
+/// @param [out] out_group A pointer to receive the group.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraJobGroupCreate(RraJobGroup** out_group);
+
+/// @brief Wait for the jobs in a group to finish, then destroy it.
+///
+/// @param [in] group The group.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraJobGroupDestroy(RraJobGroup* group);
+
+/// @brief Run a job on the job system.
+///
+/// The job runs with the context bound to the calling thread. Jobs can submit more jobs, and wait for them.
+///
+/// @param [in] group     The group to add the job to.
+/// @param [in] function  The job.
+/// @param [in] user_data A pointer passed to the job.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraJobGroupSubmit(RraJobGroup* group, RraJobFunction function, void* user_data);
+
+/// @brief Check whether every job in a group has finished, without waiting.
+///
+/// @param [in]  group        The group.
+/// @param [out] out_finished A pointer to receive true if every job has finished, false if not.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraJobGroupIsFinished(const RraJobGroup* group, bool* out_finished);
+
+/// @brief Wait for every job in a group to finish, running queued jobs in the meantime.
+///
+/// @param [in] group The group.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraJobGroupWait(RraJobGroup* group);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+
+#endif  // RRA_BACKEND_PUBLIC_RRA_JOB_SYSTEM_H_
@@ -0,0 +1,230 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the ray cost estimator interface.
+///
+/// Casts a set of rays against a TLAS or BLAS on the CPU and counts the box
+/// nodes visited and triangles tested by each ray. This measures the
+/// traversal cost of a ray distribution directly, where the SAH is only a
+/// geometric estimate of it.
+///
+/// Rays are generated from a seed, and each ray depends only on the seed and
+/// its index. The results are the same for a given seed no matter how many
+/// threads are used, so they can be compared between captures.
+///
+/// The same traversals can also be replayed through a cache model, to see
+/// how well the node layout of a capture suits the GPU's caches.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_RAY_COST_H_
+#define RRA_BACKEND_PUBLIC_RRA_RAY_COST_H_
+
+#include <stdint.h>
+
+#include "rra_context.h"
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief The ways of generating the rays to cast.
+typedef enum RraRayDistribution
+{
+    kRraRayDistributionUniformSphere = 0,  ///< Lines between random pairs of points on the bounding sphere of the acceleration structure.
+    kRraRayDistributionCameraFrustum = 1,  ///< Rays from a camera through random points in its view frustum.
+    kRraRayDistributionFile          = 2,  ///< Rays read from a text file.
+} RraRayDistribution;
+
+/// @brief The percentiles reported for the per-ray counts.
+typedef enum RraRayCostPercentile
+{
+    kRraRayCostPercentile50  = 0,  ///< The median.
+    kRraRayCostPercentile90  = 1,  ///< The 90th percentile.
+    kRraRayCostPercentile99  = 2,  ///< The 99th percentile.
+    kRraRayCostPercentileMax = 3,  ///< The maximum.
+
+    kRraRayCostPercentileCount
+} RraRayCostPercentile;
+
+/// @brief The settings for a ray cost estimate.
+///
+/// Call RraRayCostGetDefaultConfig() to fill in the defaults before changing any fields.
+typedef struct RraRayCostConfig
+{
+    RraRayDistribution distribution;         ///< How the rays are generated.
+    uint32_t           ray_count;            ///< The number of rays to generate. Not used for rays read from a file.
+    uint64_t           seed;                 ///< The seed for the random ray generator.
+    uint32_t           thread_count;         ///< The number of threads to use, or 0 for one per core.
+    uint32_t           instance_mask;        ///< The ray's instance inclusion mask. Only used for a TLAS.
+    float              camera_position[3];   ///< The camera position, for the camera frustum distribution.
+    float              camera_direction[3];  ///< The direction the camera is looking in. If zero, the camera looks along -Z at the acceleration structure from outside its bounding sphere.
+    float              camera_up[3];         ///< The camera's up vector.
+    float              camera_fov;           ///< The vertical field of view of the camera, in degrees.
+    float              camera_aspect_ratio;  ///< The width of the view divided by its height.
+    const char*        ray_file_name;        ///< The file to read rays from, for the file distribution.
+} RraRayCostConfig;
+
+/// @brief The totals from a ray cost estimate.
+typedef struct RraRayCostStats
+{
+    uint64_t ray_count;                                              ///< The number of rays cast.
+    uint64_t hit_count;                                              ///< The number of rays that hit a triangle.
+    uint64_t node_visits;                                            ///< The total number of nodes visited by all rays.
+    uint64_t box_node_visits;                                        ///< The total number of box nodes visited by all rays.
+    uint64_t triangle_tests;                                         ///< The total number of ray/triangle tests.
+    uint64_t instance_visits;                                        ///< The total number of instance nodes visited. Zero for a BLAS.
+    float    mean_node_visits;                                       ///< The mean number of nodes visited per ray.
+    float    mean_triangle_tests;                                    ///< The mean number of triangle tests per ray.
+    uint32_t node_visit_percentiles[kRraRayCostPercentileCount];     ///< The per-ray node visit counts at each percentile.
+    uint32_t triangle_test_percentiles[kRraRayCostPercentileCount];  ///< The per-ray triangle test counts at each percentile.
+} RraRayCostStats;
+
+/// @brief The traversal cost within a single instance or BLAS, summed over all rays.
+typedef struct RraRayCostCounters
+{
+    uint64_t ray_count;        ///< The number of rays that entered the instance or BLAS.
+    uint64_t node_visits;      ///< The number of nodes visited inside it.
+    uint64_t box_node_visits;  ///< The number of box nodes visited inside it.
+    uint64_t triangle_tests;   ///< The number of ray/triangle tests inside it.
+} RraRayCostCounters;
+
+/// @brief The settings for the cache model used by the cache simulation.
+///
+/// Call RraRayCostGetDefaultCacheConfig() to fill in the defaults before changing any fields.
+typedef struct RraRayCostCacheConfig
+{
+    uint32_t line_size;       ///< The size of a cache line, in bytes. Must be a power of 2.
+    uint32_t associativity;   ///< The number of lines in each set. Lines within a set are replaced least recently used first.
+    uint32_t capacity;        ///< The size of the cache, in bytes. Must be a multiple of line_size * associativity.
+    uint32_t page_size;       ///< The size of a DRAM page, in bytes. Must be a power of 2 no smaller than line_size.
+    uint32_t ray_group_size;  ///< The number of consecutive rays sharing the cache. The cache starts empty for each group.
+} RraRayCostCacheConfig;
+
+/// @brief The totals from a cache simulation.
+typedef struct RraRayCostCacheStats
+{
+    uint64_t ray_count;                                            ///< The number of rays cast.
+    uint64_t line_reads;                                           ///< The number of cache line reads made by all rays.
+    uint64_t hits;                                                 ///< The number of cache line reads that hit.
+    uint64_t misses;                                               ///< The number of cache line reads that missed.
+    uint64_t unique_lines;                                         ///< The number of distinct lines read by each ray, summed over all rays.
+    uint64_t unique_pages;                                         ///< The number of distinct DRAM pages read by each ray, summed over all rays.
+    float    hit_rate;                                             ///< The fraction of cache line reads that hit.
+    float    mean_unique_lines;                                    ///< The mean number of distinct lines read per ray.
+    float    mean_unique_pages;                                    ///< The mean number of distinct DRAM pages read per ray.
+    float    mean_miss_bytes;                                      ///< The mean number of bytes fetched from memory per ray.
+    uint32_t unique_line_percentiles[kRraRayCostPercentileCount];  ///< The per-ray distinct line counts at each percentile.
+} RraRayCostCacheStats;
+
+/// @brief Fill in the default ray cost settings.
+///
+/// The default is 1M rays from the uniform sphere distribution with seed 0, using all cores.
+///
+/// @param [out] out_config The settings to fill in.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraRayCostGetDefaultConfig(RraRayCostConfig* out_config);
+
+/// @brief Fill in the default cache model settings.
+///
+/// The default is a 16KB, 4-way cache with 128 byte lines and 4KB pages, shared by groups of 64 rays.
+///
+/// @param [out] out_config The settings to fill in.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraRayCostGetDefaultCacheConfig(RraRayCostCacheConfig* out_config);
+
+/// @brief Estimate the traversal cost of a ray distribution against a BLAS.
+///
+/// Procedural nodes are counted as visited but never hit, since their intersection shaders can't be run.
+///
+/// @param [in]  blas_index The index of the BLAS to cast the rays against.
+/// @param [in]  config     The ray cost settings.
+/// @param [out] out_stats  A pointer to receive the totals.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraRayCostEstimateBlas(uint64_t blas_index, const RraRayCostConfig* config, RraRayCostStats* out_stats);
+
+/// @brief Same as RraRayCostEstimateBlas(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraRayCostEstimateBlas().
+RraErrorCode RraContextRayCostEstimateBlas(RraContext* context, uint64_t blas_index, const RraRayCostConfig* config, RraRayCostStats* out_stats);
+
+/// @brief Estimate the traversal cost of a ray distribution against a TLAS.
+///
+/// @param [in]  tlas_index            The index of the TLAS to cast the rays against.
+/// @param [in]  config                The ray cost settings.
+/// @param [out] out_stats             A pointer to receive the totals.
+/// @param [out] out_instance_counters An array to receive the cost within each instance, indexed by instance node.
+///                                    It must hold RraTlasGetInstanceNodeCount() entries. May be NULL.
+/// @param [out] out_blas_counters     An array to receive the cost within each BLAS, summed over its instances.
+///                                    It must hold RraBvhGetTotalBlasCount() entries. May be NULL.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraRayCostEstimateTlas(uint64_t                tlas_index,
+                                    const RraRayCostConfig* config,
+                                    RraRayCostStats*        out_stats,
+                                    RraRayCostCounters*     out_instance_counters,
+                                    RraRayCostCounters*     out_blas_counters);
+
+/// @brief Same as RraRayCostEstimateTlas(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraRayCostEstimateTlas().
+RraErrorCode RraContextRayCostEstimateTlas(RraContext*             context,
+                                           uint64_t                tlas_index,
+                                           const RraRayCostConfig* config,
+                                           RraRayCostStats*        out_stats,
+                                           RraRayCostCounters*     out_instance_counters,
+                                           RraRayCostCounters*     out_blas_counters);
+
+/// @brief Replay the traversal of a ray distribution against a BLAS through a cache model.
+///
+/// Each node visited reads the cache lines covering the node's bytes, at the node's offset in the acceleration
+/// structure. The rays are split into groups of consecutive rays, and the rays in a group are traced one after
+/// another through a cache that starts empty, so the results are the same no matter how many threads are used.
+///
+/// @param [in]  blas_index   The index of the BLAS to cast the rays against.
+/// @param [in]  config       The ray cost settings.
+/// @param [in]  cache_config The cache model settings.
+/// @param [out] out_stats    A pointer to receive the totals.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraRayCostSimulateCacheBlas(uint64_t blas_index, const RraRayCostConfig* config, const RraRayCostCacheConfig* cache_config, RraRayCostCacheStats* out_stats);
+
+/// @brief Same as RraRayCostSimulateCacheBlas(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraRayCostSimulateCacheBlas().
+RraErrorCode RraContextRayCostSimulateCacheBlas(RraContext*                  context,
+                                                uint64_t                     blas_index,
+                                                const RraRayCostConfig*      config,
+                                                const RraRayCostCacheConfig* cache_config,
+                                                RraRayCostCacheStats*        out_stats);
+
+/// @brief Replay the traversal of a ray distribution against a TLAS through a cache model.
+///
+/// Each BLAS is placed in its own address range, so BLAS nodes never share cache lines or pages with the TLAS
+/// or with other BLASes.
+///
+/// @param [in]  tlas_index   The index of the TLAS to cast the rays against.
+/// @param [in]  config       The ray cost settings.
+/// @param [in]  cache_config The cache model settings.
+/// @param [out] out_stats    A pointer to receive the totals.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraRayCostSimulateCacheTlas(uint64_t tlas_index, const RraRayCostConfig* config, const RraRayCostCacheConfig* cache_config, RraRayCostCacheStats* out_stats);
+
+/// @brief Same as RraRayCostSimulateCacheTlas(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraRayCostSimulateCacheTlas().
+RraErrorCode RraContextRayCostSimulateCacheTlas(RraContext*                  context,
+                                                uint64_t                     tlas_index,
+                                                const RraRayCostConfig*      config,
+                                                const RraRayCostCacheConfig* cache_config,
+                                                RraRayCostCacheStats*        out_stats);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+#endif  // RRA_BACKEND_PUBLIC_RRA_RAY_COST_H_
@@ -0,0 +1,77 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the reference BVH interface.
+///
+/// Rebuilds the triangles of a BLAS into a reference tree using a binned
+/// surface area heuristic builder, and compares the quality of the captured
+/// tree against it. This gives an idea of how far the driver's build is from
+/// a good offline build of the same geometry.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_REFERENCE_BVH_H_
+#define RRA_BACKEND_PUBLIC_RRA_REFERENCE_BVH_H_
+
+#include <stdint.h>
+
+#include "rra_context.h"
+#include "rra_error.h"
+#include "rra_ray_cost.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief The quality metrics for a single tree.
+typedef struct RraReferenceBvhTreeStats
+{
+    float           sah_cost;              ///< The expected number of box node visits plus triangle tests for a ray that hits the root bounding box.
+    float           average_sah;           ///< The mean SAH of all the nodes, as shown for the root node in the BLAS view.
+    float           average_triangle_sah;  ///< The mean SAH of the triangle nodes.
+    uint64_t        box_node_count;        ///< The number of box nodes.
+    uint64_t        leaf_node_count;       ///< The number of leaf nodes.
+    uint32_t        max_depth;             ///< The depth of the deepest leaf.
+    RraRayCostStats ray_cost;              ///< The ray cost estimate. Zero if no ray cost settings were given.
+} RraReferenceBvhTreeStats;
+
+/// @brief The comparison between a captured BLAS and its reference tree.
+///
+/// The ratios are the captured value divided by the reference value, so a ratio above 1 means the captured tree is worse.
+typedef struct RraReferenceBvhStats
+{
+    uint64_t                 triangle_count;              ///< The number of triangles in the BLAS.
+    RraReferenceBvhTreeStats captured;                    ///< The metrics for the captured tree.
+    RraReferenceBvhTreeStats reference;                   ///< The metrics for the reference tree.
+    float                    sah_cost_ratio;              ///< The ratio of the SAH costs.
+    float                    node_visit_ratio;            ///< The ratio of the mean node visits per ray. Zero if no rays were cast.
+    float                    triangle_test_ratio;         ///< The ratio of the mean triangle tests per ray. Zero if no rays were cast.
+    double                   build_time_ms;               ///< The time taken to build the reference tree, in milliseconds.
+    double                   build_triangles_per_second;  ///< The build throughput.
+} RraReferenceBvhStats;
+
+/// @brief Build a reference tree for a BLAS and compare the captured tree with it.
+///
+/// Only the triangles are rebuilt, so procedural nodes are ignored in the reference tree.
+///
+/// @param [in]  blas_index      The index of the BLAS to compare.
+/// @param [in]  thread_count    The number of threads to build with, or 0 for one per core.
+/// @param [in]  ray_cost_config The ray cost settings. The same rays are cast against both trees. May be NULL to skip the ray cost estimate.
+/// @param [out] out_stats       A pointer to receive the comparison.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraReferenceBvhCompareBlas(uint64_t blas_index, uint32_t thread_count, const RraRayCostConfig* ray_cost_config, RraReferenceBvhStats* out_stats);
+
+/// @brief Same as RraReferenceBvhCompareBlas(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraReferenceBvhCompareBlas().
+RraErrorCode RraContextReferenceBvhCompareBlas(RraContext*             context,
+                                               uint64_t                blas_index,
+                                               uint32_t                thread_count,
+                                               const RraRayCostConfig* ray_cost_config,
+                                               RraReferenceBvhStats*   out_stats);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+#endif  // RRA_BACKEND_PUBLIC_RRA_REFERENCE_BVH_H_
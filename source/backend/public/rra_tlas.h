@@ -13,6 +13,7 @@
 #include <stdbool.h>
 
 #include "rra_bvh.h"
+#include "rra_context.h"
 #include "rra_error.h"
 
 #include "vulkan/include/vulkan/vulkan_core.h"
@@ -21,6 +22,37 @@
 extern "C" {
 #endif  // #ifdef __cplusplus
 
+/// @brief Structure describing a caller-allocated, column-oriented table of TLAS instance data.
+///
+/// Each column is an array with one element per row, apart from the transform columns which need
+/// 12 floats per row. Columns that aren't needed can be set to NULL and will be skipped.
+///
+/// Rows are ordered by BLAS index, then by the order of the instances of each BLAS, so the rows
+/// for a BLAS match the instance indices accepted by RraTlasGetInstanceNode(). Inactive instances
+/// don't reference a BLAS, so they have no row. RraTlasGetInactiveInstancesCount() gives their count.
+///
+/// A row whose instance node can't be read doesn't stop the rest of the table being filled in. Its
+/// row_valid entry is 0, and every column apart from node_ptr, blas_index and blas_instance_index is
+/// zeroed. The number of these rows is written to invalid_row_count.
+struct RraTlasInstanceTable
+{
+    uint32_t*                     node_ptr;             ///< The instance node pointer.
+    uint64_t*                     blas_index;           ///< The index of the BLAS referenced by the instance.
+    uint64_t*                     blas_instance_index;  ///< The index of the instance in the instance list of its BLAS.
+    uint32_t*                     instance_index;       ///< The index of the instance node in the TLAS.
+    uint64_t*                     instance_address;     ///< The virtual address of the instance node.
+    uint64_t*                     instance_offset;      ///< The offset of the instance node in the TLAS.
+    float*                        transform;            ///< The instance transform as encoded (inverse). 12 floats per row.
+    float*                        original_transform;   ///< The original (not inverse) instance transform. 12 floats per row.
+    uint32_t*                     mask;                 ///< The instance mask as specified through the API.
+    uint32_t*                     instance_id;          ///< The instance ID as specified through the API.
+    uint32_t*                     hit_group;            ///< The instance hit group as specified through the API.
+    uint32_t*                     flags;                ///< The instance flags.
+    struct BoundingVolumeExtents* bounding_volume;      ///< The bounding volume extents of the instance node.
+    uint32_t*                     row_valid;            ///< 1 if the instance node was read, 0 if it couldn't be.
+    uint64_t*                     invalid_row_count;    ///< Receives the number of rows that couldn't be read. A single value rather than a column.
+};
+
 /// @brief Get the base address for the tlas_index given.
 ///
 /// @param [in]  tlas_index  The index of the TLAS to use.
@@ -29,6 +61,11 @@ extern "C" {
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBaseAddress(uint64_t tlas_index, uint64_t* out_address);
 
+/// @brief Same as RraTlasGetBaseAddress(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBaseAddress().
+RraErrorCode RraContextTlasGetBaseAddress(RraContext* context, uint64_t tlas_index, uint64_t* out_address);
+
 /// @brief Is the TLAS empty.
 ///
 /// @param [in]  tlas_index  The index of the TLAS to use.
@@ -36,6 +73,11 @@ RraErrorCode RraTlasGetBaseAddress(uint64_t tlas_index, uint64_t* out_address);
 /// @return true if empty, false if not.
 bool RraTlasIsEmpty(uint64_t tlas_index);
 
+/// @brief Same as RraTlasIsEmpty(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasIsEmpty().
+bool RraContextTlasIsEmpty(RraContext* context, uint64_t tlas_index);
+
 /// @brief Get the total number of nodes for the tlas_index given.
 ///
 /// The total number of nodes is the sum of the internal nodes and leaf nodes.
@@ -46,6 +88,11 @@ bool RraTlasIsEmpty(uint64_t tlas_index);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetTotalNodeCount(uint64_t tlas_index, uint64_t* out_node_count);
 
+/// @brief Same as RraTlasGetTotalNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetTotalNodeCount().
+RraErrorCode RraContextTlasGetTotalNodeCount(RraContext* context, uint64_t tlas_index, uint64_t* out_node_count);
+
 /// @brief Get the child node count for a given node.
 ///
 /// @param [in]  tlas_index         The index of the TLAS to use.
@@ -55,6 +102,11 @@ RraErrorCode RraTlasGetTotalNodeCount(uint64_t tlas_index, uint64_t* out_node_co
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetChildNodeCount(uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_count);
 
+/// @brief Same as RraTlasGetChildNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetChildNodeCount().
+RraErrorCode RraContextTlasGetChildNodeCount(RraContext* context, uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_count);
+
 /// @brief Get the child nodes for a given node.
 ///
 /// @param [in]  tlas_index         The index of the TLAS to use.
@@ -64,6 +116,11 @@ RraErrorCode RraTlasGetChildNodeCount(uint64_t tlas_index, uint32_t parent_node,
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetChildNodes(uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_nodes);
 
+/// @brief Same as RraTlasGetChildNodes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetChildNodes().
+RraErrorCode RraContextTlasGetChildNodes(RraContext* context, uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_nodes);
+
 /// @brief Get the child node pointer for a given node.
 ///
 /// @param [in]  tlas_index     The index of the TLAS to use.
@@ -77,6 +134,11 @@ RraErrorCode RraTlasGetChildNodes(uint64_t tlas_index, uint32_t parent_node, uin
 ///         kRraErrorIndexOutOfRange if the child node index is out of range.
 RraErrorCode RraTlasGetChildNodePtr(uint64_t tlas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr);
 
+/// @brief Same as RraTlasGetChildNodePtr(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetChildNodePtr().
+RraErrorCode RraContextTlasGetChildNodePtr(RraContext* context, uint64_t tlas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr);
+
 /// @brief Get the base address for a given node.
 ///
 /// @param [in]  tlas_index     The index of the TLAS to use.
@@ -86,6 +148,11 @@ RraErrorCode RraTlasGetChildNodePtr(uint64_t tlas_index, uint32_t parent_node, u
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetNodeBaseAddress(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address);
 
+/// @brief Same as RraTlasGetNodeBaseAddress(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetNodeBaseAddress().
+RraErrorCode RraContextTlasGetNodeBaseAddress(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address);
+
 /// @brief Get the base address for a given node's parent.
 ///
 /// @param [in]  tlas_index     The index of the TLAS to use.
@@ -95,6 +162,26 @@ RraErrorCode RraTlasGetNodeBaseAddress(uint64_t tlas_index, uint32_t node_ptr, u
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetNodeParentBaseAddress(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address);
 
+/// @brief Same as RraTlasGetNodeParentBaseAddress(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetNodeParentBaseAddress().
+RraErrorCode RraContextTlasGetNodeParentBaseAddress(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address);
+
+/// @brief Get the parent node pointer for a given node.
+///
+/// @param [in]  tlas_index          The index of the TLAS to use.
+/// @param [in]  node_ptr            The node whose parent is to be found.
+/// @param [out] out_parent_node_ptr A pointer to receive the parent node pointer.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred. kRraErrorInvalidPointer
+///         is returned for the root node, since it has no parent.
+RraErrorCode RraTlasGetNodeParent(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr);
+
+/// @brief Same as RraTlasGetNodeParent(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetNodeParent().
+RraErrorCode RraContextTlasGetNodeParent(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr);
+
 /// @brief Get the instance information for an instance node.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -106,6 +193,16 @@ RraErrorCode RraTlasGetNodeParentBaseAddress(uint64_t tlas_index, uint32_t node_
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceNodeInfo(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_address, uint64_t* out_instance_count, bool* out_is_empty);
 
+/// @brief Same as RraTlasGetInstanceNodeInfo(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceNodeInfo().
+RraErrorCode RraContextTlasGetInstanceNodeInfo(RraContext* context,
+                                               uint64_t    tlas_index,
+                                               uint32_t    node_ptr,
+                                               uint64_t*   out_blas_address,
+                                               uint64_t*   out_instance_count,
+                                               bool*       out_is_empty);
+
 /// @brief Get the instance count for a given BLAS in a TLAS.
 ///
 /// @param [in]  tlas_index          The index of the TLAS where the BLAS instance is.
@@ -115,6 +212,11 @@ RraErrorCode RraTlasGetInstanceNodeInfo(uint64_t tlas_index, uint32_t node_ptr,
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceCount(uint64_t tlas_index, uint64_t blas_index, uint64_t* out_instance_count);
 
+/// @brief Same as RraTlasGetInstanceCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceCount().
+RraErrorCode RraContextTlasGetInstanceCount(RraContext* context, uint64_t tlas_index, uint64_t blas_index, uint64_t* out_instance_count);
+
 /// @brief Get the total number of box nodes for the tlas_index given.
 ///
 /// The total number of box nodes is the number of internal nodes.
@@ -125,6 +227,11 @@ RraErrorCode RraTlasGetInstanceCount(uint64_t tlas_index, uint64_t blas_index, u
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBoxNodeCount(uint64_t tlas_index, uint64_t* out_node_count);
 
+/// @brief Same as RraTlasGetBoxNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBoxNodeCount().
+RraErrorCode RraContextTlasGetBoxNodeCount(RraContext* context, uint64_t tlas_index, uint64_t* out_node_count);
+
 /// @brief Get the number of box-16 nodes for the tlas_index given.
 ///
 /// @param [in]  tlas_index     The index of the TLAS to use.
@@ -133,6 +240,11 @@ RraErrorCode RraTlasGetBoxNodeCount(uint64_t tlas_index, uint64_t* out_node_coun
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBox16NodeCount(uint64_t tlas_index, uint32_t* out_node_count);
 
+/// @brief Same as RraTlasGetBox16NodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBox16NodeCount().
+RraErrorCode RraContextTlasGetBox16NodeCount(RraContext* context, uint64_t tlas_index, uint32_t* out_node_count);
+
 /// @brief Get the number of box-32 nodes for the tlas_index given.
 ///
 /// @param [in]  tlas_index     The index of the TLAS to use.
@@ -141,6 +253,11 @@ RraErrorCode RraTlasGetBox16NodeCount(uint64_t tlas_index, uint32_t* out_node_co
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBox32NodeCount(uint64_t tlas_index, uint32_t* out_node_count);
 
+/// @brief Same as RraTlasGetBox32NodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBox32NodeCount().
+RraErrorCode RraContextTlasGetBox32NodeCount(RraContext* context, uint64_t tlas_index, uint32_t* out_node_count);
+
 /// @brief Get the number of half box-32 nodes for the tlas_index given.
 ///
 /// @param [in]  tlas_index     The index of the TLAS to use.
@@ -149,6 +266,11 @@ RraErrorCode RraTlasGetBox32NodeCount(uint64_t tlas_index, uint32_t* out_node_co
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetHalfBox32NodeCount(uint64_t tlas_index, uint32_t* out_node_count);
 
+/// @brief Same as RraTlasGetHalfBox32NodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetHalfBox32NodeCount().
+RraErrorCode RraContextTlasGetHalfBox32NodeCount(RraContext* context, uint64_t tlas_index, uint32_t* out_node_count);
+
 /// @brief Get the instance node count for a TLAS.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -157,6 +279,11 @@ RraErrorCode RraTlasGetHalfBox32NodeCount(uint64_t tlas_index, uint32_t* out_nod
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceNodeCount(uint64_t tlas_index, uint64_t* out_instance_count);
 
+/// @brief Same as RraTlasGetInstanceNodeCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceNodeCount().
+RraErrorCode RraContextTlasGetInstanceNodeCount(RraContext* context, uint64_t tlas_index, uint64_t* out_instance_count);
+
 /// @brief Get the number of unique BLASes in a TLAS.
 ///
 /// @param [in]  tlas_index      The index of the TLAS whose BLAS count is needed.
@@ -165,6 +292,11 @@ RraErrorCode RraTlasGetInstanceNodeCount(uint64_t tlas_index, uint64_t* out_inst
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBlasCount(uint64_t tlas_index, uint64_t* out_blas_count);
 
+/// @brief Same as RraTlasGetBlasCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBlasCount().
+RraErrorCode RraContextTlasGetBlasCount(RraContext* context, uint64_t tlas_index, uint64_t* out_blas_count);
+
 /// @brief Get the instance node for an instance of a BLAS.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -175,6 +307,67 @@ RraErrorCode RraTlasGetBlasCount(uint64_t tlas_index, uint64_t* out_blas_count);
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceNode(uint64_t tlas_index, uint64_t blas_index, uint64_t instance_index, uint32_t* out_node_ptr);
 
+/// @brief Same as RraTlasGetInstanceNode(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceNode().
+RraErrorCode RraContextTlasGetInstanceNode(RraContext* context, uint64_t tlas_index, uint64_t blas_index, uint64_t instance_index, uint32_t* out_node_ptr);
+
+/// @brief Get the number of rows needed for the instance table of a TLAS.
+///
+/// This is the number of instances in the TLAS, summed over all referenced BLASes.
+///
+/// @param [in]  tlas_index     The index of the TLAS to use.
+/// @param [out] out_row_count  A pointer to receive the row count.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraTlasGetInstanceTableRowCount(uint64_t tlas_index, uint64_t* out_row_count);
+
+/// @brief Same as RraTlasGetInstanceTableRowCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceTableRowCount().
+RraErrorCode RraContextTlasGetInstanceTableRowCount(RraContext* context, uint64_t tlas_index, uint64_t* out_row_count);
+
+/// @brief Fill in the instance table for all instances in a TLAS.
+///
+/// The TLAS is validated once and the table is filled in a single pass over the instance nodes,
+/// rather than making several calls per instance. The columns in out_table must have space for
+/// the number of rows returned by RraTlasGetInstanceTableRowCount().
+///
+/// @param [in]  tlas_index    The index of the TLAS to use.
+/// @param [in]  thread_count  The number of threads to split the rows over. 0 uses the number of hardware threads.
+/// @param [out] out_table     The table of caller-allocated columns to fill in.
+///
+/// @return kRraOk if successful or an RraErrorCode if the TLAS or table is invalid. Rows that can't be
+///         read are flagged in the table rather than failing the call.
+RraErrorCode RraTlasGetInstanceTable(uint64_t tlas_index, uint32_t thread_count, const struct RraTlasInstanceTable* out_table);
+
+/// @brief Same as RraTlasGetInstanceTable(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceTable().
+RraErrorCode RraContextTlasGetInstanceTable(RraContext* context, uint64_t tlas_index, uint32_t thread_count, const struct RraTlasInstanceTable* out_table);
+
+/// @brief Fill in the instance table for the instances of a single BLAS in a TLAS.
+///
+/// The columns in out_table must have space for the number of rows returned by RraTlasGetInstanceCount().
+///
+/// @param [in]  tlas_index    The index of the TLAS to use.
+/// @param [in]  blas_index    The index of the BLAS whose instances are needed.
+/// @param [in]  thread_count  The number of threads to split the rows over. 0 uses the number of hardware threads.
+/// @param [out] out_table     The table of caller-allocated columns to fill in.
+///
+/// @return kRraOk if successful or an RraErrorCode if the TLAS or table is invalid. Rows that can't be
+///         read are flagged in the table rather than failing the call.
+RraErrorCode RraTlasGetBlasInstanceTable(uint64_t tlas_index, uint64_t blas_index, uint32_t thread_count, const struct RraTlasInstanceTable* out_table);
+
+/// @brief Same as RraTlasGetBlasInstanceTable(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBlasInstanceTable().
+RraErrorCode RraContextTlasGetBlasInstanceTable(RraContext*                        context,
+                                                uint64_t                           tlas_index,
+                                                uint64_t                           blas_index,
+                                                uint32_t                           thread_count,
+                                                const struct RraTlasInstanceTable* out_table);
+
 /// @brief Get the instance transformation for an instance node.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -184,6 +377,11 @@ RraErrorCode RraTlasGetInstanceNode(uint64_t tlas_index, uint64_t blas_index, ui
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceNodeTransform(uint64_t tlas_index, uint32_t node_ptr, float* transform);
 
+/// @brief Same as RraTlasGetInstanceNodeTransform(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceNodeTransform().
+RraErrorCode RraContextTlasGetInstanceNodeTransform(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* transform);
+
 /// @brief Get the original (not inverse) instance transformation for an instance node.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -193,6 +391,11 @@ RraErrorCode RraTlasGetInstanceNodeTransform(uint64_t tlas_index, uint32_t node_
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetOriginalInstanceNodeTransform(uint64_t tlas_index, uint32_t node_ptr, float* transform);
 
+/// @brief Same as RraTlasGetOriginalInstanceNodeTransform(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetOriginalInstanceNodeTransform().
+RraErrorCode RraContextTlasGetOriginalInstanceNodeTransform(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* transform);
+
 /// @brief Get the BLAS index from a TLAS instance node.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -202,6 +405,11 @@ RraErrorCode RraTlasGetOriginalInstanceNodeTransform(uint64_t tlas_index, uint32
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBlasIndexFromInstanceNode(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_index);
 
+/// @brief Same as RraTlasGetBlasIndexFromInstanceNode(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBlasIndexFromInstanceNode().
+RraErrorCode RraContextTlasGetBlasIndexFromInstanceNode(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_index);
+
 /// @brief Get the Instance index, given a TLAS index and an instance node pointer.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -211,6 +419,11 @@ RraErrorCode RraTlasGetBlasIndexFromInstanceNode(uint64_t tlas_index, uint32_t n
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceIndexFromInstanceNode(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_instance_index);
 
+/// @brief Same as RraTlasGetInstanceIndexFromInstanceNode(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceIndexFromInstanceNode().
+RraErrorCode RraContextTlasGetInstanceIndexFromInstanceNode(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_instance_index);
+
 /// @brief Get the bounding volume extents of a given node.
 ///
 /// @param [in]  tlas_index          The index of the TLAS to use.
@@ -220,6 +433,11 @@ RraErrorCode RraTlasGetInstanceIndexFromInstanceNode(uint64_t tlas_index, uint32
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBoundingVolumeExtents(uint64_t tlas_index, uint32_t node_ptr, struct BoundingVolumeExtents* out_extents);
 
+/// @brief Same as RraTlasGetBoundingVolumeExtents(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBoundingVolumeExtents().
+RraErrorCode RraContextTlasGetBoundingVolumeExtents(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, struct BoundingVolumeExtents* out_extents);
+
 /// @brief Get the surface area heuristic of a given node.
 ///
 /// @param [in]  tlas_index                 The index of the TLAS to use.
@@ -229,6 +447,11 @@ RraErrorCode RraTlasGetBoundingVolumeExtents(uint64_t tlas_index, uint32_t node_
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_surface_area_heuristic);
 
+/// @brief Same as RraTlasGetSurfaceAreaHeuristic(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetSurfaceAreaHeuristic().
+RraErrorCode RraContextTlasGetSurfaceAreaHeuristic(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_surface_area_heuristic);
+
 /// @brief Get the minimum surface area heuristic of a given node and its children.
 ///
 /// @param [in]  tlas_index                     The index of the TLAS to use.
@@ -238,6 +461,11 @@ RraErrorCode RraTlasGetSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_p
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetMinimumSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_min_surface_area_heuristic);
 
+/// @brief Same as RraTlasGetMinimumSurfaceAreaHeuristic(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetMinimumSurfaceAreaHeuristic().
+RraErrorCode RraContextTlasGetMinimumSurfaceAreaHeuristic(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_min_surface_area_heuristic);
+
 /// @brief Get the average surface area heuristic of a given node and its children.
 ///
 /// @param [in]  tlas_index                     The index of the TLAS to use.
@@ -247,6 +475,41 @@ RraErrorCode RraTlasGetMinimumSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetAverageSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_avg_surface_area_heuristic);
 
+/// @brief Same as RraTlasGetAverageSurfaceAreaHeuristic(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetAverageSurfaceAreaHeuristic().
+RraErrorCode RraContextTlasGetAverageSurfaceAreaHeuristic(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_avg_surface_area_heuristic);
+
+/// @brief Get the sibling overlap of a given box node.
+///
+/// @param [in]  tlas_index         The index of the TLAS to use.
+/// @param [in]  node_ptr           The box node pointer whose overlap is to be found.
+/// @param [out] out_overlap_area   A pointer to receive the overlap surface area, relative to the node's surface area.
+/// @param [out] out_overlap_volume A pointer to receive the overlap volume, relative to the node's volume.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraTlasGetSiblingOverlap(uint64_t tlas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume);
+
+/// @brief Same as RraTlasGetSiblingOverlap(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetSiblingOverlap().
+RraErrorCode RraContextTlasGetSiblingOverlap(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume);
+
+/// @brief Get the node overlap summary of a TLAS.
+///
+/// The leaf tightness values are zero, since the TLAS has no triangle nodes.
+///
+/// @param [in]  tlas_index The index of the TLAS to use.
+/// @param [out] out_stats  A pointer to receive the overlap summary.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraTlasGetOverlapStats(uint64_t tlas_index, RraBvhOverlapStats* out_stats);
+
+/// @brief Same as RraTlasGetOverlapStats(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetOverlapStats().
+RraErrorCode RraContextTlasGetOverlapStats(RraContext* context, uint64_t tlas_index, RraBvhOverlapStats* out_stats);
+
 /// @brief Get the instance mask as specified through the API.
 ///
 /// @param tlas_index    The index of the TLAS to use.
@@ -256,6 +519,11 @@ RraErrorCode RraTlasGetAverageSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceNodeMask(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_mask);
 
+/// @brief Same as RraTlasGetInstanceNodeMask(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceNodeMask().
+RraErrorCode RraContextTlasGetInstanceNodeMask(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_mask);
+
 /// @brief Get the instance ID as specified through the API.
 ///
 /// @param tlas_index    The index of the TLAS to use.
@@ -265,6 +533,11 @@ RraErrorCode RraTlasGetInstanceNodeMask(uint64_t tlas_index, uint32_t node_ptr,
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceNodeID(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_id);
 
+/// @brief Same as RraTlasGetInstanceNodeID(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceNodeID().
+RraErrorCode RraContextTlasGetInstanceNodeID(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_id);
+
 /// @brief Get the instance hit group as specified through the API.
 ///
 /// @param tlas_index     The index of the TLAS to use.
@@ -274,6 +547,11 @@ RraErrorCode RraTlasGetInstanceNodeID(uint64_t tlas_index, uint32_t node_ptr, ui
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceNodeHitGroup(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_hit_group);
 
+/// @brief Same as RraTlasGetInstanceNodeHitGroup(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceNodeHitGroup().
+RraErrorCode RraContextTlasGetInstanceNodeHitGroup(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_hit_group);
+
 /// @brief Get the size of the TLAS, in bytes.
 ///
 /// @param [in] tlas_index         The index of the TLAS to use.
@@ -282,6 +560,11 @@ RraErrorCode RraTlasGetInstanceNodeHitGroup(uint64_t tlas_index, uint32_t node_p
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetSizeInBytes(uint64_t tlas_index, uint32_t* out_size_in_bytes);
 
+/// @brief Same as RraTlasGetSizeInBytes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetSizeInBytes().
+RraErrorCode RraContextTlasGetSizeInBytes(RraContext* context, uint64_t tlas_index, uint32_t* out_size_in_bytes);
+
 /// @brief Get the size of the TLAS and unique BLASes, in bytes.
 ///
 /// @param [in] tlas_index         The index of the TLAS to use.
@@ -290,6 +573,11 @@ RraErrorCode RraTlasGetSizeInBytes(uint64_t tlas_index, uint32_t* out_size_in_by
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetEffectiveSizeInBytes(uint64_t tlas_index, uint64_t* out_size_in_bytes);
 
+/// @brief Same as RraTlasGetEffectiveSizeInBytes(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetEffectiveSizeInBytes().
+RraErrorCode RraContextTlasGetEffectiveSizeInBytes(RraContext* context, uint64_t tlas_index, uint64_t* out_size_in_bytes);
+
 /// @brief Get the total number of triangles referenced by the instance nodes in this TLAS.
 ///
 /// @param [in] tlas_index       The index of the TLAS to use.
@@ -298,6 +586,11 @@ RraErrorCode RraTlasGetEffectiveSizeInBytes(uint64_t tlas_index, uint64_t* out_s
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetTotalTriangleCount(uint64_t tlas_index, uint64_t* triangle_count);
 
+/// @brief Same as RraTlasGetTotalTriangleCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetTotalTriangleCount().
+RraErrorCode RraContextTlasGetTotalTriangleCount(RraContext* context, uint64_t tlas_index, uint64_t* triangle_count);
+
 /// @brief Get the sum of all the triangles in each BLAS referenced by the TLAS.
 ///
 /// @param [in] tlas_index The index of the TLAS.
@@ -306,6 +599,11 @@ RraErrorCode RraTlasGetTotalTriangleCount(uint64_t tlas_index, uint64_t* triangl
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetUniqueTriangleCount(uint64_t tlas_index, uint64_t* out_count);
 
+/// @brief Same as RraTlasGetUniqueTriangleCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetUniqueTriangleCount().
+RraErrorCode RraContextTlasGetUniqueTriangleCount(RraContext* context, uint64_t tlas_index, uint64_t* out_count);
+
 /// @brief Get the number of inactive instances referenced by this TLAS.
 ///
 /// @param [in] tlas_index      The index of the TLAS.
@@ -314,6 +612,11 @@ RraErrorCode RraTlasGetUniqueTriangleCount(uint64_t tlas_index, uint64_t* out_co
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInactiveInstancesCount(uint64_t tlas_index, uint64_t* inactive_count);
 
+/// @brief Same as RraTlasGetInactiveInstancesCount(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInactiveInstancesCount().
+RraErrorCode RraContextTlasGetInactiveInstancesCount(RraContext* context, uint64_t tlas_index, uint64_t* inactive_count);
+
 /// @brief Retrieve the build flags used to build this TLAS.
 ///
 /// @param [in] tlas_index The index of the TLAS to use.
@@ -322,6 +625,11 @@ RraErrorCode RraTlasGetInactiveInstancesCount(uint64_t tlas_index, uint64_t* ina
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetBuildFlags(uint64_t tlas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags);
 
+/// @brief Same as RraTlasGetBuildFlags(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetBuildFlags().
+RraErrorCode RraContextTlasGetBuildFlags(RraContext* context, uint64_t tlas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags);
+
 /// @brief Retrieve the instance flags.
 ///
 /// @param [in] tlas_index	The index of the TLAS to use.
@@ -331,6 +639,11 @@ RraErrorCode RraTlasGetBuildFlags(uint64_t tlas_index, VkBuildAccelerationStruct
 /// @returns kRraOk if successful or an RraErrorCode if an error occurred.
 RraErrorCode RraTlasGetInstanceFlags(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_flags);
 
+/// @brief Same as RraTlasGetInstanceFlags(), for the trace loaded into a context.
+///
+/// @param [in] context The context to query. The remaining parameters are as for RraTlasGetInstanceFlags().
+RraErrorCode RraContextTlasGetInstanceFlags(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_flags);
+
 #ifdef __cplusplus
 }
 #endif  // #ifdef __cplusplus
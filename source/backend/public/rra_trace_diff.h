@@ -0,0 +1,66 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the trace diff interface.
+///
+/// Compares the acceleration structures in two trace files and reports the
+/// differences in size, node counts, SAH, depth, compaction and build flags.
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_TRACE_DIFF_H_
+#define RRA_BACKEND_PUBLIC_RRA_TRACE_DIFF_H_
+
+#include <stdint.h>
+
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief The relative increase in a BLAS SAH that is counted as a regression.
+static const float kRraTraceDiffSahTolerance = 0.01f;
+
+/// @brief The totals from comparing two traces.
+typedef struct RraTraceDiffSummary
+{
+    uint64_t tlas_count_a;           ///< The number of TLASes in the first trace.
+    uint64_t tlas_count_b;           ///< The number of TLASes in the second trace.
+    uint64_t blas_count_a;           ///< The number of BLASes in the first trace.
+    uint64_t blas_count_b;           ///< The number of BLASes in the second trace.
+    uint64_t matched_by_geometry;    ///< The number of BLASes matched by their geometry hash.
+    uint64_t matched_by_address;     ///< The number of BLASes matched by their virtual address.
+    uint64_t added_blas_count;       ///< The number of BLASes only in the second trace.
+    uint64_t removed_blas_count;     ///< The number of BLASes only in the first trace.
+    uint64_t changed_blas_count;     ///< The number of matched BLASes with any difference.
+    uint64_t regressed_blas_count;   ///< The number of matched BLASes that got bigger or whose SAH got worse.
+    int64_t  total_blas_size_delta;  ///< The change in the total size of all BLASes, in bytes.
+    int64_t  total_tlas_size_delta;  ///< The change in the total size of all TLASes, in bytes.
+} RraTraceDiffSummary;
+
+/// @brief Compare the acceleration structures in two trace files.
+///
+/// Each trace is loaded into a context of its own, so any trace that is already
+/// loaded is left as it is.
+///
+/// BLASes are matched using a hash of their triangle geometry, which does not
+/// depend on how the BVH was built, and then by virtual address. TLASes are
+/// matched by virtual address, then by index. Both passes use hash maps, so the
+/// cost grows linearly with the number of acceleration structures.
+///
+/// @param [in]  trace_file_name_a The first (baseline) trace file.
+/// @param [in]  trace_file_name_b The second trace file.
+/// @param [in]  report_file_name  The file to write the JSON report to. May be NULL if no report is needed.
+/// @param [out] out_summary       A pointer to receive the totals. May be NULL.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+RraErrorCode RraTraceDiff(const char*          trace_file_name_a,
+                          const char*          trace_file_name_b,
+                          const char*          report_file_name,
+                          RraTraceDiffSummary* out_summary);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+#endif  // RRA_BACKEND_PUBLIC_RRA_TRACE_DIFF_H_
@@ -0,0 +1,85 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition for the synthetic trace generator interface.
+///
+/// Writes a trace file containing procedurally generated acceleration
+/// structures, so the loader and the analysis passes can be exercised at any
+/// scale without a real capture. Each BLAS is a randomly displaced grid mesh,
+/// and a single TLAS instances the BLASes on a grid. The output is a normal
+/// RDF trace and can be opened with RraTraceLoaderLoad().
+//=============================================================================
+
+#ifndef RRA_BACKEND_PUBLIC_RRA_TRACE_GENERATOR_H_
+#define RRA_BACKEND_PUBLIC_RRA_TRACE_GENERATOR_H_
+
+#include <stdint.h>
+
+#include "rra_compression_analysis.h"
+#include "rra_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // #ifdef __cplusplus
+
+/// @brief How the generated trees are split.
+typedef enum
+{
+    kRraTraceGeneratorTreeShapeMedian = 0,  ///< Split at the median along the longest axis. Gives balanced trees with tight boxes.
+    kRraTraceGeneratorTreeShapeRandom = 1,  ///< Split at a random point in build order. Gives unbalanced trees with overlapping boxes.
+
+    kRraTraceGeneratorTreeShapeCount  ///< The number of tree shapes.
+} RraTraceGeneratorTreeShape;
+
+/// @brief The settings for a generated trace.
+typedef struct RraTraceGeneratorConfig
+{
+    uint32_t                   blas_count;                 ///< The number of BLASes.
+    uint32_t                   triangles_per_blas;         ///< The number of triangles in each BLAS, at most 1 << 24.
+    uint32_t                   instance_count;             ///< The number of instances in the TLAS, at most 1 << 24. Every BLAS is instanced at least once.
+    uint32_t                   inactive_instance_count;    ///< The number of instances, taken from the end, with a mask of 0. At most instance_count.
+    RraTraceGeneratorTreeShape tree_shape;                 ///< How the trees are split.
+    RraTriangleCompressionMode triangle_compression_mode;  ///< The triangle compression mode. Must be None, TwoTriangles or PairTriangles.
+    RraBoxFp16Mode             box_fp16_mode;              ///< The fp16 box node mode for the BLASes. The TLAS box nodes are always fp32.
+    float                      fp16_tolerance;             ///< For kRraBoxFp16ModeMixedWithFp32, how far a bound may move as a fraction of the node's extent.
+    uint64_t                   seed;                       ///< The random seed. The same seed and settings always give the same file.
+} RraTraceGeneratorConfig;
+
+/// @brief The totals for a generated trace.
+typedef struct RraTraceGeneratorStats
+{
+    uint64_t triangle_count;       ///< The number of triangles over all the BLASes.
+    uint64_t fp32_box_node_count;  ///< The number of fp32 box nodes, including the TLAS.
+    uint64_t fp16_box_node_count;  ///< The number of fp16 box nodes.
+    uint64_t leaf_node_count;      ///< The number of triangle and instance nodes.
+    uint64_t chunk_data_size;      ///< The number of bytes of chunk headers and data written, not counting the RDF file structures.
+} RraTraceGeneratorStats;
+
+/// @brief Get the default trace generator settings.
+///
+/// This is a small trace of 16 BLASes of 4096 pair compressed triangles, instanced 64 times.
+///
+/// @param [out] out_config A pointer to receive the settings.
+///
+/// @return kRraOk if successful, kRraErrorInvalidPointer if out_config is NULL.
+RraErrorCode RraTraceGeneratorGetDefaultConfig(RraTraceGeneratorConfig* out_config);
+
+/// @brief Generate a trace and write it to a file.
+///
+/// Each BLAS is generated, written and freed in turn, so the memory use depends on the size of a single BLAS rather
+/// than the size of the trace. This does not need a trace to be loaded, and does not change the loaded trace.
+///
+/// @param [in]  file_path The path of the file to write. An existing file is overwritten.
+/// @param [in]  config    The settings.
+/// @param [out] out_stats A pointer to receive the totals. May be NULL.
+///
+/// @return kRraOk if successful, kRraErrorInvalidSize if a count or mode is out of range, kRraErrorInvalidPath if
+/// the file could not be created, or kRraErrorPlatformFunctionFailed if writing failed.
+RraErrorCode RraTraceGeneratorWrite(const char* file_path, const RraTraceGeneratorConfig* config, RraTraceGeneratorStats* out_stats);
+
+#ifdef __cplusplus
+}
+#endif  // #ifdef __cplusplus
+
+#endif  // RRA_BACKEND_PUBLIC_RRA_TRACE_GENERATOR_H_
@@ -16,7 +16,7 @@
 extern "C" {
 #endif  // #ifdef __cplusplus
 
-/// @brief Load a trace file.
+/// @brief Load a trace file into the default context.
 ///
 /// @param [in] trace_file_name The name of the trace file to load.
 ///
@@ -0,0 +1,463 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the ray generation and intersection functions used to estimate ray costs.
+//=============================================================================
+
+#include "ray_cost.h"
+
+#include <float.h>
+#include <immintrin.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "public/rra_assert.h"
+#include "job_system.h"
+
+#ifndef _WIN32
+#include "public/linux/safe_crt.h"
+#endif
+
+namespace rra
+{
+    namespace ray_cost
+    {
+        static const uint32_t kRayBatchSize = 1024;               ///< The number of rays in each block of work.
+        static const float    kBoundsScale  = 1.05f;              ///< Scale applied to the bounding sphere so rays start outside the geometry.
+        static const float    kPi           = 3.14159265358979f;  ///< Pi.
+
+        /// @brief The percentiles reported, in the order of RraRayCostPercentile.
+        static const uint32_t kPercentiles[kRraRayCostPercentileCount] = {50, 90, 99, 100};
+
+        /// @brief A small random number generator (splitmix64), seeded separately for each ray.
+        class Random
+        {
+        public:
+            /// @brief Constructor.
+            ///
+            /// @param [in] seed      The seed for the estimate.
+            /// @param [in] ray_index The index of the ray being generated.
+            Random(uint64_t seed, uint64_t ray_index)
+                : state_(seed ^ (ray_index * 0x9e3779b97f4a7c15ULL))
+            {
+            }
+
+            /// @brief Get the next random value in [0, 1).
+            ///
+            /// @return The random value.
+            float NextFloat()
+            {
+                state_ += 0x9e3779b97f4a7c15ULL;
+                uint64_t value = state_;
+                value          = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                value          = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+                value ^= value >> 31;
+
+                // Use the top 24 bits so the result is exact in a float.
+                return static_cast<float>(value >> 40) * (1.0f / 16777216.0f);
+            }
+
+        private:
+            uint64_t state_;  ///< The generator state.
+        };
+
+        /// @brief Get a random point on a unit sphere.
+        ///
+        /// @param [in] random The random number generator.
+        ///
+        /// @return The point.
+        static glm::vec3 RandomPointOnSphere(Random& random)
+        {
+            float z   = 1.0f - 2.0f * random.NextFloat();
+            float phi = 2.0f * kPi * random.NextFloat();
+            float r   = sqrtf(std::max(0.0f, 1.0f - z * z));
+            return glm::vec3(r * cosf(phi), r * sinf(phi), z);
+        }
+
+        /// @brief Generate a ray.
+        ///
+        /// @param [in] generator The ray generator state.
+        /// @param [in] ray_index The index of the ray.
+        ///
+        /// @return The ray.
+        static Ray GenerateRay(const RayGenerator& generator, uint64_t ray_index)
+        {
+            if (generator.distribution == kRraRayDistributionFile)
+            {
+                return generator.file_rays[ray_index];
+            }
+
+            Random random(generator.seed, ray_index);
+            Ray    ray = {};
+            ray.t_min  = 0.0f;
+            ray.t_max  = FLT_MAX;
+
+            if (generator.distribution == kRraRayDistributionCameraFrustum)
+            {
+                float u       = 2.0f * random.NextFloat() - 1.0f;
+                float v       = 2.0f * random.NextFloat() - 1.0f;
+                ray.origin    = generator.camera_position;
+                ray.direction = glm::normalize(generator.camera_forward + generator.camera_right * u + generator.camera_up * v);
+            }
+            else
+            {
+                // A line through two random points on the sphere. This gives a uniform distribution of lines through it.
+                glm::vec3 start = RandomPointOnSphere(random);
+                glm::vec3 end   = RandomPointOnSphere(random);
+                glm::vec3 chord = end - start;
+                if (glm::dot(chord, chord) < 1e-12f)
+                {
+                    chord = -start;
+                }
+                ray.origin    = generator.center + start * generator.radius;
+                ray.direction = glm::normalize(chord);
+            }
+
+            return ray;
+        }
+
+        /// @brief Read rays from a text file.
+        ///
+        /// Each line holds the origin and direction, and optionally the start and end of the ray
+        /// interval: "ox oy oz dx dy dz [t_min t_max]". Blank lines and lines starting with '#' are skipped.
+        ///
+        /// @param [in]  file_name The file to read.
+        /// @param [out] out_rays  The rays read.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        static RraErrorCode ReadRayFile(const char* file_name, std::vector<Ray>& out_rays)
+        {
+            RRA_RETURN_ON_ERROR(file_name != nullptr, kRraErrorInvalidPath);
+
+            FILE* file = nullptr;
+            fopen_s(&file, file_name, "rb");
+            RRA_RETURN_ON_ERROR(file != nullptr, kRraErrorInvalidPath);
+
+            RraErrorCode error_code = kRraOk;
+            char         line[512];
+            while (fgets(line, sizeof(line), file) != nullptr)
+            {
+                char* cursor = line;
+                while (*cursor == ' ' || *cursor == '\t')
+                {
+                    cursor++;
+                }
+                if (*cursor == '#' || *cursor == '\r' || *cursor == '\n' || *cursor == '\0')
+                {
+                    continue;
+                }
+
+                float values[8]   = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, FLT_MAX};
+                int   value_count = 0;
+                for (; value_count < 8; value_count++)
+                {
+                    char* end           = nullptr;
+                    values[value_count] = strtof(cursor, &end);
+                    if (end == cursor)
+                    {
+                        break;
+                    }
+                    cursor = end;
+                }
+
+                glm::vec3 direction(values[3], values[4], values[5]);
+                if (value_count < 6 || glm::dot(direction, direction) == 0.0f)
+                {
+                    error_code = kRraErrorMalformedData;
+                    break;
+                }
+
+                Ray ray       = {};
+                ray.origin    = glm::vec3(values[0], values[1], values[2]);
+                ray.direction = direction;
+                ray.t_min     = value_count >= 7 ? values[6] : 0.0f;
+                ray.t_max     = value_count >= 8 ? values[7] : FLT_MAX;
+                out_rays.push_back(ray);
+            }
+
+            fclose(file);
+            return error_code;
+        }
+
+        /// @brief Get the number of rays an estimate will cast.
+        ///
+        /// @param [in] config    The ray cost settings.
+        /// @param [in] generator The ray generator.
+        ///
+        /// @return The ray count.
+        static uint64_t GetRayCount(const RraRayCostConfig& config, const RayGenerator& generator)
+        {
+            return (config.distribution == kRraRayDistributionFile) ? generator.file_rays.size() : config.ray_count;
+        }
+
+        /// @brief Get a percentile of a list of values, using the nearest rank.
+        ///
+        /// @param [in] values     The values. They are partially reordered.
+        /// @param [in] percentile The percentile, from 1 to 100.
+        ///
+        /// @return The value at the percentile.
+        static uint32_t GetPercentile(std::vector<uint32_t>& values, uint32_t percentile)
+        {
+            size_t rank  = (values.size() * percentile + 99) / 100;
+            size_t index = (rank > 0) ? rank - 1 : 0;
+            std::nth_element(values.begin(), values.begin() + index, values.end());
+            return values[index];
+        }
+
+        RraErrorCode InitializeRayGenerator(const RraRayCostConfig& config, const dxr::amd::AxisAlignedBoundingBox& bounds, RayGenerator& generator)
+        {
+            generator.distribution = config.distribution;
+            generator.seed         = config.seed;
+
+            glm::vec3 bounds_min(bounds.min.x, bounds.min.y, bounds.min.z);
+            glm::vec3 bounds_max(bounds.max.x, bounds.max.y, bounds.max.z);
+            generator.center = (bounds_min + bounds_max) * 0.5f;
+            generator.radius = std::max(glm::length(bounds_max - bounds_min) * 0.5f * kBoundsScale, FLT_MIN);
+
+            if (config.distribution == kRraRayDistributionFile)
+            {
+                return ReadRayFile(config.ray_file_name, generator.file_rays);
+            }
+
+            if (config.distribution == kRraRayDistributionCameraFrustum)
+            {
+                glm::vec3 position(config.camera_position[0], config.camera_position[1], config.camera_position[2]);
+                glm::vec3 forward(config.camera_direction[0], config.camera_direction[1], config.camera_direction[2]);
+                glm::vec3 up(config.camera_up[0], config.camera_up[1], config.camera_up[2]);
+
+                if (glm::dot(forward, forward) == 0.0f)
+                {
+                    forward  = glm::vec3(0.0f, 0.0f, -1.0f);
+                    position = generator.center - forward * (2.0f * generator.radius);
+                }
+                if (glm::dot(up, up) == 0.0f)
+                {
+                    up = glm::vec3(0.0f, 1.0f, 0.0f);
+                }
+
+                forward         = glm::normalize(forward);
+                glm::vec3 right = glm::cross(forward, up);
+                if (glm::dot(right, right) < 1e-12f)
+                {
+                    // The up vector is parallel to the view direction, so pick any perpendicular one.
+                    right = glm::cross(forward, fabsf(forward.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+                }
+                right = glm::normalize(right);
+                up    = glm::cross(right, forward);
+
+                float half_height = tanf(config.camera_fov * 0.5f * kPi / 180.0f);
+                float half_width  = half_height * config.camera_aspect_ratio;
+
+                generator.camera_position = position;
+                generator.camera_forward  = forward;
+                generator.camera_right    = right * half_width;
+                generator.camera_up       = up * half_height;
+            }
+
+            return kRraOk;
+        }
+
+        uint32_t IntersectChildBoxes(const std::array<dxr::amd::AxisAlignedBoundingBox, 4>& boxes,
+                                     const glm::vec3&                                       origin,
+                                     const glm::vec3&                                       inv_direction,
+                                     float                                                  t_min,
+                                     float                                                  t_max,
+                                     float                                                  out_t_entry[4])
+        {
+            // Transpose the boxes, so each register holds one bound of all 4 boxes.
+            const __m128 min_x = _mm_setr_ps(boxes[0].min.x, boxes[1].min.x, boxes[2].min.x, boxes[3].min.x);
+            const __m128 min_y = _mm_setr_ps(boxes[0].min.y, boxes[1].min.y, boxes[2].min.y, boxes[3].min.y);
+            const __m128 min_z = _mm_setr_ps(boxes[0].min.z, boxes[1].min.z, boxes[2].min.z, boxes[3].min.z);
+            const __m128 max_x = _mm_setr_ps(boxes[0].max.x, boxes[1].max.x, boxes[2].max.x, boxes[3].max.x);
+            const __m128 max_y = _mm_setr_ps(boxes[0].max.y, boxes[1].max.y, boxes[2].max.y, boxes[3].max.y);
+            const __m128 max_z = _mm_setr_ps(boxes[0].max.z, boxes[1].max.z, boxes[2].max.z, boxes[3].max.z);
+
+            const __m128 origin_x = _mm_set1_ps(origin.x);
+            const __m128 origin_y = _mm_set1_ps(origin.y);
+            const __m128 origin_z = _mm_set1_ps(origin.z);
+            const __m128 inv_x    = _mm_set1_ps(inv_direction.x);
+            const __m128 inv_y    = _mm_set1_ps(inv_direction.y);
+            const __m128 inv_z    = _mm_set1_ps(inv_direction.z);
+
+            const __m128 tx0 = _mm_mul_ps(_mm_sub_ps(min_x, origin_x), inv_x);
+            const __m128 tx1 = _mm_mul_ps(_mm_sub_ps(max_x, origin_x), inv_x);
+            const __m128 ty0 = _mm_mul_ps(_mm_sub_ps(min_y, origin_y), inv_y);
+            const __m128 ty1 = _mm_mul_ps(_mm_sub_ps(max_y, origin_y), inv_y);
+            const __m128 tz0 = _mm_mul_ps(_mm_sub_ps(min_z, origin_z), inv_z);
+            const __m128 tz1 = _mm_mul_ps(_mm_sub_ps(max_z, origin_z), inv_z);
+
+            // std::min(a, b) and std::max(a, b) return a when either is NaN, as _mm_min_ps(b, a) and _mm_max_ps(b, a) do,
+            // so the operands are swapped to keep the NaN handling of the slab test the same as before.
+            const __m128 t_near = _mm_max_ps(_mm_max_ps(_mm_set1_ps(t_min), _mm_min_ps(tz1, tz0)), _mm_max_ps(_mm_min_ps(ty1, ty0), _mm_min_ps(tx1, tx0)));
+            const __m128 t_far  = _mm_min_ps(_mm_min_ps(_mm_set1_ps(t_max), _mm_max_ps(tz1, tz0)), _mm_min_ps(_mm_max_ps(ty1, ty0), _mm_max_ps(tx1, tx0)));
+
+            _mm_storeu_ps(out_t_entry, t_near);
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(t_near, t_far)));
+        }
+
+        bool IntersectTriangle(const Ray& ray, const dxr::amd::Triangle& triangle, float* out_t)
+        {
+            glm::vec3 p0(triangle.v0.x, triangle.v0.y, triangle.v0.z);
+            glm::vec3 edge1 = glm::vec3(triangle.v1.x, triangle.v1.y, triangle.v1.z) - p0;
+            glm::vec3 edge2 = glm::vec3(triangle.v2.x, triangle.v2.y, triangle.v2.z) - p0;
+
+            glm::vec3 p   = glm::cross(ray.direction, edge2);
+            float     det = glm::dot(edge1, p);
+            if (fabsf(det) < 1e-12f)
+            {
+                return false;
+            }
+
+            float     inv_det = 1.0f / det;
+            glm::vec3 s       = ray.origin - p0;
+            float     u       = glm::dot(s, p) * inv_det;
+            if (u < 0.0f || u > 1.0f)
+            {
+                return false;
+            }
+
+            glm::vec3 q = glm::cross(s, edge1);
+            float     v = glm::dot(ray.direction, q) * inv_det;
+            if (v < 0.0f || u + v > 1.0f)
+            {
+                return false;
+            }
+
+            float t = glm::dot(edge2, q) * inv_det;
+            if (t < ray.t_min || t > ray.t_max)
+            {
+                return false;
+            }
+
+            *out_t = t;
+            return true;
+        }
+
+        glm::vec3 GetInverseDirection(const glm::vec3& direction)
+        {
+            glm::vec3 inv_direction;
+            for (int i = 0; i < 3; i++)
+            {
+                float component  = (fabsf(direction[i]) > 1e-20f) ? direction[i] : copysignf(1e-20f, direction[i]);
+                inv_direction[i] = 1.0f / component;
+            }
+            return inv_direction;
+        }
+
+        void CastRays(const RraRayCostConfig& config, const RayGenerator& generator, const TraceFunction& trace, RraRayCostStats* out_stats)
+        {
+            const uint64_t         ray_count = GetRayCount(config, generator);
+            std::vector<RayResult> results(ray_count);
+
+            // Each ray depends only on its index, so the results don't depend on which thread casts it.
+            auto cast_batch = [&](size_t first, size_t last, uint32_t) {
+                for (uint64_t ray_index = first; ray_index < last; ray_index++)
+                {
+                    Ray ray = GenerateRay(generator, ray_index);
+                    trace(ray, results[ray_index]);
+                }
+            };
+            JobSystem::Get().ParallelFor(static_cast<size_t>(ray_count), kRayBatchSize, config.thread_count, cast_batch);
+
+            *out_stats = {};
+
+            std::vector<uint32_t> node_visits(ray_count);
+            std::vector<uint32_t> triangle_tests(ray_count);
+            for (uint64_t i = 0; i < ray_count; i++)
+            {
+                const RayResult& result = results[i];
+                out_stats->hit_count += result.hit ? 1 : 0;
+                out_stats->node_visits += result.node_visits;
+                out_stats->box_node_visits += result.box_node_visits;
+                out_stats->triangle_tests += result.triangle_tests;
+                out_stats->instance_visits += result.instance_visits;
+                node_visits[i]    = result.node_visits;
+                triangle_tests[i] = result.triangle_tests;
+            }
+
+            out_stats->ray_count = ray_count;
+            if (ray_count == 0)
+            {
+                return;
+            }
+
+            out_stats->mean_node_visits    = static_cast<float>(static_cast<double>(out_stats->node_visits) / ray_count);
+            out_stats->mean_triangle_tests = static_cast<float>(static_cast<double>(out_stats->triangle_tests) / ray_count);
+            for (uint32_t i = 0; i < kRraRayCostPercentileCount; i++)
+            {
+                out_stats->node_visit_percentiles[i]    = GetPercentile(node_visits, kPercentiles[i]);
+                out_stats->triangle_test_percentiles[i] = GetPercentile(triangle_tests, kPercentiles[i]);
+            }
+        }
+
+        void SimulateCache(const RraRayCostConfig&      config,
+                           const RraRayCostCacheConfig& cache_config,
+                           const RayGenerator&          generator,
+                           const CacheTraceFunction&    trace,
+                           RraRayCostCacheStats*        out_stats)
+        {
+            const uint64_t              ray_count   = GetRayCount(config, generator);
+            const uint64_t              group_count = (ray_count + cache_config.ray_group_size - 1) / cache_config.ray_group_size;
+            std::vector<RayCacheResult> results(ray_count);
+            std::atomic<uint64_t>       next_group(0);
+
+            // Each group always starts with an empty cache and traces its rays in order, so the results don't depend on which thread casts it.
+            auto worker = [&]() {
+                CacheModel cache(cache_config);
+                RayResult  ray_result;
+                for (uint64_t group = next_group++; group < group_count; group = next_group++)
+                {
+                    cache.Flush();
+
+                    const uint64_t first = group * cache_config.ray_group_size;
+                    const uint64_t last  = std::min(first + cache_config.ray_group_size, ray_count);
+                    for (uint64_t ray_index = first; ray_index < last; ray_index++)
+                    {
+                        Ray ray    = GenerateRay(generator, ray_index);
+                        ray_result = {};
+                        trace(ray, ray_result, cache);
+                        cache.EndRay(results[ray_index]);
+                    }
+                }
+            };
+
+            uint32_t thread_count = (config.thread_count > 0) ? config.thread_count : JobSystem::Get().GetThreadCount();
+            thread_count          = static_cast<uint32_t>(std::max<uint64_t>(1, std::min<uint64_t>(thread_count, group_count)));
+            JobSystem::Get().RunConcurrently(thread_count, [&worker](uint32_t) { worker(); });
+
+            *out_stats = {};
+
+            std::vector<uint32_t> unique_lines(ray_count);
+            for (uint64_t i = 0; i < ray_count; i++)
+            {
+                const RayCacheResult& result = results[i];
+                out_stats->line_reads += result.line_reads;
+                out_stats->hits += result.hits;
+                out_stats->unique_lines += result.unique_lines;
+                out_stats->unique_pages += result.unique_pages;
+                unique_lines[i] = result.unique_lines;
+            }
+
+            out_stats->ray_count = ray_count;
+            out_stats->misses    = out_stats->line_reads - out_stats->hits;
+            if (ray_count == 0)
+            {
+                return;
+            }
+
+            out_stats->hit_rate          = (out_stats->line_reads > 0) ? static_cast<float>(static_cast<double>(out_stats->hits) / out_stats->line_reads) : 0.0f;
+            out_stats->mean_unique_lines = static_cast<float>(static_cast<double>(out_stats->unique_lines) / ray_count);
+            out_stats->mean_unique_pages = static_cast<float>(static_cast<double>(out_stats->unique_pages) / ray_count);
+            out_stats->mean_miss_bytes   = static_cast<float>(static_cast<double>(out_stats->misses) * cache_config.line_size / ray_count);
+            for (uint32_t i = 0; i < kRraRayCostPercentileCount; i++)
+            {
+                out_stats->unique_line_percentiles[i] = GetPercentile(unique_lines, kPercentiles[i]);
+            }
+        }
+    }  // namespace ray_cost
+}  // namespace rra
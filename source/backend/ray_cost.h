@@ -0,0 +1,163 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the ray generation and intersection functions used to estimate ray costs.
+///
+/// These are shared by the ray cost estimator, which traverses the captured
+/// BVHs, and the reference BVH builder, which traverses its own trees.
+//=============================================================================
+
+#ifndef RRA_BACKEND_RAY_COST_H_
+#define RRA_BACKEND_RAY_COST_H_
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#include "glm/glm/glm.hpp"
+
+#include "bvh/dxr_definitions.h"
+#include "bvh/node_types/triangle_node.h"
+#include "cache_model.h"
+#include "public/rra_error.h"
+#include "public/rra_ray_cost.h"
+
+namespace rra
+{
+    namespace ray_cost
+    {
+        /// @brief A ray, in the space of the acceleration structure being traversed.
+        struct Ray
+        {
+            glm::vec3 origin;     ///< The ray origin.
+            glm::vec3 direction;  ///< The ray direction.
+            float     t_min;      ///< The start of the ray interval.
+            float     t_max;      ///< The end of the ray interval. Shrinks to the closest hit found so far.
+        };
+
+        /// @brief The counts for a single ray.
+        struct RayResult
+        {
+            uint32_t node_visits     = 0;      ///< The number of nodes visited.
+            uint32_t box_node_visits = 0;      ///< The number of box nodes visited.
+            uint32_t triangle_tests  = 0;      ///< The number of ray/triangle tests.
+            uint32_t instance_visits = 0;      ///< The number of instance nodes visited.
+            bool     hit             = false;  ///< Did the ray hit a triangle.
+        };
+
+        /// @brief The state needed to generate the rays for an estimate.
+        struct RayGenerator
+        {
+            RraRayDistribution distribution    = kRraRayDistributionUniformSphere;  ///< How the rays are generated.
+            uint64_t           seed            = 0;                                 ///< The seed for the estimate.
+            glm::vec3          center          = {};                                ///< The center of the bounding sphere.
+            float              radius          = 0.0f;                              ///< The radius of the bounding sphere.
+            glm::vec3          camera_position = {};                                ///< The camera position.
+            glm::vec3          camera_forward  = {};                                ///< The camera's forward vector.
+            glm::vec3          camera_right    = {};                                ///< The camera's right vector, scaled to the edge of the view.
+            glm::vec3          camera_up       = {};                                ///< The camera's up vector, scaled to the edge of the view.
+            std::vector<Ray>   file_rays;                                           ///< The rays read from a file.
+        };
+
+        /// @brief A function that traces a single ray and fills in its counts. Called from several threads at once.
+        typedef std::function<void(Ray& ray, RayResult& result)> TraceFunction;
+
+        /// @brief A function that traces a single ray, reading each node it visits through the cache. Called from several threads at once.
+        typedef std::function<void(Ray& ray, RayResult& result, CacheModel& cache)> CacheTraceFunction;
+
+        /// @brief Set up the ray generator for an estimate.
+        ///
+        /// @param [in]  config    The ray cost settings.
+        /// @param [in]  bounds    The bounding box of the acceleration structure.
+        /// @param [out] generator The ray generator to set up.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        RraErrorCode InitializeRayGenerator(const RraRayCostConfig& config, const dxr::amd::AxisAlignedBoundingBox& bounds, RayGenerator& generator);
+
+        /// @brief Intersect a ray with the four child bounding boxes of a box node.
+        ///
+        /// The boxes are transposed into SSE registers, and the four slab tests are done together.
+        ///
+        /// @param [in]  boxes         The child bounding boxes.
+        /// @param [in]  origin        The ray origin.
+        /// @param [in]  inv_direction The reciprocal of the ray direction.
+        /// @param [in]  t_min         The start of the ray interval.
+        /// @param [in]  t_max         The end of the ray interval.
+        /// @param [out] out_t_entry   The distance at which the ray enters each box.
+        ///
+        /// @return A mask with a bit set for each box that was hit.
+        uint32_t IntersectChildBoxes(const std::array<dxr::amd::AxisAlignedBoundingBox, 4>& boxes,
+                                     const glm::vec3&                                       origin,
+                                     const glm::vec3&                                       inv_direction,
+                                     float                                                  t_min,
+                                     float                                                  t_max,
+                                     float                                                  out_t_entry[4]);
+
+        /// @brief Intersect a ray with a triangle (Moller-Trumbore, no culling).
+        ///
+        /// @param [in]  ray      The ray.
+        /// @param [in]  triangle The triangle.
+        /// @param [out] out_t    The distance to the hit, if there is one.
+        ///
+        /// @return true if the ray hits the triangle within its interval, false if not.
+        bool IntersectTriangle(const Ray& ray, const dxr::amd::Triangle& triangle, float* out_t);
+
+        /// @brief Sort the hit children of a box node so the furthest comes first, ready to be pushed onto the stack.
+        ///
+        /// An insertion sort, as there are at most 4 children. std::sort on the fixed size array trips GCC's
+        /// -Warray-bounds, as it can't tell the count is never more than 4.
+        ///
+        /// @param [in,out] entries The stack entries, each with a t_entry distance.
+        /// @param [in]     count   The number of entries.
+        template <typename StackEntry>
+        void SortFurthestFirst(StackEntry* entries, uint32_t count)
+        {
+            for (uint32_t i = 1; i < count; i++)
+            {
+                StackEntry entry = entries[i];
+                uint32_t   j     = i;
+                for (; j > 0 && entries[j - 1].t_entry < entry.t_entry; j--)
+                {
+                    entries[j] = entries[j - 1];
+                }
+                entries[j] = entry;
+            }
+        }
+
+        /// @brief Get the reciprocal of a ray direction, avoiding infinities for zero components.
+        ///
+        /// @param [in] direction The ray direction.
+        ///
+        /// @return The reciprocal direction.
+        glm::vec3 GetInverseDirection(const glm::vec3& direction);
+
+        /// @brief Cast all the rays, using several threads, and gather the totals.
+        ///
+        /// Each ray depends only on the seed and its index, so the totals don't depend on the number of threads.
+        ///
+        /// @param [in]  config    The ray cost settings.
+        /// @param [in]  generator The ray generator.
+        /// @param [in]  trace     The function that traces a single ray.
+        /// @param [out] out_stats A pointer to receive the totals.
+        void CastRays(const RraRayCostConfig& config, const RayGenerator& generator, const TraceFunction& trace, RraRayCostStats* out_stats);
+
+        /// @brief Cast all the rays through a cache model, using several threads, and gather the totals.
+        ///
+        /// The rays are split into groups of consecutive rays. Each group is traced by one thread, a ray at a time,
+        /// through a cache that starts empty, so the totals don't depend on the number of threads.
+        ///
+        /// @param [in]  config       The ray cost settings.
+        /// @param [in]  cache_config The cache model settings. Must have passed CacheModel::ValidateConfig().
+        /// @param [in]  generator    The ray generator.
+        /// @param [in]  trace        The function that traces a single ray.
+        /// @param [out] out_stats    A pointer to receive the totals.
+        void SimulateCache(const RraRayCostConfig&      config,
+                           const RraRayCostCacheConfig& cache_config,
+                           const RayGenerator&          generator,
+                           const CacheTraceFunction&    trace,
+                           RraRayCostCacheStats*        out_stats);
+    }  // namespace ray_cost
+}  // namespace rra
+
+#endif  // RRA_BACKEND_RAY_COST_H_
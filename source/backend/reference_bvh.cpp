@@ -0,0 +1,393 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the reference BVH builder.
+//=============================================================================
+
+#include "reference_bvh.h"
+
+#include <float.h>
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "glm/glm/glm.hpp"
+
+#include "public/rra_assert.h"
+#include "job_system.h"
+
+namespace rra
+{
+    const uint32_t ReferenceBvhNode::kLeafFlag;
+    const uint32_t ReferenceBvhNode::kInvalidChild;
+
+    static const uint32_t kBinCount          = 16;         ///< The number of bins used to find a split.
+    static const uint32_t kParallelThreshold = 16 * 1024;  ///< The number of triangles a subtree needs before it is built as a job of its own.
+    static const uint32_t kMaxSahDepth       = 64;         ///< Below this depth, ranges are split at the median to bound the recursion.
+
+    /// @brief An axis aligned bounding box used while building.
+    struct Bounds
+    {
+        glm::vec3 min = glm::vec3(FLT_MAX);   ///< The minimum corner.
+        glm::vec3 max = glm::vec3(-FLT_MAX);  ///< The maximum corner.
+
+        /// @brief Grow the bounds to include a point.
+        ///
+        /// @param [in] point The point.
+        void Grow(const glm::vec3& point)
+        {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        /// @brief Grow the bounds to include another bounding box.
+        ///
+        /// @param [in] other The other bounding box.
+        void Grow(const Bounds& other)
+        {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+
+        /// @brief Get the surface area. Used as a relative measure, so is halved.
+        ///
+        /// @return The half surface area, or 0 if the bounds are empty.
+        float HalfArea() const
+        {
+            if (min.x > max.x)
+            {
+                return 0.0f;
+            }
+
+            const glm::vec3 extent = max - min;
+            return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+        }
+    };
+
+    /// @brief A triangle being placed in the tree.
+    struct PrimitiveRef
+    {
+        Bounds    bounds;          ///< The bounding box of the triangle.
+        glm::vec3 centroid;        ///< The center of the bounding box.
+        uint32_t  triangle_index;  ///< The index of the triangle.
+    };
+
+    /// @brief A contiguous range of primitive references.
+    struct BuildRange
+    {
+        uint32_t first = 0;  ///< The first primitive reference.
+        uint32_t count = 0;  ///< The number of primitive references.
+        Bounds   bounds;     ///< The bounding box of the primitives.
+    };
+
+    /// @brief Convert the bounds used by the builder to the DXR bounding box.
+    ///
+    /// @param [in] bounds The bounds.
+    ///
+    /// @return The DXR bounding box.
+    static dxr::amd::AxisAlignedBoundingBox ToAxisAlignedBoundingBox(const Bounds& bounds)
+    {
+        return dxr::amd::AxisAlignedBoundingBox({bounds.min.x, bounds.min.y, bounds.min.z}, {bounds.max.x, bounds.max.y, bounds.max.z});
+    }
+
+    /// @brief Builds the nodes of a reference BVH, splitting large subtrees across threads.
+    class ReferenceBvhBuilder
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in] refs         The primitive references. Reordered while building.
+        /// @param [in] nodes        The node array, with room for every node.
+        /// @param [in] thread_count The maximum number of jobs to build at once.
+        ReferenceBvhBuilder(std::vector<PrimitiveRef>& refs, std::vector<ReferenceBvhNode>& nodes, uint32_t thread_count)
+            : refs_(refs)
+            , nodes_(nodes)
+            , next_node_(1)
+            , spare_threads_(static_cast<int32_t>(thread_count) - 1)
+        {
+        }
+
+        /// @brief Build a node and all of its descendants.
+        ///
+        /// @param [in] node_index The index of the node to fill in.
+        /// @param [in] range      The primitives below the node.
+        /// @param [in] depth      The depth of the node.
+        void BuildNode(uint32_t node_index, const BuildRange& range, uint32_t depth)
+        {
+            // Split the child with the largest surface area until there are 4 children, like a BVH4 collapsed from a binary tree.
+            BuildRange ranges[4];
+            uint32_t   range_count = 1;
+            ranges[0]              = range;
+
+            while (range_count < 4)
+            {
+                int32_t split_index = -1;
+                float   split_area  = -1.0f;
+                for (uint32_t i = 0; i < range_count; i++)
+                {
+                    if (ranges[i].count > 1 && ranges[i].bounds.HalfArea() > split_area)
+                    {
+                        split_index = static_cast<int32_t>(i);
+                        split_area  = ranges[i].bounds.HalfArea();
+                    }
+                }
+
+                if (split_index < 0)
+                {
+                    break;
+                }
+
+                SplitRange(ranges[split_index], depth >= kMaxSahDepth, ranges[split_index], ranges[range_count]);
+                range_count++;
+            }
+
+            ReferenceBvhNode& node = nodes_[node_index];
+            node.boxes.fill(dxr::amd::AxisAlignedBoundingBox());
+            node.children.fill(ReferenceBvhNode::kInvalidChild);
+
+            JobGroup group;
+            uint32_t inline_children[4];
+            uint32_t inline_count = 0;
+
+            for (uint32_t i = 0; i < range_count; i++)
+            {
+                node.boxes[i] = ToAxisAlignedBoundingBox(ranges[i].bounds);
+
+                if (ranges[i].count == 1)
+                {
+                    node.children[i] = ReferenceBvhNode::kLeafFlag | refs_[ranges[i].first].triangle_index;
+                    continue;
+                }
+
+                node.children[i] = next_node_.fetch_add(1);
+
+                if (ranges[i].count >= kParallelThreshold && ReserveThread())
+                {
+                    const uint32_t   child_index = node.children[i];
+                    const BuildRange child_range = ranges[i];
+                    JobSystem::Get().Submit(
+                        [this, child_index, child_range, depth]() {
+                            BuildNode(child_index, child_range, depth + 1);
+                            spare_threads_++;
+                        },
+                        group);
+                }
+                else
+                {
+                    inline_children[inline_count++] = i;
+                }
+            }
+
+            for (uint32_t i = 0; i < inline_count; i++)
+            {
+                BuildNode(node.children[inline_children[i]], ranges[inline_children[i]], depth + 1);
+            }
+
+            JobSystem::Get().Wait(group);
+        }
+
+        /// @brief Get the number of nodes used.
+        ///
+        /// @return The node count.
+        uint32_t GetNodeCount() const
+        {
+            return next_node_;
+        }
+
+    private:
+        /// @brief Take one of the spare threads, if there are any.
+        ///
+        /// @return true if a thread was reserved, false if not.
+        bool ReserveThread()
+        {
+            int32_t spare = spare_threads_;
+            while (spare > 0)
+            {
+                if (spare_threads_.compare_exchange_weak(spare, spare - 1))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// @brief Get the bounds of a range of primitives.
+        ///
+        /// @param [in] first The first primitive.
+        /// @param [in] count The number of primitives.
+        ///
+        /// @return The bounds.
+        Bounds GetRangeBounds(uint32_t first, uint32_t count) const
+        {
+            Bounds bounds;
+            for (uint32_t i = first; i < first + count; i++)
+            {
+                bounds.Grow(refs_[i].bounds);
+            }
+            return bounds;
+        }
+
+        /// @brief Split a range of primitives in two.
+        ///
+        /// The split is chosen by binning the centroids along the axis they are most spread out on, and taking the
+        /// bin boundary with the lowest surface area heuristic cost. If that leaves one side empty, or the tree is
+        /// too deep, the range is split at the median instead.
+        ///
+        /// @param [in]  range      The range to split. May be the same as out_left.
+        /// @param [in]  use_median Split at the median without evaluating the surface area heuristic.
+        /// @param [out] out_left   The first half of the range.
+        /// @param [out] out_right  The second half of the range.
+        void SplitRange(const BuildRange range, bool use_median, BuildRange& out_left, BuildRange& out_right)
+        {
+            RRA_ASSERT(range.count > 1);
+
+            Bounds centroid_bounds;
+            for (uint32_t i = range.first; i < range.first + range.count; i++)
+            {
+                centroid_bounds.Grow(refs_[i].centroid);
+            }
+
+            const glm::vec3 extent = centroid_bounds.max - centroid_bounds.min;
+            int             axis   = 0;
+            if (extent.y > extent[axis])
+            {
+                axis = 1;
+            }
+            if (extent.z > extent[axis])
+            {
+                axis = 2;
+            }
+
+            auto     begin = refs_.begin() + range.first;
+            auto     end   = begin + range.count;
+            uint32_t split = 0;
+
+            if (!use_median && extent[axis] > 0.0f)
+            {
+                const float axis_min = centroid_bounds.min[axis];
+                const float scale    = (kBinCount * (1.0f - 1e-5f)) / extent[axis];
+                auto        get_bin  = [axis, axis_min, scale](const PrimitiveRef& ref) {
+                    float bin = (ref.centroid[axis] - axis_min) * scale;
+                    return (bin > 0.0f) ? std::min(static_cast<uint32_t>(bin), kBinCount - 1) : 0u;
+                };
+
+                Bounds   bin_bounds[kBinCount];
+                uint32_t bin_counts[kBinCount] = {};
+                for (auto it = begin; it != end; ++it)
+                {
+                    uint32_t bin = get_bin(*it);
+                    bin_bounds[bin].Grow(it->bounds);
+                    bin_counts[bin]++;
+                }
+
+                // Sweep from the right to get the cost of everything after each bin boundary.
+                float    right_costs[kBinCount] = {};
+                Bounds   right_bounds;
+                uint32_t right_count = 0;
+                for (uint32_t bin = kBinCount - 1; bin > 0; bin--)
+                {
+                    right_bounds.Grow(bin_bounds[bin]);
+                    right_count += bin_counts[bin];
+                    right_costs[bin - 1] = right_bounds.HalfArea() * right_count;
+                }
+
+                // Then sweep from the left, splitting after the bin with the lowest total cost.
+                Bounds   left_bounds;
+                uint32_t left_count = 0;
+                float    best_cost  = FLT_MAX;
+                uint32_t best_bin   = 0;
+                for (uint32_t bin = 0; bin < kBinCount - 1; bin++)
+                {
+                    left_bounds.Grow(bin_bounds[bin]);
+                    left_count += bin_counts[bin];
+
+                    float cost = left_bounds.HalfArea() * left_count + right_costs[bin];
+                    if (left_count > 0 && left_count < range.count && cost < best_cost)
+                    {
+                        best_cost = cost;
+                        best_bin  = bin;
+                    }
+                }
+
+                if (best_cost < FLT_MAX)
+                {
+                    auto middle = std::partition(begin, end, [&get_bin, best_bin](const PrimitiveRef& ref) { return get_bin(ref) <= best_bin; });
+                    split       = static_cast<uint32_t>(middle - begin);
+                }
+            }
+
+            if (split == 0 || split == range.count)
+            {
+                split = range.count / 2;
+                std::nth_element(begin, begin + split, end, [axis](const PrimitiveRef& a, const PrimitiveRef& b) { return a.centroid[axis] < b.centroid[axis]; });
+            }
+
+            out_right.first  = range.first + split;
+            out_right.count  = range.count - split;
+            out_right.bounds = GetRangeBounds(out_right.first, out_right.count);
+            out_left.first   = range.first;
+            out_left.count   = split;
+            out_left.bounds  = GetRangeBounds(out_left.first, out_left.count);
+        }
+
+        std::vector<PrimitiveRef>&     refs_;           ///< The primitive references.
+        std::vector<ReferenceBvhNode>& nodes_;          ///< The nodes being built.
+        std::atomic<uint32_t>          next_node_;      ///< The index of the next free node.
+        std::atomic<int32_t>           spare_threads_;  ///< The number of threads that may still be started.
+    };
+
+    void BuildReferenceBvh(std::vector<dxr::amd::Triangle>&& triangles, uint32_t thread_count, ReferenceBvh& out_bvh)
+    {
+        out_bvh.triangles = std::move(triangles);
+        out_bvh.nodes.clear();
+        out_bvh.bounds = dxr::amd::AxisAlignedBoundingBox();
+
+        const uint32_t triangle_count = static_cast<uint32_t>(out_bvh.triangles.size());
+        if (triangle_count == 0)
+        {
+            return;
+        }
+
+        std::vector<PrimitiveRef> refs(triangle_count);
+        BuildRange                root_range;
+        root_range.count = triangle_count;
+
+        for (uint32_t i = 0; i < triangle_count; i++)
+        {
+            const dxr::amd::Triangle& triangle = out_bvh.triangles[i];
+            PrimitiveRef&             ref      = refs[i];
+            ref.triangle_index                 = i;
+            for (int32_t vertex = 0; vertex < 3; vertex++)
+            {
+                ref.bounds.Grow(glm::vec3(triangle[vertex].x, triangle[vertex].y, triangle[vertex].z));
+            }
+
+            // Keep triangles with non-finite vertices out of the way, so they can't break the binning.
+            const glm::vec3 corner_sum = ref.bounds.min + ref.bounds.max;
+            if (!isfinite(corner_sum.x + corner_sum.y + corner_sum.z))
+            {
+                ref.bounds.min = glm::vec3(0.0f);
+                ref.bounds.max = glm::vec3(0.0f);
+            }
+
+            ref.centroid = (ref.bounds.min + ref.bounds.max) * 0.5f;
+            root_range.bounds.Grow(ref.bounds);
+        }
+
+        if (thread_count == 0)
+        {
+            thread_count = JobSystem::Get().GetThreadCount();
+        }
+
+        // Every box node has at least 2 children, so there are fewer box nodes than triangles.
+        out_bvh.nodes.resize(std::max(triangle_count - 1, 1u));
+
+        ReferenceBvhBuilder builder(refs, out_bvh.nodes, thread_count);
+        builder.BuildNode(0, root_range, 0);
+
+        out_bvh.nodes.resize(builder.GetNodeCount());
+        out_bvh.bounds = ToAxisAlignedBoundingBox(root_range.bounds);
+    }
+}  // namespace rra
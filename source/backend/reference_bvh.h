@@ -0,0 +1,51 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the reference BVH builder.
+///
+/// Builds a 4-wide BVH over a set of triangles using the binned surface area
+/// heuristic. The tree only lives in memory and is used as a yardstick for
+/// the quality of the BLASes built by the driver.
+//=============================================================================
+
+#ifndef RRA_BACKEND_REFERENCE_BVH_H_
+#define RRA_BACKEND_REFERENCE_BVH_H_
+
+#include <array>
+#include <vector>
+
+#include "bvh/dxr_definitions.h"
+#include "bvh/node_types/triangle_node.h"
+
+namespace rra
+{
+    /// @brief A box node in a reference BVH.
+    struct ReferenceBvhNode
+    {
+        static const uint32_t kLeafFlag     = 0x80000000;  ///< Set in a child if it is the index of a triangle rather than a node.
+        static const uint32_t kInvalidChild = 0xFFFFFFFF;  ///< An unused child slot.
+
+        std::array<dxr::amd::AxisAlignedBoundingBox, 4> boxes;     ///< The bounding boxes of the children.
+        std::array<uint32_t, 4>                         children;  ///< The child node or triangle indices.
+    };
+
+    /// @brief A reference BVH. Each leaf holds a single triangle, as the triangle nodes in a captured BLAS do.
+    struct ReferenceBvh
+    {
+        std::vector<dxr::amd::Triangle>  triangles;  ///< The triangles, in the order they were given to the builder.
+        std::vector<ReferenceBvhNode>    nodes;      ///< The box nodes. The root is the first node.
+        dxr::amd::AxisAlignedBoundingBox bounds;     ///< The bounding box of all the triangles.
+    };
+
+    /// @brief Build a reference BVH using the binned surface area heuristic.
+    ///
+    /// Large subtrees are built on separate threads.
+    ///
+    /// @param [in]  triangles    The triangles to build the BVH over. Moved into the BVH.
+    /// @param [in]  thread_count The number of threads to use, or 0 for one per core.
+    /// @param [out] out_bvh      The BVH to build.
+    void BuildReferenceBvh(std::vector<dxr::amd::Triangle>&& triangles, uint32_t thread_count, ReferenceBvh& out_bvh);
+}  // namespace rra
+
+#endif  // RRA_BACKEND_REFERENCE_BVH_H_
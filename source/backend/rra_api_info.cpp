@@ -7,17 +7,25 @@
 
 #include "public/rra_api_info.h"
 
+#include "rra_context.h"
 #include "rra_data_set.h"
 
-// External reference to the global dataset.
-extern RraDataSet data_set_;
+const char* RraContextApiInfoGetApiName(RraContext* context)
+{
+    return context->data_set.api_info.GetApiName();
+}
+
+bool RraContextApiInfoIsVulkan(RraContext* context)
+{
+    return context->data_set.api_info.IsVulkan();
+}
 
 const char* RraApiInfoGetApiName()
 {
-    return data_set_.api_info.GetApiName();
+    return RraContextApiInfoGetApiName(RraContextGetDefault());
 }
 
 bool RraApiInfoIsVulkan()
 {
-    return data_set_.api_info.IsVulkan();
+    return RraContextApiInfoIsVulkan(RraContextGetDefault());
 }
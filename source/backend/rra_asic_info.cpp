@@ -7,31 +7,29 @@
 
 #include "public/rra_asic_info.h"
 
+#include "rra_context.h"
 #include "rra_data_set.h"
 #include "bvh/encoded_rt_ip_11_top_level_bvh.h"
 #include "rra_tlas_impl.h"
 
-// External reference to the global dataset.
-extern RraDataSet data_set_;
-
-const char* RraAsicInfoGetDeviceName()
+const char* RraContextAsicInfoGetDeviceName(RraContext* context)
 {
-    return data_set_.asic_info.GetDeviceName();
+    return context->data_set.asic_info.GetDeviceName();
 }
 
-RraErrorCode RraAsicInfoGetDeviceID(int32_t* device_id)
+RraErrorCode RraContextAsicInfoGetDeviceID(RraContext* context, int32_t* device_id)
 {
-    return data_set_.asic_info.GetDeviceID(device_id);
+    return context->data_set.asic_info.GetDeviceID(device_id);
 }
 
-RraErrorCode RraAsicInfoGetDeviceRevisionID(int32_t* device_revision_id)
+RraErrorCode RraContextAsicInfoGetDeviceRevisionID(RraContext* context, int32_t* device_revision_id)
 {
-    return data_set_.asic_info.GetDeviceRevisionID(device_revision_id);
+    return context->data_set.asic_info.GetDeviceRevisionID(device_revision_id);
 }
 
-RraErrorCode RraAsicInfoGetShaderCoreClockFrequency(uint64_t* out_clk_frequency)
+RraErrorCode RraContextAsicInfoGetShaderCoreClockFrequency(RraContext* context, uint64_t* out_clk_frequency)
 {
-    RraErrorCode result = data_set_.asic_info.GetShaderCoreClockFrequency(out_clk_frequency);
+    RraErrorCode result = context->data_set.asic_info.GetShaderCoreClockFrequency(out_clk_frequency);
     if (result == kRraOk)
     {
         *out_clk_frequency /= 1000000;
@@ -39,9 +37,9 @@ RraErrorCode RraAsicInfoGetShaderCoreClockFrequency(uint64_t* out_clk_frequency)
     return result;
 }
 
-RraErrorCode RraAsicInfoGetMaxShaderCoreClockFrequency(uint64_t* out_clk_frequency)
+RraErrorCode RraContextAsicInfoGetMaxShaderCoreClockFrequency(RraContext* context, uint64_t* out_clk_frequency)
 {
-    RraErrorCode result = data_set_.asic_info.GetMaxShaderCoreClockFrequency(out_clk_frequency);
+    RraErrorCode result = context->data_set.asic_info.GetMaxShaderCoreClockFrequency(out_clk_frequency);
     if (result == kRraOk)
     {
         *out_clk_frequency /= 1000000;
@@ -49,14 +47,14 @@ RraErrorCode RraAsicInfoGetMaxShaderCoreClockFrequency(uint64_t* out_clk_frequen
     return result;
 }
 
-RraErrorCode RraAsicInfoGetVRAMSize(int64_t* out_vram_size)
+RraErrorCode RraContextAsicInfoGetVRAMSize(RraContext* context, int64_t* out_vram_size)
 {
-    return data_set_.asic_info.GetVRAMSize(out_vram_size);
+    return context->data_set.asic_info.GetVRAMSize(out_vram_size);
 }
 
-RraErrorCode RraAsicInfoGetMemoryClockFrequency(uint64_t* out_clk_frequency)
+RraErrorCode RraContextAsicInfoGetMemoryClockFrequency(RraContext* context, uint64_t* out_clk_frequency)
 {
-    RraErrorCode result = data_set_.asic_info.GetMemoryClockFrequency(out_clk_frequency);
+    RraErrorCode result = context->data_set.asic_info.GetMemoryClockFrequency(out_clk_frequency);
     if (result == kRraOk)
     {
         *out_clk_frequency /= 1000000;
@@ -64,9 +62,9 @@ RraErrorCode RraAsicInfoGetMemoryClockFrequency(uint64_t* out_clk_frequency)
     return result;
 }
 
-RraErrorCode RraAsicInfoGetMaxMemoryClockFrequency(uint64_t* out_clk_frequency)
+RraErrorCode RraContextAsicInfoGetMaxMemoryClockFrequency(RraContext* context, uint64_t* out_clk_frequency)
 {
-    RraErrorCode result = data_set_.asic_info.GetMaxMemoryClockFrequency(out_clk_frequency);
+    RraErrorCode result = context->data_set.asic_info.GetMaxMemoryClockFrequency(out_clk_frequency);
     if (result == kRraOk)
     {
         *out_clk_frequency /= 1000000;
@@ -74,24 +72,24 @@ RraErrorCode RraAsicInfoGetMaxMemoryClockFrequency(uint64_t* out_clk_frequency)
     return result;
 }
 
-RraErrorCode RraAsicInfoGetVideoMemoryBandwidth(uint64_t* out_memory_bandwidth)
+RraErrorCode RraContextAsicInfoGetVideoMemoryBandwidth(RraContext* context, uint64_t* out_memory_bandwidth)
 {
-    return data_set_.asic_info.GetVideoMemoryBandwidth(out_memory_bandwidth);
+    return context->data_set.asic_info.GetVideoMemoryBandwidth(out_memory_bandwidth);
 }
 
-const char* RraAsicInfoGetVideoMemoryType()
+const char* RraContextAsicInfoGetVideoMemoryType(RraContext* context)
 {
-    return data_set_.asic_info.GetVideoMemoryType();
+    return context->data_set.asic_info.GetVideoMemoryType();
 }
 
-RraErrorCode RraAsicInfoGetVideoMemoryBusWidth(int32_t* out_bus_width)
+RraErrorCode RraContextAsicInfoGetVideoMemoryBusWidth(RraContext* context, int32_t* out_bus_width)
 {
-    return data_set_.asic_info.GetVideoMemoryBusWidth(out_bus_width);
+    return context->data_set.asic_info.GetVideoMemoryBusWidth(out_bus_width);
 }
 
-RraErrorCode RraAsicInfoGetRaytracingVersion(uint16_t* out_version_major, uint16_t* out_version_minor)
+RraErrorCode RraContextAsicInfoGetRaytracingVersion(RraContext* context, uint16_t* out_version_major, uint16_t* out_version_minor)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(0);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, 0);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -105,3 +103,63 @@ RraErrorCode RraAsicInfoGetRaytracingVersion(uint16_t* out_version_major, uint16
 
     return kRraOk;
 }
+
+const char* RraAsicInfoGetDeviceName()
+{
+    return RraContextAsicInfoGetDeviceName(RraContextGetDefault());
+}
+
+RraErrorCode RraAsicInfoGetDeviceID(int32_t* device_id)
+{
+    return RraContextAsicInfoGetDeviceID(RraContextGetDefault(), device_id);
+}
+
+RraErrorCode RraAsicInfoGetDeviceRevisionID(int32_t* device_revision_id)
+{
+    return RraContextAsicInfoGetDeviceRevisionID(RraContextGetDefault(), device_revision_id);
+}
+
+RraErrorCode RraAsicInfoGetShaderCoreClockFrequency(uint64_t* out_clk_frequency)
+{
+    return RraContextAsicInfoGetShaderCoreClockFrequency(RraContextGetDefault(), out_clk_frequency);
+}
+
+RraErrorCode RraAsicInfoGetMaxShaderCoreClockFrequency(uint64_t* out_clk_frequency)
+{
+    return RraContextAsicInfoGetMaxShaderCoreClockFrequency(RraContextGetDefault(), out_clk_frequency);
+}
+
+RraErrorCode RraAsicInfoGetVRAMSize(int64_t* out_vram_size)
+{
+    return RraContextAsicInfoGetVRAMSize(RraContextGetDefault(), out_vram_size);
+}
+
+RraErrorCode RraAsicInfoGetMemoryClockFrequency(uint64_t* out_clk_frequency)
+{
+    return RraContextAsicInfoGetMemoryClockFrequency(RraContextGetDefault(), out_clk_frequency);
+}
+
+RraErrorCode RraAsicInfoGetMaxMemoryClockFrequency(uint64_t* out_clk_frequency)
+{
+    return RraContextAsicInfoGetMaxMemoryClockFrequency(RraContextGetDefault(), out_clk_frequency);
+}
+
+RraErrorCode RraAsicInfoGetVideoMemoryBandwidth(uint64_t* out_memory_bandwidth)
+{
+    return RraContextAsicInfoGetVideoMemoryBandwidth(RraContextGetDefault(), out_memory_bandwidth);
+}
+
+const char* RraAsicInfoGetVideoMemoryType()
+{
+    return RraContextAsicInfoGetVideoMemoryType(RraContextGetDefault());
+}
+
+RraErrorCode RraAsicInfoGetVideoMemoryBusWidth(int32_t* out_bus_width)
+{
+    return RraContextAsicInfoGetVideoMemoryBusWidth(RraContextGetDefault(), out_bus_width);
+}
+
+RraErrorCode RraAsicInfoGetRaytracingVersion(uint16_t* out_version_major, uint16_t* out_version_minor)
+{
+    return RraContextAsicInfoGetRaytracingVersion(RraContextGetDefault(), out_version_major, out_version_minor);
+}
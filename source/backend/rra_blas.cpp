@@ -11,16 +11,16 @@
 
 #include <math.h>  // for sqrt
 
+#include <algorithm>
+
 #include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
 #include "bvh/flags_util.h"
 #include "public/rra_assert.h"
 #include "rra_bvh_impl.h"
+#include "rra_context.h"
 #include "rra_data_set.h"
 #include "surface_area_heuristic.h"
 
-// External reference to the global dataset.
-extern RraDataSet data_set_;
-
 /// @brief Private function to get the length of a vector, given 2 3D points.
 ///
 /// @param vert_1 The first vertex.
@@ -39,10 +39,10 @@ static float GetLength(const dxr::amd::Float3& vert_1, const dxr::amd::Float3& v
     return sqrt(x_squared + y_squared + z_squared);
 }
 
-rta::EncodedRtIp11BottomLevelBvh* RraBlasGetBlasFromBlasIndex(uint64_t blas_index)
+rta::EncodedRtIp11BottomLevelBvh* RraBlasGetBlasFromBlasIndex(RraContext* context, uint64_t blas_index)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    const auto& bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    const auto& bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     if (blas_index >= bottom_level_bvhs.size())
     {
         return nullptr;
@@ -50,9 +50,9 @@ rta::EncodedRtIp11BottomLevelBvh* RraBlasGetBlasFromBlasIndex(uint64_t blas_inde
     return dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
 }
 
-RraErrorCode RraBlasGetBaseAddress(uint64_t blas_index, uint64_t* out_address)
+RraErrorCode RraContextBlasGetBaseAddress(RraContext* context, uint64_t blas_index, uint64_t* out_address)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -62,9 +62,9 @@ RraErrorCode RraBlasGetBaseAddress(uint64_t blas_index, uint64_t* out_address)
     return kRraOk;
 }
 
-bool RraBlasIsEmpty(uint64_t blas_index)
+bool RraContextBlasIsEmpty(RraContext* context, uint64_t blas_index)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return true;
@@ -73,23 +73,23 @@ bool RraBlasIsEmpty(uint64_t blas_index)
     return blas->IsEmpty();
 }
 
-RraErrorCode RraBlasGetTotalNodeCount(uint64_t blas_index, uint64_t* out_node_count)
+RraErrorCode RraContextBlasGetTotalNodeCount(RraContext* context, uint64_t blas_index, uint64_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const auto& blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     *out_node_count  = blas->GetNodeCount(rta::BvhNodeFlags::kNone);
 
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetChildNodeCount(uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_count)
+RraErrorCode RraContextBlasGetChildNodeCount(RraContext* context, uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_count)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -97,9 +97,9 @@ RraErrorCode RraBlasGetChildNodeCount(uint64_t blas_index, uint32_t parent_node,
     return RraBvhGetChildNodeCount(blas, parent_node, out_child_count);
 }
 
-RraErrorCode RraBlasGetChildNodes(uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_nodes)
+RraErrorCode RraContextBlasGetChildNodes(RraContext* context, uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_nodes)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -107,15 +107,15 @@ RraErrorCode RraBlasGetChildNodes(uint64_t blas_index, uint32_t parent_node, uin
     return RraBvhGetChildNodes(blas, parent_node, out_child_nodes);
 }
 
-RraErrorCode RraBlasGetBoxNodeCount(uint64_t blas_index, uint64_t* out_node_count)
+RraErrorCode RraContextBlasGetBoxNodeCount(RraContext* context, uint64_t blas_index, uint64_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const auto& blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -126,15 +126,15 @@ RraErrorCode RraBlasGetBoxNodeCount(uint64_t blas_index, uint64_t* out_node_coun
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetBox16NodeCount(uint64_t blas_index, uint32_t* out_node_count)
+RraErrorCode RraContextBlasGetBox16NodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const auto& blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -145,15 +145,15 @@ RraErrorCode RraBlasGetBox16NodeCount(uint64_t blas_index, uint32_t* out_node_co
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetBox32NodeCount(uint64_t blas_index, uint32_t* out_node_count)
+RraErrorCode RraContextBlasGetBox32NodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const auto& blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -164,15 +164,15 @@ RraErrorCode RraBlasGetBox32NodeCount(uint64_t blas_index, uint32_t* out_node_co
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetHalfBox32NodeCount(uint64_t blas_index, uint32_t* out_node_count)
+RraErrorCode RraContextBlasGetHalfBox32NodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const auto& blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -183,15 +183,15 @@ RraErrorCode RraBlasGetHalfBox32NodeCount(uint64_t blas_index, uint32_t* out_nod
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetMaxTreeDepth(uint64_t blas_index, uint32_t* out_tree_depth)
+RraErrorCode RraContextBlasGetMaxTreeDepth(RraContext* context, uint64_t blas_index, uint32_t* out_tree_depth)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const auto& blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -202,15 +202,15 @@ RraErrorCode RraBlasGetMaxTreeDepth(uint64_t blas_index, uint32_t* out_tree_dept
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetAvgTreeDepth(uint64_t blas_index, uint32_t* out_tree_depth)
+RraErrorCode RraContextBlasGetAvgTreeDepth(RraContext* context, uint64_t blas_index, uint32_t* out_tree_depth)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const auto& blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -221,9 +221,9 @@ RraErrorCode RraBlasGetAvgTreeDepth(uint64_t blas_index, uint32_t* out_tree_dept
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetChildNodePtr(uint64_t blas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr)
+RraErrorCode RraContextBlasGetChildNodePtr(RraContext* context, uint64_t blas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -231,9 +231,9 @@ RraErrorCode RraBlasGetChildNodePtr(uint64_t blas_index, uint32_t parent_node, u
     return RraBvhGetChildNodePtr(blas, parent_node, child_index, out_node_ptr);
 }
 
-RraErrorCode RraBlasGetNodeBaseAddress(uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address)
+RraErrorCode RraContextBlasGetNodeBaseAddress(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -246,9 +246,9 @@ RraErrorCode RraBlasGetNodeBaseAddress(uint64_t blas_index, uint32_t node_ptr, u
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetNodeParentBaseAddress(uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address)
+RraErrorCode RraContextBlasGetNodeParentBaseAddress(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -262,23 +262,33 @@ RraErrorCode RraBlasGetNodeParentBaseAddress(uint64_t blas_index, uint32_t node_
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetSurfaceArea(uint64_t blas_index, uint32_t node_ptr, float* out_surface_area)
+RraErrorCode RraContextBlasGetNodeParent(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr)
+{
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+    return RraBvhGetParentNodePtr(blas, node_ptr, out_parent_node_ptr);
+}
+
+RraErrorCode RraContextBlasGetSurfaceArea(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_surface_area)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    return RraBlasGetSurfaceAreaImpl(blas, reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr), out_surface_area);
+    return RraBlasGetSurfaceAreaImpl(context, blas, reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr), out_surface_area);
 }
 
-RraErrorCode RraBlasGetSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, float* out_surface_area_heuristic)
+RraErrorCode RraContextBlasGetSurfaceAreaHeuristic(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_surface_area_heuristic)
 {
     uint32_t tri_count{};
-    RraBlasGetNodeTriangleCount(blas_index, node_ptr, &tri_count);
+    RraContextBlasGetNodeTriangleCount(context, blas_index, node_ptr, &tri_count);
 
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -324,7 +334,10 @@ float RraBlasGetTriangleSurfaceArea(const dxr::amd::TriangleNode& triangle_node,
     return surface_area;
 }
 
-RraErrorCode RraBlasGetSurfaceAreaImpl(const rta::EncodedRtIp11BottomLevelBvh* blas, const dxr::amd::NodePointer* node_ptr, float* out_surface_area)
+RraErrorCode RraBlasGetSurfaceAreaImpl(RraContext*                             context,
+                                       const rta::EncodedRtIp11BottomLevelBvh* blas,
+                                       const dxr::amd::NodePointer*            node_ptr,
+                                       float*                                  out_surface_area)
 {
     if (node_ptr->IsTriangleNode())
     {
@@ -342,7 +355,7 @@ RraErrorCode RraBlasGetSurfaceAreaImpl(const rta::EncodedRtIp11BottomLevelBvh* b
 #endif  // DEBUG
 
         uint32_t tri_count{};
-        RraBlasGetNodeTriangleCount(blas->GetID(), triangle_node->GetTriangleId(), &tri_count);
+        RraContextBlasGetNodeTriangleCount(context, blas->GetID(), triangle_node->GetTriangleId(), &tri_count);
 
         *out_surface_area = RraBlasGetTriangleSurfaceArea(*triangle_node, tri_count);
         return kRraOk;
@@ -354,15 +367,19 @@ RraErrorCode RraBlasGetSurfaceAreaImpl(const rta::EncodedRtIp11BottomLevelBvh* b
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetMinimumSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, bool tri_only, float* out_min_surface_area_heuristic)
+RraErrorCode RraContextBlasGetMinimumSurfaceAreaHeuristic(RraContext* context,
+                                                          uint64_t    blas_index,
+                                                          uint32_t    node_ptr,
+                                                          bool        tri_only,
+                                                          float*      out_min_surface_area_heuristic)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    if (RraBlasIsEmpty(blas_index))
+    if (RraContextBlasIsEmpty(context, blas_index))
     {
         *out_min_surface_area_heuristic = 0.0f;
         return kRraOk;
@@ -374,15 +391,19 @@ RraErrorCode RraBlasGetMinimumSurfaceAreaHeuristic(uint64_t blas_index, uint32_t
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetAverageSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, bool tri_only, float* out_avg_surface_area_heuristic)
+RraErrorCode RraContextBlasGetAverageSurfaceAreaHeuristic(RraContext* context,
+                                                          uint64_t    blas_index,
+                                                          uint32_t    node_ptr,
+                                                          bool        tri_only,
+                                                          float*      out_avg_surface_area_heuristic)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    if (RraBlasIsEmpty(blas_index))
+    if (RraContextBlasIsEmpty(context, blas_index))
     {
         *out_avg_surface_area_heuristic = 0.0f;
         return kRraOk;
@@ -394,9 +415,9 @@ RraErrorCode RraBlasGetAverageSurfaceAreaHeuristic(uint64_t blas_index, uint32_t
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetTriangleSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, float* out_tri_surface_area_heuristic)
+RraErrorCode RraContextBlasGetTriangleSurfaceAreaHeuristic(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_tri_surface_area_heuristic)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -408,9 +429,52 @@ RraErrorCode RraBlasGetTriangleSurfaceAreaHeuristic(uint64_t blas_index, uint32_
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetUniqueTriangleCount(uint64_t blas_index, uint32_t* out_triangle_count)
+RraErrorCode RraContextBlasGetSiblingOverlap(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume)
+{
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    const dxr::amd::NodePointer* current_node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
+    return RraBvhGetSiblingOverlap(blas, *current_node, out_overlap_area, out_overlap_volume);
+}
+
+RraErrorCode RraContextBlasGetLeafTightness(RraContext* context, uint64_t blas_index, uint32_t node_ptr, float* out_leaf_tightness)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    RRA_RETURN_ON_ERROR(out_leaf_tightness != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    const dxr::amd::NodePointer* current_node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
+    if (current_node->IsInvalid() || !current_node->IsTriangleNode())
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_leaf_tightness = blas->GetLeafNodeTightness(*current_node);
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetOverlapStats(RraContext* context, uint64_t blas_index, RraBvhOverlapStats* out_stats)
+{
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    return RraBvhGetOverlapStats(blas, out_stats);
+}
+
+RraErrorCode RraContextBlasGetUniqueTriangleCount(RraContext* context, uint64_t blas_index, uint32_t* out_triangle_count)
+{
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
 
     if (blas == nullptr)
     {
@@ -437,9 +501,9 @@ RraErrorCode RraBlasGetUniqueTriangleCount(uint64_t blas_index, uint32_t* out_tr
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetTriangleNodeCount(uint64_t blas_index, uint32_t* out_triangle_count)
+RraErrorCode RraContextBlasGetTriangleNodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_triangle_count)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
 
     if (blas == nullptr)
     {
@@ -458,9 +522,9 @@ RraErrorCode RraBlasGetTriangleNodeCount(uint64_t blas_index, uint32_t* out_tria
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetProceduralNodeCount(uint64_t blas_index, uint32_t* out_procedural_Node_count)
+RraErrorCode RraContextBlasGetProceduralNodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_procedural_Node_count)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
 
     if (blas == nullptr)
     {
@@ -479,9 +543,9 @@ RraErrorCode RraBlasGetProceduralNodeCount(uint64_t blas_index, uint32_t* out_pr
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetGeometryIndex(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_geometry_index)
+RraErrorCode RraContextBlasGetGeometryIndex(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_geometry_index)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
 
     if (blas == nullptr)
     {
@@ -515,9 +579,9 @@ RraErrorCode RraBlasGetGeometryIndex(uint64_t blas_index, uint32_t node_ptr, uin
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetGeometryFlags(uint64_t blas_index, uint32_t geometry_index, uint32_t* out_geometry_flags)
+RraErrorCode RraContextBlasGetGeometryFlags(RraContext* context, uint64_t blas_index, uint32_t geometry_index, uint32_t* out_geometry_flags)
 {
-    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
 
     if (blas == nullptr)
     {
@@ -548,9 +612,9 @@ RraErrorCode RraBlasGetGeometryFlags(uint64_t blas_index, uint32_t geometry_inde
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetIsInactive(uint64_t blas_index, uint32_t node_ptr, bool* out_is_inactive)
+RraErrorCode RraContextBlasGetIsInactive(RraContext* context, uint64_t blas_index, uint32_t node_ptr, bool* out_is_inactive)
 {
-    const auto&                             bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    const auto&                             bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     const rta::EncodedRtIp11BottomLevelBvh* blas              = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
     if (blas == nullptr)
     {
@@ -588,16 +652,16 @@ RraErrorCode RraBlasGetIsInactive(uint64_t blas_index, uint32_t node_ptr, bool*
     return kRraErrorInvalidChildNode;
 }
 
-RraErrorCode RraBlasGetNodeTriangleCount(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_triangle_count)
+RraErrorCode RraContextBlasGetNodeTriangleCount(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_triangle_count)
 {
-    const auto&                             bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    const auto&                             bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     const rta::EncodedRtIp11BottomLevelBvh* blas              = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    if (RraBlasIsEmpty(blas_index))
+    if (RraContextBlasIsEmpty(context, blas_index))
     {
         *out_triangle_count = 0;
         return kRraOk;
@@ -626,9 +690,9 @@ RraErrorCode RraBlasGetNodeTriangleCount(uint64_t blas_index, uint32_t node_ptr,
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetNodeTriangles(uint64_t blas_index, uint32_t node_ptr, TriangleVertices* out_triangles)
+RraErrorCode RraContextBlasGetNodeTriangles(RraContext* context, uint64_t blas_index, uint32_t node_ptr, TriangleVertices* out_triangles)
 {
-    const auto&                             bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    const auto&                             bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     const rta::EncodedRtIp11BottomLevelBvh* blas              = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
     if (blas == nullptr)
     {
@@ -678,9 +742,9 @@ RraErrorCode RraBlasGetNodeTriangles(uint64_t blas_index, uint32_t node_ptr, Tri
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetNodeVertices(uint64_t blas_index, uint32_t node_ptr, struct VertexPosition* out_vertices)
+RraErrorCode RraContextBlasGetNodeVertices(RraContext* context, uint64_t blas_index, uint32_t node_ptr, struct VertexPosition* out_vertices)
 {
-    const auto&                             bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    const auto&                             bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     const rta::EncodedRtIp11BottomLevelBvh* blas              = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
     if (blas == nullptr)
     {
@@ -720,9 +784,9 @@ RraErrorCode RraBlasGetNodeVertices(uint64_t blas_index, uint32_t node_ptr, stru
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetPrimitiveIndex(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_primitive_index)
+RraErrorCode RraContextBlasGetPrimitiveIndex(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_primitive_index)
 {
-    const auto&                             bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    const auto&                             bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     const rta::EncodedRtIp11BottomLevelBvh* blas              = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
     if (blas == nullptr)
     {
@@ -762,9 +826,9 @@ RraErrorCode RraBlasGetPrimitiveIndex(uint64_t blas_index, uint32_t node_ptr, ui
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetBoundingVolumeExtents(uint64_t blas_index, uint32_t node_ptr, BoundingVolumeExtents* out_extents)
+RraErrorCode RraContextBlasGetBoundingVolumeExtents(RraContext* context, uint64_t blas_index, uint32_t node_ptr, BoundingVolumeExtents* out_extents)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -789,9 +853,9 @@ RraErrorCode RraBlasGetBoundingVolumeExtents(uint64_t blas_index, uint32_t node_
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetBuildFlags(uint64_t blas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags)
+RraErrorCode RraContextBlasGetBuildFlags(RraContext* context, uint64_t blas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -806,9 +870,9 @@ RraErrorCode RraBlasGetBuildFlags(uint64_t blas_index, VkBuildAccelerationStruct
     return kRraOk;
 }
 
-RraErrorCode RraBlasGetSizeInBytes(uint64_t blas_index, uint32_t* out_size_in_bytes)
+RraErrorCode RraContextBlasGetSizeInBytes(RraContext* context, uint64_t blas_index, uint32_t* out_size_in_bytes)
 {
-    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(blas_index);
+    const rta::IEncodedRtIp11Bvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
     if (blas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -817,3 +881,393 @@ RraErrorCode RraBlasGetSizeInBytes(uint64_t blas_index, uint32_t* out_size_in_by
     *out_size_in_bytes = blas->GetHeader().GetFileSize();
     return kRraOk;
 }
+
+RraErrorCode RraContextBlasGetContentHash(RraContext* context, uint64_t blas_index, uint64_t* out_content_hash)
+{
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_content_hash = blas->GetContentHash();
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetGeometryHash(RraContext* context, uint64_t blas_index, uint64_t* out_geometry_hash)
+{
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_geometry_hash = blas->GetGeometryHash();
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetDuplicateOf(RraContext* context, uint64_t blas_index, uint64_t* out_blas_index)
+{
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_blas_index = blas->GetDuplicateOf();
+    return kRraOk;
+}
+
+/// @brief Copy the triangle problem counts to the public structure.
+///
+/// @param [in]  counts     The counts.
+/// @param [out] out_counts The public counts.
+static void CopyTriangleIssueCounts(const rta::TriangleIssueCounts& counts, RraTriangleIssueCounts* out_counts)
+{
+    out_counts->triangle_count         = counts.triangle_count;
+    out_counts->zero_area_count        = counts.zero_area_count;
+    out_counts->sliver_count           = counts.sliver_count;
+    out_counts->non_finite_count       = counts.non_finite_count;
+    out_counts->duplicate_count        = counts.duplicate_count;
+    out_counts->outside_parent_count   = counts.outside_parent_count;
+    out_counts->problem_triangle_count = counts.problem_triangle_count;
+}
+
+static_assert(static_cast<int>(kRraTriangleIssueZeroArea) == static_cast<int>(rta::kTriangleIssueZeroArea), "Triangle issue flags don't match.");
+static_assert(static_cast<int>(kRraTriangleIssueSliver) == static_cast<int>(rta::kTriangleIssueSliver), "Triangle issue flags don't match.");
+static_assert(static_cast<int>(kRraTriangleIssueNonFinite) == static_cast<int>(rta::kTriangleIssueNonFinite), "Triangle issue flags don't match.");
+static_assert(static_cast<int>(kRraTriangleIssueDuplicate) == static_cast<int>(rta::kTriangleIssueDuplicate), "Triangle issue flags don't match.");
+static_assert(static_cast<int>(kRraTriangleIssueOutsideParent) == static_cast<int>(rta::kTriangleIssueOutsideParent), "Triangle issue flags don't match.");
+
+RraErrorCode RraContextBlasGetGeometryCount(RraContext* context, uint64_t blas_index, uint32_t* out_geometry_count)
+{
+    RRA_RETURN_ON_ERROR(out_geometry_count != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_geometry_count = static_cast<uint32_t>(blas->GetGeometryInfos().size());
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetTriangleIssueFlags(RraContext* context, uint64_t blas_index, uint32_t node_ptr, uint32_t* out_issue_flags)
+{
+    RRA_RETURN_ON_ERROR(out_issue_flags != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    const dxr::amd::NodePointer* current_node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
+    if (current_node->IsInvalid() || !current_node->IsTriangleNode())
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_issue_flags = blas->GetLeafNodeIssueFlags(*current_node);
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetTriangleIssueCounts(RraContext* context, uint64_t blas_index, RraTriangleIssueCounts* out_counts)
+{
+    RRA_RETURN_ON_ERROR(out_counts != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    CopyTriangleIssueCounts(blas->GetTriangleIssueCounts(), out_counts);
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetGeometryTriangleIssueCounts(RraContext* context, uint64_t blas_index, uint32_t geometry_index, RraTriangleIssueCounts* out_counts)
+{
+    RRA_RETURN_ON_ERROR(out_counts != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    // A geometry with no triangles may be missing from the end of the list, so treat it as having no problems.
+    const auto& geometry_counts = blas->GetGeometryTriangleIssueCounts();
+    RRA_RETURN_ON_ERROR(geometry_index < std::max(geometry_counts.size(), blas->GetGeometryInfos().size()), kRraErrorIndexOutOfRange);
+
+    CopyTriangleIssueCounts((geometry_index < geometry_counts.size()) ? geometry_counts[geometry_index] : rta::TriangleIssueCounts{}, out_counts);
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetProblemTriangleNodeCount(RraContext* context, uint64_t blas_index, uint32_t* out_node_count)
+{
+    RRA_RETURN_ON_ERROR(out_node_count != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_node_count = 0;
+    for (const auto& node_ptr : blas->GetLeafNodes())
+    {
+        if (node_ptr.IsTriangleNode() && blas->GetLeafNodeIssueFlags(node_ptr) != rta::kTriangleIssueNone)
+        {
+            (*out_node_count)++;
+        }
+    }
+    return kRraOk;
+}
+
+RraErrorCode RraContextBlasGetProblemTriangleNodes(RraContext* context, uint64_t blas_index, uint32_t* out_node_ptrs)
+{
+    RRA_RETURN_ON_ERROR(out_node_ptrs != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    if (blas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    uint32_t node_index = 0;
+    for (const auto& node_ptr : blas->GetLeafNodes())
+    {
+        if (node_ptr.IsTriangleNode() && blas->GetLeafNodeIssueFlags(node_ptr) != rta::kTriangleIssueNone)
+        {
+            out_node_ptrs[node_index++] = node_ptr.GetRawPointer();
+        }
+    }
+    return kRraOk;
+}
+
+RraErrorCode RraBlasGetBaseAddress(uint64_t blas_index, uint64_t* out_address)
+{
+    return RraContextBlasGetBaseAddress(RraContextGetDefault(), blas_index, out_address);
+}
+
+bool RraBlasIsEmpty(uint64_t blas_index)
+{
+    return RraContextBlasIsEmpty(RraContextGetDefault(), blas_index);
+}
+
+RraErrorCode RraBlasGetTotalNodeCount(uint64_t blas_index, uint64_t* out_node_count)
+{
+    return RraContextBlasGetTotalNodeCount(RraContextGetDefault(), blas_index, out_node_count);
+}
+
+RraErrorCode RraBlasGetChildNodeCount(uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_count)
+{
+    return RraContextBlasGetChildNodeCount(RraContextGetDefault(), blas_index, parent_node, out_child_count);
+}
+
+RraErrorCode RraBlasGetChildNodes(uint64_t blas_index, uint32_t parent_node, uint32_t* out_child_nodes)
+{
+    return RraContextBlasGetChildNodes(RraContextGetDefault(), blas_index, parent_node, out_child_nodes);
+}
+
+RraErrorCode RraBlasGetBoxNodeCount(uint64_t blas_index, uint64_t* out_node_count)
+{
+    return RraContextBlasGetBoxNodeCount(RraContextGetDefault(), blas_index, out_node_count);
+}
+
+RraErrorCode RraBlasGetBox16NodeCount(uint64_t blas_index, uint32_t* out_node_count)
+{
+    return RraContextBlasGetBox16NodeCount(RraContextGetDefault(), blas_index, out_node_count);
+}
+
+RraErrorCode RraBlasGetBox32NodeCount(uint64_t blas_index, uint32_t* out_node_count)
+{
+    return RraContextBlasGetBox32NodeCount(RraContextGetDefault(), blas_index, out_node_count);
+}
+
+RraErrorCode RraBlasGetHalfBox32NodeCount(uint64_t blas_index, uint32_t* out_node_count)
+{
+    return RraContextBlasGetHalfBox32NodeCount(RraContextGetDefault(), blas_index, out_node_count);
+}
+
+RraErrorCode RraBlasGetMaxTreeDepth(uint64_t blas_index, uint32_t* out_tree_depth)
+{
+    return RraContextBlasGetMaxTreeDepth(RraContextGetDefault(), blas_index, out_tree_depth);
+}
+
+RraErrorCode RraBlasGetAvgTreeDepth(uint64_t blas_index, uint32_t* out_tree_depth)
+{
+    return RraContextBlasGetAvgTreeDepth(RraContextGetDefault(), blas_index, out_tree_depth);
+}
+
+RraErrorCode RraBlasGetChildNodePtr(uint64_t blas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr)
+{
+    return RraContextBlasGetChildNodePtr(RraContextGetDefault(), blas_index, parent_node, child_index, out_node_ptr);
+}
+
+RraErrorCode RraBlasGetNodeBaseAddress(uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address)
+{
+    return RraContextBlasGetNodeBaseAddress(RraContextGetDefault(), blas_index, node_ptr, out_address);
+}
+
+RraErrorCode RraBlasGetNodeParentBaseAddress(uint64_t blas_index, uint32_t node_ptr, uint64_t* out_address)
+{
+    return RraContextBlasGetNodeParentBaseAddress(RraContextGetDefault(), blas_index, node_ptr, out_address);
+}
+
+RraErrorCode RraBlasGetNodeParent(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr)
+{
+    return RraContextBlasGetNodeParent(RraContextGetDefault(), blas_index, node_ptr, out_parent_node_ptr);
+}
+
+RraErrorCode RraBlasGetSurfaceArea(uint64_t blas_index, uint32_t node_ptr, float* out_surface_area)
+{
+    return RraContextBlasGetSurfaceArea(RraContextGetDefault(), blas_index, node_ptr, out_surface_area);
+}
+
+RraErrorCode RraBlasGetSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, float* out_surface_area_heuristic)
+{
+    return RraContextBlasGetSurfaceAreaHeuristic(RraContextGetDefault(), blas_index, node_ptr, out_surface_area_heuristic);
+}
+
+RraErrorCode RraBlasGetMinimumSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, bool tri_only, float* out_min_surface_area_heuristic)
+{
+    return RraContextBlasGetMinimumSurfaceAreaHeuristic(RraContextGetDefault(), blas_index, node_ptr, tri_only, out_min_surface_area_heuristic);
+}
+
+RraErrorCode RraBlasGetAverageSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, bool tri_only, float* out_avg_surface_area_heuristic)
+{
+    return RraContextBlasGetAverageSurfaceAreaHeuristic(RraContextGetDefault(), blas_index, node_ptr, tri_only, out_avg_surface_area_heuristic);
+}
+
+RraErrorCode RraBlasGetTriangleSurfaceAreaHeuristic(uint64_t blas_index, uint32_t node_ptr, float* out_tri_surface_area_heuristic)
+{
+    return RraContextBlasGetTriangleSurfaceAreaHeuristic(RraContextGetDefault(), blas_index, node_ptr, out_tri_surface_area_heuristic);
+}
+
+RraErrorCode RraBlasGetSiblingOverlap(uint64_t blas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume)
+{
+    return RraContextBlasGetSiblingOverlap(RraContextGetDefault(), blas_index, node_ptr, out_overlap_area, out_overlap_volume);
+}
+
+RraErrorCode RraBlasGetLeafTightness(uint64_t blas_index, uint32_t node_ptr, float* out_leaf_tightness)
+{
+    return RraContextBlasGetLeafTightness(RraContextGetDefault(), blas_index, node_ptr, out_leaf_tightness);
+}
+
+RraErrorCode RraBlasGetOverlapStats(uint64_t blas_index, RraBvhOverlapStats* out_stats)
+{
+    return RraContextBlasGetOverlapStats(RraContextGetDefault(), blas_index, out_stats);
+}
+
+RraErrorCode RraBlasGetUniqueTriangleCount(uint64_t blas_index, uint32_t* out_triangle_count)
+{
+    return RraContextBlasGetUniqueTriangleCount(RraContextGetDefault(), blas_index, out_triangle_count);
+}
+
+RraErrorCode RraBlasGetTriangleNodeCount(uint64_t blas_index, uint32_t* out_triangle_count)
+{
+    return RraContextBlasGetTriangleNodeCount(RraContextGetDefault(), blas_index, out_triangle_count);
+}
+
+RraErrorCode RraBlasGetProceduralNodeCount(uint64_t blas_index, uint32_t* out_procedural_Node_count)
+{
+    return RraContextBlasGetProceduralNodeCount(RraContextGetDefault(), blas_index, out_procedural_Node_count);
+}
+
+RraErrorCode RraBlasGetGeometryIndex(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_geometry_index)
+{
+    return RraContextBlasGetGeometryIndex(RraContextGetDefault(), blas_index, node_ptr, out_geometry_index);
+}
+
+RraErrorCode RraBlasGetGeometryFlags(uint64_t blas_index, uint32_t geometry_index, uint32_t* out_geometry_flags)
+{
+    return RraContextBlasGetGeometryFlags(RraContextGetDefault(), blas_index, geometry_index, out_geometry_flags);
+}
+
+RraErrorCode RraBlasGetIsInactive(uint64_t blas_index, uint32_t node_ptr, bool* out_is_inactive)
+{
+    return RraContextBlasGetIsInactive(RraContextGetDefault(), blas_index, node_ptr, out_is_inactive);
+}
+
+RraErrorCode RraBlasGetNodeTriangleCount(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_triangle_count)
+{
+    return RraContextBlasGetNodeTriangleCount(RraContextGetDefault(), blas_index, node_ptr, out_triangle_count);
+}
+
+RraErrorCode RraBlasGetNodeTriangles(uint64_t blas_index, uint32_t node_ptr, TriangleVertices* out_triangles)
+{
+    return RraContextBlasGetNodeTriangles(RraContextGetDefault(), blas_index, node_ptr, out_triangles);
+}
+
+RraErrorCode RraBlasGetNodeVertices(uint64_t blas_index, uint32_t node_ptr, struct VertexPosition* out_vertices)
+{
+    return RraContextBlasGetNodeVertices(RraContextGetDefault(), blas_index, node_ptr, out_vertices);
+}
+
+RraErrorCode RraBlasGetPrimitiveIndex(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_primitive_index)
+{
+    return RraContextBlasGetPrimitiveIndex(RraContextGetDefault(), blas_index, node_ptr, out_primitive_index);
+}
+
+RraErrorCode RraBlasGetBoundingVolumeExtents(uint64_t blas_index, uint32_t node_ptr, BoundingVolumeExtents* out_extents)
+{
+    return RraContextBlasGetBoundingVolumeExtents(RraContextGetDefault(), blas_index, node_ptr, out_extents);
+}
+
+RraErrorCode RraBlasGetBuildFlags(uint64_t blas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags)
+{
+    return RraContextBlasGetBuildFlags(RraContextGetDefault(), blas_index, out_flags);
+}
+
+RraErrorCode RraBlasGetSizeInBytes(uint64_t blas_index, uint32_t* out_size_in_bytes)
+{
+    return RraContextBlasGetSizeInBytes(RraContextGetDefault(), blas_index, out_size_in_bytes);
+}
+
+RraErrorCode RraBlasGetContentHash(uint64_t blas_index, uint64_t* out_content_hash)
+{
+    return RraContextBlasGetContentHash(RraContextGetDefault(), blas_index, out_content_hash);
+}
+
+RraErrorCode RraBlasGetGeometryHash(uint64_t blas_index, uint64_t* out_geometry_hash)
+{
+    return RraContextBlasGetGeometryHash(RraContextGetDefault(), blas_index, out_geometry_hash);
+}
+
+RraErrorCode RraBlasGetDuplicateOf(uint64_t blas_index, uint64_t* out_blas_index)
+{
+    return RraContextBlasGetDuplicateOf(RraContextGetDefault(), blas_index, out_blas_index);
+}
+
+RraErrorCode RraBlasGetGeometryCount(uint64_t blas_index, uint32_t* out_geometry_count)
+{
+    return RraContextBlasGetGeometryCount(RraContextGetDefault(), blas_index, out_geometry_count);
+}
+
+RraErrorCode RraBlasGetTriangleIssueFlags(uint64_t blas_index, uint32_t node_ptr, uint32_t* out_issue_flags)
+{
+    return RraContextBlasGetTriangleIssueFlags(RraContextGetDefault(), blas_index, node_ptr, out_issue_flags);
+}
+
+RraErrorCode RraBlasGetTriangleIssueCounts(uint64_t blas_index, RraTriangleIssueCounts* out_counts)
+{
+    return RraContextBlasGetTriangleIssueCounts(RraContextGetDefault(), blas_index, out_counts);
+}
+
+RraErrorCode RraBlasGetGeometryTriangleIssueCounts(uint64_t blas_index, uint32_t geometry_index, RraTriangleIssueCounts* out_counts)
+{
+    return RraContextBlasGetGeometryTriangleIssueCounts(RraContextGetDefault(), blas_index, geometry_index, out_counts);
+}
+
+RraErrorCode RraBlasGetProblemTriangleNodeCount(uint64_t blas_index, uint32_t* out_node_count)
+{
+    return RraContextBlasGetProblemTriangleNodeCount(RraContextGetDefault(), blas_index, out_node_count);
+}
+
+RraErrorCode RraBlasGetProblemTriangleNodes(uint64_t blas_index, uint32_t* out_node_ptrs)
+{
+    return RraContextBlasGetProblemTriangleNodes(RraContextGetDefault(), blas_index, out_node_ptrs);
+}
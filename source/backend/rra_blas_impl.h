@@ -13,13 +13,15 @@
 #include "bvh/dxr_definitions.h"
 #include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
 #include "public/rra_blas.h"
+#include "rra_context.h"
 
 /// @brief Get a pointer to the BLAS from the blas index passed in.
 ///
+/// @param [in] context           The context holding the loaded trace.
 /// @param [in] blas_index        The index of the BLAS to retrieve.
 ///
 /// @return  A pointer to the TLAS (or nullptr if it doesn't exist).
-rta::EncodedRtIp11BottomLevelBvh* RraBlasGetBlasFromBlasIndex(uint64_t blas_index);
+rta::EncodedRtIp11BottomLevelBvh* RraBlasGetBlasFromBlasIndex(RraContext* context, uint64_t blas_index);
 
 /// @brief Get the surface area for a given triangle node.
 ///
@@ -31,11 +33,15 @@ float RraBlasGetTriangleSurfaceArea(const dxr::amd::TriangleNode& triangle_node,
 
 /// @brief Get the surface area for a given BLAS node.
 ///
+/// @param [in]  context          The context holding the loaded trace.
 /// @param [in]  blas             The bottom level acceleration structure.
 /// @param [in]  node_ptr         The node pointer whose surface area is to be calculated.
 /// @param [out] out_surface_area The calculated surface area.
 ///
 /// @return RraOk if successful, an error code if not.
-RraErrorCode RraBlasGetSurfaceAreaImpl(const rta::EncodedRtIp11BottomLevelBvh* blas, const dxr::amd::NodePointer* node_ptr, float* out_surface_area);
+RraErrorCode RraBlasGetSurfaceAreaImpl(RraContext*                             context,
+                                       const rta::EncodedRtIp11BottomLevelBvh* blas,
+                                       const dxr::amd::NodePointer*            node_ptr,
+                                       float*                                  out_surface_area);
 
 #endif  // RRA_BACKEND_RRA_BLAS_IMPL_H_
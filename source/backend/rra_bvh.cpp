@@ -10,15 +10,15 @@
 #include "rra_bvh_impl.h"
 
 #include <float.h>
+#include <algorithm>
 
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
 #include "bvh/iencoded_rt_ip_11_bvh.h"
 #include "bvh/dxr_definitions.h"
 #include "public/rra_assert.h"
+#include "rra_context.h"
 #include "rra_data_set.h"
 
-// External reference to the global dataset.
-extern RraDataSet data_set_;
-
 RraErrorCode RraBvhGetNodeBoundingVolume(const rta::IEncodedRtIp11Bvh*     bvh,
                                          const dxr::amd::NodePointer*      node_ptr,
                                          dxr::amd::AxisAlignedBoundingBox& out_bounding_box)
@@ -260,6 +260,43 @@ RraErrorCode RraBvhGetSurfaceAreaHeuristic(const rta::IEncodedRtIp11Bvh* bvh, co
     }
 }
 
+RraErrorCode RraBvhGetSiblingOverlap(const rta::IEncodedRtIp11Bvh* bvh, const dxr::amd::NodePointer node_ptr, float* out_overlap_area, float* out_overlap_volume)
+{
+    RRA_RETURN_ON_ERROR(out_overlap_area != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(out_overlap_volume != nullptr, kRraErrorInvalidPointer);
+
+    if (node_ptr.IsInvalid() || !node_ptr.IsBoxNode())
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    if (bvh->IsEmpty())
+    {
+        *out_overlap_area   = 0.0f;
+        *out_overlap_volume = 0.0f;
+        return kRraOk;
+    }
+
+    *out_overlap_area   = bvh->GetInteriorNodeOverlapArea(node_ptr);
+    *out_overlap_volume = bvh->GetInteriorNodeOverlapVolume(node_ptr);
+    return kRraOk;
+}
+
+RraErrorCode RraBvhGetOverlapStats(const rta::IEncodedRtIp11Bvh* bvh, RraBvhOverlapStats* out_stats)
+{
+    static_assert(kRraBvhOverlapHistogramBinCount == rta::kOverlapHistogramBinCount, "Overlap histogram bin counts don't match");
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+
+    const rta::BvhOverlapStats& stats = bvh->GetOverlapStats();
+    out_stats->mean_overlap_area      = stats.mean_overlap_area;
+    out_stats->mean_overlap_volume    = stats.mean_overlap_volume;
+    out_stats->mean_leaf_tightness    = stats.mean_leaf_tightness;
+    std::copy(stats.overlap_area_histogram.begin(), stats.overlap_area_histogram.end(), out_stats->overlap_area_histogram);
+    std::copy(stats.overlap_volume_histogram.begin(), stats.overlap_volume_histogram.end(), out_stats->overlap_volume_histogram);
+    std::copy(stats.leaf_tightness_histogram.begin(), stats.leaf_tightness_histogram.end(), out_stats->leaf_tightness_histogram);
+    return kRraOk;
+}
+
 RraErrorCode RraBvhGetChildNodeCount(const rta::IEncodedRtIp11Bvh* bvh, uint32_t parent_node, uint32_t* out_child_count)
 {
     const auto&            header_offsets = bvh->GetHeader().GetBufferOffsets();
@@ -377,87 +414,154 @@ RraErrorCode RraBvhGetChildNodePtr(const rta::IEncodedRtIp11Bvh* bvh, uint32_t p
     return kRraErrorIndexOutOfRange;
 }
 
-RraErrorCode RraBvhGetTlasCount(uint64_t* out_count)
+RraErrorCode RraBvhGetParentNodePtr(const rta::IEncodedRtIp11Bvh* bvh, uint32_t node_ptr, uint32_t* out_parent_node_ptr)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    uint32_t root_node = UINT32_MAX;
+    RraBvhGetRootNodePtr(&root_node);
+
+    const dxr::amd::NodePointer* node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
+    if (node->IsInvalid() || node_ptr == root_node || bvh->IsEmpty())
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& top_level_bvhs = data_set_.bvh_bundle->GetTopLevelBvhs();
+    const dxr::amd::NodePointer parent_node = bvh->GetParentNode(node);
+    if (parent_node.IsInvalid())
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_parent_node_ptr = parent_node.GetRawPointer();
+    return kRraOk;
+}
+
+RraErrorCode RraContextBvhGetTlasCount(RraContext* context, uint64_t* out_count)
+{
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    const auto& top_level_bvhs = context->data_set.bvh_bundle->GetTopLevelBvhs();
     *out_count                 = top_level_bvhs.size();
 
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetBlasCount(uint64_t* out_count)
+RraErrorCode RraContextBvhGetBlasCount(RraContext* context, uint64_t* out_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    *out_count = data_set_.bvh_bundle->GetBlasCount();
+    *out_count = context->data_set.bvh_bundle->GetBlasCount();
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetTotalBlasCount(uint64_t* out_count)
+RraErrorCode RraContextBvhGetTotalBlasCount(RraContext* context, uint64_t* out_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    *out_count = data_set_.bvh_bundle->GetTotalBlasCount();
+    *out_count = context->data_set.bvh_bundle->GetTotalBlasCount();
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetMissingBlasCount(uint64_t* out_count)
+RraErrorCode RraContextBvhGetMissingBlasCount(RraContext* context, uint64_t* out_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    *out_count = data_set_.bvh_bundle->GetMissingBlasCount();
+    *out_count = context->data_set.bvh_bundle->GetMissingBlasCount();
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetInactiveInstancesCount(uint64_t* out_count)
+RraErrorCode RraContextBvhGetInactiveInstancesCount(RraContext* context, uint64_t* out_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    *out_count = data_set_.bvh_bundle->GetInactiveInstanceCount();
+    *out_count = context->data_set.bvh_bundle->GetInactiveInstanceCount();
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetEmptyBlasCount(uint64_t* out_count)
+RraErrorCode RraContextBvhGetEmptyBlasCount(RraContext* context, uint64_t* out_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    *out_count = data_set_.bvh_bundle->GetEmptyBlasCount();
+    *out_count = context->data_set.bvh_bundle->GetEmptyBlasCount();
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetTotalTlasSizeInBytes(uint64_t* out_size_in_bytes)
+RraErrorCode RraContextBvhGetDuplicateBlasCount(RraContext* context, uint64_t* out_count)
+{
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    uint64_t    count             = 0;
+    const auto& bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
+    for (size_t blas_index = 0; blas_index < bottom_level_bvhs.size(); blas_index++)
+    {
+        const rta::EncodedRtIp11BottomLevelBvh* blas = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
+        if (blas != nullptr && blas->GetDuplicateOf() != blas_index)
+        {
+            count++;
+        }
+    }
+
+    *out_count = count;
+    return kRraOk;
+}
+
+RraErrorCode RraContextBvhGetDuplicateBlasSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes)
+{
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    uint64_t    size              = 0;
+    const auto& bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
+    for (size_t blas_index = 0; blas_index < bottom_level_bvhs.size(); blas_index++)
+    {
+        const rta::EncodedRtIp11BottomLevelBvh* blas = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
+        if (blas != nullptr && blas->GetDuplicateOf() != blas_index)
+        {
+            size += blas->GetHeader().GetFileSize();
+        }
+    }
+
+    *out_size_in_bytes = size;
+    return kRraOk;
+}
+
+RraErrorCode RraContextBvhGetTotalTlasSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes)
 {
     uint64_t tlas_count = 0;
-    if (RraBvhGetTlasCount(&tlas_count) == kRraOk)
+    if (RraContextBvhGetTlasCount(context, &tlas_count) == kRraOk)
     {
-        RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-        const auto& top_level_bvhs = data_set_.bvh_bundle->GetTopLevelBvhs();
+        RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+        const auto& top_level_bvhs = context->data_set.bvh_bundle->GetTopLevelBvhs();
         for (uint64_t tlas_index = 0; tlas_index < tlas_count; tlas_index++)
         {
             const rta::IEncodedRtIp11Bvh* tlas = dynamic_cast<rta::IEncodedRtIp11Bvh*>(&(*top_level_bvhs[tlas_index]));
@@ -470,15 +574,15 @@ RraErrorCode RraBvhGetTotalTlasSizeInBytes(uint64_t* out_size_in_bytes)
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetTotalBlasSizeInBytes(uint64_t* out_size_in_bytes)
+RraErrorCode RraContextBvhGetTotalBlasSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes)
 {
     uint64_t blas_count = 0;
-    if (RraBvhGetBlasCount(&blas_count) == kRraOk)
+    if (RraContextBvhGetBlasCount(context, &blas_count) == kRraOk)
     {
-        RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-        const auto& bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+        RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+        const auto& bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
         uint64_t    offset            = 0;
-        if (data_set_.bvh_bundle->ContainsEmptyPlaceholder())
+        if (context->data_set.bvh_bundle->ContainsEmptyPlaceholder())
         {
             offset = 1;
         }
@@ -494,14 +598,69 @@ RraErrorCode RraBvhGetTotalBlasSizeInBytes(uint64_t* out_size_in_bytes)
     return kRraOk;
 }
 
-RraErrorCode RraBvhGetTotalTraceSizeInBytes(uint64_t* out_size_in_bytes)
+RraErrorCode RraContextBvhGetTotalTraceSizeInBytes(RraContext* context, uint64_t* out_size_in_bytes)
 {
     uint64_t tlas_size{};
-    RraBvhGetTotalTlasSizeInBytes(&tlas_size);
+    RraContextBvhGetTotalTlasSizeInBytes(context, &tlas_size);
 
     uint64_t blas_size{};
-    RraBvhGetTotalBlasSizeInBytes(&blas_size);
+    RraContextBvhGetTotalBlasSizeInBytes(context, &blas_size);
 
     *out_size_in_bytes = tlas_size + blas_size;
     return kRraOk;
 }
+
+RraErrorCode RraBvhGetTlasCount(uint64_t* out_count)
+{
+    return RraContextBvhGetTlasCount(RraContextGetDefault(), out_count);
+}
+
+RraErrorCode RraBvhGetBlasCount(uint64_t* out_count)
+{
+    return RraContextBvhGetBlasCount(RraContextGetDefault(), out_count);
+}
+
+RraErrorCode RraBvhGetTotalBlasCount(uint64_t* out_count)
+{
+    return RraContextBvhGetTotalBlasCount(RraContextGetDefault(), out_count);
+}
+
+RraErrorCode RraBvhGetMissingBlasCount(uint64_t* out_count)
+{
+    return RraContextBvhGetMissingBlasCount(RraContextGetDefault(), out_count);
+}
+
+RraErrorCode RraBvhGetInactiveInstancesCount(uint64_t* out_count)
+{
+    return RraContextBvhGetInactiveInstancesCount(RraContextGetDefault(), out_count);
+}
+
+RraErrorCode RraBvhGetEmptyBlasCount(uint64_t* out_count)
+{
+    return RraContextBvhGetEmptyBlasCount(RraContextGetDefault(), out_count);
+}
+
+RraErrorCode RraBvhGetDuplicateBlasCount(uint64_t* out_count)
+{
+    return RraContextBvhGetDuplicateBlasCount(RraContextGetDefault(), out_count);
+}
+
+RraErrorCode RraBvhGetDuplicateBlasSizeInBytes(uint64_t* out_size_in_bytes)
+{
+    return RraContextBvhGetDuplicateBlasSizeInBytes(RraContextGetDefault(), out_size_in_bytes);
+}
+
+RraErrorCode RraBvhGetTotalTlasSizeInBytes(uint64_t* out_size_in_bytes)
+{
+    return RraContextBvhGetTotalTlasSizeInBytes(RraContextGetDefault(), out_size_in_bytes);
+}
+
+RraErrorCode RraBvhGetTotalBlasSizeInBytes(uint64_t* out_size_in_bytes)
+{
+    return RraContextBvhGetTotalBlasSizeInBytes(RraContextGetDefault(), out_size_in_bytes);
+}
+
+RraErrorCode RraBvhGetTotalTraceSizeInBytes(uint64_t* out_size_in_bytes)
+{
+    return RraContextBvhGetTotalTraceSizeInBytes(RraContextGetDefault(), out_size_in_bytes);
+}
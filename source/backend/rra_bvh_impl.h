@@ -45,6 +45,16 @@ RraErrorCode RraBvhGetChildNodes(const rta::IEncodedRtIp11Bvh* bvh, uint32_t par
 ///         kRraErrorIndexOutOfRange if the child node index is out of range.
 RraErrorCode RraBvhGetChildNodePtr(const rta::IEncodedRtIp11Bvh* bvh, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr);
 
+/// @brief Get the parent node pointer for a given node.
+///
+/// @param [in]  bvh                 The acceleration structure containing the node of interest.
+/// @param [in]  node_ptr            The node whose parent is to be found.
+/// @param [out] out_parent_node_ptr The parent node pointer.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred. The root node has
+///         no parent, so kRraErrorInvalidPointer is returned for it.
+RraErrorCode RraBvhGetParentNodePtr(const rta::IEncodedRtIp11Bvh* bvh, uint32_t node_ptr, uint32_t* out_parent_node_ptr);
+
 /// @brief Get the bounding volume for a provided node.
 ///
 /// @param [in]  bvh              The acceleration structure containing the node of interest.
@@ -74,4 +84,22 @@ RraErrorCode RraBvhGetBoundingVolumeSurfaceArea(const rta::IEncodedRtIp11Bvh* bv
 /// @return RraOk if successful, an error code if not.
 RraErrorCode RraBvhGetSurfaceAreaHeuristic(const rta::IEncodedRtIp11Bvh* bvh, const dxr::amd::NodePointer node_ptr, float* out_surface_area_heuristic);
 
+/// @brief Get the sibling overlap for a provided box node.
+///
+/// @param [in]  bvh                The acceleration structure containing the node of interest.
+/// @param [in]  node_ptr           The node of interest.
+/// @param [out] out_overlap_area   The sibling overlap area, relative to the node's surface area.
+/// @param [out] out_overlap_volume The sibling overlap volume, relative to the node's volume.
+///
+/// @return RraOk if successful, an error code if not.
+RraErrorCode RraBvhGetSiblingOverlap(const rta::IEncodedRtIp11Bvh* bvh, const dxr::amd::NodePointer node_ptr, float* out_overlap_area, float* out_overlap_volume);
+
+/// @brief Get the node overlap summary for an acceleration structure.
+///
+/// @param [in]  bvh       The acceleration structure.
+/// @param [out] out_stats The overlap summary.
+///
+/// @return RraOk if successful, an error code if not.
+RraErrorCode RraBvhGetOverlapStats(const rta::IEncodedRtIp11Bvh* bvh, RraBvhOverlapStats* out_stats);
+
 #endif  // RRA_BACKEND_RRA_BVH_IMPL_H_
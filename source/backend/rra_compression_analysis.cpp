@@ -0,0 +1,122 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the compression analysis interface.
+//=============================================================================
+
+#include "public/rra_compression_analysis.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "bvh/gpu_def.h"
+#include "compression_analysis.h"
+#include "rra_blas_impl.h"
+#include "rra_context.h"
+
+static_assert(static_cast<int>(kRraTriangleCompressionModeNone) == static_cast<int>(rta::BvhTriangleCompressionMode::kNone),
+              "Triangle compression mode mismatch.");
+static_assert(static_cast<int>(kRraTriangleCompressionModeTwoTriangles) == static_cast<int>(rta::BvhTriangleCompressionMode::kTwoTriangles),
+              "Triangle compression mode mismatch.");
+static_assert(static_cast<int>(kRraTriangleCompressionModePairTriangles) == static_cast<int>(rta::BvhTriangleCompressionMode::kPairTriangles),
+              "Triangle compression mode mismatch.");
+static_assert(static_cast<int>(kRraTriangleCompressionModeAutomatic) == static_cast<int>(rta::BvhTriangleCompressionMode::kAutomaticNumberOfTriangles),
+              "Triangle compression mode mismatch.");
+static_assert(static_cast<int>(kRraTriangleCompressionModeFourTriangles) == static_cast<int>(rta::BvhTriangleCompressionMode::kFourTriangles),
+              "Triangle compression mode mismatch.");
+static_assert(static_cast<int>(kRraBoxFp16ModeNone) == static_cast<int>(rta::BvhLowPrecisionInteriorNodeMode::kNone), "Fp16 box node mode mismatch.");
+static_assert(static_cast<int>(kRraBoxFp16ModeLeafNodesOnly) == static_cast<int>(rta::BvhLowPrecisionInteriorNodeMode::kLeafNodesOnly),
+              "Fp16 box node mode mismatch.");
+static_assert(static_cast<int>(kRraBoxFp16ModeMixedWithFp32) == static_cast<int>(rta::BvhLowPrecisionInteriorNodeMode::kMixedWithFp32),
+              "Fp16 box node mode mismatch.");
+static_assert(static_cast<int>(kRraBoxFp16ModeAll) == static_cast<int>(rta::BvhLowPrecisionInteriorNodeMode::kAll), "Fp16 box node mode mismatch.");
+
+/// @brief Add the counts and sizes of a BLAS analysis to a running total.
+///
+/// @param [in]     stats  The BLAS analysis.
+/// @param [in,out] totals The running total.
+static void AddToTotals(const RraBlasCompressionStats& stats, RraBlasCompressionStats& totals)
+{
+    totals.triangle_count += stats.triangle_count;
+    totals.leaf_node_count += stats.leaf_node_count;
+    totals.shared_edge_pair_count += stats.shared_edge_pair_count;
+    totals.leaf_node_buffer_size += stats.leaf_node_buffer_size;
+    totals.uncompressed_leaf_node_buffer_size += stats.uncompressed_leaf_node_buffer_size;
+    totals.pair_compressed_leaf_node_buffer_size += stats.pair_compressed_leaf_node_buffer_size;
+    totals.fp32_box_node_count += stats.fp32_box_node_count;
+    totals.fp16_box_node_count += stats.fp16_box_node_count;
+    totals.fp16_representable_box_node_count += stats.fp16_representable_box_node_count;
+    totals.interior_node_buffer_size += stats.interior_node_buffer_size;
+    for (uint32_t mode = 0; mode < kRraBoxFp16ModeCount; mode++)
+    {
+        totals.projected_interior_node_buffer_size[mode] += stats.projected_interior_node_buffer_size[mode];
+    }
+}
+
+RraErrorCode RraContextCompressionAnalyzeBlas(RraContext* context, uint64_t blas_index, float fp16_tolerance, RraBlasCompressionStats* out_stats)
+{
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    RRA_RETURN_ON_ERROR(blas != nullptr, kRraErrorIndexOutOfRange);
+
+    rra::AnalyzeBlasCompression(blas, fp16_tolerance, *out_stats);
+    return kRraOk;
+}
+
+RraErrorCode RraContextCompressionAnalyzeAllBlases(RraContext*              context,
+                                                   uint32_t                 thread_count,
+                                                   float                    fp16_tolerance,
+                                                   RraBlasCompressionStats* out_blas_stats,
+                                                   RraBlasCompressionStats* out_total_stats)
+{
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    std::vector<RraBlasCompressionStats> blas_stats;
+    RraErrorCode                         error_code = rra::AnalyzeCompression(context->data_set, thread_count, fp16_tolerance, blas_stats);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    if (out_blas_stats != nullptr)
+    {
+        std::copy(blas_stats.begin(), blas_stats.end(), out_blas_stats);
+    }
+
+    if (out_total_stats != nullptr)
+    {
+        // Each non-empty BLAS has a root node, which can never be fp16.
+        RraBlasCompressionStats totals         = {};
+        uint64_t                non_root_count = 0;
+        for (const auto& stats : blas_stats)
+        {
+            AddToTotals(stats, totals);
+            const uint64_t box_count = stats.fp32_box_node_count + stats.fp16_box_node_count;
+            non_root_count += (box_count > 0) ? box_count - 1 : 0;
+        }
+
+        totals.pair_compression_ratio      = (totals.triangle_count > 0)
+                                                 ? static_cast<float>(totals.triangle_count - totals.shared_edge_pair_count) / totals.triangle_count
+                                                 : 1.0f;
+        totals.fp16_representable_fraction = (non_root_count > 0) ? static_cast<float>(totals.fp16_representable_box_node_count) / non_root_count : 0.0f;
+        *out_total_stats                   = totals;
+    }
+
+    return kRraOk;
+}
+
+RraErrorCode RraCompressionAnalyzeBlas(uint64_t blas_index, float fp16_tolerance, RraBlasCompressionStats* out_stats)
+{
+    return RraContextCompressionAnalyzeBlas(RraContextGetDefault(), blas_index, fp16_tolerance, out_stats);
+}
+
+RraErrorCode RraCompressionAnalyzeAllBlases(uint32_t                 thread_count,
+                                            float                    fp16_tolerance,
+                                            RraBlasCompressionStats* out_blas_stats,
+                                            RraBlasCompressionStats* out_total_stats)
+{
+    return RraContextCompressionAnalyzeAllBlases(RraContextGetDefault(), thread_count, fp16_tolerance, out_blas_stats, out_total_stats);
+}
@@ -0,0 +1,91 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the backend context interface.
+//=============================================================================
+
+#include "rra_context.h"
+
+#include <new>
+
+#include "blas_hash.h"
+#include "job_system.h"
+#include "node_overlap.h"
+#include "surface_area_heuristic.h"
+#include "triangle_scan.h"
+
+/// The default context, used by the functions that don't take a context.
+static RraContext default_context_;
+
+RraErrorCode RraContextCreate(RraContext** out_context)
+{
+    RRA_RETURN_ON_ERROR(out_context != nullptr, kRraErrorInvalidPointer);
+
+    *out_context = new (std::nothrow) RraContext();
+    RRA_RETURN_ON_ERROR(*out_context != nullptr, kRraErrorOutOfMemory);
+    return kRraOk;
+}
+
+RraErrorCode RraContextDestroy(RraContext* context)
+{
+    RRA_RETURN_ON_ERROR(context != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context != &default_context_, kRraErrorInvalidPointer);
+
+    RraContextUnloadTrace(context);
+    delete context;
+    return kRraOk;
+}
+
+RraContext* RraContextGetDefault()
+{
+    return &default_context_;
+}
+
+RraErrorCode RraContextLoadTrace(RraContext* context, const char* trace_file_name)
+{
+    RRA_RETURN_ON_ERROR(context != nullptr, kRraErrorInvalidPointer);
+
+    RraContextUnloadTrace(context);
+
+    RraErrorCode error_code = RraDataSetInitialize(trace_file_name, &context->data_set);
+    if (error_code == kRraOk)
+    {
+        // The passes each write their own values into the acceleration structures. Only the TLAS surface area
+        // heuristics read what another pass wrote, the BLAS values of the instance nodes.
+        rra::TaskGraph passes;
+        const uint32_t blas_sah = passes.AddTask([context]() { rra::CalculateBlasSurfaceAreaHeuristics(context); });
+        passes.AddTask([context]() { rra::CalculateTlasSurfaceAreaHeuristics(context); }, {blas_sah});
+        passes.AddTask([context]() { rra::CalculateNodeOverlap(context->data_set); });
+        passes.AddTask([context]() { rra::CalculateBlasHashes(context); });
+        passes.AddTask([context]() { rra::ScanTriangles(context->data_set, 0, true, nullptr); });
+        passes.Run();
+    }
+    else
+    {
+        context->data_set = {};
+    }
+    return error_code;
+}
+
+RraErrorCode RraContextUnloadTrace(RraContext* context)
+{
+    RRA_RETURN_ON_ERROR(context != nullptr, kRraErrorInvalidPointer);
+
+    if (context->data_set.file_loaded)
+    {
+        RraDataSetDestroy(&context->data_set);
+    }
+    context->data_set = {};
+    return kRraOk;
+}
+
+bool RraContextIsTraceLoaded(const RraContext* context)
+{
+    return (context != nullptr) && context->data_set.file_loaded;
+}
+
+time_t RraContextGetTraceCreateTime(const RraContext* context)
+{
+    return (context != nullptr) ? context->data_set.create_time : 0;
+}
@@ -0,0 +1,20 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the backend context structure.
+//=============================================================================
+
+#ifndef RRA_BACKEND_RRA_CONTEXT_H_
+#define RRA_BACKEND_RRA_CONTEXT_H_
+
+#include "public/rra_context.h"
+#include "rra_data_set.h"
+
+/// A structure encapsulating a backend context.
+struct RraContext
+{
+    RraDataSet data_set = {};  ///< The data set for the trace loaded into this context.
+};
+
+#endif  // RRA_BACKEND_RRA_CONTEXT_H_
@@ -0,0 +1,823 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the statistics export interface.
+//=============================================================================
+
+#include "public/rra_export.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "public/rra_assert.h"
+#include "public/rra_blas.h"
+#include "public/rra_bvh.h"
+#include "public/rra_macro.h"
+#include "public/rra_tlas.h"
+
+#ifndef _WIN32
+#include "public/linux/safe_crt.h"
+#endif
+
+namespace rra
+{
+    /// @brief The number of bytes buffered per column before being written to disk.
+    static const size_t kColumnBufferSize = 64 * 1024;
+
+    /// @brief A single column of a table, streamed to its own file.
+    class ExportColumn
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in] name       The name of the column.
+        /// @param [in] type       The value type of the column.
+        /// @param [in] components The number of values per row.
+        ExportColumn(const std::string& name, RraExportColumnType type, uint32_t components)
+            : name_(name)
+            , type_(type)
+            , components_(components)
+        {
+        }
+
+        /// @brief Destructor.
+        ~ExportColumn()
+        {
+            if (file_ != nullptr)
+            {
+                fclose(file_);
+            }
+        }
+
+        /// @brief Create the column file and write a placeholder header.
+        ///
+        /// @param [in] file_path The full path of the file to create.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        RraErrorCode Open(const std::string& file_path)
+        {
+            fopen_s(&file_, file_path.c_str(), "wb");
+            if (file_ == nullptr)
+            {
+                return kRraErrorInvalidPath;
+            }
+
+            buffer_.reserve(kColumnBufferSize);
+            return WriteHeader();
+        }
+
+        /// @brief Append a row to a 32-bit unsigned column.
+        ///
+        /// @param [in] value The value to append.
+        void Append(uint32_t value)
+        {
+            RRA_ASSERT(type_ == kRraExportColumnTypeUint32 && components_ == 1);
+            AppendBytes(&value, sizeof(value));
+            row_count_++;
+        }
+
+        /// @brief Append a row to a 64-bit unsigned column.
+        ///
+        /// @param [in] value The value to append.
+        void Append(uint64_t value)
+        {
+            RRA_ASSERT(type_ == kRraExportColumnTypeUint64 && components_ == 1);
+            AppendBytes(&value, sizeof(value));
+            row_count_++;
+        }
+
+        /// @brief Append a row to a float column.
+        ///
+        /// @param [in] value The value to append.
+        void Append(float value)
+        {
+            RRA_ASSERT(type_ == kRraExportColumnTypeFloat32 && components_ == 1);
+            AppendBytes(&value, sizeof(value));
+            row_count_++;
+        }
+
+        /// @brief Append a row to a multi-component float column.
+        ///
+        /// @param [in] values The row values. Must contain one value per component.
+        void AppendArray(const float* values)
+        {
+            RRA_ASSERT(type_ == kRraExportColumnTypeFloat32);
+            AppendBytes(values, sizeof(float) * components_);
+            row_count_++;
+        }
+
+        /// @brief Flush the remaining data, write the final header and close the file.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        RraErrorCode Close()
+        {
+            if (file_ == nullptr)
+            {
+                return kRraErrorFileNotOpen;
+            }
+
+            Flush();
+            if (!write_failed_)
+            {
+                fseek(file_, 0, SEEK_SET);
+                WriteHeader();
+            }
+
+            fclose(file_);
+            file_ = nullptr;
+
+            return write_failed_ ? kRraErrorInvalidPath : kRraOk;
+        }
+
+        /// @brief Get the name of the column.
+        ///
+        /// @return The column name.
+        const std::string& GetName() const
+        {
+            return name_;
+        }
+
+        /// @brief Get the value type of the column.
+        ///
+        /// @return The column type.
+        RraExportColumnType GetType() const
+        {
+            return type_;
+        }
+
+        /// @brief Get the number of values per row.
+        ///
+        /// @return The number of components.
+        uint32_t GetComponents() const
+        {
+            return components_;
+        }
+
+        /// @brief Get the number of rows written.
+        ///
+        /// @return The row count.
+        uint64_t GetRowCount() const
+        {
+            return row_count_;
+        }
+
+    private:
+        /// @brief Write the column header at the current file position.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        RraErrorCode WriteHeader()
+        {
+            RraExportColumnHeader header = {};
+            header.magic                 = kRraExportColumnMagic;
+            header.version               = kRraExportColumnVersion;
+            header.type                  = type_;
+            header.components            = components_;
+            header.row_count             = row_count_;
+
+            if (fwrite(&header, sizeof(header), 1, file_) != 1)
+            {
+                write_failed_ = true;
+                return kRraErrorInvalidPath;
+            }
+            return kRraOk;
+        }
+
+        /// @brief Add data to the buffer, writing the buffer to disk when full.
+        ///
+        /// @param [in] data The data to add.
+        /// @param [in] size The size of the data, in bytes.
+        void AppendBytes(const void* data, size_t size)
+        {
+            if (buffer_.size() + size > kColumnBufferSize)
+            {
+                Flush();
+            }
+
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            buffer_.insert(buffer_.end(), bytes, bytes + size);
+        }
+
+        /// @brief Write the buffered data to disk.
+        void Flush()
+        {
+            if (!buffer_.empty() && !write_failed_)
+            {
+                if (fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size())
+                {
+                    write_failed_ = true;
+                }
+            }
+            buffer_.clear();
+        }
+
+        std::string          name_;                    ///< The column name.
+        RraExportColumnType  type_;                    ///< The value type.
+        uint32_t             components_;              ///< The number of values per row.
+        uint64_t             row_count_    = 0;        ///< The number of rows written so far.
+        FILE*                file_         = nullptr;  ///< The column file.
+        std::vector<uint8_t> buffer_       = {};       ///< Data waiting to be written to the file.
+        bool                 write_failed_ = false;    ///< Set if any write to the file failed.
+    };
+
+    /// @brief A table made up of a set of columns with the same number of rows.
+    class ExportTable
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in] name The name of the table.
+        explicit ExportTable(const std::string& name)
+            : name_(name)
+        {
+        }
+
+        /// @brief Add a column to the table. Must be called before Open().
+        ///
+        /// @param [in] name       The name of the column.
+        /// @param [in] type       The value type of the column.
+        /// @param [in] components The number of values per row.
+        ///
+        /// @return A reference to the new column.
+        ExportColumn& AddColumn(const std::string& name, RraExportColumnType type, uint32_t components = 1)
+        {
+            columns_.emplace_back(new ExportColumn(name, type, components));
+            return *columns_.back();
+        }
+
+        /// @brief Create the files for all columns.
+        ///
+        /// @param [in] directory_path The directory to write to, including a trailing separator.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        RraErrorCode Open(const std::string& directory_path)
+        {
+            for (auto& column : columns_)
+            {
+                RraErrorCode error_code = column->Open(directory_path + GetFileName(*column));
+                if (error_code != kRraOk)
+                {
+                    return error_code;
+                }
+            }
+            return kRraOk;
+        }
+
+        /// @brief Close all column files.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        RraErrorCode Close()
+        {
+            RraErrorCode result = kRraOk;
+            for (auto& column : columns_)
+            {
+                RraErrorCode error_code = column->Close();
+                if (result == kRraOk)
+                {
+                    result = error_code;
+                }
+            }
+            return result;
+        }
+
+        /// @brief Get the row count of the table, checking all columns agree.
+        ///
+        /// @return The row count.
+        uint64_t GetRowCount() const
+        {
+            if (columns_.empty())
+            {
+                return 0;
+            }
+
+            uint64_t row_count = columns_.front()->GetRowCount();
+            for (const auto& column : columns_)
+            {
+                RRA_ASSERT(column->GetRowCount() == row_count);
+            }
+            return row_count;
+        }
+
+        /// @brief Add a count to the manifest entry for this table, such as the number of rows that were skipped.
+        ///
+        /// Adding to a name that is already there increases its count.
+        ///
+        /// @param [in] name  The name of the count.
+        /// @param [in] count The value to add.
+        void AddManifestCount(const std::string& name, uint64_t count)
+        {
+            for (auto& manifest_count : manifest_counts_)
+            {
+                if (manifest_count.first == name)
+                {
+                    manifest_count.second += count;
+                    return;
+                }
+            }
+            manifest_counts_.emplace_back(name, count);
+        }
+
+        /// @brief Append the manifest entry for this table.
+        ///
+        /// @param [in,out] manifest The manifest string to append to.
+        void AppendManifest(std::string& manifest) const
+        {
+            static const char* kTypeNames[] = {"uint32", "uint64", "float32"};
+
+            manifest += "    {\n";
+            manifest += "      \"name\": \"" + name_ + "\",\n";
+            manifest += "      \"row_count\": " + std::to_string(GetRowCount()) + ",\n";
+            for (const auto& manifest_count : manifest_counts_)
+            {
+                manifest += "      \"" + manifest_count.first + "\": " + std::to_string(manifest_count.second) + ",\n";
+            }
+            manifest += "      \"columns\": [\n";
+            for (size_t i = 0; i < columns_.size(); i++)
+            {
+                const ExportColumn& column = *columns_[i];
+                manifest += "        {\"name\": \"" + column.GetName() + "\", \"type\": \"" + kTypeNames[column.GetType()] +
+                            "\", \"components\": " + std::to_string(column.GetComponents()) + ", \"file\": \"" + GetFileName(column) + "\"}";
+                manifest += (i + 1 < columns_.size()) ? ",\n" : "\n";
+            }
+            manifest += "      ]\n";
+            manifest += "    }";
+        }
+
+    private:
+        /// @brief Get the file name for a column of this table.
+        ///
+        /// @param [in] column The column.
+        ///
+        /// @return The file name, without a directory.
+        std::string GetFileName(const ExportColumn& column) const
+        {
+            return name_ + "." + column.GetName() + ".rracol";
+        }
+
+        std::string                                   name_;             ///< The table name.
+        std::vector<std::unique_ptr<ExportColumn>>    columns_;          ///< The columns in the table.
+        std::vector<std::pair<std::string, uint64_t>> manifest_counts_;  ///< The extra counts written to the manifest, in the order added.
+    };
+
+    /// @brief Write the TLAS table.
+    ///
+    /// @param [in] context        The context holding the loaded trace.
+    /// @param [in] directory_path The directory to write to.
+    /// @param [in,out] manifest   The manifest to add the table to.
+    ///
+    /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+    static RraErrorCode ExportTlasTable(RraContext* context, const std::string& directory_path, std::string& manifest)
+    {
+        ExportTable   table("tlas");
+        ExportColumn& tlas_index_column     = table.AddColumn("tlas_index", kRraExportColumnTypeUint64);
+        ExportColumn& address_column        = table.AddColumn("address", kRraExportColumnTypeUint64);
+        ExportColumn& size_column           = table.AddColumn("size_in_bytes", kRraExportColumnTypeUint32);
+        ExportColumn& effective_size_column = table.AddColumn("effective_size_in_bytes", kRraExportColumnTypeUint64);
+        ExportColumn& node_count_column     = table.AddColumn("node_count", kRraExportColumnTypeUint64);
+        ExportColumn& box_count_column      = table.AddColumn("box_node_count", kRraExportColumnTypeUint64);
+        ExportColumn& instance_count_column = table.AddColumn("instance_count", kRraExportColumnTypeUint64);
+        ExportColumn& inactive_count_column = table.AddColumn("inactive_instance_count", kRraExportColumnTypeUint64);
+        ExportColumn& blas_count_column     = table.AddColumn("blas_count", kRraExportColumnTypeUint64);
+        ExportColumn& triangle_count_column = table.AddColumn("triangle_count", kRraExportColumnTypeUint64);
+        ExportColumn& unique_count_column   = table.AddColumn("unique_triangle_count", kRraExportColumnTypeUint64);
+        ExportColumn& build_flags_column    = table.AddColumn("build_flags", kRraExportColumnTypeUint32);
+        ExportColumn& sah_column            = table.AddColumn("sah", kRraExportColumnTypeFloat32);
+        ExportColumn& min_sah_column        = table.AddColumn("min_sah", kRraExportColumnTypeFloat32);
+        ExportColumn& avg_sah_column        = table.AddColumn("avg_sah", kRraExportColumnTypeFloat32);
+        RRA_BUBBLE_ON_ERROR(table.Open(directory_path));
+
+        uint32_t root_node = 0;
+        RRA_BUBBLE_ON_ERROR(RraBvhGetRootNodePtr(&root_node));
+
+        uint64_t tlas_count = 0;
+        RRA_BUBBLE_ON_ERROR(RraContextBvhGetTlasCount(context, &tlas_count));
+
+        for (uint64_t tlas_index = 0; tlas_index < tlas_count; tlas_index++)
+        {
+            uint64_t address        = 0;
+            uint32_t size           = 0;
+            uint64_t effective_size = 0;
+            uint64_t node_count     = 0;
+            uint64_t box_count      = 0;
+            uint64_t instance_count = 0;
+            uint64_t inactive_count = 0;
+            uint64_t blas_count     = 0;
+            uint64_t triangle_count = 0;
+            uint64_t unique_count   = 0;
+            float    sah            = 0.0f;
+            float    min_sah        = 0.0f;
+            float    avg_sah        = 0.0f;
+
+            VkBuildAccelerationStructureFlagBitsKHR build_flags = {};
+
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetBaseAddress(context, tlas_index, &address));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetSizeInBytes(context, tlas_index, &size));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetEffectiveSizeInBytes(context, tlas_index, &effective_size));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetTotalNodeCount(context, tlas_index, &node_count));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetBoxNodeCount(context, tlas_index, &box_count));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetInstanceNodeCount(context, tlas_index, &instance_count));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetInactiveInstancesCount(context, tlas_index, &inactive_count));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetBlasCount(context, tlas_index, &blas_count));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetTotalTriangleCount(context, tlas_index, &triangle_count));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetUniqueTriangleCount(context, tlas_index, &unique_count));
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetBuildFlags(context, tlas_index, &build_flags));
+
+            // The SAH queries fail for an empty TLAS, so leave them at 0.
+            if (!RraContextTlasIsEmpty(context, tlas_index))
+            {
+                RraContextTlasGetSurfaceAreaHeuristic(context, tlas_index, root_node, &sah);
+                RraContextTlasGetMinimumSurfaceAreaHeuristic(context, tlas_index, root_node, &min_sah);
+                RraContextTlasGetAverageSurfaceAreaHeuristic(context, tlas_index, root_node, &avg_sah);
+            }
+
+            tlas_index_column.Append(tlas_index);
+            address_column.Append(address);
+            size_column.Append(size);
+            effective_size_column.Append(effective_size);
+            node_count_column.Append(node_count);
+            box_count_column.Append(box_count);
+            instance_count_column.Append(instance_count);
+            inactive_count_column.Append(inactive_count);
+            blas_count_column.Append(blas_count);
+            triangle_count_column.Append(triangle_count);
+            unique_count_column.Append(unique_count);
+            build_flags_column.Append(static_cast<uint32_t>(build_flags));
+            sah_column.Append(sah);
+            min_sah_column.Append(min_sah);
+            avg_sah_column.Append(avg_sah);
+        }
+
+        RRA_BUBBLE_ON_ERROR(table.Close());
+        table.AppendManifest(manifest);
+        return kRraOk;
+    }
+
+    /// @brief Write the BLAS table.
+    ///
+    /// BLASes that are missing from the trace are skipped, and counted as skipped_row_count in the manifest.
+    ///
+    /// @param [in] context        The context holding the loaded trace.
+    /// @param [in] directory_path The directory to write to.
+    /// @param [in,out] manifest   The manifest to add the table to.
+    ///
+    /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+    static RraErrorCode ExportBlasTable(RraContext* context, const std::string& directory_path, std::string& manifest)
+    {
+        ExportTable   table("blas");
+        ExportColumn& blas_index_column      = table.AddColumn("blas_index", kRraExportColumnTypeUint64);
+        ExportColumn& address_column         = table.AddColumn("address", kRraExportColumnTypeUint64);
+        ExportColumn& size_column            = table.AddColumn("size_in_bytes", kRraExportColumnTypeUint32);
+        ExportColumn& node_count_column      = table.AddColumn("node_count", kRraExportColumnTypeUint64);
+        ExportColumn& box_count_column       = table.AddColumn("box_node_count", kRraExportColumnTypeUint64);
+        ExportColumn& triangle_node_column   = table.AddColumn("triangle_node_count", kRraExportColumnTypeUint32);
+        ExportColumn& procedural_node_column = table.AddColumn("procedural_node_count", kRraExportColumnTypeUint32);
+        ExportColumn& unique_count_column    = table.AddColumn("unique_triangle_count", kRraExportColumnTypeUint32);
+        ExportColumn& max_depth_column       = table.AddColumn("max_depth", kRraExportColumnTypeUint32);
+        ExportColumn& avg_depth_column       = table.AddColumn("avg_depth", kRraExportColumnTypeUint32);
+        ExportColumn& build_flags_column     = table.AddColumn("build_flags", kRraExportColumnTypeUint32);
+        ExportColumn& surface_area_column    = table.AddColumn("surface_area", kRraExportColumnTypeFloat32);
+        ExportColumn& sah_column             = table.AddColumn("sah", kRraExportColumnTypeFloat32);
+        ExportColumn& min_sah_column         = table.AddColumn("min_triangle_sah", kRraExportColumnTypeFloat32);
+        ExportColumn& avg_sah_column         = table.AddColumn("avg_triangle_sah", kRraExportColumnTypeFloat32);
+        RRA_BUBBLE_ON_ERROR(table.Open(directory_path));
+
+        uint32_t root_node = 0;
+        RRA_BUBBLE_ON_ERROR(RraBvhGetRootNodePtr(&root_node));
+
+        uint64_t blas_count = 0;
+        RRA_BUBBLE_ON_ERROR(RraContextBvhGetTotalBlasCount(context, &blas_count));
+
+        table.AddManifestCount("skipped_row_count", 0);
+        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        {
+            uint64_t address = 0;
+            if (RraContextBlasGetBaseAddress(context, blas_index, &address) != kRraOk)
+            {
+                table.AddManifestCount("skipped_row_count", 1);
+                continue;
+            }
+
+            uint32_t size           = 0;
+            uint64_t node_count     = 0;
+            uint64_t box_count      = 0;
+            uint32_t triangle_nodes = 0;
+            uint32_t procedural     = 0;
+            uint32_t unique_count   = 0;
+            uint32_t max_depth      = 0;
+            uint32_t avg_depth      = 0;
+            float    surface_area   = 0.0f;
+            float    sah            = 0.0f;
+            float    min_sah        = 0.0f;
+            float    avg_sah        = 0.0f;
+
+            VkBuildAccelerationStructureFlagBitsKHR build_flags = {};
+
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetSizeInBytes(context, blas_index, &size));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetTotalNodeCount(context, blas_index, &node_count));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetBoxNodeCount(context, blas_index, &box_count));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetTriangleNodeCount(context, blas_index, &triangle_nodes));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetProceduralNodeCount(context, blas_index, &procedural));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetUniqueTriangleCount(context, blas_index, &unique_count));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetMaxTreeDepth(context, blas_index, &max_depth));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetAvgTreeDepth(context, blas_index, &avg_depth));
+            RRA_BUBBLE_ON_ERROR(RraContextBlasGetBuildFlags(context, blas_index, &build_flags));
+
+            // The node queries fail for an empty BLAS, so leave them at 0.
+            if (!RraContextBlasIsEmpty(context, blas_index))
+            {
+                RraContextBlasGetSurfaceArea(context, blas_index, root_node, &surface_area);
+                RraContextBlasGetSurfaceAreaHeuristic(context, blas_index, root_node, &sah);
+                RraContextBlasGetMinimumSurfaceAreaHeuristic(context, blas_index, root_node, true, &min_sah);
+                RraContextBlasGetAverageSurfaceAreaHeuristic(context, blas_index, root_node, true, &avg_sah);
+            }
+
+            blas_index_column.Append(blas_index);
+            address_column.Append(address);
+            size_column.Append(size);
+            node_count_column.Append(node_count);
+            box_count_column.Append(box_count);
+            triangle_node_column.Append(triangle_nodes);
+            procedural_node_column.Append(procedural);
+            unique_count_column.Append(unique_count);
+            max_depth_column.Append(max_depth);
+            avg_depth_column.Append(avg_depth);
+            build_flags_column.Append(static_cast<uint32_t>(build_flags));
+            surface_area_column.Append(surface_area);
+            sah_column.Append(sah);
+            min_sah_column.Append(min_sah);
+            avg_sah_column.Append(avg_sah);
+        }
+
+        RRA_BUBBLE_ON_ERROR(table.Close());
+        table.AppendManifest(manifest);
+        return kRraOk;
+    }
+
+    /// @brief Write the instance table.
+    ///
+    /// Instances are read a TLAS at a time using the bulk instance table, which walks the TLAS's instance lists
+    /// once, so only the instances of one TLAS are held in memory at once. The rows of each TLAS are ordered by
+    /// BLAS index.
+    ///
+    /// Inactive instances reference no BLAS, so have no row. Instances whose node couldn't be read are skipped.
+    /// Both are counted in the manifest, as inactive_instance_count and skipped_row_count.
+    ///
+    /// @param [in] context        The context holding the loaded trace.
+    /// @param [in] directory_path The directory to write to.
+    /// @param [in,out] manifest   The manifest to add the table to.
+    ///
+    /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+    static RraErrorCode ExportInstanceTable(RraContext* context, const std::string& directory_path, std::string& manifest)
+    {
+        ExportTable   table("instance");
+        ExportColumn& tlas_index_column     = table.AddColumn("tlas_index", kRraExportColumnTypeUint64);
+        ExportColumn& blas_index_column     = table.AddColumn("blas_index", kRraExportColumnTypeUint64);
+        ExportColumn& instance_index_column = table.AddColumn("instance_index", kRraExportColumnTypeUint32);
+        ExportColumn& node_ptr_column       = table.AddColumn("node_ptr", kRraExportColumnTypeUint32);
+        ExportColumn& mask_column           = table.AddColumn("mask", kRraExportColumnTypeUint32);
+        ExportColumn& instance_id_column    = table.AddColumn("instance_id", kRraExportColumnTypeUint32);
+        ExportColumn& hit_group_column      = table.AddColumn("hit_group", kRraExportColumnTypeUint32);
+        ExportColumn& flags_column          = table.AddColumn("flags", kRraExportColumnTypeUint32);
+        ExportColumn& transform_column      = table.AddColumn("transform", kRraExportColumnTypeFloat32, 12);
+        ExportColumn& surface_area_column   = table.AddColumn("surface_area", kRraExportColumnTypeFloat32);
+        ExportColumn& sah_column            = table.AddColumn("sah", kRraExportColumnTypeFloat32);
+        RRA_BUBBLE_ON_ERROR(table.Open(directory_path));
+
+        uint64_t tlas_count = 0;
+        RRA_BUBBLE_ON_ERROR(RraContextBvhGetTlasCount(context, &tlas_count));
+
+        std::vector<uint32_t>              node_ptrs;
+        std::vector<uint64_t>              blas_indices;
+        std::vector<uint32_t>              instance_indices;
+        std::vector<uint32_t>              masks;
+        std::vector<uint32_t>              instance_ids;
+        std::vector<uint32_t>              hit_groups;
+        std::vector<uint32_t>              flags;
+        std::vector<float>                 transforms;
+        std::vector<BoundingVolumeExtents> bounding_volumes;
+        std::vector<uint32_t>              row_valid;
+
+        // Both counts are written even when they are zero, so readers can tell nothing was left out.
+        table.AddManifestCount("inactive_instance_count", 0);
+        table.AddManifestCount("skipped_row_count", 0);
+
+        for (uint64_t tlas_index = 0; tlas_index < tlas_count; tlas_index++)
+        {
+            uint64_t inactive_count = 0;
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetInactiveInstancesCount(context, tlas_index, &inactive_count));
+            table.AddManifestCount("inactive_instance_count", inactive_count);
+
+            uint64_t instance_count = 0;
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetInstanceTableRowCount(context, tlas_index, &instance_count));
+            if (instance_count == 0)
+            {
+                continue;
+            }
+
+            size_t row_count = static_cast<size_t>(instance_count);
+            node_ptrs.resize(row_count);
+            blas_indices.resize(row_count);
+            instance_indices.resize(row_count);
+            masks.resize(row_count);
+            instance_ids.resize(row_count);
+            hit_groups.resize(row_count);
+            flags.resize(row_count);
+            transforms.resize(row_count * 12);
+            bounding_volumes.resize(row_count);
+            row_valid.resize(row_count);
+
+            uint64_t             invalid_row_count = 0;
+            RraTlasInstanceTable instance_table    = {};
+            instance_table.node_ptr             = node_ptrs.data();
+            instance_table.blas_index           = blas_indices.data();
+            instance_table.instance_index       = instance_indices.data();
+            instance_table.mask                 = masks.data();
+            instance_table.instance_id          = instance_ids.data();
+            instance_table.hit_group            = hit_groups.data();
+            instance_table.flags                = flags.data();
+            instance_table.original_transform   = transforms.data();
+            instance_table.bounding_volume      = bounding_volumes.data();
+            instance_table.row_valid            = row_valid.data();
+            instance_table.invalid_row_count    = &invalid_row_count;
+            RRA_BUBBLE_ON_ERROR(RraContextTlasGetInstanceTable(context, tlas_index, 0, &instance_table));
+            table.AddManifestCount("skipped_row_count", invalid_row_count);
+
+            for (size_t row = 0; row < row_count; row++)
+            {
+                if (row_valid[row] == 0)
+                {
+                    continue;
+                }
+
+                float surface_area = 0.0f;
+                float sah          = 0.0f;
+                RraBvhGetBoundingVolumeSurfaceArea(&bounding_volumes[row], &surface_area);
+                RraContextTlasGetSurfaceAreaHeuristic(context, tlas_index, node_ptrs[row], &sah);
+
+                tlas_index_column.Append(tlas_index);
+                blas_index_column.Append(blas_indices[row]);
+                instance_index_column.Append(instance_indices[row]);
+                node_ptr_column.Append(node_ptrs[row]);
+                mask_column.Append(masks[row]);
+                instance_id_column.Append(instance_ids[row]);
+                hit_group_column.Append(hit_groups[row]);
+                flags_column.Append(flags[row]);
+                transform_column.AppendArray(&transforms[row * 12]);
+                surface_area_column.Append(surface_area);
+                sah_column.Append(sah);
+            }
+        }
+
+        RRA_BUBBLE_ON_ERROR(table.Close());
+        table.AppendManifest(manifest);
+        return kRraOk;
+    }
+
+    /// @brief Write the triangle table.
+    ///
+    /// Each BLAS is walked depth first with an explicit stack, writing a row per triangle node.
+    ///
+    /// @param [in] context        The context holding the loaded trace.
+    /// @param [in] directory_path The directory to write to.
+    /// @param [in,out] manifest   The manifest to add the table to.
+    ///
+    /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+    static RraErrorCode ExportTriangleTable(RraContext* context, const std::string& directory_path, std::string& manifest)
+    {
+        ExportTable   table("triangle");
+        ExportColumn& blas_index_column      = table.AddColumn("blas_index", kRraExportColumnTypeUint64);
+        ExportColumn& node_ptr_column        = table.AddColumn("node_ptr", kRraExportColumnTypeUint32);
+        ExportColumn& depth_column           = table.AddColumn("depth", kRraExportColumnTypeUint32);
+        ExportColumn& geometry_index_column  = table.AddColumn("geometry_index", kRraExportColumnTypeUint32);
+        ExportColumn& geometry_flags_column  = table.AddColumn("geometry_flags", kRraExportColumnTypeUint32);
+        ExportColumn& primitive_index_column = table.AddColumn("primitive_index", kRraExportColumnTypeUint32);
+        ExportColumn& triangle_count_column  = table.AddColumn("triangle_count", kRraExportColumnTypeUint32);
+        ExportColumn& inactive_column        = table.AddColumn("inactive", kRraExportColumnTypeUint32);
+        ExportColumn& surface_area_column    = table.AddColumn("surface_area", kRraExportColumnTypeFloat32);
+        ExportColumn& sah_column             = table.AddColumn("sah", kRraExportColumnTypeFloat32);
+        RRA_BUBBLE_ON_ERROR(table.Open(directory_path));
+
+        uint32_t root_node = 0;
+        RRA_BUBBLE_ON_ERROR(RraBvhGetRootNodePtr(&root_node));
+
+        uint64_t blas_count = 0;
+        RRA_BUBBLE_ON_ERROR(RraContextBvhGetTotalBlasCount(context, &blas_count));
+
+        struct StackEntry
+        {
+            uint32_t node_ptr;  ///< The node pointer.
+            uint32_t depth;     ///< The depth of the node in the BLAS.
+        };
+
+        std::vector<StackEntry> stack;
+        std::vector<uint32_t>   child_nodes;
+
+        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        {
+            uint64_t address = 0;
+            if (RraContextBlasGetBaseAddress(context, blas_index, &address) != kRraOk || RraContextBlasIsEmpty(context, blas_index))
+            {
+                continue;
+            }
+
+            stack.clear();
+            stack.push_back({root_node, 0});
+
+            while (!stack.empty())
+            {
+                StackEntry entry = stack.back();
+                stack.pop_back();
+
+                uint32_t child_count = 0;
+                if (RraContextBlasGetChildNodeCount(context, blas_index, entry.node_ptr, &child_count) == kRraOk && child_count > 0)
+                {
+                    child_nodes.resize(child_count);
+                    RRA_BUBBLE_ON_ERROR(RraContextBlasGetChildNodes(context, blas_index, entry.node_ptr, child_nodes.data()));
+
+                    // Push in reverse so children are visited in order.
+                    for (uint32_t i = child_count; i > 0; i--)
+                    {
+                        stack.push_back({child_nodes[i - 1], entry.depth + 1});
+                    }
+                    continue;
+                }
+
+                uint32_t triangle_count = 0;
+                if (RraContextBlasGetNodeTriangleCount(context, blas_index, entry.node_ptr, &triangle_count) != kRraOk || triangle_count == 0)
+                {
+                    continue;
+                }
+
+                uint32_t geometry_index  = 0;
+                uint32_t geometry_flags  = 0;
+                uint32_t primitive_index = 0;
+                bool     inactive        = false;
+                float    surface_area    = 0.0f;
+                float    sah             = 0.0f;
+
+                RRA_BUBBLE_ON_ERROR(RraContextBlasGetGeometryIndex(context, blas_index, entry.node_ptr, &geometry_index));
+                RRA_BUBBLE_ON_ERROR(RraContextBlasGetGeometryFlags(context, blas_index, geometry_index, &geometry_flags));
+                RRA_BUBBLE_ON_ERROR(RraContextBlasGetPrimitiveIndex(context, blas_index, entry.node_ptr, &primitive_index));
+                RRA_BUBBLE_ON_ERROR(RraContextBlasGetIsInactive(context, blas_index, entry.node_ptr, &inactive));
+                RRA_BUBBLE_ON_ERROR(RraContextBlasGetSurfaceArea(context, blas_index, entry.node_ptr, &surface_area));
+                RRA_BUBBLE_ON_ERROR(RraContextBlasGetTriangleSurfaceAreaHeuristic(context, blas_index, entry.node_ptr, &sah));
+
+                blas_index_column.Append(blas_index);
+                node_ptr_column.Append(entry.node_ptr);
+                depth_column.Append(entry.depth);
+                geometry_index_column.Append(geometry_index);
+                geometry_flags_column.Append(geometry_flags);
+                primitive_index_column.Append(primitive_index);
+                triangle_count_column.Append(triangle_count);
+                inactive_column.Append(inactive ? 1u : 0u);
+                surface_area_column.Append(surface_area);
+                sah_column.Append(sah);
+            }
+        }
+
+        RRA_BUBBLE_ON_ERROR(table.Close());
+        table.AppendManifest(manifest);
+        return kRraOk;
+    }
+}  // namespace rra
+
+RraErrorCode RraContextExportStatistics(RraContext* context, const char* directory_path)
+{
+    RRA_RETURN_ON_ERROR(directory_path != nullptr, kRraErrorInvalidPointer);
+
+    std::string directory(directory_path);
+    if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+    {
+        directory += '/';
+    }
+
+    std::string manifest = "{\n  \"format\": \"rracol\",\n  \"version\": " + std::to_string(kRraExportColumnVersion) + ",\n  \"tables\": [\n";
+
+    RRA_BUBBLE_ON_ERROR(rra::ExportTlasTable(context, directory, manifest));
+    manifest += ",\n";
+    RRA_BUBBLE_ON_ERROR(rra::ExportBlasTable(context, directory, manifest));
+    manifest += ",\n";
+    RRA_BUBBLE_ON_ERROR(rra::ExportInstanceTable(context, directory, manifest));
+    manifest += ",\n";
+    RRA_BUBBLE_ON_ERROR(rra::ExportTriangleTable(context, directory, manifest));
+    manifest += "\n  ]\n}\n";
+
+    FILE* manifest_file = nullptr;
+    fopen_s(&manifest_file, (directory + "manifest.json").c_str(), "wb");
+    RRA_RETURN_ON_ERROR(manifest_file != nullptr, kRraErrorInvalidPath);
+
+    size_t written = fwrite(manifest.data(), 1, manifest.size(), manifest_file);
+    fclose(manifest_file);
+    RRA_RETURN_ON_ERROR(written == manifest.size(), kRraErrorInvalidPath);
+
+    return kRraOk;
+}
+
+RraErrorCode RraExportStatistics(const char* directory_path)
+{
+    return RraContextExportStatistics(RraContextGetDefault(), directory_path);
+}
@@ -0,0 +1,158 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the instance overlap interface.
+//=============================================================================
+
+#include "public/rra_instance_overlap.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
+#include "bvh/encoded_rt_ip_11_top_level_bvh.h"
+#include "instance_overlap.h"
+#include "math_util.h"
+#include "rra_blas_impl.h"
+#include "rra_context.h"
+#include "rra_tlas_impl.h"
+
+namespace rra
+{
+    namespace instance_overlap
+    {
+        /// @brief A bounding box that never overlaps anything.
+        static const BoundingVolumeExtents kEmptyBox = {FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        /// @brief Get the world space bounding box of every instance in a TLAS, in instance table order.
+        ///
+        /// @param [in]  context   The context holding the loaded trace.
+        /// @param [in]  tlas      The TLAS.
+        /// @param [out] out_boxes The bounding boxes. Instances that can never be hit get an empty box.
+        static void GetInstanceBoxes(RraContext* context, const rta::EncodedRtIp11TopLevelBvh* tlas, std::vector<BoundingVolumeExtents>& out_boxes)
+        {
+            const auto& blas_indices      = tlas->GetReferencedBlasIndices();
+            const auto& offsets           = tlas->GetInstanceListOffsets();
+            const auto& instances         = tlas->GetInstanceListNodes();
+            const auto& instance_nodes    = tlas->GetInstanceNodes();
+            uint32_t    leaf_nodes_offset = tlas->GetHeader().GetBufferOffsets().leaf_nodes;
+
+            out_boxes.assign(instances.size(), kEmptyBox);
+
+            // The instance lists are stored contiguously in BLAS order, so the BLAS root box is only looked up once per list.
+            for (size_t i = 0; i < blas_indices.size(); i++)
+            {
+                const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_indices[i]);
+                if (blas == nullptr || blas->IsEmpty())
+                {
+                    continue;
+                }
+
+                dxr::amd::NodePointer                  root_ptr(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
+                const dxr::amd::AxisAlignedBoundingBox root_box = blas->ComputeRootNodeBoundingBox(blas->GetFloat32Box(root_ptr));
+
+                for (uint64_t row = offsets[i]; row < offsets[i + 1]; row++)
+                {
+                    const dxr::amd::NodePointer& node = instances[row];
+                    if (!node.IsInstanceNode())
+                    {
+                        continue;
+                    }
+
+                    uint32_t instance_index = (node.GetByteOffset() - leaf_nodes_offset) / sizeof(dxr::amd::InstanceNode);
+                    if (instance_index >= instance_nodes.size())
+                    {
+                        continue;
+                    }
+
+                    const dxr::amd::InstanceNode& instance_node = instance_nodes[instance_index];
+                    if (instance_node.GetDesc().GetMask() == 0)
+                    {
+                        continue;
+                    }
+
+                    out_boxes[row] = rra::math_util::TransformAABB(root_box, instance_node.GetExtraData().GetOriginalInstanceTransform());
+                }
+            }
+        }
+    }  // namespace instance_overlap
+}  // namespace rra
+
+RraErrorCode RraContextInstanceOverlapCalculate(RraContext*              context,
+                                                uint64_t                 tlas_index,
+                                                uint32_t                 thread_count,
+                                                uint32_t*                out_overlap_counts,
+                                                uint32_t*                out_overlap_depths,
+                                                RraInstanceOverlapStats* out_stats)
+{
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    RRA_RETURN_ON_ERROR(tlas != nullptr, kRraErrorIndexOutOfRange);
+
+    *out_stats = {};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<BoundingVolumeExtents> boxes;
+    rra::instance_overlap::GetInstanceBoxes(context, tlas, boxes);
+
+    rra::instance_overlap::Result result;
+    RraErrorCode                  error_code = rra::instance_overlap::FindOverlaps(boxes, thread_count, kRraInstanceOverlapMaxClusterCount, result);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    const std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+
+    uint64_t overlap_count_sum = 0;
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        const uint32_t overlap_count = result.overlap_counts[i];
+        overlap_count_sum += overlap_count;
+        out_stats->overlapping_instance_count += (overlap_count > 0) ? 1 : 0;
+        out_stats->max_overlap_count = std::max(out_stats->max_overlap_count, overlap_count);
+        out_stats->max_overlap_depth = std::max(out_stats->max_overlap_depth, result.overlap_depths[i]);
+    }
+
+    out_stats->instance_count         = boxes.size();
+    out_stats->overlapping_pair_count = result.overlapping_pair_count;
+    out_stats->mean_overlap_count     = boxes.empty() ? 0.0f : static_cast<float>(static_cast<double>(overlap_count_sum) / boxes.size());
+    out_stats->grid_dimensions[0]     = result.grid_dimensions[0];
+    out_stats->grid_dimensions[1]     = result.grid_dimensions[1];
+    out_stats->grid_dimensions[2]     = result.grid_dimensions[2];
+    out_stats->cluster_count          = static_cast<uint32_t>(std::min<size_t>(result.clusters.size(), kRraInstanceOverlapMaxClusterCount));
+    out_stats->time_ms                = time.count();
+
+    for (uint32_t i = 0; i < out_stats->cluster_count; i++)
+    {
+        out_stats->clusters[i].bounds         = result.clusters[i].bounds;
+        out_stats->clusters[i].instance_count = result.clusters[i].instance_count;
+    }
+
+    if (out_overlap_counts != nullptr && !boxes.empty())
+    {
+        memcpy(out_overlap_counts, result.overlap_counts.data(), boxes.size() * sizeof(uint32_t));
+    }
+    if (out_overlap_depths != nullptr && !boxes.empty())
+    {
+        memcpy(out_overlap_depths, result.overlap_depths.data(), boxes.size() * sizeof(uint32_t));
+    }
+
+    return kRraOk;
+}
+
+RraErrorCode RraInstanceOverlapCalculate(uint64_t                 tlas_index,
+                                         uint32_t                 thread_count,
+                                         uint32_t*                out_overlap_counts,
+                                         uint32_t*                out_overlap_depths,
+                                         RraInstanceOverlapStats* out_stats)
+{
+    return RraContextInstanceOverlapCalculate(RraContextGetDefault(), tlas_index, thread_count, out_overlap_counts, out_overlap_depths, out_stats);
+}
@@ -0,0 +1,76 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the job system interface.
+//=============================================================================
+
+#include "public/rra_job_system.h"
+
+#include "job_system.h"
+
+/// @brief A job group created through the public interface.
+struct RraJobGroup
+{
+    rra::JobGroup group;  ///< The group the jobs are submitted to.
+};
+
+RraErrorCode RraJobSystemSetThreadCount(uint32_t thread_count)
+{
+    rra::JobSystem::Get().SetThreadCount(thread_count);
+    return kRraOk;
+}
+
+uint32_t RraJobSystemGetThreadCount()
+{
+    return rra::JobSystem::Get().GetThreadCount();
+}
+
+RraErrorCode RraJobSystemGetStats(RraJobSystemStats* out_stats)
+{
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    rra::JobSystem::Get().GetStats(*out_stats);
+    return kRraOk;
+}
+
+void RraJobSystemResetStats()
+{
+    rra::JobSystem::Get().ResetStats();
+}
+
+RraErrorCode RraJobGroupCreate(RraJobGroup** out_group)
+{
+    RRA_RETURN_ON_ERROR(out_group != nullptr, kRraErrorInvalidPointer);
+    *out_group = new RraJobGroup;
+    return kRraOk;
+}
+
+RraErrorCode RraJobGroupDestroy(RraJobGroup* group)
+{
+    RRA_RETURN_ON_ERROR(group != nullptr, kRraErrorInvalidPointer);
+    delete group;
+    return kRraOk;
+}
+
+RraErrorCode RraJobGroupSubmit(RraJobGroup* group, RraJobFunction function, void* user_data)
+{
+    RRA_RETURN_ON_ERROR(group != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(function != nullptr, kRraErrorInvalidPointer);
+    rra::JobSystem::Get().Submit([function, user_data]() { function(user_data); }, group->group);
+    return kRraOk;
+}
+
+RraErrorCode RraJobGroupIsFinished(const RraJobGroup* group, bool* out_finished)
+{
+    RRA_RETURN_ON_ERROR(group != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(out_finished != nullptr, kRraErrorInvalidPointer);
+    *out_finished = group->group.IsFinished();
+    return kRraOk;
+}
+
+RraErrorCode RraJobGroupWait(RraJobGroup* group)
+{
+    RRA_RETURN_ON_ERROR(group != nullptr, kRraErrorInvalidPointer);
+    rra::JobSystem::Get().Wait(group->group);
+    return kRraOk;
+}
@@ -0,0 +1,579 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the ray cost estimator.
+//=============================================================================
+
+#include "public/rra_ray_cost.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "bvh/dxr_type_conversion.h"
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
+#include "bvh/encoded_rt_ip_11_top_level_bvh.h"
+#include "ray_cost.h"
+#include "rra_blas_impl.h"
+#include "rra_context.h"
+#include "rra_tlas_impl.h"
+
+namespace rra
+{
+    namespace ray_cost
+    {
+        static const uint32_t kDefaultRayCount      = 1000000;  ///< The number of rays cast by default.
+        static const uint32_t kDefaultCacheLineSize = 128;      ///< The default cache line size, in bytes.
+        static const uint32_t kDefaultCacheWays     = 4;        ///< The default cache associativity.
+        static const uint32_t kDefaultCacheCapacity = 16384;    ///< The default cache size, in bytes.
+        static const uint32_t kDefaultCachePageSize = 4096;     ///< The default DRAM page size, in bytes.
+        static const uint32_t kDefaultCacheRayGroup = 64;       ///< The default number of rays sharing the cache, one wave.
+        static const uint32_t kBlasAddressShift     = 40;       ///< Each BLAS is placed at its index plus one shifted by this, above the TLAS.
+
+        /// @brief A node waiting to be visited, with the distance at which the ray enters it.
+        struct StackEntry
+        {
+            dxr::amd::NodePointer node_ptr;  ///< The node to visit.
+            float                 t_entry;   ///< The distance along the ray to the node's bounding box.
+        };
+
+        /// @brief Per-instance or per-BLAS counters, updated by all the worker threads.
+        struct SharedCounters
+        {
+            std::atomic<uint64_t> ray_count{0};        ///< The number of rays that entered.
+            std::atomic<uint64_t> node_visits{0};      ///< The number of nodes visited.
+            std::atomic<uint64_t> box_node_visits{0};  ///< The number of box nodes visited.
+            std::atomic<uint64_t> triangle_tests{0};   ///< The number of ray/triangle tests.
+        };
+
+        /// @brief A node read function that does nothing, for when the cache is not being simulated.
+        struct IgnoreReads
+        {
+            void operator()(uint64_t, uint32_t) const
+            {
+            }
+        };
+
+        /// @brief Get the number of bytes read when a node is visited.
+        ///
+        /// @param [in] node_ptr The node.
+        ///
+        /// @return The node size, in bytes.
+        static uint32_t GetNodeSize(const dxr::amd::NodePointer node_ptr)
+        {
+            if (node_ptr.IsFp32BoxNode())
+            {
+                return dxr::amd::kFp32BoxNodeSize;
+            }
+            if (node_ptr.IsFp16BoxNode())
+            {
+                return dxr::amd::kFp16BoxNodeSize;
+            }
+            if (node_ptr.IsInstanceNode())
+            {
+                return dxr::amd::kInstanceNodeSize;
+            }
+            return dxr::amd::kLeafNodeSize;
+        }
+
+        /// @brief Traverse a BVH, visiting the nearest child first and shrinking the ray as hits are found.
+        ///
+        /// @param [in]     bvh          The BVH to traverse.
+        /// @param [in,out] ray          The ray. Its t_max is set to the closest hit.
+        /// @param [in]     stack        The traversal stack to use. Reused between rays to avoid allocations.
+        /// @param [in,out] result       The counts for the ray.
+        /// @param [in]     visit_leaf   Called for each leaf node reached.
+        /// @param [in]     base_address The address the BVH is placed at for the cache simulation.
+        /// @param [in]     read         Called with the address and size of each node visited.
+        template <typename LeafFunction, typename ReadFunction>
+        static void Traverse(const rta::IEncodedRtIp11Bvh* bvh,
+                             Ray&                          ray,
+                             std::vector<StackEntry>&      stack,
+                             RayResult&                    result,
+                             LeafFunction                  visit_leaf,
+                             uint64_t                      base_address,
+                             ReadFunction&                 read)
+        {
+            const glm::vec3 inv_direction = GetInverseDirection(ray.direction);
+
+            stack.clear();
+            stack.push_back({dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize), ray.t_min});
+
+            while (!stack.empty())
+            {
+                StackEntry entry = stack.back();
+                stack.pop_back();
+
+                // The node may have been pushed before a closer hit was found.
+                if (entry.t_entry > ray.t_max)
+                {
+                    continue;
+                }
+
+                const dxr::amd::NodePointer node_ptr = entry.node_ptr;
+                result.node_visits++;
+                read(base_address + node_ptr.GetByteOffset(), GetNodeSize(node_ptr));
+
+                if (!node_ptr.IsBoxNode())
+                {
+                    visit_leaf(node_ptr);
+                    continue;
+                }
+
+                result.box_node_visits++;
+
+                std::array<dxr::amd::AxisAlignedBoundingBox, 4> boxes;
+                const std::array<dxr::amd::NodePointer, 4>*     children = nullptr;
+                if (node_ptr.IsFp32BoxNode())
+                {
+                    const dxr::amd::Float32BoxNode* box_node = bvh->GetFloat32Box(node_ptr);
+                    boxes                                    = box_node->GetBoundingBoxes();
+                    children                                 = &box_node->GetChildren();
+                }
+                else
+                {
+                    const dxr::amd::Float16BoxNode* box_node = bvh->GetFloat16Box(node_ptr);
+                    boxes                                    = box_node->GetBoundingBoxes();
+                    children                                 = &box_node->GetChildren();
+                }
+
+                float    t_entry[4];
+                uint32_t hit_mask = IntersectChildBoxes(boxes, ray.origin, inv_direction, ray.t_min, ray.t_max, t_entry);
+
+                StackEntry hits[4];
+                uint32_t   hit_count = 0;
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    if ((hit_mask & (1u << i)) != 0 && !(*children)[i].IsInvalid())
+                    {
+                        hits[hit_count++] = {(*children)[i], t_entry[i]};
+                    }
+                }
+
+                // Push the furthest child first so the nearest one is visited next.
+                SortFurthestFirst(hits, hit_count);
+                stack.insert(stack.end(), hits, hits + hit_count);
+            }
+        }
+
+        /// @brief Trace a ray through a BLAS.
+        ///
+        /// @param [in]     blas         The BLAS.
+        /// @param [in,out] ray          The ray, in the space of the BLAS.
+        /// @param [in,out] result       The counts for the ray.
+        /// @param [in]     base_address The address the BLAS is placed at for the cache simulation.
+        /// @param [in]     read         Called with the address and size of each node visited.
+        template <typename ReadFunction>
+        static void TraceBlas(const rta::EncodedRtIp11BottomLevelBvh* blas, Ray& ray, RayResult& result, uint64_t base_address, ReadFunction& read)
+        {
+            // Kept separate from the TLAS stack, since a BLAS is traversed while its instance's TLAS traversal is still in progress.
+            static thread_local std::vector<StackEntry> stack;
+
+            const auto compression_mode = rta::ToDxrTriangleCompressionMode(blas->GetHeader().GetPostBuildInfo().GetTriangleCompressionMode());
+            auto       visit_leaf       = [blas, compression_mode, &ray, &result](const dxr::amd::NodePointer& node_ptr) {
+                if (!node_ptr.IsTriangleNode())
+                {
+                    // Procedural nodes need an intersection shader, so are never hit.
+                    return;
+                }
+
+                const dxr::amd::TriangleNode* triangle_node = blas->GetTriangleNode(node_ptr);
+                float                         t             = 0.0f;
+
+                result.triangle_tests++;
+                if (IntersectTriangle(ray, triangle_node->GetTriangle(dxr::amd::NodeType::kAmdNodeTriangle0, compression_mode), &t))
+                {
+                    ray.t_max  = t;
+                    result.hit = true;
+                }
+
+                if (node_ptr.GetType() == dxr::amd::NodeType::kAmdNodeTriangle1)
+                {
+                    result.triangle_tests++;
+                    if (IntersectTriangle(ray, triangle_node->GetTriangle(dxr::amd::NodeType::kAmdNodeTriangle1, compression_mode), &t))
+                    {
+                        ray.t_max  = t;
+                        result.hit = true;
+                    }
+                }
+            };
+
+            Traverse(blas, ray, stack, result, visit_leaf, base_address, read);
+        }
+
+        /// @brief Transform a ray into the space of an instance.
+        ///
+        /// @param [in] ray       The ray in world space.
+        /// @param [in] transform The world to object transform of the instance.
+        ///
+        /// @return The ray in object space. The direction is not normalized, so distances along the ray are unchanged.
+        static Ray TransformRay(const Ray& ray, const dxr::Matrix3x4& transform)
+        {
+            Ray object_ray = ray;
+            for (int row = 0; row < 3; row++)
+            {
+                const float* m            = &transform[row * 4];
+                object_ray.origin[row]    = m[0] * ray.origin.x + m[1] * ray.origin.y + m[2] * ray.origin.z + m[3];
+                object_ray.direction[row] = m[0] * ray.direction.x + m[1] * ray.direction.y + m[2] * ray.direction.z;
+            }
+            return object_ray;
+        }
+
+        /// @brief A TLAS and its BLASes, looked up once rather than for every instance a ray enters.
+        struct TlasScene
+        {
+            const rta::EncodedRtIp11TopLevelBvh*                 tlas              = nullptr;  ///< The TLAS.
+            std::vector<const rta::EncodedRtIp11BottomLevelBvh*> blases;                       ///< The BLASes, indexed by BLAS index. Empty BLASes are nullptr.
+            uint32_t                                             leaf_nodes_offset = 0;        ///< The offset of the TLAS's instance nodes.
+            uint32_t                                             instance_mask     = 0;        ///< The ray's instance inclusion mask.
+        };
+
+        /// @brief Look up a TLAS and its BLASes.
+        ///
+        /// @param [in]  context       The context holding the loaded trace.
+        /// @param [in]  tlas          The TLAS.
+        /// @param [in]  instance_mask The ray's instance inclusion mask.
+        /// @param [out] out_scene     The TLAS and its BLASes.
+        static void InitializeTlasScene(RraContext* context, const rta::EncodedRtIp11TopLevelBvh* tlas, uint32_t instance_mask, TlasScene& out_scene)
+        {
+            const auto& bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
+
+            out_scene.tlas              = tlas;
+            out_scene.leaf_nodes_offset = tlas->GetHeader().GetBufferOffsets().leaf_nodes;
+            out_scene.instance_mask     = instance_mask;
+            out_scene.blases.assign(bottom_level_bvhs.size(), nullptr);
+            for (size_t blas_index = 0; blas_index < bottom_level_bvhs.size(); blas_index++)
+            {
+                const auto* blas              = dynamic_cast<const rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
+                out_scene.blases[blas_index] = (blas != nullptr && !blas->IsEmpty()) ? blas : nullptr;
+            }
+        }
+
+        /// @brief Trace a ray through a TLAS and the BLASes of the instances it enters.
+        ///
+        /// @param [in]     scene          The TLAS and its BLASes.
+        /// @param [in,out] ray            The ray, in world space.
+        /// @param [in,out] result         The counts for the ray.
+        /// @param [in]     visit_instance Called after each instance is traversed, with the instance index, the BLAS index,
+        ///                                and the ray counts from before and after the traversal.
+        /// @param [in]     read           Called with the address and size of each node visited.
+        template <typename InstanceFunction, typename ReadFunction>
+        static void TraceTlas(const TlasScene& scene, Ray& ray, RayResult& result, InstanceFunction visit_instance, ReadFunction& read)
+        {
+            static thread_local std::vector<StackEntry> stack;
+
+            const auto& instance_nodes = scene.tlas->GetInstanceNodes();
+            auto        visit_leaf     = [&](const dxr::amd::NodePointer& node_ptr) {
+                if (!node_ptr.IsInstanceNode())
+                {
+                    return;
+                }
+                result.instance_visits++;
+
+                uint32_t instance_index = (node_ptr.GetByteOffset() - scene.leaf_nodes_offset) / sizeof(dxr::amd::InstanceNode);
+                if (instance_index >= instance_nodes.size())
+                {
+                    return;
+                }
+
+                const auto& desc = instance_nodes[instance_index].GetDesc();
+                if ((desc.GetMask() & scene.instance_mask) == 0)
+                {
+                    return;
+                }
+
+                uint64_t blas_index = desc.GetBottomLevelBvhGpuVa(dxr::InstanceDescType::kRaw) >> 3;
+                if (blas_index >= scene.blases.size() || scene.blases[blas_index] == nullptr)
+                {
+                    return;
+                }
+
+                Ray       object_ray = TransformRay(ray, desc.GetTransform());
+                RayResult before     = result;
+                TraceBlas(scene.blases[blas_index], object_ray, result, (blas_index + 1) << kBlasAddressShift, read);
+                ray.t_max = object_ray.t_max;
+
+                visit_instance(instance_index, blas_index, before, result);
+            };
+
+            Traverse(scene.tlas, ray, stack, result, visit_leaf, 0, read);
+        }
+
+        /// @brief Add the counts from one instance traversal to the shared counters.
+        ///
+        /// @param [in] counters The shared counters.
+        /// @param [in] before   The ray counts before the instance was traversed.
+        /// @param [in] after    The ray counts after the instance was traversed.
+        static void AddCounters(SharedCounters& counters, const RayResult& before, const RayResult& after)
+        {
+            counters.ray_count.fetch_add(1, std::memory_order_relaxed);
+            counters.node_visits.fetch_add(after.node_visits - before.node_visits, std::memory_order_relaxed);
+            counters.box_node_visits.fetch_add(after.box_node_visits - before.box_node_visits, std::memory_order_relaxed);
+            counters.triangle_tests.fetch_add(after.triangle_tests - before.triangle_tests, std::memory_order_relaxed);
+        }
+
+        /// @brief Copy the shared counters to the caller's array.
+        ///
+        /// @param [in]  counters     The shared counters.
+        /// @param [out] out_counters The array to copy to.
+        static void CopyCounters(const std::vector<SharedCounters>& counters, RraRayCostCounters* out_counters)
+        {
+            for (size_t i = 0; i < counters.size(); i++)
+            {
+                out_counters[i].ray_count       = counters[i].ray_count.load();
+                out_counters[i].node_visits     = counters[i].node_visits.load();
+                out_counters[i].box_node_visits = counters[i].box_node_visits.load();
+                out_counters[i].triangle_tests  = counters[i].triangle_tests.load();
+            }
+        }
+
+        /// @brief Get the bounding box of a BVH from its root node.
+        ///
+        /// @param [in] bvh The BVH.
+        ///
+        /// @return The bounding box.
+        static dxr::amd::AxisAlignedBoundingBox GetBounds(const rta::IEncodedRtIp11Bvh* bvh)
+        {
+            dxr::amd::NodePointer root_ptr(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
+            return bvh->ComputeRootNodeBoundingBox(bvh->GetFloat32Box(root_ptr));
+        }
+    }  // namespace ray_cost
+}  // namespace rra
+
+RraErrorCode RraRayCostGetDefaultConfig(RraRayCostConfig* out_config)
+{
+    RRA_RETURN_ON_ERROR(out_config != nullptr, kRraErrorInvalidPointer);
+
+    *out_config                     = {};
+    out_config->distribution        = kRraRayDistributionUniformSphere;
+    out_config->ray_count           = rra::ray_cost::kDefaultRayCount;
+    out_config->seed                = 0;
+    out_config->thread_count        = 0;
+    out_config->instance_mask       = 0xFF;
+    out_config->camera_fov          = 60.0f;
+    out_config->camera_aspect_ratio = 16.0f / 9.0f;
+    return kRraOk;
+}
+
+RraErrorCode RraRayCostGetDefaultCacheConfig(RraRayCostCacheConfig* out_config)
+{
+    RRA_RETURN_ON_ERROR(out_config != nullptr, kRraErrorInvalidPointer);
+
+    out_config->line_size      = rra::ray_cost::kDefaultCacheLineSize;
+    out_config->associativity  = rra::ray_cost::kDefaultCacheWays;
+    out_config->capacity       = rra::ray_cost::kDefaultCacheCapacity;
+    out_config->page_size      = rra::ray_cost::kDefaultCachePageSize;
+    out_config->ray_group_size = rra::ray_cost::kDefaultCacheRayGroup;
+    return kRraOk;
+}
+
+RraErrorCode RraContextRayCostEstimateBlas(RraContext* context, uint64_t blas_index, const RraRayCostConfig* config, RraRayCostStats* out_stats)
+{
+    RRA_RETURN_ON_ERROR(config != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    RRA_RETURN_ON_ERROR(blas != nullptr, kRraErrorIndexOutOfRange);
+
+    *out_stats = {};
+    if (blas->IsEmpty())
+    {
+        return kRraOk;
+    }
+
+    rra::ray_cost::RayGenerator generator;
+    RraErrorCode                error_code = rra::ray_cost::InitializeRayGenerator(*config, rra::ray_cost::GetBounds(blas), generator);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    auto trace = [blas](rra::ray_cost::Ray& ray, rra::ray_cost::RayResult& result) {
+        rra::ray_cost::IgnoreReads read;
+        rra::ray_cost::TraceBlas(blas, ray, result, 0, read);
+    };
+
+    rra::ray_cost::CastRays(*config, generator, trace, out_stats);
+    return kRraOk;
+}
+
+RraErrorCode RraContextRayCostEstimateTlas(RraContext*             context,
+                                           uint64_t                tlas_index,
+                                           const RraRayCostConfig* config,
+                                           RraRayCostStats*        out_stats,
+                                           RraRayCostCounters*     out_instance_counters,
+                                           RraRayCostCounters*     out_blas_counters)
+{
+    RRA_RETURN_ON_ERROR(config != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    RRA_RETURN_ON_ERROR(tlas != nullptr, kRraErrorIndexOutOfRange);
+
+    rra::ray_cost::TlasScene scene;
+    rra::ray_cost::InitializeTlasScene(context, tlas, config->instance_mask, scene);
+
+    // The instance counters are sized to match RraContextTlasGetInstanceNodeCount().
+    std::vector<rra::ray_cost::SharedCounters> instance_counters(tlas->GetNodeCount(rta::BvhNodeFlags::kIsLeafNode));
+    std::vector<rra::ray_cost::SharedCounters> blas_counters(scene.blases.size());
+
+    *out_stats = {};
+    if (!tlas->IsEmpty())
+    {
+        rra::ray_cost::RayGenerator generator;
+        RraErrorCode                error_code = rra::ray_cost::InitializeRayGenerator(*config, rra::ray_cost::GetBounds(tlas), generator);
+        if (error_code != kRraOk)
+        {
+            return error_code;
+        }
+
+        auto visit_instance = [&instance_counters, &blas_counters](uint32_t                        instance_index,
+                                                                   uint64_t                        blas_index,
+                                                                   const rra::ray_cost::RayResult& before,
+                                                                   const rra::ray_cost::RayResult& after) {
+            if (instance_index < instance_counters.size())
+            {
+                rra::ray_cost::AddCounters(instance_counters[instance_index], before, after);
+            }
+            rra::ray_cost::AddCounters(blas_counters[blas_index], before, after);
+        };
+
+        auto trace = [&scene, &visit_instance](rra::ray_cost::Ray& ray, rra::ray_cost::RayResult& result) {
+            rra::ray_cost::IgnoreReads read;
+            rra::ray_cost::TraceTlas(scene, ray, result, visit_instance, read);
+        };
+
+        rra::ray_cost::CastRays(*config, generator, trace, out_stats);
+    }
+
+    if (out_instance_counters != nullptr)
+    {
+        rra::ray_cost::CopyCounters(instance_counters, out_instance_counters);
+    }
+    if (out_blas_counters != nullptr)
+    {
+        rra::ray_cost::CopyCounters(blas_counters, out_blas_counters);
+    }
+    return kRraOk;
+}
+
+RraErrorCode RraContextRayCostSimulateCacheBlas(RraContext*                  context,
+                                                uint64_t                     blas_index,
+                                                const RraRayCostConfig*      config,
+                                                const RraRayCostCacheConfig* cache_config,
+                                                RraRayCostCacheStats*        out_stats)
+{
+    RRA_RETURN_ON_ERROR(config != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(cache_config != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    RraErrorCode error_code = rra::ray_cost::CacheModel::ValidateConfig(*cache_config);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    RRA_RETURN_ON_ERROR(blas != nullptr, kRraErrorIndexOutOfRange);
+
+    *out_stats = {};
+    if (blas->IsEmpty())
+    {
+        return kRraOk;
+    }
+
+    rra::ray_cost::RayGenerator generator;
+    error_code = rra::ray_cost::InitializeRayGenerator(*config, rra::ray_cost::GetBounds(blas), generator);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    auto trace = [blas](rra::ray_cost::Ray& ray, rra::ray_cost::RayResult& result, rra::ray_cost::CacheModel& cache) {
+        auto read = [&cache](uint64_t address, uint32_t size) { cache.Read(address, size); };
+        rra::ray_cost::TraceBlas(blas, ray, result, 0, read);
+    };
+
+    rra::ray_cost::SimulateCache(*config, *cache_config, generator, trace, out_stats);
+    return kRraOk;
+}
+
+RraErrorCode RraContextRayCostSimulateCacheTlas(RraContext*                  context,
+                                                uint64_t                     tlas_index,
+                                                const RraRayCostConfig*      config,
+                                                const RraRayCostCacheConfig* cache_config,
+                                                RraRayCostCacheStats*        out_stats)
+{
+    RRA_RETURN_ON_ERROR(config != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(cache_config != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    RraErrorCode error_code = rra::ray_cost::CacheModel::ValidateConfig(*cache_config);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    RRA_RETURN_ON_ERROR(tlas != nullptr, kRraErrorIndexOutOfRange);
+
+    *out_stats = {};
+    if (tlas->IsEmpty())
+    {
+        return kRraOk;
+    }
+
+    rra::ray_cost::RayGenerator generator;
+    error_code = rra::ray_cost::InitializeRayGenerator(*config, rra::ray_cost::GetBounds(tlas), generator);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    rra::ray_cost::TlasScene scene;
+    rra::ray_cost::InitializeTlasScene(context, tlas, config->instance_mask, scene);
+
+    auto trace = [&scene](rra::ray_cost::Ray& ray, rra::ray_cost::RayResult& result, rra::ray_cost::CacheModel& cache) {
+        auto read           = [&cache](uint64_t address, uint32_t size) { cache.Read(address, size); };
+        auto visit_instance = [](uint32_t, uint64_t, const rra::ray_cost::RayResult&, const rra::ray_cost::RayResult&) {};
+        rra::ray_cost::TraceTlas(scene, ray, result, visit_instance, read);
+    };
+
+    rra::ray_cost::SimulateCache(*config, *cache_config, generator, trace, out_stats);
+    return kRraOk;
+}
+
+RraErrorCode RraRayCostEstimateBlas(uint64_t blas_index, const RraRayCostConfig* config, RraRayCostStats* out_stats)
+{
+    return RraContextRayCostEstimateBlas(RraContextGetDefault(), blas_index, config, out_stats);
+}
+
+RraErrorCode RraRayCostEstimateTlas(uint64_t                tlas_index,
+                                    const RraRayCostConfig* config,
+                                    RraRayCostStats*        out_stats,
+                                    RraRayCostCounters*     out_instance_counters,
+                                    RraRayCostCounters*     out_blas_counters)
+{
+    return RraContextRayCostEstimateTlas(RraContextGetDefault(), tlas_index, config, out_stats, out_instance_counters, out_blas_counters);
+}
+
+RraErrorCode RraRayCostSimulateCacheBlas(uint64_t                     blas_index,
+                                         const RraRayCostConfig*      config,
+                                         const RraRayCostCacheConfig* cache_config,
+                                         RraRayCostCacheStats*        out_stats)
+{
+    return RraContextRayCostSimulateCacheBlas(RraContextGetDefault(), blas_index, config, cache_config, out_stats);
+}
+
+RraErrorCode RraRayCostSimulateCacheTlas(uint64_t                     tlas_index,
+                                         const RraRayCostConfig*      config,
+                                         const RraRayCostCacheConfig* cache_config,
+                                         RraRayCostCacheStats*        out_stats)
+{
+    return RraContextRayCostSimulateCacheTlas(RraContextGetDefault(), tlas_index, config, cache_config, out_stats);
+}
@@ -0,0 +1,386 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the reference BVH interface.
+//=============================================================================
+
+#include "public/rra_reference_bvh.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "glm/glm/glm.hpp"
+
+#include "bvh/dxr_type_conversion.h"
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
+#include "ray_cost.h"
+#include "reference_bvh.h"
+#include "rra_blas_impl.h"
+#include "rra_context.h"
+#include "surface_area_heuristic.h"
+
+namespace rra
+{
+    namespace reference_bvh
+    {
+        /// @brief A node waiting to be visited while walking a tree.
+        struct WalkEntry
+        {
+            uint32_t node;          ///< The node to visit. A NodePointer for the captured tree, a child index for the reference tree.
+            float    surface_area;  ///< The surface area of the node's bounding box.
+            uint32_t depth;         ///< The depth of the node. The root is at depth 0.
+        };
+
+        /// @brief A node waiting to be visited while tracing a ray through the reference tree.
+        struct StackEntry
+        {
+            uint32_t child;    ///< The child index, as stored in the parent node.
+            float    t_entry;  ///< The distance along the ray to the child's bounding box.
+        };
+
+        /// @brief Get the surface area of a bounding box.
+        ///
+        /// @param [in] box The bounding box.
+        ///
+        /// @return The surface area.
+        static float GetSurfaceArea(const dxr::amd::AxisAlignedBoundingBox& box)
+        {
+            const float dx = std::max(0.0f, box.max.x - box.min.x);
+            const float dy = std::max(0.0f, box.max.y - box.min.y);
+            const float dz = std::max(0.0f, box.max.z - box.min.z);
+            return 2.0f * (dx * dy + dx * dz + dy * dz);
+        }
+
+        /// @brief Get the surface area of a triangle.
+        ///
+        /// @param [in] triangle The triangle.
+        ///
+        /// @return The surface area.
+        static float GetSurfaceArea(const dxr::amd::Triangle& triangle)
+        {
+            const glm::vec3 v0(triangle.v0.x, triangle.v0.y, triangle.v0.z);
+            const glm::vec3 v1(triangle.v1.x, triangle.v1.y, triangle.v1.z);
+            const glm::vec3 v2(triangle.v2.x, triangle.v2.y, triangle.v2.z);
+            return 0.5f * glm::length(glm::cross(v1 - v0, v2 - v0));
+        }
+
+        /// @brief Get the bounding box of a BLAS from its root node.
+        ///
+        /// @param [in] blas The BLAS.
+        ///
+        /// @return The bounding box.
+        static dxr::amd::AxisAlignedBoundingBox GetBounds(const rta::EncodedRtIp11BottomLevelBvh* blas)
+        {
+            dxr::amd::NodePointer root_ptr(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
+            return blas->ComputeRootNodeBoundingBox(blas->GetFloat32Box(root_ptr));
+        }
+
+        /// @brief Get the triangles of a BLAS, decompressed.
+        ///
+        /// @param [in]  context       The context holding the loaded trace.
+        /// @param [in]  blas          The BLAS.
+        /// @param [out] out_triangles The triangles.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+        static RraErrorCode GetBlasTriangles(RraContext* context, const rta::EncodedRtIp11BottomLevelBvh* blas, std::vector<dxr::amd::Triangle>& out_triangles)
+        {
+            std::vector<dxr::amd::NodePointer> triangle_nodes;
+            RraErrorCode                       error_code = GetBlasTriangleNodes(context, blas->GetID(), triangle_nodes);
+            if (error_code != kRraOk)
+            {
+                return error_code;
+            }
+
+            const auto compression_mode = rta::ToDxrTriangleCompressionMode(blas->GetHeader().GetPostBuildInfo().GetTriangleCompressionMode());
+
+            out_triangles.clear();
+            out_triangles.reserve(triangle_nodes.size() * 2);
+            for (const auto& node_ptr : triangle_nodes)
+            {
+                const dxr::amd::TriangleNode* triangle_node = blas->GetTriangleNode(node_ptr);
+                out_triangles.push_back(triangle_node->GetTriangle(dxr::amd::NodeType::kAmdNodeTriangle0, compression_mode));
+                if (node_ptr.GetType() == dxr::amd::NodeType::kAmdNodeTriangle1)
+                {
+                    out_triangles.push_back(triangle_node->GetTriangle(dxr::amd::NodeType::kAmdNodeTriangle1, compression_mode));
+                }
+            }
+            return kRraOk;
+        }
+
+        /// @brief Compute the quality metrics for a captured BLAS.
+        ///
+        /// The average SAH values come from the values calculated at load time, so they match the BLAS view.
+        ///
+        /// @param [in]  blas      The BLAS.
+        /// @param [out] out_stats The metrics.
+        static void GetCapturedTreeStats(const rta::EncodedRtIp11BottomLevelBvh* blas, RraReferenceBvhTreeStats& out_stats)
+        {
+            const dxr::amd::NodePointer root_ptr(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
+            const float                 root_area = GetSurfaceArea(GetBounds(blas));
+
+            out_stats.average_sah          = GetAverageSurfaceAreaHeuristic(blas, root_ptr, false);
+            out_stats.average_triangle_sah = GetAverageSurfaceAreaHeuristic(blas, root_ptr, true);
+            out_stats.max_depth            = blas->GetMaxTreeDepth();
+
+            if (root_area <= 0.0f)
+            {
+                return;
+            }
+
+            float                  sah_cost = 0.0f;
+            std::vector<WalkEntry> stack    = {{root_ptr.GetRawPointer(), root_area, 0}};
+            while (!stack.empty())
+            {
+                const WalkEntry             entry = stack.back();
+                const dxr::amd::NodePointer node_ptr(entry.node);
+                stack.pop_back();
+
+                if (!node_ptr.IsBoxNode())
+                {
+                    // A triangle node holds 1 or 2 triangles, and a procedural node is counted as a single test.
+                    const float primitive_count = (node_ptr.GetType() == dxr::amd::NodeType::kAmdNodeTriangle1) ? 2.0f : 1.0f;
+                    sah_cost += primitive_count * entry.surface_area / root_area;
+                    out_stats.leaf_node_count++;
+                    continue;
+                }
+
+                sah_cost += entry.surface_area / root_area;
+                out_stats.box_node_count++;
+
+                std::array<dxr::amd::AxisAlignedBoundingBox, 4> boxes;
+                const std::array<dxr::amd::NodePointer, 4>*     children = nullptr;
+                if (node_ptr.IsFp32BoxNode())
+                {
+                    const dxr::amd::Float32BoxNode* box_node = blas->GetFloat32Box(node_ptr);
+                    boxes                                    = box_node->GetBoundingBoxes();
+                    children                                 = &box_node->GetChildren();
+                }
+                else
+                {
+                    const dxr::amd::Float16BoxNode* box_node = blas->GetFloat16Box(node_ptr);
+                    boxes                                    = box_node->GetBoundingBoxes();
+                    children                                 = &box_node->GetChildren();
+                }
+
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    if (!(*children)[i].IsInvalid())
+                    {
+                        stack.push_back({(*children)[i].GetRawPointer(), GetSurfaceArea(boxes[i]), entry.depth + 1});
+                    }
+                }
+            }
+
+            out_stats.sah_cost = sah_cost;
+        }
+
+        /// @brief Compute the quality metrics for a reference tree.
+        ///
+        /// The per-node SAH values are calculated the same way as for a captured BLAS, with each leaf holding one triangle.
+        ///
+        /// @param [in]  bvh       The reference tree.
+        /// @param [out] out_stats The metrics.
+        static void GetReferenceTreeStats(const ReferenceBvh& bvh, RraReferenceBvhTreeStats& out_stats)
+        {
+            const float root_area = GetSurfaceArea(bvh.bounds);
+            if (bvh.nodes.empty() || root_area <= 0.0f)
+            {
+                return;
+            }
+
+            float                  sah_cost       = 0.0f;
+            float                  total_sah      = 0.0f;
+            float                  total_leaf_sah = 0.0f;
+            std::vector<WalkEntry> stack          = {{0, root_area, 0}};
+            while (!stack.empty())
+            {
+                const WalkEntry         entry = stack.back();
+                const ReferenceBvhNode& node  = bvh.nodes[entry.node];
+                stack.pop_back();
+
+                sah_cost += entry.surface_area / root_area;
+                out_stats.box_node_count++;
+
+                float total_child_area = 0.0f;
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    const uint32_t child = node.children[i];
+                    if (child == ReferenceBvhNode::kInvalidChild)
+                    {
+                        continue;
+                    }
+
+                    const float child_area = GetSurfaceArea(node.boxes[i]);
+                    if ((child & ReferenceBvhNode::kLeafFlag) == 0)
+                    {
+                        total_child_area += child_area;
+                        stack.push_back({child, child_area, entry.depth + 1});
+                        continue;
+                    }
+
+                    // The leaf's bounding box is the triangle's bounding box.
+                    const float triangle_area = GetSurfaceArea(bvh.triangles[child & ~ReferenceBvhNode::kLeafFlag]);
+                    total_child_area += triangle_area;
+                    total_leaf_sah += GetTriangleSurfaceAreaHeuristic(triangle_area, 1, child_area);
+                    sah_cost += child_area / root_area;
+                    out_stats.leaf_node_count++;
+                    out_stats.max_depth = std::max(out_stats.max_depth, entry.depth + 2);
+                }
+
+                if (entry.surface_area > 0.0f)
+                {
+                    total_sah += total_child_area / entry.surface_area / 4.0f;
+                }
+            }
+
+            const uint64_t node_count      = out_stats.box_node_count + out_stats.leaf_node_count;
+            out_stats.sah_cost             = sah_cost;
+            out_stats.average_sah          = std::min(1.0f, (total_sah + total_leaf_sah) / node_count);
+            out_stats.average_triangle_sah = std::min(1.0f, total_leaf_sah / out_stats.leaf_node_count);
+        }
+
+        /// @brief Trace a ray through a reference tree, counting the work the same way as for a captured BLAS.
+        ///
+        /// @param [in]     bvh    The reference tree.
+        /// @param [in,out] ray    The ray. Its t_max is set to the closest hit.
+        /// @param [in,out] result The counts for the ray.
+        static void TraceReferenceBvh(const ReferenceBvh& bvh, ray_cost::Ray& ray, ray_cost::RayResult& result)
+        {
+            static thread_local std::vector<StackEntry> stack;
+
+            const glm::vec3 inv_direction = ray_cost::GetInverseDirection(ray.direction);
+
+            stack.clear();
+            stack.push_back({0, ray.t_min});
+
+            while (!stack.empty())
+            {
+                StackEntry entry = stack.back();
+                stack.pop_back();
+
+                if (entry.t_entry > ray.t_max)
+                {
+                    continue;
+                }
+
+                result.node_visits++;
+
+                if ((entry.child & ReferenceBvhNode::kLeafFlag) != 0)
+                {
+                    float t = 0.0f;
+                    result.triangle_tests++;
+                    if (ray_cost::IntersectTriangle(ray, bvh.triangles[entry.child & ~ReferenceBvhNode::kLeafFlag], &t))
+                    {
+                        ray.t_max  = t;
+                        result.hit = true;
+                    }
+                    continue;
+                }
+
+                result.box_node_visits++;
+
+                const ReferenceBvhNode& node = bvh.nodes[entry.child];
+                float                   t_entry[4];
+                uint32_t                hit_mask = ray_cost::IntersectChildBoxes(node.boxes, ray.origin, inv_direction, ray.t_min, ray.t_max, t_entry);
+
+                StackEntry hits[4];
+                uint32_t   hit_count = 0;
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    if ((hit_mask & (1u << i)) != 0 && node.children[i] != ReferenceBvhNode::kInvalidChild)
+                    {
+                        hits[hit_count++] = {node.children[i], t_entry[i]};
+                    }
+                }
+
+                // Push the furthest child first so the nearest one is visited next.
+                ray_cost::SortFurthestFirst(hits, hit_count);
+                stack.insert(stack.end(), hits, hits + hit_count);
+            }
+        }
+
+        /// @brief Divide two values, returning 0 if the divisor is 0.
+        ///
+        /// @param [in] numerator   The numerator.
+        /// @param [in] denominator The denominator.
+        ///
+        /// @return The ratio.
+        static float GetRatio(double numerator, double denominator)
+        {
+            return (denominator > 0.0) ? static_cast<float>(numerator / denominator) : 0.0f;
+        }
+    }  // namespace reference_bvh
+}  // namespace rra
+
+RraErrorCode RraContextReferenceBvhCompareBlas(RraContext*             context,
+                                               uint64_t                blas_index,
+                                               uint32_t                thread_count,
+                                               const RraRayCostConfig* ray_cost_config,
+                                               RraReferenceBvhStats*   out_stats)
+{
+    RRA_RETURN_ON_ERROR(out_stats != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(context->data_set.bvh_bundle != nullptr, kRraErrorInvalidPointer);
+
+    const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+    RRA_RETURN_ON_ERROR(blas != nullptr, kRraErrorIndexOutOfRange);
+
+    *out_stats = {};
+    if (blas->IsEmpty())
+    {
+        return kRraOk;
+    }
+
+    std::vector<dxr::amd::Triangle> triangles;
+    RraErrorCode                    error_code = rra::reference_bvh::GetBlasTriangles(context, blas, triangles);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+    out_stats->triangle_count = triangles.size();
+
+    const auto        build_start = std::chrono::steady_clock::now();
+    rra::ReferenceBvh reference;
+    rra::BuildReferenceBvh(std::move(triangles), thread_count, reference);
+    const std::chrono::duration<double, std::milli> build_time = std::chrono::steady_clock::now() - build_start;
+
+    out_stats->build_time_ms              = build_time.count();
+    out_stats->build_triangles_per_second = (build_time.count() > 0.0) ? out_stats->triangle_count * 1000.0 / build_time.count() : 0.0;
+
+    rra::reference_bvh::GetCapturedTreeStats(blas, out_stats->captured);
+    rra::reference_bvh::GetReferenceTreeStats(reference, out_stats->reference);
+    out_stats->sah_cost_ratio = rra::reference_bvh::GetRatio(out_stats->captured.sah_cost, out_stats->reference.sah_cost);
+
+    if (ray_cost_config == nullptr || reference.nodes.empty())
+    {
+        return kRraOk;
+    }
+
+    error_code = RraContextRayCostEstimateBlas(context, blas_index, ray_cost_config, &out_stats->captured.ray_cost);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    // Generate the rays from the captured tree's bounds so that both trees see exactly the same rays.
+    rra::ray_cost::RayGenerator generator;
+    error_code = rra::ray_cost::InitializeRayGenerator(*ray_cost_config, rra::reference_bvh::GetBounds(blas), generator);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    auto trace = [&reference](rra::ray_cost::Ray& ray, rra::ray_cost::RayResult& result) { rra::reference_bvh::TraceReferenceBvh(reference, ray, result); };
+    rra::ray_cost::CastRays(*ray_cost_config, generator, trace, &out_stats->reference.ray_cost);
+
+    out_stats->node_visit_ratio    = rra::reference_bvh::GetRatio(out_stats->captured.ray_cost.mean_node_visits, out_stats->reference.ray_cost.mean_node_visits);
+    out_stats->triangle_test_ratio = rra::reference_bvh::GetRatio(out_stats->captured.ray_cost.mean_triangle_tests, out_stats->reference.ray_cost.mean_triangle_tests);
+    return kRraOk;
+}
+
+RraErrorCode RraReferenceBvhCompareBlas(uint64_t blas_index, uint32_t thread_count, const RraRayCostConfig* ray_cost_config, RraReferenceBvhStats* out_stats)
+{
+    return RraContextReferenceBvhCompareBlas(RraContextGetDefault(), blas_index, thread_count, ray_cost_config, out_stats);
+}
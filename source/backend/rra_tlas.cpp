@@ -9,18 +9,20 @@
 
 #include "rra_tlas_impl.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "bvh/encoded_rt_ip_11_top_level_bvh.h"
 #include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
 #include "public/rra_assert.h"
+#include "job_system.h"
 #include "math_util.h"
 #include "rra_blas_impl.h"
 #include "rra_bvh_impl.h"
+#include "rra_context.h"
 #include "rra_data_set.h"
 #include "surface_area_heuristic.h"
 
-// External reference to the global dataset.
-extern RraDataSet data_set_;
-
 static RraErrorCode GetInstanceNodeFromInstancePointer(const rta::EncodedRtIp11TopLevelBvh* tlas,
                                                        const dxr::amd::NodePointer*         node,
                                                        const dxr::amd::InstanceNode**       out_instance_node)
@@ -88,10 +90,276 @@ static RraErrorCode RraTlasGetBoundingVolumeExtentsImpl(const rta::IEncodedRtIp1
     return kRraOk;
 }
 
-rta::EncodedRtIp11TopLevelBvh* RraTlasGetTlasFromTlasIndex(uint64_t tlas_index)
+/// @brief The minimum number of instance table rows given to each thread, so small tables aren't split.
+static const uint64_t kMinInstanceTableRowsPerThread = 4096;
+
+/// @brief A run of instance table rows taken from the instance list of a single BLAS.
+struct InstanceTableRun
+{
+    uint64_t                     blas_index;      ///< The index of the BLAS referenced by the instances.
+    uint64_t                     first_row;       ///< The table row of the first instance in the list.
+    const dxr::amd::NodePointer* instances;       ///< The instance node list.
+    uint64_t                     instance_count;  ///< The number of instances in the list.
+};
+
+/// @brief Fill in a single row of an instance table.
+///
+/// @param [in]  tlas                The TLAS containing the instance.
+/// @param [in]  run                 The run of rows containing this instance.
+/// @param [in]  blas_instance_index The index of the instance in the instance list of its BLAS.
+/// @param [in]  row                 The table row to write.
+/// @param [out] out_table           The table to write.
+///
+/// @return kRraOk if successful or an RraErrorCode if an error occurred.
+static RraErrorCode FillInstanceTableRow(const rta::EncodedRtIp11TopLevelBvh* tlas,
+                                         const InstanceTableRun&              run,
+                                         uint64_t                             blas_instance_index,
+                                         uint64_t                             row,
+                                         const RraTlasInstanceTable*          out_table)
+{
+    const dxr::amd::NodePointer&  node          = run.instances[blas_instance_index];
+    const dxr::amd::InstanceNode* instance_node = nullptr;
+    RraErrorCode                  error_code    = GetInstanceNodeFromInstancePointer(tlas, &node, &instance_node);
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    const auto& desc = instance_node->GetDesc();
+
+    if (out_table->node_ptr != nullptr)
+    {
+        out_table->node_ptr[row] = node.GetRawPointer();
+    }
+    if (out_table->blas_index != nullptr)
+    {
+        out_table->blas_index[row] = run.blas_index;
+    }
+    if (out_table->blas_instance_index != nullptr)
+    {
+        out_table->blas_instance_index[row] = blas_instance_index;
+    }
+    if (out_table->instance_index != nullptr)
+    {
+        out_table->instance_index[row] = static_cast<uint32_t>(instance_node - tlas->GetInstanceNodes().data());
+    }
+    if (out_table->instance_address != nullptr)
+    {
+        out_table->instance_address[row] = tlas->GetVirtualAddress() + tlas->GetHeader().GetMetaDataSize() + node.GetGpuVirtualAddress();
+    }
+    if (out_table->instance_offset != nullptr)
+    {
+        out_table->instance_offset[row] = node.GetGpuVirtualAddress();
+    }
+    if (out_table->transform != nullptr)
+    {
+        dxr::Matrix3x4 dxr_transform = desc.GetTransform();
+        memcpy(&out_table->transform[row * 12], dxr_transform.data(), dxr::kMatrix3x4Size);
+    }
+    if (out_table->original_transform != nullptr)
+    {
+        dxr::Matrix3x4 original_transform = instance_node->GetExtraData().GetOriginalInstanceTransform();
+        memcpy(&out_table->original_transform[row * 12], original_transform.data(), dxr::kMatrix3x4Size);
+    }
+    if (out_table->mask != nullptr)
+    {
+        out_table->mask[row] = desc.GetMask();
+    }
+    if (out_table->instance_id != nullptr)
+    {
+        out_table->instance_id[row] = desc.GetInstanceID();
+    }
+    if (out_table->hit_group != nullptr)
+    {
+        out_table->hit_group[row] = desc.GetHitGroup();
+    }
+    if (out_table->flags != nullptr)
+    {
+        out_table->flags[row] = static_cast<uint32_t>(desc.GetInstanceFlags());
+    }
+    if (out_table->bounding_volume != nullptr)
+    {
+        error_code = RraTlasGetBoundingVolumeExtentsImpl(tlas, &node, &out_table->bounding_volume[row]);
+    }
+
+    return error_code;
+}
+
+/// @brief Mark a row of an instance table as unread.
+///
+/// The columns known from the instance list are still written, and the rest are zeroed, so nothing
+/// from a partly written row is left behind.
+///
+/// @param [in]  run                 The run of rows containing this instance.
+/// @param [in]  blas_instance_index The index of the instance in the instance list of its BLAS.
+/// @param [in]  row                 The table row to write.
+/// @param [out] out_table           The table to write.
+static void ClearInstanceTableRow(const InstanceTableRun& run, uint64_t blas_instance_index, uint64_t row, const RraTlasInstanceTable* out_table)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    const auto& top_level_bvhs = data_set_.bvh_bundle->GetTopLevelBvhs();
+    if (out_table->node_ptr != nullptr)
+    {
+        out_table->node_ptr[row] = run.instances[blas_instance_index].GetRawPointer();
+    }
+    if (out_table->blas_index != nullptr)
+    {
+        out_table->blas_index[row] = run.blas_index;
+    }
+    if (out_table->blas_instance_index != nullptr)
+    {
+        out_table->blas_instance_index[row] = blas_instance_index;
+    }
+    if (out_table->instance_index != nullptr)
+    {
+        out_table->instance_index[row] = 0;
+    }
+    if (out_table->instance_address != nullptr)
+    {
+        out_table->instance_address[row] = 0;
+    }
+    if (out_table->instance_offset != nullptr)
+    {
+        out_table->instance_offset[row] = 0;
+    }
+    if (out_table->transform != nullptr)
+    {
+        memset(&out_table->transform[row * 12], 0, dxr::kMatrix3x4Size);
+    }
+    if (out_table->original_transform != nullptr)
+    {
+        memset(&out_table->original_transform[row * 12], 0, dxr::kMatrix3x4Size);
+    }
+    if (out_table->mask != nullptr)
+    {
+        out_table->mask[row] = 0;
+    }
+    if (out_table->instance_id != nullptr)
+    {
+        out_table->instance_id[row] = 0;
+    }
+    if (out_table->hit_group != nullptr)
+    {
+        out_table->hit_group[row] = 0;
+    }
+    if (out_table->flags != nullptr)
+    {
+        out_table->flags[row] = 0;
+    }
+    if (out_table->bounding_volume != nullptr)
+    {
+        out_table->bounding_volume[row] = {};
+    }
+}
+
+/// @brief Fill in a contiguous range of instance table rows.
+///
+/// @param [in]  tlas      The TLAS containing the instances.
+/// @param [in]  runs      The runs of rows, sorted by first row.
+/// @param [in]  begin_row The first row to write.
+/// @param [in]  end_row   One past the last row to write.
+/// @param [out] out_table The table to write.
+///
+/// @return The number of rows that couldn't be read.
+static uint64_t FillInstanceTableRows(const rta::EncodedRtIp11TopLevelBvh* tlas,
+                                      const std::vector<InstanceTableRun>& runs,
+                                      uint64_t                             begin_row,
+                                      uint64_t                             end_row,
+                                      const RraTlasInstanceTable*          out_table)
+{
+    // Find the run containing the first row, then walk forward through the runs.
+    auto run_iter = std::upper_bound(
+        runs.begin(), runs.end(), begin_row, [](uint64_t row, const InstanceTableRun& run) { return row < run.first_row; });
+    RRA_ASSERT(run_iter != runs.begin());
+    --run_iter;
+
+    uint64_t row               = begin_row;
+    uint64_t invalid_row_count = 0;
+    for (; run_iter != runs.end() && row < end_row; ++run_iter)
+    {
+        const uint64_t run_size = run_iter->instance_count;
+        for (uint64_t blas_instance_index = row - run_iter->first_row; blas_instance_index < run_size && row < end_row; blas_instance_index++)
+        {
+            const bool valid = FillInstanceTableRow(tlas, *run_iter, blas_instance_index, row, out_table) == kRraOk;
+            if (!valid)
+            {
+                ClearInstanceTableRow(*run_iter, blas_instance_index, row, out_table);
+                invalid_row_count++;
+            }
+            if (out_table->row_valid != nullptr)
+            {
+                out_table->row_valid[row] = valid ? 1 : 0;
+            }
+            row++;
+        }
+    }
+
+    return invalid_row_count;
+}
+
+/// @brief Fill in an instance table from a list of row runs, optionally spreading the rows over several threads.
+///
+/// @param [in]  tlas         The TLAS containing the instances.
+/// @param [in]  runs         The runs of rows, sorted by first row.
+/// @param [in]  row_count    The total number of rows.
+/// @param [in]  thread_count The requested number of threads. 0 uses every job system thread.
+/// @param [out] out_table    The table to write.
+///
+/// @return kRraOk. Rows that can't be read are flagged in the table rather than failing the call.
+static RraErrorCode FillInstanceTable(const rta::EncodedRtIp11TopLevelBvh* tlas,
+                                      const std::vector<InstanceTableRun>& runs,
+                                      uint64_t                             row_count,
+                                      uint32_t                             thread_count,
+                                      const RraTlasInstanceTable*          out_table)
+{
+    if (out_table->invalid_row_count != nullptr)
+    {
+        *out_table->invalid_row_count = 0;
+    }
+
+    if (row_count == 0)
+    {
+        return kRraOk;
+    }
+
+    if (thread_count == 0)
+    {
+        thread_count = rra::JobSystem::Get().GetThreadCount();
+    }
+
+    const uint64_t max_thread_count = std::max<uint64_t>(row_count / kMinInstanceTableRowsPerThread, 1);
+    thread_count                    = static_cast<uint32_t>(std::min<uint64_t>(thread_count, max_thread_count));
+
+    // Each call writes a disjoint range of rows, so the columns can be written without synchronization.
+    std::vector<uint64_t> invalid_row_counts(thread_count, 0);
+    const uint64_t        rows_per_thread = (row_count + thread_count - 1) / thread_count;
+
+    if (thread_count == 1)
+    {
+        invalid_row_counts[0] = FillInstanceTableRows(tlas, runs, 0, row_count, out_table);
+    }
+    else
+    {
+        rra::JobSystem::Get().RunConcurrently(thread_count, [tlas, &runs, row_count, out_table, &invalid_row_counts, rows_per_thread](uint32_t call_index) {
+            const uint64_t begin_row       = call_index * rows_per_thread;
+            const uint64_t end_row         = std::min(begin_row + rows_per_thread, row_count);
+            invalid_row_counts[call_index] = FillInstanceTableRows(tlas, runs, begin_row, end_row, out_table);
+        });
+    }
+
+    if (out_table->invalid_row_count != nullptr)
+    {
+        for (uint64_t invalid_row_count : invalid_row_counts)
+        {
+            *out_table->invalid_row_count += invalid_row_count;
+        }
+    }
+
+    return kRraOk;
+}
+
+rta::EncodedRtIp11TopLevelBvh* RraTlasGetTlasFromTlasIndex(RraContext* context, uint64_t tlas_index)
+{
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    const auto& top_level_bvhs = context->data_set.bvh_bundle->GetTopLevelBvhs();
     if (tlas_index >= top_level_bvhs.size())
     {
         return nullptr;
@@ -99,9 +367,9 @@ rta::EncodedRtIp11TopLevelBvh* RraTlasGetTlasFromTlasIndex(uint64_t tlas_index)
     return dynamic_cast<rta::EncodedRtIp11TopLevelBvh*>(&(*top_level_bvhs[tlas_index]));
 }
 
-RraErrorCode RraTlasGetBaseAddress(uint64_t tlas_index, uint64_t* out_address)
+RraErrorCode RraContextTlasGetBaseAddress(RraContext* context, uint64_t tlas_index, uint64_t* out_address)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -111,9 +379,9 @@ RraErrorCode RraTlasGetBaseAddress(uint64_t tlas_index, uint64_t* out_address)
     return kRraOk;
 }
 
-bool RraTlasIsEmpty(uint64_t tlas_index)
+bool RraContextTlasIsEmpty(RraContext* context, uint64_t tlas_index)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return true;
@@ -122,15 +390,15 @@ bool RraTlasIsEmpty(uint64_t tlas_index)
     return tlas->IsEmpty();
 }
 
-RraErrorCode RraTlasGetTotalNodeCount(uint64_t tlas_index, uint64_t* out_node_count)
+RraErrorCode RraContextTlasGetTotalNodeCount(RraContext* context, uint64_t tlas_index, uint64_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& top_level_bvhs = data_set_.bvh_bundle->GetTopLevelBvhs();
+    const auto& top_level_bvhs = context->data_set.bvh_bundle->GetTopLevelBvhs();
     if (tlas_index >= top_level_bvhs.size())
     {
         return kRraErrorInvalidPointer;
@@ -142,11 +410,11 @@ RraErrorCode RraTlasGetTotalNodeCount(uint64_t tlas_index, uint64_t* out_node_co
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetChildNodeCount(uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_count)
+RraErrorCode RraContextTlasGetChildNodeCount(RraContext* context, uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_count)
 {
     RRA_ASSERT(out_child_count != nullptr);
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    const auto& top_level_bvhs = data_set_.bvh_bundle->GetTopLevelBvhs();
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    const auto& top_level_bvhs = context->data_set.bvh_bundle->GetTopLevelBvhs();
     if (tlas_index >= top_level_bvhs.size())
     {
         return kRraErrorInvalidPointer;
@@ -160,10 +428,10 @@ RraErrorCode RraTlasGetChildNodeCount(uint64_t tlas_index, uint32_t parent_node,
     return RraBvhGetChildNodeCount(tlas, parent_node, out_child_count);
 }
 
-RraErrorCode RraTlasGetChildNodes(uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_nodes)
+RraErrorCode RraContextTlasGetChildNodes(RraContext* context, uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_nodes)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    const auto& top_level_bvhs = data_set_.bvh_bundle->GetTopLevelBvhs();
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    const auto& top_level_bvhs = context->data_set.bvh_bundle->GetTopLevelBvhs();
     if (tlas_index >= top_level_bvhs.size())
     {
         return kRraErrorInvalidPointer;
@@ -177,9 +445,9 @@ RraErrorCode RraTlasGetChildNodes(uint64_t tlas_index, uint32_t parent_node, uin
     return RraBvhGetChildNodes(tlas, parent_node, out_child_nodes);
 }
 
-RraErrorCode RraTlasGetChildNodePtr(uint64_t tlas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr)
+RraErrorCode RraContextTlasGetChildNodePtr(RraContext* context, uint64_t tlas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -187,9 +455,9 @@ RraErrorCode RraTlasGetChildNodePtr(uint64_t tlas_index, uint32_t parent_node, u
     return RraBvhGetChildNodePtr(tlas, parent_node, child_index, out_node_ptr);
 }
 
-RraErrorCode RraTlasGetNodeBaseAddress(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address)
+RraErrorCode RraContextTlasGetNodeBaseAddress(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -202,9 +470,9 @@ RraErrorCode RraTlasGetNodeBaseAddress(uint64_t tlas_index, uint32_t node_ptr, u
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetNodeParentBaseAddress(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address)
+RraErrorCode RraContextTlasGetNodeParentBaseAddress(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -218,9 +486,24 @@ RraErrorCode RraTlasGetNodeParentBaseAddress(uint64_t tlas_index, uint32_t node_
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceNodeInfo(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_address, uint64_t* out_instance_count, bool* out_is_empty)
+RraErrorCode RraContextTlasGetNodeParent(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr)
+{
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    if (tlas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+    return RraBvhGetParentNodePtr(tlas, node_ptr, out_parent_node_ptr);
+}
+
+RraErrorCode RraContextTlasGetInstanceNodeInfo(RraContext* context,
+                                               uint64_t    tlas_index,
+                                               uint32_t    node_ptr,
+                                               uint64_t*   out_blas_address,
+                                               uint64_t*   out_instance_count,
+                                               bool*       out_is_empty)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
 
     if (tlas == nullptr)
     {
@@ -239,7 +522,7 @@ RraErrorCode RraTlasGetInstanceNodeInfo(uint64_t tlas_index, uint32_t node_ptr,
     const auto& desc       = instance_node->GetDesc();
     uint64_t    blas_index = desc.GetBottomLevelBvhGpuVa(dxr::InstanceDescType::kRaw) >> 3;
 
-    const auto& bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    const auto& bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     if (tlas_index >= bottom_level_bvhs.size())
     {
         return kRraErrorInvalidPointer;
@@ -258,9 +541,9 @@ RraErrorCode RraTlasGetInstanceNodeInfo(uint64_t tlas_index, uint32_t node_ptr,
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceCount(uint64_t tlas_index, uint64_t blas_index, uint64_t* out_instance_count)
+RraErrorCode RraContextTlasGetInstanceCount(RraContext* context, uint64_t tlas_index, uint64_t blas_index, uint64_t* out_instance_count)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -270,92 +553,92 @@ RraErrorCode RraTlasGetInstanceCount(uint64_t tlas_index, uint64_t blas_index, u
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetBlasCount(uint64_t tlas_index, uint64_t* out_blas_count)
+RraErrorCode RraContextTlasGetBlasCount(RraContext* context, uint64_t tlas_index, uint64_t* out_blas_count)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    *out_blas_count = tlas->GetBlasCount(data_set_.bvh_bundle->ContainsEmptyPlaceholder());
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    *out_blas_count = tlas->GetBlasCount(context->data_set.bvh_bundle->ContainsEmptyPlaceholder());
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetBoxNodeCount(uint64_t tlas_index, uint64_t* out_node_count)
+RraErrorCode RraContextTlasGetBoxNodeCount(RraContext* context, uint64_t tlas_index, uint64_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const auto& tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     *out_node_count  = tlas->GetNodeCount(rta::BvhNodeFlags::kIsInteriorNode);
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetBox16NodeCount(uint64_t tlas_index, uint32_t* out_node_count)
+RraErrorCode RraContextTlasGetBox16NodeCount(RraContext* context, uint64_t tlas_index, uint32_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const auto& tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     *out_node_count  = tlas->GetHeader().GetInteriorFp16NodeCount();
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetBox32NodeCount(uint64_t tlas_index, uint32_t* out_node_count)
+RraErrorCode RraContextTlasGetBox32NodeCount(RraContext* context, uint64_t tlas_index, uint32_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const auto& tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     *out_node_count  = tlas->GetHeader().GetInteriorFp32NodeCount();
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetHalfBox32NodeCount(uint64_t tlas_index, uint32_t* out_node_count)
+RraErrorCode RraContextTlasGetHalfBox32NodeCount(RraContext* context, uint64_t tlas_index, uint32_t* out_node_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const auto& tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     *out_node_count  = tlas->GetHeader().GetInteriorHalfFp32NodeCount();
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceNodeCount(uint64_t tlas_index, uint64_t* out_instance_count)
+RraErrorCode RraContextTlasGetInstanceNodeCount(RraContext* context, uint64_t tlas_index, uint64_t* out_instance_count)
 {
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    if (data_set_.bvh_bundle.get() == nullptr)
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    if (context->data_set.bvh_bundle.get() == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    const auto& tlas    = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const auto& tlas    = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     *out_instance_count = tlas->GetNodeCount(rta::BvhNodeFlags::kIsLeafNode);
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceNode(uint64_t tlas_index, uint64_t blas_index, uint64_t instance_index, uint32_t* out_node_ptr)
+RraErrorCode RraContextTlasGetInstanceNode(RraContext* context, uint64_t tlas_index, uint64_t blas_index, uint64_t instance_index, uint32_t* out_node_ptr)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -376,9 +659,70 @@ RraErrorCode RraTlasGetInstanceNode(uint64_t tlas_index, uint64_t blas_index, ui
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceNodeTransform(uint64_t tlas_index, uint32_t node_ptr, float* transform)
+RraErrorCode RraContextTlasGetInstanceTableRowCount(RraContext* context, uint64_t tlas_index, uint64_t* out_row_count)
+{
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    if (tlas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    *out_row_count = tlas->GetInstanceListNodes().size();
+    return kRraOk;
+}
+
+RraErrorCode RraContextTlasGetInstanceTable(RraContext* context, uint64_t tlas_index, uint32_t thread_count, const RraTlasInstanceTable* out_table)
+{
+    RRA_ASSERT(out_table != nullptr);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    if (tlas == nullptr || out_table == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    // The instance lists are stored contiguously in BLAS order, so each BLAS is one run of rows.
+    const auto&                   blas_indices = tlas->GetReferencedBlasIndices();
+    const auto&                   offsets      = tlas->GetInstanceListOffsets();
+    const auto&                   instances    = tlas->GetInstanceListNodes();
+    std::vector<InstanceTableRun> runs;
+
+    runs.reserve(blas_indices.size());
+    for (size_t i = 0; i < blas_indices.size(); i++)
+    {
+        runs.push_back({blas_indices[i], offsets[i], &instances[offsets[i]], offsets[i + 1] - offsets[i]});
+    }
+
+    return FillInstanceTable(tlas, runs, instances.size(), thread_count, out_table);
+}
+
+RraErrorCode RraContextTlasGetBlasInstanceTable(RraContext*                 context,
+                                                uint64_t                    tlas_index,
+                                                uint64_t                    blas_index,
+                                                uint32_t                    thread_count,
+                                                const RraTlasInstanceTable* out_table)
+{
+    RRA_ASSERT(out_table != nullptr);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    if (tlas == nullptr || out_table == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    // A BLAS this TLAS doesn't reference has no rows.
+    uint64_t                     instance_count = 0;
+    const dxr::amd::NodePointer* instances      = tlas->GetInstanceList(blas_index, &instance_count);
+    if (instances == nullptr)
+    {
+        instance_count = 0;
+    }
+
+    const std::vector<InstanceTableRun> runs = {{blas_index, 0, instances, instance_count}};
+    return FillInstanceTable(tlas, runs, instance_count, thread_count, out_table);
+}
+
+RraErrorCode RraContextTlasGetInstanceNodeTransform(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* transform)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -399,9 +743,9 @@ RraErrorCode RraTlasGetInstanceNodeTransform(uint64_t tlas_index, uint32_t node_
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetOriginalInstanceNodeTransform(uint64_t tlas_index, uint32_t node_ptr, float* transform)
+RraErrorCode RraContextTlasGetOriginalInstanceNodeTransform(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* transform)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -421,9 +765,9 @@ RraErrorCode RraTlasGetOriginalInstanceNodeTransform(uint64_t tlas_index, uint32
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetBlasIndexFromInstanceNode(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_index)
+RraErrorCode RraContextTlasGetBlasIndexFromInstanceNode(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_index)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -433,7 +777,8 @@ RraErrorCode RraTlasGetBlasIndexFromInstanceNode(uint64_t tlas_index, uint32_t n
     return GetBlasIndexFromInstanceNodeImpl(tlas, node, out_blas_index);
 }
 
-RraErrorCode RraTlasGetBlasFromInstanceNode(const rta::EncodedRtIp11TopLevelBvh*     tlas,
+RraErrorCode RraTlasGetBlasFromInstanceNode(RraContext*                              context,
+                                            const rta::EncodedRtIp11TopLevelBvh*     tlas,
                                             const dxr::amd::NodePointer*             node_ptr,
                                             const rta::EncodedRtIp11BottomLevelBvh** out_blas)
 {
@@ -444,8 +789,8 @@ RraErrorCode RraTlasGetBlasFromInstanceNode(const rta::EncodedRtIp11TopLevelBvh*
         return error_code;
     }
 
-    RRA_ASSERT(data_set_.bvh_bundle.get() != nullptr);
-    const auto& bottom_level_bvhs = data_set_.bvh_bundle->GetBottomLevelBvhs();
+    RRA_ASSERT(context->data_set.bvh_bundle.get() != nullptr);
+    const auto& bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
     if (blas_index >= bottom_level_bvhs.size())
     {
         return kRraErrorInvalidPointer;
@@ -460,9 +805,9 @@ RraErrorCode RraTlasGetBlasFromInstanceNode(const rta::EncodedRtIp11TopLevelBvh*
     return kRraErrorInvalidPointer;
 }
 
-RraErrorCode RraTlasGetBoundingVolumeExtents(uint64_t tlas_index, uint32_t node_ptr, BoundingVolumeExtents* out_extents)
+RraErrorCode RraContextTlasGetBoundingVolumeExtents(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, BoundingVolumeExtents* out_extents)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -472,9 +817,9 @@ RraErrorCode RraTlasGetBoundingVolumeExtents(uint64_t tlas_index, uint32_t node_
     return RraTlasGetBoundingVolumeExtentsImpl(tlas, current_node, out_extents);
 }
 
-RraErrorCode RraTlasGetSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_surface_area_heuristic)
+RraErrorCode RraContextTlasGetSurfaceAreaHeuristic(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_surface_area_heuristic)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -495,9 +840,9 @@ RraErrorCode RraTlasGetSurfaceAreaImpl(const rta::EncodedRtIp11TopLevelBvh* tlas
     return error_code;
 }
 
-RraErrorCode RraTlasGetMinimumSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_max_surface_area_heuristic)
+RraErrorCode RraContextTlasGetMinimumSurfaceAreaHeuristic(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_max_surface_area_heuristic)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -509,9 +854,9 @@ RraErrorCode RraTlasGetMinimumSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetAverageSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_avg_surface_area_heuristic)
+RraErrorCode RraContextTlasGetAverageSurfaceAreaHeuristic(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_avg_surface_area_heuristic)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -523,6 +868,29 @@ RraErrorCode RraTlasGetAverageSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t
     return kRraOk;
 }
 
+RraErrorCode RraContextTlasGetSiblingOverlap(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume)
+{
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    if (tlas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    const dxr::amd::NodePointer* current_node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
+    return RraBvhGetSiblingOverlap(tlas, *current_node, out_overlap_area, out_overlap_volume);
+}
+
+RraErrorCode RraContextTlasGetOverlapStats(RraContext* context, uint64_t tlas_index, RraBvhOverlapStats* out_stats)
+{
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
+    if (tlas == nullptr)
+    {
+        return kRraErrorInvalidPointer;
+    }
+
+    return RraBvhGetOverlapStats(tlas, out_stats);
+}
+
 RraErrorCode RraTlasGetNodeTransformedSurfaceArea(const rta::EncodedRtIp11TopLevelBvh* tlas,
                                                   const dxr::amd::NodePointer*         node_ptr,
                                                   const rta::IEncodedRtIp11Bvh*        volume_bvh,
@@ -562,9 +930,9 @@ RraErrorCode RraTlasGetNodeTransformedSurfaceArea(const rta::EncodedRtIp11TopLev
     return RraBvhGetBoundingVolumeSurfaceArea(&extents, out_surface_area);
 }
 
-RraErrorCode RraTlasGetInstanceIndexFromInstanceNode(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_instance_index)
+RraErrorCode RraContextTlasGetInstanceIndexFromInstanceNode(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_instance_index)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -589,11 +957,11 @@ RraErrorCode RraTlasGetInstanceIndexFromInstanceNode(uint64_t tlas_index, uint32
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceNodeMask(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_mask)
+RraErrorCode RraContextTlasGetInstanceNodeMask(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_mask)
 {
     dxr::amd::NodePointer* node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
 
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -611,11 +979,11 @@ RraErrorCode RraTlasGetInstanceNodeMask(uint64_t tlas_index, uint32_t node_ptr,
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceNodeID(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_id)
+RraErrorCode RraContextTlasGetInstanceNodeID(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_id)
 {
     dxr::amd::NodePointer* node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
 
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -633,11 +1001,11 @@ RraErrorCode RraTlasGetInstanceNodeID(uint64_t tlas_index, uint32_t node_ptr, ui
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceNodeHitGroup(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_hit_group)
+RraErrorCode RraContextTlasGetInstanceNodeHitGroup(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_hit_group)
 {
     dxr::amd::NodePointer* node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
 
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -655,9 +1023,9 @@ RraErrorCode RraTlasGetInstanceNodeHitGroup(uint64_t tlas_index, uint32_t node_p
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetSizeInBytes(uint64_t tlas_index, uint32_t* out_size_in_bytes)
+RraErrorCode RraContextTlasGetSizeInBytes(RraContext* context, uint64_t tlas_index, uint32_t* out_size_in_bytes)
 {
-    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::IEncodedRtIp11Bvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -667,9 +1035,9 @@ RraErrorCode RraTlasGetSizeInBytes(uint64_t tlas_index, uint32_t* out_size_in_by
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetEffectiveSizeInBytes(uint64_t tlas_index, uint64_t* out_size_in_bytes)
+RraErrorCode RraContextTlasGetEffectiveSizeInBytes(RraContext* context, uint64_t tlas_index, uint64_t* out_size_in_bytes)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -679,40 +1047,40 @@ RraErrorCode RraTlasGetEffectiveSizeInBytes(uint64_t tlas_index, uint64_t* out_s
     *out_size_in_bytes = tlas->GetHeader().GetFileSize();
 
     // Add the memory for all referenced BLASes in the TLAS.
-    *out_size_in_bytes += tlas->GetReferencedBlasMemorySize();
+    *out_size_in_bytes += tlas->GetReferencedBlasMemorySize(context);
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetTotalTriangleCount(uint64_t tlas_index, uint64_t* triangle_count)
+RraErrorCode RraContextTlasGetTotalTriangleCount(RraContext* context, uint64_t tlas_index, uint64_t* triangle_count)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    *triangle_count = tlas->GetTotalTriangleCount();
+    *triangle_count = tlas->GetTotalTriangleCount(context);
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetUniqueTriangleCount(uint64_t tlas_index, uint64_t* triangle_count)
+RraErrorCode RraContextTlasGetUniqueTriangleCount(RraContext* context, uint64_t tlas_index, uint64_t* triangle_count)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
     }
 
-    *triangle_count = tlas->GetUniqueTriangleCount();
+    *triangle_count = tlas->GetUniqueTriangleCount(context);
 
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInactiveInstancesCount(uint64_t tlas_index, uint64_t* inactive_count)
+RraErrorCode RraContextTlasGetInactiveInstancesCount(RraContext* context, uint64_t tlas_index, uint64_t* inactive_count)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -723,9 +1091,9 @@ RraErrorCode RraTlasGetInactiveInstancesCount(uint64_t tlas_index, uint64_t* ina
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetBuildFlags(uint64_t tlas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags)
+RraErrorCode RraContextTlasGetBuildFlags(RraContext* context, uint64_t tlas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags)
 {
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -739,11 +1107,11 @@ RraErrorCode RraTlasGetBuildFlags(uint64_t tlas_index, VkBuildAccelerationStruct
     return kRraOk;
 }
 
-RraErrorCode RraTlasGetInstanceFlags(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_flags)
+RraErrorCode RraContextTlasGetInstanceFlags(RraContext* context, uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_flags)
 {
     dxr::amd::NodePointer* node = reinterpret_cast<dxr::amd::NodePointer*>(&node_ptr);
 
-    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(tlas_index);
+    const rta::EncodedRtIp11TopLevelBvh* tlas = RraTlasGetTlasFromTlasIndex(context, tlas_index);
     if (tlas == nullptr)
     {
         return kRraErrorInvalidPointer;
@@ -759,3 +1127,208 @@ RraErrorCode RraTlasGetInstanceFlags(uint64_t tlas_index, uint32_t node_ptr, uin
     *out_flags = static_cast<uint32_t>(instance_node->GetDesc().GetInstanceFlags());
     return kRraOk;
 }
+
+RraErrorCode RraTlasGetBaseAddress(uint64_t tlas_index, uint64_t* out_address)
+{
+    return RraContextTlasGetBaseAddress(RraContextGetDefault(), tlas_index, out_address);
+}
+
+bool RraTlasIsEmpty(uint64_t tlas_index)
+{
+    return RraContextTlasIsEmpty(RraContextGetDefault(), tlas_index);
+}
+
+RraErrorCode RraTlasGetTotalNodeCount(uint64_t tlas_index, uint64_t* out_node_count)
+{
+    return RraContextTlasGetTotalNodeCount(RraContextGetDefault(), tlas_index, out_node_count);
+}
+
+RraErrorCode RraTlasGetChildNodeCount(uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_count)
+{
+    return RraContextTlasGetChildNodeCount(RraContextGetDefault(), tlas_index, parent_node, out_child_count);
+}
+
+RraErrorCode RraTlasGetChildNodes(uint64_t tlas_index, uint32_t parent_node, uint32_t* out_child_nodes)
+{
+    return RraContextTlasGetChildNodes(RraContextGetDefault(), tlas_index, parent_node, out_child_nodes);
+}
+
+RraErrorCode RraTlasGetChildNodePtr(uint64_t tlas_index, uint32_t parent_node, uint32_t child_index, uint32_t* out_node_ptr)
+{
+    return RraContextTlasGetChildNodePtr(RraContextGetDefault(), tlas_index, parent_node, child_index, out_node_ptr);
+}
+
+RraErrorCode RraTlasGetNodeBaseAddress(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address)
+{
+    return RraContextTlasGetNodeBaseAddress(RraContextGetDefault(), tlas_index, node_ptr, out_address);
+}
+
+RraErrorCode RraTlasGetNodeParentBaseAddress(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_address)
+{
+    return RraContextTlasGetNodeParentBaseAddress(RraContextGetDefault(), tlas_index, node_ptr, out_address);
+}
+
+RraErrorCode RraTlasGetNodeParent(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_parent_node_ptr)
+{
+    return RraContextTlasGetNodeParent(RraContextGetDefault(), tlas_index, node_ptr, out_parent_node_ptr);
+}
+
+RraErrorCode RraTlasGetInstanceNodeInfo(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_address, uint64_t* out_instance_count, bool* out_is_empty)
+{
+    return RraContextTlasGetInstanceNodeInfo(RraContextGetDefault(), tlas_index, node_ptr, out_blas_address, out_instance_count, out_is_empty);
+}
+
+RraErrorCode RraTlasGetInstanceCount(uint64_t tlas_index, uint64_t blas_index, uint64_t* out_instance_count)
+{
+    return RraContextTlasGetInstanceCount(RraContextGetDefault(), tlas_index, blas_index, out_instance_count);
+}
+
+RraErrorCode RraTlasGetBlasCount(uint64_t tlas_index, uint64_t* out_blas_count)
+{
+    return RraContextTlasGetBlasCount(RraContextGetDefault(), tlas_index, out_blas_count);
+}
+
+RraErrorCode RraTlasGetBoxNodeCount(uint64_t tlas_index, uint64_t* out_node_count)
+{
+    return RraContextTlasGetBoxNodeCount(RraContextGetDefault(), tlas_index, out_node_count);
+}
+
+RraErrorCode RraTlasGetBox16NodeCount(uint64_t tlas_index, uint32_t* out_node_count)
+{
+    return RraContextTlasGetBox16NodeCount(RraContextGetDefault(), tlas_index, out_node_count);
+}
+
+RraErrorCode RraTlasGetBox32NodeCount(uint64_t tlas_index, uint32_t* out_node_count)
+{
+    return RraContextTlasGetBox32NodeCount(RraContextGetDefault(), tlas_index, out_node_count);
+}
+
+RraErrorCode RraTlasGetHalfBox32NodeCount(uint64_t tlas_index, uint32_t* out_node_count)
+{
+    return RraContextTlasGetHalfBox32NodeCount(RraContextGetDefault(), tlas_index, out_node_count);
+}
+
+RraErrorCode RraTlasGetInstanceNodeCount(uint64_t tlas_index, uint64_t* out_instance_count)
+{
+    return RraContextTlasGetInstanceNodeCount(RraContextGetDefault(), tlas_index, out_instance_count);
+}
+
+RraErrorCode RraTlasGetInstanceNode(uint64_t tlas_index, uint64_t blas_index, uint64_t instance_index, uint32_t* out_node_ptr)
+{
+    return RraContextTlasGetInstanceNode(RraContextGetDefault(), tlas_index, blas_index, instance_index, out_node_ptr);
+}
+
+RraErrorCode RraTlasGetInstanceTableRowCount(uint64_t tlas_index, uint64_t* out_row_count)
+{
+    return RraContextTlasGetInstanceTableRowCount(RraContextGetDefault(), tlas_index, out_row_count);
+}
+
+RraErrorCode RraTlasGetInstanceTable(uint64_t tlas_index, uint32_t thread_count, const RraTlasInstanceTable* out_table)
+{
+    return RraContextTlasGetInstanceTable(RraContextGetDefault(), tlas_index, thread_count, out_table);
+}
+
+RraErrorCode RraTlasGetBlasInstanceTable(uint64_t tlas_index, uint64_t blas_index, uint32_t thread_count, const RraTlasInstanceTable* out_table)
+{
+    return RraContextTlasGetBlasInstanceTable(RraContextGetDefault(), tlas_index, blas_index, thread_count, out_table);
+}
+
+RraErrorCode RraTlasGetInstanceNodeTransform(uint64_t tlas_index, uint32_t node_ptr, float* transform)
+{
+    return RraContextTlasGetInstanceNodeTransform(RraContextGetDefault(), tlas_index, node_ptr, transform);
+}
+
+RraErrorCode RraTlasGetOriginalInstanceNodeTransform(uint64_t tlas_index, uint32_t node_ptr, float* transform)
+{
+    return RraContextTlasGetOriginalInstanceNodeTransform(RraContextGetDefault(), tlas_index, node_ptr, transform);
+}
+
+RraErrorCode RraTlasGetBlasIndexFromInstanceNode(uint64_t tlas_index, uint32_t node_ptr, uint64_t* out_blas_index)
+{
+    return RraContextTlasGetBlasIndexFromInstanceNode(RraContextGetDefault(), tlas_index, node_ptr, out_blas_index);
+}
+
+RraErrorCode RraTlasGetBoundingVolumeExtents(uint64_t tlas_index, uint32_t node_ptr, BoundingVolumeExtents* out_extents)
+{
+    return RraContextTlasGetBoundingVolumeExtents(RraContextGetDefault(), tlas_index, node_ptr, out_extents);
+}
+
+RraErrorCode RraTlasGetSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_surface_area_heuristic)
+{
+    return RraContextTlasGetSurfaceAreaHeuristic(RraContextGetDefault(), tlas_index, node_ptr, out_surface_area_heuristic);
+}
+
+RraErrorCode RraTlasGetMinimumSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_max_surface_area_heuristic)
+{
+    return RraContextTlasGetMinimumSurfaceAreaHeuristic(RraContextGetDefault(), tlas_index, node_ptr, out_max_surface_area_heuristic);
+}
+
+RraErrorCode RraTlasGetAverageSurfaceAreaHeuristic(uint64_t tlas_index, uint32_t node_ptr, float* out_avg_surface_area_heuristic)
+{
+    return RraContextTlasGetAverageSurfaceAreaHeuristic(RraContextGetDefault(), tlas_index, node_ptr, out_avg_surface_area_heuristic);
+}
+
+RraErrorCode RraTlasGetSiblingOverlap(uint64_t tlas_index, uint32_t node_ptr, float* out_overlap_area, float* out_overlap_volume)
+{
+    return RraContextTlasGetSiblingOverlap(RraContextGetDefault(), tlas_index, node_ptr, out_overlap_area, out_overlap_volume);
+}
+
+RraErrorCode RraTlasGetOverlapStats(uint64_t tlas_index, RraBvhOverlapStats* out_stats)
+{
+    return RraContextTlasGetOverlapStats(RraContextGetDefault(), tlas_index, out_stats);
+}
+
+RraErrorCode RraTlasGetInstanceIndexFromInstanceNode(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_instance_index)
+{
+    return RraContextTlasGetInstanceIndexFromInstanceNode(RraContextGetDefault(), tlas_index, node_ptr, out_instance_index);
+}
+
+RraErrorCode RraTlasGetInstanceNodeMask(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_mask)
+{
+    return RraContextTlasGetInstanceNodeMask(RraContextGetDefault(), tlas_index, node_ptr, out_mask);
+}
+
+RraErrorCode RraTlasGetInstanceNodeID(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_id)
+{
+    return RraContextTlasGetInstanceNodeID(RraContextGetDefault(), tlas_index, node_ptr, out_id);
+}
+
+RraErrorCode RraTlasGetInstanceNodeHitGroup(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_hit_group)
+{
+    return RraContextTlasGetInstanceNodeHitGroup(RraContextGetDefault(), tlas_index, node_ptr, out_hit_group);
+}
+
+RraErrorCode RraTlasGetSizeInBytes(uint64_t tlas_index, uint32_t* out_size_in_bytes)
+{
+    return RraContextTlasGetSizeInBytes(RraContextGetDefault(), tlas_index, out_size_in_bytes);
+}
+
+RraErrorCode RraTlasGetEffectiveSizeInBytes(uint64_t tlas_index, uint64_t* out_size_in_bytes)
+{
+    return RraContextTlasGetEffectiveSizeInBytes(RraContextGetDefault(), tlas_index, out_size_in_bytes);
+}
+
+RraErrorCode RraTlasGetTotalTriangleCount(uint64_t tlas_index, uint64_t* triangle_count)
+{
+    return RraContextTlasGetTotalTriangleCount(RraContextGetDefault(), tlas_index, triangle_count);
+}
+
+RraErrorCode RraTlasGetUniqueTriangleCount(uint64_t tlas_index, uint64_t* triangle_count)
+{
+    return RraContextTlasGetUniqueTriangleCount(RraContextGetDefault(), tlas_index, triangle_count);
+}
+
+RraErrorCode RraTlasGetInactiveInstancesCount(uint64_t tlas_index, uint64_t* inactive_count)
+{
+    return RraContextTlasGetInactiveInstancesCount(RraContextGetDefault(), tlas_index, inactive_count);
+}
+
+RraErrorCode RraTlasGetBuildFlags(uint64_t tlas_index, VkBuildAccelerationStructureFlagBitsKHR* out_flags)
+{
+    return RraContextTlasGetBuildFlags(RraContextGetDefault(), tlas_index, out_flags);
+}
+
+RraErrorCode RraTlasGetInstanceFlags(uint64_t tlas_index, uint32_t node_ptr, uint32_t* out_flags)
+{
+    return RraContextTlasGetInstanceFlags(RraContextGetDefault(), tlas_index, node_ptr, out_flags);
+}
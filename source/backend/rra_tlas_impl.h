@@ -13,13 +13,15 @@
 #include "bvh/encoded_rt_ip_11_top_level_bvh.h"
 #include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
 #include "public/rra_tlas.h"
+#include "rra_context.h"
 
 /// @brief Get a pointer to the TLAS from the tlas index passed in.
 ///
+/// @param [in] context           The context holding the loaded trace.
 /// @param [in] tlas_index        The index of the TLAS to retrieve.
 ///
 /// @return  A pointer to the TLAS (or nullptr if it doesn't exist).
-rta::EncodedRtIp11TopLevelBvh* RraTlasGetTlasFromTlasIndex(uint64_t tlas_index);
+rta::EncodedRtIp11TopLevelBvh* RraTlasGetTlasFromTlasIndex(RraContext* context, uint64_t tlas_index);
 
 /// @brief Get the surface area for a given TLAS node.
 ///
@@ -32,12 +34,14 @@ RraErrorCode RraTlasGetSurfaceAreaImpl(const rta::EncodedRtIp11TopLevelBvh* tlas
 
 /// @brief Get the BLAS associated with a given instance node.
 ///
+/// @param [in]  context          The context holding the loaded trace.
 /// @param [in]  tlas             The top level acceleration structure containing the node.
 /// @param [in]  node_ptr         The instance node of interest.
 /// @param [out] out_blas         The BLAS associated with the instance node.
 ///
 /// @return kRraOk if successful or an RraErrorCode if an error occurred.
-RraErrorCode RraTlasGetBlasFromInstanceNode(const rta::EncodedRtIp11TopLevelBvh*     tlas,
+RraErrorCode RraTlasGetBlasFromInstanceNode(RraContext*                              context,
+                                            const rta::EncodedRtIp11TopLevelBvh*     tlas,
                                             const dxr::amd::NodePointer*             node_ptr,
                                             const rta::EncodedRtIp11BottomLevelBvh** out_blas);
 
@@ -0,0 +1,519 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the trace diff interface.
+//=============================================================================
+
+#include "public/rra_trace_diff.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "public/rra_assert.h"
+#include "public/rra_blas.h"
+#include "public/rra_bvh.h"
+#include "public/rra_tlas.h"
+
+#include "rra_blas_impl.h"
+#include "rra_context.h"
+
+#ifndef _WIN32
+#include "public/linux/safe_crt.h"
+#endif
+
+namespace rra
+{
+    /// @brief The statistics for a single BLAS that take part in a diff.
+    struct BlasSnapshot
+    {
+        uint64_t blas_index;       ///< The index of the BLAS in its trace.
+        uint64_t address;          ///< The virtual address of the BLAS.
+        uint64_t geometry_hash;    ///< A hash of the triangle geometry, independent of the BVH layout.
+        uint64_t triangle_count;   ///< The number of triangles.
+        uint64_t node_count;       ///< The total number of nodes.
+        uint64_t box_node_count;   ///< The number of box nodes.
+        uint32_t size_in_bytes;    ///< The size of the BLAS.
+        uint32_t max_depth;        ///< The maximum tree depth.
+        uint32_t avg_depth;        ///< The average tree depth.
+        uint32_t build_flags;      ///< The build flags.
+        float    sah;              ///< The SAH of the root node.
+        bool     compacted;        ///< Was the BLAS compacted.
+    };
+
+    /// @brief The statistics for a single TLAS that take part in a diff.
+    struct TlasSnapshot
+    {
+        uint64_t tlas_index;      ///< The index of the TLAS in its trace.
+        uint64_t address;         ///< The virtual address of the TLAS.
+        uint64_t node_count;      ///< The total number of nodes.
+        uint64_t instance_count;  ///< The number of instance nodes.
+        uint64_t blas_count;      ///< The number of unique BLASes referenced.
+        uint32_t size_in_bytes;   ///< The size of the TLAS.
+        uint32_t build_flags;     ///< The build flags.
+        float    sah;             ///< The SAH of the root node.
+    };
+
+    /// @brief The acceleration structure statistics for a whole trace.
+    struct TraceSnapshot
+    {
+        std::vector<TlasSnapshot> tlases;  ///< The TLAS statistics.
+        std::vector<BlasSnapshot> blases;  ///< The BLAS statistics, excluding missing BLASes.
+    };
+
+    /// @brief A pair of matched acceleration structures, as indices into the snapshot arrays.
+    struct MatchedPair
+    {
+        size_t      index_a;  ///< The index in the first snapshot.
+        size_t      index_b;  ///< The index in the second snapshot.
+        const char* reason;   ///< How the pair was matched.
+    };
+
+    /// @brief Record the statistics for all the acceleration structures in a trace.
+    ///
+    /// @param [in]  context      The context containing the loaded trace.
+    /// @param [out] out_snapshot The statistics for the trace.
+    static void TakeSnapshot(RraContext* context, TraceSnapshot& out_snapshot)
+    {
+        uint32_t root_node  = 0;
+        uint64_t tlas_count = 0;
+        uint64_t blas_count = 0;
+        RraBvhGetRootNodePtr(&root_node);
+        RraContextBvhGetTlasCount(context, &tlas_count);
+        RraContextBvhGetTotalBlasCount(context, &blas_count);
+
+        out_snapshot.tlases.reserve(tlas_count);
+        for (uint64_t tlas_index = 0; tlas_index < tlas_count; tlas_index++)
+        {
+            TlasSnapshot                            tlas        = {};
+            VkBuildAccelerationStructureFlagBitsKHR build_flags = {};
+            tlas.tlas_index                                     = tlas_index;
+
+            RraContextTlasGetBaseAddress(context, tlas_index, &tlas.address);
+            RraContextTlasGetTotalNodeCount(context, tlas_index, &tlas.node_count);
+            RraContextTlasGetInstanceNodeCount(context, tlas_index, &tlas.instance_count);
+            RraContextTlasGetBlasCount(context, tlas_index, &tlas.blas_count);
+            RraContextTlasGetSizeInBytes(context, tlas_index, &tlas.size_in_bytes);
+            RraContextTlasGetBuildFlags(context, tlas_index, &build_flags);
+            if (!RraContextTlasIsEmpty(context, tlas_index))
+            {
+                RraContextTlasGetSurfaceAreaHeuristic(context, tlas_index, root_node, &tlas.sah);
+            }
+            tlas.build_flags = static_cast<uint32_t>(build_flags);
+            out_snapshot.tlases.push_back(tlas);
+        }
+
+        out_snapshot.blases.reserve(blas_count);
+        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        {
+            const rta::EncodedRtIp11BottomLevelBvh* bvh = RraBlasGetBlasFromBlasIndex(context, blas_index);
+            if (bvh == nullptr)
+            {
+                // Missing BLASes have no data to compare.
+                continue;
+            }
+
+            BlasSnapshot                            blas        = {};
+            VkBuildAccelerationStructureFlagBitsKHR build_flags = {};
+            blas.blas_index                                     = blas_index;
+            blas.address                                        = bvh->GetVirtualAddress();
+            blas.compacted                                      = bvh->IsCompacted();
+
+            RraContextBlasGetSizeInBytes(context, blas_index, &blas.size_in_bytes);
+            RraContextBlasGetTotalNodeCount(context, blas_index, &blas.node_count);
+            RraContextBlasGetBoxNodeCount(context, blas_index, &blas.box_node_count);
+            RraContextBlasGetMaxTreeDepth(context, blas_index, &blas.max_depth);
+            RraContextBlasGetAvgTreeDepth(context, blas_index, &blas.avg_depth);
+            RraContextBlasGetBuildFlags(context, blas_index, &build_flags);
+            blas.build_flags = static_cast<uint32_t>(build_flags);
+
+            if (!RraContextBlasIsEmpty(context, blas_index))
+            {
+                uint32_t triangle_count = 0;
+                RraContextBlasGetSurfaceAreaHeuristic(context, blas_index, root_node, &blas.sah);
+                RraContextBlasGetUniqueTriangleCount(context, blas_index, &triangle_count);
+                blas.geometry_hash  = bvh->GetGeometryHash();
+                blas.triangle_count = triangle_count;
+            }
+            out_snapshot.blases.push_back(blas);
+        }
+    }
+
+    /// @brief Match the BLASes in two snapshots.
+    ///
+    /// BLASes are first matched by geometry hash. Where several BLASes share a hash they are paired in
+    /// index order. The remaining BLASes are then matched by virtual address.
+    ///
+    /// @param [in]  snapshot_a     The first snapshot.
+    /// @param [in]  snapshot_b     The second snapshot.
+    /// @param [out] out_matches    The matched pairs.
+    /// @param [out] out_matched_a  Flags for each BLAS in the first snapshot, set if it was matched.
+    /// @param [out] out_matched_b  Flags for each BLAS in the second snapshot, set if it was matched.
+    static void MatchBlases(const TraceSnapshot&      snapshot_a,
+                            const TraceSnapshot&      snapshot_b,
+                            std::vector<MatchedPair>& out_matches,
+                            std::vector<bool>&        out_matched_a,
+                            std::vector<bool>&        out_matched_b)
+    {
+        const auto& blases_a = snapshot_a.blases;
+        const auto& blases_b = snapshot_b.blases;
+
+        out_matched_a.assign(blases_a.size(), false);
+        out_matched_b.assign(blases_b.size(), false);
+
+        // Geometry hash to the list of unmatched BLASes in the second trace, in index order.
+        std::unordered_map<uint64_t, std::vector<size_t>> geometry_map;
+        for (size_t i = 0; i < blases_b.size(); i++)
+        {
+            if (blases_b[i].geometry_hash != 0)
+            {
+                geometry_map[blases_b[i].geometry_hash].push_back(i);
+            }
+        }
+        for (auto& entry : geometry_map)
+        {
+            std::reverse(entry.second.begin(), entry.second.end());
+        }
+
+        for (size_t i = 0; i < blases_a.size(); i++)
+        {
+            if (blases_a[i].geometry_hash == 0)
+            {
+                continue;
+            }
+
+            auto it = geometry_map.find(blases_a[i].geometry_hash);
+            if (it != geometry_map.end() && !it->second.empty())
+            {
+                size_t index_b = it->second.back();
+                it->second.pop_back();
+                out_matches.push_back({i, index_b, "geometry"});
+                out_matched_a[i]       = true;
+                out_matched_b[index_b] = true;
+            }
+        }
+
+        std::unordered_map<uint64_t, size_t> address_map;
+        for (size_t i = 0; i < blases_b.size(); i++)
+        {
+            if (!out_matched_b[i])
+            {
+                address_map.emplace(blases_b[i].address, i);
+            }
+        }
+
+        for (size_t i = 0; i < blases_a.size(); i++)
+        {
+            if (out_matched_a[i])
+            {
+                continue;
+            }
+
+            auto it = address_map.find(blases_a[i].address);
+            if (it != address_map.end())
+            {
+                out_matches.push_back({i, it->second, "address"});
+                out_matched_a[i]          = true;
+                out_matched_b[it->second] = true;
+                address_map.erase(it);
+            }
+        }
+    }
+
+    /// @brief Match the TLASes in two snapshots, by virtual address and then by index.
+    ///
+    /// @param [in]  snapshot_a  The first snapshot.
+    /// @param [in]  snapshot_b  The second snapshot.
+    /// @param [out] out_matches The matched pairs.
+    static void MatchTlases(const TraceSnapshot& snapshot_a, const TraceSnapshot& snapshot_b, std::vector<MatchedPair>& out_matches)
+    {
+        const auto& tlases_a = snapshot_a.tlases;
+        const auto& tlases_b = snapshot_b.tlases;
+
+        std::vector<bool>                    matched_a(tlases_a.size(), false);
+        std::vector<bool>                    matched_b(tlases_b.size(), false);
+        std::unordered_map<uint64_t, size_t> address_map;
+        for (size_t i = 0; i < tlases_b.size(); i++)
+        {
+            address_map.emplace(tlases_b[i].address, i);
+        }
+
+        for (size_t i = 0; i < tlases_a.size(); i++)
+        {
+            auto it = address_map.find(tlases_a[i].address);
+            if (it != address_map.end())
+            {
+                out_matches.push_back({i, it->second, "address"});
+                matched_a[i]          = true;
+                matched_b[it->second] = true;
+                address_map.erase(it);
+            }
+        }
+
+        for (size_t i = 0; i < tlases_a.size() && i < tlases_b.size(); i++)
+        {
+            if (!matched_a[i] && !matched_b[i])
+            {
+                out_matches.push_back({i, i, "index"});
+            }
+        }
+    }
+
+    /// @brief Get the difference between two unsigned values as a signed value.
+    ///
+    /// @param [in] value_a The first value.
+    /// @param [in] value_b The second value.
+    ///
+    /// @return value_b - value_a.
+    static int64_t Delta(uint64_t value_a, uint64_t value_b)
+    {
+        return static_cast<int64_t>(value_b) - static_cast<int64_t>(value_a);
+    }
+
+    /// @brief Append a JSON number field to a string.
+    ///
+    /// @param [in,out] json  The string to append to.
+    /// @param [in]     name  The field name.
+    /// @param [in]     value The field value.
+    template <typename T>
+    static void AppendField(std::string& json, const char* name, T value)
+    {
+        json += std::string(", \"") + name + "\": " + std::to_string(value);
+    }
+
+    /// @brief Append a JSON floating point field to a string.
+    ///
+    /// JSON has no NaN or infinity, so a value that isn't finite is written as null.
+    ///
+    /// @param [in,out] json  The string to append to.
+    /// @param [in]     name  The field name.
+    /// @param [in]     value The field value.
+    static void AppendField(std::string& json, const char* name, float value)
+    {
+        json += std::string(", \"") + name + "\": ";
+        if (!std::isfinite(value))
+        {
+            json += "null";
+            return;
+        }
+
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.9g", value);
+        json += buffer;
+    }
+
+    /// @brief Write the diff report as JSON.
+    ///
+    /// @param [in] report_file_name The file to write to.
+    /// @param [in] report           The report contents.
+    ///
+    /// @return kRraOk if successful or an RraErrorCode if an error occurred.
+    static RraErrorCode WriteReport(const char* report_file_name, const std::string& report)
+    {
+        FILE* report_file = nullptr;
+        fopen_s(&report_file, report_file_name, "wb");
+        if (report_file == nullptr)
+        {
+            return kRraErrorInvalidPath;
+        }
+
+        size_t written = fwrite(report.data(), 1, report.size(), report_file);
+        fclose(report_file);
+        return (written == report.size()) ? kRraOk : kRraErrorInvalidPath;
+    }
+}  // namespace rra
+
+RraErrorCode RraTraceDiff(const char* trace_file_name_a, const char* trace_file_name_b, const char* report_file_name, RraTraceDiffSummary* out_summary)
+{
+    RRA_RETURN_ON_ERROR(trace_file_name_a != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(trace_file_name_b != nullptr, kRraErrorInvalidPointer);
+
+    // Load both traces into contexts of their own, leaving any trace already loaded untouched.
+    RraContext* context_a = nullptr;
+    RraContext* context_b = nullptr;
+    RRA_BUBBLE_ON_ERROR(RraContextCreate(&context_a));
+    RraErrorCode error_code = RraContextCreate(&context_b);
+    if (error_code == kRraOk)
+    {
+        error_code = RraContextLoadTrace(context_a, trace_file_name_a);
+    }
+    if (error_code == kRraOk)
+    {
+        error_code = RraContextLoadTrace(context_b, trace_file_name_b);
+    }
+
+    rra::TraceSnapshot snapshot_a;
+    rra::TraceSnapshot snapshot_b;
+    if (error_code == kRraOk)
+    {
+        rra::TakeSnapshot(context_a, snapshot_a);
+        rra::TakeSnapshot(context_b, snapshot_b);
+    }
+
+    RraContextDestroy(context_a);
+    if (context_b != nullptr)
+    {
+        RraContextDestroy(context_b);
+    }
+    if (error_code != kRraOk)
+    {
+        return error_code;
+    }
+
+    std::vector<rra::MatchedPair> blas_matches;
+    std::vector<rra::MatchedPair> tlas_matches;
+    std::vector<bool>             blas_matched_a;
+    std::vector<bool>             blas_matched_b;
+    rra::MatchBlases(snapshot_a, snapshot_b, blas_matches, blas_matched_a, blas_matched_b);
+    rra::MatchTlases(snapshot_a, snapshot_b, tlas_matches);
+
+    RraTraceDiffSummary summary = {};
+    summary.tlas_count_a        = snapshot_a.tlases.size();
+    summary.tlas_count_b        = snapshot_b.tlases.size();
+    summary.blas_count_a        = snapshot_a.blases.size();
+    summary.blas_count_b        = snapshot_b.blases.size();
+
+    for (const auto& tlas : snapshot_a.tlases)
+    {
+        summary.total_tlas_size_delta -= tlas.size_in_bytes;
+    }
+    for (const auto& tlas : snapshot_b.tlases)
+    {
+        summary.total_tlas_size_delta += tlas.size_in_bytes;
+    }
+    for (const auto& blas : snapshot_a.blases)
+    {
+        summary.total_blas_size_delta -= blas.size_in_bytes;
+    }
+    for (const auto& blas : snapshot_b.blases)
+    {
+        summary.total_blas_size_delta += blas.size_in_bytes;
+    }
+
+    std::string report = "{\n  \"blas_matches\": [\n";
+    bool        first  = true;
+    for (const auto& match : blas_matches)
+    {
+        const rra::BlasSnapshot& a = snapshot_a.blases[match.index_a];
+        const rra::BlasSnapshot& b = snapshot_b.blases[match.index_b];
+
+        if (match.reason[0] == 'g')
+        {
+            summary.matched_by_geometry++;
+        }
+        else
+        {
+            summary.matched_by_address++;
+        }
+
+        bool changed = a.size_in_bytes != b.size_in_bytes || a.node_count != b.node_count || a.box_node_count != b.box_node_count ||
+                       a.max_depth != b.max_depth || a.avg_depth != b.avg_depth || a.build_flags != b.build_flags || a.sah != b.sah ||
+                       a.compacted != b.compacted || a.geometry_hash != b.geometry_hash;
+        if (!changed)
+        {
+            continue;
+        }
+        summary.changed_blas_count++;
+
+        bool regressed = b.size_in_bytes > a.size_in_bytes || b.sah > a.sah * (1.0f + kRraTraceDiffSahTolerance);
+        if (regressed)
+        {
+            summary.regressed_blas_count++;
+        }
+
+        report += first ? "" : ",\n";
+        first = false;
+        report += "    {\"match\": \"" + std::string(match.reason) + "\"";
+        rra::AppendField(report, "blas_index_a", a.blas_index);
+        rra::AppendField(report, "blas_index_b", b.blas_index);
+        rra::AppendField(report, "address_a", a.address);
+        rra::AppendField(report, "address_b", b.address);
+        rra::AppendField(report, "size_delta", rra::Delta(a.size_in_bytes, b.size_in_bytes));
+        rra::AppendField(report, "node_count_delta", rra::Delta(a.node_count, b.node_count));
+        rra::AppendField(report, "box_node_count_delta", rra::Delta(a.box_node_count, b.box_node_count));
+        rra::AppendField(report, "triangle_count_delta", rra::Delta(a.triangle_count, b.triangle_count));
+        rra::AppendField(report, "max_depth_delta", rra::Delta(a.max_depth, b.max_depth));
+        rra::AppendField(report, "avg_depth_delta", rra::Delta(a.avg_depth, b.avg_depth));
+        rra::AppendField(report, "sah_a", a.sah);
+        rra::AppendField(report, "sah_b", b.sah);
+        rra::AppendField(report, "compacted_a", a.compacted ? 1 : 0);
+        rra::AppendField(report, "compacted_b", b.compacted ? 1 : 0);
+        rra::AppendField(report, "build_flags_a", a.build_flags);
+        rra::AppendField(report, "build_flags_b", b.build_flags);
+        rra::AppendField(report, "regressed", regressed ? 1 : 0);
+        report += "}";
+    }
+
+    report += "\n  ],\n  \"blas_removed\": [";
+    for (size_t i = 0; i < blas_matched_a.size(); i++)
+    {
+        if (!blas_matched_a[i])
+        {
+            report += (summary.removed_blas_count++ == 0) ? "" : ", ";
+            report += std::to_string(snapshot_a.blases[i].blas_index);
+        }
+    }
+
+    report += "],\n  \"blas_added\": [";
+    for (size_t i = 0; i < blas_matched_b.size(); i++)
+    {
+        if (!blas_matched_b[i])
+        {
+            report += (summary.added_blas_count++ == 0) ? "" : ", ";
+            report += std::to_string(snapshot_b.blases[i].blas_index);
+        }
+    }
+
+    report += "],\n  \"tlas_matches\": [\n";
+    first = true;
+    for (const auto& match : tlas_matches)
+    {
+        const rra::TlasSnapshot& a = snapshot_a.tlases[match.index_a];
+        const rra::TlasSnapshot& b = snapshot_b.tlases[match.index_b];
+
+        report += first ? "" : ",\n";
+        first = false;
+        report += "    {\"match\": \"" + std::string(match.reason) + "\"";
+        rra::AppendField(report, "tlas_index_a", a.tlas_index);
+        rra::AppendField(report, "tlas_index_b", b.tlas_index);
+        rra::AppendField(report, "size_delta", rra::Delta(a.size_in_bytes, b.size_in_bytes));
+        rra::AppendField(report, "node_count_delta", rra::Delta(a.node_count, b.node_count));
+        rra::AppendField(report, "instance_count_delta", rra::Delta(a.instance_count, b.instance_count));
+        rra::AppendField(report, "blas_count_delta", rra::Delta(a.blas_count, b.blas_count));
+        rra::AppendField(report, "sah_a", a.sah);
+        rra::AppendField(report, "sah_b", b.sah);
+        rra::AppendField(report, "build_flags_a", a.build_flags);
+        rra::AppendField(report, "build_flags_b", b.build_flags);
+        report += "}";
+    }
+
+    report += "\n  ],\n  \"summary\": {\"blas_count_a\": " + std::to_string(summary.blas_count_a);
+    rra::AppendField(report, "blas_count_b", summary.blas_count_b);
+    rra::AppendField(report, "tlas_count_a", summary.tlas_count_a);
+    rra::AppendField(report, "tlas_count_b", summary.tlas_count_b);
+    rra::AppendField(report, "matched_by_geometry", summary.matched_by_geometry);
+    rra::AppendField(report, "matched_by_address", summary.matched_by_address);
+    rra::AppendField(report, "added", summary.added_blas_count);
+    rra::AppendField(report, "removed", summary.removed_blas_count);
+    rra::AppendField(report, "changed", summary.changed_blas_count);
+    rra::AppendField(report, "regressed", summary.regressed_blas_count);
+    rra::AppendField(report, "total_blas_size_delta", summary.total_blas_size_delta);
+    rra::AppendField(report, "total_tlas_size_delta", summary.total_tlas_size_delta);
+    report += "}\n}\n";
+
+    if (report_file_name != nullptr)
+    {
+        RRA_BUBBLE_ON_ERROR(rra::WriteReport(report_file_name, report));
+    }
+
+    if (out_summary != nullptr)
+    {
+        *out_summary = summary;
+    }
+    return kRraOk;
+}
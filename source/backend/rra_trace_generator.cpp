@@ -0,0 +1,46 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the synthetic trace generator interface.
+//=============================================================================
+
+#include "public/rra_trace_generator.h"
+
+#include "trace_generator.h"
+
+RraErrorCode RraTraceGeneratorGetDefaultConfig(RraTraceGeneratorConfig* out_config)
+{
+    RRA_RETURN_ON_ERROR(out_config != nullptr, kRraErrorInvalidPointer);
+
+    out_config->blas_count                = 16;
+    out_config->triangles_per_blas        = 4096;
+    out_config->instance_count            = 64;
+    out_config->inactive_instance_count   = 0;
+    out_config->tree_shape                = kRraTraceGeneratorTreeShapeMedian;
+    out_config->triangle_compression_mode = kRraTriangleCompressionModePairTriangles;
+    out_config->box_fp16_mode             = kRraBoxFp16ModeNone;
+    out_config->fp16_tolerance            = 0.01f;
+    out_config->seed                      = 0;
+    return kRraOk;
+}
+
+RraErrorCode RraTraceGeneratorWrite(const char* file_path, const RraTraceGeneratorConfig* config, RraTraceGeneratorStats* out_stats)
+{
+    RRA_RETURN_ON_ERROR(file_path != nullptr, kRraErrorInvalidPointer);
+    RRA_RETURN_ON_ERROR(config != nullptr, kRraErrorInvalidPointer);
+
+    const RraErrorCode validate_code = rra::ValidateTraceGeneratorConfig(*config);
+    if (validate_code != kRraOk)
+    {
+        return validate_code;
+    }
+
+    RraTraceGeneratorStats stats      = {};
+    const RraErrorCode     error_code = rra::GenerateTrace(file_path, *config, stats);
+    if (error_code == kRraOk && out_stats != nullptr)
+    {
+        *out_stats = stats;
+    }
+    return error_code;
+}
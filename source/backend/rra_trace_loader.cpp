@@ -7,45 +7,24 @@
 
 #include "public/rra_trace_loader.h"
 
-#include <string.h>
-
-#include "rra_data_set.h"
-#include "surface_area_heuristic.h"
-
-/// The one and only instance of the data set, which is initialized when loading in
-/// a trace file.
-RraDataSet data_set_ = {};
+#include "rra_context.h"
 
 RraErrorCode RraTraceLoaderLoad(const char* trace_file_name)
 {
-    RraErrorCode error_code = RraDataSetInitialize(trace_file_name, &data_set_);
-
-    if (error_code == kRraOk)
-    {
-        rra::CalculateSurfaceAreaHeuristics(data_set_);
-    }
-    else
-    {
-        data_set_ = {};
-    }
-    return error_code;
+    return RraContextLoadTrace(RraContextGetDefault(), trace_file_name);
 }
 
 void RraTraceLoaderUnload()
 {
-    if (RraTraceLoaderValid())
-    {
-        RraDataSetDestroy(&data_set_);
-    }
-    data_set_ = {};
+    RraContextUnloadTrace(RraContextGetDefault());
 }
 
 bool RraTraceLoaderValid()
 {
-    return data_set_.file_loaded;
+    return RraContextIsTraceLoaded(RraContextGetDefault());
 }
 
 time_t RraTraceLoaderGetCreateTime()
 {
-    return data_set_.create_time;
+    return RraContextGetTraceCreateTime(RraContextGetDefault());
 }
@@ -10,20 +10,21 @@
 #include <float.h>
 #include <math.h>
 
+#include <vector>
+
 #include "bvh/iencoded_rt_ip_11_bvh.h"
 #include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
 #include "bvh/encoded_rt_ip_11_top_level_bvh.h"
 #include "bvh/dxr_definitions.h"
+#include "job_system.h"
 #include "public/rra_assert.h"
 #include "public/rra_error.h"
 #include "rra_bvh_impl.h"
 #include "rra_blas_impl.h"
+#include "rra_context.h"
 #include "rra_data_set.h"
 #include "rra_tlas_impl.h"
 
-// External reference to the global dataset.
-extern RraDataSet data_set_;
-
 namespace rra
 {
     /// @brief Find the minimum value of 3 provided values.
@@ -152,11 +153,12 @@ namespace rra
     /// The BLAS will be traversed starting at the provided node given and the surface area heuristic will be
     /// calculated for each child node.
     ///
+    /// @param [in] context   The context holding the loaded trace.
     /// @param [in] blas      The bottom level acceleration structure to use.
     /// @param [in] root_node The root node of the BLAS to start from.
     ///
     /// @return The surface area heuristic for the node passed in.
-    static float CalculateSAHForBlasNode(rta::EncodedRtIp11BottomLevelBvh* blas, const dxr::amd::NodePointer root_node)
+    static float CalculateSAHForBlasNode(RraContext* context, rta::EncodedRtIp11BottomLevelBvh* blas, const dxr::amd::NodePointer root_node)
     {
         float sah          = 0.0f;
         float sub_tree_sah = 0.0f;
@@ -178,8 +180,8 @@ namespace rra
             {
                 // find SAH for child nodes.
                 const auto child_node = child_array[child_index];
-                sub_tree_sah += CalculateSAHForBlasNode(blas, child_node);
-                if (RraBlasGetSurfaceAreaImpl(blas, &child_node, &out_surface_area) == kRraOk)
+                sub_tree_sah += CalculateSAHForBlasNode(context, blas, child_node);
+                if (RraBlasGetSurfaceAreaImpl(context, blas, &child_node, &out_surface_area) == kRraOk)
                 {
                     total_child_area += static_cast<float>(out_surface_area);
                 }
@@ -187,7 +189,7 @@ namespace rra
 
             // Take that as ratio of the current node.
             out_surface_area = 0.0;
-            if (RraBlasGetSurfaceAreaImpl(blas, &root_node, &out_surface_area) == kRraOk)
+            if (RraBlasGetSurfaceAreaImpl(context, blas, &root_node, &out_surface_area) == kRraOk)
             {
                 sah = total_child_area / (static_cast<float>(out_surface_area)) / 4.0f;
             }
@@ -213,11 +215,12 @@ namespace rra
     /// The TLAS will be traversed starting at the provided node given and the surface area heuristic will be
     /// calculated for each child node.
     ///
+    /// @param [in] context   The context holding the loaded trace.
     /// @param [in] tlas      The top level acceleration structure to use.
     /// @param [in] root_node The root node of the BLAS to start from.
     ///
     /// @return The surface area heuristic for the node passed in.
-    static float CalculateSAHForTlasNode(rta::EncodedRtIp11TopLevelBvh* tlas, const dxr::amd::NodePointer root_node)
+    static float CalculateSAHForTlasNode(RraContext* context, rta::EncodedRtIp11TopLevelBvh* tlas, const dxr::amd::NodePointer root_node)
     {
         float sah          = 0.0f;
         float sub_tree_sah = 0.0f;
@@ -240,7 +243,7 @@ namespace rra
             {
                 // Find SAH for child nodes.
                 const auto child_node = child_array[child_index];
-                sub_tree_sah += CalculateSAHForTlasNode(tlas, child_node);
+                sub_tree_sah += CalculateSAHForTlasNode(context, tlas, child_node);
                 if (RraTlasGetSurfaceAreaImpl(tlas, &child_node, &out_surface_area) == kRraOk)
                 {
                     total_child_area += static_cast<float>(out_surface_area);
@@ -267,7 +270,7 @@ namespace rra
         {
             // Get SAH from BLAS since it's already been computed for triangle nodes.
             const rta::EncodedRtIp11BottomLevelBvh* blas = nullptr;
-            if (RraTlasGetBlasFromInstanceNode(tlas, &root_node, &blas) == kRraOk)
+            if (RraTlasGetBlasFromInstanceNode(context, tlas, &root_node, &blas) == kRraOk)
             {
                 sub_tree_sah     = blas->GetSurfaceAreaHeuristic();
                 float child_area = 0.0f;
@@ -313,57 +316,75 @@ namespace rra
 
     /// @brief Get all the triangle NodePointers from the BLAS
     ///
+    /// @param [in] context The context holding the loaded trace.
     /// @param [in] blas_index Index of BLAS to get the triangle NodePointers from.
     /// @param [out] triangle_nodes The triangle nodes are written into this vector.
     ///
     /// @returns The error code.
-    RraErrorCode GetBlasTriangleNodes(uint64_t blas_index, std::vector<dxr::amd::NodePointer>& triangle_nodes)
+    RraErrorCode GetBlasTriangleNodes(RraContext* context, uint64_t blas_index, std::vector<dxr::amd::NodePointer>& triangle_nodes)
     {
-        uint32_t root_node = UINT32_MAX;
-        RRA_BUBBLE_ON_ERROR(RraBvhGetRootNodePtr(&root_node));
+        const rta::EncodedRtIp11BottomLevelBvh* blas = RraBlasGetBlasFromBlasIndex(context, blas_index);
+        RRA_RETURN_ON_ERROR(blas != nullptr, kRraErrorInvalidPointer);
 
-        uint32_t              child_node_count;
-        uint32_t              triangle_count;
-        std::vector<uint32_t> traverse_nodes = {root_node};
-        std::vector<uint32_t> swap_nodes;
-
-        // Memoized traversal of the tree.
-        while (!traverse_nodes.empty())
+        if (blas->IsEmpty())
         {
-            swap_nodes.clear();
+            return kRraOk;
+        }
 
-            for (size_t i = 0; i < traverse_nodes.size(); i++)
+        // The leaf nodes were gathered in breadth-first order by the post-load scan.
+        for (const auto& node_ptr : blas->GetLeafNodes())
+        {
+            // Only keep triangle nodes with 1 or more triangles within.
+            if (node_ptr.GetType() == dxr::amd::NodeType::kAmdNodeTriangle0 || node_ptr.GetType() == dxr::amd::NodeType::kAmdNodeTriangle1)
             {
-                uint32_t current_node = traverse_nodes[i];
+                triangle_nodes.push_back(node_ptr);
+            }
+        }
+        return kRraOk;
+    }
 
-                // Add the triangles to the list.
-                RRA_BUBBLE_ON_ERROR(RraBlasGetChildNodeCount(blas_index, current_node, &child_node_count));
-                std::vector<uint32_t> child_nodes(child_node_count);
-                RRA_BUBBLE_ON_ERROR(RraBlasGetChildNodes(blas_index, current_node, child_nodes.data()));
-                swap_nodes.insert(swap_nodes.end(), child_nodes.begin(), child_nodes.end());
+    float GetTriangleSurfaceAreaHeuristic(float triangle_surface_area, uint32_t tri_count, float aabb_surface_area)
+    {
+        float triangle_avg_surface_area = triangle_surface_area / tri_count;
+        float sah                       = 0.0f;
 
-                // Get the triangle nodes. If this is not a triangle the triangle count is 0.
-                RRA_BUBBLE_ON_ERROR(RraBlasGetNodeTriangleCount(blas_index, current_node, &triangle_count));
+        // Make sure the surface area of the triangle bounding volume is larger than the triangle surface area.
+        if (aabb_surface_area >= triangle_surface_area && aabb_surface_area > FLT_MIN)
+        {
+            // Multiply triangle area by 2, to account for probability of ray going through front or back face.
+            sah = (2.0f * triangle_avg_surface_area) / aabb_surface_area;
 
-                // Continue with processing the node if it's a triangle node with 1 or more triangles within.
-                if (triangle_count > 0)
-                {
-                    triangle_nodes.push_back(dxr::amd::NodePointer(current_node));
-                }
-            }
+            // SAH is currently in the range [0.0, 0.5] since a triangle can occupy at most half the space of its bounding volume.
+            // So multiply by 2.0 to normalize the SAH to a range [0.0, 1.0].
+            sah *= 2.0f;
+        }
 
-            // Swap the old list with the new.
-            traverse_nodes = swap_nodes;
+        // Mathematically SAH should not ever be greater than 1.0, but with really problematic triangles (extremely long and thin)
+        // floating point errors can push it over. I've seen as high as 1.454 in the Deathloop trace.
+        if (!isnan(sah))
+        {
+            if (sah > 1.01f)
+            {
+                // SAH has passed threshold, so assume this triangle is problematic and mark it as 0.
+                sah = 0.0f;
+            }
+            else
+            {
+                // Otherwise it's only a small floating point error so clamp it to a valid value.
+                sah = std::min(sah, 1.0f);
+            }
         }
-        return kRraOk;
+
+        return sah;
     }
 
     /// @brief Calculate the surface area heuristic for a given BLAS.
     ///
-    /// @param [in] blas The bottom level acceleration structure index.
+    /// @param [in] context The context holding the loaded trace.
+    /// @param [in] blas    The bottom level acceleration structure index.
     ///
     /// @returns Error code.
-    static RraErrorCode CalcBlasSAH(rta::EncodedRtIp11BottomLevelBvh* blas)
+    static RraErrorCode CalcBlasSAH(RraContext* context, rta::EncodedRtIp11BottomLevelBvh* blas)
     {
         RRA_ASSERT(blas != nullptr);
 
@@ -378,14 +399,14 @@ namespace rra
         const auto& header_offsets = blas->GetHeader().GetBufferOffsets();
 
         std::vector<dxr::amd::NodePointer> tri_node_pointers;
-        RRA_BUBBLE_ON_ERROR(GetBlasTriangleNodes(blas->GetID(), tri_node_pointers));
+        RRA_BUBBLE_ON_ERROR(GetBlasTriangleNodes(context, blas->GetID(), tri_node_pointers));
 
         for (const auto& node_ptr : tri_node_pointers)
         {
             const uint32_t node_index = (node_ptr.GetByteOffset() - header_offsets.leaf_nodes) / sizeof(dxr::amd::TriangleNode);
 
             uint32_t tri_count{};
-            RraBlasGetNodeTriangleCount(blas->GetID(), node_ptr.GetID(), &tri_count);
+            RraContextBlasGetNodeTriangleCount(context, blas->GetID(), node_ptr.GetID(), &tri_count);
 
             if (node_ptr.GetType() == dxr::amd::NodeType::kAmdNodeTriangle0)
             {
@@ -396,37 +417,9 @@ namespace rra
                 tri_count = 2;
             }
 
-            float aabb_surface_area         = CalculateTriangleAABBSurfaceArea(triangle_nodes[node_index], tri_count);
-            float triangle_surface_area     = RraBlasGetTriangleSurfaceArea(triangle_nodes[node_index], tri_count);
-            float triangle_avg_surface_area = triangle_surface_area / tri_count;
-            float sah                       = 0.0f;
-
-            // Make sure the surface area of the triangle bounding volume is larger than the triangle surface area.
-            if (aabb_surface_area >= triangle_surface_area && aabb_surface_area > FLT_MIN)
-            {
-                // Multiply triangle area by 2, to account for probability of ray going through front or back face.
-                sah = (2.0f * triangle_avg_surface_area) / aabb_surface_area;
-
-                // SAH is currently in the range [0.0, 0.5] since a triangle can occupy at most half the space of its bounding volume.
-                // So multiply by 2.0 to normalize the SAH to a range [0.0, 1.0].
-                sah *= 2.0f;
-            }
-
-            // Mathematically SAH should not ever be greater than 1.0, but with really problematic triangles (extremely long and thin)
-            // floating point errors can push it over. I've seen as high as 1.454 in the Deathloop trace.
-            if (!isnan(sah))
-            {
-                if (sah > 1.01f)
-                {
-                    // SAH has passed threshold, so assume this triangle is problematic and mark it as 0.
-                    sah = 0.0f;
-                }
-                else
-                {
-                    // Otherwise it's only a small floating point error so clamp it to a valid value.
-                    sah = std::min(sah, 1.0f);
-                }
-            }
+            float aabb_surface_area     = CalculateTriangleAABBSurfaceArea(triangle_nodes[node_index], tri_count);
+            float triangle_surface_area = RraBlasGetTriangleSurfaceArea(triangle_nodes[node_index], tri_count);
+            float sah                   = GetTriangleSurfaceAreaHeuristic(triangle_surface_area, tri_count, aabb_surface_area);
 
             // Store the SAH back to the BLAS.
             blas->SetLeafNodeSurfaceAreaHeuristic(node_index, sah);
@@ -435,7 +428,7 @@ namespace rra
         // Iterate over the box nodes and calculate their SAH values.
         // Top level node doesn't exist in the data so needs to be created. Assumed to be a Box32.
         dxr::amd::NodePointer root_node = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
-        float                 sah       = CalculateSAHForBlasNode(blas, root_node);
+        float                 sah       = CalculateSAHForBlasNode(context, blas, root_node);
 
         blas->SetSurfaceAreaHeuristic(sah);
 
@@ -444,13 +437,14 @@ namespace rra
 
     /// @brief Calculate the surface area heuristic for a given TLAS.
     ///
-    /// @param [in] tlas The top level acceleration structure.
-    static void CalcTlasSAH(rta::EncodedRtIp11TopLevelBvh* tlas)
+    /// @param [in] context The context holding the loaded trace.
+    /// @param [in] tlas    The top level acceleration structure.
+    static void CalcTlasSAH(RraContext* context, rta::EncodedRtIp11TopLevelBvh* tlas)
     {
         // Iterate over the box nodes and calculate their SAH values.
         // Top level node doesn't exist in the data so needs to be created. Assumed to be a Box32.
         dxr::amd::NodePointer root_node = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize);
-        float                 sah       = CalculateSAHForTlasNode(tlas, root_node);
+        float                 sah       = CalculateSAHForTlasNode(context, tlas, root_node);
         RRA_UNUSED(sah);
     }
 
@@ -535,25 +529,39 @@ namespace rra
         }
     }
 
-    RraErrorCode CalculateSurfaceAreaHeuristics(RraDataSet& data_set)
+    RraErrorCode CalculateSurfaceAreaHeuristics(RraContext* context)
+    {
+        RRA_BUBBLE_ON_ERROR(CalculateBlasSurfaceAreaHeuristics(context));
+        return CalculateTlasSurfaceAreaHeuristics(context);
+    }
+
+    RraErrorCode CalculateBlasSurfaceAreaHeuristics(RraContext* context)
     {
-        // Calculate the SAH for each BLAS.
-        // The CalcBlasSAH can be done as a worker thread if needed.
-        const auto& bottom_level_bvhs = data_set.bvh_bundle->GetBottomLevelBvhs();
+        const auto&                                    bottom_level_bvhs = context->data_set.bvh_bundle->GetBottomLevelBvhs();
+        std::vector<rta::EncodedRtIp11BottomLevelBvh*> blases(bottom_level_bvhs.size(), nullptr);
         for (size_t blas_index = 0; blas_index < bottom_level_bvhs.size(); blas_index++)
         {
-            rta::EncodedRtIp11BottomLevelBvh* blas = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
-            if (blas == nullptr)
+            blases[blas_index] = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*bottom_level_bvhs[blas_index]));
+            if (blases[blas_index] == nullptr)
             {
                 return kRraErrorInvalidPointer;
             }
-
-            CalcBlasSAH(blas);
         }
 
-        // Calculate the SAH for each TLAS.
+        JobSystem::Get().ParallelFor(blases.size(), 1, 0, [context, &blases](size_t begin, size_t end, uint32_t) {
+            for (size_t index = begin; index < end; index++)
+            {
+                CalcBlasSAH(context, blases[index]);
+            }
+        });
+
+        return kRraOk;
+    }
+
+    RraErrorCode CalculateTlasSurfaceAreaHeuristics(RraContext* context)
+    {
         // The leaf nodes here will be an instance node/BLAS.
-        const auto& top_level_bvhs = data_set.bvh_bundle->GetTopLevelBvhs();
+        const auto& top_level_bvhs = context->data_set.bvh_bundle->GetTopLevelBvhs();
         for (size_t tlas_index = 0; tlas_index < top_level_bvhs.size(); tlas_index++)
         {
             rta::EncodedRtIp11TopLevelBvh* tlas = dynamic_cast<rta::EncodedRtIp11TopLevelBvh*>(&(*top_level_bvhs[tlas_index]));
@@ -561,7 +569,7 @@ namespace rra
             {
                 return kRraErrorInvalidPointer;
             }
-            CalcTlasSAH(tlas);
+            CalcTlasSAH(context, tlas);
         }
 
         return kRraOk;
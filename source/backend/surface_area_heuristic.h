@@ -9,7 +9,7 @@
 #define RRA_BACKEND_SURFACE_AREA_HEURISTIC_H_
 
 #include "bvh/iencoded_rt_ip_11_bvh.h"
-#include "rra_data_set.h"
+#include "rra_context.h"
 
 // Surface area heuristic calculator functions. Used only by the backend; no public interface.
 
@@ -17,10 +17,46 @@ namespace rra
 {
     /// @brief Calculate the surface area heuristic values for all nodes in the TLASes and BLASes.
     ///
-    /// @param [in] data_set The data set containing the loaded trace data.
+    /// @param [in] context The context holding the loaded trace.
     ///
     /// @return RraOk if successful, an error code if not.
-    RraErrorCode CalculateSurfaceAreaHeuristics(RraDataSet& data_set);
+    RraErrorCode CalculateSurfaceAreaHeuristics(RraContext* context);
+
+    /// @brief Calculate the surface area heuristic values for all nodes in the BLASes.
+    ///
+    /// @param [in] context The context holding the loaded trace.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode CalculateBlasSurfaceAreaHeuristics(RraContext* context);
+
+    /// @brief Calculate the surface area heuristic values for all nodes in the TLASes.
+    ///
+    /// The instance nodes use the BLAS values, so CalculateBlasSurfaceAreaHeuristics() must have finished first.
+    ///
+    /// @param [in] context The context holding the loaded trace.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode CalculateTlasSurfaceAreaHeuristics(RraContext* context);
+
+    /// @brief Get the list of triangle nodes in a BLAS.
+    ///
+    /// @param [in]  context        The context holding the loaded trace.
+    /// @param [in]  blas_index     Index of BLAS to get the triangle NodePointers from.
+    /// @param [out] triangle_nodes The triangle nodes are written into this vector.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode GetBlasTriangleNodes(RraContext* context, uint64_t blas_index, std::vector<dxr::amd::NodePointer>& triangle_nodes);
+
+    /// @brief Get the surface area heuristic of a triangle node.
+    ///
+    /// This is how much of the node's bounding volume is filled by its triangles, normalized to the range [0.0, 1.0].
+    ///
+    /// @param [in] triangle_surface_area The total surface area of the triangles in the node.
+    /// @param [in] tri_count             The number of triangles in the node.
+    /// @param [in] aabb_surface_area     The surface area of the node's bounding volume.
+    ///
+    /// @return The surface area heuristic.
+    float GetTriangleSurfaceAreaHeuristic(float triangle_surface_area, uint32_t tri_count, float aabb_surface_area);
 
     /// @brief Get the minimum surface area heuristic for a given node and its children.
     ///
@@ -0,0 +1,808 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the synthetic trace generator.
+//=============================================================================
+
+#include "trace_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "rdf/rdf/inc/amdrdf.h"
+
+#include "api_info.h"
+#include "asic_info.h"
+#include "bvh/geometry_info.h"
+#include "bvh/iencoded_rt_ip_11_bvh.h"
+#include "bvh/irt_ip_11_acceleration_structure_header.h"
+#include "bvh/metadata_v1.h"
+#include "bvh/node_types/float16_box_node.h"
+#include "bvh/node_types/float32_box_node.h"
+#include "bvh/node_types/instance_node.h"
+#include "bvh/node_types/triangle_node.h"
+#include "bvh/parent_block.h"
+#include "compression_analysis.h"
+#include "math_util.h"
+#include "reference_bvh.h"
+
+namespace rra
+{
+    static const uint32_t kMaxPrimitiveCount       = 1u << 24;    ///< The most triangles in a BLAS or instances in a TLAS, so every offset fits in 32 bits.
+    static const uint64_t kBaseVirtualAddress      = 1ull << 32;  ///< The GPU address of the first acceleration structure.
+    static const uint64_t kVirtualAddressAlignment = 256;         ///< The alignment of each acceleration structure's GPU address.
+    static const float    kHeightScale             = 0.5f;        ///< The largest vertex displacement, in grid cells.
+    static const float    kInstanceSpacing         = 1.25f;       ///< The distance between instances, as a multiple of the largest BLAS extent.
+    static const uint64_t kTlasSeedOffset          = 0x544C4153;  ///< Added to the seed for the TLAS, so it does not repeat a BLAS.
+
+    /// @brief An acceleration structure laid out as it is stored in a "RawAccelStruc" chunk.
+    struct EncodedAccelStruct
+    {
+        rta::RawAccelStructRdfChunkHeader   chunk_header = {};  ///< The chunk header.
+        std::vector<uint8_t>                metadata;           ///< The metadata header, followed by the parent links at the end.
+        rta::DxrAccelerationStructureHeader header = {};        ///< The acceleration structure header.
+        std::vector<uint8_t>                interior_nodes;     ///< The box nodes.
+        std::vector<uint8_t>                leaf_nodes;         ///< The triangle or instance nodes.
+        std::vector<dxr::amd::GeometryInfo> geometry_infos;     ///< The geometry descriptions. Empty for a TLAS.
+        std::vector<dxr::amd::NodePointer>  primitive_ptrs;     ///< The leaf node pointer for each primitive, in primitive order.
+    };
+
+    /// @brief What the TLAS needs to know about a BLAS once it has been written.
+    struct GeneratedBlasInfo
+    {
+        dxr::amd::AxisAlignedBoundingBox bounds;          ///< The bounding box of the BLAS.
+        uint64_t                         address;         ///< The GPU address of the chunk, which is the start of the metadata.
+        uint32_t                         meta_data_size;  ///< The size of the metadata.
+    };
+
+    /// @brief Round a value up to a multiple of an alignment.
+    ///
+    /// @param [in] value     The value.
+    /// @param [in] alignment The alignment.
+    ///
+    /// @return The aligned value.
+    static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return ((value + alignment - 1) / alignment) * alignment;
+    }
+
+    /// @brief Get a random float from a generator, the same on every platform.
+    ///
+    /// @param [in] rng The random number generator.
+    ///
+    /// @return A random float in [0, 1).
+    static float RandomFloat(std::mt19937_64& rng)
+    {
+        return static_cast<float>(rng() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    /// @brief Get the height of a grid vertex.
+    ///
+    /// The height is hashed from the grid position, so a vertex shared by several triangles is always in the same place.
+    ///
+    /// @param [in] blas_seed The seed for the BLAS.
+    /// @param [in] x         The grid column.
+    /// @param [in] z         The grid row.
+    ///
+    /// @return The vertex position.
+    static dxr::amd::Float3 GridVertex(uint64_t blas_seed, uint32_t x, uint32_t z)
+    {
+        uint64_t hash = blas_seed ^ ((static_cast<uint64_t>(x) << 32) | z);
+        hash          = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+        hash          = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+
+        const float height = static_cast<float>(hash >> 40) * (kHeightScale / 16777216.0f);
+        return {static_cast<float>(x), height, static_cast<float>(z)};
+    }
+
+    /// @brief Grow a bounding box to contain a point.
+    ///
+    /// @param [in]     point The point.
+    /// @param [in,out] box   The bounding box.
+    static void GrowBox(const dxr::amd::Float3& point, dxr::amd::AxisAlignedBoundingBox& box)
+    {
+        box.min = {std::min(box.min.x, point.x), std::min(box.min.y, point.y), std::min(box.min.z, point.z)};
+        box.max = {std::max(box.max.x, point.x), std::max(box.max.y, point.y), std::max(box.max.z, point.z)};
+    }
+
+    /// @brief Get an empty bounding box, that any point grows.
+    ///
+    /// @return The empty bounding box.
+    static dxr::amd::AxisAlignedBoundingBox EmptyBox()
+    {
+        return {{INFINITY, INFINITY, INFINITY}, {-INFINITY, -INFINITY, -INFINITY}};
+    }
+
+    /// @brief Split a range of primitives in two.
+    ///
+    /// @param [in]     item_boxes The bounding box of each primitive.
+    /// @param [in]     tree_shape How to split.
+    /// @param [in]     begin      The first primitive in the range.
+    /// @param [in]     end        One past the last primitive in the range. The range must hold at least 2 primitives.
+    /// @param [in,out] rng        The random number generator.
+    /// @param [in,out] order      The primitive order. Reordered within the range for a median split.
+    ///
+    /// @return The start of the second half.
+    static uint32_t SplitRange(const std::vector<dxr::amd::AxisAlignedBoundingBox>& item_boxes,
+                               RraTraceGeneratorTreeShape                           tree_shape,
+                               uint32_t                                             begin,
+                               uint32_t                                             end,
+                               std::mt19937_64&                                     rng,
+                               std::vector<uint32_t>&                               order)
+    {
+        if (tree_shape == kRraTraceGeneratorTreeShapeRandom)
+        {
+            return begin + 1 + static_cast<uint32_t>(rng() % (end - begin - 1));
+        }
+
+        // The box centers are compared at twice their value, which keeps the order and saves a divide.
+        dxr::amd::AxisAlignedBoundingBox centers = EmptyBox();
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const auto& box = item_boxes[order[i]];
+            GrowBox({box.min.x + box.max.x, box.min.y + box.max.y, box.min.z + box.max.z}, centers);
+        }
+
+        const float extent[3] = {centers.max.x - centers.min.x, centers.max.y - centers.min.y, centers.max.z - centers.min.z};
+        const int   axis      = static_cast<int>(std::max_element(extent, extent + 3) - extent);
+
+        const uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&item_boxes, axis](uint32_t a, uint32_t b) {
+            return (&item_boxes[a].min.x)[axis] + (&item_boxes[a].max.x)[axis] < (&item_boxes[b].min.x)[axis] + (&item_boxes[b].max.x)[axis];
+        });
+        return middle;
+    }
+
+    /// @brief Build a tree with up to 4 children per node over a set of primitives.
+    ///
+    /// Each leaf holds a single primitive. The nodes are numbered in depth first order, with the root first.
+    ///
+    /// @param [in]     item_boxes The bounding box of each primitive. Must not be empty.
+    /// @param [in]     tree_shape How to split.
+    /// @param [in,out] rng        The random number generator.
+    /// @param [out]    out_nodes  The nodes.
+    static void BuildTree(const std::vector<dxr::amd::AxisAlignedBoundingBox>& item_boxes,
+                          RraTraceGeneratorTreeShape                           tree_shape,
+                          std::mt19937_64&                                     rng,
+                          std::vector<ReferenceBvhNode>&                       out_nodes)
+    {
+        struct Range
+        {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        struct BuildTask
+        {
+            uint32_t node_index;
+            Range    range;
+        };
+
+        std::vector<uint32_t> order(item_boxes.size());
+        for (uint32_t i = 0; i < order.size(); i++)
+        {
+            order[i] = i;
+        }
+
+        ReferenceBvhNode empty_node = {};
+        empty_node.children.fill(ReferenceBvhNode::kInvalidChild);
+
+        out_nodes.clear();
+        out_nodes.push_back(empty_node);
+
+        std::vector<BuildTask> stack;
+        stack.push_back({0, {0, static_cast<uint32_t>(item_boxes.size())}});
+        while (!stack.empty())
+        {
+            const BuildTask task = stack.back();
+            stack.pop_back();
+
+            // Keep splitting the largest range until there are 4, or every range holds a single primitive.
+            std::array<Range, 4> ranges      = {task.range};
+            uint32_t             range_count = 1;
+            while (range_count < 4)
+            {
+                uint32_t largest = 0;
+                for (uint32_t i = 1; i < range_count; i++)
+                {
+                    if (ranges[i].end - ranges[i].begin > ranges[largest].end - ranges[largest].begin)
+                    {
+                        largest = i;
+                    }
+                }
+
+                const Range range = ranges[largest];
+                if (range.end - range.begin < 2)
+                {
+                    break;
+                }
+
+                const uint32_t middle = SplitRange(item_boxes, tree_shape, range.begin, range.end, rng, order);
+                ranges[largest]       = {range.begin, middle};
+                ranges[range_count++] = {middle, range.end};
+            }
+            std::sort(ranges.begin(), ranges.begin() + range_count, [](const Range& a, const Range& b) { return a.begin < b.begin; });
+
+            for (uint32_t i = 0; i < range_count; i++)
+            {
+                const Range& range = ranges[i];
+                if (range.end - range.begin == 1)
+                {
+                    out_nodes[task.node_index].children[i] = order[range.begin] | ReferenceBvhNode::kLeafFlag;
+                    out_nodes[task.node_index].boxes[i]    = item_boxes[order[range.begin]];
+                    continue;
+                }
+
+                dxr::amd::AxisAlignedBoundingBox box = EmptyBox();
+                for (uint32_t j = range.begin; j < range.end; j++)
+                {
+                    GrowBox(item_boxes[order[j]].min, box);
+                    GrowBox(item_boxes[order[j]].max, box);
+                }
+
+                const uint32_t child_index             = static_cast<uint32_t>(out_nodes.size());
+                out_nodes[task.node_index].children[i] = child_index;
+                out_nodes[task.node_index].boxes[i]    = box;
+                out_nodes.push_back(empty_node);
+                stack.push_back({child_index, range});
+            }
+        }
+    }
+
+    /// @brief Decide which box nodes are stored as fp16.
+    ///
+    /// @param [in] nodes          The nodes.
+    /// @param [in] box_fp16_mode  The fp16 box node mode.
+    /// @param [in] fp16_tolerance How far a bound may move, for kRraBoxFp16ModeMixedWithFp32.
+    ///
+    /// @return A flag for each node, set if it is fp16. The root is always fp32.
+    static std::vector<bool> ChooseFp16Nodes(const std::vector<ReferenceBvhNode>& nodes, RraBoxFp16Mode box_fp16_mode, float fp16_tolerance)
+    {
+        std::vector<bool> fp16(nodes.size(), false);
+        for (size_t i = 1; i < nodes.size(); i++)
+        {
+            const ReferenceBvhNode& node = nodes[i];
+
+            bool all_leaves = true;
+            std::array<dxr::amd::NodePointer, 4> children;
+            for (uint32_t j = 0; j < 4; j++)
+            {
+                const bool valid = node.children[j] != ReferenceBvhNode::kInvalidChild;
+                all_leaves       = all_leaves && (!valid || (node.children[j] & ReferenceBvhNode::kLeafFlag) != 0);
+                children[j]      = valid ? dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeTriangle0, 0) : dxr::amd::NodePointer();
+            }
+
+            switch (box_fp16_mode)
+            {
+            case kRraBoxFp16ModeLeafNodesOnly:
+                fp16[i] = all_leaves;
+                break;
+            case kRraBoxFp16ModeMixedWithFp32:
+                fp16[i] = IsFp16Representable(node.boxes, children, fp16_tolerance);
+                break;
+            case kRraBoxFp16ModeAll:
+                fp16[i] = true;
+                break;
+            default:
+                break;
+            }
+        }
+        return fp16;
+    }
+
+    /// @brief Record the parent of a node in the parent block.
+    ///
+    /// @param [in]     node             The node.
+    /// @param [in]     parent           The parent node, or an invalid pointer for the root.
+    /// @param [in]     compression_mode The triangle compression mode, which sets the parent block layout.
+    /// @param [in,out] parent_block     The parent block.
+    static void SetParentLink(dxr::amd::NodePointer              node,
+                              dxr::amd::NodePointer              parent,
+                              dxr::amd::TriangleCompressionMode  compression_mode,
+                              dxr::amd::ParentBlock&             parent_block)
+    {
+        const uint32_t link_index = node.CalculateParentLinkIndex(parent_block.GetSizeInBytes(), compression_mode);
+        RRA_ASSERT(link_index < parent_block.GetLinkCount());
+        if (link_index < parent_block.GetLinkCount())
+        {
+            parent_block.GetLinkData()[link_index] = parent;
+        }
+    }
+
+    /// @brief Lay out the box nodes, and record the parents of every node.
+    ///
+    /// The box nodes are stored in the order they were built, starting right after the header.
+    ///
+    /// @param [in]     nodes            The nodes.
+    /// @param [in]     fp16             A flag for each node, set if it is fp16.
+    /// @param [in]     item_ptrs        The leaf node pointer for each primitive the tree was built over.
+    /// @param [in]     compression_mode The triangle compression mode.
+    /// @param [in,out] parent_block     The parent block, sized for the box and leaf nodes.
+    /// @param [out]    out_encoded      The encoded acceleration structure, to receive the box nodes.
+    static void EncodeBoxNodes(const std::vector<ReferenceBvhNode>&      nodes,
+                               const std::vector<bool>&                  fp16,
+                               const std::vector<dxr::amd::NodePointer>& item_ptrs,
+                               dxr::amd::TriangleCompressionMode         compression_mode,
+                               dxr::amd::ParentBlock&                    parent_block,
+                               EncodedAccelStruct&                       out_encoded)
+    {
+        std::vector<dxr::amd::NodePointer> node_ptrs(nodes.size());
+        uint32_t                           offset = dxr::amd::kAccelerationStructureHeaderSize;
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            node_ptrs[i] = dxr::amd::NodePointer(fp16[i] ? dxr::amd::NodeType::kAmdNodeBoxFp16 : dxr::amd::NodeType::kAmdNodeBoxFp32, offset);
+            offset += fp16[i] ? dxr::amd::kFp16BoxNodeSize : dxr::amd::kFp32BoxNodeSize;
+        }
+        out_encoded.interior_nodes.assign(offset - dxr::amd::kAccelerationStructureHeaderSize, 0);
+
+        SetParentLink(node_ptrs[0], dxr::amd::NodePointer(), compression_mode, parent_block);
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            std::array<dxr::amd::NodePointer, 4>            children;
+            std::array<dxr::amd::AxisAlignedBoundingBox, 4> boxes = {};
+            for (uint32_t j = 0; j < 4; j++)
+            {
+                const uint32_t child = nodes[i].children[j];
+                if (child == ReferenceBvhNode::kInvalidChild)
+                {
+                    continue;
+                }
+
+                children[j] = (child & ReferenceBvhNode::kLeafFlag) ? item_ptrs[child & ~ReferenceBvhNode::kLeafFlag] : node_ptrs[child];
+                boxes[j]    = nodes[i].boxes[j];
+                SetParentLink(children[j], node_ptrs[i], compression_mode, parent_block);
+
+                // With two triangle compression each triangle in a leaf node has its own parent link.
+                if (compression_mode == dxr::amd::TriangleCompressionMode::kAmdTwoTriangleCompression &&
+                    children[j].GetType() == dxr::amd::NodeType::kAmdNodeTriangle1)
+                {
+                    const dxr::amd::NodePointer first_triangle(dxr::amd::NodeType::kAmdNodeTriangle0, children[j].GetByteOffset());
+                    SetParentLink(first_triangle, node_ptrs[i], compression_mode, parent_block);
+                }
+            }
+
+            uint8_t* destination = out_encoded.interior_nodes.data() + node_ptrs[i].GetByteOffset() - dxr::amd::kAccelerationStructureHeaderSize;
+            if (fp16[i])
+            {
+                dxr::amd::Float16BoxNode box_node;
+                box_node.SetChildren(children);
+                box_node.SetBoundingBoxes(boxes);
+                memcpy(destination, &box_node, sizeof(box_node));
+            }
+            else
+            {
+                dxr::amd::Float32BoxNode box_node;
+                box_node.SetChildren(children);
+                box_node.SetBoundingBoxes(boxes);
+                memcpy(destination, &box_node, sizeof(box_node));
+            }
+        }
+    }
+
+    /// @brief Fill in the chunk header, metadata and header sizes once the node buffers are encoded.
+    ///
+    /// @param [in]     address      The GPU address of the acceleration structure, which is the start of the metadata.
+    /// @param [in]     build_info   The post build info.
+    /// @param [in]     parent_block The parent block.
+    /// @param [in,out] encoded      The encoded acceleration structure. The header counts must already be set.
+    static void FinishAccelStruct(uint64_t                                            address,
+                                  const rta::IRtIp11AccelerationStructurePostBuildInfo& build_info,
+                                  const dxr::amd::ParentBlock&                        parent_block,
+                                  EncodedAccelStruct&                                 encoded)
+    {
+        // The parent links go at the end of the metadata, which is padded so the header stays aligned.
+        const uint32_t parent_size    = parent_block.GetSizeInBytes();
+        const uint32_t meta_data_size = static_cast<uint32_t>(AlignUp(dxr::amd::kMetaDataV1Size + parent_size, dxr::amd::kMetaDataAlignment));
+
+        dxr::amd::MetaDataV1 meta_data;
+        meta_data.SetGpuVa(address + meta_data_size);
+        meta_data.SetByteSize(meta_data_size);
+        encoded.metadata.assign(meta_data_size, 0);
+        memcpy(encoded.metadata.data(), &meta_data, sizeof(meta_data));
+        memcpy(encoded.metadata.data() + meta_data_size - parent_size, parent_block.GetLinkData().data(), parent_size);
+
+        rta::AccelerationStructureBufferOffsets& offsets = encoded.header.offsets;
+        offsets.interior_nodes                           = dxr::amd::kAccelerationStructureHeaderSize;
+        offsets.leaf_nodes                               = offsets.interior_nodes + static_cast<uint32_t>(encoded.interior_nodes.size());
+        offsets.geometry_info                            = offsets.leaf_nodes + static_cast<uint32_t>(encoded.leaf_nodes.size());
+        offsets.prim_node_ptrs = offsets.geometry_info + static_cast<uint32_t>(encoded.geometry_infos.size() * sizeof(dxr::amd::GeometryInfo));
+
+        const uint32_t data_size = offsets.prim_node_ptrs + static_cast<uint32_t>(encoded.primitive_ptrs.size() * sizeof(dxr::amd::NodePointer));
+
+        build_info.SaveToBuffer(&encoded.header.build_info);
+        encoded.header.meta_data_size_in_bytes         = meta_data_size;
+        encoded.header.file_size_in_bytes              = meta_data_size + data_size;
+        encoded.header.primitive_count                 = static_cast<uint32_t>(encoded.primitive_ptrs.size());
+        encoded.header.active_primitive_count          = encoded.header.primitive_count;
+        encoded.header.geometry_type                   = dxr::GeometryType::kTriangle;
+        encoded.header.driver_gpu_rt_interface_version = rta::RayTracingBinaryVersion(GPURT_ACCEL_STRUCT_MAJOR_VERSION, GPURT_ACCEL_STRUCT_MINOR_VERSION);
+
+        encoded.chunk_header.accel_struct_base_va_lo = static_cast<uint32_t>(address);
+        encoded.chunk_header.accel_struct_base_va_hi = static_cast<uint32_t>(address >> 32);
+        encoded.chunk_header.meta_header_offset      = 0;
+        encoded.chunk_header.meta_header_size        = dxr::amd::kMetaDataV1Size;
+        encoded.chunk_header.header_offset           = meta_data_size;
+        encoded.chunk_header.header_size             = dxr::amd::kAccelerationStructureHeaderSize;
+        encoded.chunk_header.flags.u32All            = 0;
+        encoded.chunk_header.flags.blas              = build_info.IsBottomLevel() ? 1 : 0;
+    }
+
+    /// @brief Generate a BLAS.
+    ///
+    /// The BLAS is a grid of quads, each split into two triangles sharing the diagonal, with randomly displaced
+    /// vertices. With triangle compression each quad goes in a single leaf node.
+    ///
+    /// @param [in]  config      The settings.
+    /// @param [in]  blas_index  The index of the BLAS, which picks its random seed.
+    /// @param [in]  address     The GPU address of the BLAS.
+    /// @param [out] out_encoded The encoded BLAS.
+    /// @param [out] out_info    What the TLAS needs to know about the BLAS.
+    static void GenerateBlas(const RraTraceGeneratorConfig& config,
+                             uint32_t                       blas_index,
+                             uint64_t                       address,
+                             EncodedAccelStruct&            out_encoded,
+                             GeneratedBlasInfo&             out_info)
+    {
+        const uint64_t  blas_seed = config.seed + blas_index * 0x9E3779B97F4A7C15ull;
+        std::mt19937_64 rng(blas_seed);
+
+        const auto compression_mode = static_cast<dxr::amd::TriangleCompressionMode>(config.triangle_compression_mode);
+        const bool compressed       = compression_mode != dxr::amd::TriangleCompressionMode::kAmdNoTriangleCompression;
+
+        const uint32_t triangle_count = config.triangles_per_blas;
+        const uint32_t quad_count     = (triangle_count + 1) / 2;
+        const uint32_t grid_width     = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(quad_count))));
+
+        // Each item is a leaf node: a triangle, or a quad with triangle compression.
+        const uint32_t item_count = compressed ? quad_count : triangle_count;
+
+        std::vector<std::array<dxr::amd::Float3, 4>>  item_vertices(item_count);
+        std::vector<dxr::amd::AxisAlignedBoundingBox> item_boxes(item_count);
+        out_info.bounds = EmptyBox();
+        for (uint32_t i = 0; i < item_count; i++)
+        {
+            const uint32_t quad = compressed ? i : i / 2;
+            const uint32_t x    = quad % grid_width;
+            const uint32_t z    = quad / grid_width;
+
+            // The quad's corners, ordered so that triangle 0 is (v0, v1, v2) and triangle 1 is (v1, v3, v2).
+            const std::array<dxr::amd::Float3, 4> corners = {
+                GridVertex(blas_seed, x, z), GridVertex(blas_seed, x + 1, z), GridVertex(blas_seed, x, z + 1), GridVertex(blas_seed, x + 1, z + 1)};
+
+            if (compressed || (i % 2) == 0)
+            {
+                item_vertices[i] = corners;
+            }
+            else
+            {
+                item_vertices[i] = {corners[1], corners[3], corners[2], {}};
+            }
+
+            const bool has_second_triangle = compressed && (2 * i + 1) < triangle_count;
+            item_boxes[i]                  = EmptyBox();
+            for (uint32_t v = 0; v < (has_second_triangle ? 4u : 3u); v++)
+            {
+                GrowBox(item_vertices[i][v], item_boxes[i]);
+            }
+            GrowBox(item_boxes[i].min, out_info.bounds);
+            GrowBox(item_boxes[i].max, out_info.bounds);
+        }
+
+        std::vector<ReferenceBvhNode> nodes;
+        BuildTree(item_boxes, config.tree_shape, rng, nodes);
+        const std::vector<bool> fp16 = ChooseFp16Nodes(nodes, config.box_fp16_mode, config.fp16_tolerance);
+
+        uint32_t interior_size = 0;
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            interior_size += fp16[i] ? dxr::amd::kFp16BoxNodeSize : dxr::amd::kFp32BoxNodeSize;
+        }
+
+        // The leaf nodes are stored in the order they are referenced by the box nodes.
+        // With two triangle compression the parent link of the second triangle in the last leaf node is past the end of
+        // a tightly sized parent block, so an unused leaf node is added, as the driver's worst case allocation would.
+        const uint32_t leaf_padding      = (compression_mode == dxr::amd::TriangleCompressionMode::kAmdTwoTriangleCompression) ? 1 : 0;
+        const uint32_t leaf_nodes_offset = dxr::amd::kAccelerationStructureHeaderSize + interior_size;
+        out_encoded.leaf_nodes.assign(static_cast<size_t>(item_count + leaf_padding) * dxr::amd::kLeafNodeSize, 0);
+        out_encoded.primitive_ptrs.resize(triangle_count);
+
+        std::vector<dxr::amd::NodePointer> item_ptrs(item_count);
+        uint32_t                           leaf_index = 0;
+        for (const ReferenceBvhNode& node : nodes)
+        {
+            for (uint32_t child : node.children)
+            {
+                if (child == ReferenceBvhNode::kInvalidChild || (child & ReferenceBvhNode::kLeafFlag) == 0)
+                {
+                    continue;
+                }
+
+                const uint32_t item                = child & ~ReferenceBvhNode::kLeafFlag;
+                const uint32_t first_triangle      = compressed ? 2 * item : item;
+                const bool     has_second_triangle = compressed && (first_triangle + 1) < triangle_count;
+                const uint32_t byte_offset         = leaf_nodes_offset + leaf_index * dxr::amd::kLeafNodeSize;
+
+                dxr::amd::TriangleNode triangle_node;
+                for (uint32_t v = 0; v < (has_second_triangle ? 4u : 3u); v++)
+                {
+                    triangle_node.SetVertex(v, item_vertices[item][v]);
+                }
+                triangle_node.SetGeometryIndexAndFlags(0, dxr::GeometryFlags::kAmdFlagOpaque);
+                triangle_node.SetTriangleId(dxr::amd::NodeType::kAmdNodeTriangle0, dxr::GeometryFlags::kAmdFlagOpaque);
+                triangle_node.SetPrimitiveIndex(first_triangle, dxr::amd::NodeType::kAmdNodeTriangle0);
+                out_encoded.primitive_ptrs[first_triangle] = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeTriangle0, byte_offset);
+                if (has_second_triangle)
+                {
+                    triangle_node.SetTriangleId(dxr::amd::NodeType::kAmdNodeTriangle1, dxr::GeometryFlags::kAmdFlagOpaque);
+                    triangle_node.SetPrimitiveIndex(first_triangle + 1, dxr::amd::NodeType::kAmdNodeTriangle1);
+                    out_encoded.primitive_ptrs[first_triangle + 1] = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeTriangle1, byte_offset);
+                }
+                memcpy(out_encoded.leaf_nodes.data() + static_cast<size_t>(leaf_index) * dxr::amd::kLeafNodeSize, &triangle_node, sizeof(triangle_node));
+
+                // A Triangle1 pointer covers both triangles in the leaf node.
+                const auto leaf_type = has_second_triangle ? dxr::amd::NodeType::kAmdNodeTriangle1 : dxr::amd::NodeType::kAmdNodeTriangle0;
+                item_ptrs[item]      = dxr::amd::NodePointer(leaf_type, byte_offset);
+                leaf_index++;
+            }
+        }
+
+        dxr::amd::ParentBlock parent_block(interior_size, static_cast<uint32_t>(out_encoded.leaf_nodes.size()), compression_mode);
+        EncodeBoxNodes(nodes, fp16, item_ptrs, compression_mode, parent_block, out_encoded);
+
+        dxr::amd::GeometryInfo geometry_info;
+        geometry_info.SetGeometryFlagsAndPrimitiveCount(dxr::GeometryFlags::kAmdFlagOpaque, triangle_count);
+        geometry_info.SetGeometryBufferOffset(0);
+        geometry_info.SetPrimitiveNodePtrsOffset(0);
+        out_encoded.geometry_infos.assign(1, geometry_info);
+
+        const uint32_t fp16_count                   = static_cast<uint32_t>(std::count(fp16.begin(), fp16.end(), true));
+        out_encoded.header.desc_count               = 1;
+        out_encoded.header.interior_fp32_node_count = static_cast<uint32_t>(nodes.size()) - fp16_count;
+        out_encoded.header.interior_fp16_node_count = fp16_count;
+        out_encoded.header.leaf_node_count          = item_count;
+
+        auto build_info = rta::CreateRtIp11AccelerationStructurePostBuildInfo();
+        build_info->SetBvhType(rta::BvhType::kBottomLevel);
+        build_info->SetTriangleCompressionMode(static_cast<rta::BvhTriangleCompressionMode>(config.triangle_compression_mode));
+        build_info->SetBottomLevelFp16Mode(static_cast<rta::BvhLowPrecisionInteriorNodeMode>(config.box_fp16_mode));
+        build_info->SetBuildFlags(rta::BvhBuildFlags::kFastTrace);
+        FinishAccelStruct(address, *build_info, parent_block, out_encoded);
+
+        out_info.address        = address;
+        out_info.meta_data_size = out_encoded.header.meta_data_size_in_bytes;
+    }
+
+    /// @brief Generate the TLAS.
+    ///
+    /// The instances are placed on a grid with a random rotation about the Y axis, scale and offset. The inactive
+    /// instances are given a mask of 0 but keep their BLAS address, as an application may leave it.
+    ///
+    /// @param [in]  config      The settings.
+    /// @param [in]  blases      The generated BLASes.
+    /// @param [in]  address     The GPU address of the TLAS.
+    /// @param [out] out_encoded The encoded TLAS.
+    static void GenerateTlas(const RraTraceGeneratorConfig&        config,
+                             const std::vector<GeneratedBlasInfo>& blases,
+                             uint64_t                              address,
+                             EncodedAccelStruct&                   out_encoded)
+    {
+        std::mt19937_64 rng(config.seed + kTlasSeedOffset);
+
+        float largest_extent = 0.0f;
+        for (const GeneratedBlasInfo& blas : blases)
+        {
+            largest_extent = std::max({largest_extent, blas.bounds.max.x - blas.bounds.min.x, blas.bounds.max.z - blas.bounds.min.z});
+        }
+        const float    spacing    = kInstanceSpacing * largest_extent;
+        const uint32_t grid_width = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(config.instance_count))));
+
+        std::vector<dxr::amd::InstanceNode>           instances(config.instance_count);
+        std::vector<dxr::amd::AxisAlignedBoundingBox> item_boxes(config.instance_count);
+        for (uint32_t i = 0; i < config.instance_count; i++)
+        {
+            const uint32_t           blas_index = (i < blases.size()) ? i : static_cast<uint32_t>(rng() % blases.size());
+            const GeneratedBlasInfo& blas       = blases[blas_index];
+
+            const float angle = RandomFloat(rng) * 6.2831853f;
+            const float scale = 0.5f + 0.5f * RandomFloat(rng);
+            const float c     = std::cos(angle) * scale;
+            const float s     = std::sin(angle) * scale;
+            const float tx    = ((i % grid_width) + 0.25f * RandomFloat(rng)) * spacing;
+            const float tz    = ((i / grid_width) + 0.25f * RandomFloat(rng)) * spacing;
+
+            // The descriptor holds the inverse transform, from world space to object space.
+            const dxr::Matrix3x4 transform         = {c, 0.0f, s, tx, 0.0f, scale, 0.0f, 0.0f, -s, 0.0f, c, tz};
+            const float          inverse_scale_sq  = 1.0f / (scale * scale);
+            const float          ic                = c * inverse_scale_sq;
+            const float          is                = s * inverse_scale_sq;
+            const float          inverse_scale     = 1.0f / scale;
+            const dxr::Matrix3x4 inverse_transform = {
+                ic, 0.0f, -is, -(ic * tx - is * tz), 0.0f, inverse_scale, 0.0f, 0.0f, is, 0.0f, ic, -(is * tx + ic * tz)};
+
+            dxr::InstanceDesc& desc = instances[i].GetDesc();
+            desc.SetTransform(inverse_transform);
+            desc.SetInstanceIdAndMask(i, (i < config.instance_count - config.inactive_instance_count) ? 0xFF : 0);
+            desc.SetBottomLevelBvhGpuVa(blas.address + blas.meta_data_size, dxr::InstanceDescType::kRaw);
+
+            dxr::amd::InstanceExtraData& extra_data = instances[i].GetExtraData();
+            extra_data.SetInstanceIndex(i);
+            extra_data.SetBottomLevelBvhNodePointer(dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize));
+            extra_data.SetBottomLevelBvhMetaDataSize(blas.meta_data_size);
+            extra_data.SetOriginalInstanceTransform(transform);
+
+            const BoundingVolumeExtents extents = math_util::TransformAABB(blas.bounds, transform);
+            item_boxes[i]                       = {{extents.min_x, extents.min_y, extents.min_z}, {extents.max_x, extents.max_y, extents.max_z}};
+        }
+
+        std::vector<ReferenceBvhNode> nodes;
+        BuildTree(item_boxes, config.tree_shape, rng, nodes);
+        const std::vector<bool> fp16(nodes.size(), false);
+
+        const uint32_t interior_size     = static_cast<uint32_t>(nodes.size()) * dxr::amd::kFp32BoxNodeSize;
+        const uint32_t leaf_nodes_offset = dxr::amd::kAccelerationStructureHeaderSize + interior_size;
+        out_encoded.leaf_nodes.assign(static_cast<size_t>(config.instance_count) * dxr::amd::kInstanceNodeSize, 0);
+        out_encoded.primitive_ptrs.resize(config.instance_count);
+
+        std::vector<dxr::amd::NodePointer> item_ptrs(config.instance_count);
+        uint32_t                           leaf_index = 0;
+        for (const ReferenceBvhNode& node : nodes)
+        {
+            for (uint32_t child : node.children)
+            {
+                if (child == ReferenceBvhNode::kInvalidChild || (child & ReferenceBvhNode::kLeafFlag) == 0)
+                {
+                    continue;
+                }
+
+                const uint32_t instance_index = child & ~ReferenceBvhNode::kLeafFlag;
+                const uint32_t byte_offset    = leaf_nodes_offset + leaf_index * dxr::amd::kInstanceNodeSize;
+                item_ptrs[instance_index]     = dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeInstance, byte_offset);
+                out_encoded.primitive_ptrs[instance_index] = item_ptrs[instance_index];
+                memcpy(out_encoded.leaf_nodes.data() + static_cast<size_t>(leaf_index) * dxr::amd::kInstanceNodeSize,
+                       &instances[instance_index],
+                       sizeof(dxr::amd::InstanceNode));
+                leaf_index++;
+            }
+        }
+
+        const auto            compression_mode = dxr::amd::TriangleCompressionMode::kAmdNoTriangleCompression;
+        dxr::amd::ParentBlock parent_block(interior_size, static_cast<uint32_t>(out_encoded.leaf_nodes.size()), compression_mode);
+        EncodeBoxNodes(nodes, fp16, item_ptrs, compression_mode, parent_block, out_encoded);
+
+        out_encoded.header.desc_count               = config.instance_count;
+        out_encoded.header.interior_fp32_node_count = static_cast<uint32_t>(nodes.size());
+        out_encoded.header.leaf_node_count          = config.instance_count;
+
+        auto build_info = rta::CreateRtIp11AccelerationStructurePostBuildInfo();
+        build_info->SetBvhType(rta::BvhType::kTopLevel);
+        build_info->SetBuildFlags(rta::BvhBuildFlags::kFastTrace);
+        FinishAccelStruct(address, *build_info, parent_block, out_encoded);
+    }
+
+    /// @brief Write an acceleration structure chunk.
+    ///
+    /// @param [in]     encoded The encoded acceleration structure.
+    /// @param [in,out] writer  The chunk file writer.
+    ///
+    /// @return The size of the chunk header and data.
+    static uint64_t WriteAccelStruct(const EncodedAccelStruct& encoded, rdf::ChunkFileWriter& writer)
+    {
+        writer.BeginChunk(rta::IEncodedRtIp11Bvh::kChunkIdentifier,
+                          sizeof(encoded.chunk_header),
+                          &encoded.chunk_header,
+                          rdf::Compression::None,
+                          GPURT_ACCEL_STRUCT_VERSION);
+        writer.AppendToChunk(encoded.metadata.size(), encoded.metadata.data());
+        writer.AppendToChunk(sizeof(encoded.header), &encoded.header);
+        writer.AppendToChunk(encoded.interior_nodes.size(), encoded.interior_nodes.data());
+        writer.AppendToChunk(encoded.leaf_nodes.size(), encoded.leaf_nodes.data());
+        writer.AppendToChunk(encoded.geometry_infos.size() * sizeof(dxr::amd::GeometryInfo), encoded.geometry_infos.data());
+        writer.AppendToChunk(encoded.primitive_ptrs.size() * sizeof(dxr::amd::NodePointer), encoded.primitive_ptrs.data());
+        writer.EndChunk();
+
+        return sizeof(encoded.chunk_header) + encoded.metadata.size() + encoded.header.file_size_in_bytes - encoded.header.meta_data_size_in_bytes;
+    }
+
+    /// @brief Write the API and ASIC info chunks.
+    ///
+    /// @param [in,out] writer The chunk file writer.
+    ///
+    /// @return The size of the chunk data.
+    static uint64_t WriteSystemInfo(rdf::ChunkFileWriter& writer)
+    {
+        ApiInfo::TraceChunkApiInfo api_info = {};
+        api_info.api_type                   = ApiInfo::TraceApiType::VULKAN;
+        api_info.api_version_major          = 1;
+        api_info.api_version_minor          = 3;
+        writer.WriteChunk(ApiInfo::kChunkIdentifier, 0, nullptr, sizeof(api_info), &api_info);
+
+        AsicInfo::TraceChunkAsicInfo asic_info = {};
+        asic_info.gpu_type                     = AsicInfo::TraceGpuType::Virtual;
+        asic_info.gfx_ip_level                 = {10, 3, 0};
+        asic_info.memory_chip_type             = AsicInfo::TraceMemoryType::Unknown;
+        strncpy(asic_info.gpu_name, "Synthetic trace", sizeof(asic_info.gpu_name) - 1);
+        writer.WriteChunk(AsicInfo::kChunkIdentifier, 0, nullptr, sizeof(asic_info), &asic_info);
+
+        return sizeof(api_info) + sizeof(asic_info);
+    }
+
+    RraErrorCode ValidateTraceGeneratorConfig(const RraTraceGeneratorConfig& config)
+    {
+        RRA_RETURN_ON_ERROR(config.blas_count > 0 && config.blas_count <= kMaxPrimitiveCount, kRraErrorInvalidSize);
+        RRA_RETURN_ON_ERROR(config.triangles_per_blas > 0 && config.triangles_per_blas <= kMaxPrimitiveCount, kRraErrorInvalidSize);
+        RRA_RETURN_ON_ERROR(config.instance_count > 0 && config.instance_count <= kMaxPrimitiveCount, kRraErrorInvalidSize);
+        RRA_RETURN_ON_ERROR(config.inactive_instance_count <= config.instance_count, kRraErrorInvalidSize);
+        RRA_RETURN_ON_ERROR(config.tree_shape >= 0 && config.tree_shape < kRraTraceGeneratorTreeShapeCount, kRraErrorInvalidSize);
+        RRA_RETURN_ON_ERROR(config.triangle_compression_mode == kRraTriangleCompressionModeNone ||
+                                config.triangle_compression_mode == kRraTriangleCompressionModeTwoTriangles ||
+                                config.triangle_compression_mode == kRraTriangleCompressionModePairTriangles,
+                            kRraErrorInvalidSize);
+        RRA_RETURN_ON_ERROR(config.box_fp16_mode >= 0 && config.box_fp16_mode < kRraBoxFp16ModeCount, kRraErrorInvalidSize);
+        RRA_RETURN_ON_ERROR(config.fp16_tolerance >= 0.0f, kRraErrorInvalidSize);
+        return kRraOk;
+    }
+
+    RraErrorCode GenerateTrace(const char* file_path, const RraTraceGeneratorConfig& config, RraTraceGeneratorStats& out_stats)
+    {
+        out_stats = {};
+
+        // The RDF library reports errors with exceptions.
+        std::unique_ptr<rdf::Stream> stream;
+        try
+        {
+            stream = std::make_unique<rdf::Stream>(rdf::Stream::CreateFile(file_path));
+        }
+        catch (...)
+        {
+            return kRraErrorInvalidPath;
+        }
+
+        try
+        {
+            rdf::ChunkFileWriter writer(*stream);
+            out_stats.chunk_data_size += WriteSystemInfo(writer);
+
+            std::vector<GeneratedBlasInfo> blases(config.blas_count);
+            uint64_t                       address = kBaseVirtualAddress;
+            for (uint32_t i = 0; i < config.blas_count; i++)
+            {
+                EncodedAccelStruct blas;
+                GenerateBlas(config, i, address, blas, blases[i]);
+                out_stats.chunk_data_size += WriteAccelStruct(blas, writer);
+
+                out_stats.triangle_count += blas.header.primitive_count;
+                out_stats.fp32_box_node_count += blas.header.interior_fp32_node_count;
+                out_stats.fp16_box_node_count += blas.header.interior_fp16_node_count;
+                out_stats.leaf_node_count += blas.header.leaf_node_count;
+                address += AlignUp(blas.header.file_size_in_bytes, kVirtualAddressAlignment);
+            }
+
+            EncodedAccelStruct tlas;
+            GenerateTlas(config, blases, address, tlas);
+            out_stats.chunk_data_size += WriteAccelStruct(tlas, writer);
+            out_stats.fp32_box_node_count += tlas.header.interior_fp32_node_count;
+            out_stats.leaf_node_count += tlas.header.leaf_node_count;
+
+            writer.Close();
+            stream->Close();
+        }
+        catch (const std::bad_alloc&)
+        {
+            return kRraErrorOutOfMemory;
+        }
+        catch (...)
+        {
+            return kRraErrorPlatformFunctionFailed;
+        }
+
+        return kRraOk;
+    }
+}  // namespace rra
@@ -0,0 +1,35 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the synthetic trace generator.
+//=============================================================================
+
+#ifndef RRA_BACKEND_TRACE_GENERATOR_H_
+#define RRA_BACKEND_TRACE_GENERATOR_H_
+
+#include "public/rra_error.h"
+#include "public/rra_trace_generator.h"
+
+// Trace generator functions. Used only by the backend; the public interface is in rra_trace_generator.h.
+
+namespace rra
+{
+    /// @brief Check the trace generator settings.
+    ///
+    /// @param [in] config The settings.
+    ///
+    /// @return kRraOk if the settings are valid, kRraErrorInvalidSize if not.
+    RraErrorCode ValidateTraceGeneratorConfig(const RraTraceGeneratorConfig& config);
+
+    /// @brief Generate a trace and write it to a file.
+    ///
+    /// @param [in]  file_path The path of the file to write.
+    /// @param [in]  config    The settings. Must have passed ValidateTraceGeneratorConfig().
+    /// @param [out] out_stats The totals.
+    ///
+    /// @return kRraOk if successful, an error code if not.
+    RraErrorCode GenerateTrace(const char* file_path, const RraTraceGeneratorConfig& config, RraTraceGeneratorStats& out_stats);
+}  // namespace rra
+
+#endif  // RRA_BACKEND_TRACE_GENERATOR_H_
@@ -0,0 +1,440 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the triangle scanner.
+//=============================================================================
+
+#include "triangle_scan.h"
+
+#include <immintrin.h>
+#include <string.h>  // for memcpy()
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "blas_hash.h"
+#include "bvh/dxr_type_conversion.h"
+#include "job_system.h"
+
+namespace rra
+{
+    static const float kZeroAreaTolerance      = 1e-7f;  ///< Triangles with twice their area below this fraction of their longest edge squared have zero area.
+    static const float kSliverAspectRatio      = 1e4f;   ///< Triangles with a longest edge over this many times their shortest height are slivers.
+    static const float kOutsideParentTolerance = 1e-2f;  ///< How far a triangle may reach outside its parent's box, as a fraction of the box's largest extent.
+
+    /// @brief The triangles of a BLAS, laid out as structure-of-arrays so 8 triangles can be loaded into AVX registers at once.
+    struct TriangleBatch
+    {
+        std::array<std::vector<float>, 9> vertices;     ///< The vertex coordinates. Entry 3 * vertex + axis.
+        std::array<std::vector<float>, 6> boxes;        ///< The parent bounding box of each triangle, as min x, y, z then max x, y, z.
+        std::vector<uint32_t>             node_slots;   ///< The index of each triangle's node in the node list.
+        std::vector<uint8_t>              issue_flags;  ///< The TriangleIssueFlags found for each triangle.
+
+        /// @brief Add a triangle to the batch.
+        ///
+        /// @param [in] triangle  The triangle.
+        /// @param [in] box       The bounding box stored for the triangle's node in its parent.
+        /// @param [in] node_slot The index of the triangle's node in the node list.
+        void Add(const dxr::amd::Triangle& triangle, const dxr::amd::AxisAlignedBoundingBox& box, uint32_t node_slot)
+        {
+            const dxr::amd::Float3* triangle_vertices[3] = {&triangle.v0, &triangle.v1, &triangle.v2};
+            for (uint32_t vertex = 0; vertex < 3; vertex++)
+            {
+                vertices[3 * vertex + 0].push_back(triangle_vertices[vertex]->x);
+                vertices[3 * vertex + 1].push_back(triangle_vertices[vertex]->y);
+                vertices[3 * vertex + 2].push_back(triangle_vertices[vertex]->z);
+            }
+            boxes[0].push_back(box.min.x);
+            boxes[1].push_back(box.min.y);
+            boxes[2].push_back(box.min.z);
+            boxes[3].push_back(box.max.x);
+            boxes[4].push_back(box.max.y);
+            boxes[5].push_back(box.max.z);
+            node_slots.push_back(node_slot);
+        }
+
+        /// @brief Get the number of triangles in the batch.
+        ///
+        /// @return The triangle count.
+        size_t GetCount() const
+        {
+            return node_slots.size();
+        }
+    };
+
+    /// @brief The number of triangles FindTriangleIssues checks at once, one per AVX lane.
+    static const size_t kTriangleLaneCount = 8;
+
+    /// @brief The number of coordinate arrays FindTriangleIssues reads: the 9 vertex coordinates, then the 6 box bounds.
+    static const size_t kTriangleColumnCount = 15;
+
+    /// @brief Find the problems with 8 triangles that can be found from the triangles alone.
+    ///
+    /// The comparisons give all-ones or all-zeros lanes, which are combined with bitwise operations instead of branches.
+    /// std::min(a, b) and std::max(a, b) return a when either is NaN, which _mm256_min_ps(b, a) and _mm256_max_ps(b, a)
+    /// match, so the flags are the same as a scalar check would give.
+    ///
+    /// @param [in]  columns   The 9 vertex coordinates then the 6 box bounds, each pointing at the first of the 8 triangles.
+    /// @param [out] out_flags The TriangleIssueFlags found for each triangle.
+    static void FindTriangleIssuesX8(const float* const columns[kTriangleColumnCount], uint8_t out_flags[kTriangleLaneCount])
+    {
+        const __m256 v0_x  = _mm256_loadu_ps(columns[0]);
+        const __m256 v0_y  = _mm256_loadu_ps(columns[1]);
+        const __m256 v0_z  = _mm256_loadu_ps(columns[2]);
+        const __m256 v1_x  = _mm256_loadu_ps(columns[3]);
+        const __m256 v1_y  = _mm256_loadu_ps(columns[4]);
+        const __m256 v1_z  = _mm256_loadu_ps(columns[5]);
+        const __m256 v2_x  = _mm256_loadu_ps(columns[6]);
+        const __m256 v2_y  = _mm256_loadu_ps(columns[7]);
+        const __m256 v2_z  = _mm256_loadu_ps(columns[8]);
+        const __m256 min_x = _mm256_loadu_ps(columns[9]);
+        const __m256 min_y = _mm256_loadu_ps(columns[10]);
+        const __m256 min_z = _mm256_loadu_ps(columns[11]);
+        const __m256 max_x = _mm256_loadu_ps(columns[12]);
+        const __m256 max_y = _mm256_loadu_ps(columns[13]);
+        const __m256 max_z = _mm256_loadu_ps(columns[14]);
+
+        // A NaN or infinity anywhere makes the sum NaN or infinite, and subtracting it from itself then gives NaN.
+        __m256 sum = _mm256_add_ps(v0_x, v0_y);
+        sum        = _mm256_add_ps(sum, v0_z);
+        sum        = _mm256_add_ps(sum, v1_x);
+        sum        = _mm256_add_ps(sum, v1_y);
+        sum        = _mm256_add_ps(sum, v1_z);
+        sum        = _mm256_add_ps(sum, v2_x);
+        sum        = _mm256_add_ps(sum, v2_y);
+        sum        = _mm256_add_ps(sum, v2_z);
+
+        const __m256 zero     = _mm256_setzero_ps();
+        const __m256 finite   = _mm256_cmp_ps(_mm256_sub_ps(sum, sum), zero, _CMP_EQ_OQ);
+        const __m256 inactive = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(v0_x, v0_x, _CMP_UNORD_Q), _mm256_cmp_ps(v1_x, v1_x, _CMP_UNORD_Q)),
+                                              _mm256_cmp_ps(v2_x, v2_x, _CMP_UNORD_Q));
+
+        const __m256 e0_x = _mm256_sub_ps(v1_x, v0_x);
+        const __m256 e0_y = _mm256_sub_ps(v1_y, v0_y);
+        const __m256 e0_z = _mm256_sub_ps(v1_z, v0_z);
+        const __m256 e1_x = _mm256_sub_ps(v2_x, v0_x);
+        const __m256 e1_y = _mm256_sub_ps(v2_y, v0_y);
+        const __m256 e1_z = _mm256_sub_ps(v2_z, v0_z);
+        const __m256 e2_x = _mm256_sub_ps(v2_x, v1_x);
+        const __m256 e2_y = _mm256_sub_ps(v2_y, v1_y);
+        const __m256 e2_z = _mm256_sub_ps(v2_z, v1_z);
+
+        const __m256 cross_x = _mm256_sub_ps(_mm256_mul_ps(e0_y, e1_z), _mm256_mul_ps(e0_z, e1_y));
+        const __m256 cross_y = _mm256_sub_ps(_mm256_mul_ps(e0_z, e1_x), _mm256_mul_ps(e0_x, e1_z));
+        const __m256 cross_z = _mm256_sub_ps(_mm256_mul_ps(e0_x, e1_y), _mm256_mul_ps(e0_y, e1_x));
+
+        // The products are summed in the same order as the scalar dot products, and without fused multiply-adds, so the
+        // thresholds below see the same values.
+        const __m256 double_area =
+            _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cross_x, cross_x), _mm256_mul_ps(cross_y, cross_y)), _mm256_mul_ps(cross_z, cross_z)));
+        const __m256 e0_sq      = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e0_x, e0_x), _mm256_mul_ps(e0_y, e0_y)), _mm256_mul_ps(e0_z, e0_z));
+        const __m256 e1_sq      = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1_x, e1_x), _mm256_mul_ps(e1_y, e1_y)), _mm256_mul_ps(e1_z, e1_z));
+        const __m256 e2_sq      = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2_x, e2_x), _mm256_mul_ps(e2_y, e2_y)), _mm256_mul_ps(e2_z, e2_z));
+        const __m256 longest_sq = _mm256_max_ps(_mm256_max_ps(e2_sq, e1_sq), e0_sq);
+
+        // The longest edge over the shortest height is the longest edge squared over twice the area.
+        const __m256 zero_area = _mm256_cmp_ps(double_area, _mm256_mul_ps(_mm256_set1_ps(kZeroAreaTolerance), longest_sq), _CMP_LE_OQ);
+        const __m256 sliver =
+            _mm256_andnot_ps(zero_area, _mm256_cmp_ps(longest_sq, _mm256_mul_ps(_mm256_set1_ps(kSliverAspectRatio), double_area), _CMP_GT_OQ));
+
+        const __m256 largest_extent =
+            _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(max_z, min_z), _mm256_sub_ps(max_y, min_y)), _mm256_sub_ps(max_x, min_x));
+        const __m256 tolerance = _mm256_mul_ps(_mm256_set1_ps(kOutsideParentTolerance), largest_extent);
+
+        __m256 outside = _mm256_cmp_ps(_mm256_min_ps(_mm256_min_ps(v2_x, v1_x), v0_x), _mm256_sub_ps(min_x, tolerance), _CMP_LT_OQ);
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_min_ps(_mm256_min_ps(v2_y, v1_y), v0_y), _mm256_sub_ps(min_y, tolerance), _CMP_LT_OQ));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_min_ps(_mm256_min_ps(v2_z, v1_z), v0_z), _mm256_sub_ps(min_z, tolerance), _CMP_LT_OQ));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_max_ps(_mm256_max_ps(v2_x, v1_x), v0_x), _mm256_add_ps(max_x, tolerance), _CMP_GT_OQ));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_max_ps(_mm256_max_ps(v2_y, v1_y), v0_y), _mm256_add_ps(max_y, tolerance), _CMP_GT_OQ));
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_max_ps(_mm256_max_ps(v2_z, v1_z), v0_z), _mm256_add_ps(max_z, tolerance), _CMP_GT_OQ));
+
+        // Each mask keeps its flag bit, and the non-finite flag replaces the others unless the triangle is inactive.
+        const __m256i finite_flags =
+            _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_castps_si256(zero_area), _mm256_set1_epi32(rta::kTriangleIssueZeroArea)),
+                                            _mm256_and_si256(_mm256_castps_si256(sliver), _mm256_set1_epi32(rta::kTriangleIssueSliver))),
+                            _mm256_and_si256(_mm256_castps_si256(outside), _mm256_set1_epi32(rta::kTriangleIssueOutsideParent)));
+        const __m256i non_finite_flags = _mm256_andnot_si256(_mm256_castps_si256(inactive), _mm256_set1_epi32(rta::kTriangleIssueNonFinite));
+        const __m256i flags            = _mm256_blendv_epi8(non_finite_flags, finite_flags, _mm256_castps_si256(finite));
+
+        int32_t lane_flags[kTriangleLaneCount];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lane_flags), flags);
+        for (size_t lane = 0; lane < kTriangleLaneCount; lane++)
+        {
+            out_flags[lane] = static_cast<uint8_t>(lane_flags[lane]);
+        }
+    }
+
+    /// @brief Find the problems with each triangle that can be found from the triangle alone.
+    ///
+    /// The triangles are checked 8 at a time with AVX. The last few are copied into a zero padded block first, so
+    /// they go through the same checks.
+    ///
+    /// @param [in,out] batch The triangles. The issue flags are written.
+    static void FindTriangleIssues(TriangleBatch& batch)
+    {
+        const size_t count = batch.GetCount();
+        batch.issue_flags.resize(count);
+
+        const float* columns[kTriangleColumnCount];
+        for (size_t column = 0; column < 9; column++)
+        {
+            columns[column] = batch.vertices[column].data();
+        }
+        for (size_t column = 0; column < 6; column++)
+        {
+            columns[9 + column] = batch.boxes[column].data();
+        }
+
+        size_t first = 0;
+        for (; first + kTriangleLaneCount <= count; first += kTriangleLaneCount)
+        {
+            const float* block[kTriangleColumnCount];
+            for (size_t column = 0; column < kTriangleColumnCount; column++)
+            {
+                block[column] = columns[column] + first;
+            }
+            FindTriangleIssuesX8(block, &batch.issue_flags[first]);
+        }
+
+        if (first < count)
+        {
+            const size_t remaining = count - first;
+
+            float        padded[kTriangleColumnCount][kTriangleLaneCount] = {};
+            const float* block[kTriangleColumnCount];
+            for (size_t column = 0; column < kTriangleColumnCount; column++)
+            {
+                memcpy(padded[column], columns[column] + first, remaining * sizeof(float));
+                block[column] = padded[column];
+            }
+
+            uint8_t flags[kTriangleLaneCount];
+            FindTriangleIssuesX8(block, flags);
+            memcpy(&batch.issue_flags[first], flags, remaining);
+        }
+    }
+
+    /// @brief Find the triangles with the same vertex positions as another triangle in the batch.
+    ///
+    /// The vertices of each triangle are sorted first, so triangles with rotated or reversed vertex order are still
+    /// found.
+    ///
+    /// @param [in,out] batch The triangles. The duplicate flag is added to the issue flags.
+    static void FindDuplicateTriangles(TriangleBatch& batch)
+    {
+        const size_t count = batch.GetCount();
+
+        std::vector<std::array<float, 9>> sorted_vertices;
+        std::vector<size_t>               triangle_indices;
+        sorted_vertices.reserve(count);
+        triangle_indices.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if ((batch.issue_flags[i] & rta::kTriangleIssueNonFinite) != 0 || batch.vertices[0][i] != batch.vertices[0][i])
+            {
+                // Skip NaN vertices, which never compare equal, and inactive triangles.
+                continue;
+            }
+
+            std::array<std::array<float, 3>, 3> triangle;
+            for (uint32_t vertex = 0; vertex < 3; vertex++)
+            {
+                for (uint32_t axis = 0; axis < 3; axis++)
+                {
+                    triangle[vertex][axis] = CanonicalizeZero(batch.vertices[3 * vertex + axis][i]);
+                }
+            }
+            std::sort(triangle.begin(), triangle.end());
+
+            sorted_vertices.emplace_back();
+            memcpy(sorted_vertices.back().data(), triangle.data(), sizeof(triangle));
+            triangle_indices.push_back(i);
+        }
+
+        const std::vector<uint32_t> key_indices = GetKeyIndices(sorted_vertices);
+
+        std::vector<uint32_t> key_counts(sorted_vertices.size(), 0);
+        for (uint32_t key_index : key_indices)
+        {
+            key_counts[key_index]++;
+        }
+        for (size_t i = 0; i < triangle_indices.size(); i++)
+        {
+            if (key_counts[key_indices[i]] > 1)
+            {
+                batch.issue_flags[triangle_indices[i]] |= rta::kTriangleIssueDuplicate;
+            }
+        }
+    }
+
+    /// @brief Add the problems found with a triangle to a set of counts.
+    ///
+    /// @param [in]     issue_flags The TriangleIssueFlags of the triangle.
+    /// @param [in,out] counts      The counts.
+    static void AddToCounts(uint8_t issue_flags, rta::TriangleIssueCounts& counts)
+    {
+        counts.triangle_count++;
+        counts.zero_area_count += (issue_flags & rta::kTriangleIssueZeroArea) ? 1 : 0;
+        counts.sliver_count += (issue_flags & rta::kTriangleIssueSliver) ? 1 : 0;
+        counts.non_finite_count += (issue_flags & rta::kTriangleIssueNonFinite) ? 1 : 0;
+        counts.duplicate_count += (issue_flags & rta::kTriangleIssueDuplicate) ? 1 : 0;
+        counts.outside_parent_count += (issue_flags & rta::kTriangleIssueOutsideParent) ? 1 : 0;
+        counts.problem_triangle_count += (issue_flags != rta::kTriangleIssueNone) ? 1 : 0;
+    }
+
+    /// @brief Add one set of counts to another.
+    ///
+    /// @param [in]     counts The counts to add.
+    /// @param [in,out] totals The running totals.
+    static void AddCounts(const rta::TriangleIssueCounts& counts, rta::TriangleIssueCounts& totals)
+    {
+        totals.triangle_count += counts.triangle_count;
+        totals.zero_area_count += counts.zero_area_count;
+        totals.sliver_count += counts.sliver_count;
+        totals.non_finite_count += counts.non_finite_count;
+        totals.duplicate_count += counts.duplicate_count;
+        totals.outside_parent_count += counts.outside_parent_count;
+        totals.problem_triangle_count += counts.problem_triangle_count;
+    }
+
+    /// @brief Scan the triangles of a single BLAS.
+    ///
+    /// @param [in]  blas          The BLAS.
+    /// @param [in]  store_results If true, the per-node flags and counts are stored in the BLAS.
+    /// @param [out] out_counts    The problem counts for the BLAS.
+    static void ScanBlasTriangles(rta::EncodedRtIp11BottomLevelBvh* blas, bool store_results, rta::TriangleIssueCounts& out_counts)
+    {
+        out_counts = {};
+        if (blas->IsEmpty())
+        {
+            return;
+        }
+
+        const uint32_t leaf_nodes_offset = blas->GetHeader().GetBufferOffsets().leaf_nodes;
+        const auto     compression_mode  = rta::ToDxrTriangleCompressionMode(blas->GetHeader().GetPostBuildInfo().GetTriangleCompressionMode());
+
+        // Gather the triangles along with the box stored for their node in the parent, which is only known while walking the tree.
+        std::vector<dxr::amd::NodePointer> triangle_nodes;
+        TriangleBatch                      batch;
+
+        std::vector<dxr::amd::NodePointer> stack = {dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize)};
+        while (!stack.empty())
+        {
+            const dxr::amd::NodePointer node_ptr = stack.back();
+            stack.pop_back();
+
+            std::array<dxr::amd::AxisAlignedBoundingBox, 4> boxes;
+            const std::array<dxr::amd::NodePointer, 4>*     children = nullptr;
+            if (node_ptr.IsFp32BoxNode())
+            {
+                const dxr::amd::Float32BoxNode* box_node = blas->GetFloat32Box(node_ptr);
+                boxes                                    = box_node->GetBoundingBoxes();
+                children                                 = &box_node->GetChildren();
+            }
+            else
+            {
+                const dxr::amd::Float16BoxNode* box_node = blas->GetFloat16Box(node_ptr);
+                boxes                                    = box_node->GetBoundingBoxes();
+                children                                 = &box_node->GetChildren();
+            }
+
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                const dxr::amd::NodePointer child = (*children)[i];
+                if (child.IsInvalid())
+                {
+                    continue;
+                }
+
+                if (child.IsBoxNode())
+                {
+                    stack.push_back(child);
+                }
+                else if (child.IsTriangleNode())
+                {
+                    const dxr::amd::TriangleNode* triangle_node = blas->GetTriangleNode(child);
+                    const uint32_t                node_slot     = static_cast<uint32_t>(triangle_nodes.size());
+                    triangle_nodes.push_back(child);
+
+                    batch.Add(triangle_node->GetTriangle(dxr::amd::NodeType::kAmdNodeTriangle0, compression_mode), boxes[i], node_slot);
+                    if (child.GetType() == dxr::amd::NodeType::kAmdNodeTriangle1)
+                    {
+                        batch.Add(triangle_node->GetTriangle(dxr::amd::NodeType::kAmdNodeTriangle1, compression_mode), boxes[i], node_slot);
+                    }
+                }
+            }
+        }
+
+        FindTriangleIssues(batch);
+        FindDuplicateTriangles(batch);
+
+        std::vector<uint8_t>                  node_flags(triangle_nodes.size(), rta::kTriangleIssueNone);
+        std::vector<rta::TriangleIssueCounts> geometry_counts(blas->GetGeometryInfos().size());
+        for (size_t i = 0; i < batch.GetCount(); i++)
+        {
+            const uint32_t node_slot      = batch.node_slots[i];
+            const uint32_t geometry_index = blas->GetTriangleNode(triangle_nodes[node_slot])->GetGeometryIndex();
+            if (geometry_index >= geometry_counts.size())
+            {
+                geometry_counts.resize(geometry_index + 1);
+            }
+
+            node_flags[node_slot] |= batch.issue_flags[i];
+            AddToCounts(batch.issue_flags[i], out_counts);
+            AddToCounts(batch.issue_flags[i], geometry_counts[geometry_index]);
+        }
+
+        if (store_results)
+        {
+            for (size_t i = 0; i < triangle_nodes.size(); i++)
+            {
+                blas->SetLeafNodeIssueFlags((triangle_nodes[i].GetByteOffset() - leaf_nodes_offset) / sizeof(dxr::amd::TriangleNode), node_flags[i]);
+            }
+            blas->SetTriangleIssueCounts(out_counts, std::move(geometry_counts));
+        }
+    }
+
+    RraErrorCode ScanTriangles(RraDataSet& data_set, uint32_t thread_count, bool store_results, rta::TriangleIssueCounts* out_counts)
+    {
+        std::vector<rta::EncodedRtIp11BottomLevelBvh*> blases;
+        for (const auto& blas : data_set.bvh_bundle->GetBottomLevelBvhs())
+        {
+            rta::EncodedRtIp11BottomLevelBvh* bvh = dynamic_cast<rta::EncodedRtIp11BottomLevelBvh*>(&(*blas));
+            if (bvh == nullptr)
+            {
+                return kRraErrorInvalidPointer;
+            }
+            blases.push_back(bvh);
+        }
+
+        if (thread_count == 0)
+        {
+            thread_count = JobSystem::Get().GetThreadCount();
+        }
+
+        std::vector<rta::TriangleIssueCounts> thread_counts(thread_count);
+        JobSystem::Get().ParallelFor(blases.size(), 1, thread_count, [&blases, &thread_counts, store_results](size_t begin, size_t end, uint32_t call_index) {
+            for (size_t index = begin; index < end; index++)
+            {
+                rta::TriangleIssueCounts blas_counts;
+                ScanBlasTriangles(blases[index], store_results, blas_counts);
+                AddCounts(blas_counts, thread_counts[call_index]);
+            }
+        });
+
+        if (out_counts != nullptr)
+        {
+            *out_counts = {};
+            for (const auto& counts : thread_counts)
+            {
+                AddCounts(counts, *out_counts);
+            }
+        }
+
+        return kRraOk;
+    }
+}  // namespace rra
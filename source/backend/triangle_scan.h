@@ -0,0 +1,33 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the triangle scanner.
+//=============================================================================
+
+#ifndef RRA_BACKEND_TRIANGLE_SCAN_H_
+#define RRA_BACKEND_TRIANGLE_SCAN_H_
+
+#include "bvh/encoded_rt_ip_11_bottom_level_bvh.h"
+#include "rra_data_set.h"
+
+// Triangle scanner functions. Used only by the backend; the public interface is in rra_blas.h.
+
+namespace rra
+{
+    /// @brief Scan the triangles of every BLAS for degenerate and pathological triangles.
+    ///
+    /// Each triangle is checked for zero area, extreme aspect ratio, NaN or infinite vertices, a duplicate of
+    /// another triangle in the same BLAS, and reaching outside the bounding box stored for it in its parent node.
+    /// Inactive triangles are not reported. The BLASes are scanned in parallel.
+    ///
+    /// @param [in]  data_set      The data set containing the loaded trace data.
+    /// @param [in]  thread_count  The number of threads to use, or 0 for one per core.
+    /// @param [in]  store_results If true, the per-node flags and counts are stored in each BLAS.
+    /// @param [out] out_counts    The problem counts summed over all the BLASes. May be nullptr.
+    ///
+    /// @return RraOk if successful, an error code if not.
+    RraErrorCode ScanTriangles(RraDataSet& data_set, uint32_t thread_count, bool store_results, rta::TriangleIssueCounts* out_counts);
+}  // namespace rra
+
+#endif  // RRA_BACKEND_TRIANGLE_SCAN_H_
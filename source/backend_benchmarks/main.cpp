@@ -0,0 +1,822 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Benchmarks for the backend, run over generated traces.
+///
+/// Each trace size is generated with a fixed seed, so the same build on the
+/// same machine always measures the same data. Every benchmark is run a few
+/// times untimed to warm the caches, then timed over several iterations. The
+/// results are written as JSON so they can be tracked across commits.
+//=============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rdf/rdf/inc/amdrdf.h"
+
+#include "bvh/bvh_bundle.h"
+#include "bvh/encoded_rt_ip_11_top_level_bvh.h"
+#include "bvh/iencoded_rt_ip_11_bvh.h"
+#include "public/rra_blas.h"
+#include "public/rra_bvh.h"
+#include "public/rra_job_system.h"
+#include "public/rra_ray_cost.h"
+#include "public/rra_reference_bvh.h"
+#include "public/rra_tlas.h"
+#include "public/rra_trace_generator.h"
+#include "public/rra_trace_loader.h"
+
+#include "memory_stats.h"
+#include "rra_context.h"
+#include "surface_area_heuristic.h"
+#include "triangle_scan.h"
+
+namespace rta
+{
+    /// @brief Gives the benchmarks access to the tree scan the loader runs.
+    struct ScanTreeBenchmarkAccess
+    {
+        /// @brief Scan a tree again.
+        ///
+        /// @param [in] bvh The acceleration structure.
+        static void ScanTree(IEncodedRtIp11Bvh& bvh)
+        {
+            bvh.ScanTree();
+        }
+    };
+}  // namespace rta
+
+namespace rra
+{
+    namespace benchmarks
+    {
+        static const uint64_t kTraceSeed     = 0x5252414245484D4Bull;     ///< The seed for every generated trace.
+        static const uint64_t kRaySeed       = 1;                         ///< The seed for the ray cast benchmark.
+        static const uint32_t kRayCount      = 1 << 16;                   ///< The number of rays in the ray cast benchmark.
+        static const char*    kFormatName    = "rra_backend_benchmarks";  ///< Identifies the results file.
+        static const uint32_t kFormatVersion = 1;                         ///< The results file version.
+
+        /// @brief The settings for one of the generated traces.
+        struct TraceSize
+        {
+            const char* name;                ///< The name of the size, used on the command line and in the results.
+            uint32_t    blas_count;          ///< The number of BLASes.
+            uint32_t    triangles_per_blas;  ///< The number of triangles in each BLAS.
+            uint32_t    instance_count;      ///< The number of instances.
+        };
+
+        /// @brief The trace sizes, from a quick smoke test up to a heavy scene.
+        static const TraceSize kTraceSizes[] = {
+            {"small", 4, 1024, 16},
+            {"medium", 16, 16384, 256},
+            {"large", 64, 65536, 4096},
+        };
+
+        /// @brief The command line settings.
+        struct Options
+        {
+            std::vector<const TraceSize*> sizes;                             ///< The trace sizes to run.
+            std::string                   output_path  = "benchmarks.json";  ///< The results file.
+            std::string                   work_path    = ".";                ///< The directory for the generated traces.
+            uint32_t                      warmup_count = 2;                  ///< The number of untimed runs before timing.
+            uint32_t                      iterations   = 5;                  ///< The number of timed runs.
+            uint32_t                      thread_count = 0;                  ///< The thread count for multithreaded benchmarks, 0 for one per core.
+        };
+
+        /// @brief A single benchmark.
+        struct Benchmark
+        {
+            const char*               name;   ///< The benchmark name.
+            const char*               unit;   ///< What the work items are, for the throughput.
+            std::function<void()>     setup;  ///< Run untimed before each iteration. May be empty.
+            std::function<uint64_t()> run;    ///< The timed work. Returns the number of work items processed.
+        };
+
+        /// @brief The measurements for a single benchmark.
+        struct BenchmarkResult
+        {
+            const char* name             = nullptr;  ///< The benchmark name.
+            const char* unit             = nullptr;  ///< What the work items are.
+            uint64_t    items            = 0;        ///< The number of work items in one iteration.
+            double      min_seconds      = 0.0;      ///< The fastest iteration.
+            double      median_seconds   = 0.0;      ///< The median iteration.
+            double      mean_seconds     = 0.0;      ///< The mean iteration.
+            uint64_t    peak_rss_bytes   = 0;        ///< The peak resident set size while the benchmark ran.
+            uint64_t    allocation_count = 0;        ///< The heap allocations in one iteration.
+            uint64_t    allocated_bytes  = 0;        ///< The bytes allocated in one iteration.
+            uint64_t    jobs_executed    = 0;        ///< The jobs run in one iteration.
+            uint64_t    steal_count      = 0;        ///< The jobs stolen from another thread's queue in one iteration.
+            uint64_t    max_queue_depth  = 0;        ///< The most jobs waiting in a single queue in one iteration.
+        };
+
+        /// @brief The node pointers of a single BLAS.
+        struct BlasNodes
+        {
+            uint64_t              blas_index;  ///< The index of the BLAS.
+            std::vector<uint32_t> node_ptrs;   ///< Every node in the BLAS, in depth first order.
+        };
+
+        /// @brief Run a benchmark.
+        ///
+        /// @param [in] benchmark The benchmark.
+        /// @param [in] options   The command line settings.
+        ///
+        /// @return The measurements.
+        static BenchmarkResult RunBenchmark(const Benchmark& benchmark, const Options& options)
+        {
+            BenchmarkResult result = {};
+            result.name            = benchmark.name;
+            result.unit            = benchmark.unit;
+
+            ResetPeakResidentSetSize();
+            for (uint32_t i = 0; i < options.warmup_count; i++)
+            {
+                if (benchmark.setup)
+                {
+                    benchmark.setup();
+                }
+                benchmark.run();
+            }
+
+            std::vector<double> seconds;
+            for (uint32_t i = 0; i < options.iterations; i++)
+            {
+                if (benchmark.setup)
+                {
+                    benchmark.setup();
+                }
+
+                ResetAllocationCounts();
+                RraJobSystemResetStats();
+                const auto                          start  = std::chrono::steady_clock::now();
+                const uint64_t                      items  = benchmark.run();
+                const std::chrono::duration<double> time   = std::chrono::steady_clock::now() - start;
+                const AllocationCounts              counts = GetAllocationCounts();
+                RraJobSystemStats                   job_stats;
+                RraJobSystemGetStats(&job_stats);
+
+                // The work is the same each time, so the last iteration stands for all of them.
+                seconds.push_back(time.count());
+                result.items            = items;
+                result.allocation_count = counts.allocation_count;
+                result.allocated_bytes  = counts.allocated_bytes;
+                result.jobs_executed    = job_stats.jobs_executed;
+                result.steal_count      = job_stats.steal_count;
+                result.max_queue_depth  = job_stats.max_queue_depth;
+            }
+            result.peak_rss_bytes = GetPeakResidentSetSize();
+
+            std::sort(seconds.begin(), seconds.end());
+            double total = 0.0;
+            for (double value : seconds)
+            {
+                total += value;
+            }
+            result.min_seconds    = seconds.front();
+            result.median_seconds = seconds[seconds.size() / 2];
+            result.mean_seconds   = total / seconds.size();
+            return result;
+        }
+
+        /// @brief Find every node of every BLAS by walking down from the roots.
+        ///
+        /// @param [out] out_blases The nodes of each BLAS.
+        ///
+        /// @return The total number of nodes found.
+        static uint64_t EnumerateBlasNodes(std::vector<BlasNodes>& out_blases)
+        {
+            uint64_t blas_count = 0;
+            uint32_t root_node  = 0;
+            RraBvhGetTotalBlasCount(&blas_count);
+            RraBvhGetRootNodePtr(&root_node);
+
+            out_blases.resize(blas_count);
+            uint64_t              node_count = 0;
+            std::vector<uint32_t> stack;
+            std::vector<uint32_t> children;
+            for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+            {
+                BlasNodes& blas = out_blases[blas_index];
+                blas.blas_index = blas_index;
+                blas.node_ptrs.clear();
+                if (RraBlasIsEmpty(blas_index))
+                {
+                    continue;
+                }
+
+                stack.assign(1, root_node);
+                while (!stack.empty())
+                {
+                    const uint32_t node_ptr = stack.back();
+                    stack.pop_back();
+                    blas.node_ptrs.push_back(node_ptr);
+
+                    uint32_t child_count = 0;
+                    if (!RraBvhIsBoxNode(node_ptr) || RraBlasGetChildNodeCount(blas_index, node_ptr, &child_count) != kRraOk)
+                    {
+                        continue;
+                    }
+                    children.resize(child_count);
+                    RraBlasGetChildNodes(blas_index, node_ptr, children.data());
+                    stack.insert(stack.end(), children.rbegin(), children.rend());
+                }
+                node_count += blas.node_ptrs.size();
+            }
+            return node_count;
+        }
+
+        /// @brief Walk a tree breadth first with a queue of nodes and levels, like the separate depth and instance list
+        /// scans did before the loader merged them into ScanTree().
+        ///
+        /// @param [in]  bvh            The acceleration structure.
+        /// @param [out] out_leaf_nodes The leaf nodes, in breadth first order.
+        /// @param [out] out_max_depth  The maximum depth of the tree.
+        ///
+        /// @return The number of nodes visited.
+        static uint64_t WalkTreeWithQueue(const rta::IEncodedRtIp11Bvh&       bvh,
+                                          std::vector<dxr::amd::NodePointer>& out_leaf_nodes,
+                                          uint32_t&                           out_max_depth)
+        {
+            out_leaf_nodes.clear();
+            out_max_depth = 0;
+            if (bvh.GetHeader().GetInteriorNodeCount() == 0)
+            {
+                return 0;
+            }
+
+            const auto& interior_nodes = bvh.GetInteriorNodesData();
+            const auto& header_offsets = bvh.GetHeader().GetBufferOffsets();
+
+            std::deque<std::pair<dxr::amd::NodePointer, uint32_t>> traversal_queue;
+            traversal_queue.push_back({dxr::amd::NodePointer(dxr::amd::NodeType::kAmdNodeBoxFp32, dxr::amd::kAccelerationStructureHeaderSize), 0});
+
+            uint64_t node_count = 0;
+            while (!traversal_queue.empty())
+            {
+                const dxr::amd::NodePointer node_ptr = traversal_queue.front().first;
+                const uint32_t              level    = traversal_queue.front().second;
+                traversal_queue.pop_front();
+                out_max_depth = std::max(out_max_depth, level + 1);
+                node_count++;
+
+                if (!node_ptr.IsBoxNode())
+                {
+                    out_leaf_nodes.push_back(node_ptr);
+                    continue;
+                }
+
+                const size_t byte_offset = node_ptr.GetByteOffset() - header_offsets.interior_nodes;
+                if (byte_offset >= interior_nodes.size())
+                {
+                    continue;
+                }
+
+                std::array<dxr::amd::NodePointer, 4> children;
+                if (node_ptr.IsFp32BoxNode())
+                {
+                    children = reinterpret_cast<const dxr::amd::Float32BoxNode*>(&interior_nodes[byte_offset])->GetChildren();
+                }
+                else
+                {
+                    children = reinterpret_cast<const dxr::amd::Float16BoxNode*>(&interior_nodes[byte_offset])->GetChildren();
+                }
+                for (const dxr::amd::NodePointer& child : children)
+                {
+                    if (!child.IsInvalid())
+                    {
+                        traversal_queue.push_back({child, level + 1});
+                    }
+                }
+            }
+            return node_count;
+        }
+
+        /// @brief Find the triangle nodes of a BLAS through the API a level at a time, like the SAH and geometry hash
+        /// passes did before they used the leaf nodes from ScanTree().
+        ///
+        /// @param [in]  blas_index         The index of the BLAS.
+        /// @param [out] out_triangle_nodes The triangle nodes.
+        static void FindTriangleNodesThroughApi(uint64_t blas_index, std::vector<uint32_t>& out_triangle_nodes)
+        {
+            out_triangle_nodes.clear();
+            uint32_t root_node = 0;
+            RraBvhGetRootNodePtr(&root_node);
+
+            std::vector<uint32_t> traverse_nodes = {root_node};
+            std::vector<uint32_t> next_nodes;
+            std::vector<uint32_t> child_nodes;
+            while (!traverse_nodes.empty())
+            {
+                next_nodes.clear();
+                for (uint32_t node_ptr : traverse_nodes)
+                {
+                    uint32_t child_count    = 0;
+                    uint32_t triangle_count = 0;
+                    if (RraBlasGetChildNodeCount(blas_index, node_ptr, &child_count) != kRraOk)
+                    {
+                        continue;
+                    }
+                    child_nodes.resize(child_count);
+                    RraBlasGetChildNodes(blas_index, node_ptr, child_nodes.data());
+                    next_nodes.insert(next_nodes.end(), child_nodes.begin(), child_nodes.end());
+
+                    if (RraBlasGetNodeTriangleCount(blas_index, node_ptr, &triangle_count) == kRraOk && triangle_count > 0)
+                    {
+                        out_triangle_nodes.push_back(node_ptr);
+                    }
+                }
+                std::swap(traverse_nodes, next_nodes);
+            }
+        }
+
+        /// @brief Get the size of a file.
+        ///
+        /// @param [in] file_path The path of the file.
+        ///
+        /// @return The size in bytes, or 0 if the file could not be opened.
+        static uint64_t GetFileSize(const std::string& file_path)
+        {
+            std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+            return file ? static_cast<uint64_t>(file.tellg()) : 0;
+        }
+
+        /// @brief Run every benchmark against a single trace.
+        ///
+        /// @param [in]  trace_path  The path of the trace.
+        /// @param [in]  options     The command line settings.
+        /// @param [out] out_results The measurements.
+        ///
+        /// @return kRraOk if successful or an RraErrorCode if the trace could not be loaded.
+        static RraErrorCode RunTraceBenchmarks(const std::string& trace_path, const Options& options, std::vector<BenchmarkResult>& out_results)
+        {
+            const uint64_t file_size = GetFileSize(trace_path);
+
+            // Load first, since everything else needs the trace loaded. The last load is left in place.
+            const auto load_trace = [&trace_path, file_size]() { return (RraTraceLoaderLoad(trace_path.c_str()) == kRraOk) ? file_size : 0; };
+            out_results.push_back(RunBenchmark({"trace_load", "bytes", RraTraceLoaderUnload, load_trace}, options));
+            if (!RraTraceLoaderValid())
+            {
+                return kRraErrorMalformedData;
+            }
+
+            // Just the chunk parsing and acceleration structure decode, without the rest of the loader's work.
+            const auto decode_chunks = [&trace_path, file_size]() {
+                auto           file       = rdf::Stream::OpenFile(trace_path.c_str());
+                rdf::ChunkFile chunk_file = rdf::ChunkFile(file);
+                RraErrorCode   error_code = kRraOk;
+                auto bundle = rta::LoadBvhBundleFromFile(chunk_file, rta::BvhEncoding::kAmdRtIp_1_1, rta::BvhBundleReadOption::kDefault, &error_code);
+                return (bundle != nullptr && error_code == kRraOk) ? file_size : 0;
+            };
+            out_results.push_back(RunBenchmark({"chunk_decode", "bytes", nullptr, decode_chunks}, options));
+
+            std::vector<BlasNodes> blases;
+            const auto             enumerate_children = [&blases]() { return EnumerateBlasNodes(blases); };
+            out_results.push_back(RunBenchmark({"child_enumeration", "nodes", nullptr, enumerate_children}, options));
+
+            // The single pass over each tree the loader runs, which finds the depths, node counts and leaf nodes
+            // together.
+            const auto scan_trees = []() {
+                const rta::BvhBundle* bundle     = RraContextGetDefault()->data_set.bvh_bundle.get();
+                uint64_t              node_count = 0;
+                for (const auto* bvhs : {&bundle->GetTopLevelBvhs(), &bundle->GetBottomLevelBvhs()})
+                {
+                    for (const auto& bvh : *bvhs)
+                    {
+                        auto* encoded_bvh = dynamic_cast<rta::IEncodedRtIp11Bvh*>(bvh.get());
+                        if (encoded_bvh == nullptr)
+                        {
+                            return uint64_t(0);
+                        }
+                        rta::ScanTreeBenchmarkAccess::ScanTree(*encoded_bvh);
+
+                        const rta::BvhNodeTypeCounts& counts = encoded_bvh->GetScannedNodeCounts();
+                        node_count += counts.box32 + counts.box16 + counts.triangle + counts.procedural + counts.instance;
+                    }
+                }
+                return node_count;
+            };
+            out_results.push_back(RunBenchmark({"scan_tree", "nodes", nullptr, scan_trees}, options));
+
+            // The separate walks ScanTree() replaced: a depth scan of every tree, a second walk of each TLAS for its
+            // instance list, and a walk of each BLAS through the API for its triangle nodes. The node count is the same
+            // as scan_tree's, so the two rates can be compared directly.
+            const auto separate_scans = []() {
+                const rta::BvhBundle*              bundle     = RraContextGetDefault()->data_set.bvh_bundle.get();
+                uint64_t                           node_count = 0;
+                uint32_t                           max_depth  = 0;
+                std::vector<dxr::amd::NodePointer> leaf_nodes;
+                std::vector<dxr::amd::NodePointer> instance_nodes;
+                std::vector<uint32_t>              triangle_nodes;
+                for (const auto& bvh : bundle->GetTopLevelBvhs())
+                {
+                    auto* tlas = dynamic_cast<const rta::EncodedRtIp11TopLevelBvh*>(bvh.get());
+                    if (tlas == nullptr)
+                    {
+                        return uint64_t(0);
+                    }
+                    node_count += WalkTreeWithQueue(*tlas, leaf_nodes, max_depth);
+
+                    WalkTreeWithQueue(*tlas, leaf_nodes, max_depth);
+                    instance_nodes.clear();
+                    for (const dxr::amd::NodePointer& node_ptr : leaf_nodes)
+                    {
+                        if (node_ptr.IsInstanceNode() &&
+                            (node_ptr.GetByteOffset() - tlas->GetHeader().GetBufferOffsets().leaf_nodes) / sizeof(dxr::amd::InstanceNode) <
+                                tlas->GetInstanceNodes().size())
+                        {
+                            instance_nodes.push_back(node_ptr);
+                        }
+                    }
+                }
+
+                const auto& blases = bundle->GetBottomLevelBvhs();
+                for (size_t blas_index = 0; blas_index < blases.size(); blas_index++)
+                {
+                    auto* blas = dynamic_cast<const rta::IEncodedRtIp11Bvh*>(blases[blas_index].get());
+                    if (blas == nullptr)
+                    {
+                        return uint64_t(0);
+                    }
+                    node_count += WalkTreeWithQueue(*blas, leaf_nodes, max_depth);
+                    if (!blas->IsEmpty())
+                    {
+                        FindTriangleNodesThroughApi(blas_index, triangle_nodes);
+                    }
+                }
+                return node_count;
+            };
+            out_results.push_back(RunBenchmark({"separate_tree_scans", "nodes", nullptr, separate_scans}, options));
+
+            // The whole SAH pass the loader runs, which recomputes the SAH of every node in every BLAS and TLAS.
+            uint64_t blas_node_count = 0;
+            for (const BlasNodes& blas : blases)
+            {
+                blas_node_count += blas.node_ptrs.size();
+            }
+            const auto calculate_sah = [blas_node_count]() {
+                return (rra::CalculateSurfaceAreaHeuristics(RraContextGetDefault()) == kRraOk) ? blas_node_count : 0;
+            };
+            out_results.push_back(RunBenchmark({"surface_area_heuristic", "nodes", nullptr, calculate_sah}, options));
+
+            const auto query_bounds = [&blases]() {
+                uint64_t count = 0;
+                for (const BlasNodes& blas : blases)
+                {
+                    for (uint32_t node_ptr : blas.node_ptrs)
+                    {
+                        BoundingVolumeExtents extents = {};
+                        count += (RraBlasGetBoundingVolumeExtents(blas.blas_index, node_ptr, &extents) == kRraOk) ? 1 : 0;
+                    }
+                }
+                return count;
+            };
+            out_results.push_back(RunBenchmark({"bounds_query", "nodes", nullptr, query_bounds}, options));
+
+            // Scan the triangles again without storing the results, which are the same as the ones stored at load time.
+            const uint32_t thread_count   = options.thread_count;
+            const auto     scan_triangles = [thread_count]() {
+                rta::TriangleIssueCounts counts;
+                return (rra::ScanTriangles(RraContextGetDefault()->data_set, thread_count, false, &counts) == kRraOk) ? counts.triangle_count : 0;
+            };
+            out_results.push_back(RunBenchmark({"triangle_scan", "triangles", nullptr, scan_triangles}, options));
+
+            RraRayCostConfig ray_config = {};
+            RraRayCostGetDefaultConfig(&ray_config);
+            ray_config.distribution = kRraRayDistributionUniformSphere;
+            ray_config.ray_count    = kRayCount;
+            ray_config.seed         = kRaySeed;
+            ray_config.thread_count = thread_count;
+
+            const auto cast_rays = [&ray_config]() {
+                RraRayCostStats stats = {};
+                RraRayCostEstimateTlas(0, &ray_config, &stats, nullptr, nullptr);
+                return stats.ray_count;
+            };
+            out_results.push_back(RunBenchmark({"ray_cast", "rays", nullptr, cast_rays}, options));
+
+            // Rebuild every BLAS with the reference builder. This includes the SAH metrics of both trees, which are
+            // part of every comparison, but no rays are cast.
+            const auto build_reference_bvhs = [&blases, thread_count]() {
+                uint64_t triangle_count = 0;
+                for (const BlasNodes& blas : blases)
+                {
+                    RraReferenceBvhStats stats = {};
+                    if (!blas.node_ptrs.empty() && RraReferenceBvhCompareBlas(blas.blas_index, thread_count, nullptr, &stats) == kRraOk)
+                    {
+                        triangle_count += stats.triangle_count;
+                    }
+                }
+                return triangle_count;
+            };
+            out_results.push_back(RunBenchmark({"reference_bvh_build", "triangles", nullptr, build_reference_bvhs}, options));
+
+            // The columns are allocated once, so only the extraction is measured.
+            uint64_t row_count = 0;
+            RraTlasGetInstanceTableRowCount(0, &row_count);
+            std::vector<uint32_t>              node_ptr_column(row_count);
+            std::vector<uint64_t>              blas_index_column(row_count);
+            std::vector<uint64_t>              blas_instance_index_column(row_count);
+            std::vector<uint32_t>              instance_index_column(row_count);
+            std::vector<uint64_t>              instance_address_column(row_count);
+            std::vector<uint64_t>              instance_offset_column(row_count);
+            std::vector<float>                 transform_column(row_count * 12);
+            std::vector<float>                 original_transform_column(row_count * 12);
+            std::vector<uint32_t>              mask_column(row_count);
+            std::vector<uint32_t>              instance_id_column(row_count);
+            std::vector<uint32_t>              hit_group_column(row_count);
+            std::vector<uint32_t>              flags_column(row_count);
+            std::vector<BoundingVolumeExtents> bounding_volume_column(row_count);
+
+            RraTlasInstanceTable table = {};
+            table.node_ptr             = node_ptr_column.data();
+            table.blas_index           = blas_index_column.data();
+            table.blas_instance_index  = blas_instance_index_column.data();
+            table.instance_index       = instance_index_column.data();
+            table.instance_address     = instance_address_column.data();
+            table.instance_offset      = instance_offset_column.data();
+            table.transform            = transform_column.data();
+            table.original_transform   = original_transform_column.data();
+            table.mask                 = mask_column.data();
+            table.instance_id          = instance_id_column.data();
+            table.hit_group            = hit_group_column.data();
+            table.flags                = flags_column.data();
+            table.bounding_volume      = bounding_volume_column.data();
+
+            const auto extract_instances = [&table, row_count, thread_count]() {
+                return (RraTlasGetInstanceTable(0, thread_count, &table) == kRraOk) ? row_count : 0;
+            };
+            out_results.push_back(RunBenchmark({"instance_table", "rows", nullptr, extract_instances}, options));
+
+            RraTraceLoaderUnload();
+            return kRraOk;
+        }
+
+        /// @brief Append a JSON number field to a string.
+        ///
+        /// @param [in,out] json   The string to append to.
+        /// @param [in]     indent The indent, including the separator from the previous field.
+        /// @param [in]     name   The field name.
+        /// @param [in]     value  The field value.
+        static void AppendField(std::string& json, const char* indent, const char* name, double value)
+        {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%.9g", value);
+            json += std::string(indent) + "\"" + name + "\": " + buffer;
+        }
+
+        /// @brief Append a JSON integer field to a string.
+        ///
+        /// @param [in,out] json   The string to append to.
+        /// @param [in]     indent The indent, including the separator from the previous field.
+        /// @param [in]     name   The field name.
+        /// @param [in]     value  The field value.
+        static void AppendField(std::string& json, const char* indent, const char* name, uint64_t value)
+        {
+            json += std::string(indent) + "\"" + name + "\": " + std::to_string(value);
+        }
+
+        /// @brief Append a JSON string field to a string. The value must not need escaping.
+        ///
+        /// @param [in,out] json   The string to append to.
+        /// @param [in]     indent The indent, including the separator from the previous field.
+        /// @param [in]     name   The field name.
+        /// @param [in]     value  The field value.
+        static void AppendField(std::string& json, const char* indent, const char* name, const char* value)
+        {
+            json += std::string(indent) + "\"" + name + "\": \"" + value + "\"";
+        }
+
+        /// @brief Append the results for a single trace to the JSON results.
+        ///
+        /// @param [in,out] json    The string to append to.
+        /// @param [in]     size    The trace size.
+        /// @param [in]     stats   The totals from generating the trace.
+        /// @param [in]     results The measurements.
+        static void AppendTraceResults(std::string&                        json,
+                                       const TraceSize&                    size,
+                                       const RraTraceGeneratorStats&       stats,
+                                       const std::vector<BenchmarkResult>& results)
+        {
+            json += "    {\n";
+            AppendField(json, "      ", "name", size.name);
+            AppendField(json, ",\n      ", "blas_count", static_cast<uint64_t>(size.blas_count));
+            AppendField(json, ",\n      ", "triangles_per_blas", static_cast<uint64_t>(size.triangles_per_blas));
+            AppendField(json, ",\n      ", "instance_count", static_cast<uint64_t>(size.instance_count));
+            AppendField(json, ",\n      ", "triangle_count", stats.triangle_count);
+            AppendField(json, ",\n      ", "chunk_data_size", stats.chunk_data_size);
+            json += ",\n      \"benchmarks\": [\n";
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                const BenchmarkResult& result     = results[i];
+                const double           throughput = (result.median_seconds > 0.0) ? result.items / result.median_seconds : 0.0;
+
+                json += "        {";
+                AppendField(json, "", "name", result.name);
+                AppendField(json, ", ", "unit", result.unit);
+                AppendField(json, ", ", "items", result.items);
+                AppendField(json, ", ", "min_seconds", result.min_seconds);
+                AppendField(json, ", ", "median_seconds", result.median_seconds);
+                AppendField(json, ", ", "mean_seconds", result.mean_seconds);
+                AppendField(json, ", ", "throughput", throughput);
+                AppendField(json, ", ", "peak_rss_bytes", result.peak_rss_bytes);
+                AppendField(json, ", ", "allocations", result.allocation_count);
+                AppendField(json, ", ", "allocated_bytes", result.allocated_bytes);
+                AppendField(json, ", ", "jobs", result.jobs_executed);
+                AppendField(json, ", ", "steals", result.steal_count);
+                AppendField(json, ", ", "max_queue_depth", result.max_queue_depth);
+                json += (i + 1 < results.size()) ? "},\n" : "}\n";
+            }
+            json += "      ]\n    }";
+        }
+
+        /// @brief Print the command line options.
+        ///
+        /// @param [in] program_name The name the program was run with.
+        static void PrintUsage(const char* program_name)
+        {
+            printf("Usage: %s [options]\n", program_name);
+            printf("  --output <file>      Where to write the JSON results (default benchmarks.json).\n");
+            printf("  --work-dir <dir>     Where to write the generated traces (default the current directory).\n");
+            printf("  --sizes <list>       Comma separated trace sizes: small, medium, large (default small,medium).\n");
+            printf("  --warmup <n>         Untimed runs of each benchmark before timing (default 2).\n");
+            printf("  --iterations <n>     Timed runs of each benchmark (default 5).\n");
+            printf("  --threads <n>        Threads for the multithreaded benchmarks, 0 for one per core (default 0).\n");
+        }
+
+        /// @brief Parse a comma separated list of trace sizes.
+        ///
+        /// @param [in]  list      The list.
+        /// @param [out] out_sizes The trace sizes.
+        ///
+        /// @return true if every name is a known size, false if not.
+        static bool ParseSizes(const char* list, std::vector<const TraceSize*>& out_sizes)
+        {
+            out_sizes.clear();
+            std::string remaining(list);
+            while (!remaining.empty())
+            {
+                const size_t      comma = remaining.find(',');
+                const std::string name  = remaining.substr(0, comma);
+                remaining               = (comma == std::string::npos) ? "" : remaining.substr(comma + 1);
+
+                auto size = std::find_if(std::begin(kTraceSizes), std::end(kTraceSizes), [&name](const TraceSize& s) { return name == s.name; });
+                if (size == std::end(kTraceSizes))
+                {
+                    return false;
+                }
+                out_sizes.push_back(size);
+            }
+            return !out_sizes.empty();
+        }
+
+        /// @brief Parse the command line.
+        ///
+        /// @param [in]  argc        The number of arguments.
+        /// @param [in]  argv        The arguments.
+        /// @param [out] out_options The settings.
+        ///
+        /// @return true if the command line is valid, false if not.
+        static bool ParseCommandLine(int argc, char* argv[], Options& out_options)
+        {
+            out_options.sizes = {&kTraceSizes[0], &kTraceSizes[1]};
+            for (int i = 1; i < argc; i++)
+            {
+                if (i + 1 >= argc)
+                {
+                    return false;
+                }
+                const char* argument = argv[i];
+                const char* value    = argv[++i];
+
+                if (strcmp(argument, "--output") == 0)
+                {
+                    out_options.output_path = value;
+                }
+                else if (strcmp(argument, "--work-dir") == 0)
+                {
+                    out_options.work_path = value;
+                }
+                else if (strcmp(argument, "--sizes") == 0)
+                {
+                    if (!ParseSizes(value, out_options.sizes))
+                    {
+                        return false;
+                    }
+                }
+                else if (strcmp(argument, "--warmup") == 0)
+                {
+                    out_options.warmup_count = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+                }
+                else if (strcmp(argument, "--iterations") == 0)
+                {
+                    out_options.iterations = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+                }
+                else if (strcmp(argument, "--threads") == 0)
+                {
+                    out_options.thread_count = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return out_options.iterations > 0;
+        }
+    }  // namespace benchmarks
+}  // namespace rra
+
+int main(int argc, char* argv[])
+{
+    using namespace rra::benchmarks;
+
+    Options options;
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    RraJobSystemSetThreadCount(options.thread_count);
+
+    std::string json = "{\n";
+    AppendField(json, "  ", "format", kFormatName);
+    AppendField(json, ",\n  ", "version", static_cast<uint64_t>(kFormatVersion));
+    AppendField(json, ",\n  ", "warmup", static_cast<uint64_t>(options.warmup_count));
+    AppendField(json, ",\n  ", "iterations", static_cast<uint64_t>(options.iterations));
+    AppendField(json, ",\n  ", "thread_count", static_cast<uint64_t>(RraJobSystemGetThreadCount()));
+    json += ",\n  \"traces\": [\n";
+
+    for (size_t i = 0; i < options.sizes.size(); i++)
+    {
+        const TraceSize&  size       = *options.sizes[i];
+        const std::string trace_path = options.work_path + "/benchmark_" + size.name + ".rra";
+
+        RraTraceGeneratorConfig config = {};
+        RraTraceGeneratorGetDefaultConfig(&config);
+        config.blas_count         = size.blas_count;
+        config.triangles_per_blas = size.triangles_per_blas;
+        config.instance_count     = size.instance_count;
+        config.seed               = kTraceSeed;
+
+        printf("Generating the %s trace...\n", size.name);
+        RraTraceGeneratorStats stats      = {};
+        RraErrorCode           error_code = RraTraceGeneratorWrite(trace_path.c_str(), &config, &stats);
+        if (error_code != kRraOk)
+        {
+            fprintf(stderr, "Failed to write %s (error %d).\n", trace_path.c_str(), error_code);
+            return EXIT_FAILURE;
+        }
+
+        printf("Running the %s benchmarks...\n", size.name);
+        std::vector<BenchmarkResult> results;
+        error_code = RunTraceBenchmarks(trace_path, options, results);
+        remove(trace_path.c_str());
+        if (error_code != kRraOk)
+        {
+            fprintf(stderr, "Failed to load %s (error %d).\n", trace_path.c_str(), error_code);
+            return EXIT_FAILURE;
+        }
+
+        for (const BenchmarkResult& result : results)
+        {
+            printf("  %-24s %12.6f s  %14.0f %s/s\n",
+                   result.name,
+                   result.median_seconds,
+                   (result.median_seconds > 0.0) ? result.items / result.median_seconds : 0.0,
+                   result.unit);
+        }
+
+        AppendTraceResults(json, size, stats, results);
+        json += (i + 1 < options.sizes.size()) ? ",\n" : "\n";
+    }
+    json += "  ]\n}\n";
+
+    FILE* output_file = fopen(options.output_path.c_str(), "wb");
+    if (output_file == nullptr)
+    {
+        fprintf(stderr, "Failed to open %s.\n", options.output_path.c_str());
+        return EXIT_FAILURE;
+    }
+    const size_t written = fwrite(json.data(), 1, json.size(), output_file);
+    fclose(output_file);
+    if (written != json.size())
+    {
+        fprintf(stderr, "Failed to write %s.\n", options.output_path.c_str());
+        return EXIT_FAILURE;
+    }
+
+    printf("Wrote %s\n", options.output_path.c_str());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the memory counters used by the backend benchmarks.
+//=============================================================================
+
+#include "memory_stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static std::atomic<uint64_t> allocation_count(0);  ///< The number of allocations since the last reset.
+static std::atomic<uint64_t> allocated_bytes(0);   ///< The number of bytes allocated since the last reset.
+
+/// @brief Allocate memory and count the allocation.
+///
+/// @param [in] size The number of bytes to allocate.
+///
+/// @return The allocated memory, or nullptr if the allocation failed.
+static void* CountedAllocate(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    return malloc(size > 0 ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+    void* memory = CountedAllocate(size);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    free(memory);
+}
+
+namespace rra
+{
+    namespace benchmarks
+    {
+        void ResetAllocationCounts()
+        {
+            allocation_count.store(0, std::memory_order_relaxed);
+            allocated_bytes.store(0, std::memory_order_relaxed);
+        }
+
+        AllocationCounts GetAllocationCounts()
+        {
+            AllocationCounts counts = {};
+            counts.allocation_count = allocation_count.load(std::memory_order_relaxed);
+            counts.allocated_bytes  = allocated_bytes.load(std::memory_order_relaxed);
+            return counts;
+        }
+
+        void ResetPeakResidentSetSize()
+        {
+#ifdef _LINUX
+            // Writing 5 to clear_refs resets the peak resident set size (VmHWM).
+            FILE* clear_refs = fopen("/proc/self/clear_refs", "w");
+            if (clear_refs != nullptr)
+            {
+                fputs("5", clear_refs);
+                fclose(clear_refs);
+            }
+#endif
+        }
+
+        uint64_t GetPeakResidentSetSize()
+        {
+#if defined(_WIN32)
+            PROCESS_MEMORY_COUNTERS counters = {};
+            if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            {
+                return counters.PeakWorkingSetSize;
+            }
+            return 0;
+#elif defined(_LINUX)
+            // VmHWM follows the reset above, unlike getrusage().
+            uint64_t peak   = 0;
+            FILE*    status = fopen("/proc/self/status", "r");
+            if (status != nullptr)
+            {
+                char line[256];
+                while (fgets(line, sizeof(line), status) != nullptr)
+                {
+                    if (strncmp(line, "VmHWM:", 6) == 0)
+                    {
+                        peak = strtoull(line + 6, nullptr, 10) * 1024;
+                        break;
+                    }
+                }
+                fclose(status);
+            }
+            return peak;
+#else
+            // macOS reports ru_maxrss in bytes.
+            struct rusage usage = {};
+            getrusage(RUSAGE_SELF, &usage);
+            return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+        }
+    }  // namespace benchmarks
+}  // namespace rra
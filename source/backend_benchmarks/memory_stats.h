@@ -0,0 +1,47 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Definition of the memory counters used by the backend benchmarks.
+//=============================================================================
+
+#ifndef RRA_BACKEND_BENCHMARKS_MEMORY_STATS_H_
+#define RRA_BACKEND_BENCHMARKS_MEMORY_STATS_H_
+
+#include <stdint.h>
+
+namespace rra
+{
+    namespace benchmarks
+    {
+        /// @brief The heap allocations made by C++ code since the counters were last reset.
+        ///
+        /// The counts come from replacing the global operator new, so they include the backend but not memory
+        /// allocated with malloc() directly, such as inside the RDF library.
+        struct AllocationCounts
+        {
+            uint64_t allocation_count = 0;  ///< The number of allocations.
+            uint64_t allocated_bytes  = 0;  ///< The number of bytes allocated.
+        };
+
+        /// @brief Reset the allocation counters to zero.
+        void ResetAllocationCounts();
+
+        /// @brief Get the allocation counters.
+        ///
+        /// @return The allocations made since the counters were last reset.
+        AllocationCounts GetAllocationCounts();
+
+        /// @brief Reset the peak resident set size to the current resident set size, where the platform allows it.
+        ///
+        /// Only Linux can reset the peak. Elsewhere the peak covers the whole life of the process.
+        void ResetPeakResidentSetSize();
+
+        /// @brief Get the peak resident set size.
+        ///
+        /// @return The peak resident set size in bytes, or 0 if it is not available.
+        uint64_t GetPeakResidentSetSize();
+    }  // namespace benchmarks
+}  // namespace rra
+
+#endif  // RRA_BACKEND_BENCHMARKS_MEMORY_STATS_H_
@@ -50,6 +50,9 @@ namespace rra
     static const int  kQtTooltipFloatPrecision = 7;    ///< Decimal place precision for tooltip of printed floating point values.
     static const char kQtFloatFormat           = 'f';  ///< Floating point format specifier.
 
+    /// How far the bounds of a box node may move when converted to fp16, as a fraction of the node's largest extent.
+    static const float kCompressionAnalysisFp16Tolerance = 0.01F;
+
     namespace text
     {
         // @brief Delete recent file pop up dialog.
@@ -85,6 +88,10 @@ namespace rra
         static const QString kFileOpenFileTypes = "RRA trace files (*" + kRRATraceFileExtension + ")";
         static const QString kMissingHelpFile = "Missing RRA help file: ";
 
+        // @brief Export statistics failure pop up dialog.
+        static const QString kExportStatisticsFailedTitle = "Export failed";
+        static const QString kExportStatisticsFailedText  = "The statistics could not be written to ";
+
         // @brief External links.
         static const QUrl kGpuOpenUrl                = QUrl("https://gpuopen.com");
         static const QUrl kRraGithubUrl              = QUrl("https://github.com/GPUOpen-Tools/radeon_raytracing_analyzer");
@@ -9,15 +9,19 @@
 #include <QFileInfo>
 #include <QDir>
 #include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 
 #include "qt_common/utils/scaling_manager.h"
 
 #include "public/rra_print.h"
+#include "public/rra_trace_diff.h"
 #include "public/graphics_context.h"
 
 #include "constants.h"
 #include "managers/message_manager.h"
 #include "managers/trace_manager.h"
+#include "util/file_util.h"
 #include "util/rra_util.h"
 #include "views/main_window.h"
 #include "models/acceleration_structure_viewer_model.h"
@@ -49,6 +53,39 @@ static QString GetTracePath()
     return out;
 }
 
+/// @brief Compare two traces from the command line, without creating any windows.
+///
+/// Usage: --diff <trace_a> <trace_b> [report_file]
+///
+/// @param [in] argc The number of arguments.
+/// @param [in] argv An array containing arguments.
+///
+/// @return 0 if no BLAS regressed, 1 if any BLAS regressed, 2 if the traces couldn't be compared.
+static int RunTraceDiff(int argc, char* argv[])
+{
+    const char*         report_file_name = (argc > 4) ? argv[4] : nullptr;
+    RraTraceDiffSummary summary          = {};
+
+    if (RraTraceDiff(argv[2], argv[3], report_file_name, &summary) != kRraOk)
+    {
+        fprintf(stderr, "Failed to compare %s and %s\n", argv[2], argv[3]);
+        return 2;
+    }
+
+    printf("BLAS count:  %llu -> %llu\n", (unsigned long long)summary.blas_count_a, (unsigned long long)summary.blas_count_b);
+    printf("Matched:     %llu by geometry, %llu by address\n",
+           (unsigned long long)summary.matched_by_geometry,
+           (unsigned long long)summary.matched_by_address);
+    printf("Added:       %llu\n", (unsigned long long)summary.added_blas_count);
+    printf("Removed:     %llu\n", (unsigned long long)summary.removed_blas_count);
+    printf("Changed:     %llu\n", (unsigned long long)summary.changed_blas_count);
+    printf("Regressed:   %llu\n", (unsigned long long)summary.regressed_blas_count);
+    printf("BLAS size:   %+lld bytes\n", (long long)summary.total_blas_size_delta);
+    printf("TLAS size:   %+lld bytes\n", (long long)summary.total_tlas_size_delta);
+
+    return (summary.regressed_blas_count > 0) ? 1 : 0;
+}
+
 /// @brief Main entry point.
 ///
 /// @param [in] argc The number of arguments.
@@ -59,6 +96,12 @@ int main(int argc, char* argv[])
     RraSetPrintingCallback(PrintCallback, true);
 #endif
 
+    // Headless trace comparison, for use in automated regression checks.
+    if (argc >= 4 && strcmp(argv[1], "--diff") == 0)
+    {
+        return RunTraceDiff(argc, argv);
+    }
+
     QApplication a(argc, argv);
 
     // Load application stylesheet.
@@ -88,6 +131,7 @@ int main(int argc, char* argv[])
         // Once the trace has been loaded initialize graphics context and upload data to the device via this callback.
         rra::TraceManager::Get().SetLoadingFinishedCallback([window]() {
             rra::renderer::CreateGraphicsContext(window);
+            rra::renderer::SetGraphicsContextPipelineCacheFile((file_util::GetFileLocation() + "/RraPipelineCache.bin").toStdString());
 
             // Attempt to initialize the graphics context.
             if (!rra::renderer::InitializeGraphicsContext(rra::GetGraphicsContextSceneInfo()))
@@ -142,6 +142,21 @@ namespace rra
         return is_node_;
     }
 
+    uint32_t AccelerationStructureTreeViewItem::GetNodeData() const
+    {
+        return node_data_;
+    }
+
+    bool AccelerationStructureTreeViewItem::ChildrenFetched() const
+    {
+        return children_fetched_;
+    }
+
+    void AccelerationStructureTreeViewItem::SetChildrenFetched()
+    {
+        children_fetched_ = true;
+    }
+
     int AccelerationStructureTreeViewItem::Row() const
     {
         if (parent_item_ != nullptr)
@@ -82,6 +82,19 @@ namespace rra
         /// @returns True if this item is a node.
         bool IsNode() const;
 
+        /// @brief Get the encoded node data for this item.
+        ///
+        /// @returns The node data.
+        uint32_t GetNodeData() const;
+
+        /// @brief Have the child items of this item been created yet.
+        ///
+        /// @returns True if the child items have been created.
+        bool ChildrenFetched() const;
+
+        /// @brief Mark the child items of this item as created.
+        void SetChildrenFetched();
+
         /// @brief Get the data in this item.
         ///
         /// Passes in a role parameter so will work the same way as other Qt objects which
@@ -102,8 +115,9 @@ namespace rra
     private:
         QList<AccelerationStructureTreeViewItem*> child_items_;     ///< A list of child items for this item.
         AccelerationStructureTreeViewItem*        parent_item_;     ///< A pointer to the parent item.
-        uint32_t                                  node_data_;       ///< The encoded data contained in this item for column 0.
-        bool                                      is_node_ = true;  ///< The indicator to describe if this item is not a node.
+        uint32_t                                  node_data_;                ///< The encoded data contained in this item for column 0.
+        bool                                      is_node_          = true;   ///< The indicator to describe if this item is not a node.
+        bool                                      children_fetched_ = false;  ///< Have the child items been created yet.
     };
 }  // namespace rra
 
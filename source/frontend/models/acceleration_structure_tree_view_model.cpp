@@ -16,119 +16,271 @@
 
 namespace rra
 {
+    static const uint32_t kMaxNodePathLength = 1024;  ///< The maximum number of parent links to follow when finding the path to a node.
+
+    /// @brief Return the index of the given tree item in the parent's list of children.
+    ///
+    /// @param [in] child_item The child to get the index for.
+    ///
+    /// @returns The child index for the given tree item.
+    int GetIndexOfChild(AccelerationStructureTreeViewItem* child_item)
+    {
+        int found_child_index = 0;
+
+        AccelerationStructureTreeViewItem* this_parent = child_item->ParentItem();
+        for (int child_index = 0; child_index < this_parent->ChildCount(); ++child_index)
+        {
+            AccelerationStructureTreeViewItem* current_child = this_parent->Child(child_index);
+            if (current_child == child_item)
+            {
+                found_child_index = child_index;
+                break;
+            }
+        }
+
+        return found_child_index;
+    }
+
+    /// @brief A recursive helper used to get the tree model index for the given tree item.
+    ///
+    /// @param [in] model The acceleration structure tree model.
+    /// @param [in] item The tree item.
+    ///
+    /// @returns The tree model index for the given tree item.
+    QModelIndex ComputeItemIndex(AccelerationStructureTreeViewModel* model, AccelerationStructureTreeViewItem* item)
+    {
+        QModelIndex result;
+
+        AccelerationStructureTreeViewItem* parent = item->ParentItem();
+        if (parent != nullptr)
+        {
+            // Compute the model index for the item's parent.
+            QModelIndex parent_index = ComputeItemIndex(model, parent);
+
+            // Determine the child index for the given item.
+            int child_index = GetIndexOfChild(item);
+
+            // Provide the parent item's index to compute the model index for the item.
+            result = model->index(child_index, 0, parent_index);
+        }
+        else
+        {
+            // Return an invalid model index for the root node.
+            result = QModelIndex();
+        }
+
+        return result;
+    }
+
     AccelerationStructureTreeViewModel::AccelerationStructureTreeViewModel(bool is_tlas, QObject* parent)
         : QAbstractItemModel(parent)
         , root_item_(nullptr)
-        , item_buffer_(nullptr)
-        , item_buffer_size_(0)
-        , buffer_item_index_(0)
+        , child_function_(nullptr)
+        , parent_function_(nullptr)
         , is_tlas_(is_tlas)
+        , fully_populated_(false)
         , as_index_(0)
     {
     }
 
     AccelerationStructureTreeViewModel::~AccelerationStructureTreeViewModel()
     {
-        delete[] item_buffer_;
     }
 
-    bool AccelerationStructureTreeViewModel::InitializeModel(uint64_t node_count, uint32_t index, GetChildNodeFunction function)
+    bool AccelerationStructureTreeViewModel::InitializeModel(uint32_t index, GetChildNodeFunction child_function, GetParentNodeFunction parent_function)
     {
         beginResetModel();
 
-        as_index_ = index;
-
-        if (item_buffer_ != nullptr)
-        {
-            delete[] item_buffer_;
-        }
-        buffer_item_index_ = 0;
-
-        // Allocate a single block of memory for the AS Treeview Items. This
-        // saves Qt having to allocate small blocks and means that all memory can
-        // be allocated/deallocated at once, and eliminates memory leaks due to Qt
-        // sometimes not cleaning up properly.
-        item_buffer_size_ = node_count;
-
-        // Add an extra entry for the root node.
-        item_buffer_size_++;
+        as_index_        = index;
+        child_function_  = child_function;
+        parent_function_ = parent_function;
+        fully_populated_ = false;
 
-        item_buffer_ = new AccelerationStructureTreeViewItem[item_buffer_size_];
+        // Items are only created when their parent is expanded, so large acceleration structures don't need
+        // an item for every node up front. The pool hands out items with stable addresses and releases them
+        // all at once when the model is reset.
+        node_data_to_item_.clear();
+        item_pool_.clear();
 
         // Allocate the Treeview root node.
         root_item_ = AllocateMemory(UINT32_MAX, nullptr);
+        root_item_->SetChildrenFetched();
 
         // Get the root node of the acceleration structure from the backend and add it.
         uint32_t root_node = UINT32_MAX;
         RraBvhGetRootNodePtr(&root_node);
 
-        std::deque<std::pair<uint32_t, AccelerationStructureTreeViewItem*>> traversal_stack;
-        traversal_stack.push_back(std::make_pair(root_node, root_item_));
+        root_item_->AppendChild(AllocateMemory(root_node, root_item_));
 
-        // Traverse the tree and enter stuff into the Treeview.
-        while (!traversal_stack.empty())
+        endResetModel();
+
+        return true;
+    }
+
+    void AccelerationStructureTreeViewModel::PopulateAll()
+    {
+        if (root_item_ == nullptr || fully_populated_)
         {
-            auto front       = traversal_stack.front();
-            auto node_data   = front.first;
-            auto parent_item = front.second;
-            traversal_stack.pop_front();
+            return;
+        }
 
-            AccelerationStructureTreeViewItem* item = AllocateMemory(node_data, parent_item);
-            parent_item->AppendChild(item);
+        beginResetModel();
 
-            node_data_to_item_[node_data] = item;
+        std::deque<AccelerationStructureTreeViewItem*> traversal_stack;
+        traversal_stack.push_back(root_item_);
 
-            // For each item on the stack, add the children if valid.
-            // Sort node types. Loop once for box (interior) nodes, then once for leaf nodes.
-            for (auto child_index = 0; child_index < 4; child_index++)
-            {
-                uint32_t child_node = UINT32_MAX;
-                if (function(index, node_data, child_index, &child_node) == kRraOk)
-                {
-                    if (RraBvhIsBoxNode(child_node))
-                    {
-                        traversal_stack.push_back(std::make_pair(child_node, item));
-                    }
-                }
-            }
+        while (!traversal_stack.empty())
+        {
+            AccelerationStructureTreeViewItem* item = traversal_stack.front();
+            traversal_stack.pop_front();
+
+            FetchChildren(item, false);
 
-            for (auto child_index = 0; child_index < 4; child_index++)
+            for (int child_index = 0; child_index < item->ChildCount(); child_index++)
             {
-                uint32_t child_node = UINT32_MAX;
-                if (function(index, node_data, child_index, &child_node) == kRraOk)
-                {
-                    if (!RraBvhIsBoxNode(child_node))
-                    {
-                        traversal_stack.push_back(std::make_pair(child_node, item));
-                    }
-                }
+                traversal_stack.push_back(item->Child(child_index));
             }
         }
 
+        fully_populated_ = true;
         endResetModel();
-
-        return true;
     }
 
     AccelerationStructureTreeViewItem* AccelerationStructureTreeViewModel::AllocateMemory(uint32_t                           node_data,
                                                                                           AccelerationStructureTreeViewItem* parent)
     {
-        RRA_ASSERT(buffer_item_index_ < item_buffer_size_);
-        AccelerationStructureTreeViewItem* item = GetItemAtIndex(buffer_item_index_);
-        RRA_ASSERT(item != nullptr);
+        item_pool_.emplace_back();
+        AccelerationStructureTreeViewItem* item = &item_pool_.back();
         item->Initialize(node_data, parent);
-        buffer_item_index_++;
+
+        if (parent != nullptr)
+        {
+            node_data_to_item_[node_data] = item;
+        }
         return item;
     }
 
-    AccelerationStructureTreeViewItem* AccelerationStructureTreeViewModel::GetItemAtIndex(uint32_t index) const
+    void AccelerationStructureTreeViewModel::GetChildNodes(uint32_t node_data, std::vector<uint32_t>& child_nodes) const
     {
-        AccelerationStructureTreeViewItem* item = nullptr;
-        if (index < item_buffer_size_)
+        child_nodes.clear();
+        if (child_function_ == nullptr || !RraBvhIsBoxNode(node_data))
         {
-            item = &item_buffer_[index];
+            return;
+        }
+
+        // Sort node types. Box (interior) nodes first, then leaf nodes.
+        std::vector<uint32_t> leaf_nodes;
+        for (auto child_index = 0; child_index < 4; child_index++)
+        {
+            uint32_t child_node = UINT32_MAX;
+            if (child_function_(as_index_, node_data, child_index, &child_node) == kRraOk)
+            {
+                if (RraBvhIsBoxNode(child_node))
+                {
+                    child_nodes.push_back(child_node);
+                }
+                else
+                {
+                    leaf_nodes.push_back(child_node);
+                }
+            }
+        }
+        child_nodes.insert(child_nodes.end(), leaf_nodes.begin(), leaf_nodes.end());
+    }
+
+    void AccelerationStructureTreeViewModel::FetchChildren(AccelerationStructureTreeViewItem* item, bool notify)
+    {
+        if (item->ChildrenFetched())
+        {
+            return;
+        }
+        item->SetChildrenFetched();
+
+        std::vector<uint32_t> child_nodes;
+        GetChildNodes(item->GetNodeData(), child_nodes);
+        if (child_nodes.empty())
+        {
+            return;
+        }
+
+        if (notify)
+        {
+            beginInsertRows(ComputeItemIndex(this, item), 0, static_cast<int>(child_nodes.size()) - 1);
+        }
+
+        for (uint32_t child_node : child_nodes)
+        {
+            item->AppendChild(AllocateMemory(child_node, item));
+        }
+
+        if (notify)
+        {
+            endInsertRows();
         }
-        return item;
+    }
+
+    RraErrorCode AccelerationStructureTreeViewModel::FindOrFetchItem(uint32_t node_id, AccelerationStructureTreeViewItem** out_item)
+    {
+        RRA_ASSERT(out_item != nullptr);
+        *out_item = nullptr;
+
+        auto item_iter = node_data_to_item_.find(node_id);
+        if (item_iter != node_data_to_item_.end())
+        {
+            *out_item = item_iter->second;
+            return kRraOk;
+        }
+
+        if (parent_function_ == nullptr)
+        {
+            return kRraErrorInvalidPointer;
+        }
+
+        // Walk up the parent links until reaching a node that already has an item.
+        std::vector<uint32_t>              path     = {node_id};
+        AccelerationStructureTreeViewItem* ancestor = nullptr;
+        while (ancestor == nullptr)
+        {
+            // No valid tree is this deep, so the parent links must loop back on themselves.
+            if (path.size() > kMaxNodePathLength)
+            {
+                return kRraErrorMalformedData;
+            }
+
+            uint32_t           parent_node = UINT32_MAX;
+            const RraErrorCode error_code  = parent_function_(as_index_, path.back(), &parent_node);
+            if (error_code != kRraOk)
+            {
+                return error_code;
+            }
+
+            auto parent_iter = node_data_to_item_.find(parent_node);
+            if (parent_iter != node_data_to_item_.end())
+            {
+                ancestor = parent_iter->second;
+            }
+            else
+            {
+                path.push_back(parent_node);
+            }
+        }
+
+        // Then create the items back down the path to the node.
+        for (auto path_iter = path.rbegin(); path_iter != path.rend(); ++path_iter)
+        {
+            FetchChildren(ancestor, true);
+
+            // The parent links said the node is a child here, but the parent doesn't list it.
+            auto child_iter = node_data_to_item_.find(*path_iter);
+            if (child_iter == node_data_to_item_.end())
+            {
+                return kRraErrorInvalidChildNode;
+            }
+            ancestor = child_iter->second;
+        }
+
+        *out_item = ancestor;
+        return kRraOk;
     }
 
     int AccelerationStructureTreeViewModel::rowCount(const QModelIndex& parent) const
@@ -228,94 +380,78 @@ namespace rra
         return QModelIndex();
     }
 
-    QModelIndex AccelerationStructureTreeViewModel::parent(const QModelIndex& child) const
+    bool AccelerationStructureTreeViewModel::hasChildren(const QModelIndex& parent) const
     {
-        if (!child.isValid())
-        {
-            return QModelIndex();
-        }
-
-        AccelerationStructureTreeViewItem* child_item = static_cast<AccelerationStructureTreeViewItem*>(child.internalPointer());
-        RRA_ASSERT(child_item != nullptr);
+        AccelerationStructureTreeViewItem* parent_item = parent.isValid() ? static_cast<AccelerationStructureTreeViewItem*>(parent.internalPointer()) : root_item_;
 
-        AccelerationStructureTreeViewItem* parent_item = nullptr;
-        if (child_item != nullptr)
+        if (parent.column() > 0 || parent_item == nullptr)
         {
-            parent_item = child_item->ParentItem();
+            return false;
         }
 
-        if (parent_item == nullptr || parent_item == root_item_)
+        if (!parent_item->ChildrenFetched())
         {
-            return QModelIndex();
+            return RraBvhIsBoxNode(parent_item->GetNodeData());
         }
 
-        return createIndex(parent_item->Row(), 0, parent_item);
+        return parent_item->ChildCount() > 0;
     }
 
-    /// @brief Return the index of the given tree item in the parent's list of children.
-    ///
-    /// @param [in] child_item The child to get the index for.
-    ///
-    /// @returns The child index for the given tree item.
-    int GetIndexOfChild(AccelerationStructureTreeViewItem* child_item)
+    bool AccelerationStructureTreeViewModel::canFetchMore(const QModelIndex& parent) const
     {
-        int found_child_index = 0;
+        AccelerationStructureTreeViewItem* parent_item = parent.isValid() ? static_cast<AccelerationStructureTreeViewItem*>(parent.internalPointer()) : root_item_;
 
-        AccelerationStructureTreeViewItem* this_parent = child_item->ParentItem();
-        for (int child_index = 0; child_index < this_parent->ChildCount(); ++child_index)
+        if (parent_item == nullptr)
         {
-            AccelerationStructureTreeViewItem* current_child = this_parent->Child(child_index);
-            if (current_child == child_item)
-            {
-                found_child_index = child_index;
-                break;
-            }
+            return false;
         }
 
-        return found_child_index;
+        return !parent_item->ChildrenFetched() && RraBvhIsBoxNode(parent_item->GetNodeData());
     }
 
-    /// @brief A recursive helper used to get the tree model index for the given tree item.
-    ///
-    /// @param [in] model The acceleration structure tree model.
-    /// @param [in] item The tree item.
-    ///
-    /// @returns The tree model index for the given tree item.
-    QModelIndex ComputeItemIndex(AccelerationStructureTreeViewModel* model, AccelerationStructureTreeViewItem* item)
+    void AccelerationStructureTreeViewModel::fetchMore(const QModelIndex& parent)
     {
-        QModelIndex result;
+        AccelerationStructureTreeViewItem* parent_item = parent.isValid() ? static_cast<AccelerationStructureTreeViewItem*>(parent.internalPointer()) : root_item_;
 
-        AccelerationStructureTreeViewItem* parent = item->ParentItem();
-        if (parent != nullptr)
+        if (parent_item != nullptr)
         {
-            // Compute the model index for the item's parent.
-            QModelIndex parent_index = ComputeItemIndex(model, parent);
+            FetchChildren(parent_item, true);
+        }
+    }
 
-            // Determine the child index for the given item.
-            int child_index = GetIndexOfChild(item);
+    QModelIndex AccelerationStructureTreeViewModel::parent(const QModelIndex& child) const
+    {
+        if (!child.isValid())
+        {
+            return QModelIndex();
+        }
 
-            // Provide the parent item's index to compute the model index for the item.
-            result = model->index(child_index, 0, parent_index);
+        AccelerationStructureTreeViewItem* child_item = static_cast<AccelerationStructureTreeViewItem*>(child.internalPointer());
+        RRA_ASSERT(child_item != nullptr);
+
+        AccelerationStructureTreeViewItem* parent_item = nullptr;
+        if (child_item != nullptr)
+        {
+            parent_item = child_item->ParentItem();
         }
-        else
+
+        if (parent_item == nullptr || parent_item == root_item_)
         {
-            // Return an invalid model index for the root node.
-            result = QModelIndex();
+            return QModelIndex();
         }
 
-        return result;
+        return createIndex(parent_item->Row(), 0, parent_item);
     }
 
     QModelIndex AccelerationStructureTreeViewModel::GetModelIndexForNode(uint32_t node_id)
     {
         QModelIndex result;
 
-        // Search for the node id within the value to item map.
-        auto item_iter = node_data_to_item_.find(node_id);
-        if (item_iter != node_data_to_item_.end())
+        // Search for the node id, creating the items on the path to it if it hasn't been expanded yet.
+        AccelerationStructureTreeViewItem* item = nullptr;
+        if (FindOrFetchItem(node_id, &item) == kRraOk)
         {
-            AccelerationStructureTreeViewItem* item = item_iter->second;
-            result                                  = ComputeItemIndex(this, item);
+            result = ComputeItemIndex(this, item);
         }
         else
         {
@@ -330,11 +466,11 @@ namespace rra
     {
         QModelIndex result;
 
-        // Search for the node id within the value to item map.
-        auto item_iter = node_data_to_item_.find(node_id);
-        if (item_iter != node_data_to_item_.end())
+        // Search for the node id, creating the items on the path to it if it hasn't been expanded yet.
+        AccelerationStructureTreeViewItem* item = nullptr;
+        if (FindOrFetchItem(node_id, &item) == kRraOk)
         {
-            AccelerationStructureTreeViewItem* item = item_iter->second;
+            FetchChildren(item, true);
             if (static_cast<uint32_t>(item->ChildCount()) > triangle_index && !item->Child(triangle_index)->IsNode())
             {
                 item = item->Child(triangle_index);
@@ -352,23 +488,37 @@ namespace rra
 
     void AccelerationStructureTreeViewModel::ResetModelValues()
     {
-        if (item_buffer_ != nullptr)
-        {
-            delete[] item_buffer_;
-            item_buffer_      = nullptr;
-            item_buffer_size_ = 0;
-        }
-        root_item_ = nullptr;
-        buffer_item_index_ = 0;
+        beginResetModel();
+        node_data_to_item_.clear();
+        item_pool_.clear();
+        root_item_       = nullptr;
+        child_function_  = nullptr;
+        parent_function_ = nullptr;
+        fully_populated_ = false;
+        endResetModel();
     }
 
     std::vector<uint32_t> AccelerationStructureTreeViewModel::GetAllNodeIds() const
     {
         std::vector<uint32_t> node_ids;
-        node_ids.reserve(node_data_to_item_.size());
-        for (auto& item : node_data_to_item_)
+        if (root_item_ == nullptr)
+        {
+            return node_ids;
+        }
+
+        uint32_t root_node = UINT32_MAX;
+        RraBvhGetRootNodePtr(&root_node);
+
+        std::deque<uint32_t>  traversal_stack = {root_node};
+        std::vector<uint32_t> child_nodes;
+        while (!traversal_stack.empty())
         {
-            node_ids.push_back(item.first);
+            uint32_t node_id = traversal_stack.front();
+            traversal_stack.pop_front();
+            node_ids.push_back(node_id);
+
+            GetChildNodes(node_id, child_nodes);
+            traversal_stack.insert(traversal_stack.end(), child_nodes.begin(), child_nodes.end());
         }
         return node_ids;
     }
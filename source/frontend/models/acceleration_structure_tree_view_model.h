@@ -8,6 +8,9 @@
 #ifndef RRA_MODELS_ACCELERATION_STRUCTURE_TREE_VIEW_MODEL_H_
 #define RRA_MODELS_ACCELERATION_STRUCTURE_TREE_VIEW_MODEL_H_
 
+#include <deque>
+#include <unordered_map>
+
 #include <QAbstractItemModel>
 
 #include "public/rra_error.h"
@@ -19,6 +22,9 @@ namespace rra
     /// @brief Typedef for acceleration structure specific function to get child nodes.
     typedef RraErrorCode (*GetChildNodeFunction)(uint64_t, uint32_t, uint32_t, uint32_t*);
 
+    /// @brief Typedef for acceleration structure specific function to get the parent node.
+    typedef RraErrorCode (*GetParentNodeFunction)(uint64_t, uint32_t, uint32_t*);
+
     class AccelerationStructureTreeViewModel : public QAbstractItemModel
     {
         Q_OBJECT
@@ -33,14 +39,22 @@ namespace rra
         /// @brief Destructor.
         virtual ~AccelerationStructureTreeViewModel();
 
-        /// @brief Set up the model data. Add the data to the TreeView.
+        /// @brief Set up the model data. Add the root node to the TreeView.
+        ///
+        /// Only the root node is added here. The rest of the tree is populated on demand as
+        /// items are expanded (see canFetchMore() and fetchMore()).
         ///
-        /// @param [in] node_count The number of nodes required.
-        /// @param [in] index      The index into the acceleration structure.
-        /// @param [in] fn         A function pointer to a function to get the child nodes for the acceleration structure.
+        /// @param [in] index           The index into the acceleration structure.
+        /// @param [in] child_function  A function pointer to a function to get the child nodes for the acceleration structure.
+        /// @param [in] parent_function A function pointer to a function to get the parent node for the acceleration structure.
         ///
         /// @return true if initialization was successful, false otherwise.
-        bool InitializeModel(uint64_t node_count, uint32_t index, GetChildNodeFunction fn);
+        bool InitializeModel(uint32_t index, GetChildNodeFunction child_function, GetParentNodeFunction parent_function);
+
+        /// @brief Populate every item in the tree.
+        ///
+        /// Needed for operations that have to see the whole tree, such as expanding all items or searching.
+        void PopulateAll();
 
         // Overridden QAbstractItemModel methods.
 
@@ -71,6 +85,27 @@ namespace rra
         /// @return The index of the specified item.
         QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
 
+        /// @brief Overridden hasChildren member function.
+        ///
+        /// Box nodes report children before they have been fetched, so the view shows them as expandable.
+        ///
+        /// @param [in] parent The parent model index.
+        ///
+        /// @return true if the item has children, false if not.
+        bool hasChildren(const QModelIndex& parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+        /// @brief Overridden canFetchMore member function.
+        ///
+        /// @param [in] parent The parent model index.
+        ///
+        /// @return true if the child items of parent haven't been created yet.
+        bool canFetchMore(const QModelIndex& parent) const Q_DECL_OVERRIDE;
+
+        /// @brief Overridden fetchMore member function. Creates the child items of parent.
+        ///
+        /// @param [in] parent The parent model index.
+        void fetchMore(const QModelIndex& parent) Q_DECL_OVERRIDE;
+
         /// Overridden parent member function.
         ///
         /// @param [in] child The model index of the child item to find the parent of.
@@ -96,34 +131,54 @@ namespace rra
         /// @brief Reset any values in the model to their default state.
         void ResetModelValues();
 
-        /// @brief Get all the nodes in the tree view.
+        /// @brief Get all the nodes in the acceleration structure shown in the tree view.
+        ///
+        /// This walks the acceleration structure directly, so doesn't require the tree to be populated.
         ///
-        /// @return The node ids in the tree view.
+        /// @return The node ids in the acceleration structure.
         std::vector<uint32_t> GetAllNodeIds() const;
 
     private:
-        /// @brief Claim a chunk of pre-allocated memory for a treeview item and initialize the item.
+        /// @brief Claim memory from the item pool for a treeview item and initialize the item.
         ///
         /// @param [in] node_data The data for the item.
         /// @param [in] parent    Pointer to the parent item (or nullptr if no parent).
         ///
-        /// @return Pointer to the initialized EventTreeViewItem object.
+        /// @return Pointer to the initialized AccelerationStructureTreeViewItem object.
         AccelerationStructureTreeViewItem* AllocateMemory(uint32_t node_data, AccelerationStructureTreeViewItem* parent);
 
-        /// @brief Gets a tree view item from a given index.
+        /// @brief Get the child nodes of a node, in the order they are shown in the tree view.
+        ///
+        /// Box (interior) nodes are listed first, followed by leaf nodes.
+        ///
+        /// @param [in]  node_data   The node whose children are needed.
+        /// @param [out] child_nodes The child nodes.
+        void GetChildNodes(uint32_t node_data, std::vector<uint32_t>& child_nodes) const;
+
+        /// @brief Create the child items of an item, if they haven't been created already.
+        ///
+        /// @param [in] item   The item whose children are to be created.
+        /// @param [in] notify If true, notify any attached views of the inserted rows.
+        void FetchChildren(AccelerationStructureTreeViewItem* item, bool notify);
+
+        /// @brief Find the treeview item for a node, creating the items on the path from the root if needed.
         ///
-        /// @param [in] index The index of the tree view item to retrieve.
+        /// @param [in]  node_id  The BVH node id to find.
+        /// @param [out] out_item The treeview item.
         ///
-        /// @return A pointer to the AccelerationStructureTreeViewItem at the specified index, or nullptr if the index is invalid.
-        AccelerationStructureTreeViewItem* GetItemAtIndex(uint32_t index) const;
+        /// @return kRraOk if the item was found, the error from the parent lookup if the node or one of its ancestors
+        /// isn't in the acceleration structure, or kRraErrorMalformedData if the path to the root is too long to be
+        /// anything but a loop in the parent links.
+        RraErrorCode FindOrFetchItem(uint32_t node_id, AccelerationStructureTreeViewItem** out_item);
 
-        std::map<uint32_t, AccelerationStructureTreeViewItem*> node_data_to_item_;  ///< The map used to associate node data with a treeview item.
-        AccelerationStructureTreeViewItem*                     root_item_;          ///< The item at the root of the tree.
-        AccelerationStructureTreeViewItem*                     item_buffer_;        ///< Allocated memory block for EventTreeViewItem objects.
-        uint64_t                                               item_buffer_size_;   ///< Number of AccelerationStructureTreeViewItem the memory block can hold.
-        uint32_t                                               buffer_item_index_;  ///< Index to next block of free memory.
-        bool                                                   is_tlas_;            ///< Does this treeview model represent a TLAS?
-        uint64_t                                               as_index_;  ///< The acceleration structure index, obtained from the treeview combo box index.
+        std::unordered_map<uint32_t, AccelerationStructureTreeViewItem*> node_data_to_item_;  ///< The map used to associate node data with a created treeview item.
+        std::deque<AccelerationStructureTreeViewItem>                    item_pool_;          ///< Storage for the created treeview items.
+        AccelerationStructureTreeViewItem*                               root_item_;          ///< The item at the root of the tree.
+        GetChildNodeFunction                                             child_function_;     ///< The function used to get the child nodes.
+        GetParentNodeFunction                                            parent_function_;    ///< The function used to get the parent node.
+        bool                                                             is_tlas_;            ///< Does this treeview model represent a TLAS?
+        bool                                                             fully_populated_;    ///< Have the items for every node been created?
+        uint64_t as_index_;  ///< The acceleration structure index, obtained from the treeview combo box index.
     };
 }  // namespace rra
 
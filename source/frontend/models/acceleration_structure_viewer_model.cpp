@@ -7,6 +7,8 @@
 
 #include "models/acceleration_structure_viewer_model.h"
 
+#include <algorithm>
+
 #include <QTreeView>
 
 #include "qt_common/custom_widgets/scaled_tree_view.h"
@@ -19,6 +21,7 @@
 #include "public/rra_assert.h"
 #include "public/camera.h"
 #include "public/rra_blas.h"
+#include "public/rra_job_system.h"
 #include "public/rra_print.h"
 #include "public/intersect_min_max.h"
 
@@ -179,7 +182,7 @@ namespace rra
             item_delegate_map_[index] = delegate;
 
             tree_view_->setItemDelegate(delegate);
-            tree_view_model_->InitializeModel(node_count, index, AccelerationStructureGetChildNodeFunction());
+            tree_view_model_->InitializeModel(index, AccelerationStructureGetChildNodeFunction(), AccelerationStructureGetParentNodeFunction());
         }
     }
 
@@ -196,7 +199,15 @@ namespace rra
                 Scene* bvh_scene   = scene_collection_model_->GetSceneByIndex(index);
                 auto&  node_colors = GetSceneNodeColors();
                 renderer->SetSceneInfoCallback(
-                    [bvh_scene, &node_colors](renderer::RendererSceneInfo& info, renderer::Camera* camera, bool frustum_culling, bool force_camera_update) {
+                    [this, bvh_scene, &node_colors](renderer::RendererSceneInfo& info, renderer::Camera* camera, bool frustum_culling, bool force_camera_update) {
+                        // Pick up any nodes constructed in the background since the last frame.
+                        bvh_scene->ApplyPendingRoot();
+
+                        // The node overlap coloring mode needs the scene to put the overlap scores in the triangles.
+                        bvh_scene->SetNodeOverlapColoring(
+                            render_state_adapter_ != nullptr &&
+                            render_state_adapter_->IsGeometryColoringModeActive(renderer::GeometryColoringMode::kTriangleNodeOverlap));
+
                         info.scene_iteration                       = bvh_scene->GetSceneIteration();
                         info.depth_range_lower_bound               = bvh_scene->GetDepthRangeLowerBound();
                         info.depth_range_upper_bound               = bvh_scene->GetDepthRangeUpperBound();
@@ -245,31 +256,82 @@ namespace rra
                         {
                             if (frustum_culling)
                             {
-                                // Set near clip to 0 since we don't know ahead of time how close the closest object is.
-                                // It will be updated appropriately after frustum culling.
+                                // Cull with the near clip at 0 since we don't know ahead of time how close the closest object is.
+                                // It will be updated appropriately once the culling finishes. Until then the current near clip is kept.
+                                float near_clip_scale = camera->GetNearClipScale();
                                 camera->SetNearClipScale(0.0f);
-                                auto frustum_info                = camera->GetFrustumInfo();
+                                auto frustum_info = camera->GetFrustumInfo();
+                                camera->SetNearClipScale(near_clip_scale);
                                 frustum_info.fov_threshold_ratio = rra::Settings::Get().GetFrustumCullRatio();
-                                info.instance_map            = bvh_scene->GetFrustumCulledInstanceMap(frustum_info);  ///< Writes to closest_point_to_camera.
-                                info.closest_point_to_camera = frustum_info.closest_point_to_camera;
+
+                                // Does nothing if the culling for this camera and scene iteration has already been requested.
+                                bvh_scene->GetFrustumCuller().Update(bvh_scene->GetFrustumCullTree(), info.scene_iteration, frustum_info, force_camera_update);
                             }
                             else
                             {
                                 float closest_point_distance = 3.0f;
                                 info.instance_map            = bvh_scene->GetInstanceMap();
                                 info.closest_point_to_camera = camera->GetPosition() + glm::vec3(closest_point_distance, 0.0f, 0.0f);
+                                info.instance_map_iteration++;
+                                camera->SetNearClipScale(glm::distance(camera->GetPosition(), info.closest_point_to_camera));
+                                info.camera = camera;
                             }
+                        }
+
+                        // The culling runs in the background, so use the latest result that has finished rather than waiting.
+                        if (frustum_culling && bvh_scene->GetFrustumCuller().TakeResult(info.scene_iteration, info.instance_map, info.closest_point_to_camera))
+                        {
+                            info.instance_map_iteration++;
                             camera->SetNearClipScale(glm::distance(camera->GetPosition(), info.closest_point_to_camera));
                             info.camera = camera;
                         }
 
                         info.last_view_proj = camera->GetViewProjection();
                         info.last_iteration = info.scene_iteration;
+
+                        // The renderer stops checking for changes while idle, so tell it to keep going until these have arrived.
+                        info.background_work_pending = !bvh_scene->IsComplete() || (frustum_culling && bvh_scene->GetFrustumCuller().IsBusy());
                     });
             }
         }
     }
 
+    /// @brief The number of BLAS trees constructed at once, which bounds the memory held by trees waiting to be added.
+    static const uint64_t kBlasTreeBatchSize = 64;
+
+    /// @brief The construction of a single BLAS tree for the graphics context.
+    struct BlasTreeJob
+    {
+        uint32_t   blas_index = 0;        ///< The BLAS to construct.
+        SceneNode* scene_root = nullptr;  ///< The constructed tree.
+    };
+
+    /// @brief Construct a BLAS tree. Called on the job system.
+    ///
+    /// @param [in] user_data The BlasTreeJob to fill in.
+    static void ConstructBlasTree(void* user_data)
+    {
+        BlasTreeJob* job = static_cast<BlasTreeJob*>(user_data);
+        job->scene_root  = SceneNode::ConstructFromBlas(job->blas_index);
+    }
+
+    /// @brief The encoding of a single BLAS mesh for the graphics context.
+    struct BlasMeshJob
+    {
+        const renderer::RraVertex* vertices     = nullptr;  ///< The vertices of the BLAS.
+        size_t                     vertex_count = 0;        ///< The number of vertices.
+        renderer::CompactMesh*     mesh         = nullptr;  ///< The mesh to encode into.
+    };
+
+    /// @brief Encode a BLAS mesh. Called on the job system.
+    ///
+    /// @param [in] user_data The BlasMeshJob to run.
+    static void EncodeBlasMesh(void* user_data)
+    {
+        BlasMeshJob* job = static_cast<BlasMeshJob*>(user_data);
+        job->mesh->Encode(job->vertices, job->vertex_count);
+    }
+
     renderer::GraphicsContextSceneInfo GetGraphicsContextSceneInfo()
     {
         uint64_t blas_count = 0;
@@ -277,26 +339,81 @@ namespace rra
 
         renderer::GraphicsContextSceneInfo info{};
 
-        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        RraJobGroup* job_group = nullptr;
+        RraJobGroupCreate(&job_group);
+
+        // The trees are constructed in parallel, then added to the traversal tree in BLAS order.
+        std::vector<BlasTreeJob> jobs(static_cast<size_t>(std::min(blas_count, kBlasTreeBatchSize)));
+        std::vector<BlasMeshJob> mesh_jobs(jobs.size());
+        info.blas_meshes.resize(static_cast<size_t>(blas_count));
+
+        // The vertices of each batch are encoded into compact meshes, so only a batch of full vertices is held at once.
+        // This is the number of vertices encoded by the batches before the current one.
+        uint32_t encoded_vertex_count = 0;
+
+        for (uint64_t batch_start = 0; batch_start < blas_count; batch_start += kBlasTreeBatchSize)
         {
-            auto scene_root = SceneNode::ConstructFromBlas(static_cast<uint32_t>(blas_index));
+            const size_t batch_count = static_cast<size_t>(std::min(blas_count - batch_start, kBlasTreeBatchSize));
+            for (size_t i = 0; i < batch_count; i++)
+            {
+                jobs[i].blas_index = static_cast<uint32_t>(batch_start + i);
+                RraJobGroupSubmit(job_group, &ConstructBlasTree, &jobs[i]);
+            }
+            RraJobGroupWait(job_group);
+
+            for (size_t i = 0; i < batch_count; i++)
+            {
+                auto scene_root = jobs[i].scene_root;
+
+                // Get the triangle offset before the new triangles are added.
+                auto triangle_offset = info.blas_tree.vertices.size();
+                auto volume_offset   = info.blas_tree.volumes.size();
+
+                // Add to the tree using the scene root.
+                auto structure_offset = scene_root->AddToTraversalTree(info.blas_tree);
+                info.traversal_tree_blas_structure_offsets.push_back(structure_offset);
 
-            // Get the triangle offset before the new triangles are added.
-            auto triangle_offset = info.blas_tree.vertices.size();
+                // Find how many triangles were added.
+                auto triangle_count = info.blas_tree.vertices.size() - triangle_offset;
 
-            // Add to the tree using the scene root.
-            auto structure_offset = scene_root->AddToTraversalTree(info.blas_tree);
-            info.traversal_tree_blas_structure_offsets.push_back(structure_offset);
+                // The leaves index the vertices of this batch, so move them past the vertices already encoded.
+                for (size_t volume_index = volume_offset; volume_index < info.blas_tree.volumes.size(); volume_index++)
+                {
+                    renderer::TraversalVolume& volume = info.blas_tree.volumes[volume_index];
+                    if (volume.volume_type == renderer::TraversalVolumeType::kTriangle)
+                    {
+                        volume.leaf_start += encoded_vertex_count;
+                        volume.leaf_end += encoded_vertex_count;
+                    }
+                }
 
-            // Find how many triangles were added.
-            auto triangle_count = info.blas_tree.vertices.size() - triangle_offset;
+                info.traversal_tree_blas_triangle_offsets.push_back(static_cast<uint32_t>(encoded_vertex_count + triangle_offset));
+                info.traversal_tree_blas_triangle_count.push_back(static_cast<uint32_t>(triangle_count));
 
-            info.traversal_tree_blas_triangle_offsets.push_back(static_cast<uint32_t>(triangle_offset));
-            info.traversal_tree_blas_triangle_count.push_back(static_cast<uint32_t>(triangle_count));
+                mesh_jobs[i].vertex_count = triangle_count;
+                mesh_jobs[i].mesh         = &info.blas_meshes[static_cast<size_t>(batch_start + i)];
 
-            delete scene_root;
+                delete scene_root;
+            }
+
+            // The vertex vector has stopped growing for this batch, so the pointers into it are now stable.
+            size_t batch_vertex_offset = 0;
+            for (size_t i = 0; i < batch_count; i++)
+            {
+                mesh_jobs[i].vertices = info.blas_tree.vertices.data() + batch_vertex_offset;
+                batch_vertex_offset += mesh_jobs[i].vertex_count;
+                RraJobGroupSubmit(job_group, &EncodeBlasMesh, &mesh_jobs[i]);
+            }
+            RraJobGroupWait(job_group);
+
+            encoded_vertex_count += static_cast<uint32_t>(info.blas_tree.vertices.size());
+            info.blas_tree.vertices.clear();
         }
 
+        RraJobGroupDestroy(job_group);
+
+        info.blas_tree.vertices.shrink_to_fit();
+
         return info;
     }
 
@@ -521,8 +638,12 @@ namespace rra
     {
         tree_view_proxy_model_->SetSearchText(search_text);
 
-        // Expand the treeview when searching.
+        // Expand the treeview when searching. The whole tree needs to be populated so the filter can see every node.
         treeview_expand_state_ = TreeViewExpandMode::kExpanded;
+        if (!search_text.isEmpty())
+        {
+            tree_view_model_->PopulateAll();
+        }
         tree_view_->expandAll();
     }
 
@@ -534,6 +655,7 @@ namespace rra
         }
         else
         {
+            tree_view_model_->PopulateAll();
             tree_view_->expandAll();
         }
         treeview_expand_state_ = static_cast<TreeViewExpandMode>(index);
@@ -101,6 +101,13 @@ namespace rra
         /// @return The function pointer.
         virtual GetChildNodeFunction AccelerationStructureGetChildNodeFunction() const = 0;
 
+        /// @brief Get the function pointer of the function that gets the parent node.
+        ///
+        /// Will be different for TLAS/BLAS.
+        ///
+        /// @return The function pointer.
+        virtual GetParentNodeFunction AccelerationStructureGetParentNodeFunction() const = 0;
+
         /// @brief Update the UI elements based on what is selected in the tree view.
         ///
         /// @param [in] model_index The model index of the item selected in the tree view.
@@ -65,44 +65,37 @@ namespace rra
         {
             return false;
         }
+
+        // Fetch the columns needed by the table in a single call.
+        std::vector<uint32_t> instance_indices(instance_count);
+        std::vector<uint64_t> instance_addresses(instance_count);
+        std::vector<uint64_t> instance_offsets(instance_count);
+        std::vector<float>    transforms(instance_count * 12);
+        std::vector<uint32_t> masks(instance_count);
+
+        RraTlasInstanceTable instance_table = {};
+        instance_table.instance_index       = instance_indices.data();
+        instance_table.instance_address     = instance_addresses.data();
+        instance_table.instance_offset      = instance_offsets.data();
+        instance_table.original_transform   = transforms.data();
+        instance_table.mask                 = masks.data();
+
+        if (RraTlasGetBlasInstanceTable(tlas_index, blas_index, 0, &instance_table) != kRraOk)
+        {
+            return false;
+        }
+
         table_model_->SetRowCount(instance_count);
 
         BlasInstancesStatistics stats      = {};
         uint64_t                rows_added = 0;
-        for (int instance_index = 0; instance_index < instance_count; instance_index++)
+        for (uint64_t row = 0; row < instance_count; row++)
         {
-            uint32_t node_ptr = 0;
-            if (RraTlasGetInstanceNode(tlas_index, blas_index, instance_index, &node_ptr) != kRraOk)
-            {
-                continue;
-            }
-
-            if (RraTlasGetInstanceIndexFromInstanceNode(tlas_index, node_ptr, &stats.instance_index))
-            {
-                continue;
-            }
-
-            if (RraTlasGetNodeBaseAddress(tlas_index, node_ptr, &stats.instance_address) != kRraOk)
-            {
-                continue;
-            }
-
-            if (RraBvhGetNodeOffset(node_ptr, &stats.instance_offset) != kRraOk)
-            {
-                continue;
-            }
-
-            if (RraTlasGetOriginalInstanceNodeTransform(tlas_index, node_ptr, reinterpret_cast<float*>(&stats.transform)) != kRraOk)
-            {
-                continue;
-            }
-
-            uint32_t instance_mask{};
-            if (RraTlasGetInstanceNodeMask(tlas_index, node_ptr, &instance_mask) != kRraOk)
-            {
-                continue;
-            }
-            stats.instance_mask = instance_mask;
+            stats.instance_index   = instance_indices[row];
+            stats.instance_address = instance_addresses[row];
+            stats.instance_offset  = instance_offsets[row];
+            stats.instance_mask    = masks[row];
+            memcpy(stats.transform, &transforms[row * 12], sizeof(stats.transform));
 
             table_model_->AddAccelerationStructure(stats);
             rows_added++;
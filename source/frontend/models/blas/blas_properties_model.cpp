@@ -9,6 +9,7 @@
 
 #include "public/rra_bvh.h"
 #include "public/rra_blas.h"
+#include "public/rra_compression_analysis.h"
 #include "public/rra_tlas.h"
 
 #include "constants.h"
@@ -52,6 +53,24 @@ namespace rra
         SetModelData(kBlasPropertiesMeanSAH, "-");
         SetModelData(kBlasPropertiesMaxDepth, "-");
         SetModelData(kBlasPropertiesAvgDepth, "-");
+
+        SetModelData(kBlasPropertiesTriangleCompressionMode, "-");
+        SetModelData(kBlasPropertiesSharedEdgePairs, "-");
+        SetModelData(kBlasPropertiesPairCompressionRatio, "-");
+        SetModelData(kBlasPropertiesUncompressedLeafSize, "-");
+        SetModelData(kBlasPropertiesPairCompressedLeafSize, "-");
+        SetModelData(kBlasPropertiesBoxFp16Mode, "-");
+        SetModelData(kBlasPropertiesFp16RepresentableNodes, "-");
+        SetModelData(kBlasPropertiesFp32InteriorSize, "-");
+        SetModelData(kBlasPropertiesMixedFp16InteriorSize, "-");
+        SetModelData(kBlasPropertiesAllFp16InteriorSize, "-");
+
+        SetModelData(kBlasPropertiesMeanOverlapArea, "-");
+        SetModelData(kBlasPropertiesOverlapAreaHistogram, "-");
+        SetModelData(kBlasPropertiesMeanOverlapVolume, "-");
+        SetModelData(kBlasPropertiesOverlapVolumeHistogram, "-");
+        SetModelData(kBlasPropertiesMeanLeafTightness, "-");
+        SetModelData(kBlasPropertiesLeafTightnessHistogram, "-");
     }
 
     void BlasPropertiesModel::Update(uint64_t tlas_index, uint64_t blas_index)
@@ -173,6 +192,60 @@ namespace rra
         {
             SetModelData(kBlasPropertiesAvgDepth, rra::string_util::LocalizedValue(avg_depth));
         }
+
+        RraBlasCompressionStats compression = {};
+        if (RraCompressionAnalyzeBlas(blas_index, kCompressionAnalysisFp16Tolerance, &compression) == kRraOk)
+        {
+            int decimal_precision = rra::Settings::Get().GetDecimalPrecision();
+
+            SetModelData(kBlasPropertiesTriangleCompressionMode, rra::string_util::GetTriangleCompressionModeString(compression.triangle_compression_mode));
+            SetModelData(kBlasPropertiesSharedEdgePairs, rra::string_util::LocalizedValue(compression.shared_edge_pair_count));
+            SetModelData(kBlasPropertiesPairCompressionRatio,
+                         QString::number(compression.pair_compression_ratio, kQtFloatFormat, decimal_precision),
+                         QString::number(compression.pair_compression_ratio, kQtFloatFormat, kQtTooltipFloatPrecision));
+            SetModelData(kBlasPropertiesUncompressedLeafSize,
+                         rra::string_util::LocalizedValueMemory(static_cast<double>(compression.uncompressed_leaf_node_buffer_size), false, true));
+            SetModelData(kBlasPropertiesPairCompressedLeafSize,
+                         rra::string_util::LocalizedValueMemory(static_cast<double>(compression.pair_compressed_leaf_node_buffer_size), false, true));
+
+            SetModelData(kBlasPropertiesBoxFp16Mode, rra::string_util::GetBoxFp16ModeString(compression.box_fp16_mode));
+            SetModelData(kBlasPropertiesFp16RepresentableNodes,
+                         rra::string_util::LocalizedValue(compression.fp16_representable_box_node_count) + " (" +
+                             QString::number(compression.fp16_representable_fraction * 100.0f, kQtFloatFormat, decimal_precision) + "%)");
+
+            const uint64_t* interior_sizes = compression.projected_interior_node_buffer_size;
+            SetModelData(kBlasPropertiesFp32InteriorSize,
+                         rra::string_util::LocalizedValueMemory(static_cast<double>(interior_sizes[kRraBoxFp16ModeNone]), false, true));
+            SetModelData(kBlasPropertiesMixedFp16InteriorSize,
+                         rra::string_util::LocalizedValueMemory(static_cast<double>(interior_sizes[kRraBoxFp16ModeMixedWithFp32]), false, true));
+            SetModelData(kBlasPropertiesAllFp16InteriorSize,
+                         rra::string_util::LocalizedValueMemory(static_cast<double>(interior_sizes[kRraBoxFp16ModeAll]), false, true));
+        }
+
+        RraBvhOverlapStats overlap = {};
+        if (RraBlasGetOverlapStats(blas_index, &overlap) == kRraOk)
+        {
+            int decimal_precision = rra::Settings::Get().GetDecimalPrecision();
+
+            SetModelData(kBlasPropertiesMeanOverlapArea,
+                         QString::number(overlap.mean_overlap_area, kQtFloatFormat, decimal_precision),
+                         QString::number(overlap.mean_overlap_area, kQtFloatFormat, kQtTooltipFloatPrecision));
+            SetModelData(kBlasPropertiesOverlapAreaHistogram,
+                         rra::string_util::GetHistogramString(overlap.overlap_area_histogram, kRraBvhOverlapHistogramBinCount),
+                         rra::string_util::GetHistogramTooltip(overlap.overlap_area_histogram, kRraBvhOverlapHistogramBinCount));
+            SetModelData(kBlasPropertiesMeanOverlapVolume,
+                         QString::number(overlap.mean_overlap_volume, kQtFloatFormat, decimal_precision),
+                         QString::number(overlap.mean_overlap_volume, kQtFloatFormat, kQtTooltipFloatPrecision));
+            SetModelData(kBlasPropertiesOverlapVolumeHistogram,
+                         rra::string_util::GetHistogramString(overlap.overlap_volume_histogram, kRraBvhOverlapHistogramBinCount),
+                         rra::string_util::GetHistogramTooltip(overlap.overlap_volume_histogram, kRraBvhOverlapHistogramBinCount));
+            SetModelData(kBlasPropertiesMeanLeafTightness,
+                         QString::number(overlap.mean_leaf_tightness, kQtFloatFormat, decimal_precision),
+                         QString::number(overlap.mean_leaf_tightness, kQtFloatFormat, kQtTooltipFloatPrecision));
+            SetModelData(kBlasPropertiesLeafTightnessHistogram,
+                         rra::string_util::GetHistogramString(overlap.leaf_tightness_histogram, kRraBvhOverlapHistogramBinCount),
+                         rra::string_util::GetHistogramTooltip(overlap.leaf_tightness_histogram, kRraBvhOverlapHistogramBinCount));
+        }
     }
 
 }  // namespace rra
@@ -41,6 +41,24 @@ namespace rra
         kBlasPropertiesMaxDepth,
         kBlasPropertiesAvgDepth,
 
+        kBlasPropertiesTriangleCompressionMode,
+        kBlasPropertiesSharedEdgePairs,
+        kBlasPropertiesPairCompressionRatio,
+        kBlasPropertiesUncompressedLeafSize,
+        kBlasPropertiesPairCompressedLeafSize,
+        kBlasPropertiesBoxFp16Mode,
+        kBlasPropertiesFp16RepresentableNodes,
+        kBlasPropertiesFp32InteriorSize,
+        kBlasPropertiesMixedFp16InteriorSize,
+        kBlasPropertiesAllFp16InteriorSize,
+
+        kBlasPropertiesMeanOverlapArea,
+        kBlasPropertiesOverlapAreaHistogram,
+        kBlasPropertiesMeanOverlapVolume,
+        kBlasPropertiesOverlapVolumeHistogram,
+        kBlasPropertiesMeanLeafTightness,
+        kBlasPropertiesLeafTightnessHistogram,
+
         kBlasPropertiesNumWidgets,
     };
 
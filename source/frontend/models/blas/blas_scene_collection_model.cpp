@@ -19,8 +19,12 @@
 
 namespace rra
 {
+    static const uint32_t kPreviewDepth = 4;  ///< The depth of the partial tree shown while the full BLAS tree is constructed.
+
     BlasSceneCollectionModel::~BlasSceneCollectionModel()
     {
+        scene_builder_.Cancel();
+
         // Delete each BLAS scene.
         for (auto scene_iter = blas_scenes_.begin(); scene_iter != blas_scenes_.end(); ++scene_iter)
         {
@@ -53,11 +57,16 @@ namespace rra
         // Create a scene.
         Scene* blas_scene = new Scene();
 
-        // Construct a tree by using the blas_index.
-        auto blas_node = SceneNode::ConstructFromBlas(blas_index);
+        // Start with just the root node, so the scene can be shown straight away.
+        blas_scene->Initialize(SceneNode::ConstructFromBlas(blas_index, 0), false);
 
-        // Initialize the scene with the given node.
-        blas_scene->Initialize(blas_node);
+        // Show the bounding volumes near the root first, then the full tree with its triangles once it is done. Only the
+        // scene being viewed is constructed, so starting a new one cancels the last.
+        auto construct_preview = [blas_index](const std::atomic<bool>& cancelled) {
+            return SceneNode::ConstructFromBlas(blas_index, kPreviewDepth, &cancelled);
+        };
+        auto construct_tree = [blas_index](const std::atomic<bool>& cancelled) { return SceneNode::ConstructFromBlas(blas_index, UINT32_MAX, &cancelled); };
+        scene_builder_.Start(blas_scene, {construct_preview, construct_tree});
 
         return blas_scene;
     }
@@ -140,6 +149,7 @@ namespace rra
 
     void BlasSceneCollectionModel::ResetModelValues()
     {
+        scene_builder_.Cancel();
         for (auto scene_iter = blas_scenes_.begin(); scene_iter != blas_scenes_.end(); ++scene_iter)
         {
             delete scene_iter->second;
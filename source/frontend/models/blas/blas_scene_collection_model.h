@@ -11,6 +11,7 @@
 #include <map>
 
 #include "models/scene.h"
+#include "../scene_builder.h"
 #include "../scene_collection_model.h"
 
 namespace rra
@@ -79,7 +80,8 @@ namespace rra
         /// @returns The new Scene instance.
         Scene* CreateRenderSceneForBLAS(renderer::RendererInterface* renderer, uint32_t blas_index);
 
-        std::map<uint64_t, Scene*> blas_scenes_;  ///< A map of all loaded BLAS scenes.
+        std::map<uint64_t, Scene*> blas_scenes_;    ///< A map of all loaded BLAS scenes.
+        SceneBuilder               scene_builder_;  ///< Constructs the nodes of the scene being viewed.
     };
 }  // namespace rra
 
@@ -7,15 +7,49 @@
 
 #include "models/blas/blas_triangles_item_model.h"
 
+#include <QStringList>
+
 #include "qt_common/utils/qt_util.h"
 
 #include "public/rra_assert.h"
+#include "public/rra_blas.h"
 
 #include "constants.h"
 #include "settings/settings.h"
 
 namespace rra
 {
+    /// @brief Get a description of the problems found with a triangle node.
+    ///
+    /// @param [in] issue_flags The RraTriangleIssueFlagBits of the node.
+    ///
+    /// @return A comma separated list of the problems, or "-" if there are none.
+    static QString GetIssuesString(uint32_t issue_flags)
+    {
+        QStringList issues;
+        if ((issue_flags & kRraTriangleIssueZeroArea) != 0)
+        {
+            issues << "Zero area";
+        }
+        if ((issue_flags & kRraTriangleIssueSliver) != 0)
+        {
+            issues << "Sliver";
+        }
+        if ((issue_flags & kRraTriangleIssueNonFinite) != 0)
+        {
+            issues << "NaN/Inf";
+        }
+        if ((issue_flags & kRraTriangleIssueDuplicate) != 0)
+        {
+            issues << "Duplicate";
+        }
+        if ((issue_flags & kRraTriangleIssueOutsideParent) != 0)
+        {
+            issues << "Outside parent";
+        }
+        return issues.isEmpty() ? QString("-") : issues.join(", ");
+    }
+
     BlasTrianglesItemModel::BlasTrianglesItemModel(QObject* parent)
         : QAbstractItemModel(parent)
         , num_rows_(0)
@@ -52,6 +86,7 @@ namespace rra
         acceleration_structure_table->SetColumnWidthEms(kBlasTrianglesColumnIsInactive, 10);
         acceleration_structure_table->SetColumnWidthEms(kBlasTrianglesColumnTriangleSurfaceArea, 15);
         acceleration_structure_table->SetColumnWidthEms(kBlasTrianglesColumnSAH, 10);
+        acceleration_structure_table->SetColumnWidthEms(kBlasTrianglesColumnIssues, 15);
         acceleration_structure_table->SetColumnWidthEms(kBlasTrianglesColumnVertex0, 20);
         acceleration_structure_table->SetColumnWidthEms(kBlasTrianglesColumnVertex1, 20);
         acceleration_structure_table->SetColumnWidthEms(kBlasTrianglesColumnVertex2, 20);
@@ -96,6 +131,8 @@ namespace rra
                 return QString::number(cache.triangle_surface_area, kQtFloatFormat, decimal_precision);
             case kBlasTrianglesColumnSAH:
                 return QString::number(cache.sah, kQtFloatFormat, decimal_precision);
+            case kBlasTrianglesColumnIssues:
+                return GetIssuesString(cache.issue_flags);
             case kBlasTrianglesColumnVertex0:
                 return QString::number(cache.vertex_0.x, kQtFloatFormat, decimal_precision) + "," +
                        QString::number(cache.vertex_0.y, kQtFloatFormat, decimal_precision) + "," +
@@ -178,6 +215,8 @@ namespace rra
                 return QVariant::fromValue<float>(cache.triangle_surface_area);
             case kBlasTrianglesColumnSAH:
                 return QVariant::fromValue<float>(cache.sah);
+            case kBlasTrianglesColumnIssues:
+                return QVariant::fromValue<quint32>(cache.issue_flags);
             // Userdata in the vertex columns isn't going to be used so use them to return the node id.
             case kBlasTrianglesColumnVertex0:
             case kBlasTrianglesColumnVertex1:
@@ -219,6 +258,8 @@ namespace rra
                     return "Triangle surface area";
                 case kBlasTrianglesColumnSAH:
                     return "SAH";
+                case kBlasTrianglesColumnIssues:
+                    return "Issues";
                 case kBlasTrianglesColumnVertex0:
                     return "Vertex0";
                 case kBlasTrianglesColumnVertex1:
@@ -249,6 +290,9 @@ namespace rra
                     return "The surface area of the triangle";
                 case kBlasTrianglesColumnSAH:
                     return "The triangle surface area heuristic value";
+                case kBlasTrianglesColumnIssues:
+                    return "Problems found with the triangles in this node: zero area, slivers, NaN or infinite vertices, duplicates, or "
+                           "triangles reaching outside the bounding box stored in their parent node";
                 default:
                     break;
                 }
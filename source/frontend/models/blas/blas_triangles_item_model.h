@@ -28,6 +28,7 @@ namespace rra
         bool                  is_inactive;            ///< Whether or not this triangle is inactive.
         float                 triangle_surface_area;  ///< The triangle surface area.
         float                 sah;                    ///< The surface area heuristic.
+        uint32_t              issue_flags;            ///< The RraTriangleIssueFlagBits found by the triangle scan.
         rra::renderer::float3 vertex_0;               ///< Triangle vertex 0.
         rra::renderer::float3 vertex_1;               ///< Triangle vertex 1.
         rra::renderer::float3 vertex_2;               ///< Triangle vertex 2.
@@ -44,6 +45,7 @@ namespace rra
         kBlasTrianglesColumnIsInactive,
         kBlasTrianglesColumnTriangleSurfaceArea,
         kBlasTrianglesColumnSAH,
+        kBlasTrianglesColumnIssues,
         kBlasTrianglesColumnVertex0,
         kBlasTrianglesColumnVertex1,
         kBlasTrianglesColumnVertex2,
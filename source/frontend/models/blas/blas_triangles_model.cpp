@@ -135,6 +135,11 @@ namespace rra
                         {
                             continue;
                         }
+                        if (RraBlasGetTriangleIssueFlags(blas_index, child_node, &stats.issue_flags) != kRraOk)
+                        {
+                            // Still list the triangle, just without any problems flagged.
+                            stats.issue_flags = 0;
+                        }
 
                         uint32_t                    vertex_count = (stats.triangle_count == 1 ? 3 : 4);
                         std::vector<VertexPosition> verts(vertex_count);
@@ -198,9 +203,14 @@ namespace rra
         proxy_model_->invalidate();
     }
 
+    void BlasTrianglesModel::ProblemTrianglesOnlyChanged(bool problem_triangles_only)
+    {
+        proxy_model_->SetProblemTrianglesOnly(problem_triangles_only);
+        proxy_model_->invalidate();
+    }
+
     BlasTrianglesProxyModel* BlasTrianglesModel::GetProxyModel() const
     {
         return proxy_model_;
     }
-
 }  // namespace rra
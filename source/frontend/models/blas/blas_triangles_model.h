@@ -83,6 +83,11 @@ namespace rra
         /// @param [in] filter The search text filter.
         void SearchTextChanged(const QString& filter);
 
+        /// @brief Handle what happens when the problem triangle filter changes.
+        ///
+        /// @param [in] problem_triangles_only If true, only show triangle nodes with problems.
+        void ProblemTrianglesOnlyChanged(bool problem_triangles_only);
+
     private:
         BlasTrianglesItemModel*  table_model_;  ///< Holds the BLAS triangle list table data.
         BlasTrianglesProxyModel* proxy_model_;  ///< Proxy model for the BLAS triangle list table.
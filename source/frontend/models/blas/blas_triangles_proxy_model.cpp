@@ -18,6 +18,7 @@ namespace rra
 {
     BlasTrianglesProxyModel::BlasTrianglesProxyModel(QObject* parent)
         : TableProxyModel(parent)
+        , problem_triangles_only_(false)
     {
     }
 
@@ -40,6 +41,7 @@ namespace rra
             kBlasTrianglesColumnIsInactive,
             kBlasTrianglesColumnTriangleSurfaceArea,
             kBlasTrianglesColumnSAH,
+            kBlasTrianglesColumnIssues,
             kBlasTrianglesColumnVertex0,
             kBlasTrianglesColumnVertex1,
             kBlasTrianglesColumnVertex2,
@@ -51,8 +53,22 @@ namespace rra
         return model;
     }
 
+    void BlasTrianglesProxyModel::SetProblemTrianglesOnly(bool problem_triangles_only)
+    {
+        problem_triangles_only_ = problem_triangles_only;
+    }
+
     bool BlasTrianglesProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
     {
+        if (problem_triangles_only_)
+        {
+            const QModelIndex issues_index = sourceModel()->index(source_row, kBlasTrianglesColumnIssues, source_parent);
+            if (sourceModel()->data(issues_index, Qt::UserRole).toUInt() == 0)
+            {
+                return false;
+            }
+        }
+
         if (FilterSearchString(source_row, source_parent) == false)
         {
             return false;
@@ -94,6 +110,7 @@ namespace rra
 
             case kBlasTrianglesColumnTriangleCount:
             case kBlasTrianglesColumnGeometryIndex:
+            case kBlasTrianglesColumnIssues:
             {
                 const uint32_t left_data  = left.data(Qt::UserRole).toUInt();
                 const uint32_t right_data = right.data(Qt::UserRole).toUInt();
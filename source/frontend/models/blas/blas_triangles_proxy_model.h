@@ -38,6 +38,11 @@ namespace rra
         /// @return the model for the BLAS table model.
         BlasTrianglesItemModel* InitializeAccelerationStructureTableModels(QTableView* view, int num_rows, int num_columns);
 
+        /// @brief Set whether to only show triangle nodes with problems found by the triangle scan.
+        ///
+        /// @param [in] problem_triangles_only If true, hide the triangle nodes without problems.
+        void SetProblemTrianglesOnly(bool problem_triangles_only);
+
         /// @brief Overridden sort function. Allows for disabling sorting on certain columns.
         ///
         /// @param [in] column The column to sort.
@@ -60,6 +65,9 @@ namespace rra
         ///
         /// @return true if left is less than right, false otherwise.
         virtual bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
+
+    private:
+        bool problem_triangles_only_;  ///< If true, only show triangle nodes with problems.
     };
 }  // namespace rra
 
@@ -117,6 +117,11 @@ namespace rra
         return RraBlasGetChildNodePtr;
     }
 
+    GetParentNodeFunction BlasViewerModel::AccelerationStructureGetParentNodeFunction() const
+    {
+        return RraBlasGetNodeParent;
+    }
+
     void BlasViewerModel::UpdateStatistics(uint64_t blas_index, uint32_t node_id)
     {
         // Show node name and base address.
@@ -235,6 +240,36 @@ namespace rra
                          QString::number(surface_area_heuristic, kQtFloatFormat, decimal_precision),
                          QString::number(surface_area_heuristic, kQtFloatFormat, kQtTooltipFloatPrecision));
         }
+
+        // Show the sibling overlap for box nodes and the leaf tightness for triangle nodes.
+        float overlap_area   = 0.0f;
+        float overlap_volume = 0.0f;
+        if (RraBlasGetSiblingOverlap(blas_index, node_id, &overlap_area, &overlap_volume) == kRraOk)
+        {
+            SetModelData(kBlasStatsSiblingOverlapArea,
+                         QString::number(overlap_area, kQtFloatFormat, decimal_precision),
+                         QString::number(overlap_area, kQtFloatFormat, kQtTooltipFloatPrecision));
+            SetModelData(kBlasStatsSiblingOverlapVolume,
+                         QString::number(overlap_volume, kQtFloatFormat, decimal_precision),
+                         QString::number(overlap_volume, kQtFloatFormat, kQtTooltipFloatPrecision));
+        }
+        else
+        {
+            SetModelData(kBlasStatsSiblingOverlapArea, "-");
+            SetModelData(kBlasStatsSiblingOverlapVolume, "-");
+        }
+
+        float leaf_tightness = 0.0f;
+        if (RraBlasGetLeafTightness(blas_index, node_id, &leaf_tightness) == kRraOk)
+        {
+            SetModelData(kBlasStatsLeafTightness,
+                         QString::number(leaf_tightness, kQtFloatFormat, decimal_precision),
+                         QString::number(leaf_tightness, kQtFloatFormat, kQtTooltipFloatPrecision));
+        }
+        else
+        {
+            SetModelData(kBlasStatsLeafTightness, "-");
+        }
     }
 
     void BlasViewerModel::UpdateUI(const QModelIndex& model_index, uint64_t blas_index)
@@ -297,6 +332,9 @@ namespace rra
         SetModelData(kBlasStatsCurrentSAH, "-");
         SetModelData(kBlasStatsSAHSubTreeMax, "-");
         SetModelData(kBlasStatsSAHSubTreeMean, "-");
+        SetModelData(kBlasStatsSiblingOverlapArea, "-");
+        SetModelData(kBlasStatsSiblingOverlapVolume, "-");
+        SetModelData(kBlasStatsLeafTightness, "-");
         last_selected_node_is_tri_ = false;
         AccelerationStructureViewerModel::ResetModelValues(reset_scene);
     }
@@ -25,6 +25,9 @@ namespace rra
         kBlasStatsCurrentSAH,
         kBlasStatsSAHSubTreeMax,
         kBlasStatsSAHSubTreeMean,
+        kBlasStatsSiblingOverlapArea,
+        kBlasStatsSiblingOverlapVolume,
+        kBlasStatsLeafTightness,
         kBlasStatsPrimitiveIndex,
         kBlasStatsGeometryIndex,
         kBlasStatsParent,
@@ -95,6 +98,11 @@ namespace rra
         /// @return The function pointer.
         virtual GetChildNodeFunction AccelerationStructureGetChildNodeFunction() const override;
 
+        /// @brief Get the function pointer of the function that gets the parent node.
+        ///
+        /// @return The function pointer.
+        virtual GetParentNodeFunction AccelerationStructureGetParentNodeFunction() const override;
+
         /// @brief Update the UI elements based on what is selected in the tree view.
         ///
         /// @param [in] model_index The model index of the item selected in the tree view.
@@ -0,0 +1,125 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the FrustumCuller class.
+//=============================================================================
+
+#include "models/frustum_culler.h"
+
+#include "public/rra_assert.h"
+
+namespace rra
+{
+    FrustumCuller::FrustumCuller()
+    {
+        RraJobGroupCreate(&job_group_);
+    }
+
+    FrustumCuller::~FrustumCuller()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            has_pending_request_ = false;
+            pending_request_     = {};
+        }
+        RraJobGroupDestroy(job_group_);
+    }
+
+    void FrustumCuller::Update(std::shared_ptr<const FrustumCullTree> tree, uint64_t scene_iteration, const renderer::FrustumInfo& frustum_info, bool force)
+    {
+        RRA_ASSERT(tree != nullptr);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // The camera position is part of the view projection, so this covers everything the culling depends on.
+        if (!force && scene_iteration == last_scene_iteration_ && frustum_info.camera_view_projection == last_view_projection_ &&
+            frustum_info.camera_fov == last_fov_ && frustum_info.fov_threshold_ratio == last_fov_ratio_)
+        {
+            return;
+        }
+
+        last_scene_iteration_ = scene_iteration;
+        last_view_projection_ = frustum_info.camera_view_projection;
+        last_fov_             = frustum_info.camera_fov;
+        last_fov_ratio_       = frustum_info.fov_threshold_ratio;
+
+        pending_request_.tree            = std::move(tree);
+        pending_request_.frustum_info    = frustum_info;
+        pending_request_.scene_iteration = scene_iteration;
+        has_pending_request_             = true;
+
+        // A running job picks the request up once it finishes its current cull.
+        if (!running_)
+        {
+            running_ = true;
+            RraJobGroupSubmit(job_group_, &FrustumCuller::RunRequests, this);
+        }
+    }
+
+    bool FrustumCuller::TakeResult(uint64_t scene_iteration, renderer::InstanceMap& out_instance_map, glm::vec3& out_closest_point_to_camera)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!has_finished_result_)
+        {
+            return false;
+        }
+
+        Result& result = results_[finished_index_];
+        if (result.scene_iteration != scene_iteration)
+        {
+            // The scene has changed since this was culled, so the instances it lists may no longer exist.
+            result.instance_map.clear();
+            has_finished_result_ = false;
+            return false;
+        }
+
+        out_instance_map            = std::move(result.instance_map);
+        out_closest_point_to_camera = result.closest_point_to_camera;
+        has_finished_result_        = false;
+        return true;
+    }
+
+    bool FrustumCuller::IsBusy()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return has_pending_request_ || running_ || has_finished_result_;
+    }
+
+    void FrustumCuller::RunRequests(void* user_data)
+    {
+        FrustumCuller* culler = static_cast<FrustumCuller*>(user_data);
+
+        for (;;)
+        {
+            Request  request;
+            uint32_t write_index = 0;
+            {
+                std::lock_guard<std::mutex> lock(culler->mutex_);
+                if (!culler->has_pending_request_)
+                {
+                    culler->running_ = false;
+                    return;
+                }
+
+                request                      = std::move(culler->pending_request_);
+                culler->pending_request_     = {};
+                culler->has_pending_request_ = false;
+
+                // Only this job changes which buffer is finished, so the other one can be written without the lock.
+                write_index = 1 - culler->finished_index_;
+            }
+
+            Result& result                 = culler->results_[write_index];
+            result.instance_map            = request.tree->Cull(request.frustum_info);
+            result.closest_point_to_camera = request.frustum_info.closest_point_to_camera;
+            result.scene_iteration         = request.scene_iteration;
+
+            std::lock_guard<std::mutex> lock(culler->mutex_);
+            culler->finished_index_      = write_index;
+            culler->has_finished_result_ = true;
+        }
+    }
+}  // namespace rra
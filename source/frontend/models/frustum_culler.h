@@ -0,0 +1,100 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Declaration for the FrustumCuller class.
+//=============================================================================
+
+#ifndef RRA_MODELS_FRUSTUM_CULLER_H_
+#define RRA_MODELS_FRUSTUM_CULLER_H_
+
+#include <memory>
+#include <mutex>
+
+#include "public/renderer_types.h"
+#include "public/rra_job_system.h"
+
+#include "scene_node.h"
+
+namespace rra
+{
+    /// @brief Frustum culls a scene on the backend job system, so the culling doesn't hold up drawing.
+    ///
+    /// Only one cull runs at a time. A request made while a cull is running waits for it, replacing any request already
+    /// waiting, so the culling always catches up with the latest camera. The results are double buffered: the cull
+    /// writes into one buffer while the latest finished result is held in the other until it is taken.
+    class FrustumCuller
+    {
+    public:
+        /// @brief Constructor.
+        FrustumCuller();
+
+        /// @brief Destructor. Waits for any cull still running.
+        ~FrustumCuller();
+
+        /// @brief Request a cull. Doesn't wait for it.
+        ///
+        /// Nothing is done if the last request was for the same scene iteration and frustum.
+        ///
+        /// @param [in] tree The tree to cull.
+        /// @param [in] scene_iteration The scene iteration the tree was built for.
+        /// @param [in] frustum_info The information needed for the culling.
+        /// @param [in] force Cull even if nothing has changed since the last request.
+        void Update(std::shared_ptr<const FrustumCullTree> tree, uint64_t scene_iteration, const renderer::FrustumInfo& frustum_info, bool force);
+
+        /// @brief Take the latest finished result, if one has finished since the last call. Doesn't wait.
+        ///
+        /// A result culled for another scene iteration is dropped, as its instances may no longer exist. A result culled
+        /// for an older camera is still used, since while the camera moves the culling is always a request behind.
+        ///
+        /// @param [in] scene_iteration The scene iteration being drawn.
+        /// @param [out] out_instance_map The instances inside the frustum.
+        /// @param [out] out_closest_point_to_camera The closest point on the instances to the camera.
+        ///
+        /// @returns True if there was a new result for the scene iteration.
+        bool TakeResult(uint64_t scene_iteration, renderer::InstanceMap& out_instance_map, glm::vec3& out_closest_point_to_camera);
+
+        /// @brief Check if a cull is waiting, running, or has a result that has not been taken.
+        ///
+        /// @returns True if a new result will be available from TakeResult().
+        bool IsBusy();
+
+    private:
+        /// @brief A cull waiting to run.
+        struct Request
+        {
+            std::shared_ptr<const FrustumCullTree> tree;                 ///< The tree to cull.
+            renderer::FrustumInfo                  frustum_info;         ///< The information needed for the culling.
+            uint64_t                               scene_iteration = 0;  ///< The scene iteration the tree was built for.
+        };
+
+        /// @brief The result of a cull.
+        struct Result
+        {
+            renderer::InstanceMap instance_map;             ///< The instances inside the frustum.
+            glm::vec3             closest_point_to_camera;  ///< The closest point on the instances to the camera.
+            uint64_t              scene_iteration = 0;      ///< The scene iteration the result was culled for.
+        };
+
+        /// @brief Run the waiting requests until there are none left. Called on the job system.
+        ///
+        /// @param [in] user_data The frustum culler.
+        static void RunRequests(void* user_data);
+
+        RraJobGroup* job_group_ = nullptr;  ///< The group the culling runs in.
+
+        std::mutex mutex_;                                   ///< Protects the members below.
+        Request    pending_request_;                         ///< The latest request not yet started.
+        bool       has_pending_request_  = false;            ///< True if pending_request_ is waiting to run.
+        bool       running_              = false;            ///< True while a job is running the requests.
+        uint64_t   last_scene_iteration_ = UINT64_MAX;       ///< The scene iteration of the last request.
+        glm::mat4  last_view_projection_ = glm::mat4(0.0f);  ///< The view projection of the last request.
+        float      last_fov_             = 0.0f;             ///< The field of view of the last request.
+        float      last_fov_ratio_       = 0.0f;             ///< The fov threshold ratio of the last request.
+        Result     results_[2];                              ///< The result being written by the cull, and the latest finished result.
+        uint32_t   finished_index_       = 0;                ///< The index of the latest finished result.
+        bool       has_finished_result_  = false;            ///< True if the latest finished result has not been taken.
+    };
+}  // namespace rra
+
+#endif  // RRA_MODELS_FRUSTUM_CULLER_H_
@@ -74,6 +74,8 @@ namespace rra
         widget_util::SetTableModelData(global_stats_table_model_, "Total BLASes", kGlobalStatsTableRowBlasCount, 0);
         widget_util::SetTableModelData(global_stats_table_model_, "Empty BLASes", kGlobalStatsTableRowBlasEmpty, 0);
         widget_util::SetTableModelData(global_stats_table_model_, "Missing BLASes", kGlobalStatsTableRowBlasMissing, 0);
+        widget_util::SetTableModelData(global_stats_table_model_, "Duplicate BLASes", kGlobalStatsTableRowBlasDuplicate, 0);
+        widget_util::SetTableModelData(global_stats_table_model_, "Duplicate BLAS memory", kGlobalStatsTableRowBlasDuplicateMemory, 0);
         widget_util::SetTableModelData(global_stats_table_model_, "Inactive instances", kGlobalStatsTableRowInstanceInactive, 0);
 
         uint64_t tlas_count = 0;
@@ -100,6 +102,22 @@ namespace rra
             widget_util::SetTableModelData(global_stats_table_model_, rra::string_util::LocalizedValue(missing_blas_count), kGlobalStatsTableRowBlasMissing, 1);
         }
 
+        uint64_t duplicate_blas_count = 0;
+        if (RraBvhGetDuplicateBlasCount(&duplicate_blas_count) == kRraOk)
+        {
+            widget_util::SetTableModelData(
+                global_stats_table_model_, rra::string_util::LocalizedValue(duplicate_blas_count), kGlobalStatsTableRowBlasDuplicate, 1);
+        }
+
+        uint64_t duplicate_blas_memory = 0;
+        if (RraBvhGetDuplicateBlasSizeInBytes(&duplicate_blas_memory) == kRraOk)
+        {
+            widget_util::SetTableModelData(global_stats_table_model_,
+                                           rra::string_util::LocalizedValueMemory(static_cast<double>(duplicate_blas_memory), false, true),
+                                           kGlobalStatsTableRowBlasDuplicateMemory,
+                                           1);
+        }
+
         uint64_t inactive_instance_count = 0;
         if (RraBvhGetInactiveInstancesCount(&inactive_instance_count) == kRraOk)
         {
@@ -42,6 +42,8 @@ namespace rra
         kGlobalStatsTableRowBlasCount,
         kGlobalStatsTableRowBlasEmpty,
         kGlobalStatsTableRowBlasMissing,
+        kGlobalStatsTableRowBlasDuplicate,
+        kGlobalStatsTableRowBlasDuplicateMemory,
         kGlobalStatsTableRowInstanceInactive,
 
         kGlobalStatsTableNumRows
@@ -39,15 +39,18 @@ namespace rra
     Scene::~Scene()
     {
         delete root_node_;
+        delete pending_root_;
     }
 
-    void Scene::Initialize(SceneNode* root_node)
+    void Scene::Initialize(SceneNode* root_node, bool complete)
     {
         delete root_node_;
         root_node_ = root_node;
+        complete_  = complete;
 
         nodes_.clear();
         root_node->CollectNodes(nodes_);
+        cached_instance_map_.clear();
 
         // Now that the scene mesh and instance maps have been initialized, build the scene info.
         PopulateSceneInfo();
@@ -55,52 +58,129 @@ namespace rra
         IncrementSceneIteration();
     }
 
-    renderer::InstanceMap Scene::GetInstances() const
+    void Scene::SetPendingRoot(SceneNode* root_node, bool complete)
     {
-        renderer::InstanceMap instance_map;
+        std::lock_guard<std::mutex> lock(pending_root_mutex_);
 
-        root_node_->AppendInstancesTo(instance_map);
-
-        return instance_map;
+        // A later stage replaces one that was never applied.
+        delete pending_root_;
+        pending_root_          = root_node;
+        pending_root_complete_ = complete;
     }
 
-    renderer::InstanceMap Scene::GetFrustumCulledInstanceMap(renderer::FrustumInfo& frustum_info) const
+    bool Scene::ApplyPendingRoot()
     {
-        renderer::InstanceMap instance_map;
+        SceneNode* root_node = nullptr;
+        bool       complete  = true;
+        {
+            std::lock_guard<std::mutex> lock(pending_root_mutex_);
+            root_node     = pending_root_;
+            complete      = pending_root_complete_;
+            pending_root_ = nullptr;
+        }
+
+        if (root_node == nullptr)
+        {
+            return false;
+        }
 
-        root_node_->AppendFrustumCulledInstanceMap(instance_map, frustum_info);
+        // The new tree uses the same node ids, so the selection can be carried over. Only the top of each selected
+        // branch needs selecting, since selecting a node selects everything below it.
+        std::vector<uint32_t> selected_node_ids;
+        for (const auto& node : nodes_)
+        {
+            if (node.second && node.second->IsSelected() && !(node.second->GetParent() && node.second->GetParent()->IsSelected()))
+            {
+                selected_node_ids.push_back(node.first);
+            }
+        }
+        if (pending_selection_node_id_ != UINT32_MAX)
+        {
+            selected_node_ids.push_back(pending_selection_node_id_);
+        }
 
-        float min_distance = std::numeric_limits<float>::infinity();
+        Initialize(root_node, complete);
 
-        for (auto& instance_type : instance_map)
+        bool selection_changed = false;
+        for (uint32_t node_id : selected_node_ids)
         {
-            for (auto& instance : instance_type.second)
+            auto node = GetNodeById(node_id);
+            if (node)
             {
-                glm::vec3 min      = {instance.bounding_volume.min_x, instance.bounding_volume.min_y, instance.bounding_volume.min_z};
-                glm::vec3 max      = {instance.bounding_volume.max_x, instance.bounding_volume.max_y, instance.bounding_volume.max_z};
-                glm::vec3 center   = min + (max - min) / 2.0f;
-                float     distance = glm::distance(frustum_info.camera_position, center);
-                if (distance < min_distance)
+                node->ApplyNodeSelection();
+                selection_changed = true;
+
+                if (node_id == pending_selection_node_id_)
                 {
-                    frustum_info.closest_point_to_camera = center;
-                    min_distance                         = distance;
+                    most_recent_selected_node_id_ = node_id;
+                    pending_selection_node_id_    = UINT32_MAX;
                 }
             }
         }
 
-        for (auto& custom_triangle : custom_triangles_)
+        if (complete)
         {
-            float distance = glm::distance(frustum_info.camera_position, glm::vec3(custom_triangle.position));
-            if (distance < min_distance)
-            {
-                frustum_info.closest_point_to_camera = custom_triangle.position;
-                min_distance                         = distance;
-            }
+            pending_selection_node_id_ = UINT32_MAX;
+        }
+
+        if (selection_changed)
+        {
+            IncrementSceneIteration();
         }
 
+        return true;
+    }
+
+    bool Scene::IsComplete() const
+    {
+        return complete_;
+    }
+
+    bool Scene::HasPendingSelection() const
+    {
+        return pending_selection_node_id_ != UINT32_MAX;
+    }
+
+    renderer::InstanceMap Scene::GetInstances() const
+    {
+        renderer::InstanceMap instance_map;
+
+        root_node_->AppendInstancesTo(instance_map);
+
         return instance_map;
     }
 
+    std::shared_ptr<const FrustumCullTree> Scene::GetFrustumCullTree()
+    {
+        if (frustum_cull_tree_ != nullptr && frustum_cull_tree_iteration_ == scene_iteration_)
+        {
+            return frustum_cull_tree_;
+        }
+
+        // A cull still running keeps its own reference to the old tree, so a new one is built rather than changing it.
+        std::shared_ptr<FrustumCullTree> tree = std::make_shared<FrustumCullTree>();
+        if (root_node_ != nullptr && root_node_->IsVisible())
+        {
+            tree->nodes.emplace_back();
+            root_node_->AppendToFrustumCullTree(*tree, 0);
+        }
+
+        tree->custom_triangle_positions.reserve(custom_triangles_.size());
+        for (auto& custom_triangle : custom_triangles_)
+        {
+            tree->custom_triangle_positions.push_back(glm::vec3(custom_triangle.position));
+        }
+
+        frustum_cull_tree_           = tree;
+        frustum_cull_tree_iteration_ = scene_iteration_;
+        return frustum_cull_tree_;
+    }
+
+    FrustumCuller& Scene::GetFrustumCuller()
+    {
+        return frustum_culler_;
+    }
+
     renderer::InstanceMap Scene::GetInstanceMap()
     {
         renderer::InstanceMap instance_map;
@@ -178,6 +258,17 @@ namespace rra
                 auto node_triangles = node->GetTriangles();
                 if (!node_triangles.empty() && node->IsVisible() && node->IsEnabled())
                 {
+                    if (node_overlap_coloring_)
+                    {
+                        // Negative to indicate deselected triangles, as with the SAH.
+                        const float score = -node->GetSiblingOverlapScore();
+                        for (auto& triangle : node_triangles)
+                        {
+                            triangle.a.triangle_sah_and_selected = score;
+                            triangle.b.triangle_sah_and_selected = score;
+                            triangle.c.triangle_sah_and_selected = score;
+                        }
+                    }
                     geometry_primitives[node->GetGeometryIndex()][node->GetPrimitiveIndex()] = node_triangles;
                     selected_geometry_primitives[node->GetGeometryIndex()][node->GetPrimitiveIndex()] |= node->IsSelected();
                 }
@@ -367,9 +458,16 @@ namespace rra
         if (!multi_select_)
         {
             root_node_->ResetSelection();
+            pending_selection_node_id_ = UINT32_MAX;
         }
 
         auto node = GetNodeById(node_id);
+        if (node == nullptr && !complete_)
+        {
+            // The node hasn't been constructed yet, so select it once it has.
+            pending_selection_node_id_ = node_id;
+        }
+
         if (node)
         {
             if (node->IsSelected() && multi_select_)
@@ -399,6 +497,7 @@ namespace rra
         {
             root_node_->ResetSelection();
         }
+        pending_selection_node_id_ = UINT32_MAX;
         IncrementSceneIteration();
     }
 
@@ -469,6 +568,15 @@ namespace rra
         PopulateSelectedVolumeInstances();
     }
 
+    void Scene::SetNodeOverlapColoring(bool enabled)
+    {
+        if (node_overlap_coloring_ != enabled)
+        {
+            node_overlap_coloring_ = enabled;
+            IncrementSceneIteration();
+        }
+    }
+
     uint32_t Scene::GetTotalInstanceCountForBlas(uint64_t blas_index) const
     {
         auto result = blas_instance_counts_.find(blas_index);
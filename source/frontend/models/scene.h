@@ -8,10 +8,14 @@
 #ifndef RRA_RENDERER_SCENE_H_
 #define RRA_RENDERER_SCENE_H_
 
+#include <atomic>
 #include <map>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 #include "public/renderer_types.h"
+#include "frustum_culler.h"
 #include "scene_node.h"
 
 namespace rra
@@ -93,22 +97,50 @@ namespace rra
         /// @brief Initialize the Scene with the input mesh and instance info.
         ///
         /// @param [in] root_node The root node for this scene.
-        void Initialize(SceneNode* root_node);
+        /// @param [in] complete False if the nodes are still being constructed, and a fuller tree will follow through SetPendingRoot().
+        void Initialize(SceneNode* root_node, bool complete = true);
+
+        /// @brief Hand over a root node constructed on another thread.
+        ///
+        /// The scene keeps its current nodes until ApplyPendingRoot() is called, so this can be called while the scene is in use.
+        ///
+        /// @param [in] root_node The new root node. The scene takes ownership of it.
+        /// @param [in] complete False if a fuller tree will follow.
+        void SetPendingRoot(SceneNode* root_node, bool complete);
+
+        /// @brief Replace the scene's nodes with the root node handed over by SetPendingRoot(), if there is one.
+        ///
+        /// Must be called on the thread that uses the scene. The selection is carried over to the new nodes.
+        ///
+        /// @returns True if the nodes were replaced.
+        bool ApplyPendingRoot();
+
+        /// @brief Check if every node in the scene has been constructed.
+        ///
+        /// @returns False if the scene is showing a partial tree while the rest is constructed.
+        bool IsComplete() const;
+
+        /// @brief Check if a node was selected before it was constructed. Can be called from any thread.
+        ///
+        /// @returns True if a selected node is waiting for a fuller tree.
+        bool HasPendingSelection() const;
 
         /// @brief Get the mesh instances map.
         ///
         /// @returns A map to the mesh instances by blas id.
         renderer::InstanceMap GetInstances() const;
 
-        /// @brief Get the frustum culled render data.
+        /// @brief Get a copy of the visible part of the scene for frustum culling.
         ///
-        /// @param [in] frustum_info The information needed for the culling.
+        /// The copy is only rebuilt when the scene iteration changes.
         ///
-        /// Note: This function populates mutates the given frustum info struct.
-        /// Specifically it populates the closest_distance_to_camera field for nearest plane calculation.
+        /// @returns The frustum cull tree.
+        std::shared_ptr<const FrustumCullTree> GetFrustumCullTree();
+
+        /// @brief Get the frustum culler, which culls the scene in the background.
         ///
-        /// @returns A map of instances.
-        renderer::InstanceMap GetFrustumCulledInstanceMap(renderer::FrustumInfo& frustum_info) const;
+        /// @returns The frustum culler.
+        FrustumCuller& GetFrustumCuller();
 
         /// @brief Get the render data without frustum culling.
         ///
@@ -181,6 +213,13 @@ namespace rra
         /// @brief Iterates the scene, called when a change is made in the scene to notify downstream consumers.
         void IncrementSceneIteration();
 
+        /// @brief Set whether the triangles carry the sibling overlap score of their node in place of their SAH.
+        ///
+        /// The node overlap coloring mode reuses the triangle SAH heatmap, so the scene swaps the values it shows.
+        ///
+        /// @param [in] enabled True to show the sibling overlap score.
+        void SetNodeOverlapColoring(bool enabled);
+
         /// @brief Get total instance count for blas.
         ///
         /// @param [in] blas_index The blas to check for.
@@ -306,10 +345,21 @@ namespace rra
         uint32_t                                      most_recent_selected_node_id_ = 0;  ///< The most recent selected node id.
         static bool                                   multi_select_;                      ///< Allows multiple nodes to be selected if true.
         renderer::InstanceMap                         cached_instance_map_{};  ///< Saved instance map of all instances, used when frustum culling is disabled.
+        std::shared_ptr<const FrustumCullTree>        frustum_cull_tree_;                         ///< Copy of the visible scene for frustum culling.
+        uint64_t                                      frustum_cull_tree_iteration_ = UINT64_MAX;  ///< The scene iteration frustum_cull_tree_ was built for.
+        FrustumCuller                                 frustum_culler_;                            ///< Culls the scene in the background.
 
         uint32_t depth_range_lower_bound_ = 0;  ///< The lower bound for the depth range.
         uint32_t depth_range_upper_bound_ = 0;  ///< The upper bound for the depth range.
 
+        bool node_overlap_coloring_ = false;  ///< True if the triangles carry the sibling overlap score of their node.
+
+        bool                  complete_ = true;                        ///< False while the scene is showing a partial tree.
+        std::atomic<uint32_t> pending_selection_node_id_{UINT32_MAX};  ///< A node selected before it was constructed, selected once it is.
+        std::mutex            pending_root_mutex_;                     ///< Protects the pending root node.
+        SceneNode*            pending_root_          = nullptr;        ///< A root node waiting to replace the current one.
+        bool                  pending_root_complete_ = true;           ///< True if the pending root node is the complete tree.
+
         // Static so that it monotonically increases across all scenes.
         // This prevents problems when storing last scene iteration and switching scenes.
         static uint64_t scene_iteration_;  ///< A number to check on for changes in the scene.
@@ -0,0 +1,79 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the SceneBuilder class.
+//=============================================================================
+
+#include "models/scene_builder.h"
+
+#include "public/rra_assert.h"
+
+namespace rra
+{
+    SceneBuilder::SceneBuilder()
+    {
+        RraJobGroupCreate(&job_group_);
+    }
+
+    SceneBuilder::~SceneBuilder()
+    {
+        Cancel();
+        RraJobGroupDestroy(job_group_);
+    }
+
+    void SceneBuilder::Start(Scene* scene, std::vector<Stage> stages)
+    {
+        RRA_ASSERT(scene != nullptr);
+
+        Cancel();
+
+        scene_     = scene;
+        stages_    = std::move(stages);
+        cancelled_ = false;
+        RraJobGroupSubmit(job_group_, &SceneBuilder::RunStages, this);
+    }
+
+    void SceneBuilder::Cancel()
+    {
+        // The stages check the flag as they go, so this doesn't wait for long.
+        cancelled_ = true;
+        RraJobGroupWait(job_group_);
+        stages_.clear();
+        scene_ = nullptr;
+    }
+
+    bool SceneBuilder::IsRunning() const
+    {
+        bool finished = true;
+        RraJobGroupIsFinished(job_group_, &finished);
+        return !finished;
+    }
+
+    void SceneBuilder::RunStages(void* user_data)
+    {
+        SceneBuilder* builder = static_cast<SceneBuilder*>(user_data);
+
+        for (size_t stage_index = 0; stage_index < builder->stages_.size(); stage_index++)
+        {
+            const bool last_stage = stage_index + 1 == builder->stages_.size();
+
+            // A node picked in the tree view that hasn't been constructed yet is only in the full tree, so go straight to it.
+            if (!last_stage && builder->scene_->HasPendingSelection())
+            {
+                continue;
+            }
+
+            SceneNode* root_node = builder->stages_[stage_index](builder->cancelled_);
+
+            // A cancelled stage may have stopped part way through, so its tree is thrown away.
+            if (builder->cancelled_)
+            {
+                delete root_node;
+                return;
+            }
+
+            builder->scene_->SetPendingRoot(root_node, last_stage);
+        }
+    }
+}  // namespace rra
@@ -0,0 +1,67 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Declaration for the SceneBuilder class.
+//=============================================================================
+
+#ifndef RRA_MODELS_SCENE_BUILDER_H_
+#define RRA_MODELS_SCENE_BUILDER_H_
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "public/rra_job_system.h"
+
+#include "scene.h"
+
+namespace rra
+{
+    /// @brief Constructs the nodes of a scene on the backend job system, so the UI stays responsive.
+    ///
+    /// The construction is split into stages, each producing a fuller tree than the last. Each tree is handed over to
+    /// the scene as soon as it is finished, and replaces the scene's nodes the next time the scene is drawn. If a node is
+    /// selected before it has been constructed, the stages before the last are skipped so the selection shows sooner.
+    class SceneBuilder
+    {
+    public:
+        /// @brief A stage of the construction.
+        ///
+        /// Called with a flag that is set if the construction is cancelled. Returns the new root node.
+        typedef std::function<SceneNode*(const std::atomic<bool>& cancelled)> Stage;
+
+        /// @brief Constructor.
+        SceneBuilder();
+
+        /// @brief Destructor. Cancels any construction still running.
+        ~SceneBuilder();
+
+        /// @brief Start constructing the nodes of a scene, cancelling any previous construction.
+        ///
+        /// @param [in] scene The scene to hand the nodes to. Must outlive the construction.
+        /// @param [in] stages The stages, run one after another.
+        void Start(Scene* scene, std::vector<Stage> stages);
+
+        /// @brief Cancel the construction, and wait for it to stop.
+        void Cancel();
+
+        /// @brief Check if the construction is still running.
+        ///
+        /// @returns True if the construction has not finished.
+        bool IsRunning() const;
+
+    private:
+        /// @brief Run the stages. Called on the job system.
+        ///
+        /// @param [in] user_data The scene builder.
+        static void RunStages(void* user_data);
+
+        RraJobGroup*       job_group_ = nullptr;  ///< The group the construction runs in.
+        Scene*             scene_     = nullptr;  ///< The scene being constructed.
+        std::vector<Stage> stages_;               ///< The stages of the construction.
+        std::atomic<bool>  cancelled_{false};     ///< Set to stop the construction early.
+    };
+}  // namespace rra
+
+#endif  // RRA_MODELS_SCENE_BUILDER_H_
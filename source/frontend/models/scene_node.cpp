@@ -7,8 +7,10 @@
 
 #include <deque>
 #include <algorithm>
+#include <limits>
 
 #include "public/rra_blas.h"
+#include "public/rra_instance_overlap.h"
 #include "public/rra_tlas.h"
 #include "scene_node.h"
 #include "public/shared.h"
@@ -155,40 +157,112 @@ namespace rra
         return true;
     }
 
-    void SceneNode::AppendFrustumCulledInstanceMap(renderer::InstanceMap& instance_map, renderer::FrustumInfo& frustum_info) const
+    renderer::InstanceMap FrustumCullTree::Cull(renderer::FrustumInfo& frustum_info) const
     {
-        // Skip if marked as not visible.
-        if (!visible_)
+        renderer::InstanceMap instance_map;
+
+        if (!nodes.empty())
         {
-            return;
+            // Extract the planes from the view_projection.
+            auto culling_planes = GetNormalizedPlanesFromMatrix(frustum_info.camera_view_projection);
+            CullChildren(0, culling_planes, frustum_info, instance_map);
+        }
+
+        float min_distance = std::numeric_limits<float>::infinity();
+
+        for (auto& instance_type : instance_map)
+        {
+            for (auto& instance : instance_type.second)
+            {
+                glm::vec3 min      = {instance.bounding_volume.min_x, instance.bounding_volume.min_y, instance.bounding_volume.min_z};
+                glm::vec3 max      = {instance.bounding_volume.max_x, instance.bounding_volume.max_y, instance.bounding_volume.max_z};
+                glm::vec3 center   = min + (max - min) / 2.0f;
+                float     distance = glm::distance(frustum_info.camera_position, center);
+                if (distance < min_distance)
+                {
+                    frustum_info.closest_point_to_camera = center;
+                    min_distance                         = distance;
+                }
+            }
         }
 
-        // Extract the planes from the view_projection.
-        auto culling_planes = GetNormalizedPlanesFromMatrix(frustum_info.camera_view_projection);
+        for (auto& position : custom_triangle_positions)
+        {
+            float distance = glm::distance(frustum_info.camera_position, position);
+            if (distance < min_distance)
+            {
+                frustum_info.closest_point_to_camera = position;
+                min_distance                         = distance;
+            }
+        }
+
+        return instance_map;
+    }
+
+    void FrustumCullTree::CullChildren(uint32_t                        node_index,
+                                       const std::array<glm::vec4, 6>& planes,
+                                       const renderer::FrustumInfo&    frustum_info,
+                                       renderer::InstanceMap&          instance_map) const
+    {
+        const Node& node = nodes[node_index];
 
         // Cull for the child nodes.
-        for (auto child_node : child_nodes_)
+        for (uint32_t child_index = node.first_child; child_index < node.first_child + node.child_count; child_index++)
         {
-            if (!BoundingVolumeExtentFovCull(
-                    child_node->bounding_volume_, frustum_info.camera_position, frustum_info.camera_fov, frustum_info.fov_threshold_ratio) &&
-                BoundingVolumeExtentsInsidePlanes(child_node->bounding_volume_, culling_planes))
+            const BoundingVolumeExtents& child_volume = nodes[child_index].bounding_volume;
+            if (!BoundingVolumeExtentFovCull(child_volume, frustum_info.camera_position, frustum_info.camera_fov, frustum_info.fov_threshold_ratio) &&
+                BoundingVolumeExtentsInsidePlanes(child_volume, planes))
             {
-                child_node->AppendFrustumCulledInstanceMap(instance_map, frustum_info);
+                CullChildren(child_index, planes, frustum_info, instance_map);
             }
         }
 
         // Check for instances.
-        for (auto& instance : instances_)
+        for (uint32_t instance_index = node.first_instance; instance_index < node.first_instance + node.instance_count; instance_index++)
         {
+            const renderer::Instance& instance = instances[instance_index];
             if (!BoundingVolumeExtentFovCull(
                     instance.bounding_volume, frustum_info.camera_position, frustum_info.camera_fov, frustum_info.fov_threshold_ratio) &&
-                BoundingVolumeExtentsInsidePlanes(instance.bounding_volume, culling_planes))
+                BoundingVolumeExtentsInsidePlanes(instance.bounding_volume, planes))
             {
                 instance_map[instance.blas_index].push_back(instance);
             }
         }
     }
 
+    void SceneNode::AppendToFrustumCullTree(FrustumCullTree& tree, uint32_t node_index) const
+    {
+        uint32_t visible_child_count = 0;
+        for (auto child_node : child_nodes_)
+        {
+            if (child_node->visible_)
+            {
+                visible_child_count++;
+            }
+        }
+
+        // Allocate the children together, so they are next to each other in the tree. Hidden children are left out.
+        const uint32_t first_child = static_cast<uint32_t>(tree.nodes.size());
+        tree.nodes.resize(tree.nodes.size() + visible_child_count);
+
+        FrustumCullTree::Node& node = tree.nodes[node_index];
+        node.bounding_volume        = bounding_volume_;
+        node.first_child            = first_child;
+        node.child_count            = visible_child_count;
+        node.first_instance         = static_cast<uint32_t>(tree.instances.size());
+        node.instance_count         = static_cast<uint32_t>(instances_.size());
+        tree.instances.insert(tree.instances.end(), instances_.begin(), instances_.end());
+
+        uint32_t child_index = first_child;
+        for (auto child_node : child_nodes_)
+        {
+            if (child_node->visible_)
+            {
+                child_node->AppendToFrustumCullTree(tree, child_index++);
+            }
+        }
+    }
+
     void SceneNode::AppendInstanceMap(renderer::InstanceMap& instance_map) const
     {
         // Skip if marked as not visible.
@@ -224,7 +298,7 @@ namespace rra
         }
     }
 
-    SceneNode* SceneNode::ConstructFromBlasNode(uint64_t blas_index, uint32_t node_id, uint32_t depth)
+    SceneNode* SceneNode::ConstructFromBlasNode(uint64_t blas_index, uint32_t node_id, uint32_t depth, uint32_t max_depth, const std::atomic<bool>* cancelled)
     {
         SceneNode* node = new SceneNode();
         node->node_id_  = node_id;
@@ -311,12 +385,26 @@ namespace rra
             return node;
         }
 
+        if (depth >= max_depth || (cancelled != nullptr && *cancelled))
+        {
+            return node;
+        }
+
         uint32_t child_node_count;
         RraBlasGetChildNodeCount(blas_index, node_id, &child_node_count);
 
         std::vector<uint32_t> child_nodes(child_node_count);
         RraBlasGetChildNodes(blas_index, node_id, child_nodes.data());
 
+        // The children share the overlap score of this node, so they can be colored by how well it separates them.
+        float overlap_area          = 0.0f;
+        float overlap_volume        = 0.0f;
+        float sibling_overlap_score = 1.0f;
+        if (RraBlasGetSiblingOverlap(blas_index, node_id, &overlap_area, &overlap_volume) == kRraOk)
+        {
+            sibling_overlap_score = 1.0f - std::min(1.0f, overlap_area);
+        }
+
         for (auto child_node : child_nodes)
         {
             if (child_node == node_id)
@@ -324,69 +412,55 @@ namespace rra
                 // Self refencing node will cause a stack overflow. Skip to prevent a crash.
                 continue;
             }
-            auto child_node_ptr     = SceneNode::ConstructFromBlasNode(blas_index, child_node, depth + 1);
-            child_node_ptr->parent_ = node;
+            auto child_node_ptr                    = SceneNode::ConstructFromBlasNode(blas_index, child_node, depth + 1, max_depth, cancelled);
+            child_node_ptr->parent_                = node;
+            child_node_ptr->sibling_overlap_score_ = sibling_overlap_score;
             node->child_nodes_.push_back(child_node_ptr);
         }
 
         return node;
     }
 
-    SceneNode* SceneNode::ConstructFromBlas(uint32_t blas_index)
+    SceneNode* SceneNode::ConstructFromBlas(uint32_t blas_index, uint32_t max_depth, const std::atomic<bool>* cancelled)
     {
         uint32_t root_node_index = UINT32_MAX;
         RraBvhGetRootNodePtr(&root_node_index);
 
-        auto node = ConstructFromBlasNode(blas_index, root_node_index, 0);
+        auto node = ConstructFromBlasNode(blas_index, root_node_index, 0, max_depth, cancelled);
 
         return node;
     }
 
-    SceneNode* SceneNode::ConstructFromTlasBoxNode(uint64_t tlas_index, uint32_t node_id, uint32_t depth)
+    SceneNode* SceneNode::ConstructFromTlasBoxNode(uint64_t                 tlas_index,
+                                                   uint32_t                 node_id,
+                                                   uint32_t                 depth,
+                                                   const InstanceNodeMap&   instance_nodes,
+                                                   uint32_t                 max_depth,
+                                                   const std::atomic<bool>* cancelled)
     {
         SceneNode* node = new SceneNode();
         node->node_id_  = node_id;
         node->depth_    = depth;
 
-        RraTlasGetBoundingVolumeExtents(tlas_index, node_id, &node->bounding_volume_);
-
         if (RraBvhIsInstanceNode(node_id))
         {
-            renderer::Instance instance = {};
-            instance.selected           = false;
-            instance.instance_node      = node_id;
-            instance.depth              = depth;
-
-            instance.transform = glm::mat4(0.0f);  // Reset the transform to prevent misalignment.
-
-            RraTlasGetInstanceNodeTransform(tlas_index, node_id, reinterpret_cast<float*>(&instance.transform));
-            instance.transform[3][3] = 1.0f;
-
-            // Navi IP 1.1 encoding specifies that the transform is inverse, so we inverse it again to get the correct transform.
-            instance.transform = glm::inverse(instance.transform);
-
-            RraTlasGetBoundingVolumeExtents(tlas_index, node_id, &instance.bounding_volume);
-
-            RraTlasGetBlasIndexFromInstanceNode(tlas_index, node_id, &instance.blas_index);
-            RraBlasGetMaxTreeDepth(instance.blas_index, &instance.max_depth);
-            RraBlasGetAvgTreeDepth(instance.blas_index, &instance.average_depth);
-
-            uint32_t root_node = UINT32_MAX;
-            RraBvhGetRootNodePtr(&root_node);
-
-            RraBlasGetAverageSurfaceAreaHeuristic(instance.blas_index, root_node, true, &instance.average_triangle_sah);
-            RraBlasGetMinimumSurfaceAreaHeuristic(instance.blas_index, root_node, true, &instance.min_triangle_sah);
-
-            RraTlasGetInstanceIndexFromInstanceNode(tlas_index, node_id, &instance.instance_index);
-
-            RraBlasGetBuildFlags(instance.blas_index, reinterpret_cast<VkBuildAccelerationStructureFlagBitsKHR*>(&instance.build_flags));
+            auto iter = instance_nodes.find(node_id);
+            if (iter != instance_nodes.end())
+            {
+                renderer::Instance instance = iter->second;
+                instance.depth              = depth;
 
-            RraTlasGetInstanceNodeMask(tlas_index, node_id, &instance.mask);
+                node->bounding_volume_ = instance.bounding_volume;
+                node->instances_.push_back(instance);
+            }
 
-            RraTlasGetInstanceFlags(tlas_index, node_id, &instance.flags);
+            return node;
+        }
 
-            node->instances_.push_back(instance);
+        RraTlasGetBoundingVolumeExtents(tlas_index, node_id, &node->bounding_volume_);
 
+        if (depth >= max_depth || (cancelled != nullptr && *cancelled))
+        {
             return node;
         }
 
@@ -398,7 +472,7 @@ namespace rra
 
         for (auto child_node : child_nodes)
         {
-            auto child_node_ptr     = SceneNode::ConstructFromTlasBoxNode(tlas_index, child_node, depth + 1);
+            auto child_node_ptr     = SceneNode::ConstructFromTlasBoxNode(tlas_index, child_node, depth + 1, instance_nodes, max_depth, cancelled);
             child_node_ptr->parent_ = node;
             node->child_nodes_.push_back(child_node_ptr);
         }
@@ -406,11 +480,134 @@ namespace rra
         return node;
     }
 
-    SceneNode* SceneNode::ConstructFromTlas(uint64_t tlas_index)
+    void SceneNode::GetTlasInstanceNodes(uint64_t tlas_index, InstanceNodeMap& instance_nodes)
     {
         uint32_t root_node_index = UINT32_MAX;
         RraBvhGetRootNodePtr(&root_node_index);
-        return ConstructFromTlasBoxNode(tlas_index, root_node_index, 0);
+
+        // Fetch the data for every instance in the TLAS in a single call, rather than querying each instance node individually.
+        uint64_t instance_count = 0;
+        if (RraTlasGetInstanceTableRowCount(tlas_index, &instance_count) == kRraOk && instance_count > 0)
+        {
+            std::vector<uint32_t>              node_ptrs(instance_count);
+            std::vector<uint64_t>              blas_indices(instance_count);
+            std::vector<uint32_t>              instance_indices(instance_count);
+            std::vector<float>                 transforms(instance_count * 12);
+            std::vector<uint32_t>              masks(instance_count);
+            std::vector<uint32_t>              flags(instance_count);
+            std::vector<BoundingVolumeExtents> bounding_volumes(instance_count);
+            std::vector<uint32_t>              row_valid(instance_count);
+
+            RraTlasInstanceTable instance_table = {};
+            instance_table.node_ptr             = node_ptrs.data();
+            instance_table.blas_index           = blas_indices.data();
+            instance_table.instance_index       = instance_indices.data();
+            instance_table.transform            = transforms.data();
+            instance_table.mask                 = masks.data();
+            instance_table.flags                = flags.data();
+            instance_table.bounding_volume      = bounding_volumes.data();
+            instance_table.row_valid            = row_valid.data();
+
+            if (RraTlasGetInstanceTable(tlas_index, 0, &instance_table) == kRraOk)
+            {
+                // Failing to find the overlaps only affects the overlap coloring mode, so it isn't treated as an error.
+                std::vector<uint32_t>   overlap_counts(instance_count);
+                RraInstanceOverlapStats instance_overlap_stats = {};
+                if (RraInstanceOverlapCalculate(tlas_index, 0, overlap_counts.data(), nullptr, &instance_overlap_stats) != kRraOk)
+                {
+                    overlap_counts.assign(instance_count, 0);
+                }
+                const float max_overlap_count = static_cast<float>(std::max(instance_overlap_stats.max_overlap_count, 1u));
+
+                instance_nodes.reserve(instance_count);
+
+                // The rows are sorted by BLAS index, so the BLAS statistics only need fetching when the BLAS changes.
+                renderer::Instance blas_instance = {};
+                blas_instance.blas_index         = UINT64_MAX;
+
+                for (uint64_t row = 0; row < instance_count; row++)
+                {
+                    // An instance node that couldn't be read has no transform to draw it with. Its box node is still
+                    // shown, just without an instance.
+                    if (row_valid[row] == 0)
+                    {
+                        continue;
+                    }
+
+                    if (blas_indices[row] != blas_instance.blas_index)
+                    {
+                        blas_instance.blas_index = blas_indices[row];
+                        RraBlasGetMaxTreeDepth(blas_instance.blas_index, &blas_instance.max_depth);
+                        RraBlasGetAvgTreeDepth(blas_instance.blas_index, &blas_instance.average_depth);
+                        RraBlasGetAverageSurfaceAreaHeuristic(blas_instance.blas_index, root_node_index, true, &blas_instance.average_triangle_sah);
+                        RraBlasGetMinimumSurfaceAreaHeuristic(blas_instance.blas_index, root_node_index, true, &blas_instance.min_triangle_sah);
+                        RraBlasGetBuildFlags(blas_instance.blas_index, reinterpret_cast<VkBuildAccelerationStructureFlagBitsKHR*>(&blas_instance.build_flags));
+
+                        RraBvhOverlapStats overlap_stats = {};
+                        RraBlasGetOverlapStats(blas_instance.blas_index, &overlap_stats);
+                        blas_instance.sibling_overlap_score = 1.0f - std::min(1.0f, overlap_stats.mean_overlap_area);
+                    }
+
+                    renderer::Instance instance     = {};
+                    instance.selected               = false;
+                    instance.instance_node          = node_ptrs[row];
+                    instance.blas_index             = blas_instance.blas_index;
+                    instance.max_depth              = blas_instance.max_depth;
+                    instance.average_depth          = blas_instance.average_depth;
+                    instance.average_triangle_sah   = blas_instance.average_triangle_sah;
+                    instance.min_triangle_sah       = blas_instance.min_triangle_sah;
+                    instance.sibling_overlap_score  = blas_instance.sibling_overlap_score;
+                    instance.instance_overlap_score = 1.0f - overlap_counts[row] / max_overlap_count;
+                    instance.build_flags            = blas_instance.build_flags;
+                    instance.instance_index         = instance_indices[row];
+                    instance.mask                   = masks[row];
+                    instance.flags                  = flags[row];
+                    instance.bounding_volume        = bounding_volumes[row];
+
+                    instance.transform = glm::mat4(0.0f);  // Reset the transform to prevent misalignment.
+                    memcpy(&instance.transform, &transforms[row * 12], 12 * sizeof(float));
+                    instance.transform[3][3] = 1.0f;
+
+                    // Navi IP 1.1 encoding specifies that the transform is inverse, so we inverse it again to get the correct transform.
+                    instance.transform = glm::inverse(instance.transform);
+
+                    instance_nodes[instance.instance_node] = instance;
+                }
+            }
+        }
+    }
+
+    SceneNode* SceneNode::ConstructFromTlas(uint64_t tlas_index, const InstanceNodeMap& instance_nodes, uint32_t max_depth, const std::atomic<bool>* cancelled)
+    {
+        uint32_t root_node_index = UINT32_MAX;
+        RraBvhGetRootNodePtr(&root_node_index);
+
+        return ConstructFromTlasBoxNode(tlas_index, root_node_index, 0, instance_nodes, max_depth, cancelled);
+    }
+
+    SceneNode* SceneNode::ConstructInstancesFromTlas(uint64_t tlas_index, const InstanceNodeMap& instance_nodes)
+    {
+        uint32_t root_node_index = UINT32_MAX;
+        RraBvhGetRootNodePtr(&root_node_index);
+
+        SceneNode* root = new SceneNode();
+        root->node_id_  = root_node_index;
+        RraTlasGetBoundingVolumeExtents(tlas_index, root_node_index, &root->bounding_volume_);
+
+        root->child_nodes_.reserve(instance_nodes.size());
+        for (const auto& instance_node : instance_nodes)
+        {
+            SceneNode* node        = new SceneNode();
+            node->node_id_         = instance_node.first;
+            node->depth_           = 1;
+            node->parent_          = root;
+            node->bounding_volume_ = instance_node.second.bounding_volume;
+            node->instances_.push_back(instance_node.second);
+            node->instances_.back().depth = 1;
+            root->child_nodes_.push_back(node);
+        }
+
+        return root;
     }
 
     void SceneNode::ResetSelection()
@@ -697,6 +894,11 @@ namespace rra
         return parent_;
     }
 
+    float SceneNode::GetSiblingOverlapScore() const
+    {
+        return sibling_overlap_score_;
+    }
+
     uint32_t SceneNode::AddToTraversalTree(renderer::TraversalTree& traversal_tree)
     {
         uint32_t current_index = static_cast<uint32_t>(traversal_tree.volumes.size());
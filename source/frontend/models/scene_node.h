@@ -8,6 +8,11 @@
 #ifndef RRA_RENDERER_SCENE_NODE_H_
 #define RRA_RENDERER_SCENE_NODE_H_
 
+#include <array>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
 #include "public/renderer_types.h"
 
 namespace rra
@@ -23,10 +28,56 @@ namespace rra
         renderer::RraVertex c;
     };
 
+    /// @brief A copy of the visible part of a scene's tree, holding only what frustum culling needs.
+    ///
+    /// The scene's nodes are changed on the UI thread, so the culling runs on this copy instead. It never changes once
+    /// built, so it can be culled on another thread.
+    class FrustumCullTree
+    {
+    public:
+        /// @brief A node in the tree.
+        struct Node
+        {
+            BoundingVolumeExtents bounding_volume = {};  ///< The bounding volume of the node.
+            uint32_t              first_child     = 0;   ///< The index of the first child. A node's children are next to each other.
+            uint32_t              child_count     = 0;   ///< The number of children.
+            uint32_t              first_instance  = 0;   ///< The index of the node's first instance.
+            uint32_t              instance_count  = 0;   ///< The number of instances.
+        };
+
+        /// @brief Get the render data of the instances in the given frustum.
+        ///
+        /// @param [inout] frustum_info The information needed for the culling.
+        ///
+        /// Note: This function populates the closest_point_to_camera field of the frustum info, for nearest plane calculation.
+        ///
+        /// @returns A map of instances.
+        renderer::InstanceMap Cull(renderer::FrustumInfo& frustum_info) const;
+
+        std::vector<Node>               nodes;                      ///< The visible nodes, root first. Empty if the root is hidden.
+        std::vector<renderer::Instance> instances;                  ///< The instances of the visible nodes.
+        std::vector<glm::vec3>          custom_triangle_positions;  ///< The vertex positions of the scene's custom triangles.
+
+    private:
+        /// @brief Add the instances of a node's children that are in the frustum, and of their children in turn.
+        ///
+        /// @param [in] node_index The node.
+        /// @param [in] planes The frustum planes.
+        /// @param [in] frustum_info The information needed for the culling.
+        /// @param [out] instance_map The map to add the instances to.
+        void CullChildren(uint32_t                        node_index,
+                          const std::array<glm::vec4, 6>& planes,
+                          const renderer::FrustumInfo&    frustum_info,
+                          renderer::InstanceMap&          instance_map) const;
+    };
+
     /// @brief A tree structure to contain volume data and instances.
     class SceneNode
     {
     public:
+        /// @brief Map of an instance node pointer to the instance data gathered for it.
+        typedef std::unordered_map<uint32_t, renderer::Instance> InstanceNodeMap;
+
         /// @brief Constructor
         SceneNode();
 
@@ -38,14 +89,11 @@ namespace rra
         /// @param [out] instances_map A reference to the map to add instances on.
         void AppendInstancesTo(renderer::InstanceMap& instances_map) const;
 
-        /// @brief Recursively adds the render data of volumes that are in the given frustum.
+        /// @brief Recursively copies this node and its visible children into a frustum cull tree.
         ///
-        /// @param [out] instance_map A reference to instance map.
-        /// @param [inout] frustum_info The information needed for the culling.
-        ///
-        /// Note: This function populates mutates the given frustum info struct.
-        /// Specifically it populates the closest_distance_to_camera field for nearest plane calculation.
-        void AppendFrustumCulledInstanceMap(renderer::InstanceMap& instance_map, renderer::FrustumInfo& frustum_info) const;
+        /// @param [inout] tree The tree to fill in.
+        /// @param [in] node_index The index of the tree node already allocated for this node.
+        void AppendToFrustumCullTree(FrustumCullTree& tree, uint32_t node_index) const;
 
         /// @brief Recursively adds the render data to the instance map.
         ///
@@ -60,16 +108,40 @@ namespace rra
         /// @brief Construct the tree structure from BLAS.
         ///
         /// @param [in] blas_index The blas index.
+        /// @param [in] max_depth The deepest nodes to construct. Box nodes at this depth are left without children.
+        /// @param [in] cancelled If this is set while constructing, the rest of the tree is skipped. May be nullptr.
         ///
         /// @returns A scene node.
-        static SceneNode* ConstructFromBlas(uint32_t blas_index);
+        static SceneNode* ConstructFromBlas(uint32_t blas_index, uint32_t max_depth = UINT32_MAX, const std::atomic<bool>* cancelled = nullptr);
+
+        /// @brief Gather the data for every instance in a TLAS.
+        ///
+        /// @param [in] tlas_index The tlas index.
+        /// @param [out] instance_nodes The instance data for each instance node in the TLAS.
+        static void GetTlasInstanceNodes(uint64_t tlas_index, InstanceNodeMap& instance_nodes);
 
         /// @brief Construct the tree structure from TLAS.
         ///
         /// @param [in] tlas_index The tlas index.
+        /// @param [in] instance_nodes The instance data for each instance node in the TLAS.
+        /// @param [in] max_depth The deepest nodes to construct. Box nodes at this depth are left without children.
+        /// @param [in] cancelled If this is set while constructing, the rest of the tree is skipped. May be nullptr.
+        ///
+        /// @returns A scene node.
+        static SceneNode* ConstructFromTlas(uint64_t                 tlas_index,
+                                            const InstanceNodeMap&   instance_nodes,
+                                            uint32_t                 max_depth = UINT32_MAX,
+                                            const std::atomic<bool>* cancelled = nullptr);
+
+        /// @brief Construct a flat tree from TLAS, with every instance node directly below the root.
+        ///
+        /// This is much quicker to construct than the full tree, so it can be shown while the full tree is constructed.
+        ///
+        /// @param [in] tlas_index The tlas index.
+        /// @param [in] instance_nodes The instance data for each instance node in the TLAS.
         ///
         /// @returns A scene node.
-        static SceneNode* ConstructFromTlas(uint64_t tlas_index);
+        static SceneNode* ConstructInstancesFromTlas(uint64_t tlas_index, const InstanceNodeMap& instance_nodes);
 
         /// @brief Get bounds for selection.
         ///
@@ -175,6 +247,11 @@ namespace rra
         /// @returns The parent of the node.
         SceneNode* GetParent() const;
 
+        /// @brief Get the sibling overlap score of this node.
+        ///
+        /// @returns One minus the sibling overlap area of the parent box node, so 1 means no overlap.
+        float GetSiblingOverlapScore() const;
+
         /// @brief Adds nodes recursively to the traversal tree.
         ///
         /// @param [out] node_to_address_map The mapping from node_id to the address that will end up in the tree.
@@ -189,31 +266,42 @@ namespace rra
         /// @param [in] tlas_index The tlas index.
         /// @param [in] box_index The box index under this tlas.
         /// @param [in] depth The current depth for this node.
+        /// @param [in] instance_nodes The instance data for each instance node in the TLAS.
+        /// @param [in] max_depth The deepest nodes to construct.
+        /// @param [in] cancelled If this is set while constructing, the rest of the tree is skipped. May be nullptr.
         ///
         /// @returns A scene node.
-        static SceneNode* ConstructFromTlasBoxNode(uint64_t tlas_index, uint32_t box_index, uint32_t depth);
+        static SceneNode* ConstructFromTlasBoxNode(uint64_t                 tlas_index,
+                                                   uint32_t                 box_index,
+                                                   uint32_t                 depth,
+                                                   const InstanceNodeMap&   instance_nodes,
+                                                   uint32_t                 max_depth,
+                                                   const std::atomic<bool>* cancelled);
 
         /// @brief Construct the tree structure from BLAS.
         ///
         /// @param [in] blas_index The blas index.
         /// @param [in] node_id The box index under this blas.
         /// @param [in] depth The current depth for this node.
+        /// @param [in] max_depth The deepest nodes to construct.
+        /// @param [in] cancelled If this is set while constructing, the rest of the tree is skipped. May be nullptr.
         ///
         /// @returns A scene node.
-        static SceneNode* ConstructFromBlasNode(uint64_t blas_index, uint32_t node_id, uint32_t depth);
-
-        SceneNode*                       parent_ = nullptr;         ///< The parent node.
-        uint32_t                         node_id_;                  ///< The node id for this node.
-        uint32_t                         depth_           = 0;      ///< The depth of this node.
-        bool                             enabled_         = true;   ///< A flag to represent enablement of this node.
-        bool                             visible_         = true;   ///< A flag to represent the visibility of this node.
-        bool                             selected_        = false;  ///< A flag to represent if this node is selected.
-        BoundingVolumeExtents            bounding_volume_ = {};     ///< The bounding volume of this node.
-        std::vector<SceneNode*>          child_nodes_;              ///< The child nodes of this node.
-        std::vector<renderer::Instance>  instances_;                ///< The instances that this node contains.
-        std::vector<renderer::RraVertex> vertices_;                 ///< The vertices that this node contains. Aligned by 3.
-        uint32_t                         primitive_index_ = 0;      ///< The primitive index of this node.
-        uint32_t                         geometry_index_  = 0;      ///< The geometry index of this node.
+        static SceneNode* ConstructFromBlasNode(uint64_t blas_index, uint32_t node_id, uint32_t depth, uint32_t max_depth, const std::atomic<bool>* cancelled);
+
+        SceneNode*                       parent_ = nullptr;               ///< The parent node.
+        uint32_t                         node_id_;                        ///< The node id for this node.
+        uint32_t                         depth_                 = 0;      ///< The depth of this node.
+        bool                             enabled_               = true;   ///< A flag to represent enablement of this node.
+        bool                             visible_               = true;   ///< A flag to represent the visibility of this node.
+        bool                             selected_              = false;  ///< A flag to represent if this node is selected.
+        BoundingVolumeExtents            bounding_volume_       = {};     ///< The bounding volume of this node.
+        std::vector<SceneNode*>          child_nodes_;                    ///< The child nodes of this node.
+        std::vector<renderer::Instance>  instances_;                      ///< The instances that this node contains.
+        std::vector<renderer::RraVertex> vertices_;                       ///< The vertices that this node contains. Aligned by 3.
+        uint32_t                         primitive_index_       = 0;      ///< The primitive index of this node.
+        uint32_t                         geometry_index_        = 0;      ///< The geometry index of this node.
+        float                            sibling_overlap_score_ = 1.0f;   ///< One minus the sibling overlap area of the parent box node.
     };
 
 }  // namespace rra
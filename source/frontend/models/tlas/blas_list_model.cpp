@@ -49,14 +49,33 @@ namespace rra
             return;
         }
 
+        // Count the instances of each BLAS from the BLAS index column of the instance table.
+        std::vector<uint64_t> instance_counts(blas_count, 0);
+        uint64_t              instance_row_count = 0;
+        if (RraTlasGetInstanceTableRowCount(tlas_index, &instance_row_count) == kRraOk && instance_row_count > 0)
+        {
+            std::vector<uint64_t> instance_blas_indices(instance_row_count);
+            RraTlasInstanceTable  instance_table = {};
+            instance_table.blas_index            = instance_blas_indices.data();
+
+            if (RraTlasGetInstanceTable(tlas_index, 0, &instance_table) == kRraOk)
+            {
+                for (uint64_t instance_blas_index : instance_blas_indices)
+                {
+                    if (instance_blas_index < blas_count)
+                    {
+                        instance_counts[instance_blas_index]++;
+                    }
+                }
+            }
+        }
+
         uint64_t row_count = 0;
 
         // Don't include any empty BLASes or BLASes that aren't referenced (0 instances).
         for (int blas_index = 0; blas_index < blas_count; blas_index++)
         {
-            uint64_t instance_count = 0;
-            RraTlasGetInstanceCount(tlas_index, blas_index, &instance_count);
-            if (!RraBlasIsEmpty(blas_index) && instance_count > 0)
+            if (!RraBlasIsEmpty(blas_index) && instance_counts[blas_index] > 0)
             {
                 row_count++;
             }
@@ -68,10 +87,7 @@ namespace rra
         uint64_t           rows_added = 0;
         for (int blas_index = 0; blas_index < blas_count; blas_index++)
         {
-            if (RraTlasGetInstanceCount(tlas_index, blas_index, &stats.instance_count) != kRraOk)
-            {
-                continue;
-            }
+            stats.instance_count = instance_counts[blas_index];
             if (stats.instance_count == 0)
             {
                 continue;
@@ -51,23 +51,11 @@ namespace rra
             SetModelData(kTlasInstancesTlasBaseAddress, address_string);
         }
 
-        // Get blas count to iterate over each.
-        uint64_t blas_count = 0;
-        if (RraBvhGetTotalBlasCount(&blas_count) != kRraOk || blas_count == 0)
-        {
-            return false;
-        }
-
         // Get the total instance count to allocate.
         uint64_t total_instance_count = 0;
-        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        if (RraTlasGetInstanceTableRowCount(tlas_index, &total_instance_count) != kRraOk)
         {
-            uint64_t instance_count = 0;
-            if (RraTlasGetInstanceCount(tlas_index, blas_index, &instance_count) != kRraOk)
-            {
-                return false;
-            }
-            total_instance_count += instance_count;
+            return false;
         }
 
         if (total_instance_count == 0)
@@ -76,62 +64,48 @@ namespace rra
             return false;
         }
 
+        // Fetch the columns needed by the table in a single call.
+        std::vector<uint64_t> blas_indices(total_instance_count);
+        std::vector<uint64_t> blas_instance_indices(total_instance_count);
+        std::vector<uint32_t> instance_indices(total_instance_count);
+        std::vector<uint64_t> instance_addresses(total_instance_count);
+        std::vector<uint64_t> instance_offsets(total_instance_count);
+        std::vector<float>    transforms(total_instance_count * 12);
+        std::vector<uint32_t> masks(total_instance_count);
+
+        RraTlasInstanceTable instance_table = {};
+        instance_table.blas_index           = blas_indices.data();
+        instance_table.blas_instance_index  = blas_instance_indices.data();
+        instance_table.instance_index       = instance_indices.data();
+        instance_table.instance_address     = instance_addresses.data();
+        instance_table.instance_offset      = instance_offsets.data();
+        instance_table.original_transform   = transforms.data();
+        instance_table.mask                 = masks.data();
+
+        if (RraTlasGetInstanceTable(tlas_index, 0, &instance_table) != kRraOk)
+        {
+            return false;
+        }
+
         table_model_->SetRowCount(total_instance_count);
 
-        // Iterate over each blas and each instance to gather data.
         TlasInstancesStatistics stats      = {};
         uint64_t                rows_added = 0;
 
         addressable_instance_index_.clear();
 
-        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        for (uint64_t row = 0; row < total_instance_count; row++)
         {
-            uint64_t instance_count = 0;
-            if (RraTlasGetInstanceCount(tlas_index, blas_index, &instance_count) != kRraOk)
-            {
-                return false;
-            }
-
-            for (uint64_t instance_index = 0; instance_index < instance_count; instance_index++)
-            {
-                uint32_t node_ptr = 0;
-                if (RraTlasGetInstanceNode(tlas_index, blas_index, instance_index, &node_ptr) != kRraOk)
-                {
-                    continue;
-                }
-
-                if (RraTlasGetInstanceIndexFromInstanceNode(tlas_index, node_ptr, &stats.instance_index))
-                {
-                    continue;
-                }
-
-                if (RraTlasGetNodeBaseAddress(tlas_index, node_ptr, &stats.instance_address) != kRraOk)
-                {
-                    continue;
-                }
-
-                if (RraBvhGetNodeOffset(node_ptr, &stats.instance_offset) != kRraOk)
-                {
-                    continue;
-                }
-
-                if (RraTlasGetOriginalInstanceNodeTransform(tlas_index, node_ptr, reinterpret_cast<float*>(&stats.transform)) != kRraOk)
-                {
-                    continue;
-                }
-
-                uint32_t instance_mask{};
-                if (RraTlasGetInstanceNodeMask(tlas_index, node_ptr, &instance_mask) != kRraOk)
-                {
-                    continue;
-                }
-                stats.instance_mask = instance_mask;
-
-                addressable_instance_index_[rows_added] = {blas_index, instance_index};
-
-                table_model_->AddAccelerationStructure(stats);
-                rows_added++;
-            }
+            stats.instance_index   = instance_indices[row];
+            stats.instance_address = instance_addresses[row];
+            stats.instance_offset  = instance_offsets[row];
+            stats.instance_mask    = masks[row];
+            memcpy(stats.transform, &transforms[row * 12], sizeof(stats.transform));
+
+            addressable_instance_index_[rows_added] = {blas_indices[row], blas_instance_indices[row]};
+
+            table_model_->AddAccelerationStructure(stats);
+            rows_added++;
         }
 
         Q_ASSERT(rows_added == total_instance_count);
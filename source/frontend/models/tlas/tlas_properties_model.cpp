@@ -11,7 +11,9 @@
 #include "public/rra_blas.h"
 #include "public/rra_tlas.h"
 
+#include "constants.h"
 #include "util/string_util.h"
+#include "settings/settings.h"
 
 namespace rra
 {
@@ -44,6 +46,11 @@ namespace rra
 
         SetModelData(kTlasPropertiesMemoryTlas, "-");
         SetModelData(kTlasPropertiesMemoryTotal, "-");
+
+        SetModelData(kTlasPropertiesMeanOverlapArea, "-");
+        SetModelData(kTlasPropertiesOverlapAreaHistogram, "-");
+        SetModelData(kTlasPropertiesMeanOverlapVolume, "-");
+        SetModelData(kTlasPropertiesOverlapVolumeHistogram, "-");
     }
 
     void TlasPropertiesModel::Update(uint64_t tlas_index)
@@ -123,6 +130,25 @@ namespace rra
         {
             SetModelData(kTlasPropertiesMemoryTotal, rra::string_util::LocalizedValueMemory(static_cast<double>(total_memory), false, true));
         }
+
+        RraBvhOverlapStats overlap = {};
+        if (RraTlasGetOverlapStats(tlas_index, &overlap) == kRraOk)
+        {
+            int decimal_precision = rra::Settings::Get().GetDecimalPrecision();
+
+            SetModelData(kTlasPropertiesMeanOverlapArea,
+                         QString::number(overlap.mean_overlap_area, kQtFloatFormat, decimal_precision),
+                         QString::number(overlap.mean_overlap_area, kQtFloatFormat, kQtTooltipFloatPrecision));
+            SetModelData(kTlasPropertiesOverlapAreaHistogram,
+                         rra::string_util::GetHistogramString(overlap.overlap_area_histogram, kRraBvhOverlapHistogramBinCount),
+                         rra::string_util::GetHistogramTooltip(overlap.overlap_area_histogram, kRraBvhOverlapHistogramBinCount));
+            SetModelData(kTlasPropertiesMeanOverlapVolume,
+                         QString::number(overlap.mean_overlap_volume, kQtFloatFormat, decimal_precision),
+                         QString::number(overlap.mean_overlap_volume, kQtFloatFormat, kQtTooltipFloatPrecision));
+            SetModelData(kTlasPropertiesOverlapVolumeHistogram,
+                         rra::string_util::GetHistogramString(overlap.overlap_volume_histogram, kRraBvhOverlapHistogramBinCount),
+                         rra::string_util::GetHistogramTooltip(overlap.overlap_volume_histogram, kRraBvhOverlapHistogramBinCount));
+        }
     }
 
 }  // namespace rra
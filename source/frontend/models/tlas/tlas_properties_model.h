@@ -35,6 +35,11 @@ namespace rra
         kTlasPropertiesMemoryTlas,
         kTlasPropertiesMemoryTotal,
 
+        kTlasPropertiesMeanOverlapArea,
+        kTlasPropertiesOverlapAreaHistogram,
+        kTlasPropertiesMeanOverlapVolume,
+        kTlasPropertiesOverlapVolumeHistogram,
+
         kTlasPropertiesNumWidgets,
     };
 
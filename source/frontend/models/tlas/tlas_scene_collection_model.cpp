@@ -7,6 +7,8 @@
 
 #include "models/tlas/tlas_scene_collection_model.h"
 
+#include <memory>
+
 #include "qt_common/utils/qt_util.h"
 
 #include "public/rra_assert.h"
@@ -23,6 +25,7 @@ namespace rra
 {
     TlasSceneCollectionModel::~TlasSceneCollectionModel()
     {
+        scene_builder_.Cancel();
         for (auto scene_iter = tlas_scenes_.begin(); scene_iter != tlas_scenes_.end(); ++scene_iter)
         {
             delete scene_iter->second;
@@ -74,11 +77,21 @@ namespace rra
         // Create a scene.
         Scene* tlas_scene = new Scene{};
 
-        // Construct a tree by using the blas_index
-        auto tlas_root_node = SceneNode::ConstructFromTlas(tlas_index);
-
-        // Initialize the scene with the given node.
-        tlas_scene->Initialize(tlas_root_node);
+        // Start with just the root node, so the scene can be shown straight away.
+        tlas_scene->Initialize(SceneNode::ConstructFromTlas(tlas_index, {}, 0), false);
+
+        // Show the instances first, since they are quick to construct, then the full tree once it is done. Only the scene
+        // being viewed is constructed, so starting a new one cancels the last.
+        auto instance_nodes      = std::make_shared<SceneNode::InstanceNodeMap>();
+        auto construct_instances = [tlas_index, instance_nodes](const std::atomic<bool>& cancelled) {
+            Q_UNUSED(cancelled);
+            SceneNode::GetTlasInstanceNodes(tlas_index, *instance_nodes);
+            return SceneNode::ConstructInstancesFromTlas(tlas_index, *instance_nodes);
+        };
+        auto construct_tree = [tlas_index, instance_nodes](const std::atomic<bool>& cancelled) {
+            return SceneNode::ConstructFromTlas(tlas_index, *instance_nodes, UINT32_MAX, &cancelled);
+        };
+        scene_builder_.Start(tlas_scene, {construct_instances, construct_tree});
 
         return tlas_scene;
     }
@@ -200,6 +213,7 @@ namespace rra
 
     void TlasSceneCollectionModel::ResetModelValues()
     {
+        scene_builder_.Cancel();
         for (auto scene_iter = tlas_scenes_.begin(); scene_iter != tlas_scenes_.end(); ++scene_iter)
         {
             delete scene_iter->second;
@@ -10,6 +10,7 @@
 
 #include <map>
 
+#include "../scene_builder.h"
 #include "../scene_collection_model.h"
 
 namespace rra
@@ -78,7 +79,8 @@ namespace rra
         /// @returns The new Scene instance.
         Scene* CreateRenderSceneForTLAS(renderer::RendererInterface* renderer, uint64_t tlas_index);
 
-        std::map<uint64_t, Scene*> tlas_scenes_;  ///< A map of all loaded TLAS scenes.
+        std::map<uint64_t, Scene*> tlas_scenes_;    ///< A map of all loaded TLAS scenes.
+        SceneBuilder               scene_builder_;  ///< Constructs the nodes of the scene being viewed.
     };
 }  // namespace rra
 
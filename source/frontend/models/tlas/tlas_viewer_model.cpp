@@ -79,6 +79,11 @@ namespace rra
         return RraTlasGetChildNodePtr;
     }
 
+    GetParentNodeFunction TlasViewerModel::AccelerationStructureGetParentNodeFunction() const
+    {
+        return RraTlasGetNodeParent;
+    }
+
     uint64_t TlasViewerModel::GetBlasIndex(int tlas_index, const QModelIndex& model_index) const
     {
         uint64_t blas_index = 0;
@@ -125,8 +130,21 @@ namespace rra
         AccelerationStructureViewerModel::SetSelectedNodeIndex(model_index);
         uint32_t node_id = GetNodeIdFromModelIndex(model_index, tlas_index, kIsTlasModel);
 
-        // Show Node name and base address.
-        SetModelData(kTlasStatsType, RraBvhGetNodeName(node_id));
+        // Show Node name and base address. The tooltip of a box node shows how much its children overlap.
+        float overlap_area   = 0.0f;
+        float overlap_volume = 0.0f;
+        if (RraTlasGetSiblingOverlap(tlas_index, node_id, &overlap_area, &overlap_volume) == kRraOk)
+        {
+            SetModelData(kTlasStatsType,
+                         RraBvhGetNodeName(node_id),
+                         QString("Sibling overlap area: %1\nSibling overlap volume: %2")
+                             .arg(QString::number(overlap_area, kQtFloatFormat, kQtTooltipFloatPrecision))
+                             .arg(QString::number(overlap_volume, kQtFloatFormat, kQtTooltipFloatPrecision)));
+        }
+        else
+        {
+            SetModelData(kTlasStatsType, RraBvhGetNodeName(node_id), "");
+        }
 
         uint64_t           node_address = 0;
         RraErrorCode       error_code   = kRraErrorInvalidPointer;
@@ -89,6 +89,11 @@ namespace rra
         /// @return The function pointer.
         virtual GetChildNodeFunction AccelerationStructureGetChildNodeFunction() const override;
 
+        /// @brief Get the function pointer of the function that gets the parent node.
+        ///
+        /// @return The function pointer.
+        virtual GetParentNodeFunction AccelerationStructureGetParentNodeFunction() const override;
+
         /// @brief Get the BLAS index from the TLAS index and instance node data.
         ///
         /// @param [in] tlas_index   The index of the TLAS to use.
@@ -8,6 +8,7 @@
 #include "string_util.h"
 
 #include <cctype>
+#include <QStringList>
 #include <QtMath>
 #include <QTextStream>
 
@@ -149,3 +150,66 @@ QString rra::string_util::GetBuildTypeString(VkBuildAccelerationStructureFlagBit
 
     return QString("Default");
 }
+
+QString rra::string_util::GetTriangleCompressionModeString(RraTriangleCompressionMode mode)
+{
+    switch (mode)
+    {
+    case kRraTriangleCompressionModeNone:
+        return QString("None");
+    case kRraTriangleCompressionModeTwoTriangles:
+        return QString("Two triangles");
+    case kRraTriangleCompressionModePairTriangles:
+        return QString("Pair triangles");
+    case kRraTriangleCompressionModeAutomatic:
+        return QString("Automatic");
+    case kRraTriangleCompressionModeFourTriangles:
+        return QString("Four triangles");
+    default:
+        return QString("Unknown");
+    }
+}
+
+QString rra::string_util::GetBoxFp16ModeString(RraBoxFp16Mode mode)
+{
+    switch (mode)
+    {
+    case kRraBoxFp16ModeNone:
+        return QString("None");
+    case kRraBoxFp16ModeLeafNodesOnly:
+        return QString("Leaf nodes only");
+    case kRraBoxFp16ModeMixedWithFp32:
+        return QString("Mixed with fp32");
+    case kRraBoxFp16ModeAll:
+        return QString("All");
+    default:
+        return QString("Unknown");
+    }
+}
+
+QString rra::string_util::GetHistogramString(const uint32_t* bins, uint32_t bin_count)
+{
+    QStringList counts;
+    for (uint32_t bin = 0; bin < bin_count; bin++)
+    {
+        counts.append(QString::number(bins[bin]));
+    }
+    return counts.join(" ");
+}
+
+QString rra::string_util::GetHistogramTooltip(const uint32_t* bins, uint32_t bin_count)
+{
+    QStringList lines;
+    for (uint32_t bin = 0; bin < bin_count; bin++)
+    {
+        const float bin_start = static_cast<float>(bin) / bin_count;
+        const float bin_end   = static_cast<float>(bin + 1) / bin_count;
+        QString     range     = QString::number(bin_start, 'f', 1) + " - " + QString::number(bin_end, 'f', 1);
+        if (bin + 1 == bin_count)
+        {
+            range += " and above";
+        }
+        lines.append(range + ": " + rra::string_util::LocalizedValue(bins[bin]));
+    }
+    return lines.join("\n");
+}
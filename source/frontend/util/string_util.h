@@ -14,6 +14,8 @@
 
 #include "vulkan/include/vulkan/vulkan_core.h"
 
+#include "public/rra_compression_analysis.h"
+
 namespace rra
 {
     namespace string_util
@@ -75,6 +77,38 @@ namespace rra
         /// @return String describing the build type.
         QString GetBuildTypeString(VkBuildAccelerationStructureFlagBitsKHR build_flags);
 
+        /// @brief Get the name of a triangle compression mode.
+        ///
+        /// @param [in] mode The triangle compression mode.
+        ///
+        /// @return String describing the mode.
+        QString GetTriangleCompressionModeString(RraTriangleCompressionMode mode);
+
+        /// @brief Get the name of an fp16 box node mode.
+        ///
+        /// @param [in] mode The fp16 box node mode.
+        ///
+        /// @return String describing the mode.
+        QString GetBoxFp16ModeString(RraBoxFp16Mode mode);
+
+        /// @brief Get the bin counts of a histogram over [0, 1], separated by spaces.
+        ///
+        /// @param [in] bins      The bin counts.
+        /// @param [in] bin_count The number of bins.
+        ///
+        /// @return The bin counts.
+        QString GetHistogramString(const uint32_t* bins, uint32_t bin_count);
+
+        /// @brief Get a tooltip listing the range and count of each bin of a histogram over [0, 1].
+        ///
+        /// The last bin also counts the values above 1.
+        ///
+        /// @param [in] bins      The bin counts.
+        /// @param [in] bin_count The number of bins.
+        ///
+        /// @return The tooltip, with a line per bin.
+        QString GetHistogramTooltip(const uint32_t* bins, uint32_t bin_count);
+
     }  // namespace string_util
 }  // namespace rra
 
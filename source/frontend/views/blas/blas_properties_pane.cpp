@@ -45,6 +45,24 @@ BlasPropertiesPane::BlasPropertiesPane(QWidget* parent)
     model_->InitializeModel(ui_->content_max_depth_, rra::kBlasPropertiesMaxDepth, "text");
     model_->InitializeModel(ui_->content_mean_depth_, rra::kBlasPropertiesAvgDepth, "text");
 
+    model_->InitializeModel(ui_->content_triangle_compression_mode_, rra::kBlasPropertiesTriangleCompressionMode, "text");
+    model_->InitializeModel(ui_->content_shared_edge_pairs_, rra::kBlasPropertiesSharedEdgePairs, "text");
+    model_->InitializeModel(ui_->content_pair_compression_ratio_, rra::kBlasPropertiesPairCompressionRatio, "text");
+    model_->InitializeModel(ui_->content_uncompressed_leaf_size_, rra::kBlasPropertiesUncompressedLeafSize, "text");
+    model_->InitializeModel(ui_->content_pair_compressed_leaf_size_, rra::kBlasPropertiesPairCompressedLeafSize, "text");
+    model_->InitializeModel(ui_->content_box_fp16_mode_, rra::kBlasPropertiesBoxFp16Mode, "text");
+    model_->InitializeModel(ui_->content_fp16_representable_nodes_, rra::kBlasPropertiesFp16RepresentableNodes, "text");
+    model_->InitializeModel(ui_->content_fp32_interior_size_, rra::kBlasPropertiesFp32InteriorSize, "text");
+    model_->InitializeModel(ui_->content_mixed_fp16_interior_size_, rra::kBlasPropertiesMixedFp16InteriorSize, "text");
+    model_->InitializeModel(ui_->content_all_fp16_interior_size_, rra::kBlasPropertiesAllFp16InteriorSize, "text");
+
+    model_->InitializeModel(ui_->content_mean_overlap_area_, rra::kBlasPropertiesMeanOverlapArea, "text");
+    model_->InitializeModel(ui_->content_overlap_area_histogram_, rra::kBlasPropertiesOverlapAreaHistogram, "text");
+    model_->InitializeModel(ui_->content_mean_overlap_volume_, rra::kBlasPropertiesMeanOverlapVolume, "text");
+    model_->InitializeModel(ui_->content_overlap_volume_histogram_, rra::kBlasPropertiesOverlapVolumeHistogram, "text");
+    model_->InitializeModel(ui_->content_mean_leaf_tightness_, rra::kBlasPropertiesMeanLeafTightness, "text");
+    model_->InitializeModel(ui_->content_leaf_tightness_histogram_, rra::kBlasPropertiesLeafTightnessHistogram, "text");
+
     connect(&rra::MessageManager::Get(), &rra::MessageManager::BlasSelected, this, &BlasPropertiesPane::SetBlasIndex);
     connect(&rra::MessageManager::Get(), &rra::MessageManager::TlasSelected, this, &BlasPropertiesPane::SetTlasIndex);
 }
@@ -7,9 +7,11 @@
 
 #include "views/blas/blas_triangles_pane.h"
 
+#include "constants.h"
 #include "managers/message_manager.h"
 #include "models/blas/blas_triangles_model.h"
 #include "models/blas/blas_triangles_table_item_delegate.h"
+#include "views/custom_widgets/colored_checkbox.h"
 #include "views/widget_util.h"
 
 BlasTrianglesPane::BlasTrianglesPane(QWidget* parent)
@@ -31,6 +33,12 @@ BlasTrianglesPane::BlasTrianglesPane(QWidget* parent)
     model_->InitializeTableModel(ui_->triangles_table_, 0, rra::kBlasTrianglesColumnCount);
 
     connect(ui_->search_box_, &QLineEdit::textChanged, model_, &rra::BlasTrianglesModel::SearchTextChanged);
+
+    ui_->problem_triangles_only_checkbox_->Initialize(false, rra::kCheckboxEnableColor);
+    connect(ui_->problem_triangles_only_checkbox_, &ColoredCheckbox::Clicked, [=]() {
+        model_->ProblemTrianglesOnlyChanged(ui_->problem_triangles_only_checkbox_->isChecked());
+    });
+
     connect(ui_->triangles_table_, &QAbstractItemView::doubleClicked, [=](const QModelIndex& index) { this->SelectTriangleInBlasViewer(index, true); });
     connect(ui_->triangles_table_, &QAbstractItemView::clicked, [=](const QModelIndex& index) { this->SelectTriangleInBlasViewer(index, false); });
     connect(&rra::MessageManager::Get(), &rra::MessageManager::BlasSelected, this, &BlasTrianglesPane::SetBlasIndex);
@@ -123,6 +131,8 @@ void BlasTrianglesPane::OnTraceClose()
     tlas_index_       = 0;
     triangle_node_id_ = UINT32_MAX;
     ui_->search_box_->setText("");
+    ui_->problem_triangles_only_checkbox_->setChecked(false);
+    model_->ProblemTrianglesOnlyChanged(false);
 }
 
 bool BlasTrianglesPane::eventFilter(QObject* obj, QEvent* event)
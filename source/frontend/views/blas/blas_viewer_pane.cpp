@@ -59,6 +59,9 @@ BlasViewerPane::BlasViewerPane(QWidget* parent)
     model_->InitializeModel(ui_->content_current_sah_, rra::kBlasStatsCurrentSAH, "text");
     model_->InitializeModel(ui_->content_subtree_min_, rra::kBlasStatsSAHSubTreeMax, "text");
     model_->InitializeModel(ui_->content_subtree_mean_, rra::kBlasStatsSAHSubTreeMean, "text");
+    model_->InitializeModel(ui_->content_sibling_overlap_area_, rra::kBlasStatsSiblingOverlapArea, "text");
+    model_->InitializeModel(ui_->content_sibling_overlap_volume_, rra::kBlasStatsSiblingOverlapVolume, "text");
+    model_->InitializeModel(ui_->content_leaf_tightness_, rra::kBlasStatsLeafTightness, "text");
     model_->InitializeModel(ui_->content_primitive_index_, rra::kBlasStatsPrimitiveIndex, "text");
     model_->InitializeModel(ui_->content_geometry_index_, rra::kBlasStatsGeometryIndex, "text");
     model_->InitializeModel(ui_->content_parent_blas_, rra::kBlasStatsParent, "text");
@@ -17,6 +17,7 @@
 #include "qt_common/utils/qt_util.h"
 #include "qt_common/utils/scaling_manager.h"
 
+#include "public/rra_export.h"
 #include "public/rra_trace_loader.h"
 
 #include "managers/load_animation_manager.h"
@@ -49,6 +50,7 @@ MainWindow::MainWindow(QWidget* parent)
     , file_menu_(nullptr)
     , open_trace_action_(nullptr)
     , close_trace_action_(nullptr)
+    , export_action_(nullptr)
     , exit_action_(nullptr)
     , help_action_(nullptr)
     , about_action_(nullptr)
@@ -338,6 +340,10 @@ void MainWindow::CreateActions()
     connect(close_trace_action_, &QAction::triggered, this, &MainWindow::CloseTrace);
     close_trace_action_->setDisabled(true);
 
+    export_action_ = new QAction(tr("Export statistics..."), this);
+    connect(export_action_, &QAction::triggered, this, &MainWindow::ExportStatisticsFromFileMenu);
+    export_action_->setDisabled(true);
+
     exit_action_ = new QAction(tr("Exit"), this);
     exit_action_->setShortcut(Qt::ALT | Qt::Key_F4);
     connect(exit_action_, &QAction::triggered, this, &MainWindow::CloseTool);
@@ -393,6 +399,8 @@ void MainWindow::CreateMenus()
     file_menu_->addAction(open_trace_action_);
     file_menu_->addAction(close_trace_action_);
     file_menu_->addSeparator();
+    file_menu_->addAction(export_action_);
+    file_menu_->addSeparator();
     file_menu_->addMenu(recent_traces_menu_);
     file_menu_->addSeparator();
     file_menu_->addAction(exit_action_);
@@ -412,6 +420,7 @@ void MainWindow::LoadTrace(const QString& trace_file)
 void MainWindow::OpenTrace()
 {
     close_trace_action_->setDisabled(false);
+    export_action_->setDisabled(false);
 
     ui_->main_tab_widget_->setTabEnabled(rra::kMainPaneOverview, true);
     ui_->main_tab_widget_->setTabEnabled(rra::kMainPaneTlas, true);
@@ -453,6 +462,20 @@ void MainWindow::OpenTraceFromFileMenu()
     }
 }
 
+void MainWindow::ExportStatisticsFromFileMenu()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, "Export statistics", rra::Settings::Get().GetLastFileOpenLocation());
+
+    if (!directory.isNull())
+    {
+        if (RraExportStatistics(directory.toStdString().c_str()) != kRraOk)
+        {
+            const QString text = rra::text::kExportStatisticsFailedText + directory;
+            QtCommon::QtUtils::ShowMessageBox(this, QMessageBox::Ok, QMessageBox::Critical, rra::text::kExportStatisticsFailedTitle, text);
+        }
+    }
+}
+
 void MainWindow::CloseTrace()
 {
     pane_manager_.OnTraceClose();
@@ -462,6 +485,7 @@ void MainWindow::CloseTrace()
 
     rra::NavigationManager::Get().Reset();
     close_trace_action_->setDisabled(true);
+    export_action_->setDisabled(true);
     UpdateTitlebar();
     setWindowTitle(GetTitleBarString());
 }
@@ -83,6 +83,12 @@ public slots:
     /// the user chooses.
     void OpenTraceFromFileMenu();
 
+    /// @brief Export the statistics of the open trace via the file menu.
+    ///
+    /// Present the user with a directory selection dialog box and write the
+    /// statistics column files to the directory the user chooses.
+    void ExportStatisticsFromFileMenu();
+
     /// @brief Populate recent files menu/list.
     void SetupRecentTracesMenu();
 
@@ -192,6 +198,7 @@ private:
     QMenu*   file_menu_;           ///< File menu control.
     QAction* open_trace_action_;   ///< Action to open an RRA trace.
     QAction* close_trace_action_;  ///< Action to close an RRA trace.
+    QAction* export_action_;       ///< Action to export the statistics of an RRA trace.
     QAction* exit_action_;         ///< Action to exit RRA.
     QAction* help_action_;         ///< Action to display help.
     QAction* about_action_;        ///< Action to display About Information.
@@ -38,6 +38,11 @@ TlasPropertiesPane::TlasPropertiesPane(QWidget* parent)
     model_->InitializeModel(ui_->content_memory_tlas_, rra::kTlasPropertiesMemoryTlas, "text");
     model_->InitializeModel(ui_->content_memory_total_, rra::kTlasPropertiesMemoryTotal, "text");
 
+    model_->InitializeModel(ui_->content_mean_overlap_area_, rra::kTlasPropertiesMeanOverlapArea, "text");
+    model_->InitializeModel(ui_->content_overlap_area_histogram_, rra::kTlasPropertiesOverlapAreaHistogram, "text");
+    model_->InitializeModel(ui_->content_mean_overlap_volume_, rra::kTlasPropertiesMeanOverlapVolume, "text");
+    model_->InitializeModel(ui_->content_overlap_volume_histogram_, rra::kTlasPropertiesOverlapVolumeHistogram, "text");
+
     connect(&rra::MessageManager::Get(), &rra::MessageManager::TlasSelected, this, &TlasPropertiesPane::SetTlasIndex);
 }
 
@@ -137,6 +137,11 @@ namespace rra
             UpdateProjectionMatrix();
         }
 
+        float Camera::GetNearClipScale() const
+        {
+            return near_scale_;
+        }
+
         void Camera::SetNearClipMultiplier(float near_clip_multiplier)
         {
             near_multiplier_ = near_clip_multiplier;
@@ -0,0 +1,225 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the compact mesh.
+//=============================================================================
+
+#include "public/compact_mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "public/rra_assert.h"
+
+namespace rra
+{
+    namespace renderer
+    {
+        /// @brief The largest value of a 16 bit quantized position.
+        static const float kQuantizedPositionMax = 65535.0f;
+
+        /// @brief The largest value of a 16 bit snorm.
+        static const float kSnormMax = 32767.0f;
+
+        /// @brief Get the sign of a value, treating zero as positive.
+        ///
+        /// @param [in] value The value.
+        ///
+        /// @returns 1.0 or -1.0.
+        static float SignNotZero(float value)
+        {
+            return (value >= 0.0f) ? 1.0f : -1.0f;
+        }
+
+        /// @brief Pack a value in [-1, 1] into a 16 bit snorm.
+        ///
+        /// @param [in] value The value to pack.
+        ///
+        /// @returns The snorm in the low 16 bits.
+        static uint32_t PackSnorm16(float value)
+        {
+            int32_t snorm = static_cast<int32_t>(std::round(std::min(std::max(value, -1.0f), 1.0f) * kSnormMax));
+            return static_cast<uint32_t>(snorm) & 0xFFFF;
+        }
+
+        /// @brief Unpack a 16 bit snorm into a value in [-1, 1].
+        ///
+        /// @param [in] packed The snorm in the low 16 bits.
+        ///
+        /// @returns The unpacked value.
+        static float UnpackSnorm16(uint32_t packed)
+        {
+            int16_t snorm = static_cast<int16_t>(packed & 0xFFFF);
+            return std::max(static_cast<float>(snorm) / kSnormMax, -1.0f);
+        }
+
+        /// @brief Quantize a position on one axis.
+        ///
+        /// @param [in] value The position on the axis.
+        /// @param [in] origin The origin of the axis.
+        /// @param [in] extent The extent of the bounds on the axis.
+        ///
+        /// @returns The quantized position. A position that is not finite is quantized to the origin.
+        static uint16_t QuantizeAxis(float value, float origin, float extent)
+        {
+            if (!(extent > 0.0f) || !std::isfinite(value))
+            {
+                return 0;
+            }
+
+            // The bounds are taken from the positions, so the clamp only covers rounding in the divide.
+            float normalized = std::min(std::max((value - origin) / extent, 0.0f), 1.0f);
+            return static_cast<uint16_t>(std::round(normalized * kQuantizedPositionMax));
+        }
+
+        uint32_t EncodeOctahedralNormal(const glm::vec3& normal)
+        {
+            float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+
+            // Degenerate triangles have no normal, so they get an arbitrary one.
+            if (!(length > 0.0f) || std::isinf(length))
+            {
+                return PackSnorm16(0.0f) | (PackSnorm16(0.0f) << 16);
+            }
+
+            glm::vec3 n = normal / length;
+
+            // Fold the lower hemisphere over the diagonals onto the outside of the octahedron.
+            float x = n.z >= 0.0f ? n.x : (1.0f - std::abs(n.y)) * SignNotZero(n.x);
+            float y = n.z >= 0.0f ? n.y : (1.0f - std::abs(n.x)) * SignNotZero(n.y);
+
+            return PackSnorm16(x) | (PackSnorm16(y) << 16);
+        }
+
+        glm::vec3 DecodeOctahedralNormal(uint32_t encoded_normal)
+        {
+            glm::vec3 n = glm::vec3(UnpackSnorm16(encoded_normal), UnpackSnorm16(encoded_normal >> 16), 0.0f);
+            n.z         = 1.0f - std::abs(n.x) - std::abs(n.y);
+
+            // Unfold the lower hemisphere.
+            float t = std::max(-n.z, 0.0f);
+            n.x += n.x >= 0.0f ? -t : t;
+            n.y += n.y >= 0.0f ? -t : t;
+
+            return glm::normalize(n);
+        }
+
+        void CompactMesh::Encode(const RraVertex* vertices, size_t vertex_count)
+        {
+            RRA_ASSERT(vertex_count % 3 == 0);
+
+            // Quantize to the bounds of the finite positions, so every finite position is represented to within half a step.
+            glm::vec3 bounds_min = glm::vec3(std::numeric_limits<float>::max());
+            glm::vec3 bounds_max = glm::vec3(-std::numeric_limits<float>::max());
+            for (size_t i = 0; i < vertex_count; i++)
+            {
+                const glm::vec3& position = vertices[i].position;
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    if (std::isfinite(position[axis]))
+                    {
+                        bounds_min[axis] = std::min(bounds_min[axis], position[axis]);
+                        bounds_max[axis] = std::max(bounds_max[axis], position[axis]);
+                    }
+                }
+            }
+
+            // An axis with no finite positions has an empty extent, so it decodes to the origin.
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (bounds_min[axis] > bounds_max[axis])
+                {
+                    bounds_min[axis] = 0.0f;
+                    bounds_max[axis] = 0.0f;
+                }
+            }
+
+            glm::vec3 extent = bounds_max - bounds_min;
+
+            origin_ = bounds_min;
+            scale_  = extent / kQuantizedPositionMax;
+
+            positions_.resize(vertex_count);
+            triangles_.resize(vertex_count / 3);
+
+            for (size_t i = 0; i < vertex_count; i++)
+            {
+                const glm::vec3& position = vertices[i].position;
+                positions_[i].x           = QuantizeAxis(position.x, origin_.x, extent.x);
+                positions_[i].y           = QuantizeAxis(position.y, origin_.y, extent.y);
+                positions_[i].z           = QuantizeAxis(position.z, origin_.z, extent.z);
+            }
+
+            for (size_t i = 0; i < triangles_.size(); i++)
+            {
+                // The attributes are the same for all 3 vertices, so the first one is used.
+                const RraVertex& vertex = vertices[i * 3];
+
+                // Undo the compact normal of the vertex: z is inferred, and x is offset when z is not negative.
+                bool      positive_z = vertex.normal.x > 1.0f;
+                glm::vec3 normal     = glm::vec3(positive_z ? vertex.normal.x - kNormalSignIndicatorOffset : vertex.normal.x, vertex.normal.y, 0.0f);
+                normal.z             = std::sqrt(std::max(1.0f - normal.x * normal.x - normal.y * normal.y, 0.0f));
+                normal.z             = positive_z ? normal.z : -normal.z;
+
+                triangles_[i].triangle_sah_and_selected   = vertex.triangle_sah_and_selected;
+                triangles_[i].normal                      = EncodeOctahedralNormal(normal);
+                triangles_[i].geometry_index_depth_opaque = vertex.geometry_index_depth_opaque;
+                triangles_[i].triangle_node               = vertex.triangle_node;
+            }
+        }
+
+        void CompactMesh::Decode(RraVertex* out_vertices) const
+        {
+            Decode(0, triangles_.size(), out_vertices);
+        }
+
+        void CompactMesh::Decode(size_t first_triangle, size_t triangle_count, RraVertex* out_vertices) const
+        {
+            RRA_ASSERT(first_triangle + triangle_count <= triangles_.size());
+
+            for (size_t i = first_triangle; i < first_triangle + triangle_count; i++)
+            {
+                const CompactTriangleAttributes& triangle = triangles_[i];
+
+                glm::vec3 normal         = DecodeOctahedralNormal(triangle.normal);
+                glm::vec2 compact_normal = glm::vec2(normal.x, normal.y);
+                compact_normal.x         = (normal.z < 0.0f) ? compact_normal.x : compact_normal.x + kNormalSignIndicatorOffset;
+
+                for (size_t corner = 0; corner < 3; corner++)
+                {
+                    size_t                   vertex    = i * 3 + corner;
+                    const QuantizedPosition& quantized = positions_[vertex];
+                    RraVertex&               out       = out_vertices[vertex - first_triangle * 3];
+
+                    out.position                    = origin_ + scale_ * glm::vec3(quantized.x, quantized.y, quantized.z);
+                    out.triangle_sah_and_selected   = triangle.triangle_sah_and_selected;
+                    out.normal                      = compact_normal;
+                    out.geometry_index_depth_opaque = triangle.geometry_index_depth_opaque;
+                    out.triangle_node               = triangle.triangle_node;
+                }
+            }
+        }
+
+        size_t CompactMesh::GetVertexCount() const
+        {
+            return triangles_.size() * 3;
+        }
+
+        size_t CompactMesh::GetTriangleCount() const
+        {
+            return triangles_.size();
+        }
+
+        glm::vec3 CompactMesh::GetQuantizationStep() const
+        {
+            return scale_;
+        }
+
+        size_t CompactMesh::GetMemorySize() const
+        {
+            return positions_.size() * sizeof(QuantizedPosition) + triangles_.size() * sizeof(CompactTriangleAttributes);
+        }
+    }  // namespace renderer
+}  // namespace rra
@@ -0,0 +1,82 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the Frame Scheduler.
+//=============================================================================
+
+#include "public/frame_scheduler.h"
+
+namespace rra
+{
+    namespace renderer
+    {
+        bool FrameState::Equal(const FrameState& other) const
+        {
+            return view_projection == other.view_projection && scene_iteration == other.scene_iteration &&
+                   instance_map_iteration == other.instance_map_iteration && width == other.width && height == other.height;
+        }
+
+        bool FrameScheduler::CheckForNewFrame(const FrameState& state)
+        {
+            bool new_frame = dirty_ || !has_drawn_frame_ || !state.Equal(last_state_);
+
+            if (new_frame)
+            {
+                last_state_            = state;
+                has_drawn_frame_       = true;
+                dirty_                 = false;
+                checks_without_change_ = 0;
+            }
+            else if (checks_without_change_ < kChecksBeforeIdle)
+            {
+                checks_without_change_++;
+            }
+
+            return new_frame;
+        }
+
+        void FrameScheduler::MarkDirty()
+        {
+            bool was_idle = IsIdle();
+
+            dirty_                 = true;
+            checks_without_change_ = 0;
+
+            if (was_idle && wake_callback_ != nullptr)
+            {
+                wake_callback_();
+            }
+        }
+
+        void FrameScheduler::KeepAwake()
+        {
+            bool was_idle = IsIdle();
+
+            checks_without_change_ = 0;
+
+            if (was_idle && wake_callback_ != nullptr)
+            {
+                wake_callback_();
+            }
+        }
+
+        void FrameScheduler::SetWakeCallback(std::function<void()> callback)
+        {
+            wake_callback_ = callback;
+        }
+
+        void FrameScheduler::SetInteracting(bool interacting)
+        {
+            interacting_ = interacting;
+
+            // Keep going for a little while after the interaction ends, to pick up the last of the movement.
+            checks_without_change_ = 0;
+        }
+
+        bool FrameScheduler::IsIdle() const
+        {
+            return !interacting_ && !dirty_ && checks_without_change_ >= kChecksBeforeIdle;
+        }
+    }  // namespace renderer
+}  // namespace rra
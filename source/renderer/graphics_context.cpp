@@ -34,6 +34,12 @@ namespace rra
             vk_graphics_context->SetWindowInfo(window_info);
         }
 
+        void SetGraphicsContextPipelineCacheFile(const std::string& file_path)
+        {
+            auto vk_graphics_context = rra::renderer::GetVkGraphicsContext();
+            vk_graphics_context->GetDevice().SetPipelineCacheFile(file_path);
+        }
+
         bool InitializeGraphicsContext(const GraphicsContextSceneInfo& info)
         {
             auto vk_graphics_context = rra::renderer::GetVkGraphicsContext();
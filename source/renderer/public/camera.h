@@ -100,6 +100,11 @@ namespace rra
             /// @param [in] near_clip The near clip plane distance.
             void SetNearClipScale(float near_clip_scale);
 
+            /// @brief Get the near plane scale.
+            ///
+            /// @returns The near clip plane scale.
+            float GetNearClipScale() const;
+
             /// @brief Set the near plane distance.
             ///
             /// @param [in] near_clip The near clip plane distance.
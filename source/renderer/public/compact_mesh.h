@@ -0,0 +1,117 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Declaration for the compact mesh, a quantized host side format for
+///         BLAS triangle meshes.
+//=============================================================================
+
+#ifndef RRA_RENDERER_COMPACT_MESH_H_
+#define RRA_RENDERER_COMPACT_MESH_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "public/shared.h"
+
+namespace rra
+{
+    namespace renderer
+    {
+        /// @brief A vertex position quantized to 16 bits per axis, relative to the bounds of its mesh.
+        struct QuantizedPosition
+        {
+            uint16_t x;  ///< The quantized x position.
+            uint16_t y;  ///< The quantized y position.
+            uint16_t z;  ///< The quantized z position.
+        };
+
+        /// @brief The attributes shared by the 3 vertices of a triangle, stored once per triangle.
+        struct CompactTriangleAttributes
+        {
+            float    triangle_sah_and_selected;    ///< Absolute value is SAH, positive sign means selected.
+            uint32_t normal;                       ///< The octahedral encoded normal, as two 16 bit snorms.
+            uint32_t geometry_index_depth_opaque;  ///< Bits 31-16 are geometry index, 15-1 are depth, 0 is opaque.
+            uint32_t triangle_node;                ///< The triangle node.
+        };
+
+        /// @brief Encode a normal as an octahedral mapping packed into two 16 bit snorms.
+        ///
+        /// @param [in] normal The normal to encode. Doesn't need to be normalized.
+        ///
+        /// @returns The encoded normal. A zero length normal is encoded as +Z.
+        uint32_t EncodeOctahedralNormal(const glm::vec3& normal);
+
+        /// @brief Decode a normal encoded by EncodeOctahedralNormal.
+        ///
+        /// @param [in] encoded_normal The encoded normal.
+        ///
+        /// @returns The normalized normal.
+        glm::vec3 DecodeOctahedralNormal(uint32_t encoded_normal);
+
+        /// @brief A BLAS triangle mesh held in a compact form until it is uploaded.
+        ///
+        /// The vertices built for a BLAS are a triangle list of RraVertex, where the 3 vertices of a triangle repeat the
+        /// same attributes. The compact mesh stores the positions quantized to the mesh bounds, and the attributes once
+        /// per triangle with an octahedral encoded normal, which takes about a third of the memory. The mesh is decoded
+        /// back into RraVertex when it is written to the GPU, so the shaders see the same vertex format as before.
+        class CompactMesh
+        {
+        public:
+            /// @brief Constructor.
+            CompactMesh() = default;
+
+            /// @brief Destructor.
+            ~CompactMesh() = default;
+
+            /// @brief Encode a triangle list, replacing the current contents of the mesh.
+            ///
+            /// The positions are quantized to their own bounds, so a decoded position is within half a quantization step
+            /// (GetQuantizationStep() / 2) of the original on each axis. Positions that are not finite decode to the origin.
+            ///
+            /// @param [in] vertices The vertices, 3 per triangle.
+            /// @param [in] vertex_count The number of vertices. Must be a multiple of 3.
+            void Encode(const RraVertex* vertices, size_t vertex_count);
+
+            /// @brief Decode the mesh back into a triangle list.
+            ///
+            /// @param [out] out_vertices The decoded vertices. Must have room for GetVertexCount() vertices.
+            void Decode(RraVertex* out_vertices) const;
+
+            /// @brief Decode a range of triangles back into a triangle list, so a mesh can be written out in pieces.
+            ///
+            /// @param [in] first_triangle The first triangle to decode.
+            /// @param [in] triangle_count The number of triangles to decode.
+            /// @param [out] out_vertices The decoded vertices. Must have room for 3 vertices per triangle.
+            void Decode(size_t first_triangle, size_t triangle_count, RraVertex* out_vertices) const;
+
+            /// @brief Get the number of triangles in the mesh.
+            ///
+            /// @returns The triangle count.
+            size_t GetTriangleCount() const;
+
+            /// @brief Get the number of vertices in the mesh.
+            ///
+            /// @returns The vertex count, which is 3 per triangle.
+            size_t GetVertexCount() const;
+
+            /// @brief Get the size of a single quantization step on each axis.
+            ///
+            /// @returns The step size, which is zero on an axis where every position is the same.
+            glm::vec3 GetQuantizationStep() const;
+
+            /// @brief Get the host memory used by the mesh data.
+            ///
+            /// @returns The size in bytes.
+            size_t GetMemorySize() const;
+
+        private:
+            glm::vec3                              origin_ = {};  ///< The position a quantized position of zero maps to.
+            glm::vec3                              scale_  = {};  ///< The size of a single quantization step on each axis.
+            std::vector<QuantizedPosition>         positions_;    ///< The quantized positions, 3 per triangle.
+            std::vector<CompactTriangleAttributes> triangles_;    ///< The per triangle attributes.
+        };
+    }  // namespace renderer
+}  // namespace rra
+
+#endif  // RRA_RENDERER_COMPACT_MESH_H_
@@ -0,0 +1,100 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Declaration for the Frame Scheduler, which decides when a new
+///         frame needs to be drawn.
+//=============================================================================
+
+#ifndef RRA_RENDERER_FRAME_SCHEDULER_H_
+#define RRA_RENDERER_FRAME_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include <functional>
+
+#include "public/renderer_types.h"
+
+namespace rra
+{
+    namespace renderer
+    {
+        /// @brief Everything a drawn frame depends on that can change without the renderer being told.
+        struct FrameState
+        {
+            glm::mat4 view_projection        = glm::mat4(1.0f);  ///< The camera view projection matrix.
+            uint64_t  scene_iteration        = 0;                ///< The scene iteration.
+            uint64_t  instance_map_iteration = 0;                ///< The instance map iteration, which changes when frustum culling finishes.
+            int       width                  = 0;                ///< The viewport width.
+            int       height                 = 0;                ///< The viewport height.
+
+            /// @brief Check if the other state is equal to this.
+            ///
+            /// @param [in] other The other state to check against.
+            ///
+            /// @returns True if equal.
+            bool Equal(const FrameState& other) const;
+        };
+
+        /// @brief Decides when a new frame needs to be drawn, so nothing is drawn while the view is not changing.
+        ///
+        /// A frame is drawn when the frame state differs from the last frame drawn, or when the renderer was marked as
+        /// dirty. While the user is interacting with the view, or for a short while after anything changed, the
+        /// scheduler is busy, and the caller should check for changes at the full frame rate. Otherwise it is idle, and
+        /// the caller can stop checking until the wake callback tells it the scheduler is busy again.
+        ///
+        /// The scheduler isn't thread safe. It must only be used from the UI thread, which draws the frames.
+        class FrameScheduler
+        {
+        public:
+            /// @brief The number of checks without any change before the scheduler becomes idle.
+            static const uint32_t kChecksBeforeIdle = 32;
+
+            /// @brief Constructor.
+            FrameScheduler() = default;
+
+            /// @brief Destructor.
+            ~FrameScheduler() = default;
+
+            /// @brief Check if a new frame needs to be drawn. If so, the state is taken as drawn.
+            ///
+            /// @param [in] state The state the next frame would be drawn with.
+            ///
+            /// @returns True if a new frame needs to be drawn.
+            bool CheckForNewFrame(const FrameState& state);
+
+            /// @brief Make the next check draw a frame, for changes not covered by the frame state.
+            void MarkDirty();
+
+            /// @brief Keep the scheduler busy without drawing a frame, while work running in the background will change the frame state.
+            void KeepAwake();
+
+            /// @brief Set the function called when the scheduler goes from idle to busy.
+            ///
+            /// This is called on the UI thread, from inside MarkDirty() or KeepAwake().
+            ///
+            /// @param [in] callback The function to call, or nullptr for none.
+            void SetWakeCallback(std::function<void()> callback);
+
+            /// @brief Set whether the user is interacting with the view, such as holding a key or mouse button.
+            ///
+            /// @param [in] interacting True while the user is interacting.
+            void SetInteracting(bool interacting);
+
+            /// @brief Check if the scheduler is idle.
+            ///
+            /// @returns True if nothing has changed for a while and the user is not interacting with the view.
+            bool IsIdle() const;
+
+        private:
+            FrameState            last_state_;                                 ///< The state of the last frame drawn.
+            bool                  has_drawn_frame_       = false;              ///< True once a frame has been drawn.
+            bool                  dirty_                 = false;              ///< True if the next check must draw a frame.
+            bool                  interacting_           = false;              ///< True while the user is interacting with the view.
+            uint32_t              checks_without_change_ = kChecksBeforeIdle;  ///< The number of checks since the last change.
+            std::function<void()> wake_callback_         = nullptr;            ///< Called when the scheduler goes from idle to busy.
+        };
+    }  // namespace renderer
+}  // namespace rra
+
+#endif  // RRA_RENDERER_FRAME_SCHEDULER_H_
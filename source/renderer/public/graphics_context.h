@@ -23,6 +23,11 @@ namespace rra
         /// @param [in] window_info The window information for the creation of graphics device, queues, and context.
         void CreateGraphicsContext(QWidget* parent);
 
+        /// @brief Set the file the Vulkan pipeline cache persists to between runs. Note: must be called before InitializeGraphicsContext.
+        ///
+        /// @param [in] file_path The path of the pipeline cache file.
+        void SetGraphicsContextPipelineCacheFile(const std::string& file_path);
+
         /// @brief Initialize the graphics context. Note: must be called after CreateGraphicsContext.
         ///
         /// @returns True if the context was initialized successfully and false in case of failure.
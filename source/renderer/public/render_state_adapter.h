@@ -129,6 +129,13 @@ namespace rra
             /// @returns The coloring mode index.
             int32_t GetGeometryColoringMode() const;
 
+            /// @brief Check if a coloring mode is the one used to color BLAS meshes.
+            ///
+            /// @param [in] coloring_mode The coloring mode.
+            ///
+            /// @returns True if the coloring mode is in use.
+            bool IsGeometryColoringModeActive(GeometryColoringMode coloring_mode) const;
+
             /// @brief Retrieve the list of available coloring modes for the given BVH type flags.
             ///
             /// @param [in] type Flags indicating the BVH types to retrieve valid coloring modes for.
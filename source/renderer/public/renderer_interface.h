@@ -13,7 +13,9 @@
 #include <functional>
 #include "public/heatmap.h"
 #include "public/renderer_types.h"
+#include "public/compact_mesh.h"
 #include "camera.h"
+#include "frame_scheduler.h"
 #include "renderer_adapter.h"
 
 namespace rra
@@ -74,11 +76,14 @@ namespace rra
             TraversalTree traversal_tree;  ///< Traversal tree for traversal compute shader.
 
             // For frustum culling.
-            InstanceMap                         instance_map;             ///< Instance map after frustum culling has been applied.
-            glm::vec3                           closest_point_to_camera;  ///< The location of closest point on geometry to the camera.
-            const std::map<uint64_t, uint32_t>* instance_counts;          ///< Contains the pairs (blas_index, count).
-            Camera*                             camera;                   ///< The camera.
-            glm::mat4                           last_view_proj;           ///< The view projection matrix the camera used on the last frame.
+            InstanceMap                         instance_map;                ///< Instance map after frustum culling has been applied.
+            glm::vec3                           closest_point_to_camera;     ///< The location of closest point on geometry to the camera.
+            const std::map<uint64_t, uint32_t>* instance_counts;             ///< Contains the pairs (blas_index, count).
+            Camera*                             camera;                      ///< The camera.
+            glm::mat4                           last_view_proj;              ///< The view projection matrix the camera used on the last frame.
+            uint64_t                            instance_map_iteration = 0;  ///< Incremented each time the instance map is replaced.
+
+            bool background_work_pending = false;  ///< True while work running in the background, such as culling, will change what is drawn.
         };
 
         /// @brief Info about the scene that is needed at startup.
@@ -88,10 +93,11 @@ namespace rra
         struct GraphicsContextSceneInfo
         {
             // Give graphics context access to traversal tree.
-            TraversalTree         blas_tree;
-            std::vector<uint32_t> traversal_tree_blas_structure_offsets;  ///< The offsets of the traversal tree.
-            std::vector<uint32_t> traversal_tree_blas_triangle_offsets;   ///< The triangle offsets of the traversal tree.
-            std::vector<uint32_t> traversal_tree_blas_triangle_count;     ///< The triangle offsets of the traversal tree.
+            TraversalTree            blas_tree;
+            std::vector<CompactMesh> blas_meshes;                            ///< The triangles of each BLAS, which replace the blas_tree vertices.
+            std::vector<uint32_t>    traversal_tree_blas_structure_offsets;  ///< The offsets of the traversal tree.
+            std::vector<uint32_t>    traversal_tree_blas_triangle_offsets;   ///< The triangle offsets of the traversal tree.
+            std::vector<uint32_t>    traversal_tree_blas_triangle_count;     ///< The triangle offsets of the traversal tree.
         };
 
         /// @brief The RendererInterface class declaration.
@@ -127,7 +133,12 @@ namespace rra
             /// @brief Handle the renderer resizing.
             virtual void HandleDimensionsUpdated() = 0;
 
-            /// @brief Render the scene.
+            /// @brief Process the camera inputs and update the scene info, ready for the next frame.
+            ///
+            /// @returns True if anything changed since the last frame was drawn, so a new frame needs drawing.
+            virtual bool UpdateFrame() = 0;
+
+            /// @brief Render the scene. UpdateFrame() must be called first.
             virtual void DrawFrame() = 0;
 
             /// @brief Mark the scene as dirty.
@@ -154,6 +165,11 @@ namespace rra
             /// @returns A reference to the renderer's camera.
             Camera& GetCamera();
 
+            /// @brief Retrieve a reference to the renderer's frame scheduler.
+            ///
+            /// @returns A reference to the frame scheduler.
+            FrameScheduler& GetFrameScheduler();
+
             /// @brief Set a callback to update info about the scene every frame.
             ///
             /// @param [in] callback The callback function.
@@ -168,6 +184,7 @@ namespace rra
             int               height_;                 ///< The viewport height.
             const WindowInfo* window_info_ = nullptr;  ///< The window info.
             RendererSceneInfo scene_info_  = {};       ///< The scene being rendered.
+            FrameScheduler    frame_scheduler_;        ///< Decides when a new frame needs drawing.
 
             bool     should_update_heatmap_ = false;    ///< The flag to track of heatmap updates.
             Heatmap* heatmap_               = nullptr;  ///< The current heatmap.
@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include <vector>
 #include <map>
+#include <string>
 
 #include "public/shared.h"
 #include "public/rra_bvh.h"
@@ -98,6 +99,8 @@ namespace rra
             uint32_t              mask;                          ///< The instance mask. A mask of 0 means it's totally inactive.
             float                 min_triangle_sah;              ///< The minimum triangle SAH in this instance.
             float                 average_triangle_sah;          ///< The average triangle SAH in this instance.
+            float                 sibling_overlap_score;         ///< One minus the mean sibling overlap area of the referenced blas, so 1 means no overlap.
+            float                 instance_overlap_score;        ///< One minus the instance overlap count relative to the most overlapped instance in the TLAS.
             bool                  selected;                      ///< The flag to indicate if this instance is selected.
             bool                  use_custom_triangles = false;  ///< The flag to indicate that this instance should use custom triangles.
         };
@@ -158,6 +161,9 @@ namespace rra
             kInstanceFacingCullDisableBit,
             kInstanceFlipFacingBit,
             kInstanceForceOpaqueOrNoOpaqueBits,
+            kBlasSiblingOverlap,
+            kInstanceOverlapCount,
+            kTriangleNodeOverlap,
         };
 
         /// @brief Geometry color mode info structure.
@@ -210,20 +216,22 @@ namespace rra
         /// @brief Structure for instance data.
         struct MeshInstanceData
         {
-            glm::mat4x4 instance_transform;    ///< The world space transform.
-            int32_t     instance_index;        ///< The instance index.
-            uint32_t    instance_node;         ///< The instance node.
-            uint32_t    flags;                 ///< The mesh instance flags.
-            uint32_t    instance_count;        ///< The number of instances of the mesh.
-            uint32_t    triangle_count;        ///< The triangle count for the mesh geometry.
-            uint32_t    blas_index;            ///< The BLAS index.
-            uint32_t    max_depth;             ///< The maximum depth.
-            float       average_depth;         ///< The average depth.
-            float       min_triangle_sah;      ///< The minimum triangle SAH in this instance.
-            float       average_triangle_sah;  ///< The average triangle SAH in this instance.
-            glm::vec4   wireframe_metadata;    ///< The wireframe metadata for the instance.
-            uint32_t    build_flags;           ///< The build flags of the referenced blas.
-            uint32_t    mask;                  ///< The instance mask flags.
+            glm::mat4x4 instance_transform;      ///< The world space transform.
+            int32_t     instance_index;          ///< The instance index.
+            uint32_t    instance_node;           ///< The instance node.
+            uint32_t    flags;                   ///< The mesh instance flags.
+            uint32_t    instance_count;          ///< The number of instances of the mesh.
+            uint32_t    triangle_count;          ///< The triangle count for the mesh geometry.
+            uint32_t    blas_index;              ///< The BLAS index.
+            uint32_t    max_depth;               ///< The maximum depth.
+            float       average_depth;           ///< The average depth.
+            float       min_triangle_sah;        ///< The minimum triangle SAH in this instance.
+            float       average_triangle_sah;    ///< The average triangle SAH in this instance.
+            glm::vec4   wireframe_metadata;      ///< The wireframe metadata for the instance.
+            uint32_t    build_flags;             ///< The build flags of the referenced blas.
+            uint32_t    mask;                    ///< The instance mask flags.
+            float       sibling_overlap_score;   ///< One minus the mean sibling overlap area of the referenced blas.
+            float       instance_overlap_score;  ///< One minus the relative instance overlap count.
         };
 
         /// Traversal Rendering
@@ -8,6 +8,7 @@
 #ifndef RRA_RENDERER_RENDERER_WIDGET_H_
 #define RRA_RENDERER_RENDERER_WIDGET_H_
 
+#include <QSet>
 #include <QWidget>
 #include <QTimer>
 
@@ -16,6 +17,8 @@
 /// @brief The Renderer Widget class declaration.
 ///
 /// The Renderer Widget is a custom widget used to display a rendered scene.
+/// New frames are only drawn when something has changed, as decided by the renderer's FrameScheduler, and the
+/// frame timer is stopped while the scheduler is idle.
 class RendererWidget : public QWidget
 {
     Q_OBJECT
@@ -67,6 +70,14 @@ protected:
     /// \returns True if the event was recognized and handled, and false otherwise.
     bool event(QEvent* event) Q_DECL_OVERRIDE;
 
+    /// @brief Override the event filter, which sees the input to the whole application.
+    ///
+    /// @param [in] object The object the event is for.
+    /// @param [in] event  The event data.
+    ///
+    /// \returns True if the event was handled and should go no further, and false otherwise.
+    bool eventFilter(QObject* object, QEvent* event) Q_DECL_OVERRIDE;
+
     /// @brief Override the widget show event handler.
     ///
     /// @param [in] event The show event data.
@@ -162,6 +173,9 @@ private slots:
     /// @brief Render a new frame of the scene.
     void RenderFrame();
 
+    /// @brief Start checking for changes at the full frame rate again, if the timer was stopped while idle.
+    void WakeFrames();
+
 private:
     /// @brief Initialize the widget instance's underlying renderer.
     ///
@@ -182,6 +196,12 @@ private:
     /// @brief Set the focus to this widget's window.
     void SetFocus();
 
+    /// @brief Draw a new frame on the next tick, and restart the timer if it was stopped while idle.
+    void ScheduleFrame();
+
+    /// @brief Tell the frame scheduler whether the user is holding any keys or mouse buttons.
+    void UpdateInteraction();
+
     /// @brief Does the given widget have the application focus?
     ///
     /// @param [in] widget The widget to check for focus.
@@ -189,13 +209,15 @@ private:
     /// @returns True if the given widget has application focus, false if not.
     bool IsFocused(QWidget* widget);
 
-    QTimer                            timer_;                          ///< A timer used to redraw the scene at a specific rate.
-    bool                              device_initialized_;             ///< A flag indicating if the device has been initialized.
-    bool                              render_active_;                  ///< True when rendering is currently active.
-    bool                              started_;                        ///< True if rendering has started.
-    bool                              renderer_is_focused_ = false;    ///< True if renderer is focus of application.
-    rra::renderer::RendererInterface* renderer_interface_  = nullptr;  ///< The renderer instance used to draw the frame.
-    rra::renderer::WindowInfo         window_info_         = {};       ///< The widget's platform window handle info.
+    QTimer                            timer_;                               ///< A timer used to check for changes and redraw the scene, stopped while idle.
+    bool                              device_initialized_;                  ///< A flag indicating if the device has been initialized.
+    bool                              render_active_;                       ///< True when rendering is currently active.
+    bool                              started_;                             ///< True if rendering has started.
+    bool                              renderer_is_focused_ = false;         ///< True if renderer is focus of application.
+    rra::renderer::RendererInterface* renderer_interface_  = nullptr;       ///< The renderer instance used to draw the frame.
+    rra::renderer::WindowInfo         window_info_         = {};            ///< The widget's platform window handle info.
+    QSet<int>                         held_keys_;                           ///< The keys currently held down.
+    Qt::MouseButtons                  held_mouse_buttons_  = Qt::NoButton;  ///< The mouse buttons currently held down.
 };
 
 #endif  // RRA_RENDERER_RENDERER_WIDGET_H_
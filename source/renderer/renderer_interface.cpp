@@ -59,6 +59,11 @@ namespace rra
             return camera_;
         }
 
+        FrameScheduler& RendererInterface::GetFrameScheduler()
+        {
+            return frame_scheduler_;
+        }
+
         void RendererInterface::SetSceneInfoCallback(
             std::function<void(RendererSceneInfo&, Camera* camera, bool frustum_culling, bool force_camera_update)> callback)
         {
@@ -5,6 +5,7 @@
 /// @brief  Implementation for the Renderer Widget.
 //=============================================================================
 
+#include <QApplication>
 #include <QDebug>
 #include <QEvent>
 #include <QWheelEvent>
@@ -43,18 +44,17 @@ RendererWidget::RendererWidget(QWidget* parent)
 
 void RendererWidget::Run()
 {
-    timer_.start(kMillisecondsPerFrame);
     render_active_ = started_ = true;
+    ScheduleFrame();
 }
 
 void RendererWidget::PauseFrames()
 {
-    if (!timer_.isActive() || !started_)
+    if (!render_active_ || !started_)
     {
         return;
     }
 
-    disconnect(&timer_, &QTimer::timeout, this, &RendererWidget::RenderFrame);
     timer_.stop();
     render_active_ = false;
 
@@ -63,25 +63,28 @@ void RendererWidget::PauseFrames()
 
 void RendererWidget::ContinueFrames()
 {
-    if (timer_.isActive() || !started_)
+    if (render_active_ || !started_)
     {
         return;
     }
 
-    connect(&timer_, &QTimer::timeout, this, &RendererWidget::RenderFrame);
-    timer_.start(kMillisecondsPerFrame);
     render_active_ = true;
+
+    // Anything could have changed while paused, so always draw on resuming.
+    ScheduleFrame();
 }
 
 void RendererWidget::Release()
 {
     device_initialized_ = false;
+    render_active_      = false;
     disconnect(&timer_, &QTimer::timeout, this, &RendererWidget::RenderFrame);
     timer_.stop();
 
     assert(renderer_interface_ != nullptr);
     if (renderer_interface_ != nullptr)
     {
+        renderer_interface_->GetFrameScheduler().SetWakeCallback(nullptr);
         renderer_interface_->WaitForGpu();
         renderer_interface_->Shutdown();
     }
@@ -125,6 +128,7 @@ void RendererWidget::leaveEvent(QEvent* event)
     if (renderer_interface_ != nullptr)
     {
         renderer_interface_->MarkAsDirty();
+        ScheduleFrame();
     }
 }
 
@@ -139,6 +143,9 @@ void RendererWidget::showEvent(QShowEvent* event)
         }
     }
 
+    // The view may have changed while hidden.
+    ScheduleFrame();
+
     QWidget::showEvent(event);
 }
 
@@ -148,6 +155,16 @@ bool RendererWidget::Initialize()
     if (result)
     {
         connect(&timer_, &QTimer::timeout, this, &RendererWidget::RenderFrame);
+
+        // The scheduler can be marked as dirty from outside the widget, such as by the render state adapter. The timer
+        // may be stopped then, so restart it. This goes through the event loop, so the timer isn't restarted from the
+        // middle of whatever marked the scheduler as dirty.
+        renderer_interface_->GetFrameScheduler().SetWakeCallback(
+            [this]() { QMetaObject::invokeMethod(this, "WakeFrames", Qt::QueuedConnection); });
+
+        // Changes made from the rest of the UI, such as the camera controls in the side panes, only show up in the
+        // frame state, so any input to the application restarts the timer to look for them.
+        qApp->installEventFilter(this);
     }
 
     // Tracks mouse even if no buttons are being pressed. Needed when hovering over orientation gizmo.
@@ -181,13 +198,52 @@ void RendererWidget::RenderFrame()
     {
         if (render_active_)
         {
-            renderer_interface_->MoveToNextFrame();
-
-            renderer_interface_->DrawFrame();
+            // Only draw when something has changed since the last frame.
+            if (renderer_interface_->UpdateFrame())
+            {
+                renderer_interface_->MoveToNextFrame();
+
+                renderer_interface_->DrawFrame();
+            }
+
+            // Check at the full frame rate while things are changing, and stop checking once idle. The timer is
+            // started again by WakeFrames().
+            if (renderer_interface_->GetFrameScheduler().IsIdle())
+            {
+                timer_.stop();
+            }
         }
     }
 }
 
+void RendererWidget::WakeFrames()
+{
+    if (render_active_ && device_initialized_ && !timer_.isActive())
+    {
+        timer_.start(kMillisecondsPerFrame);
+    }
+}
+
+void RendererWidget::ScheduleFrame()
+{
+    if (renderer_interface_ != nullptr)
+    {
+        renderer_interface_->GetFrameScheduler().MarkDirty();
+    }
+
+    WakeFrames();
+}
+
+void RendererWidget::UpdateInteraction()
+{
+    if (renderer_interface_ != nullptr)
+    {
+        renderer_interface_->GetFrameScheduler().SetInteracting(!held_keys_.isEmpty() || held_mouse_buttons_ != Qt::NoButton);
+    }
+
+    ScheduleFrame();
+}
+
 void RendererWidget::ResizeSwapChain(int width, int height)
 {
     assert(renderer_interface_ != nullptr);
@@ -213,11 +269,15 @@ QPaintEngine* RendererWidget::paintEngine() const
 void RendererWidget::paintEvent(QPaintEvent* event)
 {
     Q_UNUSED(event);
+
+    // The window system wants the widget contents again, such as after it was uncovered.
+    ScheduleFrame();
 }
 
 void RendererWidget::resizeEvent(QResizeEvent* event)
 {
     UpdateSwapchainSize();
+    ScheduleFrame();
     QWidget::resizeEvent(event);
 }
 
@@ -251,6 +311,25 @@ void RendererWidget::SetFocus()
 #endif
 }
 
+bool RendererWidget::eventFilter(QObject* object, QEvent* event)
+{
+    switch (event->type())
+    {
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::Wheel:
+        WakeFrames();
+        break;
+    default:
+        break;
+    }
+
+    return QWidget::eventFilter(object, event);
+}
+
 bool RendererWidget::event(QEvent* event)
 {
     switch (event->type())
@@ -269,27 +348,54 @@ bool RendererWidget::event(QEvent* event)
         parentWidget()->setStyleSheet(kFocusOutBorderStyle);
         renderer_is_focused_ = false;
         emit FocusOut();
+
+        // The key releases go elsewhere once the focus is lost.
+        held_keys_.clear();
+        UpdateInteraction();
         break;
     case QEvent::KeyPress:
-        emit KeyPressed(static_cast<QKeyEvent*>(event));
+    {
+        QKeyEvent* key_event = static_cast<QKeyEvent*>(event);
+        if (!key_event->isAutoRepeat())
+        {
+            held_keys_.insert(key_event->key());
+        }
+        emit KeyPressed(key_event);
+        UpdateInteraction();
         break;
+    }
     case QEvent::KeyRelease:
-        emit KeyReleased(static_cast<QKeyEvent*>(event));
+    {
+        QKeyEvent* key_event = static_cast<QKeyEvent*>(event);
+        if (!key_event->isAutoRepeat())
+        {
+            held_keys_.remove(key_event->key());
+        }
+        emit KeyReleased(key_event);
+        UpdateInteraction();
         break;
+    }
     case QEvent::MouseMove:
         emit MouseMoved(static_cast<QMouseEvent*>(event));
+        ScheduleFrame();
         break;
     case QEvent::MouseButtonPress:
+        held_mouse_buttons_ = static_cast<QMouseEvent*>(event)->buttons();
         emit MousePressed(static_cast<QMouseEvent*>(event));
+        UpdateInteraction();
         break;
     case QEvent::MouseButtonRelease:
+        held_mouse_buttons_ = static_cast<QMouseEvent*>(event)->buttons();
         emit MouseReleased(static_cast<QMouseEvent*>(event));
+        UpdateInteraction();
         break;
     case QEvent::MouseButtonDblClick:
         emit MouseDoubleClicked(static_cast<QMouseEvent*>(event));
+        ScheduleFrame();
         break;
     case QEvent::Wheel:
         emit MouseWheelMoved(static_cast<QWheelEvent*>(event));
+        ScheduleFrame();
         break;
     default:
         break;
@@ -80,6 +80,16 @@ namespace rra
         static const char* kGeometryColoringModeName_TriangleCount        = "Color geometry by leaf node triangle count (Triangle)";
         static const char* kGeometryColoringModeDescription_TriangleCount = "The triangle count within a leaf node.";
 
+        static const char* kGeometryColoringModeName_BlasSiblingOverlap = "Color geometry by sibling overlap (BLAS)";
+        static const char* kGeometryColoringModeDescription_BlasSiblingOverlap =
+            "A heatmap of how much the child bounding boxes of each box node in a BLAS overlap. Boxes that overlap less score higher.";
+        static const char* kGeometryColoringModeName_InstanceOverlapCount = "Color geometry by overlap count (Instance)";
+        static const char* kGeometryColoringModeDescription_InstanceOverlapCount =
+            "A heatmap of how many other instances each instance's bounding box overlaps. Instances that overlap fewer others score higher.";
+        static const char* kGeometryColoringModeName_TriangleNodeOverlap = "Color geometry by node overlap (Triangle)";
+        static const char* kGeometryColoringModeDescription_TriangleNodeOverlap =
+            "A heatmap of how much each triangle node's bounding box overlaps its siblings. Nodes that overlap less score higher.";
+
         // A declaration of all available coloring modes.
         static const std::vector<GeometryColoringModeInfo> kAvailableGeometryColoringModes = {
             {GeometryColoringMode::kBlasAverageSAH,
@@ -88,6 +98,18 @@ namespace rra
              kGeometryColoringModeDescription_BlasAverageSAH},
             {GeometryColoringMode::kTriangleSAH, BvhTypeFlags::All, kGeometryColoringModeName_TriangleSAH, kGeometryColoringModeDescription_TriangleSAH},
             {GeometryColoringMode::kBlasMinSAH, BvhTypeFlags::TopLevel, kGeometryColoringModeName_BlasMinSAH, kGeometryColoringModeDescription_BlasMinSAH},
+            {GeometryColoringMode::kBlasSiblingOverlap,
+             BvhTypeFlags::TopLevel,
+             kGeometryColoringModeName_BlasSiblingOverlap,
+             kGeometryColoringModeDescription_BlasSiblingOverlap},
+            {GeometryColoringMode::kInstanceOverlapCount,
+             BvhTypeFlags::TopLevel,
+             kGeometryColoringModeName_InstanceOverlapCount,
+             kGeometryColoringModeDescription_InstanceOverlapCount},
+            {GeometryColoringMode::kTriangleNodeOverlap,
+             BvhTypeFlags::BottomLevel,
+             kGeometryColoringModeName_TriangleNodeOverlap,
+             kGeometryColoringModeDescription_TriangleNodeOverlap},
             {GeometryColoringMode::kInstanceMask,
              BvhTypeFlags::TopLevel,
              kGeometryColoringModeName_InstanceMask,
@@ -292,6 +314,11 @@ namespace rra
             return GetIndexFromGeometryColoringMode((int32_t)mesh_render_module_->GetGeometryColoringMode());
         }
 
+        bool RenderStateAdapter::IsGeometryColoringModeActive(GeometryColoringMode coloring_mode) const
+        {
+            return mesh_render_module_->GetGeometryColoringMode() == coloring_mode;
+        }
+
         void RenderStateAdapter::GetAvailableGeometryColoringModes(BvhTypeFlags type, std::vector<GeometryColoringModeInfo>& coloring_modes) const
         {
             for (const auto& mode_info : kAvailableGeometryColoringModes)
@@ -6,6 +6,7 @@
 //=============================================================================
 
 #include <cassert>
+#include <fstream>
 #include <string>
 #include <stdexcept>
 #include <string.h>
@@ -87,6 +88,11 @@ namespace rra
 
                             result = alloc_init_result == VK_SUCCESS;
                         }
+
+                        if (result)
+                        {
+                            CreatePipelineCache();
+                        }
                     }
                 }
             }
@@ -224,6 +230,18 @@ namespace rra
                 }
             }
 
+            // Look for a queue family dedicated to transfers, which copies on the DMA engines without holding up rendering.
+            transfer_queue_family_index_ = UINT32_MAX;
+            for (uint32_t family_index = 0; family_index < queue_family_count; ++family_index)
+            {
+                VkQueueFlags flags = queue_props[family_index].queueFlags;
+                if ((flags & VK_QUEUE_TRANSFER_BIT) != 0 && (flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0)
+                {
+                    transfer_queue_family_index_ = family_index;
+                    break;
+                }
+            }
+
             // Prepare existing extensions names into a buffer for vkCreateDevice.
             std::vector<const char*> extension_names;
             device_properties->GetExtensionNamesAndConfigs(extension_names);
@@ -231,7 +249,7 @@ namespace rra
             // Create the logical device.
             float queue_priorities[1] = {0.0};
 
-            VkDeviceQueueCreateInfo queue_info[2] = {};
+            VkDeviceQueueCreateInfo queue_info[3] = {};
             queue_info[0].sType                   = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
             queue_info[0].pNext                   = nullptr;
             queue_info[0].queueCount              = 1;
@@ -244,6 +262,12 @@ namespace rra
             queue_info[1].pQueuePriorities = queue_priorities;
             queue_info[1].queueFamilyIndex = compute_queue_family_index_;
 
+            queue_info[2].sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queue_info[2].pNext            = nullptr;
+            queue_info[2].queueCount       = 1;
+            queue_info[2].pQueuePriorities = queue_priorities;
+            queue_info[2].queueFamilyIndex = transfer_queue_family_index_;
+
             VkPhysicalDeviceFeatures physical_device_features       = {};
             physical_device_features.fillModeNonSolid               = true;
             physical_device_features.pipelineStatisticsQuery        = true;
@@ -264,7 +288,7 @@ namespace rra
             VkDeviceCreateInfo device_info      = {};
             device_info.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
             device_info.pNext                   = &physical_device_features_2;
-            device_info.queueCreateInfoCount    = 2;
+            device_info.queueCreateInfoCount    = (transfer_queue_family_index_ != UINT32_MAX) ? 3 : 2;
             device_info.pQueueCreateInfos       = queue_info;
             device_info.enabledExtensionCount   = static_cast<uint32_t>(extension_names.size());
             device_info.ppEnabledExtensionNames = device_info.enabledExtensionCount ? extension_names.data() : nullptr;
@@ -295,6 +319,11 @@ namespace rra
                 vkGetDeviceQueue(device_, compute_queue_family_index_, 0, &compute_queue_);
             }
 
+            if (transfer_queue_family_index_ != UINT32_MAX)
+            {
+                vkGetDeviceQueue(device_, transfer_queue_family_index_, 0, &transfer_queue_);
+            }
+
             // Initialize the extensions (if they have been enabled successfully).
             ExtDebugUtilsGetProcAddresses(device_);
         }
@@ -334,6 +363,16 @@ namespace rra
             return compute_queue_family_index_;
         }
 
+        VkQueue Device::GetTransferQueue() const
+        {
+            return (transfer_queue_ != VK_NULL_HANDLE) ? transfer_queue_ : graphics_queue_;
+        }
+
+        uint32_t Device::GetTransferQueueFamilyIndex() const
+        {
+            return (transfer_queue_family_index_ != UINT32_MAX) ? transfer_queue_family_index_ : graphics_queue_family_index_;
+        }
+
         VkPhysicalDevice Device::GetPhysicalDevice() const
         {
             return physical_device_;
@@ -364,6 +403,119 @@ namespace rra
             return allocator_;
         }
 
+        void Device::SetPipelineCacheFile(const std::string& file_path)
+        {
+            pipeline_cache_file_ = file_path;
+        }
+
+        VkPipelineCache Device::GetPipelineCache() const
+        {
+            return pipeline_cache_;
+        }
+
+        void Device::CreatePipelineCache()
+        {
+            std::vector<char> cache_data;
+
+            if (!pipeline_cache_file_.empty())
+            {
+                std::ifstream cache_stream(pipeline_cache_file_.c_str(), std::ios::binary | std::ios::in | std::ios::ate);
+                if (cache_stream.is_open())
+                {
+                    std::streamoff size = cache_stream.tellg();
+                    if (size > 0)
+                    {
+                        cache_data.resize(static_cast<size_t>(size));
+                        cache_stream.seekg(0, std::ios::beg);
+                        cache_stream.read(cache_data.data(), size);
+                        if (!cache_stream)
+                        {
+                            cache_data.clear();
+                        }
+                    }
+                }
+            }
+
+            // The cache is only valid for the device and driver that wrote it. Drivers should reject anything else
+            // themselves, but not all of them do, so the header is checked here too.
+            if (!cache_data.empty())
+            {
+                VkPipelineCacheHeaderVersionOne header = {};
+
+                bool valid = cache_data.size() >= sizeof(header);
+                if (valid)
+                {
+                    memcpy(&header, cache_data.data(), sizeof(header));
+                    valid = header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                            header.vendorID == device_properties_.vendorID && header.deviceID == device_properties_.deviceID &&
+                            memcmp(header.pipelineCacheUUID, device_properties_.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+                }
+
+                if (!valid)
+                {
+                    RraPrint("Discarding the pipeline cache written by a different device or driver.");
+                    cache_data.clear();
+                }
+            }
+
+            VkPipelineCacheCreateInfo create_info = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+            create_info.initialDataSize           = cache_data.size();
+            create_info.pInitialData              = cache_data.empty() ? nullptr : cache_data.data();
+
+            VkResult result = vkCreatePipelineCache(device_, &create_info, nullptr, &pipeline_cache_);
+            if (result != VK_SUCCESS && !cache_data.empty())
+            {
+                // Fall back to an empty cache if the driver didn't like the data.
+                create_info.initialDataSize = 0;
+                create_info.pInitialData    = nullptr;
+                result                      = vkCreatePipelineCache(device_, &create_info, nullptr, &pipeline_cache_);
+            }
+
+            // The cache only speeds up pipeline creation, so carry on without one if it can't be created.
+            if (result != VK_SUCCESS)
+            {
+                RraPrint("Failed to create the pipeline cache.");
+                pipeline_cache_ = VK_NULL_HANDLE;
+            }
+        }
+
+        void Device::SavePipelineCache()
+        {
+            if (pipeline_cache_ == VK_NULL_HANDLE)
+            {
+                return;
+            }
+
+            if (!pipeline_cache_file_.empty())
+            {
+                size_t   size   = 0;
+                VkResult result = vkGetPipelineCacheData(device_, pipeline_cache_, &size, nullptr);
+
+                std::vector<char> cache_data(size);
+                if (result == VK_SUCCESS && size > 0)
+                {
+                    result = vkGetPipelineCacheData(device_, pipeline_cache_, &size, cache_data.data());
+                }
+
+                if (result == VK_SUCCESS && size > 0)
+                {
+                    std::ofstream cache_stream(pipeline_cache_file_.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+                    if (cache_stream.is_open())
+                    {
+                        cache_stream.write(cache_data.data(), size);
+                    }
+
+                    if (!cache_stream)
+                    {
+                        RraPrint("Failed to write the pipeline cache file.");
+                    }
+                }
+            }
+
+            vkDestroyPipelineCache(device_, pipeline_cache_, nullptr);
+            pipeline_cache_ = VK_NULL_HANDLE;
+        }
+
         void Device::OnDestroy()
         {
             if (instance_ == VK_NULL_HANDLE)
@@ -373,6 +525,8 @@ namespace rra
 
             GPUFlush();
 
+            SavePipelineCache();
+
             if (allocator_ != VK_NULL_HANDLE)
             {
                 vmaDestroyAllocator(allocator_);
@@ -450,7 +604,8 @@ namespace rra
                                   VkBuffer&          buffer,
                                   VmaAllocation&     allocation,
                                   const void*        data,
-                                  VkDeviceSize       size)
+                                  VkDeviceSize       size,
+                                  bool               shared_across_queues)
         {
             RRA_ASSERT(buffer == VK_NULL_HANDLE);
 
@@ -458,6 +613,22 @@ namespace rra
             buffer_info.size               = size;
             buffer_info.usage              = usage_flags;
 
+            // Concurrent sharing avoids ownership transfers between the queue families, at a small cost in access speed.
+            uint32_t queue_family_indices[3] = {graphics_queue_family_index_};
+            uint32_t queue_family_count      = 1;
+            if (shared_across_queues && transfer_queue_family_index_ != UINT32_MAX)
+            {
+                if (compute_queue_family_index_ != UINT32_MAX && compute_queue_family_index_ != graphics_queue_family_index_)
+                {
+                    queue_family_indices[queue_family_count++] = compute_queue_family_index_;
+                }
+                queue_family_indices[queue_family_count++] = transfer_queue_family_index_;
+
+                buffer_info.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+                buffer_info.queueFamilyIndexCount = queue_family_count;
+                buffer_info.pQueueFamilyIndices   = queue_family_indices;
+            }
+
             VmaAllocationCreateInfo alloc_info = {};
             alloc_info.usage                   = memory_usage;
 
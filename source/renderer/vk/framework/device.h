@@ -108,6 +108,16 @@ namespace rra
             /// @returns The handle to the device compute queue family index.
             uint32_t GetComputeQueueFamilyIndex() const;
 
+            /// @brief Retrieve the handle to the device transfer queue.
+            ///
+            /// @returns The handle to the dedicated transfer queue, or the graphics queue if there is none.
+            VkQueue GetTransferQueue() const;
+
+            /// @brief Retrieve the handle to the device transfer queue family index.
+            ///
+            /// @returns The dedicated transfer queue family index, or the graphics queue family index if there is none.
+            uint32_t GetTransferQueueFamilyIndex() const;
+
             /// @brief Retrieve the handle to the underlying physical device.
             ///
             /// @returns The handle to the underlying physical device.
@@ -138,6 +148,16 @@ namespace rra
             /// @return The VMA allocator.
             VmaAllocator GetAllocator() const;
 
+            /// @brief Set the file the pipeline cache is loaded from on creation and saved to on destruction.
+            ///
+            /// @param [in] file_path The path of the pipeline cache file. An empty path disables the file.
+            void SetPipelineCacheFile(const std::string& file_path);
+
+            /// @brief Get the pipeline cache to create pipelines with.
+            ///
+            /// @returns The pipeline cache, or VK_NULL_HANDLE if it couldn't be created.
+            VkPipelineCache GetPipelineCache() const;
+
             /// @brief Wait for all in-flight work in the GPU queues to complete.
             void GPUFlush();
 
@@ -157,12 +177,14 @@ namespace rra
             /// @param [out] allocation The allocation for the buffer.
             /// @param [in] data An pointer to the data to populate the buffer with. If the value is nullptr mapping will be skipped.
             /// @param [in] size The total size of the buffer in bytes.
+            /// @param [in] shared_across_queues True if the buffer is written on the transfer queue and used on the others.
             void CreateBuffer(VkBufferUsageFlags usage_flags,
                               VmaMemoryUsage     memory_usage,
                               VkBuffer&          buffer,
                               VmaAllocation&     allocation,
                               const void*        data,
-                              VkDeviceSize       size);
+                              VkDeviceSize       size,
+                              bool               shared_across_queues = false);
 
             /// @brief Create an image with the device using the given image configuration.
             ///
@@ -204,6 +226,12 @@ namespace rra
             std::vector<VkSampleCountFlagBits> GetPossibleMSAASampleSettings();
 
         private:
+            /// @brief Create the pipeline cache, seeded with the cache file if it was written by the same device and driver.
+            void CreatePipelineCache();
+
+            /// @brief Write the pipeline cache to the cache file, then destroy it.
+            void SavePipelineCache();
+
             VkInstance                         instance_            = VK_NULL_HANDLE;  ///< The instance handle.
             VkDevice                           device_              = VK_NULL_HANDLE;  ///< The device handle.
             VkPhysicalDevice                   physical_device_     = VK_NULL_HANDLE;  ///< The physical device handle.
@@ -213,12 +241,16 @@ namespace rra
             VkPhysicalDeviceSubgroupProperties subgroup_properties_ = {};              ///< The device subgroup properties.
             VkSurfaceKHR                       surface_             = VK_NULL_HANDLE;  ///< The surface used to gather information for the queue creation.
             VmaAllocator                       allocator_           = VK_NULL_HANDLE;  ///< VMA allocator to help with allocation.
+            VkPipelineCache                    pipeline_cache_      = VK_NULL_HANDLE;  ///< The pipeline cache shared by all pipelines.
+            std::string                        pipeline_cache_file_;                   ///< The file the pipeline cache persists to.
             VkQueue                            present_queue_       = VK_NULL_HANDLE;  ///< The device present queue.
             uint32_t                           present_queue_family_index_  = 0;       ///< The device present queue family index.
             VkQueue                            graphics_queue_              = VK_NULL_HANDLE;  ///< The device graphics queue.
             uint32_t                           graphics_queue_family_index_ = 0;               ///< The device graphics queue family index.
             VkQueue                            compute_queue_               = VK_NULL_HANDLE;  ///< The device compute queue.
             uint32_t                           compute_queue_family_index_  = 0;               ///< The device compute queue family index.
+            VkQueue                            transfer_queue_              = VK_NULL_HANDLE;  ///< The dedicated transfer queue, if the device has one.
+            uint32_t                           transfer_queue_family_index_ = UINT32_MAX;      ///< The dedicated transfer queue family index.
             bool                               using_validation_layer       = false;           ///< The flag indicating if the validation layers are active.
             size_t                             buffer_allocation_count_     = 0;               ///< The buffer allocation count.
             size_t                             image_allocation_count_      = 0;               ///< The image allocation count.
@@ -121,7 +121,7 @@ namespace rra
 
             // Create the pipeline.
             create_result =
-                vkCreateGraphicsPipelines(context->device->GetDevice(), VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &checker_clear_pipeline_);
+                vkCreateGraphicsPipelines(context->device->GetDevice(), context->device->GetPipelineCache(), 1, &pipeline_create_info, nullptr, &checker_clear_pipeline_);
             CheckResult(create_result, "Failed to create checker clear pipeline.");
 
             // Destroy shader modules.
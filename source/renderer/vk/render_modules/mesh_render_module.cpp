@@ -162,9 +162,11 @@ namespace rra
 
             // Process the other scene data if the state has updated.
             if (draw_context->scene_info != nullptr && (render_state_.updated || draw_context->scene_info->scene_iteration != last_scene_iteration_ ||
+                                                        draw_context->scene_info->instance_map_iteration != last_instance_map_iteration_ ||
                                                         (last_view_projection_matrix_ != draw_context->view_projection)))
             {
                 last_view_projection_matrix_ = draw_context->view_projection;
+                last_instance_map_iteration_ = draw_context->scene_info->instance_map_iteration;
                 ProcessSceneData(draw_context->command_buffer, draw_context->camera_position);
             }
 
@@ -269,7 +271,7 @@ namespace rra
 
                     if (render_state_.render_geometry)
                     {
-                        cull_pipelines = geometry_color_pipelines_[coloring_mode_];
+                        cull_pipelines = GetGeometryColorPipelines(coloring_mode_);
                         draw           = true;
                     }
                     else if (render_state_.render_wireframe)
@@ -319,6 +321,7 @@ namespace rra
                 vkDestroyPipeline(device_handle, pipeline_pair.second.cull_front, nullptr);
                 vkDestroyPipeline(device_handle, pipeline_pair.second.cull_back, nullptr);
             }
+            geometry_color_pipelines_.clear();
 
             vkDestroyPipeline(device_handle, geometry_wireframe_only_pipeline_.cull_none, nullptr);
             vkDestroyPipeline(device_handle, geometry_wireframe_only_pipeline_.cull_front, nullptr);
@@ -508,17 +511,41 @@ namespace rra
 
             // Create the pipeline.
             VkResult create_result =
-                vkCreateGraphicsPipelines(context_->device->GetDevice(), VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &result_pipeline);
+                vkCreateGraphicsPipelines(context_->device->GetDevice(), context_->device->GetPipelineCache(), 1, &pipeline_create_info, nullptr, &result_pipeline);
             CheckResult(create_result, "Failed to create pipeline.");
 
             return result_pipeline;
         }
 
-        void MeshRenderModule::InitializeGeometryColorPipeline(const std::string&                                    vert_shader,
-                                                               const std::string&                                    frag_shader,
-                                                               const std::vector<VkVertexInputAttributeDescription>& attributes,
-                                                               GeometryColoringMode                                  coloring_mode)
+        void MeshRenderModule::RegisterGeometryColorPipeline(const std::string&                                    vert_shader,
+                                                             const std::string&                                    frag_shader,
+                                                             const std::vector<VkVertexInputAttributeDescription>& attributes,
+                                                             GeometryColoringMode                                  coloring_mode)
         {
+            GeometryColorPipelineDescription& description = geometry_color_pipeline_descriptions_[coloring_mode];
+            description.vert_shader                       = vert_shader;
+            description.frag_shader                       = frag_shader;
+            description.attributes                        = attributes;
+        }
+
+        const MeshRenderModule::TriangleCullPipelines& MeshRenderModule::GetGeometryColorPipelines(GeometryColoringMode coloring_mode)
+        {
+            // Most sessions only look at a few coloring modes, so the pipelines are created the first time a mode is drawn
+            // rather than all of them at startup.
+            if (geometry_color_pipelines_.find(coloring_mode) == geometry_color_pipelines_.end())
+            {
+                InitializeGeometryColorPipeline(coloring_mode);
+            }
+
+            return geometry_color_pipelines_[coloring_mode];
+        }
+
+        void MeshRenderModule::InitializeGeometryColorPipeline(GeometryColoringMode coloring_mode)
+        {
+            RRA_ASSERT(geometry_color_pipeline_descriptions_.find(coloring_mode) != geometry_color_pipeline_descriptions_.end());
+
+            const GeometryColorPipelineDescription& description = geometry_color_pipeline_descriptions_[coloring_mode];
+
             // Binding point 0: Mesh vertex layout description at per-vertex rate.
             VkVertexInputBindingDescription mesh_binding_description = {};
             mesh_binding_description.binding                         = kVertexBufferBindId;
@@ -534,21 +561,21 @@ namespace rra
 
             // Load the SPV shader binaries used to render solid TLAS + BLAS geometry.
             VkPipelineShaderStageCreateInfo preview_shader_vs;
-            LoadShader(vert_shader.c_str(), context_->device, VK_SHADER_STAGE_VERTEX_BIT, "VSMain", preview_shader_vs);
+            LoadShader(description.vert_shader.c_str(), context_->device, VK_SHADER_STAGE_VERTEX_BIT, "VSMain", preview_shader_vs);
 
             VkPipelineShaderStageCreateInfo preview_shader_ps;
-            LoadShader(frag_shader.c_str(), context_->device, VK_SHADER_STAGE_FRAGMENT_BIT, "PSMain", preview_shader_ps);
+            LoadShader(description.frag_shader.c_str(), context_->device, VK_SHADER_STAGE_FRAGMENT_BIT, "PSMain", preview_shader_ps);
 
             VkPipeline cull_none_pipeline =
-                InitializeMeshPipeline(preview_shader_vs, preview_shader_ps, input_binding_descriptions, attributes, VK_CULL_MODE_NONE, false);
+                InitializeMeshPipeline(preview_shader_vs, preview_shader_ps, input_binding_descriptions, description.attributes, VK_CULL_MODE_NONE, false);
             geometry_color_pipelines_[coloring_mode].cull_none = cull_none_pipeline;
 
             VkPipeline cull_front_pipeline =
-                InitializeMeshPipeline(preview_shader_vs, preview_shader_ps, input_binding_descriptions, attributes, VK_CULL_MODE_FRONT_BIT, false);
+                InitializeMeshPipeline(preview_shader_vs, preview_shader_ps, input_binding_descriptions, description.attributes, VK_CULL_MODE_FRONT_BIT, false);
             geometry_color_pipelines_[coloring_mode].cull_front = cull_front_pipeline;
 
             VkPipeline cull_back_pipeline =
-                InitializeMeshPipeline(preview_shader_vs, preview_shader_ps, input_binding_descriptions, attributes, VK_CULL_MODE_BACK_BIT, false);
+                InitializeMeshPipeline(preview_shader_vs, preview_shader_ps, input_binding_descriptions, description.attributes, VK_CULL_MODE_BACK_BIT, false);
             geometry_color_pipelines_[coloring_mode].cull_back = cull_back_pipeline;
 
             // Destroy each render module after the pipelines have been created.
@@ -625,7 +652,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE_FOUR_SLOTS(3, instance_transform),
                 INSTANCE_ATTRIBUTE(7, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorTreeLevel.vs.spv", "GeometryColorTreeLevel.ps.spv", tree_level_attr, GeometryColoringMode::kTreeLevel);
 
             std::vector<VkVertexInputAttributeDescription> blas_instance_id_attr{
@@ -635,7 +662,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, blas_index),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorBlasInstanceId.vs.spv", "GeometryColorBlasInstanceId.ps.spv", blas_instance_id_attr, GeometryColoringMode::kBlasInstanceId);
 
             std::vector<VkVertexInputAttributeDescription> geometry_index_attr{
@@ -646,7 +673,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE_FOUR_SLOTS(3, instance_transform),
                 INSTANCE_ATTRIBUTE(7, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorGeometryIndex.vs.spv", "GeometryColorGeometryIndex.ps.spv", geometry_index_attr, GeometryColoringMode::kGeometryIndex);
 
             std::vector<VkVertexInputAttributeDescription> opacity_attr{
@@ -657,7 +684,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE_FOUR_SLOTS(3, instance_transform),
                 INSTANCE_ATTRIBUTE(7, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline("GeometryColorOpacity.vs.spv", "GeometryColorOpacity.ps.spv", opacity_attr, GeometryColoringMode::kOpacity);
+            RegisterGeometryColorPipeline("GeometryColorOpacity.vs.spv", "GeometryColorOpacity.ps.spv", opacity_attr, GeometryColoringMode::kOpacity);
 
             std::vector<VkVertexInputAttributeDescription> instance_mask_attr{
                 VERTEX_ATTRIBUTE(0, position),
@@ -666,7 +693,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, wireframe_metadata),
                 INSTANCE_ATTRIBUTE(6, mask),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorInstanceMask.vs.spv", "GeometryColorInstanceMask.ps.spv", instance_mask_attr, GeometryColoringMode::kInstanceMask);
 
             std::vector<VkVertexInputAttributeDescription> lit_attr{
@@ -677,7 +704,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE_FOUR_SLOTS(3, instance_transform),
                 INSTANCE_ATTRIBUTE(7, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline("GeometryColorLit.vs.spv", "GeometryColorLit.ps.spv", lit_attr, GeometryColoringMode::kLit);
+            RegisterGeometryColorPipeline("GeometryColorLit.vs.spv", "GeometryColorLit.ps.spv", lit_attr, GeometryColoringMode::kLit);
 
             std::vector<VkVertexInputAttributeDescription> technical_attr{
                 VERTEX_ATTRIBUTE(0, position),
@@ -687,7 +714,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE_FOUR_SLOTS(3, instance_transform),
                 INSTANCE_ATTRIBUTE(7, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline("GeometryColorTechnical.vs.spv", "GeometryColorTechnical.ps.spv", technical_attr, GeometryColoringMode::kTechnical);
+            RegisterGeometryColorPipeline("GeometryColorTechnical.vs.spv", "GeometryColorTechnical.ps.spv", technical_attr, GeometryColoringMode::kTechnical);
 
             std::vector<VkVertexInputAttributeDescription> average_sah_attr{
                 VERTEX_ATTRIBUTE(0, position),
@@ -696,7 +723,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, average_triangle_sah),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorBlasAverageSAH.vs.spv", "GeometryColorBlasAverageSAH.ps.spv", average_sah_attr, GeometryColoringMode::kBlasAverageSAH);
 
             std::vector<VkVertexInputAttributeDescription> min_sah_attr{
@@ -706,9 +733,34 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, min_triangle_sah),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorBlasMinSAH.vs.spv", "GeometryColorBlasMinSAH.ps.spv", min_sah_attr, GeometryColoringMode::kBlasMinSAH);
 
+            // The overlap score uses the same 0 to 1 heatmap as the SAH, so the average SAH shaders are reused.
+            std::vector<VkVertexInputAttributeDescription> sibling_overlap_attr{
+                VERTEX_ATTRIBUTE(0, position),
+
+                INSTANCE_ATTRIBUTE_FOUR_SLOTS(1, instance_transform),
+                INSTANCE_ATTRIBUTE(5, sibling_overlap_score),
+                INSTANCE_ATTRIBUTE(6, wireframe_metadata),
+            };
+            RegisterGeometryColorPipeline("GeometryColorBlasAverageSAH.vs.spv",
+                                          "GeometryColorBlasAverageSAH.ps.spv",
+                                          sibling_overlap_attr,
+                                          GeometryColoringMode::kBlasSiblingOverlap);
+
+            std::vector<VkVertexInputAttributeDescription> instance_overlap_attr{
+                VERTEX_ATTRIBUTE(0, position),
+
+                INSTANCE_ATTRIBUTE_FOUR_SLOTS(1, instance_transform),
+                INSTANCE_ATTRIBUTE(5, instance_overlap_score),
+                INSTANCE_ATTRIBUTE(6, wireframe_metadata),
+            };
+            RegisterGeometryColorPipeline("GeometryColorBlasAverageSAH.vs.spv",
+                                          "GeometryColorBlasAverageSAH.ps.spv",
+                                          instance_overlap_attr,
+                                          GeometryColoringMode::kInstanceOverlapCount);
+
             std::vector<VkVertexInputAttributeDescription> triangle_sah_attr{
                 VERTEX_ATTRIBUTE(0, position),
                 VERTEX_ATTRIBUTE(1, triangle_sah_and_selected),
@@ -716,9 +768,15 @@ namespace rra
                 INSTANCE_ATTRIBUTE_FOUR_SLOTS(2, instance_transform),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorTriangleSAH.vs.spv", "GeometryColorTriangleSAH.ps.spv", triangle_sah_attr, GeometryColoringMode::kTriangleSAH);
 
+            // The scene puts the node overlap score where the triangle SAH would be, so the triangle SAH shaders are reused.
+            RegisterGeometryColorPipeline("GeometryColorTriangleSAH.vs.spv",
+                                          "GeometryColorTriangleSAH.ps.spv",
+                                          triangle_sah_attr,
+                                          GeometryColoringMode::kTriangleNodeOverlap);
+
             std::vector<VkVertexInputAttributeDescription> blas_instance_count_attr{
                 VERTEX_ATTRIBUTE(0, position),
 
@@ -726,10 +784,10 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, instance_count),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline("GeometryColorBlasInstanceCount.vs.spv",
-                                            "GeometryColorBlasInstanceCount.ps.spv",
-                                            blas_instance_count_attr,
-                                            GeometryColoringMode::kBlasInstanceCount);
+            RegisterGeometryColorPipeline("GeometryColorBlasInstanceCount.vs.spv",
+                                          "GeometryColorBlasInstanceCount.ps.spv",
+                                          blas_instance_count_attr,
+                                          GeometryColoringMode::kBlasInstanceCount);
 
             std::vector<VkVertexInputAttributeDescription> blas_triangle_count_attr{
                 VERTEX_ATTRIBUTE(0, position),
@@ -738,10 +796,10 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, triangle_count),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline("GeometryColorBlasTriangleCount.vs.spv",
-                                            "GeometryColorBlasTriangleCount.ps.spv",
-                                            blas_triangle_count_attr,
-                                            GeometryColoringMode::kBlasTriangleCount);
+            RegisterGeometryColorPipeline("GeometryColorBlasTriangleCount.vs.spv",
+                                          "GeometryColorBlasTriangleCount.ps.spv",
+                                          blas_triangle_count_attr,
+                                          GeometryColoringMode::kBlasTriangleCount);
 
             std::vector<VkVertexInputAttributeDescription> blas_max_depth_attr{
                 VERTEX_ATTRIBUTE(0, position),
@@ -750,7 +808,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, max_depth),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorBlasMaxDepth.vs.spv", "GeometryColorBlasMaxDepth.ps.spv", blas_max_depth_attr, GeometryColoringMode::kBlasMaxDepth);
 
             std::vector<VkVertexInputAttributeDescription> blas_average_depth_attr{
@@ -760,10 +818,10 @@ namespace rra
                 INSTANCE_ATTRIBUTE(5, average_depth),
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline("GeometryColorBlasAverageDepth.vs.spv",
-                                            "GeometryColorBlasAverageDepth.ps.spv",
-                                            blas_average_depth_attr,
-                                            GeometryColoringMode::kBlasAverageDepth);
+            RegisterGeometryColorPipeline("GeometryColorBlasAverageDepth.vs.spv",
+                                          "GeometryColorBlasAverageDepth.ps.spv",
+                                          blas_average_depth_attr,
+                                          GeometryColoringMode::kBlasAverageDepth);
 
             std::vector<VkVertexInputAttributeDescription> instance_index_attr{
                 VERTEX_ATTRIBUTE(0, position),
@@ -773,7 +831,7 @@ namespace rra
                 INSTANCE_ATTRIBUTE(6, blas_index),
                 INSTANCE_ATTRIBUTE(7, wireframe_metadata),
             };
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorInstanceIndex.vs.spv", "GeometryColorInstanceIndex.ps.spv", instance_index_attr, GeometryColoringMode::kInstanceIndex);
 
             std::vector<VkVertexInputAttributeDescription> build_flags_attr{
@@ -784,20 +842,20 @@ namespace rra
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
 
-            InitializeGeometryColorPipeline("GeometryColorPreferFastBuildOrTrace.vs.spv",
-                                            "GeometryColorPreferFastBuildOrTrace.ps.spv",
-                                            build_flags_attr,
-                                            GeometryColoringMode::kFastBuildOrTraceFlag);
+            RegisterGeometryColorPipeline("GeometryColorPreferFastBuildOrTrace.vs.spv",
+                                          "GeometryColorPreferFastBuildOrTrace.ps.spv",
+                                          build_flags_attr,
+                                          GeometryColoringMode::kFastBuildOrTraceFlag);
 
-            InitializeGeometryColorPipeline("GeometryColorAllowCompactionFlag.vs.spv",
-                                            "GeometryColorAllowCompactionFlag.ps.spv",
-                                            build_flags_attr,
-                                            GeometryColoringMode::kAllowCompactionFlag);
+            RegisterGeometryColorPipeline("GeometryColorAllowCompactionFlag.vs.spv",
+                                          "GeometryColorAllowCompactionFlag.ps.spv",
+                                          build_flags_attr,
+                                          GeometryColoringMode::kAllowCompactionFlag);
 
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorAllowUpdateFlag.vs.spv", "GeometryColorAllowUpdateFlag.ps.spv", build_flags_attr, GeometryColoringMode::kAllowUpdateFlag);
 
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryColorLowMemoryFlag.vs.spv", "GeometryColorLowMemoryFlag.ps.spv", build_flags_attr, GeometryColoringMode::kLowMemoryFlag);
 
             std::vector<VkVertexInputAttributeDescription> instance_flags_attr{
@@ -808,18 +866,18 @@ namespace rra
                 INSTANCE_ATTRIBUTE(6, wireframe_metadata),
             };
 
-            InitializeGeometryColorPipeline("GeometryInstanceFacingCullDisable.vs.spv",
-                                            "GeometryInstanceFacingCullDisable.ps.spv",
-                                            instance_flags_attr,
-                                            GeometryColoringMode::kInstanceFacingCullDisableBit);
+            RegisterGeometryColorPipeline("GeometryInstanceFacingCullDisable.vs.spv",
+                                          "GeometryInstanceFacingCullDisable.ps.spv",
+                                          instance_flags_attr,
+                                          GeometryColoringMode::kInstanceFacingCullDisableBit);
 
-            InitializeGeometryColorPipeline(
+            RegisterGeometryColorPipeline(
                 "GeometryInstanceFlipFacing.vs.spv", "GeometryInstanceFlipFacing.ps.spv", instance_flags_attr, GeometryColoringMode::kInstanceFlipFacingBit);
 
-            InitializeGeometryColorPipeline("GeometryInstanceForceOpaqueOrNoOpaque.vs.spv",
-                                            "GeometryInstanceForceOpaqueOrNoOpaque.ps.spv",
-                                            instance_flags_attr,
-                                            GeometryColoringMode::kInstanceForceOpaqueOrNoOpaqueBits);
+            RegisterGeometryColorPipeline("GeometryInstanceForceOpaqueOrNoOpaque.vs.spv",
+                                          "GeometryInstanceForceOpaqueOrNoOpaque.ps.spv",
+                                          instance_flags_attr,
+                                          GeometryColoringMode::kInstanceForceOpaqueOrNoOpaqueBits);
         }
 
         void MeshRenderModule::UploadCustomTriangles(VkCommandBuffer command_buffer)
@@ -945,6 +1003,12 @@ namespace rra
                 auto instance_count_for_blas = GetTotalInstanceCountForBlas(instance_iter.first, current_scene_info_->instance_counts);
                 auto instance_transforms     = instance_iter.second;
 
+                // A blas still uploading is left out until it arrives, which bumps the instance map iteration.
+                if (!GetVkGraphicsContext()->IsBlasUploaded(instance_iter.first))
+                {
+                    continue;
+                }
+
                 auto mesh = GetVkGraphicsContext()->GetBlasDrawInstruction(instance_iter.first);
 
                 std::vector<MeshInstanceData> temp_buffer;
@@ -954,19 +1018,21 @@ namespace rra
                 {
                     mesh_instance_data = {};  // Reset the instance data.
 
-                    mesh_instance_data.instance_transform   = instance_transforms[i].transform;
-                    mesh_instance_data.instance_index       = instance_transforms[i].instance_index;
-                    mesh_instance_data.instance_node        = instance_transforms[i].instance_node;
-                    mesh_instance_data.instance_count       = instance_count_for_blas;
-                    mesh_instance_data.blas_index           = static_cast<uint32_t>(instance_iter.first);
-                    mesh_instance_data.triangle_count       = mesh.vertex_count / 3;
-                    mesh_instance_data.flags                = instance_transforms[i].flags;
-                    mesh_instance_data.max_depth            = instance_transforms[i].max_depth;
-                    mesh_instance_data.mask                 = instance_transforms[i].mask;
-                    mesh_instance_data.average_depth        = instance_transforms[i].average_depth;
-                    mesh_instance_data.min_triangle_sah     = instance_transforms[i].min_triangle_sah;
-                    mesh_instance_data.average_triangle_sah = instance_transforms[i].average_triangle_sah;
-                    mesh_instance_data.build_flags          = instance_transforms[i].build_flags;
+                    mesh_instance_data.instance_transform     = instance_transforms[i].transform;
+                    mesh_instance_data.instance_index         = instance_transforms[i].instance_index;
+                    mesh_instance_data.instance_node          = instance_transforms[i].instance_node;
+                    mesh_instance_data.instance_count         = instance_count_for_blas;
+                    mesh_instance_data.blas_index             = static_cast<uint32_t>(instance_iter.first);
+                    mesh_instance_data.triangle_count         = mesh.vertex_count / 3;
+                    mesh_instance_data.flags                  = instance_transforms[i].flags;
+                    mesh_instance_data.max_depth              = instance_transforms[i].max_depth;
+                    mesh_instance_data.mask                   = instance_transforms[i].mask;
+                    mesh_instance_data.average_depth          = instance_transforms[i].average_depth;
+                    mesh_instance_data.min_triangle_sah       = instance_transforms[i].min_triangle_sah;
+                    mesh_instance_data.average_triangle_sah   = instance_transforms[i].average_triangle_sah;
+                    mesh_instance_data.sibling_overlap_score  = instance_transforms[i].sibling_overlap_score;
+                    mesh_instance_data.instance_overlap_score = instance_transforms[i].instance_overlap_score;
+                    mesh_instance_data.build_flags            = instance_transforms[i].build_flags;
 
                     mesh_instance_data.wireframe_metadata =
                         GetWireframeColor(render_state_.render_wireframe, instance_transforms[i].selected, current_scene_info_);
@@ -75,6 +75,21 @@ namespace rra
             void SetGeometryColoringMode(GeometryColoringMode coloring_mode);
 
         private:
+            struct TriangleCullPipelines
+            {
+                VkPipeline cull_none;
+                VkPipeline cull_front;
+                VkPipeline cull_back;
+            };
+
+            /// @brief The shaders and vertex input of a geometry coloring mode, kept until its pipelines are first needed.
+            struct GeometryColorPipelineDescription
+            {
+                std::string                                    vert_shader;  ///< The path to a spirv vertex shader.
+                std::string                                    frag_shader;  ///< The path to a spirv fragment shader.
+                std::vector<VkVertexInputAttributeDescription> attributes;   ///< The vertex input attributes for the vertex shader.
+            };
+
             /// @brief Initialize the descriptor pool used for BVH rendering.
             void SetupDescriptorPool();
 
@@ -84,7 +99,7 @@ namespace rra
             /// @brief Initialize the BVH renderer descriptor set configuration.
             void SetupDescriptorSet();
 
-            /// @brief Initialize the renderer pipelines for each geometry coloring mode.
+            /// @brief Initialize the wireframe pipelines and register the pipelines for each geometry coloring mode.
             void InitializePipelines();
 
             /// @brief Initialize a pipeline used to render BLAS geometry.
@@ -104,15 +119,24 @@ namespace rra
                                               VkCullModeFlags                                       cull_mode,
                                               bool                                                  wireframe_only) const;
 
-            /// @brief Creates a pipeline for a single geometry coloring mode.
+            /// @brief Registers the pipeline for a single geometry coloring mode. The pipeline isn't created until the mode is first drawn.
             /// @param vert_shader The path to a spirv vertex shader.
             /// @param frag_shader The path to a spirv fragment shader.
             /// @param attributes The vertex input attributes for the vertex shader.
             /// @param coloring_mode The geometry coloring mode that the shaders implement.
-            void InitializeGeometryColorPipeline(const std::string&                                    vert_shader,
-                                                 const std::string&                                    frag_shader,
-                                                 const std::vector<VkVertexInputAttributeDescription>& attributes,
-                                                 GeometryColoringMode                                  coloring_mode);
+            void RegisterGeometryColorPipeline(const std::string&                                    vert_shader,
+                                               const std::string&                                    frag_shader,
+                                               const std::vector<VkVertexInputAttributeDescription>& attributes,
+                                               GeometryColoringMode                                  coloring_mode);
+
+            /// @brief Creates the pipelines for a single registered geometry coloring mode.
+            /// @param coloring_mode The geometry coloring mode to create the pipelines for.
+            void InitializeGeometryColorPipeline(GeometryColoringMode coloring_mode);
+
+            /// @brief Get the pipelines for a geometry coloring mode, creating them the first time the mode is used.
+            /// @param coloring_mode The geometry coloring mode.
+            /// @returns The pipelines for each cull mode.
+            const TriangleCullPipelines& GetGeometryColorPipelines(GeometryColoringMode coloring_mode);
 
             /// @brief Creates a pipeline for wireframe display.
             /// @param vert_shader The path to a spirv vertex shader.
@@ -170,16 +194,10 @@ namespace rra
             };
             std::vector<RenderInstruction> render_instructions_;  ///< The instructions to render.
 
-            struct TriangleCullPipelines
-            {
-                VkPipeline cull_none;
-                VkPipeline cull_front;
-                VkPipeline cull_back;
-            };
-
-            TriangleCullPipelines                                           geometry_wireframe_only_pipeline_;  ///< The wireframe only pipeline.
-            std::unordered_map<GeometryColoringMode, TriangleCullPipelines> geometry_color_pipelines_;  ///< Pipelines used for each geometry coloring mode.
-            GeometryColoringMode                                            coloring_mode_;             ///< The geometry color mode currently being drawn.
+            TriangleCullPipelines                                                      geometry_wireframe_only_pipeline_;      ///< The wireframe only pipeline.
+            std::unordered_map<GeometryColoringMode, TriangleCullPipelines>            geometry_color_pipelines_;              ///< Pipelines used for each geometry coloring mode, once created.
+            std::unordered_map<GeometryColoringMode, GeometryColorPipelineDescription> geometry_color_pipeline_descriptions_;  ///< How to create the pipelines for each mode.
+            GeometryColoringMode                                                       coloring_mode_;                         ///< The geometry color mode currently being drawn.
 
             std::vector<VkDescriptorSet> blas_mesh_descriptor_sets_;  ///< The descriptor sets used for rendering BVH geometry.
 
@@ -197,6 +215,7 @@ namespace rra
             glm::mat4 last_view_projection_matrix_ = glm::mat4(1.0f);  ///< The last view projection combined matrix to check if culling should be re-triggered.
             uint64_t  last_scene_iteration_ =
                 UINT64_MAX;  ///< Last rendered scene iteration to keep track of changes. Set to UINT64_MAX so that the first pass will be picked up.
+            uint64_t  last_instance_map_iteration_ = UINT64_MAX;  ///< Last rendered instance map iteration, which changes when a frustum culling result arrives.
         };
     }  // namespace renderer
 }  // namespace rra
@@ -187,7 +187,7 @@ namespace rra
 
             // Create the pipeline.
             create_result =
-                vkCreateGraphicsPipelines(context->device->GetDevice(), VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &orientation_gizmo_pipeline_);
+                vkCreateGraphicsPipelines(context->device->GetDevice(), context->device->GetPipelineCache(), 1, &pipeline_create_info, nullptr, &orientation_gizmo_pipeline_);
             CheckResult(create_result, "Failed to create orientation gizmo pipeline.");
 
             // Destroy shader modules.
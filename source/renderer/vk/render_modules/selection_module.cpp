@@ -184,7 +184,7 @@ namespace rra
 
             pipeline_create_info.pVertexInputState = &vertex_input_state_info;
 
-            create_result = vkCreateGraphicsPipelines(context->device->GetDevice(), VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &pipeline_);
+            create_result = vkCreateGraphicsPipelines(context->device->GetDevice(), context->device->GetPipelineCache(), 1, &pipeline_create_info, nullptr, &pipeline_);
             CheckResult(create_result, "Failed to create pipeline.");
 
             SetupDescriptorPool();
@@ -129,7 +129,7 @@ namespace rra
 
             // Create the render pipeline.
             VkResult create_result =
-                vkCreateGraphicsPipelines(context->device->GetDevice(), VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &trace_traversal_pipeline_);
+                vkCreateGraphicsPipelines(context->device->GetDevice(), context->device->GetPipelineCache(), 1, &pipeline_create_info, nullptr, &trace_traversal_pipeline_);
             CheckResult(create_result, "Failed to create pipeline.");
 
             // Create the compute pipeline.
@@ -139,7 +139,7 @@ namespace rra
             compute_pipeline_create_info.basePipelineIndex           = -1;
             compute_pipeline_create_info.basePipelineHandle          = VK_NULL_HANDLE;
             create_result =
-                vkCreateComputePipelines(context->device->GetDevice(), VK_NULL_HANDLE, 1, &compute_pipeline_create_info, nullptr, &compute_pipeline_);
+                vkCreateComputePipelines(context->device->GetDevice(), context->device->GetPipelineCache(), 1, &compute_pipeline_create_info, nullptr, &compute_pipeline_);
             CheckResult(create_result, "Failed to create compute pipeline.");
 
             // Create the subsample pipeline.
@@ -149,7 +149,7 @@ namespace rra
             subsample_pipeline_create_info.basePipelineIndex           = -1;
             subsample_pipeline_create_info.basePipelineHandle          = VK_NULL_HANDLE;
             create_result =
-                vkCreateComputePipelines(context->device->GetDevice(), VK_NULL_HANDLE, 1, &subsample_pipeline_create_info, nullptr, &subsample_pipeline_);
+                vkCreateComputePipelines(context->device->GetDevice(), context->device->GetPipelineCache(), 1, &subsample_pipeline_create_info, nullptr, &subsample_pipeline_);
             CheckResult(create_result, "Failed to create subsample pipeline.");
 
             // Cleanup shader modules.
@@ -659,6 +659,8 @@ namespace rra
             write_descriptor_3.pBufferInfo          = &instance_info;
             write_descriptor_3.descriptorCount      = 1;
 
+            // The traversal can reach any blas, so the whole tree has to be on the device.
+            GetVkGraphicsContext()->WaitForUploads();
             auto vk_tree = GetVkGraphicsContext()->GetBlasTraversalTree();
 
             // Binding 4 : Volume Storage for blasses
@@ -175,9 +175,10 @@ namespace rra
             UpdateHeatmap();
 
             RendererVulkanStateTracker current_state;
-            current_state.renderer_iteration_  = renderer_iteration_;
-            current_state.scene_iteration      = scene_info_.scene_iteration;
-            current_state.scene_uniform_buffer = scene_uniform_buffer_;
+            current_state.renderer_iteration_    = renderer_iteration_;
+            current_state.scene_iteration        = scene_info_.scene_iteration;
+            current_state.instance_map_iteration = scene_info_.instance_map_iteration;
+            current_state.scene_uniform_buffer   = scene_uniform_buffer_;
 
             // Start with a new set of command buffers for the frame.
             auto cmd = command_buffer_ring_.GetNewCommandBuffer();
@@ -229,17 +230,52 @@ namespace rra
             command_buffers_per_frame_[current_frame_index].push_back(cmd);
         }
 
-        void RendererVulkan::DrawFrame()
+        bool RendererVulkan::UpdateFrame()
         {
             camera_.ProcessInputs();
 
             // This is where the data is passed from the scene to the renderer each frame.
             // Must be called after camera processes inputs to have up to date frustum culling.
+            // The culling itself runs in the background, so this picks up the latest finished result without waiting.
             if (update_scene_info_ != nullptr)
             {
                 update_scene_info_(scene_info_, &camera_, (bool)FRUSTUM_CULLING_ENABLE, (bool)FORCE_FRUSTUM_CULLING_UPDATES);
             }
 
+            // Keep checking for the background results, as nothing else will say when they arrive.
+            if (scene_info_.background_work_pending)
+            {
+                frame_scheduler_.KeepAwake();
+            }
+
+            if (FORCE_UPDATES)
+            {
+                frame_scheduler_.MarkDirty();
+            }
+
+            // Keep drawing while the scene geometry streams in, and rebuild the instances as more of it arrives.
+            auto graphics_context = GetVkGraphicsContext();
+            if (graphics_context->UpdateUploads())
+            {
+                frame_scheduler_.MarkDirty();
+            }
+            if (graphics_context->GetUploadIteration() != upload_iteration_)
+            {
+                upload_iteration_ = graphics_context->GetUploadIteration();
+                scene_info_.instance_map_iteration++;
+            }
+
+            FrameState state;
+            state.view_projection        = camera_.GetViewProjection();
+            state.scene_iteration        = scene_info_.scene_iteration;
+            state.instance_map_iteration = scene_info_.instance_map_iteration;
+            state.width                  = width_;
+            state.height                 = height_;
+            return frame_scheduler_.CheckForNewFrame(state);
+        }
+
+        void RendererVulkan::DrawFrame()
+        {
             HandleSceneChanged();
 
             BuildScene();
@@ -250,6 +286,7 @@ namespace rra
         void RendererVulkan::MarkAsDirty()
         {
             renderer_iteration_++;
+            frame_scheduler_.MarkDirty();
         }
 
         Device& RendererVulkan::GetDevice()
@@ -540,7 +577,7 @@ namespace rra
         bool RendererVulkanStateTracker::Equal(const RendererVulkanStateTracker& other) const
         {
             return renderer_iteration_ == other.renderer_iteration_ && scene_iteration == other.scene_iteration &&
-                   EqualsSceneUniformBuffer(scene_uniform_buffer, other.scene_uniform_buffer);
+                   instance_map_iteration == other.instance_map_iteration && EqualsSceneUniformBuffer(scene_uniform_buffer, other.scene_uniform_buffer);
         }
 
         bool EqualsSceneUniformBuffer(const SceneUniformBuffer& a, const SceneUniformBuffer& b)
@@ -26,9 +26,10 @@ namespace rra
         /// @brief State tracking data store for RendererVulkan.
         struct RendererVulkanStateTracker
         {
-            uint64_t           renderer_iteration_  = 0;   ///< The last renderer iteration.
-            uint64_t           scene_iteration      = 0;   ///< The last scene iteration.
-            SceneUniformBuffer scene_uniform_buffer = {};  ///< The last view projection matrix.
+            uint64_t           renderer_iteration_    = 0;   ///< The last renderer iteration.
+            uint64_t           scene_iteration        = 0;   ///< The last scene iteration.
+            uint64_t           instance_map_iteration = 0;   ///< The last instance map iteration.
+            SceneUniformBuffer scene_uniform_buffer   = {};  ///< The last view projection matrix.
 
             /// @brief Check if the other state is equal to this.
             ///
@@ -82,6 +83,11 @@ namespace rra
             /// @brief Handle the renderer resizing.
             virtual void HandleDimensionsUpdated() override;
 
+            /// @brief Process the camera inputs and update the scene info, ready for the next frame.
+            ///
+            /// @returns True if anything changed since the last frame was drawn, so a new frame needs drawing.
+            virtual bool UpdateFrame() override;
+
             /// @brief Draw the scene.
             virtual void DrawFrame() override;
 
@@ -187,6 +193,7 @@ namespace rra
             std::vector<RenderModule*> render_modules_;         ///< The list of render modules to aid rendering.
 
             uint64_t renderer_iteration_ = 0;  ///< The renderer iteration to track state for when the renderer is marked dirty.
+            uint64_t upload_iteration_   = 0;  ///< The last graphics context upload iteration seen.
 
             std::vector<RendererVulkanStateTracker> states_;  ///< The state tracking to provide efficient rendering.
         };
@@ -0,0 +1,244 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the upload scheduler.
+//=============================================================================
+
+#include "upload_scheduler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "public/rra_assert.h"
+
+namespace rra
+{
+    namespace renderer
+    {
+        const VkDeviceSize UploadScheduler::kDefaultStagingSlotSize;
+        const uint32_t     UploadScheduler::kStagingSlotCount;
+
+        /// @brief The alignment of each copy within a staging slot.
+        static const VkDeviceSize kStagingAlignment = 16;
+
+        bool UploadScheduler::Initialize(UploadDevice* device, VkDeviceSize slot_size)
+        {
+            RRA_ASSERT(device != nullptr);
+
+            uint8_t* mapped_data[kStagingSlotCount] = {};
+            if (!device->CreateSlots(kStagingSlotCount, slot_size, mapped_data))
+            {
+                device->DestroySlots();
+                return false;
+            }
+
+            device_    = device;
+            slot_size_ = slot_size;
+            for (uint32_t slot_index = 0; slot_index < kStagingSlotCount; slot_index++)
+            {
+                slots_[slot_index]             = {};
+                slots_[slot_index].mapped_data = mapped_data[slot_index];
+            }
+
+            current_slot_       = 0;
+            recording_          = false;
+            last_submit_ticket_ = 0;
+            completed_ticket_   = 0;
+            return true;
+        }
+
+        void UploadScheduler::Cleanup()
+        {
+            if (device_ == nullptr)
+            {
+                return;
+            }
+
+            WaitForAll();
+
+            device_->DestroySlots();
+            for (StagingSlot& slot : slots_)
+            {
+                slot = {};
+            }
+
+            device_ = nullptr;
+        }
+
+        VkDeviceSize UploadScheduler::GetSlotSize() const
+        {
+            return slot_size_;
+        }
+
+        void* UploadScheduler::Stage(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size)
+        {
+            return StageImpl(dst_buffer, dst_offset, size, true);
+        }
+
+        void* UploadScheduler::TryStage(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size)
+        {
+            return StageImpl(dst_buffer, dst_offset, size, false);
+        }
+
+        void* UploadScheduler::StageImpl(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size, bool wait)
+        {
+            RRA_ASSERT(size <= slot_size_);
+
+            // Move on to the next slot if the data doesn't fit in what is left of this one.
+            if (recording_)
+            {
+                VkDeviceSize offset = (slots_[current_slot_].used_size + kStagingAlignment - 1) & ~(kStagingAlignment - 1);
+                if (offset + size > slot_size_ && !Submit())
+                {
+                    return nullptr;
+                }
+            }
+
+            if (!BeginSlot(wait))
+            {
+                return nullptr;
+            }
+
+            StagingSlot& slot   = slots_[current_slot_];
+            VkDeviceSize offset = (slot.used_size + kStagingAlignment - 1) & ~(kStagingAlignment - 1);
+            slot.used_size      = offset + size;
+
+            device_->RecordCopy(current_slot_, offset, dst_buffer, dst_offset, size);
+
+            return slot.mapped_data + offset;
+        }
+
+        bool UploadScheduler::StageData(VkBuffer dst_buffer, VkDeviceSize dst_offset, const void* data, VkDeviceSize size)
+        {
+            const uint8_t* source = static_cast<const uint8_t*>(data);
+
+            while (size > 0)
+            {
+                VkDeviceSize chunk_size = std::min(size, slot_size_);
+
+                void* staging = Stage(dst_buffer, dst_offset, chunk_size);
+                if (staging == nullptr)
+                {
+                    return false;
+                }
+                std::memcpy(staging, source, static_cast<size_t>(chunk_size));
+
+                source += chunk_size;
+                dst_offset += chunk_size;
+                size -= chunk_size;
+            }
+
+            return true;
+        }
+
+        bool UploadScheduler::Submit()
+        {
+            if (!recording_)
+            {
+                return true;
+            }
+
+            recording_ = false;
+            if (!device_->SubmitSlot(current_slot_))
+            {
+                return false;
+            }
+
+            slots_[current_slot_].ticket = ++last_submit_ticket_;
+            current_slot_                = (current_slot_ + 1) % kStagingSlotCount;
+            return true;
+        }
+
+        uint64_t UploadScheduler::GetStagingTicket() const
+        {
+            return recording_ ? last_submit_ticket_ + 1 : last_submit_ticket_;
+        }
+
+        bool UploadScheduler::IsComplete(uint64_t ticket)
+        {
+            return ticket <= GetCompletedTicket();
+        }
+
+        uint64_t UploadScheduler::GetCompletedTicket()
+        {
+            // A ticket only counts as complete once every ticket before it is, so stop at the first one still in flight.
+            while (completed_ticket_ < last_submit_ticket_)
+            {
+                uint32_t next_slot_index = kStagingSlotCount;
+                for (uint32_t slot_index = 0; slot_index < kStagingSlotCount; slot_index++)
+                {
+                    if (slots_[slot_index].ticket == completed_ticket_ + 1)
+                    {
+                        next_slot_index = slot_index;
+                    }
+                }
+
+                // A ticket no longer in any slot was waited for when its slot was reused.
+                if (next_slot_index != kStagingSlotCount && !device_->IsSlotDone(next_slot_index))
+                {
+                    break;
+                }
+
+                completed_ticket_++;
+            }
+
+            return completed_ticket_;
+        }
+
+        void UploadScheduler::WaitForAll()
+        {
+            Submit();
+
+            for (uint32_t slot_index = 0; slot_index < kStagingSlotCount; slot_index++)
+            {
+                if (slots_[slot_index].ticket != 0)
+                {
+                    device_->WaitForSlot(slot_index);
+                    slots_[slot_index].ticket = 0;
+                }
+            }
+
+            completed_ticket_ = last_submit_ticket_;
+        }
+
+        bool UploadScheduler::BeginSlot(bool wait)
+        {
+            if (recording_)
+            {
+                return true;
+            }
+
+            StagingSlot& slot = slots_[current_slot_];
+
+            // The ring has wrapped around, so the GPU has to be done copying out of the slot before it is reused.
+            if (slot.ticket != 0)
+            {
+                if (wait)
+                {
+                    if (!device_->WaitForSlot(current_slot_))
+                    {
+                        return false;
+                    }
+                }
+                else if (!device_->IsSlotDone(current_slot_))
+                {
+                    return false;
+                }
+
+                // The slots are used in order, so every earlier ticket is complete too.
+                completed_ticket_ = std::max(completed_ticket_, slot.ticket);
+                slot.ticket       = 0;
+            }
+
+            if (!device_->BeginSlot(current_slot_))
+            {
+                return false;
+            }
+
+            slot.used_size = 0;
+            recording_     = true;
+            return true;
+        }
+    }  // namespace renderer
+}  // namespace rra
@@ -0,0 +1,209 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Declaration for the upload scheduler, which streams data to device
+///         buffers through a bounded staging ring.
+//=============================================================================
+
+#ifndef RRA_RENDERER_VK_UPLOAD_SCHEDULER_H_
+#define RRA_RENDERER_VK_UPLOAD_SCHEDULER_H_
+
+#include <volk/volk.h>
+
+namespace rra
+{
+    namespace renderer
+    {
+        /// @brief The device side of the upload scheduler: the staging slots, and the copies out of them.
+        ///
+        /// The scheduler only does the bookkeeping of the ring, so it can run against a mock device in the tests.
+        class UploadDevice
+        {
+        public:
+            /// @brief Destructor.
+            virtual ~UploadDevice() = default;
+
+            /// @brief Create the staging slots, each with persistently mapped memory and the commands copying out of it.
+            ///
+            /// @param [in]  slot_count      The number of slots.
+            /// @param [in]  slot_size       The size of each slot.
+            /// @param [out] out_mapped_data An array receiving the mapped memory of each slot.
+            ///
+            /// @returns True if the slots were created successfully.
+            virtual bool CreateSlots(uint32_t slot_count, VkDeviceSize slot_size, uint8_t** out_mapped_data) = 0;
+
+            /// @brief Destroy the staging slots. Nothing may be in flight.
+            virtual void DestroySlots() = 0;
+
+            /// @brief Start recording copies out of a slot. The slot has no submission in flight.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the recording was started successfully.
+            virtual bool BeginSlot(uint32_t slot_index) = 0;
+
+            /// @brief Record a copy out of a slot.
+            ///
+            /// @param [in] slot_index The slot.
+            /// @param [in] src_offset The offset of the data in the slot.
+            /// @param [in] dst_buffer The buffer to copy to.
+            /// @param [in] dst_offset The offset in the buffer to copy to.
+            /// @param [in] size The size of the copy.
+            virtual void RecordCopy(uint32_t slot_index, VkDeviceSize src_offset, VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size) = 0;
+
+            /// @brief Submit the copies recorded for a slot. Doesn't wait for them.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the submission was successful.
+            virtual bool SubmitSlot(uint32_t slot_index) = 0;
+
+            /// @brief Check if the submission of a slot has finished copying. Doesn't wait.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the copies have finished.
+            virtual bool IsSlotDone(uint32_t slot_index) = 0;
+
+            /// @brief Wait for the submission of a slot to finish copying.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the wait was successful.
+            virtual bool WaitForSlot(uint32_t slot_index) = 0;
+        };
+
+        /// @brief Streams data to device buffers through a ring of staging buffers on the transfer queue.
+        ///
+        /// Data is written into the current staging slot, and the copies out of it are recorded as it goes. A full slot is
+        /// submitted and the next one is used, so the CPU fills one slot while the GPU copies out of the others. When the
+        /// ring wraps around, Stage waits for the oldest slot, while TryStage returns so the caller can come back later.
+        /// Either way, the staging memory is bounded to the ring size.
+        ///
+        /// Each submission gets a ticket, with later submissions getting larger tickets. Data can be checked for arrival
+        /// by taking the staging ticket after writing it, and checking the ticket is complete.
+        class UploadScheduler
+        {
+        public:
+            /// @brief The default size of each staging slot, which is the most data a single Stage call can take.
+            static const VkDeviceSize kDefaultStagingSlotSize = 16 * 1024 * 1024;
+
+            /// @brief The number of staging slots in the ring.
+            static const uint32_t kStagingSlotCount = 4;
+
+            /// @brief Constructor.
+            UploadScheduler() = default;
+
+            /// @brief Destructor.
+            ~UploadScheduler() = default;
+
+            /// @brief Create the staging ring.
+            ///
+            /// @param [in] device The device to upload to.
+            /// @param [in] slot_size The size of each staging slot.
+            ///
+            /// @returns True if the staging ring was created successfully.
+            bool Initialize(UploadDevice* device, VkDeviceSize slot_size = kDefaultStagingSlotSize);
+
+            /// @brief Wait for the uploads in flight, then destroy the staging ring.
+            void Cleanup();
+
+            /// @brief Get the size of each staging slot.
+            ///
+            /// @returns The slot size.
+            VkDeviceSize GetSlotSize() const;
+
+            /// @brief Reserve staging memory for a copy into a device buffer, waiting for a slot if the ring is full.
+            ///
+            /// The data must be written to the returned memory before the next call to Stage, TryStage or Submit.
+            ///
+            /// @param [in] dst_buffer The buffer to copy to.
+            /// @param [in] dst_offset The offset in the buffer to copy to.
+            /// @param [in] size The size of the copy. Must be at most the slot size.
+            ///
+            /// @returns The staging memory to write the data to, or nullptr on failure.
+            void* Stage(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size);
+
+            /// @brief Reserve staging memory for a copy into a device buffer, without waiting.
+            ///
+            /// @param [in] dst_buffer The buffer to copy to.
+            /// @param [in] dst_offset The offset in the buffer to copy to.
+            /// @param [in] size The size of the copy. Must be at most the slot size.
+            ///
+            /// @returns The staging memory to write the data to, or nullptr if every slot is still in flight or on failure.
+            void* TryStage(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size);
+
+            /// @brief Stage a copy of host data into a device buffer, split over as many slots as needed.
+            ///
+            /// @param [in] dst_buffer The buffer to copy to.
+            /// @param [in] dst_offset The offset in the buffer to copy to.
+            /// @param [in] data The data to copy.
+            /// @param [in] size The size of the data.
+            ///
+            /// @returns True if the data was staged successfully.
+            bool StageData(VkBuffer dst_buffer, VkDeviceSize dst_offset, const void* data, VkDeviceSize size);
+
+            /// @brief Submit the copies staged so far to the transfer queue. Doesn't wait for them.
+            ///
+            /// @returns True if the submission was successful.
+            bool Submit();
+
+            /// @brief Get the ticket the data staged so far will be complete at.
+            ///
+            /// @returns The ticket.
+            uint64_t GetStagingTicket() const;
+
+            /// @brief Check if all the submissions up to a ticket have finished copying. Doesn't wait.
+            ///
+            /// @param [in] ticket The ticket to check.
+            ///
+            /// @returns True if the ticket is complete.
+            bool IsComplete(uint64_t ticket);
+
+            /// @brief Get the last ticket with all the submissions up to it finished copying. Doesn't wait.
+            ///
+            /// @returns The completed ticket.
+            uint64_t GetCompletedTicket();
+
+            /// @brief Submit anything staged and wait for all the copies to finish.
+            void WaitForAll();
+
+        private:
+            /// @brief A staging buffer in the ring.
+            struct StagingSlot
+            {
+                uint8_t*     mapped_data = nullptr;  ///< The persistently mapped staging memory.
+                VkDeviceSize used_size   = 0;        ///< The staging memory used so far.
+                uint64_t     ticket      = 0;        ///< The ticket of the submission in flight, or 0 if none.
+            };
+
+            /// @brief Reserve staging memory in the current slot, moving on to the next slot if it doesn't fit.
+            ///
+            /// @param [in] dst_buffer The buffer to copy to.
+            /// @param [in] dst_offset The offset in the buffer to copy to.
+            /// @param [in] size The size of the copy.
+            /// @param [in] wait True to wait for the next slot if it is still in flight.
+            ///
+            /// @returns The staging memory, or nullptr if the slot is still in flight or on failure.
+            void* StageImpl(VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size, bool wait);
+
+            /// @brief Make the current slot ready to take data.
+            ///
+            /// @param [in] wait True to wait for the GPU to finish with the slot, false to give up if it hasn't.
+            ///
+            /// @returns True if the slot is ready.
+            bool BeginSlot(bool wait);
+
+            UploadDevice* device_                   = nullptr;                  ///< The device to upload to.
+            VkDeviceSize  slot_size_                = kDefaultStagingSlotSize;  ///< The size of each staging slot.
+            StagingSlot   slots_[kStagingSlotCount] = {};                       ///< The staging ring.
+            uint32_t      current_slot_             = 0;                        ///< The slot data is being staged into.
+            bool          recording_                = false;                    ///< True if the current slot is recording copies.
+            uint64_t      last_submit_ticket_       = 0;                        ///< The ticket of the last submission.
+            uint64_t      completed_ticket_         = 0;                        ///< All tickets up to this are known to be complete.
+        };
+    }  // namespace renderer
+}  // namespace rra
+
+#endif  // RRA_RENDERER_VK_UPLOAD_SCHEDULER_H_
@@ -6,6 +6,10 @@
 //=============================================================================
 
 #include "vk_graphics_context.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "public/rra_error.h"
 #include "public/rra_blas.h"
 #include "framework/ext_debug_utils.h"
@@ -112,6 +116,10 @@ namespace rra
         {
             if (initialized_)
             {
+                // Anything not yet staged is dropped, but the copies in flight have to finish before the buffers go.
+                pending_uploads_ = {};
+                upload_scheduler_.Cleanup();
+                uploading_ = false;
                 device_.GPUFlush();
                 device_.DestroyBuffer(geometry_buffer_, geometry_buffer_allocation_);
 
@@ -156,122 +164,191 @@ namespace rra
             traversal_tree_blas_offsets_ = info.traversal_tree_blas_structure_offsets;
             VkTraversalTree vk_tree;
 
-            VkBuffer      volume_staging_buffer     = VK_NULL_HANDLE;
-            VmaAllocation volume_staging_allocation = VK_NULL_HANDLE;
+            upload_device_.Initialize(&device_);
+            if (!upload_scheduler_.Initialize(&upload_device_))
+            {
+                return false;
+            }
+
+            size_t vertex_count = 0;
+            for (const CompactMesh& mesh : info.blas_meshes)
+            {
+                vertex_count += mesh.GetVertexCount();
+            }
 
-            VkBuffer      triangle_staging_buffer     = VK_NULL_HANDLE;
-            VmaAllocation triangle_staging_allocation = VK_NULL_HANDLE;
+            auto volume_buffer_size = info.blas_tree.volumes.size() * sizeof(TraversalVolume);
+            auto vertex_buffer_size = vertex_count * sizeof(RraVertex);
 
-            VkResult result;
+            // The buffers are written on the transfer queue, which may be a separate queue family.
+            PRE_RENDER_CHECK_HEALTH();
+            device_.CreateBuffer(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                 VMA_MEMORY_USAGE_GPU_ONLY,
+                                 vk_tree.volume_buffer,
+                                 vk_tree.volume_allocation,
+                                 nullptr,
+                                 volume_buffer_size,
+                                 true);
 
-            VkCommandPool   command_pool;
-            VkCommandBuffer command_buffer;
+            PRE_RENDER_CHECK_HEALTH();
+            device_.CreateBuffer(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                 VMA_MEMORY_USAGE_GPU_ONLY,
+                                 vk_tree.vertex_buffer,
+                                 vk_tree.vertex_allocation,
+                                 nullptr,
+                                 vertex_buffer_size,
+                                 true);
 
-            VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
-            pool_info.queueFamilyIndex        = device_.GetGraphicsQueueFamilyIndex();
+            SetObjectName(device_.GetDevice(), VK_OBJECT_TYPE_BUFFER, (uint64_t)vk_tree.volume_buffer, "volumeBufferContext");
+            SetObjectName(device_.GetDevice(), VK_OBJECT_TYPE_BUFFER, (uint64_t)vk_tree.vertex_buffer, "triangleBufferContext");
 
-            result = vkCreateCommandPool(device_.GetDevice(), &pool_info, nullptr, &command_pool);
-            PRE_RENDER_CHECK_RESULT(result, "Failed to create global upload command buffer pool.");
+            traversal_tree_ = vk_tree;
 
-            VkCommandBufferAllocateInfo alloc_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
-            alloc_info.commandPool                 = command_pool;
-            alloc_info.level                       = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-            alloc_info.commandBufferCount          = 1;
+            for (size_t i = 0; i < info.traversal_tree_blas_triangle_offsets.size(); i++)
+            {
+                BlasDrawInstruction geometry_instruction = {};
+                geometry_instruction.vertex_index        = info.traversal_tree_blas_triangle_offsets[i];
+                geometry_instruction.vertex_count        = info.traversal_tree_blas_triangle_count[i];
+                geometry_instruction.vertex_buffer       = vk_tree.vertex_buffer;
+                geometry_instructions_.push_back(geometry_instruction);
+            }
 
-            result = vkAllocateCommandBuffers(device_.GetDevice(), &alloc_info, &command_buffer);
-            PRE_RENDER_CHECK_RESULT(result, "Failed to allocate global upload command buffer.");
+            // The scene info only lives for the call, so keep the data until it has all been staged. The blases are
+            // left out of the drawing until their triangles arrive.
+            pending_uploads_         = {};
+            pending_uploads_.volumes = info.blas_tree.volumes;
+            pending_uploads_.meshes  = info.blas_meshes;
+            blas_upload_tickets_.assign(info.blas_meshes.size(), UINT64_MAX);
+            uploading_    = true;
+            staging_done_ = false;
 
-            VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
-            result                              = vkBeginCommandBuffer(command_buffer, &begin_info);
-            PRE_RENDER_CHECK_RESULT(result, "Failed to begin global upload command buffer recording.");
+            // Fill what the staging ring has room for now, and stream the rest from UpdateUploads as the copies finish.
+            PRE_RENDER_CHECK_HEALTH();
+            return StreamUploads(false);
+        }
 
+        bool VkGraphicsContext::StreamUploads(bool wait)
+        {
+            if (staging_done_)
             {
-                auto buffer_size = info.blas_tree.volumes.size() * sizeof(TraversalVolume);
-
-                PRE_RENDER_CHECK_HEALTH();
-                device_.CreateBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                     VMA_MEMORY_USAGE_CPU_ONLY,
-                                     volume_staging_buffer,
-                                     volume_staging_allocation,
-                                     info.blas_tree.volumes.data(),
-                                     buffer_size);
-
-                PRE_RENDER_CHECK_HEALTH();
-                device_.CreateBuffer(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                                     VMA_MEMORY_USAGE_GPU_ONLY,
-                                     vk_tree.volume_buffer,
-                                     vk_tree.volume_allocation,
-                                     nullptr,
-                                     buffer_size);
-
-                SetObjectName(device_.GetDevice(), VK_OBJECT_TYPE_BUFFER, (uint64_t)volume_staging_buffer, "volumeStagingBufferContext");
-                SetObjectName(device_.GetDevice(), VK_OBJECT_TYPE_BUFFER, (uint64_t)vk_tree.volume_buffer, "volumeBufferContext");
-
-                VkBufferCopy copy_region = {};
-                copy_region.size         = buffer_size;
-                vkCmdCopyBuffer(command_buffer, volume_staging_buffer, vk_tree.volume_buffer, 1, &copy_region);
+                return true;
             }
 
+            PendingUploads& pending = pending_uploads_;
+            const auto      stage   = [this, wait](VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size) {
+                return wait ? upload_scheduler_.Stage(buffer, offset, size) : upload_scheduler_.TryStage(buffer, offset, size);
+            };
+
+            // The volumes first, as they are plain data.
+            const VkDeviceSize slot_size          = upload_scheduler_.GetSlotSize();
+            const VkDeviceSize volume_buffer_size = pending.volumes.size() * sizeof(TraversalVolume);
+            while (pending.volume_offset < volume_buffer_size)
             {
-                auto buffer_size = info.blas_tree.vertices.size() * sizeof(RraVertex);
-
-                PRE_RENDER_CHECK_HEALTH();
-                device_.CreateBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                     VMA_MEMORY_USAGE_CPU_ONLY,
-                                     triangle_staging_buffer,
-                                     triangle_staging_allocation,
-                                     info.blas_tree.vertices.data(),
-                                     buffer_size);
-
-                PRE_RENDER_CHECK_HEALTH();
-                device_.CreateBuffer(VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                                     VMA_MEMORY_USAGE_GPU_ONLY,
-                                     vk_tree.vertex_buffer,
-                                     vk_tree.vertex_allocation,
-                                     nullptr,
-                                     buffer_size);
-
-                SetObjectName(device_.GetDevice(), VK_OBJECT_TYPE_BUFFER, (uint64_t)triangle_staging_buffer, "triangleStagingBufferContext");
-                SetObjectName(device_.GetDevice(), VK_OBJECT_TYPE_BUFFER, (uint64_t)vk_tree.vertex_buffer, "triangleBufferContext");
-
-                VkBufferCopy copy_region = {};
-                copy_region.size         = buffer_size;
-                vkCmdCopyBuffer(command_buffer, triangle_staging_buffer, vk_tree.vertex_buffer, 1, &copy_region);
+                VkDeviceSize chunk_size = std::min(volume_buffer_size - pending.volume_offset, slot_size);
+
+                void* staging = stage(traversal_tree_.volume_buffer, pending.volume_offset, chunk_size);
+                if (staging == nullptr)
+                {
+                    return wait ? false : upload_scheduler_.Submit();
+                }
+
+                std::memcpy(staging, reinterpret_cast<const uint8_t*>(pending.volumes.data()) + pending.volume_offset, static_cast<size_t>(chunk_size));
+                pending.volume_offset += chunk_size;
             }
 
-            result = vkEndCommandBuffer(command_buffer);
-            PRE_RENDER_CHECK_RESULT(result, "Failed to end global upload command buffer recording.");
+            // The meshes are decoded into the staging ring a slot at a time, so the CPU decodes the next part of the
+            // meshes while the GPU copies the last. Each BLAS is ready to draw once the slot holding its end has been copied.
+            const size_t triangles_per_chunk = static_cast<size_t>(slot_size / (3 * sizeof(RraVertex)));
+            while (pending.blas_index < pending.meshes.size())
+            {
+                const CompactMesh& mesh = pending.meshes[pending.blas_index];
+
+                while (pending.first_triangle < mesh.GetTriangleCount())
+                {
+                    size_t       triangle_count = std::min(mesh.GetTriangleCount() - pending.first_triangle, triangles_per_chunk);
+                    VkDeviceSize chunk_size     = triangle_count * 3 * sizeof(RraVertex);
+
+                    void* staging = stage(traversal_tree_.vertex_buffer, pending.vertex_offset, chunk_size);
+                    if (staging == nullptr)
+                    {
+                        // Submit what has been staged, so the copies can go ahead while the ring drains.
+                        return wait ? false : upload_scheduler_.Submit();
+                    }
+
+                    mesh.Decode(pending.first_triangle, triangle_count, static_cast<RraVertex*>(staging));
+                    pending.first_triangle += triangle_count;
+                    pending.vertex_offset += chunk_size;
+                }
+
+                blas_upload_tickets_[pending.blas_index] = upload_scheduler_.GetStagingTicket();
+                pending.blas_index++;
+                pending.first_triangle = 0;
+            }
 
-            VkSubmitInfo submit_info       = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
-            submit_info.commandBufferCount = 1;
-            submit_info.pCommandBuffers    = &command_buffer;
+            if (!upload_scheduler_.Submit())
+            {
+                return false;
+            }
+            final_upload_ticket_ = upload_scheduler_.GetStagingTicket();
+            staging_done_        = true;
 
-            result = vkQueueSubmit(device_.GetGraphicsQueue(), 1, &submit_info, VK_NULL_HANDLE);
-            PRE_RENDER_CHECK_RESULT(result, "Failed to submit global buffer uploads to the graphics queue.");
+            // Everything is in the staging ring or on its way to the device, so the host copy is no longer needed.
+            pending_uploads_ = {};
+            return true;
+        }
 
-            PRE_RENDER_CHECK_HEALTH();
-            device_.GPUFlush();
+        bool VkGraphicsContext::IsBlasUploaded(uint64_t blas_index)
+        {
+            return upload_scheduler_.IsComplete(blas_upload_tickets_[blas_index]);
+        }
 
-            vkDestroyCommandPool(device_.GetDevice(), command_pool, nullptr);
+        bool VkGraphicsContext::UpdateUploads()
+        {
+            if (!uploading_)
+            {
+                return false;
+            }
 
-            PRE_RENDER_CHECK_HEALTH();
-            device_.DestroyBuffer(volume_staging_buffer, volume_staging_allocation);
+            // Stage more of the data if the copies have made room for it.
+            if (!StreamUploads(false))
+            {
+                return false;
+            }
 
-            PRE_RENDER_CHECK_HEALTH();
-            device_.DestroyBuffer(triangle_staging_buffer, triangle_staging_allocation);
+            uint64_t completed_ticket = upload_scheduler_.GetCompletedTicket();
+            if (!staging_done_ || completed_ticket < final_upload_ticket_)
+            {
+                if (completed_ticket != completed_upload_ticket_)
+                {
+                    completed_upload_ticket_ = completed_ticket;
+                    upload_iteration_++;
+                }
+                return true;
+            }
 
-            traversal_tree_ = vk_tree;
+            // Everything has arrived, so the staging ring is no longer needed.
+            WaitForUploads();
+            return false;
+        }
 
-            for (size_t i = 0; i < info.traversal_tree_blas_triangle_offsets.size(); i++)
+        void VkGraphicsContext::WaitForUploads()
+        {
+            if (!uploading_)
             {
-                BlasDrawInstruction geometry_instruction = {};
-                geometry_instruction.vertex_index        = info.traversal_tree_blas_triangle_offsets[i];
-                geometry_instruction.vertex_count        = info.traversal_tree_blas_triangle_count[i];
-                geometry_instruction.vertex_buffer       = vk_tree.vertex_buffer;
-                geometry_instructions_.push_back(geometry_instruction);
+                return;
             }
 
-            return true;
+            StreamUploads(true);
+            upload_scheduler_.Cleanup();
+
+            blas_upload_tickets_.assign(blas_upload_tickets_.size(), 0);
+            pending_uploads_ = {};
+            uploading_       = false;
+            upload_iteration_++;
+        }
+
+        uint64_t VkGraphicsContext::GetUploadIteration() const
+        {
+            return upload_iteration_;
         }
 
     }  // namespace renderer
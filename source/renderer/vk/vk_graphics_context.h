@@ -10,6 +10,8 @@
 
 #include "framework/device.h"
 #include "public/renderer_interface.h"
+#include "upload_scheduler.h"
+#include "vulkan_upload_device.h"
 #include <map>
 
 namespace rra
@@ -57,6 +59,27 @@ namespace rra
             /// @returns An instruction on how to draw the blas.
             BlasDrawInstruction GetBlasDrawInstruction(uint64_t blas_index);
 
+            /// @brief Check if a blas has finished uploading and can be drawn.
+            ///
+            /// @param [in] blas_index The blas index.
+            ///
+            /// @returns True if the geometry of the blas is on the device.
+            bool IsBlasUploaded(uint64_t blas_index);
+
+            /// @brief Stage as much of the remaining data as the staging ring has room for, check on the uploads still in
+            /// flight, and release the staging memory once they have all finished. Doesn't wait.
+            ///
+            /// @returns True while uploads are still in flight.
+            bool UpdateUploads();
+
+            /// @brief Stage all of the remaining data, wait for the uploads to finish, and release the staging memory.
+            void WaitForUploads();
+
+            /// @brief Get the upload iteration, which changes whenever more blases have finished uploading.
+            ///
+            /// @returns The upload iteration.
+            uint64_t GetUploadIteration() const;
+
             /// @brief Get the uploaded traversal tree for a blas index.
             ///
             /// @param [in] blas_index The blas index.
@@ -106,11 +129,29 @@ namespace rra
             void SetSceneInfo(RendererSceneInfo* scene_info);
 
         private:
-            /// @brief Collects and uploads the traversal trees to the device.
+            /// @brief The data still to be streamed to the device, and how far the streaming has got.
+            struct PendingUploads
+            {
+                std::vector<TraversalVolume> volumes;             ///< The traversal tree volumes.
+                std::vector<CompactMesh>     meshes;              ///< The triangles of each blas.
+                VkDeviceSize                 volume_offset  = 0;  ///< The offset of the next volume data to stage.
+                size_t                       blas_index     = 0;  ///< The blas of the next triangles to stage.
+                size_t                       first_triangle = 0;  ///< The next triangle of the blas to stage.
+                VkDeviceSize                 vertex_offset  = 0;  ///< The offset in the vertex buffer of the next triangle.
+            };
+
+            /// @brief Collects the traversal trees, creates their buffers and starts streaming them to the device.
             ///
             /// returns True on successful upload.
             bool CollectAndUploadTraversalTrees(const GraphicsContextSceneInfo& info);
 
+            /// @brief Stage the remaining data a chunk at a time, submitting each slot as it fills.
+            ///
+            /// @param [in] wait True to wait for the staging ring to have room, false to stop once it is full.
+            ///
+            /// returns True if the staging was successful, even if it stopped early.
+            bool StreamUploads(bool wait);
+
             Device                           device_;                                       ///< The renderer device.
             WindowInfo                       window_info_;                                  ///< The window information.
             std::vector<BlasDrawInstruction> geometry_instructions_;                        ///< Mapping from BLAS to a geometry address.
@@ -119,6 +160,15 @@ namespace rra
             VkTraversalTree                  traversal_tree_;                               ///< The traversal tree.
             std::vector<uint32_t>            traversal_tree_blas_offsets_;                  ///< The offsets of the traversal tree.
             RendererSceneInfo*               scene_info_;                                   ///< Information needed to render the scene.
+            VulkanUploadDevice               upload_device_;                                ///< Runs the copies on the transfer queue.
+            UploadScheduler                  upload_scheduler_;                             ///< Streams the traversal trees to the device.
+            PendingUploads                   pending_uploads_;                              ///< The data still to be staged.
+            std::vector<uint64_t>            blas_upload_tickets_;                          ///< The upload ticket each blas is ready at.
+            bool                             uploading_                  = false;           ///< True until all the uploads have finished.
+            bool                             staging_done_               = false;           ///< True once all the data has been staged.
+            uint64_t                         final_upload_ticket_        = 0;               ///< The ticket all uploads are done at.
+            uint64_t                         completed_upload_ticket_    = 0;               ///< The last completed ticket seen by UpdateUploads.
+            uint64_t                         upload_iteration_           = 0;               ///< Changes whenever more blases finish uploading.
 
             /// We load our contents in a seperate thread so we can't show the error window and exit until we join main thread.
             bool error_window_primed_ = false;  /// A flag to track if the error window can be shown if the vulkan crashes after the loading has been complete.
@@ -0,0 +1,181 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation for the Vulkan upload device.
+//=============================================================================
+
+#include "vulkan_upload_device.h"
+
+#include "public/rra_assert.h"
+#include "util_vulkan.h"
+
+namespace rra
+{
+    namespace renderer
+    {
+        void VulkanUploadDevice::Initialize(Device* device)
+        {
+            RRA_ASSERT(device != nullptr);
+
+            device_ = device;
+            queue_  = device_->GetTransferQueue();
+        }
+
+        bool VulkanUploadDevice::CreateSlots(uint32_t slot_count, VkDeviceSize slot_size, uint8_t** out_mapped_data)
+        {
+            RRA_ASSERT(device_ != nullptr);
+
+            VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+            pool_info.flags                   = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            pool_info.queueFamilyIndex        = device_->GetTransferQueueFamilyIndex();
+
+            VkResult result = vkCreateCommandPool(device_->GetDevice(), &pool_info, nullptr, &command_pool_);
+            CheckResult(result, "Failed to create the upload command pool.");
+            if (result != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            slots_.resize(slot_count);
+            for (uint32_t slot_index = 0; slot_index < slot_count; slot_index++)
+            {
+                Slot& slot = slots_[slot_index];
+
+                VkCommandBufferAllocateInfo alloc_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+                alloc_info.commandPool                 = command_pool_;
+                alloc_info.level                       = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                alloc_info.commandBufferCount          = 1;
+
+                result = vkAllocateCommandBuffers(device_->GetDevice(), &alloc_info, &slot.command_buffer);
+                CheckResult(result, "Failed to allocate an upload command buffer.");
+                if (result != VK_SUCCESS)
+                {
+                    return false;
+                }
+
+                VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+
+                result = vkCreateFence(device_->GetDevice(), &fence_info, nullptr, &slot.fence);
+                CheckResult(result, "Failed to create an upload fence.");
+                if (result != VK_SUCCESS)
+                {
+                    return false;
+                }
+
+                device_->CreateBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, slot.buffer, slot.allocation, nullptr, slot_size);
+                if (slot.buffer == VK_NULL_HANDLE)
+                {
+                    return false;
+                }
+
+                void* mapped_data = nullptr;
+                result            = vmaMapMemory(device_->GetAllocator(), slot.allocation, &mapped_data);
+                CheckResult(result, "Failed to map an upload staging buffer.");
+                if (result != VK_SUCCESS)
+                {
+                    return false;
+                }
+                slot.mapped                 = true;
+                out_mapped_data[slot_index] = static_cast<uint8_t*>(mapped_data);
+            }
+
+            return true;
+        }
+
+        void VulkanUploadDevice::DestroySlots()
+        {
+            if (device_ == nullptr)
+            {
+                return;
+            }
+
+            for (Slot& slot : slots_)
+            {
+                if (slot.mapped)
+                {
+                    vmaUnmapMemory(device_->GetAllocator(), slot.allocation);
+                }
+                if (slot.buffer != VK_NULL_HANDLE)
+                {
+                    device_->DestroyBuffer(slot.buffer, slot.allocation);
+                }
+                if (slot.fence != VK_NULL_HANDLE)
+                {
+                    vkDestroyFence(device_->GetDevice(), slot.fence, nullptr);
+                }
+            }
+            slots_.clear();
+
+            // Destroying the pool frees the slot command buffers.
+            if (command_pool_ != VK_NULL_HANDLE)
+            {
+                vkDestroyCommandPool(device_->GetDevice(), command_pool_, nullptr);
+                command_pool_ = VK_NULL_HANDLE;
+            }
+        }
+
+        bool VulkanUploadDevice::BeginSlot(uint32_t slot_index)
+        {
+            Slot& slot = slots_[slot_index];
+
+            // The fence is signaled from the last submission, if there was one.
+            VkResult result = vkResetFences(device_->GetDevice(), 1, &slot.fence);
+            CheckResult(result, "Failed to reset an upload fence.");
+            if (result != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+            begin_info.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            result = vkBeginCommandBuffer(slot.command_buffer, &begin_info);
+            CheckResult(result, "Failed to begin an upload command buffer.");
+            return result == VK_SUCCESS;
+        }
+
+        void VulkanUploadDevice::RecordCopy(uint32_t slot_index, VkDeviceSize src_offset, VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size)
+        {
+            Slot& slot = slots_[slot_index];
+
+            VkBufferCopy copy_region = {};
+            copy_region.srcOffset    = src_offset;
+            copy_region.dstOffset    = dst_offset;
+            copy_region.size         = size;
+            vkCmdCopyBuffer(slot.command_buffer, slot.buffer, dst_buffer, 1, &copy_region);
+        }
+
+        bool VulkanUploadDevice::SubmitSlot(uint32_t slot_index)
+        {
+            Slot& slot = slots_[slot_index];
+
+            VkResult result = vkEndCommandBuffer(slot.command_buffer);
+            CheckResult(result, "Failed to end an upload command buffer.");
+            if (result != VK_SUCCESS)
+            {
+                return false;
+            }
+
+            VkSubmitInfo submit_info       = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+            submit_info.commandBufferCount = 1;
+            submit_info.pCommandBuffers    = &slot.command_buffer;
+
+            result = vkQueueSubmit(queue_, 1, &submit_info, slot.fence);
+            CheckResult(result, "Failed to submit uploads to the transfer queue.");
+            return result == VK_SUCCESS;
+        }
+
+        bool VulkanUploadDevice::IsSlotDone(uint32_t slot_index)
+        {
+            return vkGetFenceStatus(device_->GetDevice(), slots_[slot_index].fence) == VK_SUCCESS;
+        }
+
+        bool VulkanUploadDevice::WaitForSlot(uint32_t slot_index)
+        {
+            VkResult result = vkWaitForFences(device_->GetDevice(), 1, &slots_[slot_index].fence, VK_TRUE, UINT64_MAX);
+            CheckResult(result, "Failed to wait for an upload to finish.");
+            return result == VK_SUCCESS;
+        }
+    }  // namespace renderer
+}  // namespace rra
@@ -0,0 +1,106 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Declaration for the Vulkan upload device, which runs the copies of
+///         the upload scheduler on the transfer queue.
+//=============================================================================
+
+#ifndef RRA_RENDERER_VK_VULKAN_UPLOAD_DEVICE_H_
+#define RRA_RENDERER_VK_VULKAN_UPLOAD_DEVICE_H_
+
+#include <vector>
+
+#include "framework/device.h"
+#include "upload_scheduler.h"
+
+namespace rra
+{
+    namespace renderer
+    {
+        /// @brief Staging slots in host visible buffers, copied out of on the transfer queue.
+        ///
+        /// Each slot has its own command buffer, and a fence signaled once its copies have finished.
+        class VulkanUploadDevice : public UploadDevice
+        {
+        public:
+            /// @brief Constructor.
+            VulkanUploadDevice() = default;
+
+            /// @brief Destructor.
+            virtual ~VulkanUploadDevice() = default;
+
+            /// @brief Set the device the slots are created on.
+            ///
+            /// @param [in] device The device to upload to.
+            void Initialize(Device* device);
+
+            /// @brief Create the staging slots.
+            ///
+            /// @param [in]  slot_count      The number of slots.
+            /// @param [in]  slot_size       The size of each slot.
+            /// @param [out] out_mapped_data An array receiving the mapped memory of each slot.
+            ///
+            /// @returns True if the slots were created successfully.
+            virtual bool CreateSlots(uint32_t slot_count, VkDeviceSize slot_size, uint8_t** out_mapped_data) override;
+
+            /// @brief Destroy the staging slots, and whatever of them was created.
+            virtual void DestroySlots() override;
+
+            /// @brief Reset the fence of a slot and start recording its command buffer.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the recording was started successfully.
+            virtual bool BeginSlot(uint32_t slot_index) override;
+
+            /// @brief Record a copy out of a slot.
+            ///
+            /// @param [in] slot_index The slot.
+            /// @param [in] src_offset The offset of the data in the slot.
+            /// @param [in] dst_buffer The buffer to copy to.
+            /// @param [in] dst_offset The offset in the buffer to copy to.
+            /// @param [in] size The size of the copy.
+            virtual void RecordCopy(uint32_t slot_index, VkDeviceSize src_offset, VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size) override;
+
+            /// @brief End the command buffer of a slot and submit it to the transfer queue.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the submission was successful.
+            virtual bool SubmitSlot(uint32_t slot_index) override;
+
+            /// @brief Check the fence of a slot.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the fence is signaled.
+            virtual bool IsSlotDone(uint32_t slot_index) override;
+
+            /// @brief Wait for the fence of a slot.
+            ///
+            /// @param [in] slot_index The slot.
+            ///
+            /// @returns True if the wait was successful.
+            virtual bool WaitForSlot(uint32_t slot_index) override;
+
+        private:
+            /// @brief A staging buffer with the commands copying out of it.
+            struct Slot
+            {
+                VkBuffer        buffer         = VK_NULL_HANDLE;  ///< The staging buffer.
+                VmaAllocation   allocation     = VK_NULL_HANDLE;  ///< The allocation of the staging buffer.
+                bool            mapped         = false;           ///< True if the staging buffer is mapped.
+                VkCommandBuffer command_buffer = VK_NULL_HANDLE;  ///< The command buffer recording the copies.
+                VkFence         fence          = VK_NULL_HANDLE;  ///< Signaled once the copies have finished.
+            };
+
+            Device*           device_       = nullptr;         ///< The device to upload to.
+            VkQueue           queue_        = VK_NULL_HANDLE;  ///< The queue the copies are submitted to.
+            VkCommandPool     command_pool_ = VK_NULL_HANDLE;  ///< The pool of the slot command buffers.
+            std::vector<Slot> slots_;                          ///< The staging slots.
+        };
+    }  // namespace renderer
+}  // namespace rra
+
+#endif  // RRA_RENDERER_VK_VULKAN_UPLOAD_DEVICE_H_
@@ -0,0 +1,208 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Tests for the compact mesh encoding of BLAS triangle meshes.
+//=============================================================================
+
+#include <stdio.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "public/compact_mesh.h"
+
+#include "test_framework.h"
+
+using rra::renderer::CompactMesh;
+using rra::renderer::RraVertex;
+
+namespace
+{
+    /// @brief Make a vertex with a position and fixed attributes.
+    ///
+    /// @param [in] position The position.
+    ///
+    /// @returns The vertex.
+    RraVertex MakeVertex(const glm::vec3& position)
+    {
+        RraVertex vertex                   = {};
+        vertex.position                    = position;
+        vertex.triangle_sah_and_selected   = 0.5f;
+        vertex.normal                      = glm::vec2(kNormalSignIndicatorOffset, 0.0f);
+        vertex.geometry_index_depth_opaque = 1;
+        vertex.triangle_node               = 0x40;
+        return vertex;
+    }
+
+    /// @brief Make a triangle list for a grid of quads, with two triangles per quad sharing the diagonal.
+    ///
+    /// @param [in] grid_width The number of quads along each side.
+    /// @param [in] cell_size  The size of a quad.
+    ///
+    /// @returns The vertices, 6 per quad.
+    std::vector<RraVertex> MakeGrid(uint32_t grid_width, float cell_size)
+    {
+        std::vector<RraVertex> vertices;
+        vertices.reserve(static_cast<size_t>(grid_width) * grid_width * 6);
+        for (uint32_t z = 0; z < grid_width; z++)
+        {
+            for (uint32_t x = 0; x < grid_width; x++)
+            {
+                const glm::vec3 v0 = glm::vec3(x * cell_size, 0.0f, z * cell_size);
+                const glm::vec3 v1 = glm::vec3((x + 1) * cell_size, 0.0f, z * cell_size);
+                const glm::vec3 v2 = glm::vec3(x * cell_size, 0.0f, (z + 1) * cell_size);
+                const glm::vec3 v3 = glm::vec3((x + 1) * cell_size, 0.0f, (z + 1) * cell_size);
+                for (const glm::vec3& position : {v0, v1, v2, v1, v3, v2})
+                {
+                    vertices.push_back(MakeVertex(position));
+                }
+            }
+        }
+        return vertices;
+    }
+
+    /// @brief Get the largest distance between a decoded position and the original, on any axis.
+    ///
+    /// @param [in] mesh     The encoded mesh.
+    /// @param [in] original The vertices the mesh was encoded from.
+    ///
+    /// @returns The largest error as a fraction of the step size, or infinity if a position is too far out.
+    float GetLargestRelativeError(const CompactMesh& mesh, const std::vector<RraVertex>& original)
+    {
+        std::vector<RraVertex> decoded(mesh.GetVertexCount());
+        mesh.Decode(decoded.data());
+
+        const glm::vec3 step          = mesh.GetQuantizationStep();
+        float           largest_error = 0.0f;
+        for (size_t i = 0; i < original.size(); i++)
+        {
+            for (int axis = 0; axis < 3; axis++)
+            {
+                const float error = std::abs(decoded[i].position[axis] - original[i].position[axis]);
+
+                // Allow for the float rounding of origin + step * quantized on top of the half step.
+                const float magnitude = std::abs(original[i].position[axis]) + std::abs(decoded[i].position[axis]) + step[axis] * 65535.0f;
+                const float rounding  = magnitude * 4.0f * std::numeric_limits<float>::epsilon();
+                if (step[axis] > 0.0f)
+                {
+                    largest_error = std::max(largest_error, std::max(error - rounding, 0.0f) / step[axis]);
+                }
+                else if (error > rounding)
+                {
+                    return std::numeric_limits<float>::infinity();
+                }
+            }
+        }
+        return largest_error;
+    }
+}  // namespace
+
+RRA_TEST(compact_mesh, positions_within_half_a_step)
+{
+    std::mt19937                          rng(1);
+    std::uniform_real_distribution<float> distribution(-1000.0f, 3000.0f);
+
+    std::vector<RraVertex> vertices;
+    for (int i = 0; i < 3 * 4096; i++)
+    {
+        vertices.push_back(MakeVertex(glm::vec3(distribution(rng), distribution(rng) * 0.01f, distribution(rng))));
+    }
+
+    CompactMesh mesh;
+    mesh.Encode(vertices.data(), vertices.size());
+    RRA_TEST_CHECK(mesh.GetVertexCount() == vertices.size());
+    RRA_TEST_CHECK(GetLargestRelativeError(mesh, vertices) <= 0.5f);
+}
+
+RRA_TEST(compact_mesh, step_matches_the_vertex_bounds)
+{
+    // Positions far outside any bounds a caller might have passed in are still represented, as the bounds come from
+    // the vertices themselves.
+    std::vector<RraVertex> vertices = {MakeVertex(glm::vec3(-5.0f, 1.0f, 2.0f)),
+                                       MakeVertex(glm::vec3(60.0f, 1.0f, -3.0f)),
+                                       MakeVertex(glm::vec3(7.0f, 1.0f, 2000.0f))};
+
+    CompactMesh mesh;
+    mesh.Encode(vertices.data(), vertices.size());
+
+    const glm::vec3 step = mesh.GetQuantizationStep();
+    RRA_TEST_CHECK(std::abs(step.x - 65.0f / 65535.0f) <= 1e-6f);
+    RRA_TEST_CHECK(step.y == 0.0f);
+    RRA_TEST_CHECK(std::abs(step.z - 2003.0f / 65535.0f) <= 1e-5f);
+
+    // The extremes of the bounds are the ends of the quantized range, so they decode to within float rounding.
+    std::vector<RraVertex> decoded(mesh.GetVertexCount());
+    mesh.Decode(decoded.data());
+    RRA_TEST_CHECK(std::abs(decoded[0].position.x - -5.0f) <= 1e-5f);
+    RRA_TEST_CHECK(std::abs(decoded[1].position.x - 60.0f) <= 1e-4f);
+    RRA_TEST_CHECK(decoded[0].position.y == 1.0f);
+    RRA_TEST_CHECK(std::abs(decoded[2].position.z - 2000.0f) <= 1e-3f);
+}
+
+RRA_TEST(compact_mesh, non_finite_positions_decode_to_the_origin)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    std::vector<RraVertex> vertices = MakeGrid(4, 1.0f);
+    vertices[0].position            = glm::vec3(nan, 0.0f, 0.0f);
+    vertices[1].position            = glm::vec3(1.0f, inf, 0.0f);
+    vertices[2].position            = glm::vec3(0.0f, 0.0f, -inf);
+
+    CompactMesh mesh;
+    mesh.Encode(vertices.data(), vertices.size());
+
+    std::vector<RraVertex> decoded(mesh.GetVertexCount());
+    mesh.Decode(decoded.data());
+    for (const RraVertex& vertex : decoded)
+    {
+        RRA_TEST_CHECK(std::isfinite(vertex.position.x) && std::isfinite(vertex.position.y) && std::isfinite(vertex.position.z));
+    }
+
+    // The non-finite values don't widen the bounds, so the finite positions keep their precision.
+    RRA_TEST_CHECK(std::abs(mesh.GetQuantizationStep().x - 4.0f / 65535.0f) <= 1e-6f);
+    RRA_TEST_CHECK(decoded[0].position.x == 0.0f);
+    RRA_TEST_CHECK(decoded[1].position.y == 0.0f);
+    RRA_TEST_CHECK(decoded[2].position.z == 0.0f);
+    RRA_TEST_CHECK(std::abs(decoded[5].position.z - vertices[5].position.z) <= 0.5f * mesh.GetQuantizationStep().z);
+}
+
+RRA_TEST(compact_mesh, attributes_round_trip)
+{
+    std::vector<RraVertex> vertices = MakeGrid(2, 1.0f);
+
+    CompactMesh mesh;
+    mesh.Encode(vertices.data(), vertices.size());
+
+    std::vector<RraVertex> decoded(mesh.GetVertexCount());
+    mesh.Decode(decoded.data());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        RRA_TEST_CHECK(decoded[i].triangle_sah_and_selected == vertices[i].triangle_sah_and_selected);
+        RRA_TEST_CHECK(decoded[i].geometry_index_depth_opaque == vertices[i].geometry_index_depth_opaque);
+        RRA_TEST_CHECK(decoded[i].triangle_node == vertices[i].triangle_node);
+        RRA_TEST_CHECK(std::abs(decoded[i].normal.x - vertices[i].normal.x) <= 1e-4f);
+        RRA_TEST_CHECK(std::abs(decoded[i].normal.y - vertices[i].normal.y) <= 1e-4f);
+    }
+}
+
+RRA_TEST(compact_mesh, memory_use)
+{
+    // A 256 x 256 grid has 131072 triangles.
+    std::vector<RraVertex> vertices   = MakeGrid(256, 0.25f);
+    const size_t           full_bytes = vertices.size() * sizeof(RraVertex);
+
+    CompactMesh compact;
+    compact.Encode(vertices.data(), vertices.size());
+
+    printf("compact_mesh memory for %zu triangles: RraVertex %zu bytes, compact %zu bytes (%.1f%%)\n",
+           compact.GetTriangleCount(),
+           full_bytes,
+           compact.GetMemorySize(),
+           100.0 * compact.GetMemorySize() / full_bytes);
+
+    RRA_TEST_CHECK(compact.GetMemorySize() * 2 < full_bytes);
+}
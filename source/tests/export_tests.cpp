@@ -0,0 +1,225 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Tests for the statistics export, which read the exported files back.
+//=============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "public/rra_bvh.h"
+#include "public/rra_export.h"
+#include "public/rra_tlas.h"
+#include "public/rra_trace_generator.h"
+#include "public/rra_trace_loader.h"
+
+#include "test_framework.h"
+
+namespace
+{
+    /// @brief A column file read back from disk.
+    struct Column
+    {
+        RraExportColumnHeader header = {};  ///< The file header.
+        std::vector<uint8_t>  data;         ///< The values following the header.
+
+        /// @brief Get a value of the column.
+        ///
+        /// @param [in] row The row of the value.
+        ///
+        /// @returns The value.
+        template <typename T>
+        T Get(uint64_t row) const
+        {
+            T value = {};
+            memcpy(&value, &data[row * sizeof(T)], sizeof(T));
+            return value;
+        }
+    };
+
+    /// @brief Read a whole file.
+    ///
+    /// @param [in]  file_path The path of the file.
+    /// @param [out] out_data  The file contents.
+    ///
+    /// @returns True if the file was read.
+    bool ReadFile(const std::string& file_path, std::vector<uint8_t>& out_data)
+    {
+        FILE* file = fopen(file_path.c_str(), "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        out_data.resize(static_cast<size_t>(size));
+        bool result = (size == 0) || (fread(out_data.data(), 1, out_data.size(), file) == out_data.size());
+        fclose(file);
+        return result;
+    }
+
+    /// @brief Read a column file, checking its header matches the file size.
+    ///
+    /// @param [in]  table      The table name.
+    /// @param [in]  column     The column name.
+    /// @param [in]  type       The type the column should have.
+    /// @param [in]  components The number of values per row the column should have.
+    /// @param [out] out_column The column.
+    ///
+    /// @returns True if the column was read and is consistent.
+    bool ReadColumn(const char* table, const char* column, RraExportColumnType type, uint32_t components, Column& out_column)
+    {
+        std::vector<uint8_t> file_data;
+        if (!ReadFile(std::string(table) + "." + column + ".rracol", file_data) || file_data.size() < sizeof(RraExportColumnHeader))
+        {
+            return false;
+        }
+
+        memcpy(&out_column.header, file_data.data(), sizeof(RraExportColumnHeader));
+        out_column.data.assign(file_data.begin() + sizeof(RraExportColumnHeader), file_data.end());
+
+        const RraExportColumnHeader& header     = out_column.header;
+        const uint64_t               value_size = (type == kRraExportColumnTypeUint64) ? 8 : 4;
+        return header.magic == kRraExportColumnMagic && header.version == kRraExportColumnVersion && header.type == static_cast<uint32_t>(type) &&
+               header.components == components && header.reserved == 0 && out_column.data.size() == header.row_count * components * value_size;
+    }
+
+    /// @brief Find a count of a table in the manifest.
+    ///
+    /// @param [in] manifest The manifest text.
+    /// @param [in] table    The table name.
+    /// @param [in] count    The name of the count.
+    ///
+    /// @returns The count, or -1 if the table or count is missing.
+    long long GetManifestCount(const std::string& manifest, const char* table, const char* count)
+    {
+        const std::string name     = std::string("\"name\": \"") + table + "\"";
+        size_t            position = manifest.find(name);
+        if (position == std::string::npos)
+        {
+            return -1;
+        }
+
+        // The counts come before the column list.
+        const size_t      columns_position = manifest.find("\"columns\": ", position);
+        const std::string key              = std::string("\"") + count + "\": ";
+        position                           = manifest.find(key, position);
+        if (position == std::string::npos || position > columns_position)
+        {
+            return -1;
+        }
+        return strtoll(manifest.c_str() + position + key.size(), nullptr, 10);
+    }
+
+    /// @brief Find the row count of a table in the manifest.
+    ///
+    /// @param [in] manifest The manifest text.
+    /// @param [in] table    The table name.
+    ///
+    /// @returns The row count, or -1 if the table is missing.
+    long long GetManifestRowCount(const std::string& manifest, const char* table)
+    {
+        return GetManifestCount(manifest, table, "row_count");
+    }
+}  // namespace
+
+RRA_TEST(export, round_trip)
+{
+    RraTraceGeneratorConfig config = {};
+    RraTraceGeneratorGetDefaultConfig(&config);
+    config.blas_count              = 5;
+    config.triangles_per_blas      = 300;
+    config.instance_count          = 24;
+    config.inactive_instance_count = 3;
+
+    RraTraceGeneratorStats stats = {};
+    RRA_TEST_CHECK(RraTraceGeneratorWrite("export_round_trip.rra", &config, &stats) == kRraOk);
+    RRA_TEST_CHECK(RraTraceLoaderLoad("export_round_trip.rra") == kRraOk);
+    RRA_TEST_CHECK(RraExportStatistics(".") == kRraOk);
+
+    uint64_t tlas_count = 0;
+    RRA_TEST_CHECK(RraBvhGetTlasCount(&tlas_count) == kRraOk && tlas_count == 1);
+
+    // The instances each BLAS should have in the instance table.
+    uint64_t              total_blas_count = 0;
+    std::vector<uint64_t> blas_instance_counts;
+    RRA_TEST_CHECK(RraBvhGetTotalBlasCount(&total_blas_count) == kRraOk);
+    for (uint64_t blas_index = 0; blas_index < total_blas_count; blas_index++)
+    {
+        uint64_t instance_count = 0;
+        RraTlasGetInstanceCount(0, blas_index, &instance_count);
+        blas_instance_counts.push_back(instance_count);
+    }
+
+    RraTraceLoaderUnload();
+
+    std::vector<uint8_t> manifest_data;
+    RRA_TEST_CHECK(ReadFile("manifest.json", manifest_data));
+    const std::string manifest(manifest_data.begin(), manifest_data.end());
+    RRA_TEST_CHECK(manifest.find("\"format\": \"rracol\"") != std::string::npos);
+
+    // The TLAS table.
+    Column tlas_instance_counts;
+    RRA_TEST_CHECK(ReadColumn("tlas", "instance_count", kRraExportColumnTypeUint64, 1, tlas_instance_counts));
+    RRA_TEST_CHECK(tlas_instance_counts.header.row_count == 1);
+    RRA_TEST_CHECK(GetManifestRowCount(manifest, "tlas") == 1);
+    RRA_TEST_CHECK(tlas_instance_counts.Get<uint64_t>(0) == config.instance_count);
+
+    // The BLAS table has a row for every BLAS index, including the empty placeholder BLAS.
+    Column blas_indices;
+    RRA_TEST_CHECK(ReadColumn("blas", "blas_index", kRraExportColumnTypeUint64, 1, blas_indices));
+    RRA_TEST_CHECK(blas_indices.header.row_count == total_blas_count);
+    RRA_TEST_CHECK(GetManifestRowCount(manifest, "blas") == static_cast<long long>(total_blas_count));
+    for (uint64_t row = 0; row < total_blas_count; row++)
+    {
+        RRA_TEST_CHECK(blas_indices.Get<uint64_t>(row) == row);
+    }
+
+    // The instance table has a row for each active instance, grouped by BLAS.
+    const uint64_t active_count = config.instance_count - config.inactive_instance_count;
+    Column         instance_blas_indices;
+    Column         instance_masks;
+    Column         instance_transforms;
+    RRA_TEST_CHECK(ReadColumn("instance", "blas_index", kRraExportColumnTypeUint64, 1, instance_blas_indices));
+    RRA_TEST_CHECK(ReadColumn("instance", "mask", kRraExportColumnTypeUint32, 1, instance_masks));
+    RRA_TEST_CHECK(ReadColumn("instance", "transform", kRraExportColumnTypeFloat32, 12, instance_transforms));
+    RRA_TEST_CHECK(instance_blas_indices.header.row_count == active_count);
+    RRA_TEST_CHECK(instance_transforms.header.row_count == active_count);
+    RRA_TEST_CHECK(GetManifestRowCount(manifest, "instance") == static_cast<long long>(active_count));
+
+    // The inactive instances are counted rather than silently left out, and every active instance could be read.
+    RRA_TEST_CHECK(GetManifestCount(manifest, "instance", "inactive_instance_count") == config.inactive_instance_count);
+    RRA_TEST_CHECK(GetManifestCount(manifest, "instance", "skipped_row_count") == 0);
+    RRA_TEST_CHECK(GetManifestCount(manifest, "blas", "skipped_row_count") == 0);
+
+    std::vector<uint64_t> exported_instance_counts(blas_instance_counts.size(), 0);
+    for (uint64_t row = 0; row < active_count; row++)
+    {
+        const uint64_t blas_index = instance_blas_indices.Get<uint64_t>(row);
+        RRA_TEST_CHECK(blas_index < exported_instance_counts.size());
+        RRA_TEST_CHECK(row == 0 || instance_blas_indices.Get<uint64_t>(row - 1) <= blas_index);
+        RRA_TEST_CHECK(instance_masks.Get<uint32_t>(row) != 0);
+        exported_instance_counts[blas_index]++;
+    }
+    RRA_TEST_CHECK(exported_instance_counts == blas_instance_counts);
+
+    // The triangle table covers every triangle in every BLAS.
+    Column triangle_counts;
+    RRA_TEST_CHECK(ReadColumn("triangle", "triangle_count", kRraExportColumnTypeUint32, 1, triangle_counts));
+    RRA_TEST_CHECK(GetManifestRowCount(manifest, "triangle") == static_cast<long long>(triangle_counts.header.row_count));
+
+    uint64_t triangle_count = 0;
+    for (uint64_t row = 0; row < triangle_counts.header.row_count; row++)
+    {
+        triangle_count += triangle_counts.Get<uint32_t>(row);
+    }
+    RRA_TEST_CHECK(triangle_count == stats.triangle_count);
+}
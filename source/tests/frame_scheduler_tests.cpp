@@ -0,0 +1,128 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Tests for when the frame scheduler draws, goes idle and wakes up.
+//=============================================================================
+
+#include "public/frame_scheduler.h"
+
+#include "test_framework.h"
+
+using rra::renderer::FrameScheduler;
+using rra::renderer::FrameState;
+
+namespace
+{
+    /// @brief Make a frame state for a viewport size.
+    ///
+    /// @param [in] width The viewport width.
+    ///
+    /// @returns The frame state.
+    FrameState MakeState(int width)
+    {
+        FrameState state;
+        state.width  = width;
+        state.height = 100;
+        return state;
+    }
+
+    /// @brief Check the same state as many times as it takes the scheduler to go idle when nothing is drawn.
+    ///
+    /// @param [in] scheduler The scheduler.
+    /// @param [in] state     The state to check with.
+    ///
+    /// @returns The number of checks that drew a frame.
+    uint32_t CheckUntilIdle(FrameScheduler& scheduler, const FrameState& state)
+    {
+        uint32_t frame_count = 0;
+        for (uint32_t i = 0; i < FrameScheduler::kChecksBeforeIdle; i++)
+        {
+            frame_count += scheduler.CheckForNewFrame(state) ? 1 : 0;
+        }
+        return frame_count;
+    }
+}  // namespace
+
+RRA_TEST(frame_scheduler, draws_when_dirty_or_changed)
+{
+    FrameScheduler   scheduler;
+    const FrameState state = MakeState(100);
+
+    // The first check always draws, then nothing does until something changes.
+    RRA_TEST_CHECK(scheduler.CheckForNewFrame(state));
+    RRA_TEST_CHECK(!scheduler.CheckForNewFrame(state));
+
+    scheduler.MarkDirty();
+    RRA_TEST_CHECK(scheduler.CheckForNewFrame(state));
+    RRA_TEST_CHECK(!scheduler.CheckForNewFrame(state));
+
+    RRA_TEST_CHECK(scheduler.CheckForNewFrame(MakeState(200)));
+    RRA_TEST_CHECK(!scheduler.CheckForNewFrame(MakeState(200)));
+
+    // Keeping the scheduler awake doesn't draw anything.
+    scheduler.KeepAwake();
+    RRA_TEST_CHECK(!scheduler.CheckForNewFrame(MakeState(200)));
+}
+
+RRA_TEST(frame_scheduler, goes_idle_after_checks_without_change)
+{
+    FrameScheduler   scheduler;
+    const FrameState state = MakeState(100);
+    RRA_TEST_CHECK(scheduler.IsIdle());
+
+    RRA_TEST_CHECK(scheduler.CheckForNewFrame(state));
+    RRA_TEST_CHECK(!scheduler.IsIdle());
+
+    for (uint32_t i = 0; i + 1 < FrameScheduler::kChecksBeforeIdle; i++)
+    {
+        RRA_TEST_CHECK(!scheduler.CheckForNewFrame(state));
+        RRA_TEST_CHECK(!scheduler.IsIdle());
+    }
+    RRA_TEST_CHECK(!scheduler.CheckForNewFrame(state));
+    RRA_TEST_CHECK(scheduler.IsIdle());
+
+    // The scheduler stays busy while the user is interacting, and for a while after they stop.
+    scheduler.SetInteracting(true);
+    RRA_TEST_CHECK(CheckUntilIdle(scheduler, state) == 0);
+    RRA_TEST_CHECK(!scheduler.IsIdle());
+    scheduler.SetInteracting(false);
+    RRA_TEST_CHECK(!scheduler.IsIdle());
+    RRA_TEST_CHECK(CheckUntilIdle(scheduler, state) == 0);
+    RRA_TEST_CHECK(scheduler.IsIdle());
+}
+
+RRA_TEST(frame_scheduler, mark_dirty_wakes_when_idle)
+{
+    FrameScheduler   scheduler;
+    const FrameState state      = MakeState(100);
+    uint32_t         wake_count = 0;
+    scheduler.SetWakeCallback([&wake_count]() { wake_count++; });
+
+    RRA_TEST_CHECK(CheckUntilIdle(scheduler, state) == 1);
+    RRA_TEST_CHECK(!scheduler.IsIdle());
+    RRA_TEST_CHECK(!scheduler.CheckForNewFrame(state));
+    RRA_TEST_CHECK(scheduler.IsIdle());
+    RRA_TEST_CHECK(wake_count == 0);
+
+    // Only the change from idle to busy wakes the caller.
+    scheduler.MarkDirty();
+    RRA_TEST_CHECK(wake_count == 1);
+    RRA_TEST_CHECK(!scheduler.IsIdle());
+    scheduler.MarkDirty();
+    scheduler.KeepAwake();
+    RRA_TEST_CHECK(wake_count == 1);
+
+    RRA_TEST_CHECK(CheckUntilIdle(scheduler, state) == 1);
+    RRA_TEST_CHECK(!scheduler.CheckForNewFrame(state));
+    RRA_TEST_CHECK(scheduler.IsIdle());
+
+    scheduler.KeepAwake();
+    RRA_TEST_CHECK(wake_count == 2);
+    RRA_TEST_CHECK(CheckUntilIdle(scheduler, state) == 0);
+    RRA_TEST_CHECK(scheduler.IsIdle());
+
+    scheduler.SetWakeCallback(nullptr);
+    scheduler.MarkDirty();
+    RRA_TEST_CHECK(wake_count == 2);
+}
@@ -0,0 +1,265 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Tests for the job system: waiting, nesting, cancellation, task graphs and contexts on worker threads.
+//=============================================================================
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "job_system.h"
+#include "public/rra_blas.h"
+#include "public/rra_bvh.h"
+#include "public/rra_context.h"
+#include "public/rra_trace_generator.h"
+
+#include "test_framework.h"
+
+using rra::CancellationToken;
+using rra::JobGroup;
+using rra::JobSystem;
+using rra::TaskGraph;
+
+namespace
+{
+    /// @brief Sets the job system thread count for a test, and goes back to one thread per core afterwards.
+    class ScopedThreadCount
+    {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param [in] thread_count The number of threads.
+        explicit ScopedThreadCount(uint32_t thread_count)
+        {
+            JobSystem::Get().SetThreadCount(thread_count);
+            JobSystem::Get().ResetStats();
+        }
+
+        /// @brief Destructor.
+        ~ScopedThreadCount()
+        {
+            JobSystem::Get().SetThreadCount(0);
+        }
+    };
+
+    /// @brief Write a generated trace and load it into a context.
+    ///
+    /// @param [in] context    The context.
+    /// @param [in] file_path  The path to write the trace to.
+    /// @param [in] blas_count The number of BLASes.
+    ///
+    /// @returns True if the trace was loaded.
+    bool LoadGeneratedTrace(RraContext* context, const char* file_path, uint32_t blas_count)
+    {
+        RraTraceGeneratorConfig config = {};
+        RraTraceGeneratorGetDefaultConfig(&config);
+        config.blas_count         = blas_count;
+        config.triangles_per_blas = 200;
+        config.instance_count     = 16;
+        config.seed               = blas_count;
+
+        return RraTraceGeneratorWrite(file_path, &config, nullptr) == kRraOk && RraContextLoadTrace(context, file_path) == kRraOk;
+    }
+
+    /// @brief Get the root surface area heuristic of each BLAS in a context.
+    ///
+    /// @param [in] context The context.
+    ///
+    /// @returns The values, or an empty list if they couldn't be read.
+    std::vector<float> GetBlasSurfaceAreaHeuristics(RraContext* context)
+    {
+        uint64_t blas_count = 0;
+        uint32_t root_node  = 0;
+        RraBvhGetRootNodePtr(&root_node);
+        if (RraContextBvhGetTotalBlasCount(context, &blas_count) != kRraOk)
+        {
+            return {};
+        }
+
+        std::vector<float> values(static_cast<size_t>(blas_count), 0.0f);
+        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        {
+            if (RraContextBlasGetSurfaceAreaHeuristic(context, blas_index, root_node, &values[static_cast<size_t>(blas_index)]) != kRraOk)
+            {
+                return {};
+            }
+        }
+        return values;
+    }
+}  // namespace
+
+RRA_TEST(job_system, wait_runs_queued_jobs)
+{
+    // With a single thread there are no workers, so nothing runs until the caller waits.
+    ScopedThreadCount thread_count(1);
+    RRA_TEST_CHECK(JobSystem::Get().GetThreadCount() == 1);
+
+    std::atomic<uint32_t> run_count(0);
+    JobGroup              group;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        JobSystem::Get().Submit([&run_count]() { run_count++; }, group);
+    }
+    RRA_TEST_CHECK(run_count == 0);
+    RRA_TEST_CHECK(!group.IsFinished());
+
+    RraJobSystemStats stats = {};
+    JobSystem::Get().GetStats(stats);
+    RRA_TEST_CHECK(stats.queued_job_count == 10);
+
+    JobSystem::Get().Wait(group);
+    RRA_TEST_CHECK(run_count == 10);
+    RRA_TEST_CHECK(group.IsFinished());
+
+    JobSystem::Get().GetStats(stats);
+    RRA_TEST_CHECK(stats.jobs_submitted == 10 && stats.jobs_executed == 10 && stats.queued_job_count == 0);
+}
+
+RRA_TEST(job_system, nested_parallel_for)
+{
+    const size_t kOuterCount = 16;
+    const size_t kInnerCount = 100;
+
+    for (uint32_t threads : {1u, 3u})
+    {
+        ScopedThreadCount thread_count(threads);
+
+        // Each outer block waits for its inner blocks, which only finishes if waiting threads run queued jobs.
+        std::vector<std::atomic<uint32_t>> visits(kOuterCount * kInnerCount);
+        JobSystem::Get().ParallelFor(kOuterCount, 1, 0, [&visits](size_t outer_begin, size_t outer_end, uint32_t) {
+            for (size_t outer = outer_begin; outer < outer_end; outer++)
+            {
+                JobSystem::Get().ParallelFor(kInnerCount, 7, 0, [&visits, outer](size_t begin, size_t end, uint32_t) {
+                    for (size_t inner = begin; inner < end; inner++)
+                    {
+                        visits[outer * kInnerCount + inner]++;
+                    }
+                });
+            }
+        });
+
+        bool each_once = true;
+        for (const auto& visit_count : visits)
+        {
+            each_once = each_once && visit_count == 1;
+        }
+        RRA_TEST_CHECK(each_once);
+
+        RraJobSystemStats stats = {};
+        JobSystem::Get().GetStats(stats);
+        RRA_TEST_CHECK(stats.queued_job_count == 0);
+    }
+}
+
+RRA_TEST(job_system, cancellation_skips_jobs_not_started)
+{
+    ScopedThreadCount thread_count(1);
+
+    // Jobs queued before the cancel are skipped, but still finish the group.
+    CancellationToken     token;
+    std::atomic<uint32_t> run_count(0);
+    {
+        JobGroup group(&token);
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            JobSystem::Get().Submit([&run_count]() { run_count++; }, group);
+        }
+        token.Cancel();
+        RRA_TEST_CHECK(group.IsCancelled());
+        JobSystem::Get().Wait(group);
+        RRA_TEST_CHECK(group.IsFinished());
+    }
+    RRA_TEST_CHECK(run_count == 0);
+
+    RraJobSystemStats stats = {};
+    JobSystem::Get().GetStats(stats);
+    RRA_TEST_CHECK(stats.jobs_cancelled == 10 && stats.jobs_executed == 0);
+
+    // A block that cancels stops the blocks after it. The caller runs every block itself, in order.
+    CancellationToken parallel_token;
+    size_t            block_count = 0;
+    JobSystem::Get().ParallelFor(
+        100,
+        10,
+        0,
+        [&parallel_token, &block_count](size_t, size_t, uint32_t) {
+            if (++block_count == 3)
+            {
+                parallel_token.Cancel();
+            }
+        },
+        &parallel_token);
+    RRA_TEST_CHECK(block_count == 3);
+}
+
+RRA_TEST(job_system, task_graph_runs_after_dependencies)
+{
+    ScopedThreadCount thread_count(3);
+
+    std::mutex            order_mutex;
+    std::vector<uint32_t> order;
+    TaskGraph             graph;
+    const auto            record = [&order_mutex, &order](uint32_t task) {
+        return [&order_mutex, &order, task]() {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(task);
+        };
+    };
+
+    const uint32_t first  = graph.AddTask(record(0));
+    const uint32_t second = graph.AddTask(record(1), {first});
+    const uint32_t third  = graph.AddTask(record(2));
+    graph.AddTask(record(3), {second, third});
+
+    for (int run = 0; run < 2; run++)
+    {
+        order.clear();
+        graph.Run();
+        RRA_TEST_CHECK(order.size() == 4);
+
+        uint32_t position[4] = {};
+        for (uint32_t i = 0; i < order.size(); i++)
+        {
+            position[order[i]] = i;
+        }
+        RRA_TEST_CHECK(position[0] < position[1]);
+        RRA_TEST_CHECK(position[1] < position[3] && position[2] < position[3]);
+    }
+
+    // Nothing runs once the graph is cancelled, and the tasks depending on skipped tasks are never started.
+    CancellationToken token;
+    token.Cancel();
+    order.clear();
+    graph.Run(&token);
+    RRA_TEST_CHECK(order.empty());
+}
+
+RRA_TEST(job_system, worker_threads_use_the_context_they_are_given)
+{
+    ScopedThreadCount thread_count(3);
+
+    RraContext* contexts[2] = {};
+    RRA_TEST_CHECK(RraContextCreate(&contexts[0]) == kRraOk);
+    RRA_TEST_CHECK(RraContextCreate(&contexts[1]) == kRraOk);
+    RRA_TEST_CHECK(LoadGeneratedTrace(contexts[0], "job_system_context_0.rra", 3));
+    RRA_TEST_CHECK(LoadGeneratedTrace(contexts[1], "job_system_context_1.rra", 5));
+
+    // Workers have no context of their own, so each job reads whichever trace it was handed.
+    const std::vector<float> expected[2] = {GetBlasSurfaceAreaHeuristics(contexts[0]), GetBlasSurfaceAreaHeuristics(contexts[1])};
+    RRA_TEST_CHECK(!expected[0].empty() && expected[0].size() != expected[1].size());
+
+    std::atomic<uint32_t> mismatch_count(0);
+    JobSystem::Get().ParallelFor(64, 1, 0, [&contexts, &expected, &mismatch_count](size_t begin, size_t end, uint32_t) {
+        for (size_t index = begin; index < end; index++)
+        {
+            const size_t which = index % 2;
+            mismatch_count += (GetBlasSurfaceAreaHeuristics(contexts[which]) == expected[which]) ? 0 : 1;
+        }
+    });
+    RRA_TEST_CHECK(mismatch_count == 0);
+
+    RRA_TEST_CHECK(RraContextDestroy(contexts[0]) == kRraOk);
+    RRA_TEST_CHECK(RraContextDestroy(contexts[1]) == kRraOk);
+}
@@ -0,0 +1,202 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Tests that the ray cost estimates don't depend on the thread count.
+//=============================================================================
+
+#include <vector>
+
+#include "public/rra_blas.h"
+#include "public/rra_bvh.h"
+#include "public/rra_ray_cost.h"
+#include "public/rra_tlas.h"
+#include "public/rra_trace_generator.h"
+#include "public/rra_trace_loader.h"
+
+#include "test_framework.h"
+
+namespace
+{
+    /// @brief The thread counts each estimate is run with. The second doesn't divide the ray batches evenly.
+    static const uint32_t kThreadCounts[2] = {1, 3};
+
+    /// @brief Compare the totals of two estimates.
+    ///
+    /// @param [in] a The first totals.
+    /// @param [in] b The second totals.
+    ///
+    /// @returns True if every field is the same.
+    bool StatsEqual(const RraRayCostStats& a, const RraRayCostStats& b)
+    {
+        bool equal = a.ray_count == b.ray_count && a.hit_count == b.hit_count && a.node_visits == b.node_visits && a.box_node_visits == b.box_node_visits &&
+                     a.triangle_tests == b.triangle_tests && a.instance_visits == b.instance_visits && a.mean_node_visits == b.mean_node_visits &&
+                     a.mean_triangle_tests == b.mean_triangle_tests;
+        for (int i = 0; i < kRraRayCostPercentileCount; i++)
+        {
+            equal = equal && a.node_visit_percentiles[i] == b.node_visit_percentiles[i] && a.triangle_test_percentiles[i] == b.triangle_test_percentiles[i];
+        }
+        return equal;
+    }
+
+    /// @brief Compare the totals of two cache simulations.
+    ///
+    /// @param [in] a The first totals.
+    /// @param [in] b The second totals.
+    ///
+    /// @returns True if every field is the same.
+    bool CacheStatsEqual(const RraRayCostCacheStats& a, const RraRayCostCacheStats& b)
+    {
+        bool equal = a.ray_count == b.ray_count && a.line_reads == b.line_reads && a.hits == b.hits && a.misses == b.misses &&
+                     a.unique_lines == b.unique_lines && a.unique_pages == b.unique_pages && a.hit_rate == b.hit_rate &&
+                     a.mean_unique_lines == b.mean_unique_lines && a.mean_unique_pages == b.mean_unique_pages && a.mean_miss_bytes == b.mean_miss_bytes;
+        for (int i = 0; i < kRraRayCostPercentileCount; i++)
+        {
+            equal = equal && a.unique_line_percentiles[i] == b.unique_line_percentiles[i];
+        }
+        return equal;
+    }
+
+    /// @brief Compare the per instance or per BLAS costs of two estimates.
+    ///
+    /// @param [in] a The first costs.
+    /// @param [in] b The second costs.
+    ///
+    /// @returns True if every entry is the same.
+    bool CountersEqual(const std::vector<RraRayCostCounters>& a, const std::vector<RraRayCostCounters>& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (a[i].ray_count != b[i].ray_count || a[i].node_visits != b[i].node_visits || a[i].box_node_visits != b[i].box_node_visits ||
+                a[i].triangle_tests != b[i].triangle_tests)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Write and load a small generated trace.
+    ///
+    /// @param [in] file_path The path to write the trace to.
+    ///
+    /// @returns True if the trace was loaded.
+    bool LoadGeneratedTrace(const char* file_path)
+    {
+        RraTraceGeneratorConfig config = {};
+        RraTraceGeneratorGetDefaultConfig(&config);
+        config.blas_count         = 4;
+        config.triangles_per_blas = 500;
+        config.instance_count     = 32;
+        config.seed               = 7;
+
+        return RraTraceGeneratorWrite(file_path, &config, nullptr) == kRraOk && RraTraceLoaderLoad(file_path) == kRraOk;
+    }
+
+    /// @brief Get the ray cost settings for the tests.
+    ///
+    /// @param [in] distribution How the rays are generated.
+    /// @param [in] thread_count The number of threads to use.
+    ///
+    /// @returns The settings.
+    RraRayCostConfig GetConfig(RraRayDistribution distribution, uint32_t thread_count)
+    {
+        RraRayCostConfig config = {};
+        RraRayCostGetDefaultConfig(&config);
+        config.distribution = distribution;
+        config.ray_count    = 5000;
+        config.seed         = 12345;
+        config.thread_count = thread_count;
+        return config;
+    }
+
+    /// @brief Find the first BLAS with geometry.
+    ///
+    /// @param [out] out_blas_index The index of the BLAS.
+    ///
+    /// @returns True if a BLAS was found.
+    bool FindNonEmptyBlas(uint64_t* out_blas_index)
+    {
+        uint64_t blas_count = 0;
+        RraBvhGetTotalBlasCount(&blas_count);
+        for (uint64_t blas_index = 0; blas_index < blas_count; blas_index++)
+        {
+            if (!RraBlasIsEmpty(blas_index))
+            {
+                *out_blas_index = blas_index;
+                return true;
+            }
+        }
+        return false;
+    }
+}  // namespace
+
+RRA_TEST(ray_cost, estimates_do_not_depend_on_thread_count)
+{
+    RRA_TEST_CHECK(LoadGeneratedTrace("ray_cost_estimates.rra"));
+
+    uint64_t blas_index = 0;
+    RRA_TEST_CHECK(FindNonEmptyBlas(&blas_index));
+
+    uint64_t blas_count          = 0;
+    uint64_t instance_node_count = 0;
+    RRA_TEST_CHECK(RraBvhGetTotalBlasCount(&blas_count) == kRraOk);
+    RRA_TEST_CHECK(RraTlasGetInstanceNodeCount(0, &instance_node_count) == kRraOk);
+
+    for (RraRayDistribution distribution : {kRraRayDistributionUniformSphere, kRraRayDistributionCameraFrustum})
+    {
+        RraRayCostStats                 blas_stats[2]        = {};
+        RraRayCostStats                 tlas_stats[2]        = {};
+        std::vector<RraRayCostCounters> instance_counters[2] = {};
+        std::vector<RraRayCostCounters> blas_counters[2]     = {};
+        for (int run = 0; run < 2; run++)
+        {
+            const RraRayCostConfig config = GetConfig(distribution, kThreadCounts[run]);
+            instance_counters[run].resize(static_cast<size_t>(instance_node_count));
+            blas_counters[run].resize(static_cast<size_t>(blas_count));
+
+            RRA_TEST_CHECK(RraRayCostEstimateBlas(blas_index, &config, &blas_stats[run]) == kRraOk);
+            RRA_TEST_CHECK(RraRayCostEstimateTlas(0, &config, &tlas_stats[run], instance_counters[run].data(), blas_counters[run].data()) == kRraOk);
+        }
+
+        RRA_TEST_CHECK(blas_stats[0].ray_count == 5000 && blas_stats[0].node_visits > 0);
+        RRA_TEST_CHECK(tlas_stats[0].ray_count == 5000 && tlas_stats[0].instance_visits > 0);
+        RRA_TEST_CHECK(StatsEqual(blas_stats[0], blas_stats[1]));
+        RRA_TEST_CHECK(StatsEqual(tlas_stats[0], tlas_stats[1]));
+        RRA_TEST_CHECK(CountersEqual(instance_counters[0], instance_counters[1]));
+        RRA_TEST_CHECK(CountersEqual(blas_counters[0], blas_counters[1]));
+    }
+
+    RraTraceLoaderUnload();
+}
+
+RRA_TEST(ray_cost, cache_simulation_does_not_depend_on_thread_count)
+{
+    RRA_TEST_CHECK(LoadGeneratedTrace("ray_cost_cache.rra"));
+
+    uint64_t blas_index = 0;
+    RRA_TEST_CHECK(FindNonEmptyBlas(&blas_index));
+
+    RraRayCostCacheConfig cache_config = {};
+    RRA_TEST_CHECK(RraRayCostGetDefaultCacheConfig(&cache_config) == kRraOk);
+
+    RraRayCostCacheStats blas_stats[2] = {};
+    RraRayCostCacheStats tlas_stats[2] = {};
+    for (int run = 0; run < 2; run++)
+    {
+        const RraRayCostConfig config = GetConfig(kRraRayDistributionUniformSphere, kThreadCounts[run]);
+        RRA_TEST_CHECK(RraRayCostSimulateCacheBlas(blas_index, &config, &cache_config, &blas_stats[run]) == kRraOk);
+        RRA_TEST_CHECK(RraRayCostSimulateCacheTlas(0, &config, &cache_config, &tlas_stats[run]) == kRraOk);
+    }
+
+    RRA_TEST_CHECK(blas_stats[0].ray_count == 5000 && blas_stats[0].line_reads > 0);
+    RRA_TEST_CHECK(tlas_stats[0].ray_count == 5000 && tlas_stats[0].line_reads > 0);
+    RRA_TEST_CHECK(CacheStatsEqual(blas_stats[0], blas_stats[1]));
+    RRA_TEST_CHECK(CacheStatsEqual(tlas_stats[0], tlas_stats[1]));
+
+    RraTraceLoaderUnload();
+}
@@ -0,0 +1,92 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Implementation of the minimal test framework, and the test runner entry point.
+//=============================================================================
+
+#include "test_framework.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+namespace rra
+{
+    namespace test
+    {
+        /// @brief A registered test.
+        struct TestCase
+        {
+            const char*  suite;     ///< The name of the suite the test belongs to.
+            const char*  name;      ///< The name of the test.
+            TestFunction function;  ///< The test function.
+        };
+
+        /// @brief Get the registered tests.
+        ///
+        /// The list is a function local static, so it is constructed before the first registration whatever the order
+        /// the test files are initialized in.
+        ///
+        /// @returns The list of tests.
+        static std::vector<TestCase>& GetTests()
+        {
+            static std::vector<TestCase> tests;
+            return tests;
+        }
+
+        /// @brief Set by ReportFailure when the running test fails a check.
+        static bool test_failed_ = false;
+
+        TestRegistration::TestRegistration(const char* suite, const char* name, TestFunction function)
+        {
+            GetTests().push_back({suite, name, function});
+        }
+
+        void ReportFailure(const char* expression, const char* file, int line)
+        {
+            fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+            test_failed_ = true;
+        }
+
+        int RunTests(const char* suite)
+        {
+            int run_count     = 0;
+            int failure_count = 0;
+            for (const TestCase& test : GetTests())
+            {
+                if (suite != nullptr && strcmp(suite, test.suite) != 0)
+                {
+                    continue;
+                }
+
+                test_failed_ = false;
+                test.function();
+                run_count++;
+
+                printf("[%s] %s.%s\n", test_failed_ ? "FAILED" : "PASSED", test.suite, test.name);
+                if (test_failed_)
+                {
+                    failure_count++;
+                }
+            }
+
+            if (run_count == 0)
+            {
+                fprintf(stderr, "No tests found in suite %s.\n", suite);
+                return 1;
+            }
+
+            printf("%d of %d tests passed.\n", run_count - failure_count, run_count);
+            return failure_count;
+        }
+    }  // namespace test
+}  // namespace rra
+
+int main(int argc, char* argv[])
+{
+    const char* suite = (argc > 1) ? argv[1] : nullptr;
+    return (rra::test::RunTests(suite) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,67 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  A minimal test framework for the backend and renderer tests.
+///
+/// Tests register themselves with RRA_TEST and are grouped into suites. Each
+/// suite is registered with CTest as its own test, which runs the test
+/// executable with the suite name as its only argument.
+//=============================================================================
+
+#ifndef RRA_TESTS_TEST_FRAMEWORK_H_
+#define RRA_TESTS_TEST_FRAMEWORK_H_
+
+namespace rra
+{
+    namespace test
+    {
+        /// @brief A test function.
+        typedef void (*TestFunction)();
+
+        /// @brief Adds a test to the list of tests at static initialization time.
+        class TestRegistration
+        {
+        public:
+            /// @brief Constructor.
+            ///
+            /// @param [in] suite    The name of the suite the test belongs to.
+            /// @param [in] name     The name of the test.
+            /// @param [in] function The test function.
+            TestRegistration(const char* suite, const char* name, TestFunction function);
+        };
+
+        /// @brief Record a failed check in the test that is running.
+        ///
+        /// @param [in] expression The expression that was false.
+        /// @param [in] file       The source file of the check.
+        /// @param [in] line       The line of the check.
+        void ReportFailure(const char* expression, const char* file, int line);
+
+        /// @brief Run the registered tests.
+        ///
+        /// @param [in] suite The suite to run, or nullptr to run every suite.
+        ///
+        /// @returns The number of tests that failed.
+        int RunTests(const char* suite);
+    }  // namespace test
+}  // namespace rra
+
+/// @brief Define a test in a suite.
+#define RRA_TEST(suite, name)                                                                         \
+    static void                        suite##_##name();                                              \
+    static rra::test::TestRegistration suite##_##name##_registration(#suite, #name, &suite##_##name); \
+    static void                        suite##_##name()
+
+/// @brief Check a condition, and end the test as failed if it is false.
+#define RRA_TEST_CHECK(condition)                                     \
+    do                                                                \
+    {                                                                 \
+        if (!(condition))                                             \
+        {                                                             \
+            rra::test::ReportFailure(#condition, __FILE__, __LINE__); \
+            return;                                                   \
+        }                                                             \
+    } while (false)
+
+#endif  // RRA_TESTS_TEST_FRAMEWORK_H_
@@ -0,0 +1,292 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Tests for the upload scheduler tickets and ordering, against a mock device.
+//=============================================================================
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "vk/upload_scheduler.h"
+
+#include "test_framework.h"
+
+using rra::renderer::UploadDevice;
+using rra::renderer::UploadScheduler;
+
+namespace
+{
+    /// @brief The slot size for the tests, small enough to wrap the ring with a few bytes.
+    static const VkDeviceSize kSlotSize = 64;
+
+    /// @brief An upload device keeping the slots in host memory, where the copies only run when the test says so.
+    class MockUploadDevice : public UploadDevice
+    {
+    public:
+        /// @brief A copy recorded out of a slot.
+        struct Copy
+        {
+            VkDeviceSize src_offset;  ///< The offset of the data in the slot.
+            VkBuffer     dst_buffer;  ///< The buffer to copy to.
+            VkDeviceSize dst_offset;  ///< The offset in the buffer to copy to.
+            VkDeviceSize size;        ///< The size of the copy.
+        };
+
+        /// @brief A staging slot.
+        struct Slot
+        {
+            std::vector<uint8_t> memory;             ///< The staging memory.
+            std::vector<Copy>    copies;             ///< The copies recorded since the slot was begun.
+            bool                 in_flight = false;  ///< True if the slot was submitted and hasn't finished copying.
+        };
+
+        virtual bool CreateSlots(uint32_t slot_count, VkDeviceSize slot_size, uint8_t** out_mapped_data) override
+        {
+            slots.resize(slot_count);
+            for (uint32_t slot_index = 0; slot_index < slot_count; slot_index++)
+            {
+                slots[slot_index].memory.resize(static_cast<size_t>(slot_size));
+                out_mapped_data[slot_index] = slots[slot_index].memory.data();
+            }
+            return true;
+        }
+
+        virtual void DestroySlots() override
+        {
+            for (const Slot& slot : slots)
+            {
+                misuse_count += slot.in_flight ? 1 : 0;
+            }
+            slots.clear();
+        }
+
+        virtual bool BeginSlot(uint32_t slot_index) override
+        {
+            Slot& slot = slots[slot_index];
+            misuse_count += slot.in_flight ? 1 : 0;
+            slot.copies.clear();
+            return true;
+        }
+
+        virtual void RecordCopy(uint32_t slot_index, VkDeviceSize src_offset, VkBuffer dst_buffer, VkDeviceSize dst_offset, VkDeviceSize size) override
+        {
+            slots[slot_index].copies.push_back({src_offset, dst_buffer, dst_offset, size});
+        }
+
+        virtual bool SubmitSlot(uint32_t slot_index) override
+        {
+            slots[slot_index].in_flight = true;
+            submit_count++;
+            return true;
+        }
+
+        virtual bool IsSlotDone(uint32_t slot_index) override
+        {
+            return !slots[slot_index].in_flight;
+        }
+
+        virtual bool WaitForSlot(uint32_t slot_index) override
+        {
+            wait_count++;
+            last_waited_slot = slot_index;
+            Complete(slot_index);
+            return true;
+        }
+
+        /// @brief Run the copies of a submitted slot, as the GPU would.
+        ///
+        /// @param [in] slot_index The slot.
+        void Complete(uint32_t slot_index)
+        {
+            Slot& slot = slots[slot_index];
+            if (!slot.in_flight)
+            {
+                return;
+            }
+
+            for (const Copy& copy : slot.copies)
+            {
+                std::vector<uint8_t>& buffer = buffers[copy.dst_buffer];
+                if (buffer.size() < copy.dst_offset + copy.size)
+                {
+                    buffer.resize(static_cast<size_t>(copy.dst_offset + copy.size));
+                }
+                std::memcpy(buffer.data() + copy.dst_offset, slot.memory.data() + copy.src_offset, static_cast<size_t>(copy.size));
+            }
+            slot.in_flight = false;
+        }
+
+        std::vector<Slot>                        slots;                 ///< The staging slots.
+        std::map<VkBuffer, std::vector<uint8_t>> buffers;               ///< The contents of each device buffer.
+        uint32_t                                 submit_count     = 0;  ///< The number of submissions.
+        uint32_t                                 wait_count       = 0;  ///< The number of waits for a slot.
+        uint32_t                                 last_waited_slot = 0;  ///< The slot of the last wait.
+        uint32_t                                 misuse_count     = 0;  ///< Slots begun or destroyed while still in flight.
+    };
+
+    /// @brief Make a fake buffer handle.
+    ///
+    /// @param [in] id The id of the buffer.
+    ///
+    /// @returns The handle.
+    VkBuffer MakeBuffer(uintptr_t id)
+    {
+        return reinterpret_cast<VkBuffer>(id);
+    }
+
+    /// @brief Stage a full slot of data, and submit it.
+    ///
+    /// @param [in] scheduler The scheduler.
+    ///
+    /// @returns True if the data was staged.
+    bool StageFullSlot(UploadScheduler& scheduler)
+    {
+        if (scheduler.TryStage(MakeBuffer(1), 0, kSlotSize) == nullptr)
+        {
+            return false;
+        }
+        return scheduler.Submit();
+    }
+}  // namespace
+
+RRA_TEST(upload_scheduler, tickets_increase_per_submit)
+{
+    MockUploadDevice device;
+    UploadScheduler  scheduler;
+    RRA_TEST_CHECK(scheduler.Initialize(&device, kSlotSize));
+    RRA_TEST_CHECK(scheduler.GetStagingTicket() == 0);
+    RRA_TEST_CHECK(scheduler.IsComplete(0));
+
+    // Data staged into the slot being recorded is complete at the next ticket, and stays there once submitted.
+    uint8_t* first  = static_cast<uint8_t*>(scheduler.Stage(MakeBuffer(1), 0, 8));
+    uint8_t* second = static_cast<uint8_t*>(scheduler.Stage(MakeBuffer(1), 8, 8));
+    RRA_TEST_CHECK(first != nullptr && second != nullptr);
+    RRA_TEST_CHECK(second - first == 16);
+    RRA_TEST_CHECK(scheduler.GetStagingTicket() == 1);
+    RRA_TEST_CHECK(scheduler.Submit());
+    RRA_TEST_CHECK(scheduler.GetStagingTicket() == 1);
+
+    RRA_TEST_CHECK(scheduler.Stage(MakeBuffer(1), 16, 8) != nullptr);
+    RRA_TEST_CHECK(scheduler.GetStagingTicket() == 2);
+    RRA_TEST_CHECK(scheduler.Submit());
+    RRA_TEST_CHECK(device.submit_count == 2);
+
+    // Submitting with nothing staged doesn't use up a ticket.
+    RRA_TEST_CHECK(scheduler.Submit());
+    RRA_TEST_CHECK(scheduler.GetStagingTicket() == 2);
+    RRA_TEST_CHECK(device.submit_count == 2);
+
+    RRA_TEST_CHECK(!scheduler.IsComplete(1));
+    device.Complete(0);
+    RRA_TEST_CHECK(scheduler.GetCompletedTicket() == 1);
+    RRA_TEST_CHECK(!scheduler.IsComplete(2));
+    device.Complete(1);
+    RRA_TEST_CHECK(scheduler.IsComplete(2));
+    RRA_TEST_CHECK(device.wait_count == 0);
+
+    scheduler.Cleanup();
+    RRA_TEST_CHECK(device.misuse_count == 0);
+}
+
+RRA_TEST(upload_scheduler, completion_is_in_ticket_order)
+{
+    MockUploadDevice device;
+    UploadScheduler  scheduler;
+    RRA_TEST_CHECK(scheduler.Initialize(&device, kSlotSize));
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        RRA_TEST_CHECK(StageFullSlot(scheduler));
+    }
+
+    // The later submissions finishing first doesn't complete their tickets while the first is still in flight.
+    device.Complete(2);
+    device.Complete(1);
+    RRA_TEST_CHECK(scheduler.GetCompletedTicket() == 0);
+    RRA_TEST_CHECK(!scheduler.IsComplete(1));
+
+    device.Complete(0);
+    RRA_TEST_CHECK(scheduler.GetCompletedTicket() == 3);
+    RRA_TEST_CHECK(device.wait_count == 0);
+
+    scheduler.Cleanup();
+    RRA_TEST_CHECK(device.misuse_count == 0);
+}
+
+RRA_TEST(upload_scheduler, try_stage_does_not_wait)
+{
+    MockUploadDevice device;
+    UploadScheduler  scheduler;
+    RRA_TEST_CHECK(scheduler.Initialize(&device, kSlotSize));
+
+    for (uint32_t i = 0; i < UploadScheduler::kStagingSlotCount; i++)
+    {
+        RRA_TEST_CHECK(StageFullSlot(scheduler));
+    }
+
+    // Every slot is in flight, so there is nowhere to stage until the oldest finishes.
+    RRA_TEST_CHECK(scheduler.TryStage(MakeBuffer(1), 0, 8) == nullptr);
+    RRA_TEST_CHECK(scheduler.GetStagingTicket() == UploadScheduler::kStagingSlotCount);
+    RRA_TEST_CHECK(device.wait_count == 0);
+
+    device.Complete(0);
+    RRA_TEST_CHECK(scheduler.TryStage(MakeBuffer(1), 0, 8) != nullptr);
+    RRA_TEST_CHECK(scheduler.GetStagingTicket() == UploadScheduler::kStagingSlotCount + 1);
+    RRA_TEST_CHECK(scheduler.IsComplete(1));
+    RRA_TEST_CHECK(!scheduler.IsComplete(2));
+
+    scheduler.Cleanup();
+    RRA_TEST_CHECK(device.wait_count == UploadScheduler::kStagingSlotCount);
+    RRA_TEST_CHECK(device.misuse_count == 0);
+}
+
+RRA_TEST(upload_scheduler, stage_waits_for_the_oldest_slot)
+{
+    MockUploadDevice device;
+    UploadScheduler  scheduler;
+    RRA_TEST_CHECK(scheduler.Initialize(&device, kSlotSize));
+
+    for (uint32_t i = 0; i < UploadScheduler::kStagingSlotCount; i++)
+    {
+        RRA_TEST_CHECK(StageFullSlot(scheduler));
+    }
+
+    RRA_TEST_CHECK(scheduler.Stage(MakeBuffer(1), 0, 8) != nullptr);
+    RRA_TEST_CHECK(device.wait_count == 1);
+    RRA_TEST_CHECK(device.last_waited_slot == 0);
+    RRA_TEST_CHECK(scheduler.GetCompletedTicket() == 1);
+    RRA_TEST_CHECK(device.misuse_count == 0);
+
+    scheduler.Cleanup();
+    RRA_TEST_CHECK(device.misuse_count == 0);
+}
+
+RRA_TEST(upload_scheduler, stage_data_splits_across_slots)
+{
+    MockUploadDevice device;
+    UploadScheduler  scheduler;
+    RRA_TEST_CHECK(scheduler.Initialize(&device, kSlotSize));
+
+    // Enough data to wrap the ring, so the first slot is reused and has to have finished copying first.
+    std::vector<uint8_t> data(kSlotSize * UploadScheduler::kStagingSlotCount + 24);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    const VkDeviceSize dst_offset = 8;
+    RRA_TEST_CHECK(scheduler.StageData(MakeBuffer(2), dst_offset, data.data(), data.size()));
+    scheduler.WaitForAll();
+    RRA_TEST_CHECK(scheduler.IsComplete(scheduler.GetStagingTicket()));
+    RRA_TEST_CHECK(device.submit_count == UploadScheduler::kStagingSlotCount + 1);
+    RRA_TEST_CHECK(device.misuse_count == 0);
+
+    const std::vector<uint8_t>& buffer = device.buffers[MakeBuffer(2)];
+    RRA_TEST_CHECK(buffer.size() == dst_offset + data.size());
+    RRA_TEST_CHECK(std::memcmp(buffer.data() + dst_offset, data.data(), data.size()) == 0);
+
+    scheduler.Cleanup();
+    RRA_TEST_CHECK(device.misuse_count == 0);
+}
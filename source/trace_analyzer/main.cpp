@@ -0,0 +1,484 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Command line tool that runs the backend analyses on a trace without the UI.
+//=============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "public/rra_blas.h"
+#include "public/rra_bvh.h"
+#include "public/rra_compression_analysis.h"
+#include "public/rra_ray_cost.h"
+#include "public/rra_reference_bvh.h"
+#include "public/rra_trace_loader.h"
+
+/// @brief The settings from the command line.
+struct AnalyzerOptions
+{
+    const char*           command        = nullptr;  ///< The analysis to run.
+    const char*           trace_path     = nullptr;  ///< The trace to load.
+    bool                  use_blas       = false;    ///< True to analyze a BLAS rather than a TLAS.
+    uint64_t              index          = 0;        ///< The index of the TLAS or BLAS to analyze.
+    RraRayCostConfig      ray_config     = {};       ///< The ray settings.
+    RraRayCostCacheConfig cache_config   = {};       ///< The cache model settings.
+    float                 fp16_tolerance = 0.01f;    ///< How far a box node's bounds may move when converted to fp16.
+};
+
+/// @brief An analysis that can be run from the command line.
+struct AnalyzerCommand
+{
+    const char* name;                                  ///< The name used on the command line.
+    const char* description;                           ///< A line describing the analysis.
+    bool (*function)(const AnalyzerOptions& options);  ///< Runs the analysis on the loaded trace, returning false on failure.
+};
+
+/// @brief Replay the rays through the cache model and print the cache statistics.
+///
+/// @param [in] options The command line settings.
+///
+/// @return true if the simulation ran, false if not.
+static bool RunCacheCommand(const AnalyzerOptions& options)
+{
+    RraRayCostCacheStats stats      = {};
+    RraErrorCode         error_code = kRraOk;
+    if (options.use_blas)
+    {
+        error_code = RraRayCostSimulateCacheBlas(options.index, &options.ray_config, &options.cache_config, &stats);
+    }
+    else
+    {
+        error_code = RraRayCostSimulateCacheTlas(options.index, &options.ray_config, &options.cache_config, &stats);
+    }
+    if (error_code != kRraOk)
+    {
+        fprintf(stderr, "The cache simulation failed (error %d).\n", error_code);
+        return false;
+    }
+
+    const RraRayCostCacheConfig& cache = options.cache_config;
+    printf("Cache simulation for %s %llu\n", options.use_blas ? "BLAS" : "TLAS", (unsigned long long)options.index);
+    printf("  Cache:              %u bytes, %u-way, %u byte lines, %u byte pages, %u rays per group\n",
+           cache.capacity,
+           cache.associativity,
+           cache.line_size,
+           cache.page_size,
+           cache.ray_group_size);
+    printf("  Rays:               %llu\n", (unsigned long long)stats.ray_count);
+    printf("  Line reads:         %llu\n", (unsigned long long)stats.line_reads);
+    printf("  Hit rate:           %.4f\n", stats.hit_rate);
+    printf("  Lines per ray:      %.2f (median %u, 90%% %u, 99%% %u, max %u)\n",
+           stats.mean_unique_lines,
+           stats.unique_line_percentiles[kRraRayCostPercentile50],
+           stats.unique_line_percentiles[kRraRayCostPercentile90],
+           stats.unique_line_percentiles[kRraRayCostPercentile99],
+           stats.unique_line_percentiles[kRraRayCostPercentileMax]);
+    printf("  Pages per ray:      %.2f\n", stats.mean_unique_pages);
+    printf("  Miss bytes per ray: %.1f\n", stats.mean_miss_bytes);
+    return true;
+}
+
+/// @brief Print the quality metrics of one tree in a reference BVH comparison.
+///
+/// @param [in] name  The name of the tree.
+/// @param [in] stats The metrics.
+static void PrintReferenceTreeStats(const char* name, const RraReferenceBvhTreeStats& stats)
+{
+    printf("    %-10s SAH cost %9.3f, %7llu box nodes, %7llu leaves, depth %3u",
+           name,
+           stats.sah_cost,
+           (unsigned long long)stats.box_node_count,
+           (unsigned long long)stats.leaf_node_count,
+           stats.max_depth);
+    if (stats.ray_cost.ray_count > 0)
+    {
+        printf(", %.2f nodes and %.2f triangles per ray", stats.ray_cost.mean_node_visits, stats.ray_cost.mean_triangle_tests);
+    }
+    printf("\n");
+}
+
+/// @brief Rebuild BLASes with the reference builder and compare the captured trees with them.
+///
+/// Compares the BLAS given with --blas, or every BLAS if none was given. The rays are only cast if --rays is not 0.
+///
+/// @param [in] options The command line settings.
+///
+/// @return true if every comparison ran, false if not.
+static bool RunReferenceBvhCommand(const AnalyzerOptions& options)
+{
+    uint64_t first_blas = options.index;
+    uint64_t end_blas   = options.index + 1;
+    if (!options.use_blas)
+    {
+        first_blas = 0;
+        RraBvhGetTotalBlasCount(&end_blas);
+    }
+
+    const RraRayCostConfig* ray_config = (options.ray_config.ray_count > 0) ? &options.ray_config : nullptr;
+    for (uint64_t blas_index = first_blas; blas_index < end_blas; blas_index++)
+    {
+        // Skip the empty BLASes, such as the placeholder at index 0, unless one was asked for.
+        if (!options.use_blas && RraBlasIsEmpty(blas_index))
+        {
+            continue;
+        }
+
+        RraReferenceBvhStats stats      = {};
+        RraErrorCode         error_code = RraReferenceBvhCompareBlas(blas_index, options.ray_config.thread_count, ray_config, &stats);
+        if (error_code != kRraOk)
+        {
+            fprintf(stderr, "The comparison of BLAS %llu failed (error %d).\n", (unsigned long long)blas_index, error_code);
+            return false;
+        }
+
+        printf("BLAS %llu: %llu triangles, reference built in %.2f ms\n",
+               (unsigned long long)blas_index,
+               (unsigned long long)stats.triangle_count,
+               stats.build_time_ms);
+        PrintReferenceTreeStats("captured", stats.captured);
+        PrintReferenceTreeStats("reference", stats.reference);
+        printf("    Captured / reference: SAH cost %.3f", stats.sah_cost_ratio);
+        if (ray_config != nullptr)
+        {
+            printf(", node visits %.3f, triangle tests %.3f", stats.node_visit_ratio, stats.triangle_test_ratio);
+        }
+        printf("\n");
+    }
+    return true;
+}
+
+/// @brief Print the compression analysis of a BLAS, or of the totals over all the BLASes.
+///
+/// @param [in] name  The name of the BLAS or total.
+/// @param [in] stats The analysis.
+static void PrintCompressionStats(const char* name, const RraBlasCompressionStats& stats)
+{
+    const uint64_t* interior_sizes = stats.projected_interior_node_buffer_size;
+    printf("%-10s %10llu %10llu %7.3f %12llu %12llu %7.3f %12llu %12llu %12llu\n",
+           name,
+           (unsigned long long)stats.triangle_count,
+           (unsigned long long)stats.shared_edge_pair_count,
+           stats.pair_compression_ratio,
+           (unsigned long long)stats.uncompressed_leaf_node_buffer_size,
+           (unsigned long long)stats.pair_compressed_leaf_node_buffer_size,
+           stats.fp16_representable_fraction,
+           (unsigned long long)interior_sizes[kRraBoxFp16ModeNone],
+           (unsigned long long)interior_sizes[kRraBoxFp16ModeMixedWithFp32],
+           (unsigned long long)interior_sizes[kRraBoxFp16ModeAll]);
+}
+
+/// @brief Estimate the memory each BLAS would take with other triangle compression and fp16 box node modes.
+///
+/// Analyzes the BLAS given with --blas, or every BLAS in parallel followed by the totals if none was given.
+///
+/// @param [in] options The command line settings.
+///
+/// @return true if the analysis ran, false if not.
+static bool RunCompressionCommand(const AnalyzerOptions& options)
+{
+    std::vector<RraBlasCompressionStats> blas_stats;
+    RraBlasCompressionStats              total_stats = {};
+    RraErrorCode                         error_code  = kRraOk;
+    if (options.use_blas)
+    {
+        blas_stats.resize(1);
+        error_code = RraCompressionAnalyzeBlas(options.index, options.fp16_tolerance, blas_stats.data());
+    }
+    else
+    {
+        uint64_t blas_count = 0;
+        RraBvhGetTotalBlasCount(&blas_count);
+        blas_stats.resize(blas_count);
+        error_code = RraCompressionAnalyzeAllBlases(options.ray_config.thread_count, options.fp16_tolerance, blas_stats.data(), &total_stats);
+    }
+    if (error_code != kRraOk)
+    {
+        fprintf(stderr, "The compression analysis failed (error %d).\n", error_code);
+        return false;
+    }
+
+    // Sizes are in bytes. The fp16 column is the fraction of the non-root box nodes that are or could be fp16.
+    printf("%-10s %10s %10s %7s %12s %12s %7s %12s %12s %12s\n",
+           "BLAS",
+           "Triangles",
+           "Pairs",
+           "Ratio",
+           "Leaf none",
+           "Leaf pair",
+           "fp16",
+           "Box fp32",
+           "Box mixed",
+           "Box fp16");
+    for (size_t i = 0; i < blas_stats.size(); i++)
+    {
+        const uint64_t blas_index = options.use_blas ? options.index : i;
+        if (!options.use_blas && RraBlasIsEmpty(blas_index))
+        {
+            continue;
+        }
+
+        char name[32];
+        snprintf(name, sizeof(name), "%llu", (unsigned long long)blas_index);
+        PrintCompressionStats(name, blas_stats[i]);
+    }
+    if (!options.use_blas)
+    {
+        PrintCompressionStats("Total", total_stats);
+    }
+    return true;
+}
+
+/// @brief Print a set of per-ray percentiles.
+///
+/// @param [in] percentiles The values at each percentile.
+static void PrintPercentiles(const uint32_t (&percentiles)[kRraRayCostPercentileCount])
+{
+    printf("(median %u, 90%% %u, 99%% %u, max %u)\n",
+           percentiles[kRraRayCostPercentile50],
+           percentiles[kRraRayCostPercentile90],
+           percentiles[kRraRayCostPercentile99],
+           percentiles[kRraRayCostPercentileMax]);
+}
+
+/// @brief Cast the rays and print the traversal cost, with the most expensive BLASes for a TLAS.
+///
+/// @param [in] options The command line settings.
+///
+/// @return true if the estimate ran, false if not.
+static bool RunRayCostCommand(const AnalyzerOptions& options)
+{
+    static const size_t kMostExpensiveBlasCount = 5;
+
+    RraRayCostStats                 stats = {};
+    std::vector<RraRayCostCounters> blas_counters;
+    RraErrorCode                    error_code = kRraOk;
+    if (options.use_blas)
+    {
+        error_code = RraRayCostEstimateBlas(options.index, &options.ray_config, &stats);
+    }
+    else
+    {
+        uint64_t blas_count = 0;
+        RraBvhGetTotalBlasCount(&blas_count);
+        blas_counters.resize(blas_count);
+        error_code = RraRayCostEstimateTlas(options.index, &options.ray_config, &stats, nullptr, blas_counters.data());
+    }
+    if (error_code != kRraOk)
+    {
+        fprintf(stderr, "The ray cost estimate failed (error %d).\n", error_code);
+        return false;
+    }
+
+    printf("Ray cost for %s %llu\n", options.use_blas ? "BLAS" : "TLAS", (unsigned long long)options.index);
+    printf("  Rays:               %llu (%llu hit)\n", (unsigned long long)stats.ray_count, (unsigned long long)stats.hit_count);
+    printf("  Node visits:        %llu (%llu box nodes", (unsigned long long)stats.node_visits, (unsigned long long)stats.box_node_visits);
+    if (!options.use_blas)
+    {
+        printf(", %llu instances", (unsigned long long)stats.instance_visits);
+    }
+    printf(")\n");
+    printf("  Nodes per ray:      %.2f ", stats.mean_node_visits);
+    PrintPercentiles(stats.node_visit_percentiles);
+    printf("  Triangles per ray:  %.2f ", stats.mean_triangle_tests);
+    PrintPercentiles(stats.triangle_test_percentiles);
+
+    // The BLASes the rays spent the most time in are the first candidates for a better build.
+    std::vector<uint64_t> blas_order;
+    for (uint64_t blas_index = 0; blas_index < blas_counters.size(); blas_index++)
+    {
+        if (blas_counters[blas_index].node_visits > 0)
+        {
+            blas_order.push_back(blas_index);
+        }
+    }
+    std::sort(blas_order.begin(), blas_order.end(), [&blas_counters](uint64_t a, uint64_t b) {
+        return blas_counters[a].node_visits > blas_counters[b].node_visits;
+    });
+    if (blas_order.size() > kMostExpensiveBlasCount)
+    {
+        blas_order.resize(kMostExpensiveBlasCount);
+    }
+
+    if (!blas_order.empty())
+    {
+        printf("  Most expensive BLASes:\n");
+        printf("    %-8s %14s %14s %14s\n", "BLAS", "Rays", "Node visits", "Triangles");
+    }
+    for (uint64_t blas_index : blas_order)
+    {
+        const RraRayCostCounters& counters = blas_counters[blas_index];
+        printf("    %-8llu %14llu %14llu %14llu\n",
+               (unsigned long long)blas_index,
+               (unsigned long long)counters.ray_count,
+               (unsigned long long)counters.node_visits,
+               (unsigned long long)counters.triangle_tests);
+    }
+    return true;
+}
+
+/// @brief The analyses that can be run.
+static const AnalyzerCommand kCommands[] = {
+    {"cache", "Replay rays through a cache model of the node reads.", RunCacheCommand},
+    {"compression", "Estimate BLAS sizes with other triangle compression and fp16 box node modes.", RunCompressionCommand},
+    {"ray-cost", "Cast rays and count the nodes visited and triangles tested.", RunRayCostCommand},
+    {"reference-bvh", "Compare BLASes with a binned SAH rebuild of their triangles.", RunReferenceBvhCommand},
+};
+
+/// @brief Print the command line options.
+///
+/// @param [in] program_name The name the program was run with.
+static void PrintUsage(const char* program_name)
+{
+    printf("Usage: %s <command> [options] <trace.rra>\n", program_name);
+    printf("Commands:\n");
+    for (const AnalyzerCommand& command : kCommands)
+    {
+        printf("  %-22s%s\n", command.name, command.description);
+    }
+    printf("Options:\n");
+    printf("  --tlas <n>            Analyze this TLAS (default 0).\n");
+    printf("  --blas <n>            Analyze this BLAS instead of a TLAS.\n");
+    printf("  --rays <n>            Number of rays to cast, 0 for none where optional (default 1000000).\n");
+    printf("  --seed <n>            Random seed for the rays (default 0).\n");
+    printf("  --threads <n>         Threads to use, 0 for one per core (default 0).\n");
+    printf("  --line-size <n>       Cache line size in bytes (default 128).\n");
+    printf("  --ways <n>            Cache associativity (default 4).\n");
+    printf("  --capacity <n>        Cache size in bytes (default 16384).\n");
+    printf("  --page-size <n>       DRAM page size in bytes (default 4096).\n");
+    printf("  --ray-group <n>       Consecutive rays sharing the cache (default 64).\n");
+    printf("  --fp16-tolerance <x>  Largest fp16 box bound movement, as a fraction of the node size (default 0.01).\n");
+}
+
+/// @brief Parse the command line into the analyzer settings.
+///
+/// @param [in]  argc    The number of arguments.
+/// @param [in]  argv    The arguments.
+/// @param [out] options The settings.
+///
+/// @return true if the command line is valid, false if not.
+static bool ParseCommandLine(int argc, char* argv[], AnalyzerOptions& options)
+{
+    if (argc < 2)
+    {
+        return false;
+    }
+    options.command = argv[1];
+
+    for (int i = 2; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        if (strncmp(argument, "--", 2) != 0)
+        {
+            if (options.trace_path != nullptr)
+            {
+                return false;
+            }
+            options.trace_path = argument;
+            continue;
+        }
+
+        // Every option takes a value.
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        const char*              value  = argv[++i];
+        const unsigned long long number = strtoull(value, nullptr, 0);
+
+        if (strcmp(argument, "--tlas") == 0)
+        {
+            options.use_blas = false;
+            options.index    = number;
+        }
+        else if (strcmp(argument, "--blas") == 0)
+        {
+            options.use_blas = true;
+            options.index    = number;
+        }
+        else if (strcmp(argument, "--rays") == 0)
+        {
+            options.ray_config.ray_count = static_cast<uint32_t>(number);
+        }
+        else if (strcmp(argument, "--seed") == 0)
+        {
+            options.ray_config.seed = number;
+        }
+        else if (strcmp(argument, "--threads") == 0)
+        {
+            options.ray_config.thread_count = static_cast<uint32_t>(number);
+        }
+        else if (strcmp(argument, "--line-size") == 0)
+        {
+            options.cache_config.line_size = static_cast<uint32_t>(number);
+        }
+        else if (strcmp(argument, "--ways") == 0)
+        {
+            options.cache_config.associativity = static_cast<uint32_t>(number);
+        }
+        else if (strcmp(argument, "--capacity") == 0)
+        {
+            options.cache_config.capacity = static_cast<uint32_t>(number);
+        }
+        else if (strcmp(argument, "--page-size") == 0)
+        {
+            options.cache_config.page_size = static_cast<uint32_t>(number);
+        }
+        else if (strcmp(argument, "--ray-group") == 0)
+        {
+            options.cache_config.ray_group_size = static_cast<uint32_t>(number);
+        }
+        else if (strcmp(argument, "--fp16-tolerance") == 0)
+        {
+            options.fp16_tolerance = strtof(value, nullptr);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return options.trace_path != nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    AnalyzerOptions options;
+    RraRayCostGetDefaultConfig(&options.ray_config);
+    RraRayCostGetDefaultCacheConfig(&options.cache_config);
+
+    if (!ParseCommandLine(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const AnalyzerCommand* command = nullptr;
+    for (const AnalyzerCommand& candidate : kCommands)
+    {
+        if (strcmp(options.command, candidate.name) == 0)
+        {
+            command = &candidate;
+        }
+    }
+    if (command == nullptr)
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    RraErrorCode error_code = RraTraceLoaderLoad(options.trace_path);
+    if (error_code != kRraOk)
+    {
+        fprintf(stderr, "Failed to load %s (error %d).\n", options.trace_path, error_code);
+        return EXIT_FAILURE;
+    }
+
+    bool result = command->function(options);
+    RraTraceLoaderUnload();
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
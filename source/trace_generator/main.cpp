@@ -0,0 +1,240 @@
+//=============================================================================
+// Copyright (c) 2022 Advanced Micro Devices, Inc. All rights reserved.
+/// @author AMD Developer Tools Team
+/// @file
+/// @brief  Command line tool that writes synthetic traces for scale testing.
+//=============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "public/rra_bvh.h"
+#include "public/rra_tlas.h"
+#include "public/rra_trace_generator.h"
+#include "public/rra_trace_loader.h"
+
+/// @brief Print the command line options.
+///
+/// @param [in] program_name The name the program was run with.
+static void PrintUsage(const char* program_name)
+{
+    printf("Usage: %s [options] <output.rra>\n", program_name);
+    printf("  --blas-count <n>        Number of BLASes (default 16).\n");
+    printf("  --triangles <n>         Number of triangles in each BLAS (default 4096).\n");
+    printf("  --instances <n>         Number of instances in the TLAS (default 64).\n");
+    printf("  --inactive <n>          Number of those instances with a mask of 0 (default 0).\n");
+    printf("  --shape <median|random> How the trees are split (default median).\n");
+    printf("  --compression <none|two|pair>\n");
+    printf("                          Triangle compression mode (default pair).\n");
+    printf("  --fp16 <none|leaves|mixed|all>\n");
+    printf("                          Fp16 box node mode for the BLASes (default none).\n");
+    printf("  --fp16-tolerance <f>    Tolerance for the mixed fp16 mode (default 0.01).\n");
+    printf("  --seed <n>              Random seed (default 0).\n");
+    printf("  --verify                Load the trace after writing it, and check the counts.\n");
+}
+
+/// @brief Look up a name in a list of names.
+///
+/// @param [in]  name      The name to look up.
+/// @param [in]  names     The list of names.
+/// @param [in]  count     The number of names in the list.
+/// @param [out] out_index The index of the name in the list.
+///
+/// @return true if the name was found, false if not.
+static bool LookUpName(const char* name, const char* const* names, int count, int& out_index)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(name, names[i]) == 0)
+        {
+            out_index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Parse the command line into the generator settings.
+///
+/// @param [in]  argc       The number of arguments.
+/// @param [in]  argv       The arguments.
+/// @param [out] config     The settings.
+/// @param [out] out_path   The output file path.
+/// @param [out] out_verify Set if the trace should be loaded after writing it.
+///
+/// @return true if the command line is valid, false if not.
+static bool ParseCommandLine(int argc, char* argv[], RraTraceGeneratorConfig& config, const char*& out_path, bool& out_verify)
+{
+    static const char* const kShapeNames[]       = {"median", "random"};
+    static const char* const kCompressionNames[] = {"none", "two", "pair"};
+    static const char* const kFp16Names[]        = {"none", "leaves", "mixed", "all"};
+
+    out_path   = nullptr;
+    out_verify = false;
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        if (strcmp(argument, "--verify") == 0)
+        {
+            out_verify = true;
+            continue;
+        }
+
+        if (strncmp(argument, "--", 2) != 0)
+        {
+            if (out_path != nullptr)
+            {
+                return false;
+            }
+            out_path = argument;
+            continue;
+        }
+
+        // Every other option takes a value.
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        const char* value = argv[++i];
+        int         index = 0;
+
+        if (strcmp(argument, "--blas-count") == 0)
+        {
+            config.blas_count = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        }
+        else if (strcmp(argument, "--triangles") == 0)
+        {
+            config.triangles_per_blas = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        }
+        else if (strcmp(argument, "--instances") == 0)
+        {
+            config.instance_count = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        }
+        else if (strcmp(argument, "--inactive") == 0)
+        {
+            config.inactive_instance_count = static_cast<uint32_t>(strtoul(value, nullptr, 0));
+        }
+        else if (strcmp(argument, "--shape") == 0 && LookUpName(value, kShapeNames, 2, index))
+        {
+            config.tree_shape = static_cast<RraTraceGeneratorTreeShape>(index);
+        }
+        else if (strcmp(argument, "--compression") == 0 && LookUpName(value, kCompressionNames, 3, index))
+        {
+            config.triangle_compression_mode = static_cast<RraTriangleCompressionMode>(index);
+        }
+        else if (strcmp(argument, "--fp16") == 0 && LookUpName(value, kFp16Names, 4, index))
+        {
+            config.box_fp16_mode = static_cast<RraBoxFp16Mode>(index);
+        }
+        else if (strcmp(argument, "--fp16-tolerance") == 0)
+        {
+            config.fp16_tolerance = strtof(value, nullptr);
+        }
+        else if (strcmp(argument, "--seed") == 0)
+        {
+            config.seed = strtoull(value, nullptr, 0);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return out_path != nullptr;
+}
+
+/// @brief Load a generated trace and check it matches the settings it was generated with.
+///
+/// @param [in] file_path The path of the trace.
+/// @param [in] config    The settings the trace was generated with.
+///
+/// @return true if the trace loaded and matches, false if not.
+static bool VerifyTrace(const char* file_path, const RraTraceGeneratorConfig& config)
+{
+    RraErrorCode error_code = RraTraceLoaderLoad(file_path);
+    if (error_code != kRraOk)
+    {
+        fprintf(stderr, "Failed to load %s (error %d).\n", file_path, error_code);
+        return false;
+    }
+
+    uint64_t tlas_count           = 0;
+    uint64_t blas_count           = 0;
+    uint64_t instance_count       = 0;
+    uint64_t inactive_count       = 0;
+    uint64_t instanced_blas_count = 0;
+    RraBvhGetTlasCount(&tlas_count);
+    RraBvhGetBlasCount(&blas_count);
+    if (tlas_count > 0)
+    {
+        RraTlasGetInstanceNodeCount(0, &instance_count);
+        RraTlasGetInactiveInstancesCount(0, &inactive_count);
+        RraTlasGetBlasCount(0, &instanced_blas_count);
+    }
+    RraTraceLoaderUnload();
+
+    if (tlas_count != 1 || blas_count != config.blas_count || instance_count != config.instance_count)
+    {
+        fprintf(stderr,
+                "Loaded %llu TLASes, %llu BLASes and %llu instances, expected 1, %u and %u.\n",
+                (unsigned long long)tlas_count,
+                (unsigned long long)blas_count,
+                (unsigned long long)instance_count,
+                config.blas_count,
+                config.instance_count);
+        return false;
+    }
+
+    // Inactive instances don't reference a BLAS, so the TLAS only counts the BLASes of the active ones.
+    const uint32_t active_count = config.instance_count - config.inactive_instance_count;
+    if (inactive_count != config.inactive_instance_count || instanced_blas_count != std::min(config.blas_count, active_count))
+    {
+        fprintf(stderr,
+                "Loaded %llu inactive instances referencing %llu BLASes, expected %u and %u.\n",
+                (unsigned long long)inactive_count,
+                (unsigned long long)instanced_blas_count,
+                config.inactive_instance_count,
+                std::min(config.blas_count, active_count));
+        return false;
+    }
+
+    printf("Verified: the trace loads with %llu BLASes and %llu instances.\n", (unsigned long long)blas_count, (unsigned long long)instance_count);
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    RraTraceGeneratorConfig config = {};
+    RraTraceGeneratorGetDefaultConfig(&config);
+
+    const char* file_path = nullptr;
+    bool        verify    = false;
+    if (!ParseCommandLine(argc, argv, config, file_path, verify))
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    RraTraceGeneratorStats stats      = {};
+    RraErrorCode           error_code = RraTraceGeneratorWrite(file_path, &config, &stats);
+    if (error_code != kRraOk)
+    {
+        fprintf(stderr, "Failed to write %s (error %d).\n", file_path, error_code);
+        return EXIT_FAILURE;
+    }
+
+    printf("Wrote %s\n", file_path);
+    printf("  Triangles:          %llu\n", (unsigned long long)stats.triangle_count);
+    printf("  Fp32 box nodes:     %llu\n", (unsigned long long)stats.fp32_box_node_count);
+    printf("  Fp16 box nodes:     %llu\n", (unsigned long long)stats.fp16_box_node_count);
+    printf("  Leaf nodes:         %llu\n", (unsigned long long)stats.leaf_node_count);
+    printf("  Chunk data (bytes): %llu\n", (unsigned long long)stats.chunk_data_size);
+
+    if (verify && !VerifyTrace(file_path, config))
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}